@@ -0,0 +1,659 @@
+// End-to-end benchmarks of the minimum cost flow solvers on synthetic phase unwrapping
+// problems.
+//
+// For each problem size, a wrapped phase field is synthesized from a smooth phase
+// surface plus Gaussian noise, and the residues of the wrapped phase are used as the
+// node surplus/demand of a unit-capacity network on the dual grid. Each solver is run
+// on a fresh copy of the network and its wall time, peak resident set size, and
+// shortest path search statistics are reported.
+//
+// Usage:
+//
+//     bench-whirlwind [--sizes N,...] [--graph grid|compact|csr|csr32|all]
+//                     [--solver pd|ssp|cs|delta|all] [--threads N,...]
+//                     [--heap binary|dary|pairing|radix|all]
+//                     [--arcs separate|packed|interleaved|all]
+//                     [--phase single|blocking|forest|all] [--maxiter N]
+//                     [--min-yield Y] [--ssp-search dijkstra|goal|all]
+//                     [--max-cost N] [--noise SIGMA] [--seed N]
+//
+// The `--heap` option selects the priority queue(s) used by the primal-dual solver's
+// Dijkstra searches. The `--arcs` option selects the network's arc storage layout:
+// separate per-arc arrays (`UnitCapacityMixin`), packed arc records
+// (`PackedUnitCapacityMixin`), and/or interleaved forward/reverse arc numbering
+// (`InterleavedResidualGraphMixin`, CSR graphs only). The `--phase` option selects how
+// the primal-dual solver augments flow in each iteration (see `PrimalDualPhase`). The
+// `--maxiter` and `--min-yield` options control when it switches to the successive
+// shortest paths algorithm (a min yield of 0 disables the adaptive switch). The
+// `--ssp-search` option selects how the successive shortest paths solver searches for
+// augmenting paths (see `SuccessiveShortestPathsSearch`). The cost scaling solver (`cs`)
+// doesn't use shortest path searches, so its visited/relaxed counts are zero. The
+// `delta` solver runs the primal-dual solver with the parallel `DeltaStepping` search
+// once for each thread count in `--threads`.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/indexed_dary_heap.hpp>
+#include <whirlwind/container/indexed_pairing_heap.hpp>
+#include <whirlwind/container/radix_heap.hpp>
+#include <whirlwind/container/ring_queue.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/graph/shortest_path_forest.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/network/cost_scaling.hpp>
+#include <whirlwind/network/delta_stepping.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/residual_graph.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+#include <whirlwind/util/get_residues.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Cost = int;
+using Flow = int;
+
+// Shortest path search statistics accumulated over a single solver run.
+struct SearchStats {
+    // The total number of vertices visited (i.e. the number of iterations of the main
+    // loop of Dijkstra's algorithm) over all shortest path searches.
+    std::uint64_t vertices_visited = 0;
+
+    // The total number of edge relaxations that improved the distance to a vertex
+    // over all shortest path searches.
+    std::uint64_t edges_relaxed = 0;
+};
+
+SearchStats search_stats = {};
+
+// A `ShortestPathForest` that counts visited vertices and improving edge relaxations.
+//
+// The shortest path solvers are parameterized by their shortest path forest type, so
+// this allows instrumenting each solver's hot loop without modifying it.
+template<class Distance, class Graph>
+class CountingShortestPathForest : public ww::ShortestPathForest<Distance, Graph> {
+private:
+    using base_type = ww::ShortestPathForest<Distance, Graph>;
+
+public:
+    using vertex_type = typename base_type::vertex_type;
+    using edge_type = typename base_type::edge_type;
+    using pred_type = typename base_type::pred_type;
+
+    using base_type::base_type;
+
+    constexpr void
+    label_vertex_visited(const vertex_type& vertex)
+    {
+        ++search_stats.vertices_visited;
+        base_type::label_vertex_visited(vertex);
+    }
+
+    constexpr void
+    set_predecessor(const vertex_type& vertex,
+                    vertex_type pred_vertex,
+                    edge_type pred_edge)
+    {
+        ++search_stats.edges_relaxed;
+        base_type::set_predecessor(vertex, std::move(pred_vertex),
+                                   std::move(pred_edge));
+    }
+
+    constexpr void
+    set_predecessor(const vertex_type& vertex, pred_type pred)
+    {
+        set_predecessor(vertex, std::move(pred.first), std::move(pred.second));
+    }
+};
+
+// The number of threads used by `BenchDeltaStepping`.
+std::size_t delta_stepping_num_threads = 1;
+
+// A `DeltaStepping` solver that uses `delta_stepping_num_threads` threads, since
+// `primal_dual()` creates its solver from the network alone.
+template<class DeltaStepping>
+class BenchDeltaStepping : public DeltaStepping {
+public:
+    template<class Network>
+    explicit BenchDeltaStepping(const Network& network)
+        : DeltaStepping(network, delta_stepping_num_threads)
+    {}
+};
+
+template<class DeltaStepping, class Network, class Visitor>
+void
+dijkstra_pd(BenchDeltaStepping<DeltaStepping>& solver,
+            const Network& network,
+            Visitor&& visitor)
+{
+    ww::dijkstra_pd(static_cast<DeltaStepping&>(solver), network,
+                    std::forward<Visitor>(visitor));
+}
+
+template<class Graph>
+using GridNetwork =
+        ww::Network<Graph, Cost, Flow, ww::Vector, ww::UnitCapacityMixin<Graph, Flow>>;
+
+template<class Graph>
+using PackedGridNetwork = ww::Network<Graph, Cost, Flow, ww::Vector,
+                                      ww::PackedUnitCapacityMixin<Graph, Flow, Cost>>;
+
+template<class Graph>
+using InterleavedGridNetwork = ww::Network<
+        Graph, Cost, Flow, ww::Vector,
+        ww::UnitCapacityMixin<Graph, Flow, ww::Vector,
+                              ww::InterleavedResidualGraphMixin<Graph>>>;
+
+struct Options {
+    std::vector<std::size_t> sizes = {256, 512, 1024, 2048};
+    bool run_grid = true;
+    bool run_compact = true;
+    bool run_csr = true;
+    bool run_csr32 = true;
+    bool run_pd = true;
+    bool run_ssp = true;
+    bool run_cs = true;
+    bool run_delta_stepping = false;
+    std::vector<std::size_t> threads = {1, ww::default_num_threads()};
+    bool run_dijkstra_search = false;
+    bool run_goal_directed_search = true;
+    bool run_binary_heap = true;
+    bool run_dary_heap = false;
+    bool run_pairing_heap = false;
+    bool run_radix_heap = false;
+    bool run_separate_arcs = true;
+    bool run_packed_arcs = false;
+    bool run_interleaved_arcs = false;
+    bool run_single_path_phase = true;
+    bool run_blocking_flow_phase = false;
+    bool run_forest_phase = false;
+    std::size_t maxiter = 0;
+    double min_yield = ww::default_primal_dual_min_yield;
+    Cost max_cost = 100;
+    float noise = 1.0F;
+    std::uint64_t seed = 0;
+};
+
+[[nodiscard]] auto
+peak_rss_mib() -> double
+{
+#if defined(__unix__) || defined(__APPLE__)
+    auto usage = rusage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    const auto maxrss = static_cast<double>(usage.ru_maxrss);
+#if defined(__APPLE__)
+    // Reported in bytes on macOS.
+    return maxrss / (1024.0 * 1024.0);
+#else
+    // Reported in kibibytes on Linux & BSD.
+    return maxrss / 1024.0;
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+// Synthesize an `m x n` wrapped phase field. The unwrapped phase is a smooth surface
+// with several cycles of phase across the field, corrupted by additive Gaussian noise
+// with standard deviation `noise` (in radians).
+[[nodiscard]] auto
+make_wrapped_phase(std::size_t m, std::size_t n, float noise, std::mt19937_64& rng)
+        -> ww::Array2D<float>
+{
+    auto normal = std::normal_distribution<float>(0.0F, noise);
+    auto phase = ww::Array2D<float>(m, n);
+
+    const auto two_pi = ww::tau<double>();
+    const auto dm = static_cast<double>(m);
+    const auto dn = static_cast<double>(n);
+
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto y = static_cast<double>(i) / dm;
+            const auto x = static_cast<double>(j) / dn;
+            const auto smooth = 20.0 * x + 10.0 * y * y +
+                                8.0 * std::sin(two_pi * x) * std::cos(3.0 * y);
+            const auto psi = smooth + static_cast<double>(normal(rng));
+            const auto wrapped = psi - two_pi * std::round(psi / two_pi);
+            phase(i, j) = static_cast<float>(wrapped);
+        }
+    }
+
+    return phase;
+}
+
+// Flatten the residues into a per-node surplus array in row-major order (which matches
+// the vertex ordering of `RectangularGridGraph`).
+[[nodiscard]] auto
+make_surplus(const ww::Array2D<std::int32_t>& residues) -> std::vector<Flow>
+{
+    const auto m = residues.extent(0);
+    const auto n = residues.extent(1);
+
+    auto surplus = std::vector<Flow>();
+    surplus.reserve(m * n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            surplus.push_back(static_cast<Flow>(residues(i, j)));
+        }
+    }
+    return surplus;
+}
+
+[[nodiscard]] auto
+make_costs(std::size_t num_edges, Cost max_cost, std::mt19937_64& rng)
+        -> std::vector<Cost>
+{
+    auto uniform = std::uniform_int_distribution<Cost>(1, max_cost);
+    auto cost = std::vector<Cost>(num_edges);
+    for (auto& c : cost) {
+        c = uniform(rng);
+    }
+    return cost;
+}
+
+// Create a `CSRGraph` with the same topology as a `RectangularGridGraph`.
+template<class CSRGraph, class GridGraph>
+[[nodiscard]] auto
+make_csr_graph(const GridGraph& grid) -> CSRGraph
+{
+    auto edge_list = ww::EdgeList();
+    for (const auto& tail : grid.vertices()) {
+        for (const auto& [edge, head] : grid.outgoing_edges(tail)) {
+            edge_list.add_edge(grid.get_vertex_id(tail), grid.get_vertex_id(head));
+        }
+    }
+    return CSRGraph(edge_list);
+}
+
+// Permute the edge costs of a `RectangularGridGraph` to match the edge ordering of the
+// equivalent `CSRGraph`, so that both networks describe the same problem.
+template<class GridGraph, class CSRGraph>
+[[nodiscard]] auto
+make_csr_costs(const GridGraph& grid,
+               const CSRGraph& csr,
+               const std::vector<Cost>& grid_cost) -> std::vector<Cost>
+{
+    auto cost = std::vector<Cost>(csr.num_edges());
+    for (const auto& tail : grid.vertices()) {
+        using CSRVertex = typename CSRGraph::vertex_type;
+        const auto tail_id = static_cast<CSRVertex>(grid.get_vertex_id(tail));
+        for (const auto& [grid_edge, head] : grid.outgoing_edges(tail)) {
+            const auto head_id = grid.get_vertex_id(head);
+            for (const auto& [csr_edge, csr_head] : csr.outgoing_edges(tail_id)) {
+                if (csr_head == head_id) {
+                    const auto grid_edge_id = grid.get_edge_id(grid_edge);
+                    cost[csr.get_edge_id(csr_edge)] = grid_cost[grid_edge_id];
+                }
+            }
+        }
+    }
+    return cost;
+}
+
+struct Problem {
+    std::size_t size = 0;
+    std::size_t num_residues = 0;
+    std::vector<Flow> surplus;
+};
+
+[[nodiscard]] auto
+make_problem(std::size_t size, const Options& options, std::mt19937_64& rng) -> Problem
+{
+    const auto phase = make_wrapped_phase(size, size, options.noise, rng);
+    const auto residues = ww::get_residues(phase);
+
+    auto problem = Problem{size, 0, make_surplus(residues)};
+    for (const auto& s : problem.surplus) {
+        problem.num_residues += (s != 0) ? 1U : 0U;
+    }
+    return problem;
+}
+
+void
+print_header()
+{
+    std::printf("%-7s %7s %-21s %10s %11s %11s %14s %14s %14s\n", "graph", "size",
+                "alg", "residues", "time (s)", "rss (MiB)", "visited", "relaxed",
+                "total cost");
+}
+
+template<class Network, class Solve>
+void
+run_solver(std::string_view graph_name,
+           std::string_view solver_name,
+           const Problem& problem,
+           Network network,
+           Solve&& solve)
+{
+    search_stats = {};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::forward<Solve>(solve)(network);
+    const auto stop = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(stop - start).count();
+
+    if (network.total_excess() != 0) {
+        std::fprintf(stderr, "error: %.*s solver terminated with unbalanced flow\n",
+                     static_cast<int>(solver_name.size()), solver_name.data());
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::printf("%-7.*s %7zu %-21.*s %10zu %11.3f %11.1f %14llu %14llu %14lld\n",
+                static_cast<int>(graph_name.size()), graph_name.data(), problem.size,
+                static_cast<int>(solver_name.size()), solver_name.data(),
+                problem.num_residues, seconds, peak_rss_mib(),
+                static_cast<unsigned long long>(search_stats.vertices_visited),
+                static_cast<unsigned long long>(search_stats.edges_relaxed),
+                static_cast<long long>(network.total_cost()));
+    std::fflush(stdout);
+}
+
+template<class Network, class Graph>
+void
+run_solvers(std::string_view graph_name,
+            std::string_view suffix,
+            const Graph& graph,
+            const Problem& problem,
+            const std::vector<Cost>& cost,
+            const Options& options)
+{
+    using ResidualGraph = typename Network::residual_graph_type;
+    using ShortestPaths = CountingShortestPathForest<Cost, ResidualGraph>;
+
+    using Vertex = typename ResidualGraph::vertex_type;
+
+    const auto run_pd = [&]<class Heap>(std::string_view name) {
+        using Dijkstra =
+                ww::Dijkstra<Cost, ResidualGraph, ww::Vector, Heap, ShortestPaths>;
+        const auto run_phase = [&](ww::PrimalDualPhase phase,
+                                   std::string_view phase_suffix) {
+            const auto solver_name =
+                    std::string(name) + std::string(phase_suffix) + std::string(suffix);
+            run_solver(graph_name, solver_name, problem,
+                       Network(graph, problem.surplus, cost), [&](auto& network) {
+                           ww::primal_dual<Dijkstra>(network, options.maxiter, phase,
+                                                     options.min_yield);
+                       });
+        };
+        if (options.run_single_path_phase) {
+            run_phase(ww::PrimalDualPhase::single_path, "");
+        }
+        if (options.run_blocking_flow_phase) {
+            run_phase(ww::PrimalDualPhase::blocking_flow, "-bf");
+        }
+        if (options.run_forest_phase) {
+            run_phase(ww::PrimalDualPhase::shortest_path_forest, "-forest");
+        }
+    };
+
+    if (options.run_delta_stepping) {
+        using Dijkstra = ww::Dijkstra<Cost, ResidualGraph, ww::Vector,
+                                      ww::BinaryHeap<Vertex, Cost>, ShortestPaths>;
+        using DeltaStepping = BenchDeltaStepping<
+                ww::DeltaStepping<Cost, ResidualGraph, ww::Vector, ShortestPaths>>;
+        for (const auto& num_threads : options.threads) {
+            delta_stepping_num_threads = num_threads;
+            const auto solver_name = "pd-delta-t" + std::to_string(num_threads) +
+                                     std::string(suffix);
+            run_solver(graph_name, solver_name, problem,
+                       Network(graph, problem.surplus, cost), [&](auto& network) {
+                           ww::primal_dual<Dijkstra, ww::NullLogger, DeltaStepping>(
+                                   network, options.maxiter,
+                                   ww::PrimalDualPhase::single_path, options.min_yield);
+                       });
+        }
+    }
+
+    using Queue = ww::RingQueue<Vertex>;
+    using Dial = ww::Dial<Cost, ResidualGraph, ww::Vector, Queue, ShortestPaths>;
+
+    if (options.run_pd) {
+        if (options.run_binary_heap) {
+            run_pd.template operator()<ww::BinaryHeap<Vertex, Cost>>("pd");
+        }
+        if (options.run_dary_heap) {
+            run_pd.template operator()<ww::IndexedDaryHeap<Vertex, Cost>>("pd-dary");
+        }
+        if (options.run_pairing_heap) {
+            run_pd.template operator()<ww::IndexedPairingHeap<Vertex, Cost>>(
+                    "pd-pairing");
+        }
+        if (options.run_radix_heap) {
+            run_pd.template operator()<ww::RadixHeap<Vertex, Cost>>("pd-radix");
+        }
+    }
+
+    const auto run_ssp = [&](ww::SuccessiveShortestPathsSearch search,
+                             std::string_view search_suffix) {
+        const auto solver_name =
+                "ssp" + std::string(search_suffix) + std::string(suffix);
+        run_solver(graph_name, solver_name, problem,
+                   Network(graph, problem.surplus, cost), [&](auto& network) {
+                       ww::successive_shortest_paths<Dial>(network, search);
+                   });
+    };
+
+    if (options.run_ssp && options.run_goal_directed_search) {
+        run_ssp(ww::SuccessiveShortestPathsSearch::goal_directed, "");
+    }
+    if (options.run_ssp && options.run_dijkstra_search) {
+        run_ssp(ww::SuccessiveShortestPathsSearch::dijkstra, "-dijkstra");
+    }
+
+    if (options.run_cs) {
+        run_solver(graph_name, "cs" + std::string(suffix), problem,
+                   Network(graph, problem.surplus, cost),
+                   [](auto& network) { ww::cost_scaling(network); });
+    }
+}
+
+template<class Graph>
+void
+run_solvers(std::string_view graph_name,
+            const Graph& graph,
+            const Problem& problem,
+            const std::vector<Cost>& cost,
+            const Options& options)
+{
+    if (options.run_separate_arcs) {
+        run_solvers<GridNetwork<Graph>>(graph_name, "", graph, problem, cost, options);
+    }
+    if (options.run_packed_arcs) {
+        run_solvers<PackedGridNetwork<Graph>>(graph_name, "-packed", graph, problem,
+                                              cost, options);
+    }
+    if constexpr (requires { graph.row_offsets(); }) {
+        if (options.run_interleaved_arcs) {
+            run_solvers<InterleavedGridNetwork<Graph>>(graph_name, "-interleaved",
+                                                       graph, problem, cost, options);
+        }
+    }
+}
+
+void
+print_usage(const char* program)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--sizes N,...] [--graph grid|compact|csr|csr32|all] "
+                 "[--solver pd|ssp|cs|delta|all] [--threads N,...] "
+                 "[--heap binary|dary|pairing|radix|all] "
+                 "[--arcs separate|packed|interleaved|all] "
+                 "[--phase single|blocking|forest|all] "
+                 "[--maxiter N] [--min-yield Y] "
+                 "[--ssp-search dijkstra|goal|all] "
+                 "[--max-cost N] [--noise SIGMA] [--seed N]\n",
+                 program);
+}
+
+[[nodiscard]] auto
+parse_sizes(std::string_view arg) -> std::vector<std::size_t>
+{
+    auto sizes = std::vector<std::size_t>();
+    while (!arg.empty()) {
+        const auto pos = arg.find(',');
+        const auto token = std::string(arg.substr(0, pos));
+        sizes.push_back(std::stoul(token));
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        arg.remove_prefix(pos + 1);
+    }
+    return sizes;
+}
+
+[[nodiscard]] auto
+parse_options(int argc, char** argv) -> Options
+{
+    auto options = Options{};
+
+    for (int i = 1; i < argc; ++i) {
+        const auto flag = std::string_view(argv[i]);
+        if ((flag == "-h") || (flag == "--help")) {
+            print_usage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        }
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        }
+        const auto value = std::string_view(argv[++i]);
+
+        if (flag == "--sizes") {
+            options.sizes = parse_sizes(value);
+        } else if (flag == "--graph") {
+            options.run_grid = (value == "grid") || (value == "all");
+            options.run_compact = (value == "compact") || (value == "all");
+            options.run_csr = (value == "csr") || (value == "all");
+            options.run_csr32 = (value == "csr32") || (value == "all");
+        } else if (flag == "--solver") {
+            options.run_pd = (value == "pd") || (value == "all");
+            options.run_ssp = (value == "ssp") || (value == "all");
+            options.run_cs = (value == "cs") || (value == "all");
+            options.run_delta_stepping = (value == "delta") || (value == "all");
+        } else if (flag == "--threads") {
+            options.threads = parse_sizes(value);        } else if (flag == "--heap") {
+            options.run_binary_heap = (value == "binary") || (value == "all");
+            options.run_dary_heap = (value == "dary") || (value == "all");
+            options.run_pairing_heap = (value == "pairing") || (value == "all");
+            options.run_radix_heap = (value == "radix") || (value == "all");
+        } else if (flag == "--arcs") {
+            options.run_separate_arcs = (value == "separate") || (value == "all");
+            options.run_packed_arcs = (value == "packed") || (value == "all");
+            options.run_interleaved_arcs = (value == "interleaved") || (value == "all");
+        } else if (flag == "--phase") {
+            options.run_single_path_phase = (value == "single") || (value == "all");
+            options.run_blocking_flow_phase = (value == "blocking") || (value == "all");
+            options.run_forest_phase = (value == "forest") || (value == "all");
+        } else if (flag == "--maxiter") {
+            options.maxiter = std::stoul(std::string(value));
+        } else if (flag == "--min-yield") {
+            options.min_yield = std::stod(std::string(value));
+        } else if (flag == "--ssp-search") {
+            options.run_dijkstra_search = (value == "dijkstra") || (value == "all");
+            options.run_goal_directed_search = (value == "goal") || (value == "all");
+        } else if (flag == "--max-cost") {
+            options.max_cost = std::stoi(std::string(value));
+        } else if (flag == "--noise") {
+            options.noise = std::stof(std::string(value));
+        } else if (flag == "--seed") {
+            options.seed = std::stoull(std::string(value));
+        } else {
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    const auto has_zero_threads = std::ranges::any_of(
+            options.threads, [](const auto& n) { return n == 0; });
+    if ((options.max_cost < 1) || !(options.noise >= 0.0F) || has_zero_threads ||
+        !(options.min_yield >= 0.0)) {
+        print_usage(argv[0]);
+        std::exit(EXIT_FAILURE);
+    }
+
+    return options;
+}
+
+} // namespace
+
+auto
+main(int argc, char** argv) -> int
+{
+    const auto options = parse_options(argc, argv);
+
+    print_header();
+
+    for (const auto& size : options.sizes) {
+        if (size < 2) {
+            continue;
+        }
+
+        auto rng = std::mt19937_64(options.seed);
+        const auto problem = make_problem(size, options, rng);
+
+        // The network nodes are the vertices of the dual grid, which has one more row
+        // and column than the wrapped phase field.
+        const auto grid = ww::RectangularGridGraph<1>(size + 1, size + 1);
+        const auto cost = make_costs(grid.num_edges(), options.max_cost, rng);
+
+        if (options.run_grid) {
+            run_solvers("grid", grid, problem, cost, options);
+        }
+
+        // The compact grid graph has the same edge numbering as the grid graph.
+        if (options.run_compact) {
+            const auto compact = ww::CompactGridGraph<1>(
+                    static_cast<std::uint32_t>(size + 1),
+                    static_cast<std::uint32_t>(size + 1));
+            run_solvers("compact", compact, problem, cost, options);
+        }
+
+        if (options.run_csr) {
+            const auto csr = make_csr_graph<ww::CSRGraph<>>(grid);
+            const auto csr_cost = make_csr_costs(grid, csr, cost);
+            run_solvers("csr", csr, problem, csr_cost, options);
+        }
+
+        // A `CSRGraph` with 32-bit vertex and edge indices.
+        if (options.run_csr32) {
+            using CSRGraph32 = ww::CSRGraph<ww::Vector, std::uint32_t>;
+            const auto csr = make_csr_graph<CSRGraph32>(grid);
+            const auto csr_cost = make_csr_costs(grid, csr, cost);
+            run_solvers("csr32", csr, problem, csr_cost, options);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+// Microbenchmark of iterating over the outgoing edges of each vertex in a
+// `RectangularGridGraph`.
+//
+// Compares `RectangularGridGraph::outgoing_edges()`, which returns a fixed-capacity
+// range by value, against an equivalent coroutine-based implementation that returns a
+// `std::generator` (the previous implementation). Both traverse every (edge,head) pair
+// in an N x N grid and accumulate a checksum so that the loops are not optimized away.
+//
+// Usage:
+//
+//     bench-outgoing-edges [--size N] [--repeat N]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <generator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Graph = ww::RectangularGridGraph<>;
+using Vertex = Graph::vertex_type;
+using Edge = Graph::edge_type;
+
+// The previous, coroutine-based implementation of
+// `RectangularGridGraph::outgoing_edges()` (for a single edge between each pair of
+// adjacent vertices).
+[[nodiscard]] auto
+outgoing_edges_generator(const Graph& graph, Vertex vertex)
+        -> std::generator<std::pair<Edge, Vertex>>
+{
+    const auto i = vertex.first;
+    const auto j = vertex.second;
+
+    if (i != 0) {
+        co_yield std::pair(graph.get_up_edge(vertex), Vertex(i - 1, j));
+    }
+    if (j != 0) {
+        co_yield std::pair(graph.get_left_edge(vertex), Vertex(i, j - 1));
+    }
+    if (i + 1 != graph.num_rows()) {
+        co_yield std::pair(graph.get_down_edge(vertex), Vertex(i + 1, j));
+    }
+    if (j + 1 != graph.num_cols()) {
+        co_yield std::pair(graph.get_right_edge(vertex), Vertex(i, j + 1));
+    }
+}
+
+template<class OutgoingEdges>
+[[nodiscard]] auto
+traverse(const Graph& graph, OutgoingEdges&& outgoing_edges) -> std::uint64_t
+{
+    std::uint64_t checksum = 0;
+    for (const auto& tail : graph.vertices()) {
+        for (const auto& [edge, head] : outgoing_edges(tail)) {
+            checksum += edge + graph.get_vertex_id(head);
+        }
+    }
+    return checksum;
+}
+
+template<class OutgoingEdges>
+void
+run(std::string_view name,
+    const Graph& graph,
+    std::size_t repeat,
+    OutgoingEdges&& outgoing_edges)
+{
+    std::uint64_t checksum = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repeat; ++r) {
+        checksum += traverse(graph, outgoing_edges);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(stop - start).count();
+
+    const auto num_edges = static_cast<double>(graph.num_edges() * repeat);
+    std::printf("%-12.*s %11.3f %14.3f %20llu\n", static_cast<int>(name.size()),
+                name.data(), seconds, 1e9 * seconds / num_edges,
+                static_cast<unsigned long long>(checksum));
+    std::fflush(stdout);
+}
+
+void
+print_usage(const char* program)
+{
+    std::fprintf(stderr, "usage: %s [--size N] [--repeat N]\n", program);
+}
+
+} // namespace
+
+auto
+main(int argc, char** argv) -> int
+{
+    std::size_t size = 2048;
+    std::size_t repeat = 10;
+
+    for (int i = 1; i < argc; ++i) {
+        const auto flag = std::string_view(argv[i]);
+        if ((i + 1 >= argc) || ((flag != "--size") && (flag != "--repeat"))) {
+            print_usage(argv[0]);
+            return (flag == "-h") || (flag == "--help") ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        const auto value = std::stoul(std::string(argv[++i]));
+        if (flag == "--size") {
+            size = value;
+        } else {
+            repeat = value;
+        }
+    }
+
+    const auto graph = Graph(size, size);
+
+    std::printf("%-12s %11s %14s %20s\n", "impl", "time (s)", "ns/edge", "checksum");
+    run("static", graph, repeat,
+        [&](const Vertex& vertex) { return graph.outgoing_edges(vertex); });
+    run("generator", graph, repeat, [&](const Vertex& vertex) {
+        return outgoing_edges_generator(graph, vertex);
+    });
+
+    return EXIT_SUCCESS;
+}
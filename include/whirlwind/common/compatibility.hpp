@@ -23,3 +23,9 @@
 #else
 #define WHIRLWIND_UNLIKELY
 #endif
+
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define WHIRLWIND_HOST_DEVICE __host__ __device__
+#else
+#define WHIRLWIND_HOST_DEVICE
+#endif
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define WHIRLWIND_HAS_MMAP 1
+#else
+#include <fstream>
+#include <ios>
+#include <vector>
+#define WHIRLWIND_HAS_MMAP 0
+#endif
+
+#include "namespace.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A read-only memory mapping of the contents of a file.
+ *
+ * On POSIX systems, the file is mapped with `mmap(2)` using a shared mapping, so pages
+ * are loaded on demand and are shared between all processes that map the same file.
+ * On other platforms, the contents of the file are read into memory instead.
+ *
+ * `MappedFile` is movable but not copyable. The mapping is released when the object is
+ * destroyed, invalidating any views of its contents.
+ */
+class MappedFile {
+public:
+    /** Create an empty `MappedFile` that does not refer to any file. */
+    MappedFile() = default;
+
+    /**
+     * Map the contents of a file into memory.
+     *
+     * @param[in] path
+     *     The path of the file.
+     *
+     * @throws std::system_error
+     *     If the file could not be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path)
+    {
+#if WHIRLWIND_HAS_MMAP
+        const auto fd = ::open(path.c_str(), O_RDONLY); // NOLINT(*-vararg)
+        if (fd == -1) {
+            throw_system_error("failed to open file '" + path + "'");
+        }
+
+        struct ::stat st = {};
+        if (::fstat(fd, &st) == -1) {
+            const auto error = errno;
+            ::close(fd);
+            errno = error;
+            throw_system_error("failed to stat file '" + path + "'");
+        }
+
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ != 0) {
+            auto* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) { // NOLINT(*-cstyle-cast)
+                const auto error = errno;
+                ::close(fd);
+                errno = error;
+                throw_system_error("failed to map file '" + path + "'");
+            }
+            data_ = static_cast<const std::byte*>(addr);
+        }
+
+        // The mapping remains valid after the file descriptor is closed.
+        ::close(fd);
+#else
+        auto file = std::ifstream(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "failed to open file '" + path + "'");
+        }
+        buffer_.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(std::data(buffer_)),
+                  static_cast<std::streamsize>(std::size(buffer_)));
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::io_error),
+                                    "failed to read file '" + path + "'");
+        }
+        data_ = std::data(buffer_);
+        size_ = std::size(buffer_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    auto
+    operator=(const MappedFile&) -> MappedFile& = delete;
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+
+    auto
+    operator=(MappedFile&& other) noexcept -> MappedFile&
+    {
+        auto tmp = std::move(other);
+        swap(tmp);
+        return *this;
+    }
+
+    ~MappedFile() { unmap(); }
+
+    /** The contents of the file. */
+    [[nodiscard]] auto
+    bytes() const noexcept -> std::span<const std::byte>
+    {
+        return {data_, size_};
+    }
+
+    /** The size of the file, in bytes. */
+    [[nodiscard]] auto
+    size() const noexcept -> std::size_t
+    {
+        return size_;
+    }
+
+private:
+    [[noreturn]] static void
+    throw_system_error(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void
+    swap(MappedFile& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#if !WHIRLWIND_HAS_MMAP
+        std::swap(buffer_, other.buffer_);
+#endif
+    }
+
+    void
+    unmap() noexcept
+    {
+#if WHIRLWIND_HAS_MMAP
+        if (data_ != nullptr) {
+            // NOLINTNEXTLINE(*-const-cast)
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !WHIRLWIND_HAS_MMAP
+    std::vector<std::byte> buffer_;
+#endif
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assert.hpp"
+#include "namespace.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Get the default number of threads to use for parallel algorithms.
+ *
+ * Returns the number of concurrent threads supported by the hardware, or 1 if this
+ * cannot be determined.
+ */
+[[nodiscard]] inline auto
+default_num_threads() noexcept -> std::size_t
+{
+    const auto n = std::thread::hardware_concurrency();
+    return (n == 0) ? std::size_t{1} : static_cast<std::size_t>(n);
+}
+
+/**
+ * Partition a range of indices into contiguous chunks and process each chunk in
+ * parallel.
+ *
+ * The range [`first`, `last`) is split into at most `num_threads` contiguous chunks of
+ * approximately equal size, and `func(chunk_first, chunk_last)` is invoked once for
+ * each non-empty chunk. The first chunk is processed on the calling thread and each
+ * remaining chunk on a new thread. The function returns after all chunks have been
+ * processed. If any invocation of `func` throws an exception, the exception thrown by
+ * the lowest-indexed chunk is rethrown after all threads have been joined.
+ *
+ * If `num_threads` is 1 (or the range contains a single index), `func(first, last)` is
+ * invoked on the calling thread and no threads are created.
+ *
+ * @param[in] first
+ *     The first index in the range.
+ * @param[in] last
+ *     One past the last index in the range. Must be >= `first`.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1.
+ * @param[in] func
+ *     A callable object to invoke with the bounds of each chunk.
+ */
+template<class Func>
+void
+parallel_for_chunks(std::size_t first,
+                    std::size_t last,
+                    std::size_t num_threads,
+                    const Func& func)
+{
+    WHIRLWIND_ASSERT(first <= last);
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    const auto n = last - first;
+    const auto num_chunks = std::max(std::min(num_threads, n), std::size_t{1});
+    if (num_chunks == 1) {
+        func(first, last);
+        return;
+    }
+
+    // The first `n % num_chunks` chunks each contain one additional index.
+    const auto chunk_size = n / num_chunks;
+    const auto remainder = n % num_chunks;
+    const auto chunk_first = [&](std::size_t chunk) {
+        return first + chunk * chunk_size + std::min(chunk, remainder);
+    };
+
+    auto exceptions = std::vector<std::exception_ptr>(num_chunks);
+    const auto run_chunk = [&](std::size_t chunk) {
+        try {
+            func(chunk_first(chunk), chunk_first(chunk + 1));
+        } catch (...) {
+            exceptions[chunk] = std::current_exception();
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    threads.reserve(num_chunks - 1);
+    for (std::size_t chunk = 1; chunk < num_chunks; ++chunk) {
+        // If a new thread cannot be started, process the chunk on the calling thread
+        // instead.
+        try {
+            threads.emplace_back(run_chunk, chunk);
+        } catch (const std::system_error&) {
+            run_chunk(chunk);
+        }
+    }
+    run_chunk(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+/**
+ * A fixed set of worker threads for repeatedly processing ranges of indices in
+ * parallel.
+ *
+ * `parallel_for_chunks()` starts and joins a new thread for each chunk on every call.
+ * Algorithms that perform many short parallel steps (e.g. one per bucket of a
+ * delta-stepping search) may instead keep a `ThreadPool`, whose workers are started
+ * once and then sleep between calls to `ThreadPool::parallel_for_chunks()`.
+ *
+ * A pool must not be used by multiple threads concurrently, and the function passed to
+ * `parallel_for_chunks()` must not use the same pool.
+ */
+class ThreadPool {
+public:
+    /**
+     * Create a new `ThreadPool`.
+     *
+     * If a worker thread cannot be started, the pool uses fewer threads.
+     *
+     * @param[in] num_threads
+     *     The max number of threads to use, including the calling thread. Must be at
+     *     least 1. No worker threads are started if it is 1.
+     */
+    explicit ThreadPool(std::size_t num_threads = default_num_threads())
+    {
+        WHIRLWIND_ASSERT(num_threads >= 1);
+
+        workers_.reserve(num_threads - 1);
+        for (std::size_t worker = 0; worker + 1 < num_threads; ++worker) {
+            try {
+                workers_.emplace_back([this, worker] { run_worker(worker); });
+            } catch (const std::system_error&) {
+                break;
+            }
+        }
+        exceptions_.resize(std::size(workers_) + 1);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+
+    auto
+    operator=(const ThreadPool&) -> ThreadPool& = delete;
+    auto
+    operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+    ~ThreadPool()
+    {
+        stopping_ = true;
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /** The number of threads used, including the calling thread. */
+    [[nodiscard]] auto
+    num_threads() const noexcept -> std::size_t
+    {
+        return std::size(workers_) + 1;
+    }
+
+    /**
+     * Partition a range of indices into contiguous chunks and process each chunk in
+     * parallel.
+     *
+     * Equivalent to `whirlwind::parallel_for_chunks(first, last, num_threads(), func)`,
+     * except that the chunks after the first are processed by the pool's worker
+     * threads rather than by new threads.
+     *
+     * @param[in] first
+     *     The first index in the range.
+     * @param[in] last
+     *     One past the last index in the range. Must be >= `first`.
+     * @param[in] func
+     *     A callable object to invoke with the bounds of each chunk.
+     */
+    template<class Func>
+    void
+    parallel_for_chunks(std::size_t first, std::size_t last, const Func& func)
+    {
+        WHIRLWIND_ASSERT(first <= last);
+
+        const auto n = last - first;
+        const auto num_chunks = std::max(std::min(num_threads(), n), std::size_t{1});
+        if (num_chunks == 1) {
+            func(first, last);
+            return;
+        }
+
+        // Publish the job, then wake the workers. Each worker processes the chunk
+        // following its index (if any), so the calling thread processes the first.
+        first_ = first;
+        size_ = n;
+        num_chunks_ = num_chunks;
+        func_ = std::addressof(func);
+        invoke_ = [](const void* f, std::size_t chunk_first, std::size_t chunk_last) {
+            (*static_cast<const Func*>(f))(chunk_first, chunk_last);
+        };
+        pending_.store(std::size(workers_), std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+
+        run_chunk(0);
+
+        for (auto pending = pending_.load(std::memory_order_acquire); pending != 0;
+             pending = pending_.load(std::memory_order_acquire)) {
+            pending_.wait(pending, std::memory_order_acquire);
+        }
+
+        // Rethrow the exception thrown by the lowest-indexed chunk, if any.
+        auto exception = std::exception_ptr();
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            if (exceptions_[chunk] && !exception) {
+                exception = exceptions_[chunk];
+            }
+            exceptions_[chunk] = nullptr;
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    // Get the first index of a chunk of the current job. The first `size_ %
+    // num_chunks_` chunks each contain one additional index.
+    [[nodiscard]] auto
+    chunk_first(std::size_t chunk) const noexcept -> std::size_t
+    {
+        const auto chunk_size = size_ / num_chunks_;
+        const auto remainder = size_ % num_chunks_;
+        return first_ + chunk * chunk_size + std::min(chunk, remainder);
+    }
+
+    void
+    run_chunk(std::size_t chunk)
+    {
+        try {
+            invoke_(func_, chunk_first(chunk), chunk_first(chunk + 1));
+        } catch (...) {
+            exceptions_[chunk] = std::current_exception();
+        }
+    }
+
+    // Wait for each new job and process the worker's chunk of it (if any) until the
+    // pool is destroyed.
+    void
+    run_worker(std::size_t worker)
+    {
+        auto generation = std::size_t{0};
+        while (true) {
+            generation_.wait(generation, std::memory_order_acquire);
+            generation = generation_.load(std::memory_order_acquire);
+            if (stopping_) {
+                return;
+            }
+
+            if (worker + 1 < num_chunks_) {
+                run_chunk(worker + 1);
+            }
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                pending_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_ = {};
+    std::vector<std::exception_ptr> exceptions_ = {};
+
+    // The current job. Written by the calling thread before `generation_` is
+    // incremented, and read by the workers after observing the increment.
+    std::size_t first_ = 0;
+    std::size_t size_ = 0;
+    std::size_t num_chunks_ = 1;
+    const void* func_ = nullptr;
+    void (*invoke_)(const void*, std::size_t, std::size_t) = nullptr;
+    bool stopping_ = false;
+
+    // Incremented to wake the workers for each job (and on destruction).
+    std::atomic<std::size_t> generation_ = 0;
+    // The number of workers that haven't finished the current job.
+    std::atomic<std::size_t> pending_ = 0;
+};
+
+/**
+ * Partition a range of indices into contiguous chunks, reduce each chunk in parallel,
+ * and combine the partial results.
+ *
+ * The range [`first`, `last`) is split into chunks as in `parallel_for_chunks()`, and
+ * `func(chunk_first, chunk_last)` is invoked once for each chunk to compute its partial
+ * result. The partial results are then combined on the calling thread in chunk order,
+ * i.e. the result is `reduce(...reduce(reduce(init, r0), r1)..., rk)`. For a given
+ * number of threads, the result is therefore deterministic even if `reduce` is not
+ * associative (e.g. floating-point addition).
+ *
+ * @param[in] first
+ *     The first index in the range.
+ * @param[in] last
+ *     One past the last index in the range. Must be >= `first`.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1.
+ * @param[in] init
+ *     The initial value of the result.
+ * @param[in] reduce
+ *     A binary operation that combines two results.
+ * @param[in] func
+ *     A callable object that computes the partial result of a chunk from its bounds.
+ *
+ * @returns
+ *     The combined result.
+ */
+template<class T, class BinaryOp, class Func>
+[[nodiscard]] auto
+parallel_reduce_chunks(std::size_t first,
+                       std::size_t last,
+                       std::size_t num_threads,
+                       T init,
+                       const BinaryOp& reduce,
+                       const Func& func) -> T
+{
+    WHIRLWIND_ASSERT(first <= last);
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    const auto n = last - first;
+    const auto num_chunks = std::max(std::min(num_threads, n), std::size_t{1});
+    if (num_chunks == 1) {
+        return reduce(std::move(init), func(first, last));
+    }
+
+    // Use the same partition as `parallel_for_chunks()`, with one chunk per thread.
+    const auto chunk_size = n / num_chunks;
+    const auto remainder = n % num_chunks;
+    const auto chunk_first = [&](std::size_t chunk) {
+        return first + chunk * chunk_size + std::min(chunk, remainder);
+    };
+
+    auto partials = std::vector<std::optional<T>>(num_chunks);
+    parallel_for_chunks(0, num_chunks, num_chunks, [&](std::size_t c0, std::size_t c1) {
+        for (auto chunk = c0; chunk != c1; ++chunk) {
+            partials[chunk].emplace(func(chunk_first(chunk), chunk_first(chunk + 1)));
+        }
+    });
+
+    auto result = std::move(init);
+    for (auto& partial : partials) {
+        WHIRLWIND_DEBUG_ASSERT(partial.has_value());
+        result = reduce(std::move(result), std::move(*partial));
+    }
+    return result;
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// The memory resource of the innermost active `MemoryResourceScope` on this thread, or
+// null if there is none.
+inline thread_local std::pmr::memory_resource* current_memory_resource = nullptr;
+
+} // namespace detail
+
+/**
+ * Get the memory resource used by default-constructed `ArenaAllocator`s on the calling
+ * thread.
+ *
+ * @returns
+ *     The memory resource of the innermost active `MemoryResourceScope` on the calling
+ *     thread, or `std::pmr::get_default_resource()` if there is none.
+ */
+[[nodiscard]] inline auto
+get_current_memory_resource() noexcept -> std::pmr::memory_resource*
+{
+    auto* resource = detail::current_memory_resource;
+    return (resource != nullptr) ? resource : std::pmr::get_default_resource();
+}
+
+/**
+ * Sets the memory resource used by default-constructed `ArenaAllocator`s on the calling
+ * thread for the lifetime of the scope.
+ *
+ * Scopes may be nested. The previous resource is restored when the scope ends. The
+ * resource must outlive every container that allocated from it.
+ *
+ * For example, each object created within the scope below (including any internal
+ * arrays of the network and solver) allocates from a single arena, which is released
+ * all at once when `arena` is destroyed:
+ *
+ * ```
+ * auto arena = std::pmr::monotonic_buffer_resource();
+ * {
+ *     const auto scope = MemoryResourceScope(&arena);
+ *     auto network = Network<Graph, Cost, Flow, ArenaVector, Mixin>(...);
+ *     successive_shortest_paths<Dijkstra<Cost, ResidualGraph, ArenaVector>>(network);
+ * }
+ * ```
+ */
+class MemoryResourceScope {
+public:
+    /**
+     * Create a new `MemoryResourceScope`.
+     *
+     * @param[in] resource
+     *     The memory resource. Must not be null.
+     */
+    explicit MemoryResourceScope(std::pmr::memory_resource* resource) noexcept
+        : previous_(detail::current_memory_resource)
+    {
+        WHIRLWIND_ASSERT(resource != nullptr);
+        detail::current_memory_resource = resource;
+    }
+
+    MemoryResourceScope(const MemoryResourceScope&) = delete;
+    MemoryResourceScope(MemoryResourceScope&&) = delete;
+
+    auto
+    operator=(const MemoryResourceScope&) -> MemoryResourceScope& = delete;
+    auto
+    operator=(MemoryResourceScope&&) -> MemoryResourceScope& = delete;
+
+    ~MemoryResourceScope() { detail::current_memory_resource = previous_; }
+
+private:
+    std::pmr::memory_resource* previous_;
+};
+
+/**
+ * An allocator that allocates from a `std::pmr::memory_resource`.
+ *
+ * Unlike `std::pmr::polymorphic_allocator`, a default-constructed `ArenaAllocator`
+ * uses the memory resource of the enclosing `MemoryResourceScope` (see
+ * `get_current_memory_resource()`). Since the types in this library create their
+ * internal arrays from a single-parameter `Container` template, this allows them to
+ * allocate from a user-provided arena without passing an allocator to each
+ * constructor (see `ArenaVector`).
+ *
+ * Each container keeps the resource that it was created with. The allocator propagates
+ * on move assignment and swap, so moving a container never copies its elements, while
+ * a copy of a container allocates from the resource that is current when it's made.
+ *
+ * @tparam T
+ *     The element type.
+ */
+template<class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    /** Create a new `ArenaAllocator` that uses the current memory resource. */
+    ArenaAllocator() noexcept : resource_(get_current_memory_resource()) {}
+
+    /**
+     * Create a new `ArenaAllocator`.
+     *
+     * @param[in] resource
+     *     The memory resource. Must not be null.
+     */
+    explicit ArenaAllocator(std::pmr::memory_resource* resource) noexcept
+        : resource_(resource)
+    {
+        WHIRLWIND_ASSERT(resource_ != nullptr);
+    }
+
+    /** Create a new `ArenaAllocator` that uses the same resource as `other`. */
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept // NOLINT(*-explicit-*)
+        : resource_(other.resource())
+    {}
+
+    /** The memory resource. */
+    [[nodiscard]] auto
+    resource() const noexcept -> std::pmr::memory_resource*
+    {
+        return resource_;
+    }
+
+    [[nodiscard]] auto
+    allocate(size_type n) -> T*
+    {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T* p, size_type n) noexcept
+    {
+        resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // Copies of a container allocate from the current resource, like a new container.
+    [[nodiscard]] auto
+    select_on_container_copy_construction() const noexcept -> ArenaAllocator
+    {
+        return ArenaAllocator();
+    }
+
+    template<class U>
+    [[nodiscard]] friend auto
+    operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) noexcept -> bool
+    {
+        return (lhs.resource() == rhs.resource()) ||
+               lhs.resource()->is_equal(*rhs.resource());
+    }
+
+private:
+    std::pmr::memory_resource* resource_;
+};
+
+/**
+ * A `std::vector` that allocates from the current memory resource (see
+ * `ArenaAllocator`).
+ *
+ * May be used as the `Container` template parameter of any type in this library.
+ */
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+/**
+ * A `std::deque` that allocates from the current memory resource (see
+ * `ArenaAllocator`).
+ *
+ * May be used as the `Container` template parameter of `Queue`.
+ */
+template<class T>
+using ArenaDeque = std::deque<T, ArenaAllocator<T>>;
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A read-only, non-owning view of a contiguous array that can be used in place of
+ * `Vector` as the `Container` template argument of immutable data structures such as
+ * `CSRGraph`.
+ *
+ * A `ConstSpan` refers to memory owned elsewhere (for example, a memory-mapped file;
+ * see `MappedFile`), which must outlive it. Unlike `std::span`, it is
+ * default-constructible and copy-assignable and only provides const access to its
+ * elements.
+ *
+ * @tparam T
+ *     The element type.
+ */
+template<class T>
+class ConstSpan {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_reference = const value_type&;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    /** Create a new, empty `ConstSpan`. */
+    constexpr ConstSpan() = default;
+
+    /** Create a new `ConstSpan` referring to the elements of `data`. */
+    explicit constexpr ConstSpan(std::span<const value_type> data) noexcept
+        : data_(data)
+    {}
+
+    /** The number of elements. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return std::size(data_);
+    }
+
+    /** Check whether the span is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return std::empty(data_);
+    }
+
+    /** A pointer to the first element. */
+    [[nodiscard]] constexpr auto
+    data() const noexcept -> const value_type*
+    {
+        return std::data(data_);
+    }
+
+    /** Get the element at the specified position. */
+    [[nodiscard]] constexpr auto
+    operator[](size_type pos) const -> const_reference
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        return data_[pos];
+    }
+
+    /** Get the first element. The span must not be empty. */
+    [[nodiscard]] constexpr auto
+    front() const -> const_reference
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return data_.front();
+    }
+
+    /** Get the last element. The span must not be empty. */
+    [[nodiscard]] constexpr auto
+    back() const -> const_reference
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return data_.back();
+    }
+
+    /** Get an iterator to the first element. */
+    [[nodiscard]] constexpr auto
+    begin() const noexcept -> const_iterator
+    {
+        return data();
+    }
+
+    /** Get an iterator past the last element. */
+    [[nodiscard]] constexpr auto
+    end() const noexcept -> const_iterator
+    {
+        return data() + size();
+    }
+
+private:
+    std::span<const value_type> data_ = {};
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <whirlwind/common/namespace.hpp>
 
+#include "memory_usage.hpp"
 #include "vector.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
@@ -42,11 +43,39 @@ protected:
     using super_type::c;
 
 public:
+    using size_type = typename super_type::size_type;
+    using value_type = typename super_type::value_type;
+
     constexpr void
     clear() noexcept
     {
         c.clear();
     }
+
+    /**
+     * The number of bytes of memory owned by the heap's underlying container (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(c);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a heap.
+     *
+     * @param[in] max_size
+     *     The maximum number of elements in the heap at any one time.
+     *
+     * @returns
+     *     The estimated size of the heap's underlying container.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type max_size) noexcept -> size_type
+    {
+        return estimate_growable_array_memory<value_type, Container>(max_size);
+    }
 };
 
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+#include <whirlwind/common/namespace.hpp>
+
+#include "pair_like.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+template<class Heap, class T, class Key>
+concept IndexedHeapTypeImpl = requires(Heap h,
+                                       const Heap ch,
+                                       std::size_t id,
+                                       const T value,
+                                       const Key key) {
+    { ch.capacity() } -> std::convertible_to<std::size_t>;
+    { ch.size() } -> std::convertible_to<std::size_t>;
+    { ch.empty() } -> std::convertible_to<bool>;
+    { ch.contains(id) } -> std::convertible_to<bool>;
+    requires PairLike<std::remove_cvref_t<decltype(ch.top())>, T, Key>;
+
+    h.emplace(id, value, key);
+    h.decrease_key(id, key);
+    h.pop();
+    h.clear();
+};
+
+} // namespace detail
+
+/**
+ * An addressable min-heap of (value,key) pairs.
+ *
+ * Each element of an indexed heap is associated with a unique integer id in the range
+ * [0, N), where N is the heap's capacity. The id may be used to query whether the
+ * element is currently in the heap and to decrease its key without inserting a
+ * duplicate element.
+ */
+template<class Heap>
+concept IndexedHeapType = detail::
+        IndexedHeapTypeImpl<Heap, typename Heap::value_type::first_type,
+                            typename Heap::value_type::second_type>;
+
+WHIRLWIND_NAMESPACE_END
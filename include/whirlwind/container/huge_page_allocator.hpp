@@ -0,0 +1,321 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define WHIRLWIND_HAS_ANONYMOUS_MMAP 1
+#else
+#define WHIRLWIND_HAS_ANONYMOUS_MMAP 0
+#endif
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** The size of a huge page, in bytes. */
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20U;
+
+/** How large allocations are backed by huge pages. */
+enum class HugePagePolicy : unsigned char {
+    /**
+     * Map regular pages aligned to huge page boundaries and advise the kernel to back
+     * them with transparent huge pages (`madvise(MADV_HUGEPAGE)`).
+     */
+    transparent,
+    /**
+     * Map huge pages from the reserved pool (`MAP_HUGETLB`), falling back to
+     * `transparent` if the pool is exhausted or unavailable.
+     */
+    reserved,
+};
+
+/** Where the pages of large allocations are placed on NUMA systems. */
+enum class NumaPlacement : unsigned char {
+    /**
+     * Pages are placed on the NUMA node of the thread that first writes to them (the
+     * default policy of the operating system).
+     */
+    first_touch,
+    /**
+     * Pages are touched by the allocating thread when the memory is allocated, which
+     * places them on its NUMA node regardless of which threads access them later.
+     */
+    allocating_thread,
+};
+
+/** Options for allocating memory backed by huge pages. */
+struct HugePageOptions {
+    /** How large allocations are backed by huge pages. */
+    HugePagePolicy policy = HugePagePolicy::transparent;
+    /** Where the pages of large allocations are placed on NUMA systems. */
+    NumaPlacement placement = NumaPlacement::first_touch;
+    /**
+     * The minimum size, in bytes, of an allocation that is backed by huge pages.
+     * Smaller allocations are forwarded to the upstream resource.
+     */
+    std::size_t threshold = huge_page_size;
+};
+
+namespace detail {
+
+// Round a size up to a whole number of huge pages.
+[[nodiscard]] constexpr auto
+round_up_to_huge_pages(std::size_t bytes) noexcept -> std::size_t
+{
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+#if WHIRLWIND_HAS_ANONYMOUS_MMAP
+
+// Map `size` bytes of anonymous memory (a multiple of `huge_page_size`) aligned to a
+// huge page boundary. Returns null on failure.
+[[nodiscard]] inline auto
+map_aligned(std::size_t size) noexcept -> void*
+{
+    constexpr auto prot = PROT_READ | PROT_WRITE;
+    constexpr auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    // Over-allocate by one huge page and unmap the unaligned head and tail.
+    auto* addr = ::mmap(nullptr, size + huge_page_size, prot, flags, -1, 0);
+    if (addr == MAP_FAILED) { // NOLINT(*-cstyle-cast)
+        return nullptr;
+    }
+    auto* first = static_cast<std::byte*>(addr);
+    // NOLINTNEXTLINE(*-reinterpret-cast)
+    const auto offset = reinterpret_cast<std::uintptr_t>(first) % huge_page_size;
+    const auto head = (offset == 0) ? std::size_t{0} : huge_page_size - offset;
+    if (head > 0) {
+        ::munmap(first, head);
+    }
+    if (const auto tail = huge_page_size - head; tail > 0) {
+        ::munmap(first + head + size, tail);
+    }
+    return first + head;
+}
+
+// Map `size` bytes (a multiple of `huge_page_size`) backed by huge pages according to
+// `options`. Returns null on failure.
+[[nodiscard]] inline auto
+map_huge_pages(std::size_t size, const HugePageOptions& options) noexcept -> void*
+{
+    void* p = nullptr;
+#if defined(MAP_HUGETLB)
+    if (options.policy == HugePagePolicy::reserved) {
+        constexpr auto prot = PROT_READ | PROT_WRITE;
+        constexpr auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+        auto* addr = ::mmap(nullptr, size, prot, flags, -1, 0);
+        if (addr != MAP_FAILED) { // NOLINT(*-cstyle-cast)
+            p = addr;
+        }
+    }
+#endif
+    if (p == nullptr) {
+        p = map_aligned(size);
+        if (p == nullptr) {
+            return nullptr;
+        }
+#if defined(MADV_HUGEPAGE)
+        // The advice is best-effort, e.g. if transparent huge pages are disabled.
+        ::madvise(p, size, MADV_HUGEPAGE);
+#endif
+    }
+
+    if (options.placement == NumaPlacement::allocating_thread) {
+        // Anonymous pages are zero-filled, so writing a zero to each page faults it in
+        // without changing its contents.
+        constexpr std::size_t small_page_size = 4096;
+        auto* bytes = static_cast<volatile std::byte*>(p);
+        for (std::size_t i = 0; i < size; i += small_page_size) {
+            bytes[i] = std::byte{0};
+        }
+    }
+    return p;
+}
+
+inline void
+unmap_huge_pages(void* p, std::size_t size) noexcept
+{
+    ::munmap(p, size);
+}
+
+#endif
+
+// Allocate memory for `bytes` bytes aligned to `alignment` according to `options`,
+// forwarding allocations below the threshold to `upstream`.
+[[nodiscard]] inline auto
+allocate_huge_pages(std::size_t bytes,
+                    std::size_t alignment,
+                    const HugePageOptions& options,
+                    std::pmr::memory_resource* upstream) -> void*
+{
+#if WHIRLWIND_HAS_ANONYMOUS_MMAP
+    if (bytes >= options.threshold && bytes > 0) {
+        WHIRLWIND_ASSERT(alignment <= huge_page_size);
+        auto* p = map_huge_pages(round_up_to_huge_pages(bytes), options);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+#endif
+    return upstream->allocate(bytes, alignment);
+}
+
+// Deallocate memory returned by `allocate_huge_pages()` with the same arguments.
+inline void
+deallocate_huge_pages(void* p,
+                      std::size_t bytes,
+                      std::size_t alignment,
+                      const HugePageOptions& options,
+                      std::pmr::memory_resource* upstream)
+{
+#if WHIRLWIND_HAS_ANONYMOUS_MMAP
+    if (bytes >= options.threshold && bytes > 0) {
+        unmap_huge_pages(p, round_up_to_huge_pages(bytes));
+        return;
+    }
+#endif
+    upstream->deallocate(p, bytes, alignment);
+}
+
+} // namespace detail
+
+/**
+ * A memory resource that backs large allocations with huge pages.
+ *
+ * Allocations of at least `HugePageOptions::threshold` bytes are mapped directly from
+ * the operating system, aligned to `huge_page_size` and rounded up to a whole number of
+ * huge pages, so that large arrays (e.g. the arc costs and flows of a `Network` or the
+ * distances and predecessors of a `Dijkstra` solver) incur fewer TLB misses. Smaller
+ * allocations are forwarded to the upstream resource. On platforms without anonymous
+ * memory mappings, all allocations are forwarded to the upstream resource.
+ *
+ * The resource may be installed with `MemoryResourceScope` so that `ArenaVector`
+ * containers allocate from it, or used as the upstream resource of an arena such as
+ * `std::pmr::monotonic_buffer_resource`. See `HugePageVector` for a container that
+ * always uses the default options.
+ */
+class HugePageMemoryResource : public std::pmr::memory_resource {
+public:
+    /**
+     * Create a new `HugePageMemoryResource`.
+     *
+     * @param[in] options
+     *     Options for allocations backed by huge pages.
+     * @param[in] upstream
+     *     The resource used for allocations below the threshold. Must not be null.
+     */
+    explicit HugePageMemoryResource(
+            const HugePageOptions& options = {},
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : options_(options), upstream_(upstream)
+    {
+        WHIRLWIND_ASSERT(upstream_ != nullptr);
+    }
+
+    /** Options for allocations backed by huge pages. */
+    [[nodiscard]] auto
+    options() const noexcept -> const HugePageOptions&
+    {
+        return options_;
+    }
+
+    /** The resource used for allocations below the threshold. */
+    [[nodiscard]] auto
+    upstream_resource() const noexcept -> std::pmr::memory_resource*
+    {
+        return upstream_;
+    }
+
+private:
+    HugePageOptions options_;
+    std::pmr::memory_resource* upstream_;
+
+    auto
+    do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+    {
+        return detail::allocate_huge_pages(bytes, alignment, options_, upstream_);
+    }
+
+    void
+    do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        detail::deallocate_huge_pages(p, bytes, alignment, options_, upstream_);
+    }
+
+    [[nodiscard]] auto
+    do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * A stateless allocator that backs large allocations with transparent huge pages.
+ *
+ * Uses the default `HugePageOptions`, i.e. allocations of at least `huge_page_size`
+ * bytes are mapped directly from the operating system and their pages are placed on
+ * the NUMA node of the thread that first writes to them. Smaller allocations use
+ * `operator new`. Use `HugePageMemoryResource` for other options.
+ *
+ * @tparam T
+ *     The element type.
+ */
+template<class T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using is_always_equal = std::true_type;
+
+    constexpr HugePageAllocator() noexcept = default;
+
+    template<class U>
+    constexpr HugePageAllocator( // NOLINT(*-explicit-*)
+            const HugePageAllocator<U>&) noexcept
+    {}
+
+    [[nodiscard]] auto
+    allocate(size_type n) -> T*
+    {
+        if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        auto* p = detail::allocate_huge_pages(n * sizeof(T), alignof(T), {},
+                                              std::pmr::new_delete_resource());
+        return static_cast<T*>(p);
+    }
+
+    void
+    deallocate(T* p, size_type n) noexcept
+    {
+        detail::deallocate_huge_pages(p, n * sizeof(T), alignof(T), {},
+                                      std::pmr::new_delete_resource());
+    }
+
+    template<class U>
+    [[nodiscard]] friend constexpr auto
+    operator==(const HugePageAllocator&, const HugePageAllocator<U>&) noexcept -> bool
+    {
+        return true;
+    }
+};
+
+/**
+ * A `std::vector` whose large arrays are backed by transparent huge pages (see
+ * `HugePageAllocator`).
+ *
+ * May be used as the `Container` template parameter of any type in this library.
+ */
+template<class T>
+using HugePageVector = std::vector<T, HugePageAllocator<T>>;
+
+WHIRLWIND_NAMESPACE_END
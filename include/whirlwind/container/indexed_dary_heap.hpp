@@ -0,0 +1,294 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "memory_usage.hpp"
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * An indexed d-ary min-heap of (value,key) pairs.
+ *
+ * Each element in the heap is identified by a unique id in the range [0, N), where N
+ * is the capacity of the heap. The heap stores the position of each element so that
+ * its key may be decreased in O(log_D(n)) time, without inserting a duplicate element.
+ *
+ * @tparam T
+ *     The value type.
+ * @tparam Key
+ *     The key (priority) type. Elements with smaller keys have higher priority.
+ * @tparam D
+ *     The arity of the heap (the maximum number of children of each node). Must be at
+ *     least 2.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal arrays of heap
+ *     nodes and positions.
+ */
+template<class T,
+         class Key,
+         std::size_t D = 4,
+         template<class> class Container = Vector>
+class IndexedDaryHeap {
+    WHIRLWIND_STATIC_ASSERT(D >= 2);
+
+public:
+    using value_type = std::pair<T, Key>;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    /**
+     * Create a new, empty `IndexedDaryHeap`.
+     *
+     * @param[in] capacity
+     *     The maximum number of elements in the heap. Element ids must be in the range
+     *     [0, `capacity`).
+     */
+    explicit constexpr IndexedDaryHeap(size_type capacity = 0)
+        : nodes_(), position_(capacity, npos)
+    {
+        nodes_.reserve(capacity);
+        WHIRLWIND_DEBUG_ASSERT(std::size(position_) == capacity);
+    }
+
+    /** The arity of the heap. */
+    [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
+    arity() noexcept -> size_type
+    {
+        return D;
+    }
+
+    /** The maximum number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    capacity() const noexcept -> size_type
+    {
+        return std::size(position_);
+    }
+
+    /** The number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return std::size(nodes_);
+    }
+
+    /** Check whether the heap is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return std::empty(nodes_);
+    }
+
+    /** Check whether the heap contains an element with the specified id. */
+    [[nodiscard]] constexpr auto
+    contains(size_type id) const -> bool
+    {
+        WHIRLWIND_ASSERT(id < capacity());
+        return position_[id] != npos;
+    }
+
+    /**
+     * Get the key of the element with the specified id.
+     *
+     * @param[in] id
+     *     The element id. The heap must contain an element with this id.
+     *
+     * @returns
+     *     The element's key.
+     */
+    [[nodiscard]] constexpr auto
+    key(size_type id) const -> const Key&
+    {
+        WHIRLWIND_ASSERT(contains(id));
+        const auto pos = position_[id];
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+        return nodes_[pos].value.second;
+    }
+
+    /** Get the (value,key) pair with the smallest key. The heap must not be empty. */
+    [[nodiscard]] constexpr auto
+    top() const -> const value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return nodes_.front().value;
+    }
+
+    /**
+     * Insert a new element into the heap.
+     *
+     * @param[in] id
+     *     The element id. Must be in the range [0, `capacity()`). The heap must not
+     *     already contain an element with this id.
+     * @param[in] value
+     *     The element value.
+     * @param[in] key
+     *     The element key.
+     */
+    constexpr void
+    emplace(size_type id, T value, Key key)
+    {
+        WHIRLWIND_ASSERT(!contains(id));
+        const auto pos = size();
+        nodes_.push_back({value_type(std::move(value), std::move(key)), id});
+        position_[id] = pos;
+        sift_up(pos);
+    }
+
+    /**
+     * Decrease the key of an element in the heap.
+     *
+     * @param[in] id
+     *     The element id. The heap must contain an element with this id.
+     * @param[in] key
+     *     The new key. Must not be greater than the element's current key.
+     */
+    constexpr void
+    decrease_key(size_type id, Key key)
+    {
+        WHIRLWIND_ASSERT(contains(id));
+        const auto pos = position_[id];
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+        WHIRLWIND_ASSERT(!(nodes_[pos].value.second < key));
+        nodes_[pos].value.second = std::move(key);
+        sift_up(pos);
+    }
+
+    /** Remove the element with the smallest key. The heap must not be empty. */
+    constexpr void
+    pop()
+    {
+        WHIRLWIND_ASSERT(!empty());
+        position_[nodes_.front().id] = npos;
+
+        if (size() > 1) {
+            nodes_.front() = std::move(nodes_.back());
+            position_[nodes_.front().id] = 0;
+            nodes_.pop_back();
+            sift_down(0);
+        } else {
+            nodes_.pop_back();
+        }
+    }
+
+    /**
+     * Remove all elements from the heap.
+     *
+     * Runs in time proportional to the number of elements in the heap, rather than
+     * its capacity.
+     */
+    constexpr void
+    clear() noexcept
+    {
+        for (const auto& node : nodes_) {
+            position_[node.id] = npos;
+        }
+        nodes_.clear();
+    }
+
+    /**
+     * The number of bytes of memory owned by the heap's arrays of nodes and positions
+     * (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(nodes_) + get_memory_usage(position_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a heap.
+     *
+     * @param[in] capacity
+     *     The maximum number of elements in the heap.
+     *
+     * @returns
+     *     The estimated size of the heap's arrays of nodes and positions.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type capacity) noexcept -> size_type
+    {
+        return estimate_array_memory<node_type, Container>(capacity) +
+               estimate_array_memory<size_type, Container>(capacity);
+    }
+
+private:
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    struct node_type {
+        value_type value;
+        size_type id;
+    };
+
+    [[nodiscard]] constexpr auto
+    less(size_type lhs, size_type rhs) const -> bool
+    {
+        return nodes_[lhs].value.second < nodes_[rhs].value.second;
+    }
+
+    constexpr void
+    sift_up(size_type pos)
+    {
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+        auto node = std::move(nodes_[pos]);
+
+        while (pos > 0) {
+            const auto parent = (pos - 1) / D;
+            if (!(node.value.second < nodes_[parent].value.second)) {
+                break;
+            }
+            nodes_[pos] = std::move(nodes_[parent]);
+            position_[nodes_[pos].id] = pos;
+            pos = parent;
+        }
+
+        position_[node.id] = pos;
+        nodes_[pos] = std::move(node);
+    }
+
+    constexpr void
+    sift_down(size_type pos)
+    {
+        const auto n = size();
+        WHIRLWIND_DEBUG_ASSERT(pos < n);
+        auto node = std::move(nodes_[pos]);
+
+        while (true) {
+            const auto first_child = D * pos + 1;
+            if (first_child >= n) {
+                break;
+            }
+
+            // Find the child with the smallest key.
+            const auto last_child = (first_child + D < n) ? first_child + D : n;
+            auto min_child = first_child;
+            for (auto child = first_child + 1; child < last_child; ++child) {
+                if (less(child, min_child)) {
+                    min_child = child;
+                }
+            }
+
+            if (!(nodes_[min_child].value.second < node.value.second)) {
+                break;
+            }
+            nodes_[pos] = std::move(nodes_[min_child]);
+            position_[nodes_[pos].id] = pos;
+            pos = min_child;
+        }
+
+        position_[node.id] = pos;
+        nodes_[pos] = std::move(node);
+    }
+
+    container_type<node_type> nodes_;
+    container_type<size_type> position_;
+};
+
+WHIRLWIND_NAMESPACE_END
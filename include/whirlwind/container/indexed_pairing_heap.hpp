@@ -0,0 +1,330 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "memory_usage.hpp"
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * An indexed pairing min-heap of (value,key) pairs.
+ *
+ * Each element in the heap is identified by a unique id in the range [0, N), where N
+ * is the capacity of the heap. Heap nodes are stored in a preallocated array indexed
+ * by element id, so inserting elements and decreasing their keys never allocates
+ * memory. Insertion and decrease-key run in O(1) time, and removing the top element
+ * runs in amortized O(log(n)) time.
+ *
+ * @tparam T
+ *     The value type. Must be default constructible.
+ * @tparam Key
+ *     The key (priority) type. Elements with smaller keys have higher priority. Must
+ *     be default constructible.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal array of heap
+ *     nodes.
+ */
+template<class T, class Key, template<class> class Container = Vector>
+class IndexedPairingHeap {
+public:
+    using value_type = std::pair<T, Key>;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    /**
+     * Create a new, empty `IndexedPairingHeap`.
+     *
+     * @param[in] capacity
+     *     The maximum number of elements in the heap. Element ids must be in the range
+     *     [0, `capacity`).
+     */
+    explicit constexpr IndexedPairingHeap(size_type capacity = 0)
+        : nodes_(capacity), worklist_(), root_(npos), size_(0)
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(nodes_) == capacity);
+    }
+
+    /** The maximum number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    capacity() const noexcept -> size_type
+    {
+        return std::size(nodes_);
+    }
+
+    /** The number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** Check whether the heap is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return root_ == npos;
+    }
+
+    /** Check whether the heap contains an element with the specified id. */
+    [[nodiscard]] constexpr auto
+    contains(size_type id) const -> bool
+    {
+        WHIRLWIND_ASSERT(id < capacity());
+        return nodes_[id].in_heap;
+    }
+
+    /**
+     * Get the key of the element with the specified id.
+     *
+     * @param[in] id
+     *     The element id. The heap must contain an element with this id.
+     *
+     * @returns
+     *     The element's key.
+     */
+    [[nodiscard]] constexpr auto
+    key(size_type id) const -> const Key&
+    {
+        WHIRLWIND_ASSERT(contains(id));
+        return nodes_[id].value.second;
+    }
+
+    /** Get the (value,key) pair with the smallest key. The heap must not be empty. */
+    [[nodiscard]] constexpr auto
+    top() const -> const value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return nodes_[root_].value;
+    }
+
+    /**
+     * Insert a new element into the heap.
+     *
+     * @param[in] id
+     *     The element id. Must be in the range [0, `capacity()`). The heap must not
+     *     already contain an element with this id.
+     * @param[in] value
+     *     The element value.
+     * @param[in] key
+     *     The element key.
+     */
+    constexpr void
+    emplace(size_type id, T value, Key key)
+    {
+        WHIRLWIND_ASSERT(!contains(id));
+        auto& node = nodes_[id];
+        node.value = value_type(std::move(value), std::move(key));
+        node.child = npos;
+        node.next = npos;
+        node.prev = npos;
+        node.in_heap = true;
+        root_ = meld(root_, id);
+        ++size_;
+    }
+
+    /**
+     * Decrease the key of an element in the heap.
+     *
+     * @param[in] id
+     *     The element id. The heap must contain an element with this id.
+     * @param[in] key
+     *     The new key. Must not be greater than the element's current key.
+     */
+    constexpr void
+    decrease_key(size_type id, Key key)
+    {
+        WHIRLWIND_ASSERT(contains(id));
+        WHIRLWIND_ASSERT(!(nodes_[id].value.second < key));
+        nodes_[id].value.second = std::move(key);
+
+        if (id != root_) {
+            cut(id);
+            root_ = meld(root_, id);
+        }
+    }
+
+    /** Remove the element with the smallest key. The heap must not be empty. */
+    constexpr void
+    pop()
+    {
+        WHIRLWIND_ASSERT(!empty());
+        auto& node = nodes_[root_];
+        const auto first_child = node.child;
+        node.child = npos;
+        node.in_heap = false;
+        root_ = merge_pairs(first_child);
+        --size_;
+    }
+
+    /**
+     * Remove all elements from the heap.
+     *
+     * Runs in time proportional to the number of elements in the heap, rather than
+     * its capacity.
+     */
+    constexpr void
+    clear()
+    {
+        worklist_.clear();
+        if (!empty()) {
+            worklist_.push_back(root_);
+        }
+
+        while (!std::empty(worklist_)) {
+            const auto id = worklist_.back();
+            worklist_.pop_back();
+
+            auto& node = nodes_[id];
+            for (auto child = node.child; child != npos; child = nodes_[child].next) {
+                worklist_.push_back(child);
+            }
+            node.child = npos;
+            node.in_heap = false;
+        }
+
+        root_ = npos;
+        size_ = 0;
+    }
+
+    /**
+     * The number of bytes of memory owned by the heap's array of nodes and its
+     * internal worklist (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(nodes_) + get_memory_usage(worklist_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a heap.
+     *
+     * @param[in] capacity
+     *     The maximum number of elements in the heap.
+     *
+     * @returns
+     *     The estimated size of the heap's array of nodes and its internal worklist,
+     *     which may hold up to `capacity` node indices.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type capacity) noexcept -> size_type
+    {
+        return estimate_array_memory<node_type, Container>(capacity) +
+               estimate_growable_array_memory<size_type, Container>(capacity);
+    }
+
+private:
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    struct node_type {
+        value_type value = {};
+
+        // The first child of the node.
+        size_type child = npos;
+
+        // The next sibling of the node.
+        size_type next = npos;
+
+        // The previous sibling of the node, or its parent if it is the first child.
+        size_type prev = npos;
+
+        bool in_heap = false;
+    };
+
+    // Link two detached heap-ordered trees and return the root of the result.
+    [[nodiscard]] constexpr auto
+    meld(size_type lhs, size_type rhs) -> size_type
+    {
+        if (lhs == npos) {
+            return rhs;
+        }
+        if (rhs == npos) {
+            return lhs;
+        }
+
+        if (nodes_[rhs].value.second < nodes_[lhs].value.second) {
+            std::swap(lhs, rhs);
+        }
+
+        // Make `rhs` the first child of `lhs`.
+        auto& parent = nodes_[lhs];
+        auto& child = nodes_[rhs];
+        child.prev = lhs;
+        child.next = parent.child;
+        if (parent.child != npos) {
+            nodes_[parent.child].prev = rhs;
+        }
+        parent.child = rhs;
+
+        return lhs;
+    }
+
+    // Detach a non-root node (and its subtree) from its parent and siblings.
+    constexpr void
+    cut(size_type id)
+    {
+        auto& node = nodes_[id];
+        WHIRLWIND_DEBUG_ASSERT(node.prev != npos);
+
+        auto& prev = nodes_[node.prev];
+        if (prev.child == id) {
+            prev.child = node.next;
+        } else {
+            prev.next = node.next;
+        }
+        if (node.next != npos) {
+            nodes_[node.next].prev = node.prev;
+        }
+
+        node.prev = npos;
+        node.next = npos;
+    }
+
+    // Merge a list of sibling trees using the standard two-pass pairing strategy and
+    // return the root of the result.
+    [[nodiscard]] constexpr auto
+    merge_pairs(size_type first) -> size_type
+    {
+        // First pass: meld pairs of trees from left to right.
+        worklist_.clear();
+        auto id = first;
+        while (id != npos) {
+            const auto lhs = id;
+            const auto rhs = nodes_[lhs].next;
+            id = (rhs != npos) ? nodes_[rhs].next : npos;
+
+            nodes_[lhs].prev = npos;
+            nodes_[lhs].next = npos;
+            if (rhs != npos) {
+                nodes_[rhs].prev = npos;
+                nodes_[rhs].next = npos;
+            }
+
+            worklist_.push_back(meld(lhs, rhs));
+        }
+
+        // Second pass: meld the resulting trees from right to left.
+        auto root = npos;
+        while (!std::empty(worklist_)) {
+            root = meld(worklist_.back(), root);
+            worklist_.pop_back();
+        }
+
+        return root;
+    }
+
+    container_type<node_type> nodes_;
+    container_type<size_type> worklist_;
+    size_type root_;
+    size_type size_;
+};
+
+WHIRLWIND_NAMESPACE_END
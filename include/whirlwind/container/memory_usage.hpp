@@ -0,0 +1,137 @@
+#pragma once
+
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <whirlwind/common/namespace.hpp>
+
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+template<class T>
+struct IsStdVectorBool : std::false_type {};
+
+template<class Allocator>
+struct IsStdVectorBool<std::vector<bool, Allocator>> : std::true_type {};
+
+// Check whether an object reports its own memory usage.
+template<class T>
+concept HasMemoryUsage = requires(const T& x) {
+    { x.memory_usage() } -> std::convertible_to<std::size_t>;
+};
+
+// Check whether an object is a `std::vector`-like container that owns a contiguous,
+// possibly over-allocated, array of elements.
+template<class T>
+concept OwningContiguousContainer = requires(const T& x) {
+    typename T::value_type;
+    { x.capacity() } -> std::convertible_to<std::size_t>;
+    { std::data(x) } -> std::convertible_to<const typename T::value_type*>;
+};
+
+} // namespace detail
+
+/**
+ * Get the number of bytes of dynamically allocated memory owned by an object.
+ *
+ * Objects that provide a `memory_usage()` member function report their own usage. The
+ * usage of a `std::vector`-like container is its capacity times the size of its
+ * elements, plus the memory owned by each element. Any other object (e.g. a grid graph
+ * or a non-owning view such as `ConstSpan`) is assumed to own no memory. The size of
+ * the object itself (i.e. `sizeof(x)`) is not included.
+ *
+ * @param[in] x
+ *     The object.
+ *
+ * @returns
+ *     The number of bytes of memory owned by `x`.
+ */
+template<class T>
+[[nodiscard]] constexpr auto
+get_memory_usage(const T& x) -> std::size_t
+{
+    if constexpr (detail::HasMemoryUsage<T>) {
+        return static_cast<std::size_t>(x.memory_usage());
+    } else if constexpr (detail::IsStdVectorBool<T>::value) {
+        return (static_cast<std::size_t>(x.capacity()) + CHAR_BIT - 1) / CHAR_BIT;
+    } else if constexpr (detail::OwningContiguousContainer<T>) {
+        using Value = typename T::value_type;
+        auto bytes = static_cast<std::size_t>(x.capacity()) * sizeof(Value);
+        if constexpr (detail::HasMemoryUsage<Value> ||
+                      detail::IsStdVectorBool<Value>::value ||
+                      detail::OwningContiguousContainer<Value>) {
+            for (const auto& value : x) {
+                bytes += get_memory_usage(value);
+            }
+        }
+        return bytes;
+    } else {
+        return 0;
+    }
+}
+
+/**
+ * Estimate the number of bytes of memory needed to store an array of elements in a
+ * `Container`.
+ *
+ * Spare capacity is not included. See `estimate_growable_array_memory()` for arrays
+ * that grow on demand.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam Container
+ *     A `std::vector`-like type template.
+ *
+ * @param[in] size
+ *     The number of elements.
+ *
+ * @returns
+ *     The estimated number of bytes.
+ */
+template<class T, template<class> class Container = Vector>
+[[nodiscard]] constexpr auto
+estimate_array_memory(std::size_t size) noexcept -> std::size_t
+{
+    if constexpr (detail::IsStdVectorBool<Container<T>>::value) {
+        // Bits are packed into whole words.
+        constexpr auto word_bits = CHAR_BIT * sizeof(std::size_t);
+        return (size + word_bits - 1) / word_bits * sizeof(std::size_t);
+    } else {
+        return size * sizeof(T);
+    }
+}
+
+/**
+ * Estimate the number of bytes of memory needed by a `Container` that grows on demand
+ * (e.g. by `push_back()`) up to some max size.
+ *
+ * The capacity of a growable container may exceed its size. The estimate is an upper
+ * bound assuming geometric growth by a factor of at most 2, as in common
+ * implementations of `std::vector`.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam Container
+ *     A `std::vector`-like type template.
+ *
+ * @param[in] max_size
+ *     The max number of elements.
+ *
+ * @returns
+ *     The estimated number of bytes.
+ */
+template<class T, template<class> class Container = Vector>
+[[nodiscard]] constexpr auto
+estimate_growable_array_memory(std::size_t max_size) noexcept -> std::size_t
+{
+    return estimate_array_memory<T, Container>(2 * max_size);
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "memory_usage.hpp"
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A monotone min-heap of (value,key) pairs with non-negative integer keys.
+ *
+ * A radix heap partitions its elements into O(log(C)) buckets, where C is the range of
+ * the key type, based on the position of the highest bit in which each key differs
+ * from the most recently extracted minimum key. It is a monotone priority queue: each
+ * inserted key must be no less than the key of the last element removed from the
+ * heap (or the smallest key currently in the heap). This is satisfied by Dijkstra's
+ * algorithm with non-negative edge lengths.
+ *
+ * Insertion takes O(1) time. Removing the top element takes amortized O(log(C)) time,
+ * independent of the range of keys actually present in the heap.
+ *
+ * @tparam T
+ *     The value type.
+ * @tparam Key
+ *     The key (priority) type. Must be an integral type. Keys must be non-negative.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the contents of each bucket.
+ */
+template<class T, class Key, template<class> class Container = Vector>
+class RadixHeap {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Key>);
+
+private:
+    using unsigned_key_type = std::make_unsigned_t<Key>;
+
+public:
+    using value_type = std::pair<T, Key>;
+    using key_type = Key;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    /** Create a new, empty `RadixHeap`. */
+    constexpr RadixHeap() = default;
+
+    /** The number of buckets. */
+    [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
+    num_buckets() noexcept -> size_type
+    {
+        return std::numeric_limits<unsigned_key_type>::digits + 1;
+    }
+
+    /** The number of elements in the heap. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** Check whether the heap is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * A lower bound on the keys of elements in the heap.
+     *
+     * New elements must not have a smaller key.
+     */
+    [[nodiscard]] constexpr auto
+    min_key() const noexcept -> const key_type&
+    {
+        return last_key_;
+    }
+
+    /**
+     * Get the (value,key) pair with the smallest key. The heap must not be empty.
+     *
+     * If no element has a key equal to `min_key()`, the elements of the first
+     * non-empty bucket are first redistributed among the lower buckets.
+     */
+    [[nodiscard]] constexpr auto
+    top() -> const value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        if (std::empty(buckets_[0])) WHIRLWIND_UNLIKELY {
+            redistribute();
+        }
+        WHIRLWIND_DEBUG_ASSERT(!std::empty(buckets_[0]));
+        return buckets_[0].back();
+    }
+
+    /**
+     * Insert a new element into the heap.
+     *
+     * @param[in] value
+     *     The element value.
+     * @param[in] key
+     *     The element key. Must not be less than `min_key()`.
+     */
+    constexpr void
+    emplace(T value, Key key)
+    {
+        WHIRLWIND_ASSERT(!(key < min_key()));
+        auto& bucket = buckets_[get_bucket_id(key)];
+        bucket.emplace_back(std::move(value), std::move(key));
+        ++size_;
+    }
+
+    /** Remove the element with the smallest key. The heap must not be empty. */
+    constexpr void
+    pop()
+    {
+        WHIRLWIND_ASSERT(!empty());
+        if (std::empty(buckets_[0])) WHIRLWIND_UNLIKELY {
+            redistribute();
+        }
+        WHIRLWIND_DEBUG_ASSERT(!std::empty(buckets_[0]));
+        buckets_[0].pop_back();
+        --size_;
+    }
+
+    /** Remove all elements from the heap and reset `min_key()` to zero. */
+    constexpr void
+    clear() noexcept
+    {
+        for (auto& bucket : buckets_) {
+            bucket.clear();
+        }
+        last_key_ = {};
+        size_ = 0;
+    }
+
+    /**
+     * The number of bytes of memory owned by the heap's buckets (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        size_type bytes = 0;
+        for (const auto& bucket : buckets_) {
+            bytes += get_memory_usage(bucket);
+        }
+        return bytes;
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a heap.
+     *
+     * Bucket capacity that is retained after its elements are redistributed to lower
+     * buckets is not included.
+     *
+     * @param[in] max_size
+     *     The maximum number of elements in the heap at any one time.
+     *
+     * @returns
+     *     The estimated size of the heap's buckets.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type max_size) noexcept -> size_type
+    {
+        return estimate_growable_array_memory<value_type, Container>(max_size);
+    }
+
+private:
+    [[nodiscard]] static constexpr auto
+    to_unsigned(const key_type& key) noexcept -> unsigned_key_type
+    {
+        return static_cast<unsigned_key_type>(key);
+    }
+
+    // Get the index of the bucket that a key belongs in: zero if the key is equal to
+    // the last extracted key, or otherwise one plus the index of the highest bit in
+    // which the two keys differ.
+    [[nodiscard]] constexpr auto
+    get_bucket_id(const key_type& key) const noexcept -> size_type
+    {
+        const auto diff = to_unsigned(key) ^ to_unsigned(last_key_);
+        const auto bucket_id = static_cast<size_type>(std::bit_width(diff));
+        WHIRLWIND_DEBUG_ASSERT(bucket_id < num_buckets());
+        return bucket_id;
+    }
+
+    // Advance `last_key_` to the smallest key in the first non-empty bucket and move
+    // that bucket's elements into lower buckets.
+    constexpr void
+    redistribute()
+    {
+        WHIRLWIND_DEBUG_ASSERT(!empty());
+        WHIRLWIND_DEBUG_ASSERT(std::empty(buckets_[0]));
+
+        size_type i = 1;
+        while (std::empty(buckets_[i])) {
+            ++i;
+            WHIRLWIND_DEBUG_ASSERT(i < num_buckets());
+        }
+
+        auto& bucket = buckets_[i];
+        auto min_key = bucket.front().second;
+        for (const auto& [value, key] : bucket) {
+            if (key < min_key) {
+                min_key = key;
+            }
+        }
+        last_key_ = min_key;
+
+        // Each element's key now differs from `last_key_` only in bits lower than
+        // those distinguishing bucket `i`, so each element moves to a lower bucket.
+        for (auto& element : bucket) {
+            const auto bucket_id = get_bucket_id(element.second);
+            WHIRLWIND_DEBUG_ASSERT(bucket_id < i);
+            buckets_[bucket_id].push_back(std::move(element));
+        }
+        bucket.clear();
+    }
+
+    std::array<container_type<value_type>, num_buckets()> buckets_ = {};
+    key_type last_key_ = {};
+    size_type size_ = 0;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "memory_usage.hpp"
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A fixed-size sequence of bits supporting constant-time rank queries.
+ *
+ * The bits are packed into 64-bit words, together with the number of set bits that
+ * precede each word. The rank of a position (the number of set bits before it) is then
+ * found from a single table lookup and population count. This maps each set position
+ * in a sparse universe [0, N) to a dense index in [0, K), where K is the number of set
+ * bits, using about 2 bits of storage per position.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the words and their ranks.
+ */
+template<template<class> class Container = Vector>
+class RankBitmap {
+public:
+    using size_type = std::size_t;
+    using word_type = std::uint64_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /** Create a new, empty `RankBitmap`. */
+    constexpr RankBitmap() = default;
+
+    /**
+     * Create a new `RankBitmap`.
+     *
+     * @param[in] bits
+     *     A random-access range of the value of each bit. Each element must be
+     *     convertible to `bool`.
+     */
+    template<class RandomAccessRange>
+    explicit constexpr RankBitmap(const RandomAccessRange& bits)
+        : size_(std::size(bits)),
+          words_((size_ + word_bits - 1) / word_bits, 0),
+          word_rank_(std::size(words_) + 1, 0)
+    {
+        for (size_type i = 0; i < size_; ++i) {
+            if (static_cast<bool>(bits[i])) {
+                words_[i / word_bits] |= word_type{1} << (i % word_bits);
+            }
+        }
+        for (size_type w = 0; w < std::size(words_); ++w) {
+            word_rank_[w + 1] =
+                    word_rank_[w] + static_cast<size_type>(std::popcount(words_[w]));
+        }
+    }
+
+    /** The number of bits. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** The number of set bits. */
+    [[nodiscard]] constexpr auto
+    count() const noexcept -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(!std::empty(word_rank_) || (size_ == 0));
+        return std::empty(word_rank_) ? size_type{0} : word_rank_.back();
+    }
+
+    /**
+     * Get the value of a bit.
+     *
+     * @param[in] pos
+     *     The position of the bit. Must be less than `size()`.
+     *
+     * @returns
+     *     True if the bit is set; otherwise false.
+     */
+    [[nodiscard]] constexpr auto
+    test(size_type pos) const -> bool
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        return ((words_[pos / word_bits] >> (pos % word_bits)) & word_type{1}) != 0;
+    }
+
+    /**
+     * Get the number of set bits preceding a position.
+     *
+     * @param[in] pos
+     *     The position. Must be no greater than `size()`.
+     *
+     * @returns
+     *     The number of set bits in [0, `pos`).
+     */
+    [[nodiscard]] constexpr auto
+    rank(size_type pos) const -> size_type
+    {
+        WHIRLWIND_ASSERT(pos <= size());
+        const auto w = pos / word_bits;
+        const auto b = pos % word_bits;
+        if (b == 0) {
+            return (w < std::size(word_rank_)) ? word_rank_[w] : size_type{0};
+        }
+        const auto mask = (word_type{1} << b) - 1;
+        return word_rank_[w] + static_cast<size_type>(std::popcount(words_[w] & mask));
+    }
+
+    /**
+     * The number of bytes of memory owned by the bitmap's words and their ranks (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(words_) + get_memory_usage(word_rank_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store a bitmap.
+     *
+     * @param[in] size
+     *     The number of bits.
+     *
+     * @returns
+     *     The estimated size of the bitmap's words and their ranks.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type size) noexcept -> size_type
+    {
+        const auto num_words = (size + word_bits - 1) / word_bits;
+        return estimate_array_memory<word_type, Container>(num_words) +
+               estimate_array_memory<size_type, Container>(num_words + 1);
+    }
+
+private:
+    static constexpr size_type word_bits = 64;
+
+    size_type size_ = 0;
+    container_type<word_type> words_ = {};
+    container_type<size_type> word_rank_ = {};
+};
+
+WHIRLWIND_NAMESPACE_END
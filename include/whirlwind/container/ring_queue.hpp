@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "memory_usage.hpp"
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A FIFO queue backed by a growable ring buffer.
+ *
+ * Elements are stored in a single contiguous array whose capacity is a power of two.
+ * Unlike `Queue`, which is backed by `std::deque`, an empty `RingQueue` owns no memory
+ * and has a small fixed size, which makes it suitable for use in large arrays of
+ * mostly-empty queues (such as the buckets of Dial's algorithm). Clearing the queue
+ * retains its capacity.
+ *
+ * @tparam T
+ *     The element type. Must be default constructible.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the elements.
+ */
+template<class T, template<class> class Container = Vector>
+class RingQueue {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    /** Create a new, empty `RingQueue`. */
+    constexpr RingQueue() = default;
+
+    /** The number of elements in the queue. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** Check whether the queue is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return size_ == 0;
+    }
+
+    /** The number of elements that the queue can hold without reallocating. */
+    [[nodiscard]] constexpr auto
+    capacity() const noexcept -> size_type
+    {
+        return std::size(data_);
+    }
+
+    /** Get the first (oldest) element in the queue. The queue must not be empty. */
+    [[nodiscard]] constexpr auto
+    front() const -> const value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return data_[head_];
+    }
+
+    /** Get the first (oldest) element in the queue. The queue must not be empty. */
+    [[nodiscard]] constexpr auto
+    front() -> value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return data_[head_];
+    }
+
+    /** Get the last (newest) element in the queue. The queue must not be empty. */
+    [[nodiscard]] constexpr auto
+    back() const -> const value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return data_[wrap(head_ + size_ - 1)];
+    }
+
+    /** Get the last (newest) element in the queue. The queue must not be empty. */
+    [[nodiscard]] constexpr auto
+    back() -> value_type&
+    {
+        WHIRLWIND_ASSERT(!empty());
+        return data_[wrap(head_ + size_ - 1)];
+    }
+
+    /** Insert an element at the end of the queue. */
+    constexpr void
+    push(value_type value)
+    {
+        if (size_ == capacity()) WHIRLWIND_UNLIKELY {
+            grow();
+        }
+        WHIRLWIND_DEBUG_ASSERT(size_ < capacity());
+        data_[wrap(head_ + size_)] = std::move(value);
+        ++size_;
+    }
+
+    /** Remove the first element in the queue. The queue must not be empty. */
+    constexpr void
+    pop()
+    {
+        WHIRLWIND_ASSERT(!empty());
+        head_ = wrap(head_ + 1);
+        --size_;
+    }
+
+    /** Remove all elements from the queue. The capacity is unchanged. */
+    constexpr void
+    clear() noexcept
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * The number of bytes of memory owned by the queue's ring buffer (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(data_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a queue.
+     *
+     * @param[in] max_size
+     *     The maximum number of elements in the queue at any one time.
+     *
+     * @returns
+     *     The estimated size of the queue's ring buffer.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type max_size) noexcept -> size_type
+    {
+        if (max_size == 0) {
+            return 0;
+        }
+        const auto capacity = std::bit_ceil(std::max(max_size, size_type{4}));
+        return estimate_array_memory<value_type, Container>(capacity);
+    }
+
+private:
+    // Map a position in [0, 2 * `capacity()`) to an index in the ring buffer. The
+    // capacity is always a power of two (or zero, in which case the queue is empty).
+    [[nodiscard]] constexpr auto
+    wrap(size_type pos) const noexcept -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(capacity() > 0);
+        return pos & (capacity() - 1);
+    }
+
+    // Double the capacity of the ring buffer, moving the existing elements to the
+    // front of the new buffer in FIFO order.
+    constexpr void
+    grow()
+    {
+        const auto new_capacity = (capacity() == 0) ? size_type{4} : 2 * capacity();
+        WHIRLWIND_DEBUG_ASSERT((new_capacity & (new_capacity - 1)) == 0);
+
+        auto data = container_type<value_type>(new_capacity);
+        for (size_type i = 0; i < size_; ++i) {
+            data[i] = std::move(data_[wrap(head_ + i)]);
+        }
+
+        data_ = std::move(data);
+        head_ = 0;
+    }
+
+    container_type<value_type> data_ = {};
+    size_type head_ = 0;
+    size_type size_ = 0;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+#include "memory_usage.hpp"
+#include "vector.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A set of elements, each identified by a unique integer ID in a fixed universe
+ * [0, N).
+ *
+ * The members of the set are stored contiguously in a dense array, together with a
+ * sparse array that maps each ID in the universe to the position of the corresponding
+ * element in the dense array (if it is a member). Insertion, removal, and membership
+ * queries take O(1) time and iterating over the members takes time proportional to the
+ * number of members, regardless of the size of the universe. Removing an element moves
+ * the last member into its position, so the order of iteration is unspecified.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the dense and sparse arrays.
+ * @tparam Index
+ *     The unsigned integer type used to store positions in the sparse array. Must be
+ *     able to represent the size of the universe.
+ */
+template<class T, template<class> class Container = Vector, class Index = std::size_t>
+class SparseSet {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Index>);
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+
+public:
+    using value_type = T;
+    using index_type = Index;
+    using size_type = std::size_t;
+
+    template<class U>
+    using container_type = Container<U>;
+
+    using const_iterator = typename container_type<value_type>::const_iterator;
+
+    /** Create a new, empty `SparseSet` with an empty universe. */
+    constexpr SparseSet() = default;
+
+    /**
+     * Create a new, empty `SparseSet`.
+     *
+     * @param[in] universe_size
+     *     The number of IDs in the universe. Must be less than the max value of
+     *     `Index`.
+     */
+    explicit constexpr SparseSet(size_type universe_size)
+        : values_(), ids_(), positions_(universe_size, npos)
+    {
+        WHIRLWIND_ASSERT(universe_size < size_type{npos});
+    }
+
+    /** The number of IDs in the universe. */
+    [[nodiscard]] constexpr auto
+    universe_size() const noexcept -> size_type
+    {
+        return std::size(positions_);
+    }
+
+    /** The number of elements in the set. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return std::size(values_);
+    }
+
+    /** Check whether the set is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return std::empty(values_);
+    }
+
+    /** Check whether the set contains an element with the specified ID. */
+    [[nodiscard]] constexpr auto
+    contains(size_type id) const -> bool
+    {
+        WHIRLWIND_ASSERT(id < universe_size());
+        return positions_[id] != npos;
+    }
+
+    /** Iterate over the elements of the set (in unspecified order). */
+    [[nodiscard]] constexpr auto
+    begin() const noexcept -> const_iterator
+    {
+        return std::cbegin(values_);
+    }
+
+    /** Iterate over the elements of the set (in unspecified order). */
+    [[nodiscard]] constexpr auto
+    end() const noexcept -> const_iterator
+    {
+        return std::cend(values_);
+    }
+
+    /**
+     * Insert an element into the set.
+     *
+     * @param[in] id
+     *     The ID of the element. Must be in the universe of the set.
+     * @param[in] value
+     *     The element.
+     *
+     * @returns
+     *     True if the element was inserted; false if an element with the same ID was
+     *     already a member of the set.
+     */
+    constexpr auto
+    insert(size_type id, value_type value) -> bool
+    {
+        if (contains(id)) {
+            return false;
+        }
+        positions_[id] = static_cast<index_type>(size());
+        values_.push_back(std::move(value));
+        ids_.push_back(static_cast<index_type>(id));
+        return true;
+    }
+
+    /**
+     * Remove an element from the set.
+     *
+     * @param[in] id
+     *     The ID of the element. Must be in the universe of the set.
+     *
+     * @returns
+     *     True if the element was removed; false if it was not a member of the set.
+     */
+    constexpr auto
+    erase(size_type id) -> bool
+    {
+        if (!contains(id)) {
+            return false;
+        }
+
+        // Move the last element into the position of the removed element.
+        const auto pos = positions_[id];
+        WHIRLWIND_DEBUG_ASSERT(pos < size());
+        const auto last_id = ids_.back();
+        values_[pos] = std::move(values_.back());
+        ids_[pos] = last_id;
+        positions_[last_id] = pos;
+
+        values_.pop_back();
+        ids_.pop_back();
+        positions_[id] = npos;
+        return true;
+    }
+
+    /**
+     * Remove all elements from the set.
+     *
+     * Takes time proportional to the number of elements. The universe is unchanged.
+     */
+    constexpr void
+    clear() noexcept
+    {
+        for (const auto& id : ids_) {
+            positions_[id] = npos;
+        }
+        values_.clear();
+        ids_.clear();
+    }
+
+    /**
+     * The number of bytes of memory owned by the set's dense and sparse arrays (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(values_) + get_memory_usage(ids_) +
+               get_memory_usage(positions_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a set.
+     *
+     * @param[in] universe_size
+     *     The number of IDs in the universe.
+     * @param[in] max_size
+     *     The maximum number of elements in the set at any one time.
+     *
+     * @returns
+     *     The estimated size of the set's dense and sparse arrays.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type universe_size, size_type max_size) noexcept -> size_type
+    {
+        return estimate_growable_array_memory<value_type, Container>(max_size) +
+               estimate_growable_array_memory<index_type, Container>(max_size) +
+               estimate_array_memory<index_type, Container>(universe_size);
+    }
+
+private:
+    static constexpr auto npos = std::numeric_limits<index_type>::max();
+
+    container_type<value_type> values_;
+    container_type<index_type> ids_;
+    container_type<index_type> positions_;
+};
+
+WHIRLWIND_NAMESPACE_END
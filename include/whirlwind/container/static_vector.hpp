@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A variable-size array with fixed capacity and inline storage.
+ *
+ * A `StaticVector` stores up to `N` elements in an inline array, so it never allocates
+ * memory. It is intended for small, short-lived sequences (such as the outgoing edges
+ * of a vertex) that are returned by value.
+ *
+ * @tparam T
+ *     The element type. Must be default constructible.
+ * @tparam N
+ *     The maximum number of elements.
+ */
+template<class T, std::size_t N>
+class StaticVector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = const value_type*;
+    using const_iterator = const value_type*;
+
+    /** Create a new, empty `StaticVector`. */
+    constexpr StaticVector() = default;
+
+    /** The maximum number of elements. */
+    [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
+    capacity() noexcept -> size_type
+    {
+        return N;
+    }
+
+    /** The number of elements. */
+    [[nodiscard]] constexpr auto
+    size() const noexcept -> size_type
+    {
+        return size_;
+    }
+
+    /** Check whether the vector is empty. */
+    [[nodiscard]] constexpr auto
+    empty() const noexcept -> bool
+    {
+        return size_ == 0;
+    }
+
+    /** Get the element at the specified position. */
+    [[nodiscard]] constexpr auto
+    operator[](size_type pos) const -> const value_type&
+    {
+        WHIRLWIND_ASSERT(pos < size());
+        return data_[pos];
+    }
+
+    /** An iterator to the first element. */
+    [[nodiscard]] constexpr auto
+    begin() const noexcept -> const_iterator
+    {
+        return data_.data();
+    }
+
+    /** An iterator past the last element. */
+    [[nodiscard]] constexpr auto
+    end() const noexcept -> const_iterator
+    {
+        return data_.data() + size_;
+    }
+
+    /**
+     * Append an element to the end of the vector.
+     *
+     * @param[in] value
+     *     The new element. The vector must not be full.
+     */
+    constexpr void
+    push_back(value_type value)
+    {
+        WHIRLWIND_ASSERT(size() < capacity());
+        data_[size_] = std::move(value);
+        ++size_;
+    }
+
+private:
+    std::array<value_type, N> data_ = {};
+    size_type size_ = 0;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/util/get_residues.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** Options for the statistical cost model. */
+struct StatisticalCostOptions {
+    /** The effective number of looks used to estimate the coherence. */
+    double num_looks = 1.0;
+
+    /** Coherence values are clamped to be no less than this value. */
+    double min_coherence = 0.01;
+
+    /** Coherence values are clamped to be no greater than this value. */
+    double max_coherence = 0.999;
+
+    /** The factor by which the negative log-likelihood of each arc is multiplied. */
+    double scale = 100.0;
+
+    /** The maximum cost of any arc, after scaling. */
+    double max_cost = 10000.0;
+
+    /**
+     * The cost of arcs along the border of the grid. Flow along the border doesn't
+     * cross any pair of pixels, so it doesn't affect the unwrapped phase.
+     */
+    double border_cost = 0.0;
+};
+
+/**
+ * Non-owning views of the unit cost of each edge of a grid network, laid out as four
+ * planar rasters (one per edge direction) in the format accepted by the planar-cost
+ * `Network` constructor.
+ *
+ * For a residue grid of M+1 rows and N+1 columns of nodes, `up` and `down` are M x
+ * (N+1) arrays, and `left` and `right` are (M+1) x N arrays.
+ *
+ * @tparam Cost
+ *     The arc cost type. If it's an integral type, costs are rounded to the nearest
+ *     integer.
+ * @tparam LayoutPolicy
+ *     Specifies the layout of each raster in memory.
+ */
+template<class Cost, class LayoutPolicy = LayoutRight>
+struct PlanarGridCosts {
+    /** The cost of the edge from node (i+1,j) to node (i,j). */
+    Span2D<Cost, LayoutPolicy> up;
+
+    /** The cost of the edge from node (i,j) to node (i+1,j). */
+    Span2D<Cost, LayoutPolicy> down;
+
+    /** The cost of the edge from node (i,j+1) to node (i,j). */
+    Span2D<Cost, LayoutPolicy> left;
+
+    /** The cost of the edge from node (i,j) to node (i,j+1). */
+    Span2D<Cost, LayoutPolicy> right;
+};
+
+namespace detail {
+
+// Get the variance of the interferometric phase of a pixel from its coherence, using
+// the Cramer-Rao bound.
+template<class Real>
+[[nodiscard]] constexpr auto
+get_phase_variance(const Real& coherence, const StatisticalCostOptions& options)
+        -> double
+{
+    const auto gamma = std::clamp(static_cast<double>(coherence),
+                                  options.min_coherence, options.max_coherence);
+    const auto gamma2 = gamma * gamma;
+    return (1.0 - gamma2) / (2.0 * options.num_looks * gamma2);
+}
+
+// Convert a scaled cost to the output cost type, clamping it to the maximum cost.
+template<class Cost>
+[[nodiscard]] constexpr auto
+to_arc_cost(double cost, const StatisticalCostOptions& options) -> Cost
+{
+    const auto c = std::min(cost, options.max_cost);
+    if constexpr (std::is_integral_v<Cost>) {
+        return static_cast<Cost>(std::round(c));
+    } else {
+        return static_cast<Cost>(c);
+    }
+}
+
+// Get the statistical cost of a unit of flow on an arc that crosses the wrapped phase
+// gradient from `psi0` to `psi1`, given the sum of the phase variances of the two
+// pixels. The unwrapped phase gradient is modeled as a zero-mean Gaussian with that
+// variance, and the cost is the increase in its negative log-likelihood when one cycle
+// is added to it (`sign` = 1) or removed from it (`sign` = -1).
+template<class Cost, class Real>
+[[nodiscard]] constexpr auto
+get_statistical_arc_cost(const Real& psi1,
+                         const Real& psi0,
+                         double var,
+                         double sign,
+                         const StatisticalCostOptions& options) -> Cost
+{
+    const auto dpsi = static_cast<double>(get_wrapped_diff(psi1, psi0));
+    const auto k = options.scale * tau<double>() / var;
+    return to_arc_cost<Cost>(k * (pi<double>() + sign * dpsi), options);
+}
+
+// Check that the statistical cost model options are valid for the specified cost type.
+template<class Cost>
+constexpr void
+check_statistical_cost_options([[maybe_unused]] const StatisticalCostOptions& options)
+{
+    WHIRLWIND_ASSERT(options.num_looks > 0.0);
+    WHIRLWIND_ASSERT(options.min_coherence > 0.0);
+    WHIRLWIND_ASSERT(options.min_coherence <= options.max_coherence);
+    WHIRLWIND_ASSERT(options.max_coherence < 1.0);
+    WHIRLWIND_ASSERT(options.scale > 0.0);
+    WHIRLWIND_ASSERT(options.border_cost >= 0.0);
+    if constexpr (std::is_integral_v<Cost>) {
+        WHIRLWIND_ASSERT(options.max_cost <=
+                         static_cast<double>(std::numeric_limits<Cost>::max()));
+    }
+}
+
+// Compute the statistical costs of each row of arcs of a grid network, passing the
+// residue row kernel for each row of nodes to `store_residues` after the costs of the
+// row have been computed.
+template<template<class> class Container,
+         class SignedInteger,
+         class PhaseArray,
+         class CoherenceArray,
+         class Cost,
+         class LayoutPolicy,
+         class StoreResidues>
+void
+compute_statistical_costs(const PhaseArray& wrapped_phase,
+                          const CoherenceArray& coherence,
+                          const PlanarGridCosts<Cost, LayoutPolicy>& cost,
+                          const StatisticalCostOptions& options,
+                          std::size_t num_threads,
+                          const StoreResidues& store_residues)
+{
+    using Extents = typename PhaseArray::extents_type;
+    WHIRLWIND_STATIC_ASSERT(Extents::rank() == 2);
+    using Real = std::remove_cvref_t<typename PhaseArray::value_type>;
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<Real>);
+    WHIRLWIND_STATIC_ASSERT(std::is_arithmetic_v<Cost>);
+
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(static_cast<std::size_t>(coherence.extent(0)) == m);
+    WHIRLWIND_ASSERT(static_cast<std::size_t>(coherence.extent(1)) == n);
+    WHIRLWIND_ASSERT(cost.up.extent(0) == m);
+    WHIRLWIND_ASSERT(cost.up.extent(1) == n + 1);
+    WHIRLWIND_ASSERT(cost.down.extent(0) == m);
+    WHIRLWIND_ASSERT(cost.down.extent(1) == n + 1);
+    WHIRLWIND_ASSERT(cost.left.extent(0) == m + 1);
+    WHIRLWIND_ASSERT(cost.left.extent(1) == n);
+    WHIRLWIND_ASSERT(cost.right.extent(0) == m + 1);
+    WHIRLWIND_ASSERT(cost.right.extent(1) == n);
+    check_statistical_cost_options<Cost>(options);
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    const auto border_cost = to_arc_cost<Cost>(options.border_cost, options);
+
+    // Each block of rows of nodes is processed independently, starting from the input
+    // row preceding the block. Each output row depends on (at most) the two input rows
+    // that it borders, whose wrapped phase is held by the residue kernel.
+    const auto get_rows = [&](std::size_t first, std::size_t last) {
+        auto kernel = ResidueRowKernel<SignedInteger, Real, Container>(n);
+        auto var_prev = Container<double>(n);
+        auto var_curr = Container<double>(n);
+
+        const auto push_row = [&](std::size_t i) {
+            kernel.push_row(wrapped_phase, i);
+            std::swap(var_prev, var_curr);
+            for (std::size_t j = 0; j < n; ++j) {
+                var_curr[j] = get_phase_variance(coherence(i, j), options);
+            }
+        };
+
+        if (first >= 1) {
+            push_row(first - 1);
+        }
+        for (auto r = first; r < last; ++r) {
+            if (r < m) {
+                push_row(r);
+            } else {
+                kernel.push_end();
+            }
+            const auto& prev = kernel.previous_row();
+            const auto& curr = kernel.current_row();
+
+            const auto get_cost = [&](const auto& psi1, const auto& psi0, double var,
+                                      double sign) {
+                return get_statistical_arc_cost<Cost>(psi1, psi0, var, sign, options);
+            };
+
+            // The down (up) arcs in row `r` cross the rightward (leftward) phase
+            // gradient between adjacent pixels in input row `r`.
+            if (r < m) {
+                cost.up(r, 0) = border_cost;
+                cost.down(r, 0) = border_cost;
+                for (std::size_t j = 1; j < n; ++j) {
+                    const auto var = var_curr[j] + var_curr[j - 1];
+                    cost.down(r, j) = get_cost(curr[j], curr[j - 1], var, 1.0);
+                    cost.up(r, j) = get_cost(curr[j], curr[j - 1], var, -1.0);
+                }
+                cost.up(r, n) = border_cost;
+                cost.down(r, n) = border_cost;
+            }
+
+            // The left (right) arcs in row `r` cross the downward (upward) phase
+            // gradient between input rows `r - 1` and `r`.
+            if ((r == 0) || (r == m)) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    cost.left(r, j) = border_cost;
+                    cost.right(r, j) = border_cost;
+                }
+            } else {
+                for (std::size_t j = 0; j < n; ++j) {
+                    const auto var = var_curr[j] + var_prev[j];
+                    cost.left(r, j) = get_cost(curr[j], prev[j], var, 1.0);
+                    cost.right(r, j) = get_cost(curr[j], prev[j], var, -1.0);
+                }
+            }
+
+            store_residues(r, kernel);
+        }
+    };
+    parallel_for_chunks(0, m + 1, num_threads, get_rows);
+}
+
+} // namespace detail
+
+/**
+ * Compute statistical arc costs of a grid network from wrapped phase and coherence.
+ *
+ * The network is the (M+1) x (N+1) grid of residues of an M x N wrapped phase array.
+ * Each arc that crosses the edge between two adjacent pixels adds (or removes) one
+ * cycle to the unwrapped phase gradient between them. The gradient is modeled as a
+ * zero-mean Gaussian whose variance is the sum of the phase variances of the two
+ * pixels, each given by the Cramer-Rao bound for its coherence. The cost of each arc is
+ * the resulting increase in the negative log-likelihood of the gradient,
+ * `2pi (pi +/- dpsi) / var`, multiplied by `options.scale` and clamped to
+ * `options.max_cost`, where `dpsi` is the wrapped phase gradient. Arcs along the border
+ * of the grid are assigned `options.border_cost`.
+ *
+ * The costs are written directly to four planar rasters. Each row is computed from
+ * (at most) two rows of the input by branch-free loops over contiguous buffers that
+ * compilers can vectorize, and blocks of rows may be distributed across multiple
+ * threads. The result doesn't depend on the number of threads.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the per-row buffers.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[in] coherence
+ *     The M x N coherence array, with values in the interval [0, 1].
+ * @param[out] cost
+ *     The output cost rasters.
+ * @param[in] options
+ *     The cost model options.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ */
+template<template<class> class Container = Vector,
+         class PhaseArray,
+         class CoherenceArray,
+         class Cost,
+         class LayoutPolicy>
+void
+get_statistical_costs(const PhaseArray& wrapped_phase,
+                      const CoherenceArray& coherence,
+                      const PlanarGridCosts<Cost, LayoutPolicy>& cost,
+                      const StatisticalCostOptions& options = {},
+                      std::size_t num_threads = 1)
+{
+    const auto store_residues = [](std::size_t, const auto&) {};
+    detail::compute_statistical_costs<Container, std::int32_t>(
+            wrapped_phase, coherence, cost, options, num_threads, store_residues);
+}
+
+/**
+ * Compute statistical arc costs and the residues of a wrapped phase array in a single
+ * pass.
+ *
+ * This is equivalent to `get_statistical_costs()` followed by `get_residues()`, but
+ * each row of the wrapped phase is read once for both.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the per-row buffers.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[in] coherence
+ *     The M x N coherence array, with values in the interval [0, 1].
+ * @param[out] cost
+ *     The output cost rasters.
+ * @param[out] residues
+ *     The (M+1) x (N+1) output array of residues.
+ * @param[in] options
+ *     The cost model options.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ */
+template<template<class> class Container = Vector,
+         class PhaseArray,
+         class CoherenceArray,
+         class Cost,
+         class LayoutPolicy,
+         class SignedInteger,
+         class ResidueLayoutPolicy>
+void
+get_statistical_costs_and_residues(const PhaseArray& wrapped_phase,
+                                   const CoherenceArray& coherence,
+                                   const PlanarGridCosts<Cost, LayoutPolicy>& cost,
+                                   Span2D<SignedInteger, ResidueLayoutPolicy> residues,
+                                   const StatisticalCostOptions& options = {},
+                                   std::size_t num_threads = 1)
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_signed_v<SignedInteger> &&
+                            std::is_integral_v<SignedInteger>);
+    WHIRLWIND_ASSERT(residues.extent(0) ==
+                     static_cast<std::size_t>(wrapped_phase.extent(0)) + 1);
+    WHIRLWIND_ASSERT(residues.extent(1) ==
+                     static_cast<std::size_t>(wrapped_phase.extent(1)) + 1);
+
+    const auto store_residues = [&](std::size_t r, auto& kernel) {
+        kernel.get_residue_row(
+                [&, r](std::size_t c) -> auto& { return residues(r, c); });
+    };
+    detail::compute_statistical_costs<Container, SignedInteger>(
+            wrapped_phase, coherence, cost, options, num_threads, store_residues);
+}
+
+WHIRLWIND_NAMESPACE_END
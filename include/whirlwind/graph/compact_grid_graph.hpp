@@ -0,0 +1,293 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/view/iota.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/static_vector.hpp>
+
+#include "rectangular_grid_graph.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A 2-dimensional rectangular grid graph with linearly-indexed vertices.
+ *
+ * A graph with the same topology and edge numbering as `RectangularGridGraph`, except
+ * that each vertex is represented by its (row-major) linear index rather than by a
+ * (row,col) index pair. The row and column of a vertex may be recovered via
+ * `vertex_row()` and `vertex_col()`.
+ *
+ * Using a compact (e.g. 32-bit) vertex type reduces the size of the per-vertex state
+ * stored by shortest path solvers (heap entries, bucket queues, and predecessor
+ * arrays), and makes `get_vertex_id()` a no-op.
+ *
+ * @tparam P
+ *     The number of parallel edges between adjacent vertices.
+ * @tparam Vertex
+ *     The unsigned integer type used to represent vertices. Must be able to represent
+ *     the total number of vertices in the graph.
+ */
+template<std::size_t P = 1, class Vertex = std::uint32_t>
+class CompactGridGraph : private RectangularGridGraph<P, Vertex> {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Vertex>);
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Vertex>);
+
+private:
+    using base_type = RectangularGridGraph<P, Vertex>;
+    using base_vertex_type = typename base_type::vertex_type;
+
+public:
+    using dim_type = Vertex;
+    using vertex_type = Vertex;
+    using edge_type = typename base_type::edge_type;
+    using size_type = typename base_type::size_type;
+    using outgoing_edges_type = StaticVector<std::pair<edge_type, vertex_type>, 4 * P>;
+
+    using base_type::contains_edge;
+    using base_type::edges;
+    using base_type::get_edge_id;
+    using base_type::num_edges;
+    using base_type::num_parallel_edges;
+    using base_type::num_vertices;
+
+    /**
+     * Default constructor. Creates an empty `CompactGridGraph` with no vertices or
+     * edges.
+     */
+    constexpr CompactGridGraph() = default;
+
+    /**
+     * Create a new `CompactGridGraph`.
+     *
+     * @param[in] num_rows
+     *     The number of rows in the 2-D array of vertices.
+     * @param[in] num_cols
+     *     The number of columns in the 2-D array of vertices.
+     */
+    constexpr CompactGridGraph(dim_type num_rows, dim_type num_cols) noexcept
+        : base_type(num_rows, num_cols)
+    {
+        WHIRLWIND_ASSERT(num_vertices() <= std::numeric_limits<vertex_type>::max());
+    }
+
+    /** The number of rows of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_rows() const noexcept -> dim_type
+    {
+        return base_type::num_rows();
+    }
+
+    /** The number of columns of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_cols() const noexcept -> dim_type
+    {
+        return base_type::num_cols();
+    }
+
+    /**
+     * Get the vertex at the specified row and column of the grid.
+     *
+     * @param[in] row
+     *     The row index. Must be in the range [0, `num_rows()`).
+     * @param[in] col
+     *     The column index. Must be in the range [0, `num_cols()`).
+     *
+     * @returns
+     *     The vertex.
+     */
+    [[nodiscard]] constexpr auto
+    make_vertex(dim_type row, dim_type col) const noexcept -> vertex_type
+    {
+        WHIRLWIND_ASSERT(row < num_rows());
+        WHIRLWIND_ASSERT(col < num_cols());
+        return static_cast<vertex_type>(row * num_cols() + col);
+    }
+
+    /** Get the row index of a vertex. */
+    [[nodiscard]] constexpr auto
+    vertex_row(const vertex_type& vertex) const noexcept -> dim_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        return static_cast<dim_type>(vertex / num_cols());
+    }
+
+    /** Get the column index of a vertex. */
+    [[nodiscard]] constexpr auto
+    vertex_col(const vertex_type& vertex) const noexcept -> dim_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        return static_cast<dim_type>(vertex % num_cols());
+    }
+
+    /**
+     * Get the unique array index of a vertex.
+     *
+     * Vertices are represented by their linear index, so this is the identity.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The vertex index.
+     */
+    [[nodiscard]] constexpr auto
+    get_vertex_id(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return static_cast<size_type>(vertex);
+    }
+
+    /**
+     * Iterate over vertices in the graph.
+     *
+     * Returns a view of all vertices in the graph in order from smallest index to
+     * largest.
+     */
+    [[nodiscard]] constexpr auto
+    vertices() const
+    {
+        return ranges::views::iota(vertex_type{0},
+                                   static_cast<vertex_type>(num_vertices()));
+    }
+
+    /** Check whether the graph contains the specified vertex. */
+    [[nodiscard]] constexpr auto
+    contains_vertex(const vertex_type& vertex) const -> bool
+    {
+        return get_vertex_id(vertex) < num_vertices();
+    }
+
+    /**
+     * Get the number of outgoing edges of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The outdegree of the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    outdegree(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return base_type::outdegree(to_base_vertex(vertex));
+    }
+
+    /** See `RectangularGridGraph::get_up_edge()`. */
+    [[nodiscard]] constexpr auto
+    get_up_edge(const vertex_type& vertex) const -> edge_type
+    {
+        return base_type::get_up_edge(to_base_vertex(vertex));
+    }
+
+    /** See `RectangularGridGraph::get_left_edge()`. */
+    [[nodiscard]] constexpr auto
+    get_left_edge(const vertex_type& vertex) const -> edge_type
+    {
+        return base_type::get_left_edge(to_base_vertex(vertex));
+    }
+
+    /** See `RectangularGridGraph::get_down_edge()`. */
+    [[nodiscard]] constexpr auto
+    get_down_edge(const vertex_type& vertex) const -> edge_type
+    {
+        return base_type::get_down_edge(to_base_vertex(vertex));
+    }
+
+    /** See `RectangularGridGraph::get_right_edge()`. */
+    [[nodiscard]] constexpr auto
+    get_right_edge(const vertex_type& vertex) const -> edge_type
+    {
+        return base_type::get_right_edge(to_base_vertex(vertex));
+    }
+
+    /**
+     * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
+     *
+     * Returns a range of ordered (edge,head) pairs over all edges emanating from the
+     * specified vertex in the graph, in the same order as
+     * `RectangularGridGraph::outgoing_edges()`. The result has inline storage for at
+     * most `4 * P` elements and is returned by value, so no memory is allocated.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     A range of the vertex's outgoing incident edges and successor vertices.
+     */
+    [[nodiscard]] constexpr auto
+    outgoing_edges(const vertex_type& vertex) const -> outgoing_edges_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+
+        // Compute the (row,col) indices of the vertex once. Neighboring vertices are
+        // then obtained by offsetting its linear index.
+        const auto ij = to_base_vertex(vertex);
+        const auto i = ij.first;
+        const auto j = ij.second;
+        const auto n = num_cols();
+
+        auto outgoing = outgoing_edges_type();
+
+        // up
+        if (i != 0) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex - n);
+            add_parallel_edges(outgoing, base_type::get_up_edge(ij), head);
+        }
+
+        // left
+        if (j != 0) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex - 1);
+            add_parallel_edges(outgoing, base_type::get_left_edge(ij), head);
+        }
+
+        // down
+        if (i + 1 != num_rows()) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex + n);
+            add_parallel_edges(outgoing, base_type::get_down_edge(ij), head);
+        }
+
+        // right
+        if (j + 1 != n) WHIRLWIND_LIKELY {
+            const auto head = static_cast<vertex_type>(vertex + 1);
+            add_parallel_edges(outgoing, base_type::get_right_edge(ij), head);
+        }
+
+        WHIRLWIND_DEBUG_ASSERT(std::size(outgoing) == outdegree(vertex));
+        return outgoing;
+    }
+
+private:
+    [[nodiscard]] constexpr auto
+    to_base_vertex(const vertex_type& vertex) const noexcept -> base_vertex_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_DEBUG_ASSERT(num_cols() > 0);
+        const auto n = num_cols();
+        return base_vertex_type(static_cast<dim_type>(vertex / n),
+                                static_cast<dim_type>(vertex % n));
+    }
+
+    // Append the `P` parallel edges from some vertex to an adjacent vertex `head`,
+    // starting with the first such edge.
+    constexpr void
+    add_parallel_edges(outgoing_edges_type& outgoing,
+                       edge_type first_edge,
+                       const vertex_type& head) const
+    {
+        WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+        for (size_type p = 0; p != num_parallel_edges(); ++p) {
+            const auto edge = first_edge + p;
+            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
+            outgoing.push_back({edge, head});
+        }
+    }
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <span>
 #include <type_traits>
 #include <utility>
@@ -14,6 +17,8 @@
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/compatibility.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
 
 #include "edge_list.hpp"
@@ -27,10 +32,10 @@ subspan_of(ContiguousRange&& r, // NOLINT(cppcoreguidelines-missing-std-forward)
            Size stop)
 {
     const auto begin = std::begin(r);
-    using Difference = typename std::iterator_traits<decltype(begin)>::difference_type;
+    using Difference = std::iter_difference_t<decltype(begin)>;
     const auto first = begin + static_cast<Difference>(start);
     const auto last = begin + static_cast<Difference>(stop);
-    WHIRLWIND_ASSERT(first < std::end(r));
+    WHIRLWIND_ASSERT(first <= last);
     WHIRLWIND_ASSERT(last <= std::end(r));
     return std::span(first, last);
 }
@@ -44,12 +49,22 @@ subspan_of(ContiguousRange&& r, // NOLINT(cppcoreguidelines-missing-std-forward)
  * @tparam Container
  *     A `std::vector`-like type template used to store the internal row and column
  *     index arrays.
+ * @tparam Index
+ *     The unsigned integer type used to represent vertices and edges (and stored in the
+ *     row and column index arrays). Must be able to represent the total number of
+ *     vertices and edges in the graph. A 32-bit type halves the memory footprint of
+ *     the graph (and of per-vertex and per-edge data in algorithms that operate on it)
+ *     compared to `std::size_t`.
  */
-template<template<class> class Container = Vector>
+template<template<class> class Container = Vector, class Index = std::size_t>
 class CSRGraph {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Index>);
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+
 public:
-    using vertex_type = std::size_t;
-    using edge_type = std::size_t;
+    using index_type = Index;
+    using vertex_type = index_type;
+    using edge_type = index_type;
     using size_type = std::size_t;
 
     template<class T>
@@ -62,35 +77,148 @@ public:
         WHIRLWIND_DEBUG_ASSERT(num_edges() == 0);
     }
 
-    /** Create a new `CSRGraph` from a sequence of (tail,head) pairs. */
-    template<template<class> class UContainer>
-    explicit constexpr CSRGraph(EdgeList<vertex_type, UContainer> edge_list)
-        : CSRGraph([&]() {
-              std::sort(std::begin(edge_list), std::end(edge_list));
-
-              CSRGraph graph;
-              graph.c_.reserve(std::size(edge_list));
-
-              size_type edge_count = 0;
-              size_type max_vertex_id = 0;
-              for (const auto& [tail, head] : edge_list) {
-                  const auto new_size = tail + 1;
-                  WHIRLWIND_DEBUG_ASSERT(new_size >= std::size(graph.r_));
-
-                  graph.r_.resize(new_size, edge_count);
-                  graph.c_.emplace_back(head);
-
-                  max_vertex_id = std::max(max_vertex_id, std::max(tail, head));
+    /**
+     * Create a new `CSRGraph` from a sequence of (tail,head) pairs.
+     *
+     * Edges are numbered in lexicographical (tail,head) order. The graph is built by
+     * a counting sort of the input edges by tail vertex followed by sorting the heads
+     * of each vertex's outgoing edges in-place, which takes O(V + E) time for graphs
+     * with bounded outdegree. The input edge list is neither copied nor modified.
+     *
+     * Each step may be distributed across multiple threads. The resulting graph does
+     * not depend on the number of threads.
+     *
+     * The vertex type of the edge list may differ from `vertex_type`, but each vertex
+     * must be representable by `vertex_type`.
+     *
+     * @param[in] edge_list
+     *     The list of (tail,head) pairs.
+     * @param[in] num_threads
+     *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+     */
+    template<class Vertex, template<class> class UContainer>
+    explicit CSRGraph(const EdgeList<Vertex, UContainer>& edge_list,
+                      size_type num_threads = 1)
+        : r_(), c_()
+    {
+        WHIRLWIND_ASSERT(num_threads >= 1);
+
+        const auto edges = std::begin(edge_list);
+        const auto edge_count = size_type{std::size(edge_list)};
+        const auto concurrent = (num_threads > 1);
+
+        // Get the max vertex index among all edges.
+        auto max_vertex_id = std::atomic<size_type>(0);
+        parallel_for_chunks(0, edge_count, num_threads, [&](size_type first,
+                                                            size_type last) {
+            size_type local_max = 0;
+            for (auto i = first; i != last; ++i) {
+                const auto& [tail, head] = edges[static_cast<std::ptrdiff_t>(i)];
+                const auto max_id = static_cast<size_type>(std::max(tail, head));
+                local_max = std::max(local_max, max_id);
+            }
+
+            auto current_max = max_vertex_id.load(std::memory_order_relaxed);
+            while (current_max < local_max &&
+                   !max_vertex_id.compare_exchange_weak(current_max, local_max,
+                                                        std::memory_order_relaxed)) {
+            }
+        });
+        const auto vertex_count = max_vertex_id.load() + 1;
+        WHIRLWIND_ASSERT(vertex_count - 1 <= std::numeric_limits<index_type>::max());
+        WHIRLWIND_ASSERT(edge_count <= std::numeric_limits<index_type>::max());
+
+        // Count the outdegree of each vertex. After this step, `r_[v + 1]` is the
+        // outdegree of vertex `v`.
+        r_.assign(vertex_count + 1, 0);
+        parallel_for_chunks(0, edge_count, num_threads, [&](size_type first,
+                                                            size_type last) {
+            for (auto i = first; i != last; ++i) {
+                const auto& tail = edges[static_cast<std::ptrdiff_t>(i)].first;
+                fetch_increment(r_[static_cast<size_type>(tail) + 1], concurrent);
+            }
+        });
+
+        // Convert the outdegrees to row offsets.
+        std::partial_sum(std::begin(r_), std::end(r_), std::begin(r_));
+        WHIRLWIND_DEBUG_ASSERT(r_.back() == edge_count);
+
+        // Scatter the head of each edge to the next free position in its tail
+        // vertex's row.
+        c_.resize(edge_count);
+        auto next = container_type<edge_type>(std::begin(r_), std::prev(std::end(r_)));
+        parallel_for_chunks(0, edge_count, num_threads, [&](size_type first,
+                                                            size_type last) {
+            for (auto i = first; i != last; ++i) {
+                const auto& [tail, head] = edges[static_cast<std::ptrdiff_t>(i)];
+                const auto pos = fetch_increment(next[static_cast<size_type>(tail)],
+                                                 concurrent);
+                c_[pos] = static_cast<vertex_type>(head);
+            }
+        });
+
+        // Sort the heads within each row so that edges are ordered by (tail,head)
+        // regardless of the input order or the order of concurrent updates above.
+        parallel_for_chunks(0, vertex_count, num_threads, [&](size_type first,
+                                                              size_type last) {
+            const auto c = std::begin(c_);
+            for (auto v = first; v != last; ++v) {
+                std::sort(c + static_cast<std::ptrdiff_t>(r_[v]),
+                          c + static_cast<std::ptrdiff_t>(r_[v + 1]));
+            }
+        });
+
+        WHIRLWIND_DEBUG_ASSERT(num_vertices() == vertex_count);
+        WHIRLWIND_DEBUG_ASSERT(num_edges() == edge_count);
+    }
 
-                  ++edge_count;
-              }
+    /**
+     * Create a new `CSRGraph` from its row offset and column index arrays.
+     *
+     * This is intended for restoring a graph previously created from an edge list (see
+     * `row_offsets()` and `column_indices()`), for example from a memory-mapped file
+     * using a read-only `Container` such as `ConstSpan`.
+     *
+     * @param[in] row_offsets
+     *     The index of the first outgoing edge of each vertex, followed by the total
+     *     number of edges. Must be non-empty and non-decreasing, starting at zero.
+     * @param[in] column_indices
+     *     The head vertex of each edge, with edges ordered by tail vertex.
+     */
+    constexpr CSRGraph(container_type<edge_type> row_offsets,
+                       container_type<vertex_type> column_indices)
+        : r_(std::move(row_offsets)), c_(std::move(column_indices))
+    {
+        WHIRLWIND_ASSERT(!std::empty(r_));
+        WHIRLWIND_ASSERT(r_.front() == 0);
+        WHIRLWIND_ASSERT(r_.back() == std::size(c_));
+        WHIRLWIND_DEBUG_ASSERT(std::is_sorted(std::begin(r_), std::end(r_)));
+    }
 
-              const auto num_vertices = max_vertex_id + 1;
-              graph.r_.resize(num_vertices + 1, edge_count);
+    /**
+     * The row offset array.
+     *
+     * Contains `num_vertices() + 1` elements. The outgoing edges of the vertex with
+     * index `i` are the edges with indices in [`row_offsets()[i]`,
+     * `row_offsets()[i + 1]`).
+     */
+    [[nodiscard]] constexpr auto
+    row_offsets() const noexcept -> const container_type<edge_type>&
+    {
+        return r_;
+    }
 
-              return graph;
-          }())
-    {}
+    /**
+     * The column index array.
+     *
+     * Contains `num_edges()` elements. The element at position `i` is the head vertex
+     * of the edge with index `i`.
+     */
+    [[nodiscard]] constexpr auto
+    column_indices() const noexcept -> const container_type<vertex_type>&
+    {
+        return c_;
+    }
 
     /** The total number of vertices in the graph. */
     [[nodiscard]] constexpr auto
@@ -152,7 +280,8 @@ public:
     [[nodiscard]] constexpr auto
     vertices() const
     {
-        return ranges::views::iota(vertex_type{0}, num_vertices());
+        return ranges::views::iota(vertex_type{0},
+                                   static_cast<vertex_type>(num_vertices()));
     }
 
     /**
@@ -163,7 +292,7 @@ public:
     [[nodiscard]] constexpr auto
     edges() const
     {
-        return ranges::views::iota(edge_type{0}, num_edges());
+        return ranges::views::iota(edge_type{0}, static_cast<edge_type>(num_edges()));
     }
 
     /** Check whether the graph contains the specified vertex. */
@@ -230,7 +359,47 @@ public:
                ranges::views::transform(std::move(to_pair));
     }
 
+    /**
+     * The number of bytes of memory owned by the graph's row offset and column index
+     * arrays (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(r_) + get_memory_usage(c_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store a graph.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the graph.
+     * @param[in] num_edges
+     *     The number of edges in the graph.
+     *
+     * @returns
+     *     The estimated size of the graph's row offset and column index arrays.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type num_vertices, size_type num_edges) noexcept -> size_type
+    {
+        return estimate_array_memory<edge_type, Container>(num_vertices + 1) +
+               estimate_array_memory<vertex_type, Container>(num_edges);
+    }
+
 private:
+    // Increment `count` and return its previous value. If `concurrent` is true, the
+    // update is performed atomically.
+    static auto
+    fetch_increment(index_type& count, bool concurrent) -> index_type
+    {
+        if (concurrent) {
+            return std::atomic_ref<index_type>(count).fetch_add(
+                    1, std::memory_order_relaxed);
+        }
+        return count++;
+    }
+
     container_type<edge_type> r_;
     container_type<vertex_type> c_;
 };
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/mapped_file.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/const_span.hpp>
+
+#include "csr_graph.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * The version number of the binary file format written by `write_csr_graph()` (and
+ * `write_residual_graph()` and `write_checkpoint()`).
+ *
+ * The version is incremented whenever the layout changes. Files with a different
+ * version are rejected when loaded.
+ */
+inline constexpr std::uint32_t binary_format_version = 1;
+
+namespace detail {
+
+// The kinds of object that may be stored in a binary file.
+enum class BinaryFileKind : std::uint32_t {
+    csr_graph = 1,
+    residual_graph = 2,
+    network_checkpoint = 3,
+};
+
+// The binary file layout is a fixed-size header followed by a sequence of arrays.
+// Each array begins at an offset that is a multiple of `binary_array_alignment`
+// bytes, and is stored as raw elements in native byte order, so that it may be
+// accessed in-place from a memory-mapped file.
+//
+// Files are not portable between platforms with different byte orders; a byte order
+// marker in the header is used to detect this.
+struct BinaryFileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    BinaryFileKind kind;
+    std::uint32_t index_size;
+    std::uint32_t byte_order;
+    std::uint64_t num_vertices;
+    std::uint64_t num_edges;
+    std::array<std::uint64_t, 3> reserved;
+};
+
+WHIRLWIND_STATIC_ASSERT(sizeof(BinaryFileHeader) == 64);
+WHIRLWIND_STATIC_ASSERT(std::is_trivially_copyable_v<BinaryFileHeader>);
+
+inline constexpr std::array<char, 8> binary_file_magic = {'W', 'H', 'I', 'R',
+                                                          'L', 'W', 'N', 'D'};
+inline constexpr std::uint32_t binary_byte_order_marker = 0x01020304U;
+inline constexpr std::size_t binary_array_alignment = 64;
+
+// Writes a binary file header and arrays to an output stream.
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& os) : os_(os) {}
+
+    void
+    write_header(BinaryFileKind kind,
+                 std::size_t index_size,
+                 std::size_t num_vertices,
+                 std::size_t num_edges)
+    {
+        auto header = BinaryFileHeader{};
+        header.magic = binary_file_magic;
+        header.version = binary_format_version;
+        header.kind = kind;
+        header.index_size = static_cast<std::uint32_t>(index_size);
+        header.byte_order = binary_byte_order_marker;
+        header.num_vertices = num_vertices;
+        header.num_edges = num_edges;
+        header.reserved = {};
+        write_bytes(&header, sizeof(header));
+    }
+
+    template<class Range>
+    void
+    write_array(const Range& range)
+    {
+        using T = std::remove_cvref_t<decltype(*std::begin(range))>;
+        WHIRLWIND_STATIC_ASSERT(std::is_trivially_copyable_v<T>);
+
+        pad();
+        for (const auto& value : range) {
+            const auto element = static_cast<T>(value);
+            write_bytes(&element, sizeof(element));
+        }
+    }
+
+private:
+    void
+    write_bytes(const void* ptr, std::size_t count)
+    {
+        os_.write(static_cast<const char*>(ptr), static_cast<std::streamsize>(count));
+        if (!os_) {
+            throw std::runtime_error("failed to write binary file");
+        }
+        offset_ += count;
+    }
+
+    // Write zero bytes up to the next array boundary.
+    void
+    pad()
+    {
+        constexpr auto zeros = std::array<char, binary_array_alignment>{};
+        const auto remainder = offset_ % binary_array_alignment;
+        if (remainder != 0) {
+            write_bytes(std::data(zeros), binary_array_alignment - remainder);
+        }
+    }
+
+    std::ostream& os_;
+    std::size_t offset_ = 0;
+};
+
+// Reads a binary file header and arrays in-place from a memory buffer.
+class BinaryReader {
+public:
+    explicit BinaryReader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    [[nodiscard]] auto
+    read_header(BinaryFileKind kind, std::size_t index_size) -> BinaryFileHeader
+    {
+        if (std::size(bytes_) < sizeof(BinaryFileHeader)) {
+            throw std::runtime_error("binary file is truncated");
+        }
+
+        auto header = BinaryFileHeader{};
+        std::memcpy(&header, std::data(bytes_), sizeof(header));
+        offset_ = sizeof(header);
+
+        if (header.magic != binary_file_magic) {
+            throw std::runtime_error("not a whirlwind binary file");
+        }
+        if (header.version != binary_format_version) {
+            throw std::runtime_error("unsupported binary file format version " +
+                                     std::to_string(header.version));
+        }
+        if (header.byte_order != binary_byte_order_marker) {
+            throw std::runtime_error("binary file has incompatible byte order");
+        }
+        if (header.kind != kind) {
+            throw std::runtime_error("binary file contains unexpected object kind");
+        }
+        if (header.index_size != index_size) {
+            throw std::runtime_error("binary file has mismatched index size " +
+                                     std::to_string(header.index_size));
+        }
+
+        return header;
+    }
+
+    template<class T>
+    [[nodiscard]] auto
+    read_array(std::size_t count) -> ConstSpan<T>
+    {
+        WHIRLWIND_STATIC_ASSERT(std::is_trivially_copyable_v<T>);
+
+        offset_ = (offset_ + binary_array_alignment - 1) / binary_array_alignment *
+                  binary_array_alignment;
+        const auto size = std::size(bytes_);
+        const auto available = size - std::min(offset_, size);
+        if (count > available / sizeof(T)) {
+            throw std::runtime_error("binary file is truncated");
+        }
+
+        const auto* ptr = std::data(bytes_) + offset_;
+        WHIRLWIND_ASSERT(std::bit_cast<std::uintptr_t>(ptr) % alignof(T) == 0);
+        offset_ += count * sizeof(T);
+
+        // The file contents were written as objects of type `T`.
+        // NOLINTNEXTLINE(*-reinterpret-cast)
+        return ConstSpan<T>({reinterpret_cast<const T*>(ptr), count});
+    }
+
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t offset_ = 0;
+};
+
+} // namespace detail
+
+/**
+ * Write a `CSRGraph` to an output stream in binary format.
+ *
+ * The file stores the graph's row offset and column index arrays in a versioned
+ * binary layout which may be loaded without copying via `map_csr_graph()`.
+ *
+ * @param[in,out] os
+ *     The output stream. Should be opened in binary mode.
+ * @param[in] graph
+ *     The graph.
+ *
+ * @throws std::runtime_error
+ *     If writing to the stream failed.
+ */
+template<template<class> class Container, class Index>
+void
+write_csr_graph(std::ostream& os, const CSRGraph<Container, Index>& graph)
+{
+    auto writer = detail::BinaryWriter(os);
+    writer.write_header(detail::BinaryFileKind::csr_graph, sizeof(Index),
+                        graph.num_vertices(), graph.num_edges());
+    writer.write_array(graph.row_offsets());
+    writer.write_array(graph.column_indices());
+}
+
+/**
+ * Load a `CSRGraph` from a memory-mapped binary file written by `write_csr_graph()`.
+ *
+ * The returned graph refers directly to the contents of the mapped file, so loading
+ * takes O(1) time and the graph's pages may be shared between processes. The file
+ * must outlive the graph.
+ *
+ * @tparam Index
+ *     The vertex and edge index type of the graph. Must match the index type of the
+ *     graph that was written.
+ *
+ * @param[in] file
+ *     The mapped file.
+ *
+ * @returns
+ *     A read-only graph backed by the mapped file.
+ *
+ * @throws std::runtime_error
+ *     If the file is not a valid `CSRGraph` file with the same format version, byte
+ *     order, and index size.
+ */
+template<class Index = std::size_t>
+[[nodiscard]] auto
+map_csr_graph(const MappedFile& file) -> CSRGraph<ConstSpan, Index>
+{
+    auto reader = detail::BinaryReader(file.bytes());
+    const auto header = reader.read_header(detail::BinaryFileKind::csr_graph,
+                                           sizeof(Index));
+    const auto num_vertices = static_cast<std::size_t>(header.num_vertices);
+    const auto num_edges = static_cast<std::size_t>(header.num_edges);
+
+    auto row_offsets = reader.read_array<Index>(num_vertices + 1);
+    auto column_indices = reader.read_array<Index>(num_edges);
+    if (row_offsets.front() != 0 || row_offsets.back() != num_edges) {
+        throw std::runtime_error("binary file contains invalid row offsets");
+    }
+
+    return {std::move(row_offsets), std::move(column_indices)};
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -1,18 +1,26 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/algorithm/minmax.hpp>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/range/access.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
-#include <whirlwind/container/queue.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/memory_usage.hpp>
+#include <whirlwind/container/ring_queue.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/math/numbers.hpp>
 
@@ -22,37 +30,79 @@
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/**
+ * Get the max finite reduced cost among unsaturated arcs in a network.
+ *
+ * The search may be distributed across multiple threads.
+ *
+ * @param[in] network
+ *     The network. The reduced cost of each unsaturated arc must be nonnegative.
+ * @param[in] num_threads
+ *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+ *
+ * @returns
+ *     The max arc length, or zero if there are no unsaturated arcs with finite length.
+ */
 template<class Network>
-[[nodiscard]] constexpr auto
-get_max_admissible_arc_length(const Network& network) -> typename Network::cost_type
+[[nodiscard]] auto
+get_max_admissible_arc_length(const Network& network, std::size_t num_threads = 1) ->
+        typename Network::cost_type
 {
     using Cost = typename Network::cost_type;
-    auto max_arc_length = zero<Cost>();
 
-    for (const auto& tail : network.nodes()) {
-        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
-            if (network.is_arc_saturated(arc)) {
-                continue;
-            }
+    // Get the max arc length among the outgoing arcs of a contiguous range of nodes.
+    const auto get_max_arc_length = [&](std::size_t first, std::size_t last) {
+        const auto nodes = network.nodes();
+        auto tail_it = ranges::begin(nodes);
+        using Difference = ranges::iter_difference_t<decltype(tail_it)>;
+        ranges::advance(tail_it, static_cast<Difference>(first));
+
+        auto max_arc_length = zero<Cost>();
+        for (auto i = first; i != last; ++i, ++tail_it) {
+            const auto& tail = *tail_it;
+            for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+                if (network.is_arc_saturated(arc)) {
+                    continue;
+                }
 
-            const auto arc_length = network.arc_reduced_cost(arc, tail, head);
-            WHIRLWIND_ASSERT(!std::isnan(arc_length));
-            WHIRLWIND_ASSERT(arc_length >= zero<Cost>());
-            if (std::isinf(arc_length)) {
-                continue;
-            }
+                const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+                WHIRLWIND_ASSERT(!std::isnan(arc_length));
+                WHIRLWIND_ASSERT(arc_length >= zero<Cost>());
+                if (std::isinf(arc_length)) {
+                    continue;
+                }
 
-            max_arc_length = std::max(max_arc_length, arc_length);
+                max_arc_length = std::max(max_arc_length, arc_length);
+            }
         }
-    }
-
-    return max_arc_length;
+        return max_arc_length;
+    };
+
+    const auto max = [](const Cost& lhs, const Cost& rhs) {
+        return std::max(lhs, rhs);
+    };
+    return parallel_reduce_chunks(0, network.num_nodes(), num_threads, zero<Cost>(),
+                                  max, get_max_arc_length);
 }
 
+/**
+ * Dial's algorithm for single- or multi-source shortest paths with integer lengths.
+ *
+ * Reached vertices are stored in a ring buffer of buckets indexed by distance modulo
+ * the number of buckets. By default, each bucket is a `RingQueue`, which owns no
+ * memory while empty, so the storage required is proportional to the number of
+ * buckets plus the number of queued vertices.
+ *
+ * An occupancy bitmap with one bit per bucket records which buckets may be
+ * non-empty, so that `done()` can skip directly to the next occupied bucket rather
+ * than testing each empty bucket in turn, and `reset()` only needs to clear occupied
+ * buckets. Vertices should therefore only be inserted into buckets via
+ * `push_vertex()` (or the functions that call it).
+ */
 template<class Distance,
          GraphType Graph,
          template<class> class Container = Vector,
-         class Queue = Queue<typename Graph::vertex_type>,
+         class Queue = RingQueue<typename Graph::vertex_type, Container>,
          MutableShortestPathForestType ShortestPaths =
                  ShortestPathForest<Distance, Graph, Container>>
 class Dial : public ShortestPaths {
@@ -85,17 +135,29 @@ public:
     using base_type::set_predecessor;
 
     constexpr Dial(const graph_type& g, size_type num_buckets)
-        : base_type(g), buckets_(num_buckets)
+        : base_type(g),
+          buckets_(num_buckets),
+          occupancy_(get_num_occupancy_words(num_buckets), word_type{0})
     {
         WHIRLWIND_DEBUG_ASSERT(std::size(buckets_) == num_buckets);
         WHIRLWIND_DEBUG_ASSERT(current_bucket_id() == 0);
     }
 
+    /**
+     * Create a new `Dial` solver with enough buckets for the arc lengths of a network.
+     *
+     * @param[in] network
+     *     The network.
+     * @param[in] num_threads
+     *     The maximum number of threads to use to find the max arc length. Must be at
+     *     least 1. Defaults to 1.
+     */
     template<class Network>
-    explicit constexpr Dial(const Network& network)
+    explicit constexpr Dial(const Network& network, size_type num_threads = 1)
         : Dial(network.residual_graph(), [&]() {
               // Get the max finite arc length among admissible arcs in the network.
-              const auto max_arc_length = get_max_admissible_arc_length(network);
+              const auto max_arc_length =
+                      get_max_admissible_arc_length(network, num_threads);
 
               // The min number of buckets is the max arc length + 1.
               return static_cast<size_type>(max_arc_length) + 1;
@@ -162,6 +224,20 @@ public:
         return get_bucket(current_bucket_id());
     }
 
+    /**
+     * Check whether the specified bucket is marked as occupied.
+     *
+     * A bucket that is not marked as occupied is empty. An occupied bucket may be
+     * empty if its contents were removed since it was last inspected by `done()`.
+     */
+    [[nodiscard]] constexpr auto
+    is_bucket_occupied(size_type bucket_id) const -> bool
+    {
+        WHIRLWIND_ASSERT(bucket_id < num_buckets());
+        const auto [word, bit] = get_occupancy_bit(bucket_id);
+        return (occupancy_[word] & bit) != 0;
+    }
+
     constexpr void
     advance_current_bucket()
     {
@@ -184,6 +260,7 @@ public:
 
         const auto bucket_id = get_bucket_id(distance);
         get_bucket(bucket_id).push(std::move(vertex));
+        mark_bucket_occupied(bucket_id);
     }
 
     constexpr void
@@ -228,6 +305,17 @@ public:
         WHIRLWIND_DEBUG_ASSERT(!has_visited_vertex(head));
         WHIRLWIND_DEBUG_ASSERT(distance >= distance_to_vertex(tail));
 
+        // The ring buffer can only hold vertices whose distance is less than
+        // `num_buckets()` greater than the distance of the current vertex. Reduced arc
+        // costs may grow as node potentials are updated between searches, so enlarge
+        // the ring buffer if the arc length exceeds this limit.
+        const auto tail_distance = distance_to_vertex(tail);
+        const auto arc_length = static_cast<size_type>(distance - tail_distance);
+        if (arc_length >= num_buckets()) WHIRLWIND_UNLIKELY {
+            const auto new_num_buckets = std::max(2 * num_buckets(), arc_length + 1);
+            resize_buckets(new_num_buckets, tail_distance);
+        }
+
         set_predecessor(head, std::move(tail), std::move(edge));
         WHIRLWIND_DEBUG_ASSERT(!is_root_vertex(head));
         label_vertex_reached(head);
@@ -271,14 +359,21 @@ public:
             return true;
         }
 
-        // Cycle through the ring buffer (updating `current_bucket_id_` along the
-        // way) until the first non-empty bucket is found or we arrive back at our
-        // initial position.
-        const auto old_bucket_id = current_bucket_id();
-        do {
-            // If the current bucket is not empty, check each vertex in the bucket
-            // until the first unvisited vertex is found or the bucket's contents
-            // are exhausted. Visited vertices are removed from the bucket.
+        // Jump to each occupied bucket in the ring buffer in turn, starting from the
+        // current bucket (updating `current_bucket_id_` along the way), until the
+        // first bucket containing an unvisited vertex is found or no occupied
+        // buckets remain.
+        for (;;) {
+            const auto bucket_id = find_next_occupied_bucket(current_bucket_id());
+            if (bucket_id == num_buckets()) {
+                // If we reach this point, all buckets are empty.
+                return true;
+            }
+            current_bucket_id_ = bucket_id;
+
+            // Check each vertex in the bucket until the first unvisited vertex is
+            // found or the bucket's contents are exhausted. Visited vertices are
+            // removed from the bucket.
             auto& bucket = current_bucket();
             while (!std::empty(bucket)) {
                 if (!has_visited_vertex(bucket.front())) {
@@ -286,15 +381,8 @@ public:
                 }
                 bucket.pop();
             }
-
-            // Advance to the next bucket in the ring buffer.
-            advance_current_bucket();
-            WHIRLWIND_DEBUG_ASSERT(current_bucket_id() < num_buckets());
-
-        } while (current_bucket_id() != old_bucket_id);
-
-        // If we reach this point, all buckets are empty.
-        return true;
+            mark_bucket_empty(bucket_id);
+        }
     }
 
     constexpr void
@@ -302,14 +390,186 @@ public:
     {
         base_type::reset();
 
-        // Clear the contents of each bucket and reset the current position to the
-        // first bucket.
-        ranges::for_each(buckets(), [](auto& bucket) { bucket.clear(); });
+        // Clear the contents of each occupied bucket and reset the current position to
+        // the first bucket. Buckets that are not marked as occupied are already empty.
+        for (size_type word = 0; word < std::size(occupancy_); ++word) {
+            auto bits = occupancy_[word];
+            while (bits != 0) {
+                const auto bit = static_cast<size_type>(std::countr_zero(bits));
+                buckets_[word * word_bits + bit].clear();
+                bits &= bits - 1;
+            }
+            occupancy_[word] = 0;
+        }
         current_bucket_id_ = 0;
     }
 
+    /**
+     * Reset the solver and replace its underlying graph, reusing its internal arrays.
+     *
+     * The number of buckets is retained (it grows on demand if a longer arc is
+     * encountered).
+     *
+     * @param[in] g
+     *     The new underlying graph. Must have no more vertices than the graph that the
+     *     solver was created with.
+     */
+    constexpr void
+    rebind(const graph_type& g)
+    {
+        // The forest no longer refers to any vertices once it's rebound, so resetting
+        // it afterwards only clears the solver's own state.
+        base_type::rebind(g);
+        reset();
+    }
+
+    /**
+     * The number of bytes of memory owned by the solver's shortest path forest,
+     * buckets, and occupancy bitmap (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return base_type::memory_usage() + get_memory_usage(buckets_) +
+               get_memory_usage(occupancy_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a solver.
+     *
+     * Each vertex may be queued once as a source and once for each edge relaxation
+     * that shortens the path to it, and each bucket that is used holds at least the
+     * min capacity of a queue. The estimate is an upper bound for a single search, but
+     * may be exceeded if the buckets retain capacity across searches.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the graph (e.g. the number of nodes in the
+     *     network, when searching its residual graph).
+     * @param[in] num_edges
+     *     The number of edges in the graph (e.g. the number of arcs in the residual
+     *     graph of the network).
+     * @param[in] num_buckets
+     *     The number of buckets (at least one greater than the max edge length).
+     *
+     * @returns
+     *     The estimated size of the solver's shortest path forest, buckets, and
+     *     occupancy bitmap.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type num_vertices,
+                    size_type num_edges,
+                    size_type num_buckets) noexcept -> size_type
+    {
+        const auto num_words = get_num_occupancy_words(num_buckets);
+        return base_type::estimate_memory(num_vertices) +
+               estimate_array_memory<queue_type, Container>(num_buckets) +
+               num_buckets * queue_type::estimate_memory(1) +
+               estimate_growable_array_memory<vertex_type, Container>(num_vertices +
+                                                                      num_edges) +
+               estimate_array_memory<word_type, Container>(num_words);
+    }
+
+protected:
+    // Replace the ring buffer with a new array of `num_buckets` buckets and move each
+    // unvisited vertex from the old buckets to its position in the new array. The
+    // current bucket is set to the bucket of `current_distance`.
+    constexpr void
+    resize_buckets(size_type num_buckets, const distance_type& current_distance)
+    {
+        WHIRLWIND_ASSERT(num_buckets >= 1);
+
+        auto buckets = container_type<queue_type>(num_buckets);
+        auto occupancy = container_type<word_type>(get_num_occupancy_words(num_buckets),
+                                                   word_type{0});
+        for (auto& bucket : buckets_) {
+            while (!std::empty(bucket)) {
+                auto vertex = std::move(bucket.front());
+                bucket.pop();
+                if (has_visited_vertex(vertex)) {
+                    continue;
+                }
+
+                const auto distance = distance_to_vertex(vertex);
+                WHIRLWIND_DEBUG_ASSERT(distance >= current_distance);
+                WHIRLWIND_DEBUG_ASSERT(distance - current_distance <
+                                       static_cast<distance_type>(num_buckets));
+                const auto bucket_id = static_cast<size_type>(distance) % num_buckets;
+                buckets[bucket_id].push(std::move(vertex));
+                const auto [word, bit] = get_occupancy_bit(bucket_id);
+                occupancy[word] |= bit;
+            }
+        }
+
+        buckets_ = std::move(buckets);
+        occupancy_ = std::move(occupancy);
+        current_bucket_id_ = get_bucket_id(current_distance);
+        WHIRLWIND_DEBUG_ASSERT(std::size(buckets_) == num_buckets);
+    }
+
 private:
+    using word_type = std::uint64_t;
+    static constexpr size_type word_bits = std::numeric_limits<word_type>::digits;
+
+    [[nodiscard]] static constexpr auto
+    get_num_occupancy_words(size_type num_buckets) noexcept -> size_type
+    {
+        return (num_buckets + word_bits - 1) / word_bits;
+    }
+
+    // Get the index of the occupancy word containing the bit for the specified bucket,
+    // and a mask with only that bit set.
+    [[nodiscard]] static constexpr auto
+    get_occupancy_bit(size_type bucket_id) noexcept -> std::pair<size_type, word_type>
+    {
+        return {bucket_id / word_bits, word_type{1} << (bucket_id % word_bits)};
+    }
+
+    constexpr void
+    mark_bucket_occupied(size_type bucket_id)
+    {
+        WHIRLWIND_DEBUG_ASSERT(bucket_id < num_buckets());
+        const auto [word, bit] = get_occupancy_bit(bucket_id);
+        occupancy_[word] |= bit;
+    }
+
+    constexpr void
+    mark_bucket_empty(size_type bucket_id)
+    {
+        WHIRLWIND_DEBUG_ASSERT(bucket_id < num_buckets());
+        WHIRLWIND_DEBUG_ASSERT(std::empty(get_bucket(bucket_id)));
+        const auto [word, bit] = get_occupancy_bit(bucket_id);
+        occupancy_[word] &= ~bit;
+    }
+
+    // Find the first occupied bucket at or after `bucket_id` in ring buffer order,
+    // wrapping around to the start of the ring buffer if needed. Returns
+    // `num_buckets()` if no bucket is occupied.
+    [[nodiscard]] constexpr auto
+    find_next_occupied_bucket(size_type bucket_id) const -> size_type
+    {
+        const auto n = num_buckets();
+        WHIRLWIND_DEBUG_ASSERT(bucket_id < n);
+
+        const auto num_words = std::size(occupancy_);
+        const auto first_word = bucket_id / word_bits;
+
+        // Mask off any bits in the first word that precede `bucket_id`.
+        auto bits = occupancy_[first_word] & (~word_type{0} << (bucket_id % word_bits));
+        auto word = first_word;
+        for (size_type i = 0; i <= num_words; ++i) {
+            if (bits != 0) {
+                const auto bit = static_cast<size_type>(std::countr_zero(bits));
+                return word * word_bits + bit;
+            }
+            word = (word + 1 == num_words) ? 0 : word + 1;
+            bits = occupancy_[word];
+        }
+
+        return n;
+    }
+
     container_type<queue_type> buckets_;
+    container_type<word_type> occupancy_;
     size_type current_bucket_id_ = 0;
 };
 
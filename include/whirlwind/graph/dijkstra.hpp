@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <utility>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
 #include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/heap_concepts.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/math/numbers.hpp>
 
@@ -14,6 +17,19 @@
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/**
+ * Dijkstra's algorithm for single- or multi-source shortest paths.
+ *
+ * If `Heap` is an indexed heap (see `IndexedHeapType`), each vertex is inserted into
+ * the heap at most once, keyed by its vertex index, and its priority is decreased
+ * in-place when a shorter path to it is found. Otherwise, a new heap entry is pushed
+ * each time a vertex is reached and stale entries are discarded when they reach the
+ * top of the heap.
+ *
+ * Because the distances of vertices extracted from the heap are non-decreasing, a
+ * monotone priority queue such as `RadixHeap` may also be used as the `Heap` type when
+ * distances are non-negative integers.
+ */
 template<class Distance,
          GraphType Graph,
          template<class> class Container = Vector,
@@ -43,7 +59,7 @@ public:
     using base_type::set_distance_to_vertex;
     using base_type::set_predecessor;
 
-    explicit constexpr Dijkstra(const graph_type& g) : base_type(g), heap_{}
+    explicit constexpr Dijkstra(const graph_type& g) : base_type(g), heap_(make_heap(g))
     {
         WHIRLWIND_DEBUG_ASSERT(std::empty(heap_));
     }
@@ -73,7 +89,17 @@ public:
         WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
         WHIRLWIND_ASSERT(distance >= zero<distance_type>());
         WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(vertex));
-        heap().emplace(std::move(vertex), std::move(distance));
+
+        if constexpr (IndexedHeapType<heap_type>) {
+            const auto vertex_id = graph().get_vertex_id(vertex);
+            if (heap().contains(vertex_id)) {
+                heap().decrease_key(vertex_id, std::move(distance));
+            } else {
+                heap().emplace(vertex_id, std::move(vertex), std::move(distance));
+            }
+        } else {
+            heap().emplace(std::move(vertex), std::move(distance));
+        }
     }
 
     constexpr void
@@ -130,6 +156,10 @@ public:
         WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
         WHIRLWIND_ASSERT(distance >= zero<distance_type>());
         WHIRLWIND_DEBUG_ASSERT(has_reached_vertex(vertex));
+        if constexpr (IndexedHeapType<heap_type>) {
+            // The vertex must have been popped from the heap before being visited.
+            WHIRLWIND_DEBUG_ASSERT(!heap().contains(graph().get_vertex_id(vertex)));
+        }
         label_vertex_visited(vertex);
     }
 
@@ -156,18 +186,21 @@ public:
     [[nodiscard]] constexpr auto
     done() -> bool
     {
-        // TODO: Some heap implementations support modifying the priority of nodes in
-        // the heap. In this case, each vertex should be inserted into the heap only
-        // once, and `done()` could simply check whether the heap is empty.
-        while (!heap().empty()) {
-            using std::get;
-            const auto& vertex = get<0>(heap().top());
-            if (!has_visited_vertex(vertex)) {
-                return false;
+        // Indexed heaps contain each reached, unvisited vertex exactly once, so there
+        // are no stale entries to discard.
+        if constexpr (IndexedHeapType<heap_type>) {
+            return heap().empty();
+        } else {
+            while (!heap().empty()) {
+                using std::get;
+                const auto& vertex = get<0>(heap().top());
+                if (!has_visited_vertex(vertex)) {
+                    return false;
+                }
+                heap().pop();
             }
-            heap().pop();
+            return true;
         }
-        return true;
     }
 
     constexpr void
@@ -178,7 +211,70 @@ public:
         WHIRLWIND_DEBUG_ASSERT(std::empty(heap()));
     }
 
+    /**
+     * Reset the solver and replace its underlying graph, reusing its internal arrays.
+     *
+     * @param[in] g
+     *     The new underlying graph. Must have no more vertices than the graph that the
+     *     solver was created with.
+     */
+    constexpr void
+    rebind(const graph_type& g)
+    {
+        // The forest no longer refers to any vertices once it's rebound, so resetting
+        // it afterwards only clears the solver's own state.
+        base_type::rebind(g);
+        reset();
+    }
+
+    /**
+     * The number of bytes of memory owned by the solver's shortest path forest and
+     * heap (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> std::size_t
+    {
+        return base_type::memory_usage() + get_memory_usage(heap_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a solver.
+     *
+     * An indexed heap holds at most one entry per vertex. Otherwise, the heap may hold
+     * an entry for each source plus one for each edge relaxation that shortens the
+     * path to a vertex, so the estimate is an upper bound for a single search.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the graph (e.g. the number of nodes in the
+     *     network, when searching its residual graph).
+     * @param[in] num_edges
+     *     The number of edges in the graph (e.g. the number of arcs in the residual
+     *     graph of the network).
+     *
+     * @returns
+     *     The estimated size of the solver's shortest path forest and heap.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(std::size_t num_vertices, std::size_t num_edges) noexcept
+            -> std::size_t
+    {
+        const auto heap_size = IndexedHeapType<heap_type> ? num_vertices
+                                                          : num_vertices + num_edges;
+        return base_type::estimate_memory(num_vertices) +
+               heap_type::estimate_memory(heap_size);
+    }
+
 private:
+    [[nodiscard]] static constexpr auto
+    make_heap(const graph_type& g) -> heap_type
+    {
+        if constexpr (IndexedHeapType<heap_type>) {
+            return heap_type(g.num_vertices());
+        } else {
+            return heap_type{};
+        }
+    }
+
     heap_type heap_;
 };
 
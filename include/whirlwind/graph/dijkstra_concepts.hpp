@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 
 #include <whirlwind/common/namespace.hpp>
 #include <whirlwind/container/pair_like.hpp>
@@ -37,4 +38,34 @@ concept DijkstraSolverType = detail::DijkstraSolverTypeImpl<T,
                                                             typename T::vertex_type,
                                                             typename T::edge_type>;
 
+namespace detail {
+
+template<class Visitor, class Distance, class Vertex, class Edge>
+concept DijkstraVisitorTypeImpl = requires(Visitor visitor,
+                                           const Distance d,
+                                           const Vertex v,
+                                           const Edge e,
+                                           const std::size_t n) {
+    visitor.on_source(v);
+    visitor.on_pop(v, d);
+    visitor.on_relax(e, v, v, d);
+    visitor.on_improve(e, v, v, d);
+    visitor.on_stale_pops(n);
+    visitor.on_sink_found(v);
+};
+
+} // namespace detail
+
+/**
+ * A visitor that receives the events of a shortest path search by a solver of type
+ * `DijkstraSolver` (see `NullDijkstraVisitor` for a description of each callback).
+ */
+template<class T, class DijkstraSolver>
+concept DijkstraVisitorType =
+        DijkstraSolverType<DijkstraSolver> &&
+        detail::DijkstraVisitorTypeImpl<T,
+                                        typename DijkstraSolver::distance_type,
+                                        typename DijkstraSolver::vertex_type,
+                                        typename DijkstraSolver::edge_type>;
+
 WHIRLWIND_NAMESPACE_END
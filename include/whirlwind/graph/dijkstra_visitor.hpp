@@ -0,0 +1,124 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+
+#include <whirlwind/common/namespace.hpp>
+
+#include "dijkstra_concepts.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A shortest path search visitor that ignores every event.
+ *
+ * Search drivers such as `dijkstra_ssp()` and `dijkstra_pd()` report the events of
+ * each search to an optional visitor (see `DijkstraVisitorType`), which defaults to
+ * this type. Each callback is an empty inline function, so an unvisited search compiles
+ * to the same code as one without callbacks.
+ *
+ * Custom visitors may derive from this type and hide only the callbacks that they're
+ * interested in. For example, a visitor that counts the number of times each node is
+ * popped from the queue (e.g. to produce a per-pixel heatmap of search effort) only
+ * needs to define `on_pop()`.
+ */
+struct NullDijkstraVisitor {
+    /** Called after a source vertex is added to the search. */
+    template<class Vertex>
+    constexpr void
+    on_source(const Vertex& /* source */) const noexcept
+    {}
+
+    /** Called after a vertex is popped from the queue, just before it's visited. */
+    template<class Vertex, class Distance>
+    constexpr void
+    on_pop(const Vertex& /* vertex */, const Distance& /* distance */) const noexcept
+    {}
+
+    /**
+     * Called before each unsaturated edge from a visited vertex is relaxed, with the
+     * length of the path to its head through the edge.
+     */
+    template<class Edge, class Vertex, class Distance>
+    constexpr void
+    on_relax(const Edge& /* edge */,
+             const Vertex& /* tail */,
+             const Vertex& /* head */,
+             const Distance& /* distance */) const noexcept
+    {}
+
+    /**
+     * Called before an edge relaxation improves the distance to its head (which is
+     * then pushed to the queue).
+     */
+    template<class Edge, class Vertex, class Distance>
+    constexpr void
+    on_improve(const Edge& /* edge */,
+               const Vertex& /* tail */,
+               const Vertex& /* head */,
+               const Distance& /* distance */) const noexcept
+    {}
+
+    /**
+     * Called with the number of stale queue entries (of previously visited vertices)
+     * discarded by the solver, for solvers that expose their heap.
+     */
+    constexpr void
+    on_stale_pops(std::size_t /* count */) const noexcept
+    {}
+
+    /** Called when a search that stops at the first sink reaches one. */
+    template<class Vertex>
+    constexpr void
+    on_sink_found(const Vertex& /* sink */) const noexcept
+    {}
+};
+
+namespace detail {
+
+// Check whether the shortest path search state of `Dijkstra` exposes a priority queue
+// whose size can be inspected, so that stale entries discarded by `done()` can be
+// counted.
+template<class Dijkstra>
+concept HasInspectableHeap = requires(const Dijkstra& dijkstra) {
+    { std::size(dijkstra.heap()) } -> std::convertible_to<std::size_t>;
+};
+
+// Check whether a search is done (as `dijkstra.done()`), reporting the stale priority
+// queue entries discarded by the check to `visitor`.
+template<class Dijkstra, class Visitor>
+[[nodiscard]] constexpr auto
+search_done(Dijkstra& dijkstra, Visitor& visitor) -> bool
+{
+    if constexpr (HasInspectableHeap<Dijkstra>) {
+        const auto size_before = std::size(dijkstra.heap());
+        const auto done = dijkstra.done();
+        visitor.on_stale_pops(size_before - std::size(dijkstra.heap()));
+        return done;
+    } else {
+        return dijkstra.done();
+    }
+}
+
+// Relax an edge (as `dijkstra.relax_edge()`), reporting the relaxation and, if it
+// improves the distance to the head, the improvement to `visitor`.
+template<class Dijkstra, class Visitor, class Edge, class Vertex, class Distance>
+constexpr void
+relax_edge(Dijkstra& dijkstra,
+           Visitor& visitor,
+           const Edge& edge,
+           const Vertex& tail,
+           const Vertex& head,
+           const Distance& distance)
+{
+    visitor.on_relax(edge, tail, head, distance);
+    if (distance < dijkstra.distance_to_vertex(head)) {
+        visitor.on_improve(edge, tail, head, distance);
+    }
+    dijkstra.relax_edge(edge, tail, head, distance);
+}
+
+} // namespace detail
+
+WHIRLWIND_NAMESPACE_END
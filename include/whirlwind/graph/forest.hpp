@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -8,6 +9,7 @@
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
 
 #include "graph_concepts.hpp"
@@ -25,6 +27,10 @@ WHIRLWIND_NAMESPACE_BEGIN
  * A `Forest` maintains a non-owning pointer to its underlying graph. It may be
  * invalidated if the graph is modified or its lifetime ends.
  *
+ * The forest keeps a log of each vertex whose predecessor was modified since it was
+ * last reset, so that resetting the forest takes time proportional to the number of
+ * modified vertices rather than the total number of vertices in the graph.
+ *
  * @tparam Graph
  *     The graph type.
  * @tparam Container
@@ -64,6 +70,7 @@ public:
               return pred_vertex;
           }()),
           pred_edge_(graph.num_vertices(), edge_fill_value),
+          modified_vertices_(),
           edge_fill_value_(std::move(edge_fill_value))
     {
         WHIRLWIND_DEBUG_ASSERT(std::size(pred_vertex_) == graph.num_vertices());
@@ -188,6 +195,13 @@ public:
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(pred_vertex_));
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(pred_edge_));
 
+        // A root vertex is either in its initial state or was already logged, so
+        // logging each root vertex whose predecessor is assigned records every
+        // modified vertex at least once.
+        if (pred_vertex_[vertex_id] == vertex) {
+            modified_vertices_.push_back(vertex);
+        }
+
         pred_vertex_[vertex_id] = std::move(pred_vertex);
         pred_edge_[vertex_id] = std::move(pred_edge);
     }
@@ -258,20 +272,94 @@ public:
      * Re-initializes the forest such that each vertex in the graph is the root of its
      * own singleton tree (by setting its predecessor vertex to itself). Each
      * predecessor edge is set to the value of `edge_fill_value`.
+     *
+     * Only vertices whose predecessors were modified since the last reset are
+     * re-initialized, unless that includes most of the graph.
      */
     constexpr void
     reset()
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(pred_vertex_) == graph().num_vertices());
-        ranges::copy(graph().vertices(), std::begin(pred_vertex_));
-        WHIRLWIND_DEBUG_ASSERT(std::size(pred_edge_) == graph().num_vertices());
+        const auto num_vertices = graph().num_vertices();
+        WHIRLWIND_DEBUG_ASSERT(std::size(pred_vertex_) >= num_vertices);
+        WHIRLWIND_DEBUG_ASSERT(std::size(pred_edge_) >= num_vertices);
+
+        if (std::size(modified_vertices_) >= num_vertices) {
+            ranges::copy(graph().vertices(), std::begin(pred_vertex_));
+            ranges::fill(pred_edge_, edge_fill_value());
+        } else {
+            for (const auto& vertex : modified_vertices_) {
+                const auto vertex_id = graph().get_vertex_id(vertex);
+                WHIRLWIND_DEBUG_ASSERT(vertex_id < num_vertices);
+                pred_vertex_[vertex_id] = vertex;
+                pred_edge_[vertex_id] = edge_fill_value();
+            }
+        }
+
+        modified_vertices_.clear();
+    }
+
+    /**
+     * Reset the forest and replace its underlying graph.
+     *
+     * The forest's internal arrays are reused rather than reallocated, so that a single
+     * forest may be used for a sequence of graphs (e.g. the residual graphs of
+     * successive networks). Each vertex in the new graph becomes the root of its own
+     * singleton tree. The previous graph is not accessed, so its lifetime may have
+     * already ended.
+     *
+     * @param[in] graph
+     *     The new underlying graph. Must have no more vertices than the graph that the
+     *     forest was created with. Vertex indices must be consistent with the vertices'
+     *     positions in `graph.vertices()`, as for the original graph.
+     */
+    constexpr void
+    rebind(const graph_type& graph)
+    {
+        WHIRLWIND_ASSERT(graph.num_vertices() <= std::size(pred_vertex_));
+        WHIRLWIND_DEBUG_ASSERT(std::size(pred_edge_) == std::size(pred_vertex_));
+        graph_ = std::addressof(graph);
+
+        // The modified vertices were logged in terms of the previous graph, so every
+        // vertex is re-initialized from the new graph instead.
+        ranges::copy(graph.vertices(), std::begin(pred_vertex_));
         ranges::fill(pred_edge_, edge_fill_value());
+        modified_vertices_.clear();
+    }
+
+    /**
+     * The number of bytes of memory owned by the forest's internal arrays (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> std::size_t
+    {
+        return get_memory_usage(pred_vertex_) + get_memory_usage(pred_edge_) +
+               get_memory_usage(modified_vertices_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a forest.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the underlying graph.
+     *
+     * @returns
+     *     The estimated size of the forest's internal arrays, including a log of
+     *     modified vertices that may contain each vertex once.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(std::size_t num_vertices) noexcept -> std::size_t
+    {
+        return estimate_array_memory<vertex_type, Container>(num_vertices) +
+               estimate_array_memory<edge_type, Container>(num_vertices) +
+               estimate_growable_array_memory<vertex_type, Container>(num_vertices);
     }
 
 private:
     const graph_type* graph_;
     container_type<vertex_type> pred_vertex_;
     container_type<edge_type> pred_edge_;
+    container_type<vertex_type> modified_vertices_;
     edge_type edge_fill_value_;
 };
 
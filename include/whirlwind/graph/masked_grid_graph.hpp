@@ -0,0 +1,576 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/view/cartesian_product.hpp>
+#include <range/v3/view/filter.hpp>
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/rank_bitmap.hpp>
+#include <whirlwind/container/static_vector.hpp>
+#include <whirlwind/container/vector.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A 2-dimensional rectangular grid graph with some vertices masked out.
+ *
+ * A graph consisting of the valid vertices of an M x N Cartesian grid, given by a
+ * vertex mask. Each valid vertex has an outgoing edge to each of its four neighboring
+ * vertices that is also valid. Masked vertices and their incident edges are not part of
+ * the graph: they are skipped by `vertices()` and `outgoing_edges()` and are not
+ * counted by `num_vertices()` or `num_edges()`, so per-vertex and per-edge data
+ * indexed by `get_vertex_id()` and `get_edge_id()` is only stored for valid vertices
+ * and edges.
+ *
+ * Vertices are represented by (row,col) index pairs, as in `RectangularGridGraph`.
+ * Vertex and edge indices are computed arithmetically from the grid coordinates,
+ * without storing any adjacency arrays: the masks of valid vertices and of valid pairs
+ * of adjacent vertices are stored as `RankBitmap`s, so the index of a vertex is the
+ * number of valid vertices that precede it in row-major order, and likewise for pairs
+ * of adjacent vertices. The two opposing edges between each pair of adjacent vertices
+ * (the downward or rightward edge first, then the upward or leftward edge) are
+ * numbered consecutively.
+ *
+ * @tparam P
+ *     The number of parallel edges between adjacent vertices.
+ * @tparam Dim
+ *     The type used to represent row and column indices of vertices in the graph.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the masks.
+ */
+template<std::size_t P = 1,
+         class Dim = std::size_t,
+         template<class> class Container = Vector>
+class MaskedGridGraph {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Dim>);
+
+public:
+    using dim_type = Dim;
+    using vertex_type = std::pair<dim_type, dim_type>;
+    using edge_type = std::size_t;
+    using size_type = std::size_t;
+    using outgoing_edges_type = StaticVector<std::pair<edge_type, vertex_type>, 4 * P>;
+    using bitmap_type = RankBitmap<Container>;
+
+    /**
+     * Default constructor. Creates an empty `MaskedGridGraph` with no vertices or
+     * edges.
+     */
+    constexpr MaskedGridGraph() = default;
+
+    /**
+     * Create a new `MaskedGridGraph`.
+     *
+     * @param[in] num_rows
+     *     The number of rows in the 2-D array of vertices.
+     * @param[in] num_cols
+     *     The number of columns in the 2-D array of vertices.
+     * @param[in] vertex_mask
+     *     A random-access range of `num_rows * num_cols` elements, in row-major order,
+     *     indicating whether each vertex is valid. Each element must be convertible to
+     *     `bool`.
+     */
+    template<class RandomAccessRange>
+    constexpr MaskedGridGraph(dim_type num_rows,
+                              dim_type num_cols,
+                              const RandomAccessRange& vertex_mask)
+        : num_rows_(num_rows), num_cols_(num_cols), vertex_mask_(vertex_mask)
+    {
+        if constexpr (!std::is_unsigned_v<dim_type>) {
+            WHIRLWIND_ASSERT(num_rows >= 0);
+            WHIRLWIND_ASSERT(num_cols >= 0);
+        }
+        WHIRLWIND_ASSERT(std::size(vertex_mask) == num_grid_vertices());
+        adjacency_mask_ = make_adjacency_mask();
+    }
+
+    /**
+     * Create a new `MaskedGridGraph` with the same vertex mask as another
+     * `MaskedGridGraph` but a different number of parallel edges (e.g. the residual
+     * graph of a network).
+     */
+    template<std::size_t Q>
+    explicit constexpr MaskedGridGraph(const MaskedGridGraph<Q, Dim, Container>& other)
+        : num_rows_(other.num_rows()),
+          num_cols_(other.num_cols()),
+          vertex_mask_(other.vertex_mask()),
+          adjacency_mask_(other.adjacency_mask())
+    {}
+
+    /** The number of parallel edges between adjacent vertices. */
+    [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
+    num_parallel_edges() noexcept -> size_type
+    {
+        return P;
+    }
+
+    /** The number of rows of vertices in the grid (including masked vertices). */
+    [[nodiscard]] constexpr auto
+    num_rows() const noexcept -> dim_type
+    {
+        return num_rows_;
+    }
+
+    /** The number of columns of vertices in the grid (including masked vertices). */
+    [[nodiscard]] constexpr auto
+    num_cols() const noexcept -> dim_type
+    {
+        return num_cols_;
+    }
+
+    /** The mask of valid vertices, in row-major order. */
+    [[nodiscard]] constexpr auto
+    vertex_mask() const noexcept -> const bitmap_type&
+    {
+        return vertex_mask_;
+    }
+
+    /**
+     * The mask of valid pairs of adjacent vertices: each vertically adjacent pair in
+     * row-major order of the upper vertex, then each horizontally adjacent pair in
+     * row-major order of the left vertex.
+     */
+    [[nodiscard]] constexpr auto
+    adjacency_mask() const noexcept -> const bitmap_type&
+    {
+        return adjacency_mask_;
+    }
+
+    /** The total number of valid vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_vertices() const noexcept -> size_type
+    {
+        return vertex_mask_.count();
+    }
+
+    /** The total number of edges between valid vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_edges() const noexcept -> size_type
+    {
+        return 2 * num_parallel_edges() * adjacency_mask_.count();
+    }
+
+    /**
+     * Get the unique array index of a vertex.
+     *
+     * Given a valid vertex in the graph, get the associated vertex index in the range
+     * [0, V), where V is the total number of valid vertices.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The vertex index.
+     */
+    [[nodiscard]] constexpr auto
+    get_vertex_id(const vertex_type& vertex) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        return vertex_mask_.rank(get_grid_vertex_id(vertex));
+    }
+
+    /**
+     * Get the unique array index of an edge.
+     *
+     * Edges are represented by their index, so this is the identity.
+     *
+     * @param[in] edge
+     *     The input edge. Must be a valid edge in the graph.
+     *
+     * @returns
+     *     The edge index.
+     */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const edge_type& edge) const noexcept -> size_type
+    {
+        return static_cast<size_type>(edge);
+    }
+
+    /**
+     * Iterate over vertices in the graph.
+     *
+     * Returns a view of all valid vertices in the graph in order from smallest index to
+     * largest.
+     */
+    [[nodiscard]] constexpr auto
+    vertices() const
+    {
+        auto ii = ranges::views::iota(dim_type{0}, num_rows());
+        auto jj = ranges::views::iota(dim_type{0}, num_cols());
+
+        auto to_vertex = [](const auto& vertex) -> vertex_type {
+            using std::get;
+            return vertex_type(get<0>(vertex), get<1>(vertex));
+        };
+
+        auto is_valid = [this](const auto& vertex) -> bool {
+            return vertex_mask_.test(get_grid_vertex_id(vertex));
+        };
+
+        return ranges::views::cartesian_product(std::move(ii), std::move(jj)) |
+               ranges::views::transform(std::move(to_vertex)) |
+               ranges::views::filter(std::move(is_valid));
+    }
+
+    /**
+     * Iterate over edges in the graph.
+     *
+     * Returns a view of all edges in the graph in order from smallest index to largest.
+     */
+    [[nodiscard]] constexpr auto
+    edges() const
+    {
+        return ranges::views::iota(edge_type{0}, num_edges());
+    }
+
+    /** Check whether the graph contains the specified vertex (and it is valid). */
+    [[nodiscard]] constexpr auto
+    contains_vertex(const vertex_type& vertex) const -> bool
+    {
+        return (vertex.first < num_rows()) && (vertex.second < num_cols()) &&
+               vertex_mask_.test(get_grid_vertex_id(vertex));
+    }
+
+    /** Check whether the graph contains the specified edge. */
+    [[nodiscard]] constexpr auto
+    contains_edge(const edge_type& edge) const -> bool
+    {
+        return get_edge_id(edge) < num_edges();
+    }
+
+    /**
+     * Get the number of outgoing edges of a vertex.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     The outdegree of the vertex.
+     */
+    [[nodiscard]] constexpr auto
+    outdegree(const vertex_type& vertex) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+
+        const auto i = vertex.first;
+        const auto j = vertex.second;
+
+        size_type n = 0;
+
+        // clang-format off
+        if ((i != 0) && contains_vertex({i - 1, j})) { ++n; }
+        if ((j != 0) && contains_vertex({i, j - 1})) { ++n; }
+        if ((i + 1 != num_rows()) && contains_vertex({i + 1, j})) { ++n; }
+        if ((j + 1 != num_cols()) && contains_vertex({i, j + 1})) { ++n; }
+        // clang-format on
+
+        return n * num_parallel_edges();
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the row above `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. The vertex above it
+     *     must also be valid.
+     *
+     * @returns
+     *     The upward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_up_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_ASSERT(vertex.first != 0);
+        const auto above = vertex_type(vertex.first - 1, vertex.second);
+        return make_edge(get_vertical_adjacency_id(above), 1);
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the column to the left of `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. The vertex to its left
+     *     must also be valid.
+     *
+     * @returns
+     *     The leftward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_left_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_ASSERT(vertex.second != 0);
+        const auto left = vertex_type(vertex.first, vertex.second - 1);
+        return make_edge(get_horizontal_adjacency_id(left), 1);
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the row below `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. The vertex below it
+     *     must also be valid.
+     *
+     * @returns
+     *     The downward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_down_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_ASSERT(vertex.first + 1 != num_rows());
+        return make_edge(get_vertical_adjacency_id(vertex), 0);
+    }
+
+    /**
+     * Get the outgoing edge of `vertex` whose head is the immediate neighbor of
+     * `vertex` in the column to the right of `vertex`.
+     *
+     * If there are multiple parallel directed edges between the two vertices, returns
+     * the first such edge.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph. The vertex to its
+     *     right must also be valid.
+     *
+     * @returns
+     *     The rightward-facing outgoing edge of the input vertex.
+     */
+    [[nodiscard]] constexpr auto
+    get_right_edge(const vertex_type& vertex) const -> edge_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        WHIRLWIND_ASSERT(vertex.second + 1 != num_cols());
+        return make_edge(get_horizontal_adjacency_id(vertex), 0);
+    }
+
+    /**
+     * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
+     *
+     * Returns a range of ordered (edge,head) pairs over all edges emanating from the
+     * specified vertex to its valid neighbors. The result has inline storage for at
+     * most `4 * P` elements and is returned by value, so no memory is allocated.
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     A range of the vertex's outgoing incident edges and successor vertices.
+     */
+    [[nodiscard]] constexpr auto
+    outgoing_edges(const vertex_type& vertex) const -> outgoing_edges_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+
+        const auto i = vertex.first;
+        const auto j = vertex.second;
+
+        auto outgoing = outgoing_edges_type();
+
+        // up
+        if (i != 0) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i - 1, j);
+            if (contains_vertex(head)) {
+                add_parallel_edges(outgoing, get_up_edge(vertex), head);
+            }
+        }
+
+        // left
+        if (j != 0) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i, j - 1);
+            if (contains_vertex(head)) {
+                add_parallel_edges(outgoing, get_left_edge(vertex), head);
+            }
+        }
+
+        // down
+        if (i + 1 != num_rows()) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i + 1, j);
+            if (contains_vertex(head)) {
+                add_parallel_edges(outgoing, get_down_edge(vertex), head);
+            }
+        }
+
+        // right
+        if (j + 1 != num_cols()) WHIRLWIND_LIKELY {
+            const auto head = vertex_type(i, j + 1);
+            if (contains_vertex(head)) {
+                add_parallel_edges(outgoing, get_right_edge(vertex), head);
+            }
+        }
+
+        WHIRLWIND_DEBUG_ASSERT(std::size(outgoing) == outdegree(vertex));
+        return outgoing;
+    }
+
+    /**
+     * The number of bytes of memory owned by the graph's vertex and adjacency masks
+     * (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return vertex_mask_.memory_usage() + adjacency_mask_.memory_usage();
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store a graph.
+     *
+     * @param[in] num_rows
+     *     The number of rows in the grid, including masked vertices.
+     * @param[in] num_cols
+     *     The number of columns in the grid, including masked vertices.
+     *
+     * @returns
+     *     The estimated size of the graph's vertex and adjacency masks.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type num_rows, size_type num_cols) noexcept -> size_type
+    {
+        auto bytes = bitmap_type::estimate_memory(num_rows * num_cols);
+        if ((num_rows != 0) && (num_cols != 0)) {
+            const auto m = num_rows;
+            const auto n = num_cols;
+            bytes += bitmap_type::estimate_memory((m - 1) * n + m * (n - 1));
+        }
+        return bytes;
+    }
+
+private:
+    // The total number of vertices in the grid, including masked vertices.
+    [[nodiscard]] constexpr auto
+    num_grid_vertices() const noexcept -> size_type
+    {
+        return static_cast<size_type>(num_rows()) * static_cast<size_type>(num_cols());
+    }
+
+    // The row-major index of a vertex in the grid, including masked vertices.
+    [[nodiscard]] constexpr auto
+    get_grid_vertex_id(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return static_cast<size_type>(vertex.first) *
+                       static_cast<size_type>(num_cols()) +
+               static_cast<size_type>(vertex.second);
+    }
+
+    // The index of the pair of vertically adjacent vertices whose upper vertex is
+    // `vertex` among all such pairs in the grid, including masked pairs.
+    [[nodiscard]] constexpr auto
+    get_grid_vertical_adjacency(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return get_grid_vertex_id(vertex);
+    }
+
+    // The index of the pair of horizontally adjacent vertices whose left vertex is
+    // `vertex` among all pairs of adjacent vertices in the grid, including masked
+    // pairs.
+    [[nodiscard]] constexpr auto
+    get_grid_horizontal_adjacency(const vertex_type& vertex) const noexcept -> size_type
+    {
+        const auto m = static_cast<size_type>(num_rows());
+        const auto n = static_cast<size_type>(num_cols());
+        const auto i = static_cast<size_type>(vertex.first);
+        const auto j = static_cast<size_type>(vertex.second);
+        return (m - 1) * n + i * (n - 1) + j;
+    }
+
+    // The index of a valid pair of vertically adjacent vertices among all valid pairs.
+    [[nodiscard]] constexpr auto
+    get_vertical_adjacency_id(const vertex_type& upper) const -> size_type
+    {
+        const auto k = get_grid_vertical_adjacency(upper);
+        WHIRLWIND_ASSERT(adjacency_mask_.test(k));
+        return adjacency_mask_.rank(k);
+    }
+
+    // The index of a valid pair of horizontally adjacent vertices among all valid
+    // pairs.
+    [[nodiscard]] constexpr auto
+    get_horizontal_adjacency_id(const vertex_type& left) const -> size_type
+    {
+        const auto k = get_grid_horizontal_adjacency(left);
+        WHIRLWIND_ASSERT(adjacency_mask_.test(k));
+        return adjacency_mask_.rank(k);
+    }
+
+    // The first edge from one vertex of a valid adjacent pair to the other.
+    // `direction` is 0 for the downward or rightward edge and 1 for the upward or
+    // leftward edge.
+    [[nodiscard]] static constexpr auto
+    make_edge(size_type adjacency_id, size_type direction) noexcept -> edge_type
+    {
+        return num_parallel_edges() * (2 * adjacency_id + direction);
+    }
+
+    // Make the mask of valid pairs of adjacent vertices. A pair is valid if both of its
+    // vertices are valid.
+    [[nodiscard]] constexpr auto
+    make_adjacency_mask() const -> bitmap_type
+    {
+        const auto m = static_cast<size_type>(num_rows());
+        const auto n = static_cast<size_type>(num_cols());
+        if ((m == 0) || (n == 0)) WHIRLWIND_UNLIKELY {
+            return {};
+        }
+
+        auto is_valid = Container<bool>((m - 1) * n + m * (n - 1), false);
+        for (size_type i = 0; i < m; ++i) {
+            for (size_type j = 0; j < n; ++j) {
+                const auto vertex = vertex_type(static_cast<dim_type>(i),
+                                                static_cast<dim_type>(j));
+                if (!vertex_mask_.test(get_grid_vertex_id(vertex))) {
+                    continue;
+                }
+                if ((i + 1 < m) && vertex_mask_.test(get_grid_vertex_id(vertex) + n)) {
+                    is_valid[get_grid_vertical_adjacency(vertex)] = true;
+                }
+                if ((j + 1 < n) && vertex_mask_.test(get_grid_vertex_id(vertex) + 1)) {
+                    is_valid[get_grid_horizontal_adjacency(vertex)] = true;
+                }
+            }
+        }
+        return bitmap_type(is_valid);
+    }
+
+    // Append the `P` parallel edges from some vertex to an adjacent vertex `head`,
+    // starting with the first such edge.
+    constexpr void
+    add_parallel_edges(outgoing_edges_type& outgoing,
+                       edge_type first_edge,
+                       const vertex_type& head) const
+    {
+        WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+        for (size_type p = 0; p != num_parallel_edges(); ++p) {
+            const auto edge = first_edge + p;
+            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
+            outgoing.push_back({edge, head});
+        }
+    }
+
+    dim_type num_rows_ = {};
+    dim_type num_cols_ = {};
+    bitmap_type vertex_mask_ = {};
+    bitmap_type adjacency_mask_ = {};
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+#include <range/v3/view/zip.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
+#include <whirlwind/container/vector.hpp>
+
+#include "csr_graph.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A compressed sparse row (CSR) digraph with arbitrary edge numbering.
+ *
+ * Like `CSRGraph`, the outgoing edges of each vertex are stored contiguously. However,
+ * rather than being numbered by their position in the CSR arrays, edges are labeled by
+ * an explicit edge index array, which may be any permutation of [0, E). This allows the
+ * edge numbering to encode structural information (for example, the interleaved
+ * forward/reverse arc numbering used by `InterleavedResidualGraphMixin`) independent
+ * of the adjacency order.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal index arrays.
+ * @tparam Index
+ *     The unsigned integer type used to represent vertices and edges.
+ */
+template<template<class> class Container = Vector, class Index = std::size_t>
+class PermutedCSRGraph {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Index>);
+    WHIRLWIND_STATIC_ASSERT(std::is_unsigned_v<Index>);
+
+public:
+    using index_type = Index;
+    using vertex_type = index_type;
+    using edge_type = index_type;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /** Default constructor. Creates an empty graph with no vertices or edges. */
+    constexpr PermutedCSRGraph() : r_(1, 0), c_(), e_() {}
+
+    /**
+     * Create a new `PermutedCSRGraph` from its index arrays.
+     *
+     * @param[in] row_offsets
+     *     The position of the first outgoing edge of each vertex in `column_indices`
+     *     and `edge_ids`, followed by the total number of edges. Must be non-empty and
+     *     non-decreasing, starting at zero.
+     * @param[in] column_indices
+     *     The head vertex at each position, with positions ordered by tail vertex.
+     * @param[in] edge_ids
+     *     The edge index of the edge at each position. Must be a permutation of [0, E),
+     *     where E is the total number of edges.
+     */
+    constexpr PermutedCSRGraph(container_type<edge_type> row_offsets,
+                               container_type<vertex_type> column_indices,
+                               container_type<edge_type> edge_ids)
+        : r_(std::move(row_offsets)),
+          c_(std::move(column_indices)),
+          e_(std::move(edge_ids))
+    {
+        WHIRLWIND_ASSERT(!std::empty(r_));
+        WHIRLWIND_ASSERT(r_.front() == 0);
+        WHIRLWIND_ASSERT(r_.back() == std::size(c_));
+        WHIRLWIND_ASSERT(std::size(e_) == std::size(c_));
+        WHIRLWIND_DEBUG_ASSERT(std::is_sorted(std::begin(r_), std::end(r_)));
+    }
+
+    /** The total number of vertices in the graph. */
+    [[nodiscard]] constexpr auto
+    num_vertices() const -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(!std::empty(r_));
+        return size_type{std::size(r_) - 1};
+    }
+
+    /** The total number of edges in the graph. */
+    [[nodiscard]] constexpr auto
+    num_edges() const -> size_type
+    {
+        return size_type{std::size(c_)};
+    }
+
+    /** Get the unique array index of a vertex. See `CSRGraph::get_vertex_id()`. */
+    [[nodiscard]] constexpr auto
+    get_vertex_id(const vertex_type& vertex) const noexcept -> size_type
+    {
+        return vertex;
+    }
+
+    /** Get the unique array index of an edge. See `CSRGraph::get_edge_id()`. */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const edge_type& edge) const noexcept -> size_type
+    {
+        return edge;
+    }
+
+    /** Iterate over vertices in the graph, from smallest index to largest. */
+    [[nodiscard]] constexpr auto
+    vertices() const
+    {
+        return ranges::views::iota(vertex_type{0},
+                                   static_cast<vertex_type>(num_vertices()));
+    }
+
+    /** Iterate over edges in the graph, from smallest index to largest. */
+    [[nodiscard]] constexpr auto
+    edges() const
+    {
+        return ranges::views::iota(edge_type{0}, static_cast<edge_type>(num_edges()));
+    }
+
+    /** Check whether the graph contains the specified vertex. */
+    [[nodiscard]] constexpr auto
+    contains_vertex(const vertex_type& vertex) const -> bool
+    {
+        return get_vertex_id(vertex) < num_vertices();
+    }
+
+    /** Check whether the graph contains the specified edge. */
+    [[nodiscard]] constexpr auto
+    contains_edge(const edge_type& edge) const -> bool
+    {
+        return get_edge_id(edge) < num_edges();
+    }
+
+    /** Get the number of outgoing edges of a vertex. */
+    [[nodiscard]] constexpr auto
+    outdegree(const vertex_type& vertex) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+        return r_[vertex_id + 1] - r_[vertex_id];
+    }
+
+    /**
+     * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
+     *
+     * Returns a view of ordered (edge,head) pairs over all edges emanating from the
+     * specified vertex in the graph, in adjacency order (which need not be the order
+     * of their edge indices).
+     *
+     * @param[in] vertex
+     *     The input vertex. Must be a valid vertex in the graph.
+     *
+     * @returns
+     *     A view of the vertex's outgoing incident edges and successor vertices.
+     */
+    [[nodiscard]] constexpr auto
+    outgoing_edges(const vertex_type& vertex) const
+    {
+        WHIRLWIND_ASSERT(contains_vertex(vertex));
+        const auto vertex_id = get_vertex_id(vertex);
+
+        WHIRLWIND_DEBUG_ASSERT(vertex_id + 1 < std::size(r_));
+        const auto rstart = r_[vertex_id];
+        const auto rstop = r_[vertex_id + 1];
+        auto edges = subspan_of(e_, rstart, rstop);
+        auto heads = subspan_of(c_, rstart, rstop);
+
+        auto to_pair = [](const auto& pair_like) {
+            using std::get;
+            return std::pair(get<0>(pair_like), get<1>(pair_like));
+        };
+
+        return ranges::views::zip(std::move(edges), std::move(heads)) |
+               ranges::views::transform(std::move(to_pair));
+    }
+
+    /**
+     * The number of bytes of memory owned by the graph's internal arrays (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(r_) + get_memory_usage(c_) + get_memory_usage(e_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store a graph.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the graph.
+     * @param[in] num_edges
+     *     The number of edges in the graph.
+     *
+     * @returns
+     *     The estimated size of the graph's internal arrays.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(size_type num_vertices, size_type num_edges) noexcept -> size_type
+    {
+        return estimate_array_memory<edge_type, Container>(num_vertices + 1) +
+               estimate_array_memory<vertex_type, Container>(num_edges) +
+               estimate_array_memory<edge_type, Container>(num_edges);
+    }
+
+private:
+    container_type<edge_type> r_;
+    container_type<vertex_type> c_;
+    container_type<edge_type> e_;
+};
+
+WHIRLWIND_NAMESPACE_END
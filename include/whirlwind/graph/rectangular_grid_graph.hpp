@@ -2,7 +2,6 @@
 
 #include <array>
 #include <cstddef>
-#include <generator>
 #include <type_traits>
 #include <utility>
 
@@ -13,6 +12,7 @@
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/compatibility.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/static_vector.hpp>
 
 WHIRLWIND_NAMESPACE_BEGIN
 
@@ -38,6 +38,7 @@ public:
     using vertex_type = std::pair<dim_type, dim_type>;
     using edge_type = std::size_t;
     using size_type = std::size_t;
+    using outgoing_edges_type = StaticVector<std::pair<edge_type, vertex_type>, 4 * P>;
 
     /**
      * Default constructor. Creates an empty `RectangularGridGraph` with no vertices or
@@ -335,115 +336,49 @@ public:
     /**
      * Iterate over outgoing edges (and corresponding head vertices) of a vertex.
      *
-     * Returns a view of ordered (edge,head) pairs over all edges emanating from the
-     * specified vertex in the graph.
+     * Returns a range of ordered (edge,head) pairs over all edges emanating from the
+     * specified vertex in the graph. The result has inline storage for at most `4 * P`
+     * elements and is returned by value, so no memory is allocated.
      *
      * @param[in] vertex
      *     The input vertex. Must be a valid vertex in the graph.
      *
      * @returns
-     *     A view of the vertex's outgoing incident edges and successor vertices.
+     *     A range of the vertex's outgoing incident edges and successor vertices.
      */
-    [[nodiscard]] auto
-    outgoing_edges(vertex_type vertex) const
-            -> std::generator<std::pair<edge_type, vertex_type>>
+    [[nodiscard]] constexpr auto
+    outgoing_edges(const vertex_type& vertex) const -> outgoing_edges_type
     {
         WHIRLWIND_ASSERT(contains_vertex(vertex));
 
         const auto i = vertex.first;
         const auto j = vertex.second;
 
+        auto outgoing = outgoing_edges_type();
+
         // up
         if (i != 0) WHIRLWIND_LIKELY {
-            const auto head = vertex_type(i - 1, j);
-            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
-            auto edge = get_up_edge(vertex);
-            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-            co_yield std::pair(edge, head);
-
-            if constexpr (num_parallel_edges() > 1) {
-                ++edge;
-                WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                co_yield std::pair(edge, head);
-            }
-
-            if constexpr (num_parallel_edges() > 2) {
-                for (size_type p = 2; p != num_parallel_edges(); ++p) {
-                    ++edge;
-                    WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                    co_yield std::pair(edge, head);
-                }
-            }
+            add_parallel_edges(outgoing, get_up_edge(vertex), vertex_type(i - 1, j));
         }
 
         // left
         if (j != 0) WHIRLWIND_LIKELY {
-            const auto head = vertex_type(i, j - 1);
-            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
-            auto edge = get_left_edge(vertex);
-            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-            co_yield std::pair(edge, head);
-
-            if constexpr (num_parallel_edges() > 1) {
-                ++edge;
-                WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                co_yield std::pair(edge, head);
-            }
-
-            if constexpr (num_parallel_edges() > 2) {
-                for (size_type p = 2; p != num_parallel_edges(); ++p) {
-                    ++edge;
-                    WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                    co_yield std::pair(edge, head);
-                }
-            }
+            add_parallel_edges(outgoing, get_left_edge(vertex), vertex_type(i, j - 1));
         }
 
         // down
         if (i + 1 != num_rows()) WHIRLWIND_LIKELY {
-            const auto head = vertex_type(i + 1, j);
-            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
-            auto edge = get_down_edge(vertex);
-            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-            co_yield std::pair(edge, head);
-
-            if constexpr (num_parallel_edges() > 1) {
-                ++edge;
-                WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                co_yield std::pair(edge, head);
-            }
-
-            if constexpr (num_parallel_edges() > 2) {
-                for (size_type p = 2; p != num_parallel_edges(); ++p) {
-                    ++edge;
-                    WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                    co_yield std::pair(edge, head);
-                }
-            }
+            add_parallel_edges(outgoing, get_down_edge(vertex), vertex_type(i + 1, j));
         }
 
         // right
         if (j + 1 != num_cols()) WHIRLWIND_LIKELY {
-            const auto head = vertex_type(i, j + 1);
-            WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
-            auto edge = get_right_edge(vertex);
-            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-            co_yield std::pair(edge, head);
-
-            if constexpr (num_parallel_edges() > 1) {
-                ++edge;
-                WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                co_yield std::pair(edge, head);
-            }
-
-            if constexpr (num_parallel_edges() > 2) {
-                for (size_type p = 2; p != num_parallel_edges(); ++p) {
-                    ++edge;
-                    WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
-                    co_yield std::pair(edge, head);
-                }
-            }
+            add_parallel_edges(outgoing, get_right_edge(vertex),
+                               vertex_type(i, j + 1));
         }
+
+        WHIRLWIND_DEBUG_ASSERT(std::size(outgoing) == outdegree(vertex));
+        return outgoing;
     }
 
 protected:
@@ -495,6 +430,21 @@ protected:
     }
 
 private:
+    // Append the `P` parallel edges from some vertex to an adjacent vertex `head`,
+    // starting with the first such edge.
+    constexpr void
+    add_parallel_edges(outgoing_edges_type& outgoing,
+                       edge_type first_edge,
+                       const vertex_type& head) const
+    {
+        WHIRLWIND_DEBUG_ASSERT(contains_vertex(head));
+        for (size_type p = 0; p != num_parallel_edges(); ++p) {
+            const auto edge = first_edge + p;
+            WHIRLWIND_DEBUG_ASSERT(contains_edge(edge));
+            outgoing.push_back({edge, head});
+        }
+    }
+
     dim_type num_rows_ = {};
     dim_type num_cols_ = {};
     std::array<edge_type, 3> edge_offsets_ = {};
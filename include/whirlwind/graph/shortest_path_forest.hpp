@@ -1,13 +1,16 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 
 #include <range/v3/algorithm/fill.hpp>
+#include <range/v3/view/all.hpp>
 #include <range/v3/view/filter.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/math/numbers.hpp>
 
@@ -17,6 +20,29 @@
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/**
+ * A shortest path forest in a graph.
+ *
+ * In addition to each vertex's predecessor, a `ShortestPathForest` stores the distance
+ * to each vertex and a label indicating whether it has been reached or visited by a
+ * shortest path search.
+ *
+ * The forest keeps a log of each vertex that was reached or assigned a distance since
+ * it was last reset, as well as a list of visited vertices (in the order that they
+ * were visited). Resetting the forest therefore takes time proportional to the
+ * number of vertices touched by the previous search, and iterating over visited
+ * vertices does not require scanning the full graph.
+ *
+ * @tparam Distance
+ *     The distance type.
+ * @tparam Graph
+ *     The graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal arrays of vertex
+ *     labels and distances.
+ * @tparam Base
+ *     The base forest type.
+ */
 template<class Distance,
          GraphType Graph,
          template<class> class Container = Vector,
@@ -46,7 +72,9 @@ public:
     explicit constexpr ShortestPathForest(const graph_type& g)
         : base_type(g),
           label_(g.num_vertices(), label_type::unreached),
-          distance_(g.num_vertices(), infinity<distance_type>())
+          distance_(g.num_vertices(), infinity<distance_type>()),
+          touched_vertices_(),
+          visited_vertices_()
     {
         WHIRLWIND_DEBUG_ASSERT(std::size(label_) == g.num_vertices());
         WHIRLWIND_DEBUG_ASSERT(std::size(distance_) == g.num_vertices());
@@ -86,6 +114,7 @@ public:
         WHIRLWIND_ASSERT(!has_visited_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+        touch_vertex(vertex, vertex_id);
         label_[vertex_id] = label_type::reached;
     }
 
@@ -105,23 +134,35 @@ public:
         WHIRLWIND_ASSERT(!has_visited_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+        touch_vertex(vertex, vertex_id);
         label_[vertex_id] = label_type::visited;
+        visited_vertices_.push_back(vertex);
     }
 
+    /**
+     * Iterate over reached vertices.
+     *
+     * Returns a view of all vertices that were reached (including visited vertices)
+     * since the forest was last reset.
+     */
     [[nodiscard]] constexpr auto
     reached_vertices() const
     {
-        return ranges::views::filter(graph().vertices(), [&](const auto& vertex) {
+        return ranges::views::filter(touched_vertices_, [&](const auto& vertex) {
             return has_reached_vertex(vertex);
         });
     }
 
+    /**
+     * Iterate over visited vertices.
+     *
+     * Returns a view of all vertices that were visited since the forest was last
+     * reset, in the order that they were visited.
+     */
     [[nodiscard]] constexpr auto
     visited_vertices() const
     {
-        return ranges::views::filter(graph().vertices(), [&](const auto& vertex) {
-            return has_visited_vertex(vertex);
-        });
+        return ranges::views::all(visited_vertices_);
     }
 
     [[nodiscard]] constexpr auto
@@ -139,20 +180,105 @@ public:
         WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
         const auto vertex_id = graph().get_vertex_id(vertex);
         WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(distance_));
+        touch_vertex(vertex, vertex_id);
         distance_[vertex_id] = std::move(distance);
     }
 
+    /**
+     * Reset the forest to its initial state.
+     *
+     * Marks each vertex as "unreached" and resets its distance to infinity. Only
+     * vertices that were touched since the last reset are re-initialized, unless that
+     * includes most of the graph.
+     */
     constexpr void
     reset()
     {
         base_type::reset();
+
+        if (std::size(touched_vertices_) >= graph().num_vertices()) {
+            ranges::fill(label_, label_type::unreached);
+            ranges::fill(distance_, infinity<distance_type>());
+        } else {
+            for (const auto& vertex : touched_vertices_) {
+                const auto vertex_id = graph().get_vertex_id(vertex);
+                WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+                WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(distance_));
+                label_[vertex_id] = label_type::unreached;
+                distance_[vertex_id] = infinity<distance_type>();
+            }
+        }
+
+        touched_vertices_.clear();
+        visited_vertices_.clear();
+    }
+
+    /**
+     * Reset the forest and replace its underlying graph, reusing its internal arrays.
+     * See `Forest::rebind()`.
+     */
+    constexpr void
+    rebind(const graph_type& g)
+    {
+        // Rebind the base forest first and then re-initialize every vertex, so that
+        // the previous graph is never accessed.
+        base_type::rebind(g);
         ranges::fill(label_, label_type::unreached);
         ranges::fill(distance_, infinity<distance_type>());
+        touched_vertices_.clear();
+        visited_vertices_.clear();
+    }
+
+    /**
+     * The number of bytes of memory owned by the forest's internal arrays, including
+     * those of its base forest (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> std::size_t
+    {
+        return base_type::memory_usage() + get_memory_usage(label_) +
+               get_memory_usage(distance_) + get_memory_usage(touched_vertices_) +
+               get_memory_usage(visited_vertices_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a forest.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the underlying graph.
+     *
+     * @returns
+     *     The estimated size of the forest's internal arrays, including those of its
+     *     base forest.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(std::size_t num_vertices) noexcept -> std::size_t
+    {
+        return base_type::estimate_memory(num_vertices) +
+               estimate_array_memory<label_type, Container>(num_vertices) +
+               estimate_array_memory<distance_type, Container>(num_vertices) +
+               2 * estimate_growable_array_memory<vertex_type, Container>(num_vertices);
     }
 
 private:
+    // Log a vertex the first time its label or distance is modified since the last
+    // reset. A vertex is untouched only if it is unreached and its distance is
+    // infinite, so each touched vertex is logged at least once.
+    constexpr void
+    touch_vertex(const vertex_type& vertex, std::size_t vertex_id)
+    {
+        WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(label_));
+        WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(distance_));
+        if ((label_[vertex_id] == label_type::unreached) &&
+            (distance_[vertex_id] == infinity<distance_type>())) {
+            touched_vertices_.push_back(vertex);
+        }
+    }
+
     container_type<label_type> label_;
     container_type<distance_type> distance_;
+    container_type<vertex_type> touched_vertices_;
+    container_type<vertex_type> visited_vertices_;
 };
 
 WHIRLWIND_NAMESPACE_END
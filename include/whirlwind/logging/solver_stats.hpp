@@ -0,0 +1,266 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/graph/dijkstra_visitor.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** A phase of a minimum cost flow solver whose wall time is measured separately. */
+enum class SolverPhase : unsigned char {
+    /** Shortest path searches (e.g. `dijkstra_ssp()` or `dijkstra_pd()`). */
+    search,
+    /** Augmenting flow along shortest paths. */
+    augment,
+    /** Updating the node potentials with the shortest path distances. */
+    update_potential,
+    /**
+     * Refreshing the node potentials with the distance to the nearest deficit node
+     * (see `SuccessiveShortestPathsSearch::goal_directed`).
+     */
+    refresh_potential,
+    /**
+     * Augmenting flow along admissible paths (see `PrimalDualPhase::blocking_flow`).
+     */
+    admissible_augment,
+};
+
+/** The number of enumerators of `SolverPhase`. */
+inline constexpr std::size_t num_solver_phases = 5;
+
+/**
+ * A solver statistics policy that collects nothing.
+ *
+ * This is the default `Stats` argument of the minimum cost flow solvers. Each of its
+ * member functions is an empty inline function, so instrumented solvers compile to the
+ * same code as uninstrumented ones.
+ *
+ * The statistics policy also receives the events of each shortest path search (see
+ * `NullDijkstraVisitor`). A custom search visitor may be passed to the solvers by
+ * deriving it from this type.
+ */
+struct NullSolverStats : NullDijkstraVisitor {
+    /** Whether statistics are collected. */
+    static constexpr bool enabled = false;
+
+    /** A phase timer that measures nothing. */
+    struct Timer {};
+
+    [[nodiscard]] constexpr auto
+    time_phase(SolverPhase) const noexcept -> Timer
+    {
+        return {};
+    }
+
+    constexpr void
+    add_iteration() const noexcept
+    {}
+
+    template<class Excess>
+    constexpr void
+    set_excess_remaining(const Excess&) const noexcept
+    {}
+
+    [[nodiscard]] constexpr auto
+    should_stop() const noexcept -> bool
+    {
+        return false;
+    }
+};
+
+/**
+ * A solver statistics policy that accumulates counters and per-phase wall time.
+ *
+ * Pass an instance to a minimum cost flow solver (e.g. `successive_shortest_paths()` or
+ * `primal_dual()`) to collect statistics about the solve. The counters are plain
+ * integer increments and each phase is timed with two reads of a steady clock, so the
+ * overhead is small enough to leave enabled in production. Statistics accumulate
+ * across solves until `reset()` is called.
+ */
+struct SolverStats : NullDijkstraVisitor {
+    using clock_type = std::chrono::steady_clock;
+    using duration_type = std::chrono::nanoseconds;
+
+    /** Whether statistics are collected. */
+    static constexpr bool enabled = true;
+
+    /** The number of solver iterations (augmentations or primal-dual iterations). */
+    std::size_t num_iterations = 0;
+    /** The number of nodes visited (i.e. permanently labeled) by the searches. */
+    std::size_t nodes_visited = 0;
+    /** The number of unsaturated arcs relaxed by the searches. */
+    std::size_t arcs_relaxed = 0;
+    /**
+     * The number of entries pushed into the priority queue, including sources and
+     * decrease-key operations on indexed heaps.
+     */
+    std::size_t heap_pushes = 0;
+    /** The number of unvisited nodes popped from the priority queue. */
+    std::size_t heap_pops = 0;
+    /**
+     * The number of stale priority queue entries (of previously visited nodes) that
+     * were discarded. Only counted for solvers that expose their heap; see `Dijkstra`.
+     */
+    std::size_t stale_pops = 0;
+    /** The total excess remaining after the most recent iteration. */
+    std::size_t excess_remaining = 0;
+    /** The total wall time spent in each phase, indexed by `SolverPhase`. */
+    std::array<duration_type, num_solver_phases> phase_time = {};
+
+    /** Adds the elapsed time to a phase when it goes out of scope. */
+    class Timer {
+    public:
+        explicit Timer(duration_type& total)
+            : total_(std::addressof(total)), start_(clock_type::now())
+        {}
+
+        Timer(const Timer&) = delete;
+        auto
+        operator=(const Timer&) -> Timer& = delete;
+
+        ~Timer() { *total_ += clock_type::now() - start_; }
+
+    private:
+        duration_type* total_;
+        clock_type::time_point start_;
+    };
+
+    /**
+     * Start timing a phase.
+     *
+     * @param[in] phase
+     *     The phase.
+     *
+     * @returns
+     *     A timer that adds the elapsed time to the phase when it's destroyed.
+     */
+    [[nodiscard]] auto
+    time_phase(SolverPhase phase) -> Timer
+    {
+        return Timer(phase_time[static_cast<std::size_t>(phase)]);
+    }
+
+    /** The total wall time spent in a phase. */
+    [[nodiscard]] constexpr auto
+    time(SolverPhase phase) const -> duration_type
+    {
+        return phase_time[static_cast<std::size_t>(phase)];
+    }
+
+    /** The total wall time spent in all phases. */
+    [[nodiscard]] constexpr auto
+    total_time() const -> duration_type
+    {
+        auto total = duration_type::zero();
+        for (const auto& t : phase_time) {
+            total += t;
+        }
+        return total;
+    }
+
+    constexpr void
+    add_iteration() noexcept
+    {
+        ++num_iterations;
+    }
+
+    template<class Vertex>
+    constexpr void
+    on_source(const Vertex&) noexcept
+    {
+        ++heap_pushes;
+    }
+
+    template<class Vertex, class Distance>
+    constexpr void
+    on_pop(const Vertex&, const Distance&) noexcept
+    {
+        ++heap_pops;
+        ++nodes_visited;
+    }
+
+    template<class Edge, class Vertex, class Distance>
+    constexpr void
+    on_relax(const Edge&, const Vertex&, const Vertex&, const Distance&) noexcept
+    {
+        ++arcs_relaxed;
+    }
+
+    template<class Edge, class Vertex, class Distance>
+    constexpr void
+    on_improve(const Edge&, const Vertex&, const Vertex&, const Distance&) noexcept
+    {
+        ++heap_pushes;
+    }
+
+    constexpr void
+    on_stale_pops(std::size_t count) noexcept
+    {
+        stale_pops += count;
+    }
+
+    template<class Excess>
+    constexpr void
+    set_excess_remaining(const Excess& excess) noexcept
+    {
+        excess_remaining = static_cast<std::size_t>(excess);
+    }
+
+    /**
+     * Check whether the solver should stop early.
+     *
+     * Called by the solvers between iterations, after the statistics of the previous
+     * iteration have been recorded. Always returns false; see `SolverControl` for a
+     * policy that may interrupt a solve.
+     */
+    [[nodiscard]] constexpr auto
+    should_stop() const noexcept -> bool
+    {
+        return false;
+    }
+
+    /** Reset all statistics to zero. */
+    constexpr void
+    reset() noexcept
+    {
+        *this = SolverStats();
+    }
+
+    /** Accumulate the statistics of another solve (e.g. of another tile). */
+    constexpr auto
+    operator+=(const SolverStats& other) noexcept -> SolverStats&
+    {
+        num_iterations += other.num_iterations;
+        nodes_visited += other.nodes_visited;
+        arcs_relaxed += other.arcs_relaxed;
+        heap_pushes += other.heap_pushes;
+        heap_pops += other.heap_pops;
+        stale_pops += other.stale_pops;
+        excess_remaining += other.excess_remaining;
+        for (std::size_t i = 0; i < num_solver_phases; ++i) {
+            phase_time[i] += other.phase_time[i];
+        }
+        return *this;
+    }
+};
+
+namespace detail {
+
+// Call `func()` and return its result, adding the elapsed wall time to a phase of
+// `stats`.
+template<class Stats, class Func>
+constexpr auto
+timed_phase(Stats& stats, SolverPhase phase, Func&& func) -> decltype(auto)
+{
+    [[maybe_unused]] const auto timer = stats.time_phase(phase);
+    return std::forward<Func>(func)();
+}
+
+} // namespace detail
+
+WHIRLWIND_NAMESPACE_END
@@ -15,7 +15,8 @@
 
 #include <experimental/mdarray>
 
-#include "namespace.hpp"
+#include <whirlwind/common/namespace.hpp>
+
 #include "ndspan.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
@@ -14,7 +14,7 @@
 
 #include <experimental/mdspan>
 
-#include "namespace.hpp"
+#include <whirlwind/common/namespace.hpp>
 
 WHIRLWIND_NAMESPACE_BEGIN
 
@@ -24,6 +24,9 @@ using LayoutLeft = std::experimental::layout_left;
 /** A C-style (row-major) array layout. */
 using LayoutRight = std::experimental::layout_right;
 
+/** An array layout with an arbitrary (non-negative) stride in each dimension. */
+using LayoutStride = std::experimental::layout_stride;
+
 /**
  * A multi-dimensional index space.
  *
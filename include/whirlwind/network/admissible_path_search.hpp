@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#include <range/v3/algorithm/fill.hpp>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/iterator/traits.hpp>
+#include <range/v3/range/access.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Augments flow along paths of zero reduced cost from excess nodes to deficit nodes.
+ *
+ * An arc in the residual graph is *admissible* if it has nonzero residual capacity and
+ * zero reduced cost. If the network's node potentials satisfy the reduced cost
+ * optimality conditions (i.e. no unsaturated arc has negative reduced cost), then any
+ * path of admissible arcs is a shortest path, and augmenting flow along it preserves
+ * the optimality conditions, since the transpose of each arc along the path also has
+ * zero reduced cost.
+ *
+ * `AdmissiblePathSearch` repeatedly finds such paths by depth-first search and
+ * augments flow along them until no more can be found (i.e. a blocking flow in the
+ * admissible subgraph). Each node keeps a cursor into its list of outgoing arcs that
+ * only moves forward during a call to `augment()`, and nodes from which no deficit
+ * node was found are not revisited, so each call takes O(N + A) time plus O(L) time
+ * for each augmenting path of length L, where N and A are the number of nodes and arcs
+ * in the residual graph. Some paths created by earlier augmentations during the same
+ * call may be missed as a result; these are found by the next shortest path search
+ * instead.
+ *
+ * @tparam Graph
+ *     The residual graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal arrays.
+ */
+template<class Graph, template<class> class Container = Vector>
+class AdmissiblePathSearch {
+public:
+    using graph_type = Graph;
+    using vertex_type = typename graph_type::vertex_type;
+    using edge_type = typename graph_type::edge_type;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /**
+     * Create a new `AdmissiblePathSearch` for a network's residual graph.
+     *
+     * @param[in] network
+     *     The network. Must outlive the `AdmissiblePathSearch` object (or until it is
+     *     rebound to another graph).
+     */
+    template<class Network>
+    explicit constexpr AdmissiblePathSearch(const Network& network)
+        : graph_(std::addressof(network.residual_graph())),
+          label_(network.residual_graph().num_vertices(), label_type{0}),
+          current_arc_(network.residual_graph().num_vertices(), size_type{0}),
+          is_on_path_(network.residual_graph().num_vertices(), false)
+    {}
+
+    /** The residual graph. */
+    [[nodiscard]] constexpr auto
+    graph() const noexcept -> const graph_type&
+    {
+        WHIRLWIND_DEBUG_ASSERT(graph_ != nullptr);
+        return *graph_;
+    }
+
+    /**
+     * Replace the underlying graph, reusing the internal arrays.
+     *
+     * @param[in] g
+     *     The new residual graph. Must have no more vertices than the graph that the
+     *     object was constructed with.
+     */
+    constexpr void
+    rebind(const graph_type& g)
+    {
+        WHIRLWIND_ASSERT(g.num_vertices() <= std::size(label_));
+        graph_ = std::addressof(g);
+    }
+
+    /**
+     * Augment flow along admissible paths from excess nodes to deficit nodes until the
+     * search is blocked.
+     *
+     * @param[in,out] network
+     *     The network. Its residual graph must be the graph that the object is bound
+     *     to, and its node potentials must satisfy the reduced cost optimality
+     *     conditions.
+     *
+     * @returns
+     *     The number of augmenting paths.
+     */
+    template<class Network>
+    constexpr auto
+    augment(Network& network) -> size_type
+    {
+        WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) == graph_);
+
+        next_label();
+
+        // Augmentations modify the set of excess nodes, so take a copy of it first.
+        const auto& excess_nodes = network.excess_nodes();
+        sources_.assign(std::begin(excess_nodes), std::end(excess_nodes));
+
+        size_type num_paths = 0;
+        for (const auto& source : sources_) {
+            while (network.is_excess_node(source) && !is_dead(source)) {
+                if (!find_path(network, source)) {
+                    break;
+                }
+                augment_path(network);
+                ++num_paths;
+            }
+        }
+
+        return num_paths;
+    }
+
+private:
+    using label_type = std::uint32_t;
+
+    // A node along the current search path and the arc used to reach it.
+    struct PathEntry {
+        vertex_type node;
+        edge_type arc;
+    };
+
+    // The current arc of a node from which no deficit node can be reached.
+    static constexpr size_type dead_arc = std::numeric_limits<size_type>::max();
+
+    // Start a new labeling pass. The label array is only cleared if the label counter
+    // wraps around.
+    constexpr void
+    next_label()
+    {
+        ++label_counter_;
+        if (label_counter_ == label_type{0}) WHIRLWIND_UNLIKELY {
+            ranges::fill(label_, label_type{0});
+            label_counter_ = 1;
+        }
+    }
+
+    [[nodiscard]] constexpr auto
+    is_labeled(const vertex_type& node) const -> bool
+    {
+        const auto node_id = graph().get_vertex_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(label_));
+        return label_[node_id] == label_counter_;
+    }
+
+    // Label a node as visited during the current pass, if it wasn't already, and reset
+    // its current arc to its first outgoing arc.
+    constexpr void
+    visit(const vertex_type& node)
+    {
+        const auto node_id = graph().get_vertex_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(label_));
+        if (label_[node_id] != label_counter_) {
+            label_[node_id] = label_counter_;
+            current_arc_[node_id] = 0;
+        }
+    }
+
+    [[nodiscard]] constexpr auto
+    is_dead(const vertex_type& node) const -> bool
+    {
+        const auto node_id = graph().get_vertex_id(node);
+        return is_labeled(node) && (current_arc_[node_id] == dead_arc);
+    }
+
+    [[nodiscard]] constexpr auto
+    is_on_path(const vertex_type& node) const -> bool
+    {
+        const auto node_id = graph().get_vertex_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(is_on_path_));
+        return is_on_path_[node_id];
+    }
+
+    constexpr void
+    push_path(const vertex_type& node, const edge_type& arc)
+    {
+        visit(node);
+        is_on_path_[graph().get_vertex_id(node)] = true;
+        path_.push_back({node, arc});
+    }
+
+    // Search for an admissible path from the source to any deficit node. If one was
+    // found, the path is left in `path_` and true is returned. Otherwise, every node
+    // reachable from the source is marked dead and false is returned.
+    template<class Network>
+    constexpr auto
+    find_path(const Network& network, const vertex_type& source) -> bool
+    {
+        using Cost = typename Network::cost_type;
+
+        path_.clear();
+        push_path(source, edge_type{});
+
+        while (!std::empty(path_)) {
+            const auto tail = path_.back().node;
+            if ((std::size(path_) > 1) && network.is_deficit_node(tail)) {
+                return true;
+            }
+
+            // Resume the scan of the node's outgoing arcs from its current arc. The
+            // current arc is only advanced past arcs that are not (or no longer)
+            // admissible, or that lead to dead nodes or nodes on the path.
+            const auto tail_id = graph().get_vertex_id(tail);
+            WHIRLWIND_DEBUG_ASSERT(current_arc_[tail_id] != dead_arc);
+            auto& current_arc = current_arc_[tail_id];
+            const auto outgoing = network.outgoing_arcs(tail);
+            auto it = ranges::begin(outgoing);
+            using Difference = ranges::iter_difference_t<decltype(it)>;
+            it = ranges::next(it, static_cast<Difference>(current_arc),
+                              ranges::end(outgoing));
+
+            auto advanced = false;
+            for (; it != ranges::end(outgoing); ++it, ++current_arc) {
+                const auto [arc, head] = *it;
+                if (is_on_path(head) || is_dead(head) ||
+                    network.is_arc_saturated(arc)) {
+                    continue;
+                }
+                if (network.arc_reduced_cost(arc, tail, head) != zero<Cost>()) {
+                    continue;
+                }
+
+                push_path(head, arc);
+                advanced = true;
+                break;
+            }
+
+            // Nodes with no remaining admissible successors are dead, so they're not
+            // searched again during this pass.
+            if (!advanced) {
+                current_arc = dead_arc;
+                is_on_path_[tail_id] = false;
+                path_.pop_back();
+            }
+        }
+
+        return false;
+    }
+
+    // Augment flow along the path found by `find_path()`, by the min of the source's
+    // excess, the sink's deficit, and the residual capacity of each arc along it.
+    template<class Network>
+    constexpr void
+    augment_path(Network& network)
+    {
+        using Flow = typename Network::flow_type;
+
+        WHIRLWIND_DEBUG_ASSERT(std::size(path_) >= 2);
+        const auto& source = path_.front().node;
+        const auto& sink = path_.back().node;
+        WHIRLWIND_ASSERT(network.is_excess_node(source));
+        WHIRLWIND_ASSERT(network.is_deficit_node(sink));
+
+        auto delta = std::min(network.node_excess(source),
+                              static_cast<Flow>(-network.node_excess(sink)));
+        for (auto it = std::next(std::begin(path_)); it != std::end(path_); ++it) {
+            delta = std::min(delta, network.arc_residual_capacity(it->arc));
+        }
+        WHIRLWIND_ASSERT(delta > zero<Flow>());
+
+        network.increase_node_excess(sink, delta);
+        for (auto it = std::next(std::begin(path_)); it != std::end(path_); ++it) {
+            network.increase_arc_flow(it->arc, delta);
+        }
+        network.decrease_node_excess(source, delta);
+
+        // The nodes along the path keep their current arcs, so subsequent searches
+        // resume from the arcs that were used by this path.
+        for (const auto& entry : path_) {
+            is_on_path_[graph().get_vertex_id(entry.node)] = false;
+        }
+    }
+
+    const graph_type* graph_;
+    container_type<label_type> label_;
+    label_type label_counter_ = 0;
+    container_type<size_type> current_arc_;
+    container_type<bool> is_on_path_;
+    container_type<vertex_type> sources_ = {};
+    container_type<PathEntry> path_ = {};
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/graph_concepts.hpp>
+
+#include "network.hpp"
+#include "residual_graph.hpp"
+#include "shared_residual_graph.hpp"
+#include "solver_workspace_concepts.hpp"
+#include "uncapacitated.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * An uncapacitated network that refers to a `SharedResidualGraph`.
+ *
+ * Networks with other capacity mixins may be formed in the same way, e.g.
+ * `Network<Graph, Cost, Flow, Container, UnitCapacityMixin<Graph, Flow, Container,
+ * SharedResidualGraphMixin<ResidualGraphMixin<Graph, Container>>>>`.
+ */
+template<GraphType Graph,
+         class Cost,
+         class Flow,
+         template<class> class Container = Vector>
+using SharedResidualGraphNetwork =
+        Network<Graph,
+                Cost,
+                Flow,
+                Container,
+                UncapacitatedMixin<Graph,
+                                   Flow,
+                                   Container,
+                                   SharedResidualGraphMixin<
+                                           ResidualGraphMixin<Graph, Container>>>>;
+
+/**
+ * Solve a batch of independent minimum cost flow problems concurrently.
+ *
+ * Each network is passed to `solve` along with a solver workspace owned by the thread
+ * that solves it. Each of up to `num_threads` threads creates a single `Workspace` and
+ * repeatedly claims the next unsolved network, so the solver state is allocated once
+ * per thread and reused for each network that it solves (see `SolverWorkspace`).
+ *
+ * This is most effective for many networks of the same size, e.g. one per scene of an
+ * interferogram stack. If the networks are built on a `SharedResidualGraph` (see
+ * `SharedResidualGraphNetwork`), they share a single copy of their residual graph, and
+ * each network stores only its own node excesses and potentials and arc flows and
+ * costs.
+ *
+ * If any invocation of `solve` throws an exception, the thread that invoked it stops
+ * claiming networks and the exception is rethrown after all threads have finished.
+ *
+ * @tparam Workspace
+ *     The solver workspace type (e.g. `SolverWorkspace<Dijkstra>`).
+ *
+ * @param[in,out] networks
+ *     A random access range of networks. Each network is solved in-place.
+ * @param[in] solve
+ *     A callable object that solves a network in-place using a workspace, e.g.
+ *     `[](auto& network, auto& workspace) { primal_dual(network, workspace); }`. It
+ *     may be invoked concurrently from multiple threads.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ */
+template<SolverWorkspaceType Workspace, class RandomAccessRange, class SolveFunc>
+void
+solve_batch(RandomAccessRange& networks,
+            const SolveFunc& solve,
+            std::size_t num_threads = 1)
+{
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    const auto num_networks = static_cast<std::size_t>(std::size(networks));
+    const auto first = std::begin(networks);
+
+    auto next = std::atomic<std::size_t>(0);
+    const auto num_workers = std::clamp(num_networks, std::size_t{1}, num_threads);
+    parallel_for_chunks(0, num_workers, num_workers, [&](auto, auto) {
+        auto workspace = Workspace();
+        while (true) {
+            const auto k = next.fetch_add(1, std::memory_order_relaxed);
+            if (k >= num_networks) {
+                break;
+            }
+            using Difference = std::iter_difference_t<decltype(first)>;
+            solve(*std::next(first, static_cast<Difference>(k)), workspace);
+        }
+    });
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/view/transform.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/mapped_file.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/const_span.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph_io.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// A description of the flow and cost types of a checkpoint, stored as its first array
+// so that a checkpoint is not restored with mismatched types.
+template<class Flow, class Cost>
+[[nodiscard]] constexpr auto
+checkpoint_type_info() noexcept -> std::array<std::uint64_t, 4>
+{
+    return {sizeof(Flow), std::is_floating_point_v<Flow> ? 1U : 0U, sizeof(Cost),
+            std::is_floating_point_v<Cost> ? 1U : 0U};
+}
+
+} // namespace detail
+
+/**
+ * A read-only view of the mutable state of a network stored in a checkpoint file.
+ *
+ * @tparam Flow
+ *     The flow type of the network.
+ * @tparam Cost
+ *     The cost type of the network.
+ */
+template<class Flow, class Cost>
+struct NetworkCheckpoint {
+    /** The excess of each node, indexed by node ID. */
+    ConstSpan<Flow> node_excess;
+
+    /** The potential of each node, indexed by node ID. */
+    ConstSpan<Cost> node_potential;
+
+    /**
+     * The flow in each forward arc, indexed by the corresponding edge in the original
+     * graph.
+     */
+    ConstSpan<Flow> edge_flow;
+};
+
+/**
+ * Write a checkpoint of the mutable state of a network to an output stream in binary
+ * format.
+ *
+ * The checkpoint stores the network's node excesses, node potentials, and the flow in
+ * each forward arc, in the same versioned binary layout as `write_residual_graph()`,
+ * so that it may be loaded without copying via `map_checkpoint()`. The graph and arc
+ * costs are not stored; they are assumed to be reconstructed when the solve is
+ * resumed (see `restore_checkpoint()`).
+ *
+ * A checkpoint may be written between iterations of `successive_shortest_paths()` or
+ * `primal_dual()` from the progress callback of a `SolverControl`, e.g. every N
+ * iterations, since the network is not modified while the callback runs.
+ *
+ * @param[in,out] os
+ *     The output stream. Should be opened in binary mode.
+ * @param[in] network
+ *     The network.
+ *
+ * @throws std::runtime_error
+ *     If writing to the stream failed.
+ */
+template<class Network>
+void
+write_checkpoint(std::ostream& os, const Network& network)
+{
+    using Flow = typename Network::flow_type;
+    using Cost = typename Network::cost_type;
+
+    auto writer = detail::BinaryWriter(os);
+    writer.write_header(detail::BinaryFileKind::network_checkpoint, sizeof(Flow),
+                        network.num_nodes(), network.num_forward_arcs());
+    writer.write_array(detail::checkpoint_type_info<Flow, Cost>());
+
+    const auto nodes = network.nodes();
+    writer.write_array(nodes | ranges::views::transform([&](const auto& node) {
+                           return static_cast<Flow>(network.node_excess(node));
+                       }));
+    writer.write_array(nodes | ranges::views::transform([&](const auto& node) {
+                           return static_cast<Cost>(network.node_potential(node));
+                       }));
+
+    // Arc flows are written in order of their corresponding edge in the original graph.
+    auto edge_flow = Vector<Flow>(network.num_forward_arcs(), zero<Flow>());
+    for (const auto& arc : network.forward_arcs()) {
+        const auto edge_id = network.get_edge_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(edge_flow));
+        edge_flow[edge_id] = static_cast<Flow>(network.arc_flow(arc));
+    }
+    writer.write_array(edge_flow);
+}
+
+/**
+ * Load a network checkpoint from a memory-mapped binary file written by
+ * `write_checkpoint()`.
+ *
+ * The returned view refers directly to the contents of the mapped file, which must
+ * outlive it.
+ *
+ * @tparam Flow
+ *     The flow type of the network. Must match the flow type of the checkpoint.
+ * @tparam Cost
+ *     The cost type of the network. Must match the cost type of the checkpoint.
+ *
+ * @param[in] file
+ *     The mapped file.
+ *
+ * @returns
+ *     A read-only view of the checkpoint backed by the mapped file.
+ *
+ * @throws std::runtime_error
+ *     If the file is not a valid checkpoint file with the same format version, byte
+ *     order, and flow and cost types.
+ */
+template<class Flow, class Cost>
+[[nodiscard]] auto
+map_checkpoint(const MappedFile& file) -> NetworkCheckpoint<Flow, Cost>
+{
+    auto reader = detail::BinaryReader(file.bytes());
+    const auto header = reader.read_header(detail::BinaryFileKind::network_checkpoint,
+                                           sizeof(Flow));
+    const auto num_nodes = static_cast<std::size_t>(header.num_vertices);
+    const auto num_edges = static_cast<std::size_t>(header.num_edges);
+
+    const auto type_info = reader.read_array<std::uint64_t>(4);
+    const auto expected_type_info = detail::checkpoint_type_info<Flow, Cost>();
+    for (std::size_t i = 0; i < std::size(expected_type_info); ++i) {
+        if (type_info[i] != expected_type_info[i]) {
+            throw std::runtime_error("checkpoint has mismatched flow or cost type");
+        }
+    }
+
+    auto node_excess = reader.read_array<Flow>(num_nodes);
+    auto node_potential = reader.read_array<Cost>(num_nodes);
+    auto edge_flow = reader.read_array<Flow>(num_edges);
+    return {std::move(node_excess), std::move(node_potential), std::move(edge_flow)};
+}
+
+/**
+ * Restore the mutable state of a network from a checkpoint.
+ *
+ * The network must have been constructed in the same way as the network that the
+ * checkpoint was taken from (with the same graph, node surpluses, and arc costs) and
+ * must not carry any flow. The checkpointed flows are added to the network, moving its
+ * node excesses accordingly, and its node potentials are replaced with the
+ * checkpointed potentials. Unlike `warm_start()`, no repair is performed, so a solve
+ * that was interrupted may be resumed by `successive_shortest_paths()` or
+ * `primal_dual()` exactly where it left off.
+ *
+ * @param[in,out] network
+ *     The network. Must not carry any flow (e.g. a newly-constructed network).
+ * @param[in] checkpoint
+ *     The checkpoint.
+ *
+ * @throws std::runtime_error
+ *     If the size of the checkpoint doesn't match the network, or if the node excesses
+ *     after restoring the flows wouldn't match the checkpoint (e.g. because the network
+ *     was constructed with different node surpluses). The network is not modified in
+ *     either case.
+ */
+template<class Network, class Flow, class Cost>
+void
+restore_checkpoint(Network& network, const NetworkCheckpoint<Flow, Cost>& checkpoint)
+{
+    if (std::size(checkpoint.node_excess) != network.num_nodes() ||
+        std::size(checkpoint.node_potential) != network.num_nodes() ||
+        std::size(checkpoint.edge_flow) != network.num_forward_arcs()) {
+        throw std::runtime_error("checkpoint size does not match the network");
+    }
+
+    // Compute the node excesses implied by the checkpointed flows and validate them
+    // before modifying the network, so that it is left unchanged if they don't match.
+    auto excess = Vector<Flow>(network.num_nodes(), zero<Flow>());
+    for (const auto& node : network.nodes()) {
+        const auto node_id = network.get_node_id(node);
+        excess[node_id] = static_cast<Flow>(network.node_excess(node));
+    }
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            if (!network.is_forward_arc(arc)) {
+                continue;
+            }
+            WHIRLWIND_ASSERT(network.arc_flow(arc) == zero<Flow>());
+
+            const auto flow = checkpoint.edge_flow[network.get_edge_id(arc)];
+            excess[network.get_node_id(tail)] -= flow;
+            excess[network.get_node_id(head)] += flow;
+        }
+    }
+    for (std::size_t node_id = 0; node_id < std::size(excess); ++node_id) {
+        if (excess[node_id] != checkpoint.node_excess[node_id]) {
+            throw std::runtime_error("checkpoint node excess does not match network");
+        }
+    }
+
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            if (!network.is_forward_arc(arc)) {
+                continue;
+            }
+
+            const auto flow = checkpoint.edge_flow[network.get_edge_id(arc)];
+            if (flow == zero<Flow>()) {
+                continue;
+            }
+
+            network.increase_arc_flow(arc, flow);
+            network.decrease_node_excess(tail, flow);
+            network.increase_node_excess(head, flow);
+        }
+    }
+
+    for (const auto& node : network.nodes()) {
+        const auto node_id = network.get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(network.node_excess(node) == excess[node_id]);
+        network.increase_node_potential(node, checkpoint.node_potential[node_id] -
+                                                      network.node_potential(node));
+    }
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include <range/v3/algorithm/sort.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "network.hpp"
+#include "packed_unit_capacity.hpp"
+#include "uncapacitated.hpp"
+#include "unit_capacity.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Replace the graph type of a network mixin.
+template<class Mixin, class NewGraph>
+struct RebindMixinGraph;
+
+template<class Graph, class Flow, template<class> class Container, class NewGraph>
+struct RebindMixinGraph<UncapacitatedMixin<Graph, Flow, Container>, NewGraph> {
+    using type = UncapacitatedMixin<NewGraph, Flow, Container>;
+};
+
+template<class Graph, class Flow, template<class> class Container, class NewGraph>
+struct RebindMixinGraph<UnitCapacityMixin<Graph, Flow, Container>, NewGraph> {
+    using type = UnitCapacityMixin<NewGraph, Flow, Container>;
+};
+
+template<class Graph,
+         class Flow,
+         class Cost,
+         template<class> class Container,
+         class NewGraph>
+struct RebindMixinGraph<PackedUnitCapacityMixin<Graph, Flow, Cost, Container>,
+                        NewGraph> {
+    using type = PackedUnitCapacityMixin<NewGraph, Flow, Cost, Container>;
+};
+
+// Get the type of network used to solve a connected component of a network: a network
+// with the same cost, flow, and container types and the same capacity mixin, over a
+// `CSRGraph` of the component's nodes and finite-cost edges.
+template<class Network>
+struct ComponentNetworkTraits;
+
+template<class Graph,
+         class Cost,
+         class Flow,
+         template<class> class Container,
+         class Mixin>
+struct ComponentNetworkTraits<Network<Graph, Cost, Flow, Container, Mixin>> {
+    using graph_type = CSRGraph<Container>;
+    using mixin_type = typename RebindMixinGraph<Mixin, graph_type>::type;
+    using type = Network<graph_type, Cost, Flow, Container, mixin_type>;
+};
+
+// Check whether an arc in the residual graph of a network corresponds to an edge with
+// finite cost.
+template<class Network>
+[[nodiscard]] constexpr auto
+has_finite_cost(const Network& network, const typename Network::arc_type& arc) -> bool
+{
+    using Arc = typename Network::arc_type;
+    using Cost = typename Network::cost_type;
+
+    if (!network.is_forward_arc(arc)) {
+        const auto forward_arc = static_cast<Arc>(network.get_transpose_arc_id(arc));
+        return network.arc_cost(forward_arc) < infinity<Cost>();
+    }
+    return network.arc_cost(arc) < infinity<Cost>();
+}
+
+} // namespace detail
+
+/**
+ * The type of network used by `solve_connected_components()` to solve each connected
+ * component of a network of type `Network`.
+ */
+template<class Network>
+using ComponentNetwork = typename detail::ComponentNetworkTraits<Network>::type;
+
+/** A summary of the connected components solved by `solve_connected_components()`. */
+struct ConnectedComponentsSummary {
+    /** The number of connected components in the network. */
+    std::size_t num_components = 0;
+    /** The number of components with any excess or deficit nodes that were solved. */
+    std::size_t num_solved = 0;
+    /**
+     * The number of components whose total excess was nonzero. These components were
+     * left unsolved.
+     */
+    std::size_t num_unbalanced = 0;
+};
+
+/**
+ * Solve a minimum cost flow problem by decomposing the network into its connected
+ * components and solving each component independently.
+ *
+ * Masked or incoherent regions are typically given infinite cost (see `infinity()`),
+ * which may split the network into many regions that share no finite-cost arcs. Since
+ * no flow may pass between them, each such region is an independent sub-problem.
+ *
+ * The connected components of the network's finite-cost edges (ignoring their
+ * direction) are found in O(V + E) time. Each component containing any excess or
+ * deficit nodes is copied into a separate `ComponentNetwork<Network>`, which has the
+ * same capacity mixin as `network` and starts from the same node potentials, and
+ * passed to `solve`. Components are processed concurrently on up to `num_threads`
+ * threads, largest first. The resulting flows and potentials are written back to
+ * `network` as each component finishes, so at most `num_threads` component networks
+ * are held in memory at once.
+ *
+ * Each component must be balanced (its total excess must be zero) to be solvable.
+ * Unbalanced components are left unsolved and counted in the returned summary.
+ * Components without any excess or deficit nodes need no flow and are skipped.
+ *
+ * @param[in,out] network
+ *     The network. Must not carry any flow (e.g. a newly-constructed network).
+ * @param[in] solve
+ *     A callable object that solves a `ComponentNetwork<Network>` in-place, e.g.
+ *     `[](auto& component) { primal_dual<Dijkstra>(component); }`. It may be invoked
+ *     concurrently from multiple threads.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ *
+ * @returns
+ *     A summary of the connected components.
+ */
+template<class Network, class SolveFunc>
+auto
+solve_connected_components(Network& network,
+                           const SolveFunc& solve,
+                           std::size_t num_threads = 1) -> ConnectedComponentsSummary
+{
+    using Node = typename Network::node_type;
+    using Arc = typename Network::arc_type;
+    using Cost = typename Network::cost_type;
+    using Flow = typename Network::flow_type;
+    using SubNetwork = ComponentNetwork<Network>;
+    using SubGraph = typename SubNetwork::graph_type;
+
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    // Label the connected components by breadth-first search along finite-cost arcs.
+    // The nodes of each component are stored contiguously, in order of discovery, and
+    // each node's index within its component is recorded.
+    constexpr auto unlabeled = std::numeric_limits<std::size_t>::max();
+    auto local_id = Vector<std::size_t>(network.num_nodes(), unlabeled);
+    auto component_nodes = Vector<Node>();
+    component_nodes.reserve(network.num_nodes());
+    auto component_first = Vector<std::size_t>{0};
+    for (const auto& root : network.nodes()) {
+        const auto root_id = network.get_node_id(root);
+        WHIRLWIND_DEBUG_ASSERT(root_id < std::size(local_id));
+        if (local_id[root_id] != unlabeled) {
+            continue;
+        }
+
+        const auto first = component_first.back();
+        local_id[root_id] = 0;
+        component_nodes.push_back(root);
+        for (auto k = first; k < std::size(component_nodes); ++k) {
+            const auto tail = component_nodes[k];
+            for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+                const auto head_id = network.get_node_id(head);
+                WHIRLWIND_DEBUG_ASSERT(head_id < std::size(local_id));
+                if ((local_id[head_id] == unlabeled) &&
+                    detail::has_finite_cost(network, arc)) {
+                    local_id[head_id] = std::size(component_nodes) - first;
+                    component_nodes.push_back(head);
+                }
+            }
+        }
+        component_first.push_back(std::size(component_nodes));
+    }
+
+    auto summary = ConnectedComponentsSummary();
+    summary.num_components = std::size(component_first) - 1;
+
+    // Find the components that need to be solved.
+    auto pending = Vector<std::size_t>();
+    for (std::size_t c = 0; c < summary.num_components; ++c) {
+        auto total_excess = zero<Flow>();
+        auto any_excess = false;
+        for (auto k = component_first[c]; k < component_first[c + 1]; ++k) {
+            const auto& excess = network.node_excess(component_nodes[k]);
+            total_excess += excess;
+            any_excess = any_excess || (excess != zero<Flow>());
+        }
+
+        if (total_excess != zero<Flow>()) {
+            ++summary.num_unbalanced;
+        } else if (any_excess) {
+            pending.push_back(c);
+        }
+    }
+    summary.num_solved = std::size(pending);
+
+    // Start the largest components first to balance the load across threads.
+    const auto component_size = [&](std::size_t c) {
+        return component_first[c + 1] - component_first[c];
+    };
+    ranges::sort(pending, [&](const auto& lhs, const auto& rhs) {
+        return component_size(lhs) > component_size(rhs);
+    });
+
+    // A finite-cost edge of a component, stored with the local IDs of its endpoints.
+    struct ComponentArc {
+        std::size_t tail;
+        std::size_t head;
+        Arc arc;
+        Cost cost;
+    };
+
+    // Access to `network` is serialized, since its arc flows and active node sets are
+    // not safe to update (or read during updates) concurrently.
+    auto mutex = std::mutex();
+
+    const auto solve_component = [&](std::size_t c) {
+        const auto first = component_first[c];
+        const auto num_component_nodes = component_size(c);
+        const auto get_node = [&](std::size_t k) -> const Node& {
+            WHIRLWIND_DEBUG_ASSERT(k < num_component_nodes);
+            return component_nodes[first + k];
+        };
+
+        auto arcs = Vector<ComponentArc>();
+        auto surplus = Vector<Flow>(num_component_nodes);
+        auto potential = Vector<Cost>(num_component_nodes);
+        {
+            const auto lock = std::scoped_lock(mutex);
+            for (std::size_t k = 0; k < num_component_nodes; ++k) {
+                const auto& tail = get_node(k);
+                surplus[k] = network.node_excess(tail);
+                potential[k] = network.node_potential(tail);
+                for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+                    if (network.is_forward_arc(arc) &&
+                        detail::has_finite_cost(network, arc)) {
+                        WHIRLWIND_ASSERT(network.arc_flow(arc) == zero<Flow>());
+                        const auto head_id = network.get_node_id(head);
+                        arcs.push_back(
+                                {k, local_id[head_id], arc, network.arc_cost(arc)});
+                    }
+                }
+            }
+        }
+
+        // `CSRGraph` numbers edges in (tail,head) order, so after sorting, the k-th arc
+        // corresponds to the k-th edge of the component graph.
+        ranges::sort(arcs, [](const auto& lhs, const auto& rhs) {
+            return std::tie(lhs.tail, lhs.head) < std::tie(rhs.tail, rhs.head);
+        });
+        auto edge_list = EdgeList<std::size_t>();
+        auto cost = Vector<Cost>();
+        cost.reserve(std::size(arcs));
+        for (const auto& arc : arcs) {
+            edge_list.add_edge(arc.tail, arc.head);
+            cost.push_back(arc.cost);
+        }
+
+        const auto graph = SubGraph(edge_list);
+        WHIRLWIND_ASSERT(graph.num_vertices() == num_component_nodes);
+        edge_list.clear();
+
+        auto component = SubNetwork(graph, std::move(surplus), cost);
+        for (const auto& node : component.nodes()) {
+            component.increase_node_potential(node, potential[node]);
+        }
+        cost = {};
+        potential = {};
+
+        solve(component);
+        WHIRLWIND_ASSERT(component.total_excess() == 0);
+
+        const auto lock = std::scoped_lock(mutex);
+        for (const auto& sub_arc : component.forward_arcs()) {
+            const auto flow = component.arc_flow(sub_arc);
+            if (flow == zero<Flow>()) {
+                continue;
+            }
+
+            const auto edge_id = component.get_edge_id(sub_arc);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(arcs));
+            const auto& arc = arcs[edge_id];
+            network.increase_arc_flow(arc.arc, flow);
+            network.decrease_node_excess(get_node(arc.tail), flow);
+            network.increase_node_excess(get_node(arc.head), flow);
+        }
+        for (const auto& node : component.nodes()) {
+            const auto& parent_node = get_node(node);
+            const auto parent_potential = network.node_potential(parent_node);
+            const auto delta = component.node_potential(node) - parent_potential;
+            network.increase_node_potential(parent_node, delta);
+        }
+    };
+
+    // Each worker thread repeatedly claims the next pending component.
+    auto next = std::atomic<std::size_t>(0);
+    const auto num_workers =
+            std::clamp(std::size(pending), std::size_t{1}, num_threads);
+    parallel_for_chunks(0, num_workers, num_workers, [&](auto, auto) {
+        while (true) {
+            const auto k = next.fetch_add(1, std::memory_order_relaxed);
+            if (k >= std::size(pending)) {
+                break;
+            }
+            solve_component(pending[k]);
+        }
+    });
+
+    return summary;
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <range/v3/algorithm/fill.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/ring_queue.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// The state of the cost scaling push-relabel algorithm.
+//
+// Arc costs are multiplied by N + 1, where N is the number of nodes, so that the flow
+// is optimal once it is 1-optimal w.r.t. the scaled costs. The node prices are stored
+// separately from the network's node potentials, as 64-bit integers, since the scaled
+// costs and prices may exceed the range of the network's cost type. Reduced costs use
+// the same sign convention as `Network::arc_reduced_cost()`.
+//
+// Uncapacitated arcs are treated as having a capacity equal to the total supply of
+// the problem, i.e. the total excess that would remain if the network's current flow
+// were removed. This doesn't change the optimal cost since arc costs are nonnegative
+// (so some acyclic optimal flow carries no more than the total supply in any arc).
+template<class Network, template<class> class Container = Vector>
+class CostScaling {
+public:
+    using node_type = typename Network::node_type;
+    using arc_type = typename Network::arc_type;
+    using flow_type = typename Network::flow_type;
+    using cost_type = typename Network::cost_type;
+    using price_type = std::int64_t;
+    using size_type = std::size_t;
+
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<cost_type>);
+
+    explicit constexpr CostScaling(Network& network)
+        : network_(std::addressof(network)),
+          scale_(static_cast<price_type>(network.num_nodes()) + 1),
+          max_flow_(get_total_supply(network)),
+          price_(network.num_nodes()),
+          current_arc_(network.num_nodes(), size_type{0})
+    {
+        // Start from the network's node potentials.
+        for (const auto& node : network.nodes()) {
+            price_[network.get_node_id(node)] =
+                    scale_ * static_cast<price_type>(network.node_potential(node));
+        }
+    }
+
+    // The max absolute scaled reduced cost of any arc with nonzero residual capacity.
+    [[nodiscard]] constexpr auto
+    max_reduced_cost() const -> price_type
+    {
+        auto max_cost = price_type{0};
+        for (const auto& tail : network().nodes()) {
+            for (const auto& [arc, head] : network().outgoing_arcs(tail)) {
+                if (residual_capacity(arc) == zero<flow_type>()) {
+                    continue;
+                }
+                const auto cost = reduced_cost(arc, tail, head);
+                max_cost = std::max(max_cost, (cost < 0) ? -cost : cost);
+            }
+        }
+        return max_cost;
+    }
+
+    // Transform the current flow into an epsilon-optimal flow.
+    constexpr void
+    refine(price_type epsilon)
+    {
+        WHIRLWIND_ASSERT(epsilon > 0);
+
+        // Saturate each arc with negative reduced cost. This yields a 0-optimal
+        // pseudoflow.
+        for (const auto& tail : network().nodes()) {
+            for (const auto& [arc, head] : network().outgoing_arcs(tail)) {
+                const auto capacity = residual_capacity(arc);
+                if ((capacity > zero<flow_type>()) &&
+                    (reduced_cost(arc, tail, head) < 0)) {
+                    push(arc, tail, head, capacity);
+                }
+            }
+        }
+
+        // Discharge nodes with positive excess in FIFO order until none remain.
+        active_nodes_.clear();
+        for (const auto& node : network().excess_nodes()) {
+            active_nodes_.push(node);
+        }
+        ranges::fill(current_arc_, size_type{0});
+
+        while (!active_nodes_.empty()) {
+            const auto node = active_nodes_.front();
+            active_nodes_.pop();
+            discharge(node, epsilon);
+        }
+
+        WHIRLWIND_ASSERT(std::empty(network().excess_nodes()));
+        WHIRLWIND_ASSERT(std::empty(network().deficit_nodes()));
+    }
+
+    // Update the network's node potentials from the node prices, such that the reduced
+    // costs of all arcs with nonzero residual capacity are nonnegative. Must only be
+    // called once the flow is optimal.
+    constexpr void
+    update_potentials()
+    {
+        const auto num_nodes = network().num_nodes();
+
+        // Dividing the prices by the scale factor gives potentials whose reduced costs
+        // are at least -1, and whose reduced cost distance from any node to any other
+        // node is at least -1, since the flow is 1-optimal w.r.t. the scaled costs.
+        // Adding the (nonpositive) shortest distance from each node to any other node
+        // w.r.t. these reduced costs makes them nonnegative. The distances are found by
+        // a label-correcting search backwards along each arc.
+        auto potential = Container<cost_type>(num_nodes);
+        for (const auto& node : network().nodes()) {
+            const auto node_id = network().get_node_id(node);
+            potential[node_id] = static_cast<cost_type>(floor_div(price_[node_id]));
+        }
+
+        auto distance = Container<cost_type>(num_nodes, zero<cost_type>());
+        auto queued = Container<unsigned char>(num_nodes, 0);
+        const auto arc_length = [&](const auto& arc, const auto& tail, const auto& head) {
+            return network().arc_cost(arc) - potential[network().get_node_id(tail)] +
+                   potential[network().get_node_id(head)];
+        };
+        const auto relax = [&](const auto& tail, const auto& length) {
+            const auto tail_id = network().get_node_id(tail);
+            if (length < distance[tail_id]) {
+                distance[tail_id] = length;
+                if (queued[tail_id] == 0) {
+                    queued[tail_id] = 1;
+                    active_nodes_.push(tail);
+                }
+            }
+        };
+
+        active_nodes_.clear();
+        for (const auto& tail : network().nodes()) {
+            for (const auto& [arc, head] : network().outgoing_arcs(tail)) {
+                if (!network().is_arc_saturated(arc)) {
+                    relax(tail, arc_length(arc, tail, head));
+                }
+            }
+        }
+
+        while (!active_nodes_.empty()) {
+            const auto head = active_nodes_.front();
+            active_nodes_.pop();
+            const auto head_id = network().get_node_id(head);
+            queued[head_id] = 0;
+
+            // The transpose of each outgoing arc is an incoming arc.
+            for (const auto& [arc, tail] : network().outgoing_arcs(head)) {
+                const auto transpose_arc =
+                        static_cast<arc_type>(network().get_transpose_arc_id(arc));
+                if (!network().is_arc_saturated(transpose_arc)) {
+                    relax(tail, arc_length(transpose_arc, tail, head) +
+                                        distance[head_id]);
+                }
+            }
+        }
+
+        for (const auto& node : network().nodes()) {
+            const auto node_id = network().get_node_id(node);
+            WHIRLWIND_DEBUG_ASSERT(distance[node_id] >= -one<cost_type>());
+            const auto new_potential = potential[node_id] + distance[node_id];
+            network().increase_node_potential(
+                    node, new_potential - network().node_potential(node));
+        }
+    }
+
+private:
+    // Get the total supply of the problem from the current excess and flow of each
+    // node. The supply of a node is its excess plus its net outflow.
+    [[nodiscard]] static constexpr auto
+    get_total_supply(const Network& network) -> flow_type
+    {
+        auto total_supply = zero<flow_type>();
+        for (const auto& node : network.nodes()) {
+            auto supply = network.node_excess(node);
+            for (const auto& [arc, _] : network.outgoing_arcs(node)) {
+                if (network.is_forward_arc(arc)) {
+                    supply += network.arc_flow(arc);
+                } else {
+                    const auto transpose_arc =
+                            static_cast<arc_type>(network.get_transpose_arc_id(arc));
+                    supply -= network.arc_flow(transpose_arc);
+                }
+            }
+            total_supply += std::max(supply, zero<flow_type>());
+        }
+        return total_supply;
+    }
+
+    [[nodiscard]] constexpr auto
+    network() const noexcept -> Network&
+    {
+        WHIRLWIND_DEBUG_ASSERT(network_ != nullptr);
+        return *network_;
+    }
+
+    // Floor division of a price by the scale factor.
+    [[nodiscard]] constexpr auto
+    floor_div(price_type price) const noexcept -> price_type
+    {
+        const auto quotient = price / scale_;
+        return ((price % scale_) < 0) ? quotient - 1 : quotient;
+    }
+
+    [[nodiscard]] constexpr auto
+    price(const node_type& node) const -> price_type
+    {
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(price_));
+        return price_[node_id];
+    }
+
+    [[nodiscard]] constexpr auto
+    reduced_cost(const arc_type& arc, const node_type& tail, const node_type& head) const
+            -> price_type
+    {
+        const auto cost = static_cast<price_type>(network().arc_cost(arc));
+        return scale_ * cost - price(tail) + price(head);
+    }
+
+    // The residual capacity of an arc, with uncapacitated arcs limited to the total
+    // supply. A (warm-started) arc whose flow already exceeds the total supply has no
+    // residual capacity until its flow is reduced.
+    [[nodiscard]] constexpr auto
+    residual_capacity(const arc_type& arc) const -> flow_type
+    {
+        const auto capacity = network().arc_residual_capacity(arc);
+        if (!network().is_forward_arc(arc)) {
+            return capacity;
+        }
+        const auto flow = network().arc_flow(arc);
+        const auto headroom = (flow < max_flow_) ? max_flow_ - flow : zero<flow_type>();
+        return std::min(capacity, headroom);
+    }
+
+    // Move `delta` units of flow from `tail` to `head` along `arc`. Returns true if the
+    // head node became active.
+    constexpr auto
+    push(const arc_type& arc,
+         const node_type& tail,
+         const node_type& head,
+         const flow_type& delta) -> bool
+    {
+        WHIRLWIND_DEBUG_ASSERT(delta > zero<flow_type>());
+        const auto was_active = network().is_excess_node(head);
+        network().increase_arc_flow(arc, delta);
+        network().decrease_node_excess(tail, delta);
+        network().increase_node_excess(head, delta);
+        return !was_active && network().is_excess_node(head);
+    }
+
+    // Push flow from an active node along admissible arcs (arcs with nonzero residual
+    // capacity and negative reduced cost) until its excess is zero, relabeling it
+    // whenever it has no admissible arcs.
+    constexpr void
+    discharge(const node_type& node, price_type epsilon)
+    {
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(current_arc_));
+
+        while (network().is_excess_node(node)) {
+            // Resume the scan of the node's outgoing arcs from its current arc.
+            size_type pos = 0;
+            const auto start = current_arc_[node_id];
+            for (const auto& [arc, head] : network().outgoing_arcs(node)) {
+                ++pos;
+                if (pos <= start) {
+                    continue;
+                }
+
+                const auto capacity = residual_capacity(arc);
+                if ((capacity == zero<flow_type>()) ||
+                    (reduced_cost(arc, node, head) >= 0)) {
+                    continue;
+                }
+
+                const auto delta = std::min(network().node_excess(node), capacity);
+                if (push(arc, node, head, delta)) {
+                    active_nodes_.push(head);
+                }
+                if (!network().is_excess_node(node)) {
+                    // The arc may still be admissible, so resume from it next time.
+                    current_arc_[node_id] = pos - 1;
+                    return;
+                }
+            }
+
+            relabel(node, epsilon);
+            current_arc_[node_id] = 0;
+        }
+    }
+
+    // Increase the price of a node with no admissible arcs by the max amount such that
+    // the flow remains epsilon-optimal.
+    constexpr void
+    relabel(const node_type& node, price_type epsilon)
+    {
+        auto min_price = std::numeric_limits<price_type>::max();
+        for (const auto& [arc, head] : network().outgoing_arcs(node)) {
+            if (residual_capacity(arc) == zero<flow_type>()) {
+                continue;
+            }
+            const auto cost = static_cast<price_type>(network().arc_cost(arc));
+            min_price = std::min(min_price, scale_ * cost + price(head));
+        }
+
+        // A node with excess and no outgoing residual arcs means that the problem is
+        // infeasible.
+        WHIRLWIND_ASSERT(min_price != std::numeric_limits<price_type>::max());
+
+        const auto node_id = network().get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(min_price + epsilon > price_[node_id]);
+        price_[node_id] = min_price + epsilon;
+    }
+
+    Network* network_;
+    price_type scale_;
+    flow_type max_flow_;
+    Container<price_type> price_;
+    Container<size_type> current_arc_;
+    RingQueue<node_type, Container> active_nodes_ = {};
+};
+
+} // namespace detail
+
+/**
+ * Solve a minimum cost flow problem using the cost scaling push-relabel algorithm.
+ *
+ * Starting from the network's current flow and node potentials, the algorithm
+ * alternates between reducing a tolerance epsilon by `scale_factor` and transforming
+ * the flow into an epsilon-optimal flow by pushing excess along arcs of negative
+ * reduced cost and relabeling nodes, until the flow is optimal. Unlike the successive
+ * shortest paths and primal-dual algorithms, the runtime is polynomial in the number
+ * of nodes and arcs and logarithmic in the max arc cost, independent of the total
+ * excess.
+ *
+ * On return, the network's node potentials satisfy the reduced cost optimality
+ * conditions (every arc with nonzero residual capacity has nonnegative reduced cost),
+ * as they do after `successive_shortest_paths()`.
+ *
+ * @tparam Logger
+ *     The logger type.
+ *
+ * @param[in,out] network
+ *     The network. Its arc costs must be integers.
+ * @param[in] scale_factor
+ *     The factor by which epsilon is reduced in each iteration. Must be at least 2.
+ */
+template<class Logger = NullLogger, class Network>
+constexpr void
+cost_scaling(Network& network, std::size_t scale_factor = 8)
+{
+    using Solver = detail::CostScaling<Network>;
+    using Price = typename Solver::price_type;
+
+    auto logger = Logger("whirlwind.network.cost_scaling");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+    WHIRLWIND_ASSERT(scale_factor >= 2);
+
+    auto solver = Solver(network);
+    const auto alpha = static_cast<Price>(scale_factor);
+
+    auto epsilon = solver.max_reduced_cost();
+    std::size_t iter = 1;
+    do {
+        epsilon = std::max(epsilon / alpha, Price{1});
+        logger.info("Iteration {}: epsilon = {}", iter, epsilon);
+        solver.refine(epsilon);
+        ++iter;
+    } while (epsilon > Price{1});
+
+    solver.update_potentials();
+}
+
+WHIRLWIND_NAMESPACE_END
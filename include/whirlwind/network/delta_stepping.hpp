@@ -0,0 +1,602 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/algorithm/fill.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra_visitor.hpp>
+#include <whirlwind/graph/forest_concepts.hpp>
+#include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/graph/shortest_path_forest.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A parallel delta-stepping search for multi-source shortest paths with integer
+ * lengths, for use in place of `PrimalDualDijkstra` during each primal-dual iteration.
+ *
+ * The search runs in two stages. First, tentative distances are computed by
+ * delta-stepping: reached vertices are grouped into buckets of width `delta()` by
+ * distance, and the outgoing arcs of all vertices in the lowest non-empty bucket are
+ * relaxed in parallel (using atomic updates) until the bucket stays empty. Second, the
+ * shortest path forest is built by a level-synchronous breadth-first search from the
+ * sources along tight arcs (arcs whose reduced cost equals the difference in distance
+ * between their endpoints), claiming each vertex for the tight arc from the earliest
+ * vertex in the previous level.
+ *
+ * The resulting distances are the same as those found by `PrimalDualDijkstra`, and
+ * each vertex's predecessor and source vertex are those of a shortest path from the
+ * nearest source, so the solver may be used interchangeably with it by
+ * `augment_flow_pd()`, `augment_flow_forest_pd()`, and `update_potential_pd()`. If
+ * there are multiple shortest paths to a vertex, the predecessor may differ from the
+ * one chosen by `PrimalDualDijkstra`, but doesn't depend on the number of threads.
+ * Vertices are visited in breadth-first order (rather than in order of distance), which
+ * is still a topological order of the forest.
+ *
+ * The parallel steps are processed by a `ThreadPool` owned by the solver, which is
+ * started by the first step that is large enough to be split across multiple threads,
+ * and is then reused by every subsequent step and search.
+ *
+ * Only the search in `dijkstra_pd()` is supported -- the solver doesn't provide the
+ * incremental interface of the Dijkstra solvers (e.g. `pop_next_unvisited_vertex()`).
+ *
+ * @tparam Distance
+ *     The distance type. Must be an integer type.
+ * @tparam Graph
+ *     The graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the internal arrays.
+ * @tparam ShortestPaths
+ *     The shortest path forest type.
+ */
+template<class Distance,
+         GraphType Graph,
+         template<class> class Container = Vector,
+         MutableShortestPathForestType ShortestPaths =
+                 ShortestPathForest<Distance, Graph, Container>>
+class DeltaStepping : public ShortestPaths {
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Distance>);
+
+private:
+    using base_type = ShortestPaths;
+
+public:
+    using distance_type = Distance;
+    using graph_type = Graph;
+    using vertex_type = typename graph_type::vertex_type;
+    using edge_type = typename graph_type::edge_type;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using base_type::distance_to_vertex;
+    using base_type::graph;
+    using base_type::has_visited_vertex;
+    using base_type::label_vertex_visited;
+    using base_type::make_root_vertex;
+    using base_type::predecessor_vertex;
+    using base_type::set_distance_to_vertex;
+    using base_type::set_predecessor;
+    using base_type::visited_vertices;
+
+    /**
+     * The min number of vertices per thread in each parallel step. Smaller steps are
+     * processed using fewer threads, since the cost of waking the worker threads
+     * would exceed the work performed.
+     */
+    static constexpr size_type min_chunk_size = 1024;
+
+    /**
+     * Create a new `DeltaStepping` solver.
+     *
+     * @param[in] g
+     *     The underlying graph.
+     * @param[in] delta
+     *     The width of each bucket, in units of distance. Must be at least 1.
+     * @param[in] num_threads
+     *     The max number of threads to use, including the calling thread. Must be at
+     *     least 1.
+     */
+    constexpr DeltaStepping(const graph_type& g,
+                            distance_type delta,
+                            size_type num_threads = default_num_threads())
+        : base_type(g),
+          delta_(std::move(delta)),
+          num_threads_(num_threads),
+          tentative_distance_(g.num_vertices(), infinity<distance_type>()),
+          source_(g.num_vertices()),
+          stamp_(g.num_vertices(), size_type{0}),
+          buckets_(2)
+    {
+        WHIRLWIND_ASSERT(delta_ >= one<distance_type>());
+        WHIRLWIND_ASSERT(num_threads_ >= 1);
+    }
+
+    /**
+     * Create a new `DeltaStepping` solver for a network's residual graph.
+     *
+     * The bucket width is the max reduced cost among the network's admissible arcs
+     * divided by the average out-degree of its residual graph (or 1, if that is
+     * smaller). Reduced costs may change between searches, but the bucket width is
+     * retained.
+     *
+     * @param[in] network
+     *     The network.
+     * @param[in] num_threads
+     *     The max number of threads to use, including the calling thread. Must be at
+     *     least 1.
+     */
+    template<class Network>
+    explicit constexpr DeltaStepping(const Network& network,
+                                     size_type num_threads = default_num_threads())
+        : DeltaStepping(network.residual_graph(), get_default_delta(network),
+                        num_threads)
+    {
+        WHIRLWIND_STATIC_ASSERT(
+                std::is_same_v<typename Network::cost_type, distance_type>);
+    }
+
+    /** The width of each bucket, in units of distance. */
+    [[nodiscard]] constexpr auto
+    delta() const noexcept -> const distance_type&
+    {
+        return delta_;
+    }
+
+    /** The max number of threads to use, including the calling thread. */
+    [[nodiscard]] constexpr auto
+    num_threads() const noexcept -> size_type
+    {
+        return num_threads_;
+    }
+
+    /** Get the source vertex of the tree containing a visited vertex. */
+    [[nodiscard]] constexpr auto
+    source_vertex(const vertex_type& vertex) const -> const vertex_type&
+    {
+        WHIRLWIND_ASSERT(graph().contains_vertex(vertex));
+        const auto vertex_id = graph().get_vertex_id(vertex);
+        WHIRLWIND_DEBUG_ASSERT(vertex_id < std::size(source_));
+        return source_[vertex_id];
+    }
+
+    /**
+     * Find the shortest path w.r.t. the reduced arc costs to each node in a network
+     * from any of the specified source nodes.
+     *
+     * Unsaturated arcs are traversed, with lengths equal to their reduced costs, which
+     * must be nonnegative. The solver must have been reset since the last search.
+     *
+     * @param[in] network
+     *     The network. Its residual graph must be the solver's underlying graph.
+     * @param[in] sources
+     *     The source nodes.
+     */
+    template<class Network, class SourceRange>
+    void
+    search(const Network& network, const SourceRange& sources)
+    {
+        WHIRLWIND_ASSERT(std::addressof(graph()) ==
+                         std::addressof(network.residual_graph()));
+        WHIRLWIND_ASSERT(std::empty(visited_vertices()));
+
+        compute_distances(network, sources);
+        build_forest(network, sources);
+    }
+
+    constexpr void
+    reset()
+    {
+        base_type::reset();
+    }
+
+    /**
+     * Reset the solver and replace its underlying graph, reusing its internal arrays.
+     *
+     * @param[in] g
+     *     The new underlying graph. Must have no more vertices than the graph that the
+     *     solver was created with.
+     */
+    constexpr void
+    rebind(const graph_type& g)
+    {
+        base_type::rebind(g);
+    }
+
+private:
+    // A tree arc found by the breadth-first search, to be added to the forest.
+    struct TreeArc {
+        vertex_type tail;
+        edge_type arc;
+        vertex_type head;
+    };
+
+    template<class Network>
+    [[nodiscard]] static constexpr auto
+    get_default_delta(const Network& network) -> distance_type
+    {
+        const auto max_arc_length = get_max_admissible_arc_length(network);
+        const auto num_nodes = std::max(network.num_nodes(), size_type{1});
+        const auto degree = std::max(network.num_arcs() / num_nodes, size_type{1});
+        return std::max(max_arc_length / static_cast<distance_type>(degree),
+                        one<distance_type>());
+    }
+
+    [[nodiscard]] constexpr auto
+    get_bucket_id(const distance_type& distance) const -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<distance_type>());
+        return static_cast<size_type>(distance / delta_);
+    }
+
+    [[nodiscard]] constexpr auto
+    get_bucket(size_type bucket_id) -> container_type<vertex_type>&
+    {
+        return buckets_[bucket_id % std::size(buckets_)];
+    }
+
+    // Get the number of chunks to split a parallel step over `n` items into.
+    [[nodiscard]] constexpr auto
+    get_num_chunks(size_type n) const noexcept -> size_type
+    {
+        return std::clamp(n / min_chunk_size, size_type{1}, num_threads_);
+    }
+
+    // Invoke `func(first, last)` for each of a range of chunk indices [0, `num_chunks`)
+    // split across the thread pool. The pool is started on first use.
+    template<class Func>
+    void
+    for_each_chunk(size_type num_chunks, const Func& func)
+    {
+        WHIRLWIND_DEBUG_ASSERT(num_chunks <= num_threads_);
+        if (num_chunks == 1) {
+            func(size_type{0}, size_type{1});
+            return;
+        }
+        if (!thread_pool_) {
+            thread_pool_ = std::make_unique<ThreadPool>(num_threads_);
+        }
+        thread_pool_->parallel_for_chunks(0, num_chunks, func);
+    }
+
+    // Get the first index of a chunk of a range of `n` items split into `num_chunks`
+    // chunks of approximately equal size.
+    [[nodiscard]] static constexpr auto
+    get_chunk_first(size_type n, size_type num_chunks, size_type chunk) noexcept
+            -> size_type
+    {
+        return chunk * (n / num_chunks) + std::min(chunk, n % num_chunks);
+    }
+
+    // Add a vertex to the bucket of its tentative distance, which must not precede the
+    // current bucket. The ring buffer of buckets is enlarged if needed.
+    constexpr void
+    push_vertex(const vertex_type& vertex)
+    {
+        const auto vertex_id = graph().get_vertex_id(vertex);
+        const auto bucket_id = get_bucket_id(tentative_distance_[vertex_id]);
+        WHIRLWIND_DEBUG_ASSERT(bucket_id >= current_bucket_id_);
+
+        if (bucket_id - current_bucket_id_ >= std::size(buckets_)) WHIRLWIND_UNLIKELY {
+            resize_buckets(std::max(2 * std::size(buckets_),
+                                    bucket_id - current_bucket_id_ + 1));
+        }
+        get_bucket(bucket_id).push_back(vertex);
+    }
+
+    // Replace the ring buffer with a new array of `num_buckets` buckets and move each
+    // vertex from the old buckets to the bucket of its tentative distance. Vertices
+    // whose distance precedes the current bucket have already been settled and are
+    // dropped.
+    constexpr void
+    resize_buckets(size_type num_buckets)
+    {
+        auto buckets = container_type<container_type<vertex_type>>(num_buckets);
+        for (auto& bucket : buckets_) {
+            for (const auto& vertex : bucket) {
+                const auto vertex_id = graph().get_vertex_id(vertex);
+                const auto bucket_id = get_bucket_id(tentative_distance_[vertex_id]);
+                if (bucket_id >= current_bucket_id_) {
+                    buckets[bucket_id % num_buckets].push_back(vertex);
+                }
+            }
+        }
+        buckets_ = std::move(buckets);
+    }
+
+    // Find the first non-empty bucket at or after the current bucket. Returns
+    // `std::nullopt` if all buckets are empty.
+    [[nodiscard]] constexpr auto
+    find_next_bucket() -> std::optional<size_type>
+    {
+        for (size_type i = 0; i < std::size(buckets_); ++i) {
+            if (!std::empty(get_bucket(current_bucket_id_ + i))) {
+                return current_bucket_id_ + i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Atomically lower the tentative distance to a vertex. Returns true if the
+    // distance was lowered.
+    [[nodiscard]] auto
+    lower_tentative_distance(size_type vertex_id, distance_type distance) -> bool
+    {
+        auto ref = std::atomic_ref<distance_type>(tentative_distance_[vertex_id]);
+        auto old_distance = ref.load(std::memory_order_relaxed);
+        while (distance < old_distance) {
+            if (ref.compare_exchange_weak(old_distance, distance,
+                                          std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Compute the tentative distance to each vertex by delta-stepping.
+    template<class Network, class SourceRange>
+    void
+    compute_distances(const Network& network, const SourceRange& sources)
+    {
+        ranges::fill(tentative_distance_, infinity<distance_type>());
+        for (auto& bucket : buckets_) {
+            bucket.clear();
+        }
+        current_bucket_id_ = 0;
+
+        for (const auto& source : sources) {
+            WHIRLWIND_ASSERT(graph().contains_vertex(source));
+            tentative_distance_[graph().get_vertex_id(source)] = zero<distance_type>();
+            push_vertex(source);
+        }
+
+        while (const auto bucket_id = find_next_bucket()) {
+            current_bucket_id_ = *bucket_id;
+
+            // Relax the outgoing arcs of each vertex in the current bucket until no
+            // vertices remain in it. Relaxations may add vertices back to the current
+            // bucket.
+            while (!std::empty(get_bucket(current_bucket_id_))) {
+                frontier_.clear();
+                std::swap(frontier_, get_bucket(current_bucket_id_));
+
+                // Drop duplicate vertices and vertices whose distance has since been
+                // lowered to a preceding (settled) bucket.
+                ++round_;
+                std::erase_if(frontier_, [&](const auto& vertex) {
+                    const auto vertex_id = graph().get_vertex_id(vertex);
+                    const auto distance = tentative_distance_[vertex_id];
+                    if ((get_bucket_id(distance) != current_bucket_id_) ||
+                        (stamp_[vertex_id] == round_)) {
+                        return true;
+                    }
+                    stamp_[vertex_id] = round_;
+                    return false;
+                });
+
+                relax_frontier(network);
+                for (auto& reached : reached_) {
+                    for (const auto& vertex : reached) {
+                        push_vertex(vertex);
+                    }
+                    reached.clear();
+                }
+            }
+        }
+    }
+
+    // Relax the outgoing arcs of each vertex in the frontier in parallel. Each vertex
+    // whose tentative distance was lowered is appended to the list of reached vertices
+    // of the chunk that lowered it.
+    template<class Network>
+    void
+    relax_frontier(const Network& network)
+    {
+        const auto n = std::size(frontier_);
+        const auto num_chunks = get_num_chunks(n);
+        if (std::size(reached_) < num_chunks) {
+            reached_.resize(num_chunks);
+        }
+
+        for_each_chunk(num_chunks, [&](auto first, auto last) {
+            for (auto chunk = first; chunk < last; ++chunk) {
+                auto& reached = reached_[chunk];
+                const auto begin = get_chunk_first(n, num_chunks, chunk);
+                const auto end = get_chunk_first(n, num_chunks, chunk + 1);
+                for (auto i = begin; i < end; ++i) {
+                    const auto& tail = frontier_[i];
+                    const auto tail_id = graph().get_vertex_id(tail);
+                    const auto distance =
+                            std::atomic_ref<distance_type>(tentative_distance_[tail_id])
+                                    .load(std::memory_order_relaxed);
+
+                    for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+                        if (network.is_arc_saturated(arc)) {
+                            continue;
+                        }
+
+                        const auto arc_length =
+                                network.arc_reduced_cost(arc, tail, head);
+                        WHIRLWIND_ASSERT(arc_length >= zero<distance_type>());
+
+                        const auto head_id = graph().get_vertex_id(head);
+                        if (lower_tentative_distance(head_id, distance + arc_length)) {
+                            reached.push_back(head);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // Check whether an arc lies on a shortest path w.r.t. the tentative distances.
+    template<class Network>
+    [[nodiscard]] constexpr auto
+    is_tight_arc(const Network& network,
+                 const edge_type& arc,
+                 const vertex_type& tail,
+                 const vertex_type& head) const -> bool
+    {
+        if (network.is_arc_saturated(arc)) {
+            return false;
+        }
+        const auto tail_distance = tentative_distance_[graph().get_vertex_id(tail)];
+        const auto head_distance = tentative_distance_[graph().get_vertex_id(head)];
+        return head_distance ==
+               tail_distance + network.arc_reduced_cost(arc, tail, head);
+    }
+
+    // Build the shortest path forest by a level-synchronous breadth-first search from
+    // the sources along tight arcs. Each vertex is numbered in order of its visitation,
+    // and is claimed by the tight arc from the lowest-numbered vertex in the previous
+    // level, so the forest doesn't depend on the number of threads.
+    template<class Network, class SourceRange>
+    void
+    build_forest(const Network& network, const SourceRange& sources)
+    {
+        constexpr auto unclaimed = std::numeric_limits<size_type>::max();
+        claim_.assign(graph().num_vertices(), unclaimed);
+
+        frontier_.clear();
+        for (const auto& source : sources) {
+            const auto source_id = graph().get_vertex_id(source);
+            claim_[source_id] = std::size(frontier_);
+            source_[source_id] = source;
+            make_root_vertex(source);
+            set_distance_to_vertex(source, zero<distance_type>());
+            label_vertex_visited(source);
+            frontier_.push_back(source);
+        }
+
+        auto level_first = size_type{0};
+        while (!std::empty(frontier_)) {
+            const auto n = std::size(frontier_);
+            const auto num_chunks = get_num_chunks(n);
+            if (std::size(tree_arcs_) < num_chunks) {
+                tree_arcs_.resize(num_chunks);
+            }
+
+            // Claim each head of a tight arc for the lowest-numbered tail. Vertices in
+            // preceding levels have lower numbers, so they keep their claims.
+            for_each_chunk(num_chunks, [&](auto first, auto last) {
+                const auto begin = get_chunk_first(n, num_chunks, first);
+                const auto end = get_chunk_first(n, num_chunks, last);
+                for (auto i = begin; i < end; ++i) {
+                    const auto& tail = frontier_[i];
+                    const auto number = level_first + i;
+                    for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+                        if (!is_tight_arc(network, arc, tail, head)) {
+                            continue;
+                        }
+                        const auto head_id = graph().get_vertex_id(head);
+                        auto ref = std::atomic_ref<size_type>(claim_[head_id]);
+                        auto old_number = ref.load(std::memory_order_relaxed);
+                        while ((number < old_number) &&
+                               !ref.compare_exchange_weak(old_number, number,
+                                                          std::memory_order_relaxed)) {
+                        }
+                    }
+                }
+            });
+
+            // Collect the arcs to the claimed vertices, in order of their tails.
+            for_each_chunk(num_chunks, [&](auto first, auto last) {
+                for (auto chunk = first; chunk < last; ++chunk) {
+                    auto& tree_arcs = tree_arcs_[chunk];
+                    const auto begin = get_chunk_first(n, num_chunks, chunk);
+                    const auto end = get_chunk_first(n, num_chunks, chunk + 1);
+                    for (auto i = begin; i < end; ++i) {
+                        const auto& tail = frontier_[i];
+                        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+                            const auto head_id = graph().get_vertex_id(head);
+                            if ((claim_[head_id] == level_first + i) &&
+                                is_tight_arc(network, arc, tail, head)) {
+                                tree_arcs.push_back({tail, arc, head});
+                            }
+                        }
+                    }
+                }
+            });
+
+            // Add the arcs to the forest and form the next level. (A vertex may be the
+            // head of multiple parallel arcs from its claiming tail.)
+            level_first += n;
+            frontier_.clear();
+            for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+                for (const auto& [tail, arc, head] : tree_arcs_[chunk]) {
+                    if (has_visited_vertex(head)) {
+                        continue;
+                    }
+                    const auto head_id = graph().get_vertex_id(head);
+                    claim_[head_id] = level_first + std::size(frontier_);
+                    source_[head_id] = source_vertex(tail);
+                    set_predecessor(head, tail, arc);
+                    set_distance_to_vertex(head, tentative_distance_[head_id]);
+                    label_vertex_visited(head);
+                    frontier_.push_back(head);
+                }
+                tree_arcs_[chunk].clear();
+            }
+        }
+    }
+
+    distance_type delta_;
+    size_type num_threads_;
+    container_type<distance_type> tentative_distance_;
+    container_type<vertex_type> source_;
+    container_type<size_type> stamp_;
+    container_type<size_type> claim_ = {};
+    container_type<container_type<vertex_type>> buckets_;
+    container_type<vertex_type> frontier_ = {};
+    container_type<container_type<vertex_type>> reached_ = {};
+    container_type<container_type<TreeArc>> tree_arcs_ = {};
+    size_type current_bucket_id_ = 0;
+    size_type round_ = 0;
+    std::unique_ptr<ThreadPool> thread_pool_ = {};
+};
+
+/**
+ * Find the shortest path w.r.t. the reduced arc costs to each node from any excess node
+ * using the parallel delta-stepping solver. See `DeltaStepping`.
+ *
+ * The search is parallel, so only the sources and the visited nodes are reported to
+ * `visitor`, after the search completes. Each visited node is reported to `on_pop()`
+ * in visitation order.
+ */
+template<class Distance,
+         class Graph,
+         template<class> class Container,
+         class ShortestPaths,
+         class Network,
+         class Visitor = NullDijkstraVisitor>
+void
+dijkstra_pd(DeltaStepping<Distance, Graph, Container, ShortestPaths>& solver,
+            const Network& network,
+            Visitor&& visitor = Visitor())
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+    solver.search(network, network.excess_nodes());
+    for (const auto& source : network.excess_nodes()) {
+        visitor.on_source(source);
+    }
+    for (const auto& node : solver.visited_vertices()) {
+        visitor.on_pop(node, solver.distance_to_vertex(node));
+    }
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include <range/v3/algorithm/sort.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "network.hpp"
+#include "warm_start.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** Options for `multigrid_warm_start()`. */
+struct MultigridOptions {
+    /**
+     * The number of fine grid nodes along each side of the block of nodes that is
+     * merged into a single node of the next coarser grid. Must be at least 2.
+     */
+    std::size_t factor = 4;
+    /** The max number of coarse grids. */
+    std::size_t num_levels = 1;
+    /**
+     * The min number of rows and columns of nodes in a coarse grid. Coarsening stops
+     * before any grid would be smaller.
+     */
+    std::size_t min_size = 8;
+};
+
+namespace detail {
+
+// The four directions of the edges of a grid graph.
+enum class GridDirection : unsigned char { up, left, down, right };
+
+// Get the edge of a grid graph with a single edge between each pair of adjacent
+// vertices that leaves `vertex` in the specified direction.
+template<class Graph>
+[[nodiscard]] constexpr auto
+get_grid_edge(const Graph& graph,
+              const typename Graph::vertex_type& vertex,
+              GridDirection direction) -> typename Graph::edge_type
+{
+    switch (direction) {
+    case GridDirection::up:
+        return graph.get_up_edge(vertex);
+    case GridDirection::left:
+        return graph.get_left_edge(vertex);
+    case GridDirection::down:
+        return graph.get_down_edge(vertex);
+    default:
+        return graph.get_right_edge(vertex);
+    }
+}
+
+// The partition of the nodes along one axis of a fine grid into blocks of `factor`
+// consecutive nodes (the last block may be smaller). Each block is a single node along
+// the same axis of the coarse grid.
+class GridBlocks {
+public:
+    using size_type = std::size_t;
+
+    constexpr GridBlocks(size_type num_fine, size_type factor)
+        : num_fine_(num_fine), factor_(factor)
+    {
+        WHIRLWIND_ASSERT(factor >= 1);
+    }
+
+    [[nodiscard]] constexpr auto
+    num_blocks() const noexcept -> size_type
+    {
+        return (num_fine_ + factor_ - 1) / factor_;
+    }
+
+    [[nodiscard]] constexpr auto
+    begin(size_type block) const noexcept -> size_type
+    {
+        return block * factor_;
+    }
+
+    [[nodiscard]] constexpr auto
+    end(size_type block) const noexcept -> size_type
+    {
+        return std::min((block + 1) * factor_, num_fine_);
+    }
+
+    [[nodiscard]] constexpr auto
+    block(size_type i) const noexcept -> size_type
+    {
+        return i / factor_;
+    }
+
+    // The position of the center of a block along the fine axis.
+    [[nodiscard]] constexpr auto
+    center(size_type block) const noexcept -> double
+    {
+        return 0.5 * static_cast<double>(begin(block) + end(block) - 1);
+    }
+
+    // Find the blocks whose centers bracket position `i` and the interpolation weight
+    // of the second block.
+    [[nodiscard]] constexpr auto
+    interpolate(size_type i) const
+            -> std::pair<std::pair<size_type, size_type>, double>
+    {
+        const auto x = static_cast<double>(i);
+        auto b0 = block(i);
+        if ((x < center(b0)) && (b0 > 0)) {
+            --b0;
+        }
+        const auto b1 = std::min(b0 + 1, num_blocks() - 1);
+        if ((b0 == b1) || (x <= center(b0))) {
+            return {{b0, b0}, 0.0};
+        }
+        if (x >= center(b1)) {
+            return {{b1, b1}, 0.0};
+        }
+        const auto w = (x - center(b0)) / (center(b1) - center(b0));
+        return {{b0, b1}, w};
+    }
+
+private:
+    size_type num_fine_;
+    size_type factor_;
+};
+
+// Invoke `func(fine_vertex)` for the tail of each edge of the fine grid that crosses
+// from block `vertex` of the coarse grid to its neighbor in the specified direction.
+template<class Vertex, class Func>
+constexpr void
+for_each_crossing_edge_tail(const GridBlocks& row_blocks,
+                            const GridBlocks& col_blocks,
+                            const Vertex& vertex,
+                            GridDirection direction,
+                            Func&& func)
+{
+    using Dim = typename Vertex::first_type;
+
+    const auto bi = static_cast<std::size_t>(vertex.first);
+    const auto bj = static_cast<std::size_t>(vertex.second);
+
+    switch (direction) {
+    case GridDirection::up:
+    case GridDirection::down: {
+        const auto i = (direction == GridDirection::up) ? row_blocks.begin(bi)
+                                                        : row_blocks.end(bi) - 1;
+        for (auto j = col_blocks.begin(bj); j < col_blocks.end(bj); ++j) {
+            func(Vertex(static_cast<Dim>(i), static_cast<Dim>(j)));
+        }
+        break;
+    }
+    default: {
+        const auto j = (direction == GridDirection::left) ? col_blocks.begin(bj)
+                                                          : col_blocks.end(bj) - 1;
+        for (auto i = row_blocks.begin(bi); i < row_blocks.end(bi); ++i) {
+            func(Vertex(static_cast<Dim>(i), static_cast<Dim>(j)));
+        }
+        break;
+    }
+    }
+}
+
+// Check whether a vertex of a grid graph has a neighbor in the specified direction.
+template<class Graph>
+[[nodiscard]] constexpr auto
+has_grid_neighbor(const Graph& graph,
+                  const typename Graph::vertex_type& vertex,
+                  GridDirection direction) -> bool
+{
+    switch (direction) {
+    case GridDirection::up:
+        return vertex.first != 0;
+    case GridDirection::left:
+        return vertex.second != 0;
+    case GridDirection::down:
+        return vertex.first + 1 != graph.num_rows();
+    default:
+        return vertex.second + 1 != graph.num_cols();
+    }
+}
+
+inline constexpr GridDirection grid_directions[] = {
+        GridDirection::up,
+        GridDirection::left,
+        GridDirection::down,
+        GridDirection::right,
+};
+
+template<class GridNetwork, class SolveFunc>
+void
+multigrid_warm_start(GridNetwork& network,
+                     const SolveFunc& solve,
+                     const MultigridOptions& options,
+                     std::size_t num_levels)
+{
+    using Graph = typename GridNetwork::graph_type;
+    using Vertex = typename Graph::vertex_type;
+    using Dim = typename Vertex::first_type;
+    using Arc = typename GridNetwork::arc_type;
+    using Cost = typename GridNetwork::cost_type;
+    using Flow = typename GridNetwork::flow_type;
+    using CoarseNetwork =
+            Network<Graph, Cost, Flow, GridNetwork::template container_type>;
+    using CoarseArc = typename CoarseNetwork::arc_type;
+
+    if (num_levels == 0) {
+        return;
+    }
+
+    WHIRLWIND_ASSERT(options.factor >= 2);
+    const auto m = static_cast<std::size_t>(network.residual_graph().num_rows());
+    const auto n = static_cast<std::size_t>(network.residual_graph().num_cols());
+    const auto row_blocks = GridBlocks(m, options.factor);
+    const auto col_blocks = GridBlocks(n, options.factor);
+    const auto mc = row_blocks.num_blocks();
+    const auto nc = col_blocks.num_blocks();
+    if ((mc < std::max(options.min_size, std::size_t{2})) ||
+        (nc < std::max(options.min_size, std::size_t{2}))) {
+        return;
+    }
+
+    const auto graph = Graph(static_cast<Dim>(m), static_cast<Dim>(n));
+    const auto coarse_graph = Graph(static_cast<Dim>(mc), static_cast<Dim>(nc));
+
+    const auto get_forward_arc = [&](const Vertex& tail, GridDirection direction) {
+        const auto edge = get_grid_edge(graph, tail, direction);
+        const auto edge_id = graph.get_edge_id(edge);
+        return static_cast<Arc>(network.get_residual_graph_arc_id(edge_id));
+    };
+
+    // The surplus of each coarse node is the total excess of its block.
+    auto coarse_surplus = Vector<Flow>(coarse_graph.num_vertices(), zero<Flow>());
+    for (const auto& node : network.nodes()) {
+        const auto bi = row_blocks.block(node.first);
+        const auto bj = col_blocks.block(node.second);
+        const auto coarse_node = Vertex(static_cast<Dim>(bi), static_cast<Dim>(bj));
+        coarse_surplus[coarse_graph.get_vertex_id(coarse_node)] +=
+                network.node_excess(node);
+    }
+
+    // The cost of each coarse edge is the mean cost of the finite-cost fine edges
+    // crossing between the two blocks, scaled by the distance between the centers of
+    // the blocks. If every crossing edge has infinite cost, so does the coarse edge.
+    auto coarse_cost = Vector<Cost>(coarse_graph.num_edges(), infinity<Cost>());
+    for (const auto& coarse_tail : coarse_graph.vertices()) {
+        for (const auto& direction : grid_directions) {
+            if (!has_grid_neighbor(coarse_graph, coarse_tail, direction)) {
+                continue;
+            }
+
+            auto sum = 0.0;
+            std::size_t count = 0;
+            for_each_crossing_edge_tail(
+                    row_blocks, col_blocks, coarse_tail, direction,
+                    [&](const Vertex& tail) {
+                        const auto arc = get_forward_arc(tail, direction);
+                        const auto cost = network.arc_cost(arc);
+                        if (cost < infinity<Cost>()) {
+                            sum += static_cast<double>(cost);
+                            ++count;
+                        }
+                    });
+            if (count == 0) {
+                continue;
+            }
+
+            const auto is_vertical = (direction == GridDirection::up) ||
+                                     (direction == GridDirection::down);
+            const auto& blocks = is_vertical ? row_blocks : col_blocks;
+            const auto b0 = static_cast<std::size_t>(is_vertical ? coarse_tail.first
+                                                                 : coarse_tail.second);
+            const auto b1 = ((direction == GridDirection::up) ||
+                             (direction == GridDirection::left))
+                                    ? b0 - 1
+                                    : b0 + 1;
+            const auto distance = std::abs(blocks.center(b1) - blocks.center(b0));
+
+            const auto edge = get_grid_edge(coarse_graph, coarse_tail, direction);
+            coarse_cost[coarse_graph.get_edge_id(edge)] = static_cast<Cost>(
+                    std::round(sum / static_cast<double>(count) * distance));
+        }
+    }
+
+    // Solve the coarse network, itself warm-started from a coarser grid. Coarse edges
+    // are uncapacitated, since each represents several fine edges.
+    auto coarse = CoarseNetwork(coarse_graph, std::move(coarse_surplus), coarse_cost);
+    coarse_cost = {};
+    multigrid_warm_start(coarse, solve, options, num_levels - 1);
+    solve(coarse);
+
+    // Prolong the coarse flows. The flow in each coarse edge is spread over the
+    // cheapest finite-cost fine edges crossing between the two blocks, subject to their
+    // capacities. Any flow that doesn't fit is left for the fine network's solver.
+    auto edge_flow = Vector<Flow>(network.num_forward_arcs(), zero<Flow>());
+    auto crossing = Vector<std::pair<Cost, Arc>>();
+    for (const auto& coarse_tail : coarse_graph.vertices()) {
+        for (const auto& direction : grid_directions) {
+            if (!has_grid_neighbor(coarse_graph, coarse_tail, direction)) {
+                continue;
+            }
+
+            const auto coarse_edge =
+                    get_grid_edge(coarse_graph, coarse_tail, direction);
+            const auto coarse_edge_id = coarse_graph.get_edge_id(coarse_edge);
+            const auto coarse_arc = static_cast<CoarseArc>(
+                    coarse.get_residual_graph_arc_id(coarse_edge_id));
+            auto flow = coarse.arc_flow(coarse_arc);
+            if (flow <= zero<Flow>()) {
+                continue;
+            }
+
+            crossing.clear();
+            for_each_crossing_edge_tail(
+                    row_blocks, col_blocks, coarse_tail, direction,
+                    [&](const Vertex& tail) {
+                        const auto arc = get_forward_arc(tail, direction);
+                        const auto cost = network.arc_cost(arc);
+                        if (cost < infinity<Cost>()) {
+                            crossing.emplace_back(cost, arc);
+                        }
+                    });
+            ranges::sort(crossing, [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+            });
+
+            for (const auto& [cost, arc] : crossing) {
+                if (flow <= zero<Flow>()) {
+                    break;
+                }
+                const auto delta = std::min(flow, network.arc_capacity(arc));
+                edge_flow[network.get_edge_id(arc)] += delta;
+                flow -= delta;
+            }
+        }
+    }
+
+    // Prolong the coarse potentials by bilinear interpolation between the centers of
+    // the blocks.
+    auto node_potential = Vector<Cost>(network.num_nodes(), zero<Cost>());
+    for (const auto& node : network.nodes()) {
+        const auto [rows, wi] = row_blocks.interpolate(node.first);
+        const auto [cols, wj] = col_blocks.interpolate(node.second);
+        const auto coarse_potential = [&](std::size_t bi, std::size_t bj) {
+            const auto coarse_node = Vertex(static_cast<Dim>(bi), static_cast<Dim>(bj));
+            return static_cast<double>(coarse.node_potential(coarse_node));
+        };
+        const auto p00 = coarse_potential(rows.first, cols.first);
+        const auto p01 = coarse_potential(rows.first, cols.second);
+        const auto p10 = coarse_potential(rows.second, cols.first);
+        const auto p11 = coarse_potential(rows.second, cols.second);
+        const auto p = (1.0 - wi) * ((1.0 - wj) * p00 + wj * p01) +
+                       wi * ((1.0 - wj) * p10 + wj * p11);
+        node_potential[network.get_node_id(node)] = static_cast<Cost>(std::round(p));
+    }
+
+    warm_start(network, edge_flow, node_potential);
+}
+
+} // namespace detail
+
+/**
+ * Seed a grid network with a solution to a coarser version of the same problem.
+ *
+ * Large phase unwrapping problems typically require many primal-dual iterations, each
+ * of which visits every node in the network, mostly in order to route flow over long
+ * distances between residues. This function first solves a coarse network in which
+ * each block of `options.factor` x `options.factor` nodes is merged into a single node
+ * whose surplus is the total surplus of the block. The cost of each coarse edge is the
+ * mean cost of the fine edges crossing between the two blocks, scaled by the distance
+ * between their centers. The coarse solution is then prolonged to the fine network:
+ * the flow in each coarse edge is assigned to the cheapest fine edges crossing between
+ * the two blocks, the node potentials are interpolated bilinearly between the centers
+ * of the blocks, and the network is seeded with the resulting flows and potentials
+ * using `warm_start()`.
+ *
+ * The remaining excess is typically confined to within a few blocks of its
+ * destination, so the subsequent solve (e.g. `primal_dual()`) needs far fewer
+ * iterations over the full network. The final solution is optimal for the fine
+ * network regardless of the quality of the coarse solution.
+ *
+ * If `options.num_levels` is greater than 1, the coarse network is itself warm-started
+ * from a coarser grid, and so on. Coarsening stops early once a coarse grid would have
+ * fewer than `options.min_size` rows or columns of nodes.
+ *
+ * @param[in,out] network
+ *     A network over a `RectangularGridGraph` with one edge between each pair of
+ *     adjacent nodes. Must not carry any flow (e.g. a newly-constructed network).
+ * @param[in] solve
+ *     A callable object that solves each coarse network in-place. Coarse networks are
+ *     uncapacitated networks over a `RectangularGridGraph` with the same cost, flow,
+ *     and container types as `network`, e.g.
+ *     `[](auto& coarse) { primal_dual<Dijkstra>(coarse); }`.
+ * @param[in] options
+ *     The coarsening factor and number of levels.
+ */
+template<class Dim,
+         class Cost,
+         class Flow,
+         template<class>
+         class Container,
+         class Mixin,
+         class SolveFunc>
+void
+multigrid_warm_start(
+        Network<RectangularGridGraph<1, Dim>, Cost, Flow, Container, Mixin>& network,
+        const SolveFunc& solve,
+        const MultigridOptions& options = {})
+{
+    detail::multigrid_warm_start(network, solve, options, options.num_levels);
+}
+
+WHIRLWIND_NAMESPACE_END
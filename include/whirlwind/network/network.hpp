@@ -6,21 +6,41 @@
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/algorithm/fold_left.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/filter.hpp>
-#include <range/v3/view/transform.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/memory_usage.hpp>
+#include <whirlwind/container/sparse_set.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/math/numbers.hpp>
 
+#include "residual_graph.hpp"
+#include "shared_residual_graph.hpp"
 #include "uncapacitated.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+namespace detail {
+
+// A network mixin that stores arc costs on behalf of `Network` (e.g.
+// `PackedUnitCapacityMixin`).
+template<class Mixin>
+concept ArcCostMixin = Mixin::stores_arc_costs;
+
+// Checks whether a graph is a `RectangularGridGraph` with a single edge between each
+// pair of adjacent vertices.
+template<class Graph>
+inline constexpr bool is_simple_grid_graph = false;
+
+template<class Dim>
+inline constexpr bool is_simple_grid_graph<RectangularGridGraph<1, Dim>> = true;
+
+} // namespace detail
+
 template<GraphType Graph,
          class Cost,
          class Flow,
@@ -44,6 +64,14 @@ public:
     template<class T>
     using container_type = Container<T>;
 
+    // The type of the sets of excess and deficit nodes. Node IDs are stored using the
+    // node type itself if it is an integer type, to reduce memory usage.
+    using node_set_type =
+            SparseSet<node_type,
+                      Container,
+                      std::conditional_t<std::is_unsigned_v<node_type>, node_type,
+                                         size_type>>;
+
     using super_type::arc_flow;
     using super_type::arcs;
     using super_type::contains_arc;
@@ -58,31 +86,178 @@ public:
     using super_type::num_nodes;
 
     template<class RandomAccessRange>
-    constexpr Network(const graph_type& graph,
-                      container_type<flow_type> surplus,
-                      const RandomAccessRange& cost)
+    Network(const graph_type& graph,
+            container_type<flow_type> surplus,
+            const RandomAccessRange& cost,
+            size_type num_threads = 1)
         : super_type(graph),
           node_excess_(std::move(surplus)),
           node_potential_(num_nodes(), zero<cost_type>()),
-          arc_cost_(make_residual_arc_costs(cost))
+          arc_cost_(init_arc_costs(make_residual_arc_costs(cost, num_threads)))
     {
         WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
-        WHIRLWIND_DEBUG_ASSERT(std::size(arc_cost_) == num_arcs());
+        WHIRLWIND_DEBUG_ASSERT(detail::ArcCostMixin<super_type> ||
+                               (std::size(arc_cost_) == num_arcs()));
         WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        init_active_nodes();
     }
 
+    /**
+     * Create a new network.
+     *
+     * The arc costs are computed from the edge costs in a single pass over the edges,
+     * which may be distributed across multiple threads. The resulting network does not
+     * depend on the number of threads.
+     *
+     * @param[in] graph
+     *     The network's original graph.
+     * @param[in] surplus
+     *     The supply (or demand, if negative) of each node.
+     * @param[in] cost
+     *     The unit cost of each edge in the original graph, indexed by edge.
+     * @param[in] num_threads
+     *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+     */
     template<class InputRange, class RandomAccessRange>
-    constexpr Network(const graph_type& graph,
-                      const InputRange& surplus,
-                      const RandomAccessRange& cost)
+    Network(const graph_type& graph,
+            const InputRange& surplus,
+            const RandomAccessRange& cost,
+            size_type num_threads = 1)
+        : super_type(graph),
+          node_excess_(ranges::to<container_type<flow_type>>(surplus)),
+          node_potential_(num_nodes(), zero<cost_type>()),
+          arc_cost_(init_arc_costs(make_residual_arc_costs(cost, num_threads)))
+    {
+        WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
+        WHIRLWIND_DEBUG_ASSERT(detail::ArcCostMixin<super_type> ||
+                               (std::size(arc_cost_) == num_arcs()));
+        WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        init_active_nodes();
+    }
+
+    /**
+     * Create a new network from a precomputed residual graph layout.
+     *
+     * This avoids recomputing the residual graph of the original graph, e.g. when the
+     * layout was loaded from a file using `map_residual_graph()`. The network's node
+     * excesses, potentials, and arc costs are always stored in `Container`, regardless
+     * of the container type of the layout.
+     *
+     * @param[in] layout
+     *     The residual graph and its associated arc index arrays.
+     * @param[in] surplus
+     *     The supply (or demand, if negative) of each node.
+     * @param[in] cost
+     *     The unit cost of each edge in the original graph, indexed by edge.
+     * @param[in] num_threads
+     *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+     */
+    template<class ResidualGraph,
+             template<class> class LayoutContainer,
+             class InputRange,
+             class RandomAccessRange>
+    Network(ResidualGraphLayout<ResidualGraph, LayoutContainer> layout,
+            const InputRange& surplus,
+            const RandomAccessRange& cost,
+            size_type num_threads = 1)
+        : super_type(std::move(layout)),
+          node_excess_(ranges::to<container_type<flow_type>>(surplus)),
+          node_potential_(num_nodes(), zero<cost_type>()),
+          arc_cost_(init_arc_costs(make_residual_arc_costs(cost, num_threads)))
+    {
+        WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
+        WHIRLWIND_DEBUG_ASSERT(detail::ArcCostMixin<super_type> ||
+                               (std::size(arc_cost_) == num_arcs()));
+        WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        init_active_nodes();
+    }
+
+    /**
+     * Create a new network that refers to a shared residual graph.
+     *
+     * The network's mixin must be based on `SharedResidualGraphMixin`. Only the
+     * network's node excesses, potentials, arc flows, and arc costs are stored in the
+     * network itself.
+     *
+     * @param[in] shared_residual_graph
+     *     The shared residual graph.
+     * @param[in] surplus
+     *     The supply (or demand, if negative) of each node.
+     * @param[in] cost
+     *     The unit cost of each edge in the original graph, indexed by edge.
+     * @param[in] num_threads
+     *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+     */
+    template<class ResidualGraphMixin, class InputRange, class RandomAccessRange>
+    Network(SharedResidualGraph<ResidualGraphMixin> shared_residual_graph,
+            const InputRange& surplus,
+            const RandomAccessRange& cost,
+            size_type num_threads = 1)
+        : super_type(std::move(shared_residual_graph)),
+          node_excess_(ranges::to<container_type<flow_type>>(surplus)),
+          node_potential_(num_nodes(), zero<cost_type>()),
+          arc_cost_(init_arc_costs(make_residual_arc_costs(cost, num_threads)))
+    {
+        WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
+        WHIRLWIND_DEBUG_ASSERT(detail::ArcCostMixin<super_type> ||
+                               (std::size(arc_cost_) == num_arcs()));
+        WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        init_active_nodes();
+    }
+
+    /**
+     * Create a new network on a rectangular grid graph from planar cost rasters.
+     *
+     * The unit cost of each edge is given by one of four 2-D arrays (one per edge
+     * direction), laid out like the image raster of the grid. The costs are copied into
+     * the network with a single pass over each array, rather than one lookup per arc.
+     * The arrays may have any memory layout (e.g. `Span2D` views of external buffers).
+     *
+     * For an M x N grid, `up_cost` and `down_cost` must be (M-1) x N arrays, where
+     * element (i,j) is the cost of the edge from vertex (i+1,j) to (i,j) or from vertex
+     * (i,j) to (i+1,j), respectively. `left_cost` and `right_cost` must be M x (N-1)
+     * arrays, where element (i,j) is the cost of the edge from vertex (i,j+1) to (i,j)
+     * or from vertex (i,j) to (i,j+1), respectively.
+     *
+     * @param[in] graph
+     *     The grid graph.
+     * @param[in] surplus
+     *     The supply (or demand, if negative) of each node.
+     * @param[in] up_cost
+     *     The unit cost of each upward edge.
+     * @param[in] down_cost
+     *     The unit cost of each downward edge.
+     * @param[in] left_cost
+     *     The unit cost of each leftward edge.
+     * @param[in] right_cost
+     *     The unit cost of each rightward edge.
+     * @param[in] num_threads
+     *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+     */
+    template<class InputRange,
+             class UpCost,
+             class DownCost,
+             class LeftCost,
+             class RightCost>
+        requires detail::is_simple_grid_graph<graph_type>
+    Network(const graph_type& graph,
+            const InputRange& surplus,
+            const UpCost& up_cost,
+            const DownCost& down_cost,
+            const LeftCost& left_cost,
+            const RightCost& right_cost,
+            size_type num_threads = 1)
         : super_type(graph),
           node_excess_(ranges::to<container_type<flow_type>>(surplus)),
           node_potential_(num_nodes(), zero<cost_type>()),
-          arc_cost_(make_residual_arc_costs(cost))
+          arc_cost_(init_arc_costs(make_grid_arc_costs(
+                  graph, up_cost, down_cost, left_cost, right_cost, num_threads)))
     {
         WHIRLWIND_ASSERT(std::size(node_excess_) == num_nodes());
-        WHIRLWIND_DEBUG_ASSERT(std::size(arc_cost_) == num_arcs());
+        WHIRLWIND_DEBUG_ASSERT(detail::ArcCostMixin<super_type> ||
+                               (std::size(arc_cost_) == num_arcs()));
         WHIRLWIND_DEBUG_ASSERT(std::size(node_potential_) == num_nodes());
+        init_active_nodes();
     }
 
     [[nodiscard]] constexpr auto
@@ -100,7 +275,9 @@ public:
         WHIRLWIND_ASSERT(contains_node(node));
         const auto node_id = get_node_id(node);
         WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_excess_));
+        const auto old_excess = node_excess_[node_id];
         node_excess_[node_id] += delta;
+        update_active_nodes(node, old_excess, node_excess_[node_id]);
     }
 
     constexpr void
@@ -109,7 +286,9 @@ public:
         WHIRLWIND_ASSERT(contains_node(node));
         const auto node_id = get_node_id(node);
         WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_excess_));
+        const auto old_excess = node_excess_[node_id];
         node_excess_[node_id] -= delta;
+        update_active_nodes(node, old_excess, node_excess_[node_id]);
     }
 
     [[nodiscard]] constexpr auto
@@ -126,18 +305,33 @@ public:
         return node_excess(node) < zero<flow_type>();
     }
 
+    /**
+     * Get the set of excess nodes in the network.
+     *
+     * The set is maintained incrementally as node excesses are updated, so iterating
+     * over it takes time proportional to the number of excess nodes rather than the
+     * total number of nodes. The order of iteration is unspecified. The set must not
+     * be iterated over while node excesses are being modified.
+     *
+     * @returns
+     *     The nodes with positive excess.
+     */
     [[nodiscard]] constexpr auto
-    excess_nodes() const
+    excess_nodes() const noexcept -> const node_set_type&
     {
-        return ranges::views::filter(
-                nodes(), [&](const auto& node) { return is_excess_node(node); });
+        return excess_nodes_;
     }
 
+    /**
+     * Get the set of deficit nodes in the network. See `excess_nodes()`.
+     *
+     * @returns
+     *     The nodes with negative excess.
+     */
     [[nodiscard]] constexpr auto
-    deficit_nodes() const
+    deficit_nodes() const noexcept -> const node_set_type&
     {
-        return ranges::views::filter(
-                nodes(), [&](const auto& node) { return is_deficit_node(node); });
+        return deficit_nodes_;
     }
 
     /**
@@ -147,11 +341,9 @@ public:
      *     The sum of the excess surplus among all excess nodes in the network.
      */
     [[nodiscard]] constexpr auto
-    total_excess() const -> ssize_type
+    total_excess() const noexcept -> ssize_type
     {
-        auto excesses = ranges::views::transform(
-                excess_nodes(), [&](const auto& node) { return node_excess(node); });
-        return ranges::fold_left(std::move(excesses), 0, std::plus<ssize_type>());
+        return total_excess_;
     }
 
     /**
@@ -162,19 +354,15 @@ public:
      *     negative value).
      */
     [[nodiscard]] constexpr auto
-    total_deficit() const -> ssize_type
+    total_deficit() const noexcept -> ssize_type
     {
-        auto deficits = ranges::views::transform(
-                deficit_nodes(), [&](const auto& node) { return node_excess(node); });
-        return ranges::fold_left(std::move(deficits), 0, std::plus<ssize_type>());
+        return total_deficit_;
     }
 
     [[nodiscard]] constexpr auto
-    is_balanced() const -> bool
+    is_balanced() const noexcept -> bool
     {
-        const auto imbalance =
-                ranges::fold_left(node_excess_, 0, std::plus<ssize_type>());
-        return imbalance == ssize_type{0};
+        return total_excess_ + total_deficit_ == ssize_type{0};
     }
 
     [[nodiscard]] constexpr auto
@@ -218,9 +406,13 @@ public:
     arc_cost(const arc_type& arc) const -> const cost_type&
     {
         WHIRLWIND_ASSERT(contains_arc(arc));
-        const auto arc_id = get_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_cost_));
-        return arc_cost_[arc_id];
+        if constexpr (detail::ArcCostMixin<super_type>) {
+            return super_type::arc_cost(arc);
+        } else {
+            const auto arc_id = get_arc_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_cost_));
+            return arc_cost_[arc_id];
+        }
     }
 
     [[nodiscard]] constexpr auto
@@ -231,59 +423,267 @@ public:
         WHIRLWIND_ASSERT(contains_arc(arc));
         WHIRLWIND_ASSERT(contains_node(tail));
         WHIRLWIND_ASSERT(contains_node(head));
-        return arc_cost(arc) - node_potential(tail) + node_potential(head);
+        // Narrow integer costs are promoted to `int` by the arithmetic.
+        return static_cast<cost_type>(arc_cost(arc) - node_potential(tail) +
+                                      node_potential(head));
     }
 
+    /**
+     * Get the total cost of the flow in the network.
+     *
+     * The sum may be distributed across multiple threads. For floating-point costs, the
+     * result may depend on the number of threads, due to rounding.
+     *
+     * @param[in] num_threads
+     *     The maximum number of threads to use. Must be at least 1. Defaults to 1.
+     *
+     * @returns
+     *     The sum of the unit cost times the flow of each forward arc.
+     */
+    [[nodiscard]] auto
+    total_cost(size_type num_threads = 1) const -> cost_type
+    {
+        const auto plus = std::plus<cost_type>();
+        return parallel_reduce_chunks(
+                0, num_forward_arcs(), num_threads, zero<cost_type>(), plus,
+                [&](size_type first, size_type last) {
+                    auto sum = zero<cost_type>();
+                    for (auto edge_id = first; edge_id != last; ++edge_id) {
+                        const auto arc = static_cast<arc_type>(
+                                this->get_residual_graph_arc_id(edge_id));
+                        sum = plus(sum, arc_cost(arc) * arc_flow(arc));
+                    }
+                    return sum;
+                });
+    }
+
+    /**
+     * The number of bytes of memory owned by the network: its residual graph and
+     * per-arc data (see `Mixin`), node excesses and potentials, arc costs, and sets of
+     * excess and deficit nodes. See `get_memory_usage()`.
+     */
     [[nodiscard]] constexpr auto
-    total_cost() const -> cost_type
+    memory_usage() const -> size_type
     {
-        auto arc_costs = ranges::views::transform(forward_arcs(), [&](const auto& arc) {
-            const auto flow = arc_flow(arc);
-            const auto cost = arc_cost(arc);
-            return cost * flow;
-        });
-        return ranges::fold_left(std::move(arc_costs), zero<cost_type>(),
-                                 std::plus<cost_type>());
+        return super_type::memory_usage() + get_memory_usage(node_excess_) +
+               get_memory_usage(node_potential_) + get_memory_usage(arc_cost_) +
+               excess_nodes_.memory_usage() + deficit_nodes_.memory_usage();
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a network.
+     *
+     * The estimate depends only on the size of the graph, not on the node surpluses or
+     * edge costs. Grid graphs own no memory, so e.g. the memory needed by a network on
+     * an M x N grid may be estimated from `RectangularGridGraph<1>(M, N)` before any
+     * input data is loaded. Temporary storage used during construction is not
+     * included.
+     *
+     * @param[in] graph
+     *     The network's original graph.
+     *
+     * @returns
+     *     The estimated value of `memory_usage()` for a network on `graph`.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& graph) -> size_type
+    {
+        const auto num_nodes = size_type{graph.num_vertices()};
+        const auto num_arcs = 2 * size_type{graph.num_edges()};
+
+        auto bytes = super_type::estimate_memory(graph) +
+                     estimate_array_memory<flow_type, Container>(num_nodes) +
+                     estimate_array_memory<cost_type, Container>(num_nodes) +
+                     2 * node_set_type::estimate_memory(num_nodes, num_nodes);
+        if constexpr (!detail::ArcCostMixin<super_type>) {
+            bytes += estimate_array_memory<cost_type, Container>(num_arcs);
+        }
+        return bytes;
     }
 
 protected:
+    // Make the residual arc costs from the forward edge costs. Each edge's cost is
+    // written to its forward arc and the negated cost to the transpose arc, so every
+    // arc is written exactly once and chunks of edges may be processed concurrently.
     template<class RandomAccessRange>
-    [[nodiscard]] constexpr auto
-    make_residual_arc_costs(const RandomAccessRange& forward_cost)
-            -> container_type<cost_type>
+    [[nodiscard]] auto
+    make_residual_arc_costs(const RandomAccessRange& forward_cost,
+                            size_type num_threads) -> container_type<cost_type>
     {
         WHIRLWIND_ASSERT(std::size(forward_cost) == num_forward_arcs());
-        return arcs() | ranges::views::transform([&](const auto& arc) {
-                   if (is_forward_arc(arc)) {
-                       const auto edge_id = this->get_edge_id(arc);
-
-                       WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(forward_cost));
-                       const auto cost = forward_cost[edge_id];
-                       if constexpr (std::is_floating_point_v<decltype(cost)>) {
-                           WHIRLWIND_ASSERT(!std::isnan(cost));
-                       }
-                       WHIRLWIND_ASSERT(cost >= zero<cost_type>());
-                       return cost;
-                   } else {
-                       const auto transpose_arc = this->get_transpose_arc_id(arc);
-                       const auto edge_id = this->get_edge_id(transpose_arc);
-
-                       WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(forward_cost));
-                       const auto cost = forward_cost[edge_id];
-                       if constexpr (std::is_floating_point_v<decltype(cost)>) {
-                           WHIRLWIND_ASSERT(!std::isnan(cost));
-                       }
-                       WHIRLWIND_ASSERT(cost >= zero<cost_type>());
-                       return -cost;
-                   }
-               }) |
-               ranges::to<container_type<cost_type>>();
+        auto arc_cost = container_type<cost_type>(num_arcs());
+        parallel_for_chunks(0, num_forward_arcs(), num_threads, [&](size_type first,
+                                                                    size_type last) {
+            for (auto edge_id = first; edge_id != last; ++edge_id) {
+                const auto cost = forward_cost[edge_id];
+                if constexpr (std::is_floating_point_v<decltype(cost)>) {
+                    WHIRLWIND_ASSERT(!std::isnan(cost));
+                }
+                WHIRLWIND_ASSERT(cost >= zero<cost_type>());
+
+                const auto arc =
+                        static_cast<arc_type>(this->get_residual_graph_arc_id(edge_id));
+                const auto arc_id = get_arc_id(arc);
+                const auto transpose_arc_id =
+                        static_cast<size_type>(this->get_transpose_arc_id(arc));
+                WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_cost));
+                WHIRLWIND_DEBUG_ASSERT(transpose_arc_id < std::size(arc_cost));
+                arc_cost[arc_id] = static_cast<cost_type>(cost);
+                arc_cost[transpose_arc_id] = static_cast<cost_type>(-cost);
+            }
+        });
+        return arc_cost;
+    }
+
+    // Make the residual arc costs of a grid network from planar cost rasters. The edges
+    // of a grid graph are numbered in blocks of up, left, down, and right edges, each
+    // in row-major order, so each raster maps to a contiguous block of forward arcs.
+    // The transpose of each forward arc is the reverse arc of the edge in the
+    // opposite direction at the same position in the opposite block.
+    template<class UpCost, class DownCost, class LeftCost, class RightCost>
+    [[nodiscard]] auto
+    make_grid_arc_costs(const graph_type& graph,
+                        const UpCost& up_cost,
+                        const DownCost& down_cost,
+                        const LeftCost& left_cost,
+                        const RightCost& right_cost,
+                        size_type num_threads) -> container_type<cost_type>
+    {
+        const auto m = static_cast<size_type>(graph.num_rows());
+        const auto n = static_cast<size_type>(graph.num_cols());
+        auto arc_cost = container_type<cost_type>(num_arcs());
+        if ((m == 0) || (n == 0)) {
+            return arc_cost;
+        }
+
+        const auto num_ud_edges = (m - 1) * n;
+        const auto num_lr_edges = m * (n - 1);
+
+        // Copy a raster of forward edge costs, and the negated costs of the
+        // antiparallel edges, into the block of arcs starting at `first_edge`.
+        const auto copy_block = [&](size_type first_edge, const auto& cost,
+                                    const auto& transpose_cost, size_type rows,
+                                    size_type cols) {
+            WHIRLWIND_ASSERT(static_cast<size_type>(cost.extent(0)) == rows);
+            WHIRLWIND_ASSERT(static_cast<size_type>(cost.extent(1)) == cols);
+            WHIRLWIND_ASSERT(static_cast<size_type>(transpose_cost.extent(0)) == rows);
+            WHIRLWIND_ASSERT(static_cast<size_type>(transpose_cost.extent(1)) == cols);
+            parallel_for_chunks(0, rows, num_threads, [&](size_type first_row,
+                                                          size_type last_row) {
+                for (auto i = first_row; i != last_row; ++i) {
+                    for (size_type j = 0; j < cols; ++j) {
+                        const auto c = static_cast<cost_type>(cost(i, j));
+                        const auto ct = static_cast<cost_type>(transpose_cost(i, j));
+                        if constexpr (std::is_floating_point_v<cost_type>) {
+                            WHIRLWIND_ASSERT(!std::isnan(c));
+                        }
+                        WHIRLWIND_ASSERT(c >= zero<cost_type>());
+                        const auto arc_id = this->get_residual_graph_arc_id(
+                                first_edge + i * cols + j);
+                        WHIRLWIND_DEBUG_ASSERT(arc_id + 1 < std::size(arc_cost));
+                        arc_cost[arc_id] = c;
+                        arc_cost[arc_id + 1] = static_cast<cost_type>(-ct);
+                    }
+                }
+            });
+        };
+
+        const auto first_left_edge = num_ud_edges;
+        const auto first_down_edge = first_left_edge + num_lr_edges;
+        const auto first_right_edge = first_down_edge + num_ud_edges;
+        if (m >= 2) {
+            WHIRLWIND_DEBUG_ASSERT(graph.get_up_edge({1, 0}) == 0);
+            WHIRLWIND_DEBUG_ASSERT(graph.get_down_edge({0, 0}) == first_down_edge);
+        }
+        if (n >= 2) {
+            WHIRLWIND_DEBUG_ASSERT(graph.get_left_edge({0, 1}) == first_left_edge);
+            WHIRLWIND_DEBUG_ASSERT(graph.get_right_edge({0, 0}) == first_right_edge);
+        }
+
+        copy_block(0, up_cost, down_cost, m - 1, n);
+        copy_block(first_left_edge, left_cost, right_cost, m, n - 1);
+        copy_block(first_down_edge, down_cost, up_cost, m - 1, n);
+        copy_block(first_right_edge, right_cost, left_cost, m, n - 1);
+
+        return arc_cost;
+    }
+
+    // If the mixin stores arc costs, hand the costs over to it and return an empty
+    // container. Otherwise, return the costs unchanged.
+    [[nodiscard]] constexpr auto
+    init_arc_costs(container_type<cost_type> arc_cost) -> container_type<cost_type>
+    {
+        if constexpr (detail::ArcCostMixin<super_type>) {
+            WHIRLWIND_STATIC_ASSERT(
+                    std::is_same_v<typename super_type::cost_type, cost_type>);
+            super_type::set_arc_costs(arc_cost);
+            return {};
+        } else {
+            return arc_cost;
+        }
     }
 
 private:
+    // Populate the excess and deficit node sets and their totals from the initial
+    // node excesses.
+    constexpr void
+    init_active_nodes()
+    {
+        excess_nodes_ = node_set_type(num_nodes());
+        deficit_nodes_ = node_set_type(num_nodes());
+        total_excess_ = 0;
+        total_deficit_ = 0;
+        for (const auto& node : nodes()) {
+            update_active_nodes(node, zero<flow_type>(), node_excess(node));
+        }
+    }
+
+    // Update the excess and deficit node sets and their totals after a node's excess
+    // changed from `old_excess` to `new_excess`.
+    constexpr void
+    update_active_nodes(const node_type& node,
+                        const flow_type& old_excess,
+                        const flow_type& new_excess)
+    {
+        const auto was_excess = old_excess > zero<flow_type>();
+        const auto was_deficit = old_excess < zero<flow_type>();
+        const auto is_excess = new_excess > zero<flow_type>();
+        const auto is_deficit = new_excess < zero<flow_type>();
+
+        if (was_excess) {
+            total_excess_ -= static_cast<ssize_type>(old_excess);
+        } else if (was_deficit) {
+            total_deficit_ -= static_cast<ssize_type>(old_excess);
+        }
+        if (is_excess) {
+            total_excess_ += static_cast<ssize_type>(new_excess);
+        } else if (is_deficit) {
+            total_deficit_ += static_cast<ssize_type>(new_excess);
+        }
+
+        if (was_excess != is_excess) {
+            if (is_excess) {
+                excess_nodes_.insert(get_node_id(node), node);
+            } else {
+                excess_nodes_.erase(get_node_id(node));
+            }
+        }
+        if (was_deficit != is_deficit) {
+            if (is_deficit) {
+                deficit_nodes_.insert(get_node_id(node), node);
+            } else {
+                deficit_nodes_.erase(get_node_id(node));
+            }
+        }
+    }
+
     container_type<flow_type> node_excess_;
     container_type<cost_type> node_potential_;
     container_type<cost_type> arc_cost_;
+    node_set_type excess_nodes_ = {};
+    node_set_type deficit_nodes_ = {};
+    ssize_type total_excess_ = 0;
+    ssize_type total_deficit_ = 0;
 };
 
 WHIRLWIND_NAMESPACE_END
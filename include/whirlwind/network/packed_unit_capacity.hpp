@@ -0,0 +1,232 @@
+#pragma once
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+#include "residual_graph.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A unit-capacity network mixin that stores the per-arc state used by shortest path
+ * searches in a single array of packed arc records.
+ *
+ * `UnitCapacityMixin` and `Network` store the saturation state, transpose arc index,
+ * and cost of each arc in separate arrays, so that relaxing an arc during a shortest
+ * path search reads from several different memory locations. This mixin instead
+ * stores the cost, transpose arc index, and saturation bit of each arc together in one
+ * record, so that the arc records are traversed as a single contiguous stream in the
+ * order of the residual graph's outgoing arcs. The saturation bit is packed into the
+ * most significant bit of the transpose arc index, such that e.g. a record with 32-bit
+ * costs and 32-bit indices occupies 8 bytes.
+ *
+ * `Network` detects this mixin (via `stores_arc_costs`) and delegates storage of arc
+ * costs to it. Otherwise, it is a drop-in replacement for `UnitCapacityMixin`.
+ *
+ * @tparam Graph
+ *     The type of the network's original graph.
+ * @tparam Flow
+ *     The flow type. Must be an integral type.
+ * @tparam Cost
+ *     The arc cost type. Must match the cost type of the network.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the arc records.
+ * @tparam ResidualGraphMixin
+ *     The residual graph mixin base class.
+ */
+template<GraphType Graph,
+         class Flow,
+         class Cost,
+         template<class> class Container = Vector,
+         class ResidualGraphMixin = ResidualGraphMixin<Graph, Container>>
+class PackedUnitCapacityMixin : public ResidualGraphMixin {
+private:
+    using super_type = ResidualGraphMixin;
+
+public:
+    using arc_type = typename super_type::arc_type;
+    using size_type = typename super_type::size_type;
+    using flow_type = Flow;
+    using cost_type = Cost;
+
+    // The type used to store transpose arc indices in the arc records.
+    using index_type = std::make_unsigned_t<arc_type>;
+
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<flow_type>);
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using super_type::arcs;
+    using super_type::contains_arc;
+    using super_type::get_arc_id;
+    using super_type::is_forward_arc;
+    using super_type::num_arcs;
+
+    /** Arc costs are stored in the mixin's arc records rather than by `Network`. */
+    static constexpr bool stores_arc_costs = true;
+
+    /** See `UnitCapacityMixin::arc_capacity()`. */
+    [[nodiscard]] constexpr auto
+    arc_capacity([[maybe_unused]] const arc_type& arc) const -> flow_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        return one<flow_type>();
+    }
+
+    /** See `UnitCapacityMixin::is_arc_saturated()`. */
+    [[nodiscard]] constexpr auto
+    is_arc_saturated(const arc_type& arc) const -> bool
+    {
+        return (get_arc_record(arc).packed_index & saturated_bit) != 0;
+    }
+
+    /** See `UnitCapacityMixin::arc_residual_capacity()`. */
+    [[nodiscard]] constexpr auto
+    arc_residual_capacity(const arc_type& arc) const -> flow_type
+    {
+        return is_arc_saturated(arc) ? zero<flow_type>() : one<flow_type>();
+    }
+
+    /** See `UnitCapacityMixin::arc_flow()`. */
+    [[nodiscard]] constexpr auto
+    arc_flow(const arc_type& arc) const -> flow_type
+    {
+        return is_arc_saturated(arc) ? one<flow_type>() : zero<flow_type>();
+    }
+
+    /**
+     * Get the cost per unit of flow in an arc.
+     *
+     * @param[in] arc
+     *     The input arc. Must be a valid arc in the network's residual graph (though
+     *     its residual capacity may be zero).
+     *
+     * @returns
+     *     The unit cost of flow in the arc.
+     */
+    [[nodiscard]] constexpr auto
+    arc_cost(const arc_type& arc) const -> const cost_type&
+    {
+        return get_arc_record(arc).cost;
+    }
+
+    /** See `ResidualGraphMixin::get_transpose_arc_id()`. */
+    [[nodiscard]] constexpr auto
+    get_transpose_arc_id(const arc_type& arc) const -> index_type
+    {
+        return get_arc_record(arc).packed_index & ~saturated_bit;
+    }
+
+    /** See `UnitCapacityMixin::increase_arc_flow()`. */
+    constexpr void
+    increase_arc_flow(const arc_type& arc, [[maybe_unused]] const flow_type& delta)
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        WHIRLWIND_ASSERT(!is_arc_saturated(arc));
+        WHIRLWIND_ASSERT(delta == one<flow_type>());
+        const auto arc_id = get_arc_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_records_));
+        auto& record = arc_records_[arc_id];
+        const auto transpose_arc_id = record.packed_index & ~saturated_bit;
+        WHIRLWIND_DEBUG_ASSERT(transpose_arc_id < std::size(arc_records_));
+        record.packed_index |= saturated_bit;
+        arc_records_[transpose_arc_id].packed_index &= ~saturated_bit;
+    }
+
+    /**
+     * The number of bytes of memory owned by the network's residual graph and arc
+     * records (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return super_type::memory_usage() + get_memory_usage(arc_records_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store the residual graph and
+     * arc records of a network.
+     *
+     * @param[in] original_graph
+     *     The network's original graph.
+     *
+     * @returns
+     *     The estimated size of the residual graph and arc records.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const typename super_type::graph_type& original_graph)
+            -> size_type
+    {
+        const auto num_arcs = 2 * static_cast<size_type>(original_graph.num_edges());
+        return super_type::estimate_memory(original_graph) +
+               estimate_array_memory<ArcRecord, Container>(num_arcs);
+    }
+
+protected:
+    template<class... Args>
+    constexpr PackedUnitCapacityMixin(Args&&... args)
+        : super_type(std::forward<Args>(args)...), arc_records_(num_arcs())
+    {
+        WHIRLWIND_ASSERT(num_arcs() <= size_type{saturated_bit});
+
+        // Reverse arcs are initially saturated.
+        for (const auto& arc : arcs()) {
+            const auto arc_id = get_arc_id(arc);
+            const auto transpose_arc_id = super_type::get_transpose_arc_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(transpose_arc_id < num_arcs());
+            auto packed_index = static_cast<index_type>(transpose_arc_id);
+            if (!is_forward_arc(arc)) {
+                packed_index |= saturated_bit;
+            }
+            arc_records_[arc_id] = {zero<cost_type>(), packed_index};
+        }
+    }
+
+    /**
+     * Set the cost of each arc in the residual graph.
+     *
+     * @param[in] arc_cost
+     *     The unit cost of each arc, indexed by arc.
+     */
+    template<class RandomAccessRange>
+    constexpr void
+    set_arc_costs(const RandomAccessRange& arc_cost)
+    {
+        WHIRLWIND_ASSERT(std::size(arc_cost) == num_arcs());
+        for (size_type arc_id = 0; arc_id < num_arcs(); ++arc_id) {
+            arc_records_[arc_id].cost = arc_cost[arc_id];
+        }
+    }
+
+private:
+    // The most significant bit of the packed index stores the saturation state.
+    static constexpr auto saturated_bit = static_cast<index_type>(
+            index_type{1} << (std::numeric_limits<index_type>::digits - 1));
+
+    struct ArcRecord {
+        cost_type cost;
+        index_type packed_index;
+    };
+
+    [[nodiscard]] constexpr auto
+    get_arc_record(const arc_type& arc) const -> const ArcRecord&
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        const auto arc_id = get_arc_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_records_));
+        return arc_records_[arc_id];
+    }
+
+    container_type<ArcRecord> arc_records_;
+};
+
+WHIRLWIND_NAMESPACE_END
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -10,17 +12,100 @@
 #include <range/v3/algorithm/sort.hpp>
 #include <range/v3/algorithm/unique.hpp>
 #include <range/v3/range/conversion.hpp>
+#include <range/v3/view/reverse.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra_concepts.hpp>
+#include <whirlwind/graph/dijkstra_visitor.hpp>
 #include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
 #include <whirlwind/math/numbers.hpp>
 
+#include "admissible_path_search.hpp"
+#include "solver_workspace_concepts.hpp"
 #include "successive_shortest_paths.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/** How flow is augmented during each iteration of the primal-dual algorithm. */
+enum class PrimalDualPhase : unsigned char {
+    /**
+     * Augment flow along a single shortest path from each excess node that reached any
+     * deficit node.
+     */
+    single_path,
+    /**
+     * After updating the node potentials, additionally augment flow along paths of
+     * zero reduced cost until the admissible subgraph is blocked (see
+     * `AdmissiblePathSearch`). This typically eliminates much more excess per
+     * iteration, reducing the number of iterations.
+     */
+    blocking_flow,
+    /**
+     * Augment flow in bulk along every tree of the shortest path forest, from each
+     * excess node to any number of deficit nodes in its tree (see
+     * `augment_flow_forest_pd()`). This eliminates more excess per iteration when node
+     * supplies exceed one unit, but visits every node in the forest, so `single_path`
+     * is usually faster when each node has unit supply.
+     */
+    shortest_path_forest,
+};
+
+/** The reason that `primal_dual()` stopped performing primal-dual iterations. */
+enum class PrimalDualStopReason : unsigned char {
+    /** All excess was eliminated by the primal-dual iterations. */
+    converged,
+    /**
+     * The max number of iterations was reached. The remaining excess was routed using
+     * the successive shortest paths algorithm.
+     */
+    max_iterations,
+    /**
+     * The predicted yield of the next iteration fell below the min yield. The
+     * remaining excess was routed using the successive shortest paths algorithm.
+     */
+    low_yield,
+    /**
+     * The solver statistics policy requested that the solve stop early (see
+     * `SolverControl`). The remaining excess was left unrouted.
+     */
+    interrupted,
+};
+
+/**
+ * The default min yield of a primal-dual iteration, in units of excess eliminated per
+ * node visited, before switching to the successive shortest paths algorithm.
+ *
+ * Each primal-dual iteration visits every node in the network, while a successive
+ * shortest paths search stops at the nearest deficit node. On phase unwrapping
+ * problems, the last few primal-dual iterations typically eliminate only a handful of
+ * residues each, at which point switching to the successive shortest paths algorithm
+ * is faster.
+ */
+inline constexpr double default_primal_dual_min_yield = 1e-4;
+
+/** A summary of the policy decisions made by `primal_dual()`. */
+struct PrimalDualSummary {
+    /** The number of primal-dual iterations performed. */
+    std::size_t num_iterations = 0;
+    /** The reason that the primal-dual iterations stopped. */
+    PrimalDualStopReason stop_reason = PrimalDualStopReason::converged;
+    /**
+     * The predicted yield of the iteration after the last one, in units of excess per
+     * node visited, or 0 if the iterations converged.
+     */
+    double predicted_yield = 0.0;
+    /**
+     * The total excess that remained after the primal-dual iterations, which was
+     * routed using the successive shortest paths algorithm (unless the iterations were
+     * interrupted).
+     */
+    std::size_t remaining_excess = 0;
+};
+
 template<class Dijkstra>
 class PrimalDualDijkstra : public Dijkstra {
 private:
@@ -117,6 +202,49 @@ public:
         ranges::fill(source_, source_fill_value());
     }
 
+    /**
+     * Reset the solver and replace its underlying graph, reusing its internal arrays.
+     * See `Dijkstra::rebind()`.
+     */
+    constexpr void
+    rebind(const graph_type& g)
+    {
+        super_type::rebind(g);
+        ranges::fill(source_, source_fill_value());
+    }
+
+    /**
+     * The number of bytes of memory owned by the solver, including the source vertex
+     * of each vertex (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> std::size_t
+    {
+        return super_type::memory_usage() + get_memory_usage(source_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed by a solver.
+     *
+     * @param[in] num_vertices
+     *     The number of vertices in the graph.
+     * @param[in] args
+     *     The remaining arguments to `Dijkstra::estimate_memory()` (e.g. the number of
+     *     edges in the graph).
+     *
+     * @returns
+     *     The estimated size of the underlying solver plus the source vertex of each
+     *     vertex.
+     */
+    template<class... Args>
+    [[nodiscard]] static constexpr auto
+    estimate_memory(std::size_t num_vertices, const Args&... args) -> std::size_t
+    {
+        return super_type::estimate_memory(num_vertices, args...) +
+               estimate_array_memory<vertex_type, super_type::template container_type>(
+                       num_vertices);
+    }
+
 private:
     container_type<vertex_type> source_;
     vertex_type source_fill_value_;
@@ -126,65 +254,57 @@ template<class Network>
 [[nodiscard]] constexpr auto
 contains_any_excess_node(const Network& network) -> bool
 {
-    for ([[maybe_unused]] const auto& node : network.excess_nodes()) {
-        return true;
-    }
-    return false;
+    return !std::empty(network.excess_nodes());
 }
 
 // Find the shortest path w.r.t the reduced arc costs to each node from any excess node
-// using Dijkstra's algorithm.
-template<class Dijkstra, class Network>
+// using Dijkstra's algorithm. The events of the search are reported to `visitor`.
+template<class Dijkstra, class Network, class Visitor = NullDijkstraVisitor>
 constexpr void
-dijkstra_pd(Dijkstra& dijkstra, const Network& network)
+dijkstra_pd(Dijkstra& dijkstra, const Network& network, Visitor&& visitor = Visitor())
 {
     using Distance = typename Dijkstra::distance_type;
     WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+    WHIRLWIND_STATIC_ASSERT(
+            DijkstraVisitorType<std::remove_cvref_t<Visitor>, Dijkstra>);
 
     WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
                      std::addressof(network.residual_graph()));
 
     for (const auto& source : network.excess_nodes()) {
         dijkstra.add_source(source);
+        visitor.on_source(source);
         WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(source));
         WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(source) == zero<Distance>());
     }
 
-    while (!dijkstra.done()) {
+    while (!detail::search_done(dijkstra, visitor)) {
         const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
         WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
         WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+        visitor.on_pop(tail, distance);
 
         dijkstra.visit_vertex(tail, distance);
         WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
         WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(tail) == distance);
 
-        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
-            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
-            WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
-
-            if (network.is_arc_saturated(arc)) {
-                continue;
-            }
-
-            const auto arc_length = network.arc_reduced_cost(arc, tail, head);
-            WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
-
-            dijkstra.relax_edge(arc, tail, head, distance + arc_length);
-            WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
-        }
+        detail::relax_outgoing_arcs(dijkstra, network, visitor, tail, distance);
     }
 }
 
-template<template<class> class Container = Vector, class Network, class Dijkstra>
+// Augment flow along the shortest path to each deficit node from each excess node that
+// reached it first. `sinks` is a scratch buffer whose contents are overwritten.
+template<class Network, class Dijkstra, class SinkContainer>
 constexpr void
-augment_flow_pd(Network& network, const Dijkstra& dijkstra)
+augment_flow_pd(Network& network, const Dijkstra& dijkstra, SinkContainer& sinks)
 {
     WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
                      std::addressof(dijkstra.graph()));
 
-    using Node = typename Network::node_type;
-    auto sinks = network.deficit_nodes() | ranges::to<Container<Node>>();
+    sinks.clear();
+    for (const auto& node : network.deficit_nodes()) {
+        sinks.push_back(node);
+    }
     ranges::sort(sinks, [&](const auto& lhs, const auto& rhs) {
         const auto lhs_source = dijkstra.source_vertex(lhs);
         const auto rhs_source = dijkstra.source_vertex(rhs);
@@ -210,30 +330,104 @@ augment_flow_pd(Network& network, const Dijkstra& dijkstra)
     WHIRLWIND_DEBUG_ASSERT(std::distance(it, std::end(sinks)) >= 0);
     sinks.erase(it, std::end(sinks));
 
+    // The paths to each sink belong to different trees of the shortest path forest,
+    // so they're disjoint and the flow along each path may be augmented independently
+    // by as much as its bottleneck capacity allows.
+    for (const auto& sink : sinks) {
+        augment_flow_ssp(network, dijkstra, sink);
+    }
+}
+
+template<template<class> class Container = Vector, class Network, class Dijkstra>
+constexpr void
+augment_flow_pd(Network& network, const Dijkstra& dijkstra)
+{
+    using Node = typename Network::node_type;
+    auto sinks = Container<Node>();
+    augment_flow_pd(network, dijkstra, sinks);
+}
+
+// Augment flow from the excess nodes to the deficit nodes along the trees of the
+// shortest path forest in bulk. Unlike `augment_flow_pd()`, which walks the path to a
+// single sink in each tree, this routes as much flow as possible within each tree, to
+// any number of sinks, in two passes over the visited nodes. (Nodes are visited after
+// their predecessors, so the visitation order is a topological order of the forest.)
+//
+// The first pass, in reverse order, accumulates the flow that each subtree can absorb,
+// limited by the residual capacity of the arc into the subtree. The second pass, in
+// visitation order, distributes each source's excess (up to the amount that its tree
+// can absorb) greedily among the subtrees of each node, so each tree arc is updated at
+// most once. All tree paths are shortest paths, so the reduced cost optimality
+// conditions hold after the potential update regardless of which sinks receive flow.
+// `flow` is a scratch buffer whose contents are overwritten.
+template<class Network, class Dijkstra, class FlowContainer>
+constexpr void
+augment_flow_forest_pd(Network& network, const Dijkstra& dijkstra, FlowContainer& flow)
+{
     using Flow = typename Network::flow_type;
-    constexpr auto delta = one<Flow>();
 
-    for (const auto& sink : sinks) {
-        WHIRLWIND_DEBUG_ASSERT(network.is_deficit_node(sink));
-        network.increase_node_excess(sink, delta);
-        WHIRLWIND_ASSERT(!network.is_deficit_node(sink));
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(dijkstra.graph()));
 
-        auto head = sink;
-        for (const auto& [tail, arc] : dijkstra.predecessors(sink)) {
-            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
-            WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
-            WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
+    const auto deficit = [&](const auto& node) {
+        if (!network.is_deficit_node(node)) {
+            return zero<Flow>();
+        }
+        return static_cast<Flow>(-network.node_excess(node));
+    };
+
+    flow.assign(network.num_nodes(), zero<Flow>());
+    const auto visited_vertices = dijkstra.visited_vertices();
+
+    // Compute the max flow that can be absorbed by the subtree rooted at each vertex.
+    // The flow that can be routed from each root is limited by its excess.
+    for (const auto& node : visited_vertices | ranges::views::reverse) {
+        const auto node_id = network.get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(flow));
+        auto absorbable = flow[node_id] + deficit(node);
+
+        if (dijkstra.is_root_vertex(node)) {
+            WHIRLWIND_DEBUG_ASSERT(network.is_excess_node(node));
+            flow[node_id] = std::min(absorbable, network.node_excess(node));
+            continue;
+        }
 
-            WHIRLWIND_DEBUG_ASSERT(network.arc_residual_capacity(arc) >= delta);
-            network.increase_arc_flow(arc, delta);
-            WHIRLWIND_DEBUG_ASSERT(network.arc_flow(arc) > zero<Flow>());
+        const auto& arc = dijkstra.predecessor_edge(node);
+        absorbable = std::min(absorbable, network.arc_residual_capacity(arc));
+        flow[node_id] = absorbable;
 
-            head = tail;
+        const auto pred_id = network.get_node_id(dijkstra.predecessor_vertex(node));
+        WHIRLWIND_DEBUG_ASSERT(pred_id < std::size(flow));
+        flow[pred_id] += absorbable;
+    }
+
+    // Distribute the flow from each root down its tree. After a vertex is processed,
+    // its entry holds the flow that remains to be passed on to its successors.
+    for (const auto& node : visited_vertices) {
+        const auto node_id = network.get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(flow));
+
+        auto supply = zero<Flow>();
+        if (dijkstra.is_root_vertex(node)) {
+            supply = flow[node_id];
+            if (supply > zero<Flow>()) {
+                network.decrease_node_excess(node, supply);
+            }
+        } else {
+            const auto pred_id = network.get_node_id(dijkstra.predecessor_vertex(node));
+            WHIRLWIND_DEBUG_ASSERT(pred_id < std::size(flow));
+            supply = std::min(flow[pred_id], flow[node_id]);
+            if (supply > zero<Flow>()) {
+                flow[pred_id] -= supply;
+                network.increase_arc_flow(dijkstra.predecessor_edge(node), supply);
+            }
         }
 
-        WHIRLWIND_ASSERT(network.is_excess_node(head));
-        network.decrease_node_excess(head, delta);
-        WHIRLWIND_ASSERT(!network.is_excess_node(head));
+        const auto consumed = std::min(supply, deficit(node));
+        if (consumed > zero<Flow>()) {
+            network.increase_node_excess(node, consumed);
+        }
+        flow[node_id] = supply - consumed;
     }
 }
 
@@ -256,39 +450,282 @@ update_potential_pd(Network& network, const Dijkstra& dijkstra)
     }
 }
 
-template<class Dijkstra, class Logger = NullLogger, class Network>
-constexpr void
-primal_dual(Network& network, std::size_t maxiter = 0)
+namespace detail {
+
+// Check whether the excess remaining after the primal-dual iterations should be routed
+// using the successive shortest paths algorithm.
+[[nodiscard]] constexpr auto
+needs_successive_shortest_paths(PrimalDualStopReason reason) noexcept -> bool
 {
-    auto logger = Logger("whirlwind.network.primal_dual");
+    return (reason == PrimalDualStopReason::max_iterations) ||
+           (reason == PrimalDualStopReason::low_yield);
+}
 
-    WHIRLWIND_ASSERT(network.is_balanced());
+// Run the primal-dual algorithm using the specified solver and scratch buffers for up
+// to `maxiter` iterations (or until no excess nodes remain, if `maxiter` is 0). If
+// `flow` is non-null, flow is augmented along the whole shortest path forest using it
+// as scratch space; otherwise, along a single path per tree using `sinks`. If
+// `path_search` is non-null, each iteration additionally augments flow along
+// admissible paths after updating the potentials.
+//
+// After each iteration, the yield of the next iteration is predicted as the excess
+// eliminated by the current iteration (capped by the remaining excess) per node that
+// it visited. If the prediction is less than `min_yield`, the iterations stop early.
+// Solver statistics are recorded in `stats`.
+template<class Logger,
+         class Network,
+         class Dijkstra,
+         class SinkContainer,
+         class FlowContainer,
+         class PathSearch,
+         class Stats>
+constexpr auto
+primal_dual_iterations(Network& network,
+                       Dijkstra& dijkstra,
+                       SinkContainer& sinks,
+                       FlowContainer* flow,
+                       PathSearch* path_search,
+                       std::size_t maxiter,
+                       double min_yield,
+                       Logger& logger,
+                       Stats& stats) -> PrimalDualSummary
+{
+    WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
+                     std::addressof(network.residual_graph()));
+
+    auto summary = PrimalDualSummary();
+    const auto stop = [&](PrimalDualStopReason reason, double predicted_yield) {
+        summary.stop_reason = reason;
+        summary.predicted_yield = predicted_yield;
+        summary.remaining_excess = static_cast<std::size_t>(network.total_excess());
+        return summary;
+    };
 
-    std::size_t iter = 1;
     while (true) {
-        logger.info("Iteration {}", iter);
+        if (stats.should_stop()) {
+            logger.info("Stopped early with {} excess remaining",
+                        network.total_excess());
+            return stop(PrimalDualStopReason::interrupted, 0.0);
+        }
+
+        ++summary.num_iterations;
+        logger.info("Iteration {}", summary.num_iterations);
 
-        auto dijkstra = PrimalDualDijkstra<Dijkstra>(network);
-        WHIRLWIND_DEBUG_ASSERT(std::addressof(dijkstra.graph()) ==
-                               std::addressof(network.residual_graph()));
+        const auto initial_excess = network.total_excess();
 
-        dijkstra_pd(dijkstra, network);
-        augment_flow_pd(network, dijkstra);
+        timed_phase(stats, SolverPhase::search, [&] {
+            dijkstra.reset();
+            dijkstra_pd(dijkstra, network, stats);
+        });
+        timed_phase(stats, SolverPhase::augment, [&] {
+            if (flow != nullptr) {
+                augment_flow_forest_pd(network, dijkstra, *flow);
+            } else {
+                augment_flow_pd(network, dijkstra, sinks);
+            }
+        });
+        stats.add_iteration();
+        stats.set_excess_remaining(network.total_excess());
 
         if (!contains_any_excess_node(network)) {
-            return;
+            return stop(PrimalDualStopReason::converged, 0.0);
         }
 
-        update_potential_pd(network, dijkstra);
+        timed_phase(stats, SolverPhase::update_potential,
+                    [&] { update_potential_pd(network, dijkstra); });
 
-        if (iter == maxiter) {
-            break;
+        if (path_search != nullptr) {
+            const auto augment = [&] { return path_search->augment(network); };
+            const auto num_paths = timed_phase(stats, SolverPhase::admissible_augment,
+                                               augment);
+            stats.set_excess_remaining(network.total_excess());
+            logger.info("Augmented {} admissible paths", num_paths);
+
+            if (!contains_any_excess_node(network)) {
+                return stop(PrimalDualStopReason::converged, 0.0);
+            }
         }
 
-        ++iter;
+        const auto remaining_excess = network.total_excess();
+        const auto num_visited = std::size(dijkstra.visited_vertices());
+        WHIRLWIND_DEBUG_ASSERT(num_visited > 0);
+        const auto predicted_excess =
+                std::min(initial_excess - remaining_excess, remaining_excess);
+        const auto predicted_yield = static_cast<double>(predicted_excess) /
+                                     static_cast<double>(num_visited);
+
+        if (summary.num_iterations == maxiter) {
+            logger.info("Reached the max number of iterations, switching to successive "
+                        "shortest paths with {} excess remaining",
+                        remaining_excess);
+            return stop(PrimalDualStopReason::max_iterations, predicted_yield);
+        }
+
+        if (predicted_yield < min_yield) {
+            logger.info("Predicted yield {} is below the min yield {}, switching to "
+                        "successive shortest paths with {} excess remaining",
+                        predicted_yield, min_yield, remaining_excess);
+            return stop(PrimalDualStopReason::low_yield, predicted_yield);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Solve a minimum cost flow problem using the primal-dual algorithm.
+ *
+ * If excess remains after `maxiter` iterations, or once an iteration is predicted to
+ * eliminate less than `min_yield` units of excess per node visited, the remaining
+ * excess is routed using the successive shortest paths algorithm.
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type.
+ * @tparam Logger
+ *     The logger type.
+ * @tparam PrimalDualSolver
+ *     The solver type used for the multi-source search in each primal-dual iteration,
+ *     e.g. `DeltaStepping` to spread the search across multiple threads. The
+ *     successive shortest paths algorithm always uses `Dijkstra`.
+ *
+ * @param[in,out] network
+ *     The network.
+ * @param[in] maxiter
+ *     The max number of primal-dual iterations before switching to the successive
+ *     shortest paths algorithm, or 0 for no limit.
+ * @param[in] phase
+ *     How flow is augmented during each iteration.
+ * @param[in] min_yield
+ *     The min predicted yield of a primal-dual iteration, in units of excess per node
+ *     visited, before switching to the successive shortest paths algorithm, or 0 to
+ *     disable the adaptive switch.
+ * @param[in] ssp_search
+ *     How the successive shortest paths algorithm searches for augmenting paths, if
+ *     it is used to route the remaining excess.
+ * @param[in,out] stats
+ *     A solver statistics policy in which to record statistics about the solve,
+ *     including any successive shortest paths iterations (e.g. `SolverStats`).
+ *     Defaults to `NullSolverStats`, which records nothing.
+ *
+ * @returns
+ *     A summary of the primal-dual iterations.
+ */
+template<class Dijkstra,
+         class Logger = NullLogger,
+         class PrimalDualSolver = PrimalDualDijkstra<Dijkstra>,
+         class Network,
+         class Stats = NullSolverStats>
+constexpr auto
+primal_dual(Network& network,
+            std::size_t maxiter = 0,
+            PrimalDualPhase phase = PrimalDualPhase::single_path,
+            double min_yield = default_primal_dual_min_yield,
+            SuccessiveShortestPathsSearch ssp_search =
+                    SuccessiveShortestPathsSearch::dijkstra,
+            Stats&& stats = Stats()) -> PrimalDualSummary
+{
+    auto logger = Logger("whirlwind.network.primal_dual");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    // The solvers and scratch buffers are allocated once and reset between iterations.
+    using PathSearch = AdmissiblePathSearch<typename Network::residual_graph_type>;
+    auto dijkstra = PrimalDualSolver(network);
+    auto sinks = Vector<typename Network::node_type>();
+    auto flow = Vector<typename Network::flow_type>();
+    auto path_search = std::optional<PathSearch>();
+    if (phase == PrimalDualPhase::blocking_flow) {
+        path_search.emplace(network);
+    }
+
+    auto* flow_ptr = (phase == PrimalDualPhase::shortest_path_forest)
+                             ? std::addressof(flow)
+                             : nullptr;
+    auto* path_search_ptr = path_search ? std::addressof(*path_search) : nullptr;
+    const auto summary = detail::primal_dual_iterations(
+            network, dijkstra, sinks, flow_ptr, path_search_ptr, maxiter, min_yield,
+            logger, stats);
+    if (detail::needs_successive_shortest_paths(summary.stop_reason)) {
+        successive_shortest_paths<Dijkstra, Logger>(network, ssp_search, stats);
+    }
+
+    return summary;
+}
+
+/**
+ * Solve a minimum cost flow problem using the primal-dual algorithm, reusing the
+ * solver state owned by a `SolverWorkspace`.
+ *
+ * Equivalent to `primal_dual<Dijkstra>(network, maxiter, phase, min_yield,
+ * ssp_search)`, where `Dijkstra` is the workspace's solver type, except that the
+ * shortest path solvers and scratch buffers are taken from the workspace rather than
+ * allocated. Once the workspace has been used with a network of at least the same
+ * size, solving performs no heap allocation (beyond any needed by the network
+ * itself).
+ *
+ * @param[in,out] network
+ *     The network.
+ * @param[in,out] workspace
+ *     The solver workspace.
+ * @param[in] maxiter
+ *     The max number of primal-dual iterations before switching to the successive
+ *     shortest paths algorithm, or 0 for no limit.
+ * @param[in] phase
+ *     How flow is augmented during each iteration.
+ * @param[in] min_yield
+ *     The min predicted yield of a primal-dual iteration, in units of excess per node
+ *     visited, before switching to the successive shortest paths algorithm, or 0 to
+ *     disable the adaptive switch.
+ * @param[in] ssp_search
+ *     How the successive shortest paths algorithm searches for augmenting paths, if
+ *     it is used to route the remaining excess.
+ * @param[in,out] stats
+ *     A solver statistics policy in which to record statistics about the solve.
+ *
+ * @returns
+ *     A summary of the primal-dual iterations.
+ */
+template<class Logger = NullLogger,
+         class Network,
+         SolverWorkspaceType Workspace,
+         class Stats = NullSolverStats>
+constexpr auto
+primal_dual(Network& network,
+            Workspace& workspace,
+            std::size_t maxiter = 0,
+            PrimalDualPhase phase = PrimalDualPhase::single_path,
+            double min_yield = default_primal_dual_min_yield,
+            SuccessiveShortestPathsSearch ssp_search =
+                    SuccessiveShortestPathsSearch::dijkstra,
+            Stats&& stats = Stats()) -> PrimalDualSummary
+{
+    auto logger = Logger("whirlwind.network.primal_dual");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    using FlowBuffer = typename Workspace::flow_buffer_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<typename Workspace::flow_type,
+                                           typename Network::flow_type>);
+
+    auto& dijkstra = workspace.primal_dual_dijkstra(network);
+    auto& sinks = workspace.node_buffer();
+    FlowBuffer* flow = nullptr;
+    if (phase == PrimalDualPhase::shortest_path_forest) {
+        flow = std::addressof(workspace.flow_buffer());
+    }
+    using PathSearch = typename Workspace::admissible_path_search_type;
+    PathSearch* path_search = nullptr;
+    if (phase == PrimalDualPhase::blocking_flow) {
+        path_search = std::addressof(workspace.admissible_path_search(network));
+    }
+    const auto summary = detail::primal_dual_iterations(
+            network, dijkstra, sinks, flow, path_search, maxiter, min_yield, logger,
+            stats);
+    if (detail::needs_successive_shortest_paths(summary.stop_reason)) {
+        successive_shortest_paths<Logger>(network, workspace, ssp_search, stats);
     }
 
-    successive_shortest_paths<Dijkstra, Logger>(network);
+    return summary;
 }
 
 WHIRLWIND_NAMESPACE_END
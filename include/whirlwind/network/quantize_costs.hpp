@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** Options for quantizing floating-point arc costs to integers. */
+struct CostQuantizationOptions {
+    /**
+     * The factor by which each cost is multiplied before it is rounded to the nearest
+     * integer. If zero, the largest scale for which the largest quantized cost, times
+     * `headroom`, is representable by the integer cost type is used.
+     */
+    double scale = 0.0;
+
+    /**
+     * The ratio between the largest representable integer cost and the largest
+     * quantized cost when the scale is chosen automatically. Shortest path lengths and
+     * node potentials are stored in the cost type, so this should be at least the
+     * number of arcs in the longest expected augmenting path. Must be at least 1.
+     */
+    double headroom = 1024.0;
+};
+
+/** A description of the mapping from floating-point costs to integer costs. */
+struct CostQuantization {
+    /** The factor by which each cost was multiplied before rounding. */
+    double scale = 1.0;
+
+    /**
+     * An upper bound on the absolute error of each quantized cost, in the original
+     * units, i.e. `0.5 / scale`. The total cost of any flow differs from its quantized
+     * total cost (divided by `scale`) by at most this much per unit of flow on each
+     * arc, so an optimal quantized solution is suboptimal by at most twice that amount.
+     */
+    double error_bound = 0.5;
+
+    /** The largest absolute error of any quantized cost, in the original units. */
+    double max_error = 0.0;
+
+    /**
+     * Convert a quantized cost (or total cost) back to the original units.
+     *
+     * @param[in] quantized_cost
+     *     The quantized cost.
+     *
+     * @returns
+     *     The corresponding cost in the original units.
+     */
+    template<class Cost>
+    [[nodiscard]] constexpr auto
+    dequantize(const Cost& quantized_cost) const noexcept -> double
+    {
+        return static_cast<double>(quantized_cost) / scale;
+    }
+};
+
+/**
+ * Quantized integer costs of each edge in a graph.
+ *
+ * @tparam Cost
+ *     The integer cost type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the costs.
+ */
+template<class Cost, template<class> class Container = Vector>
+struct QuantizedCosts {
+    /** The quantized cost of each edge. */
+    Container<Cost> cost = {};
+
+    /** The mapping from the original costs to the quantized costs. */
+    CostQuantization quantization = {};
+};
+
+/**
+ * A network with quantized integer costs.
+ *
+ * @tparam Network
+ *     The network type.
+ */
+template<class Network>
+struct QuantizedNetwork {
+    /** The network. */
+    Network network;
+
+    /** The mapping from the original costs to the network's costs. */
+    CostQuantization quantization = {};
+};
+
+/**
+ * Quantize floating-point edge costs to a (possibly narrow) integer cost type.
+ *
+ * Each cost is multiplied by a scale factor and rounded to the nearest integer, so that
+ * integer-only shortest path engines (e.g. `Dial`) may be used and arc costs may be
+ * stored in fewer bytes.
+ *
+ * Positive infinite costs (e.g. edges that may not carry flow) are mapped to
+ * `infinity<Cost>()` and are excluded from the automatic scale and from `max_error`.
+ *
+ * @tparam Cost
+ *     The integer cost type. Must be a signed integer type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the quantized costs.
+ *
+ * @param[in] cost
+ *     The unit cost of each edge. Each cost must be nonnegative and not NaN.
+ * @param[in] options
+ *     The quantization options.
+ *
+ * @returns
+ *     The quantized costs and a description of the quantization.
+ *
+ * @throws std::runtime_error
+ *     If a cost is NaN or negative infinity, or a finite quantized cost is not
+ *     representable by `Cost`.
+ */
+template<class Cost = int, template<class> class Container = Vector, class Range>
+[[nodiscard]] auto
+quantize_costs(const Range& cost, const CostQuantizationOptions& options = {})
+        -> QuantizedCosts<Cost, Container>
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<Cost> && std::is_signed_v<Cost>);
+    WHIRLWIND_ASSERT(options.scale >= 0.0);
+    WHIRLWIND_ASSERT(options.headroom >= 1.0);
+
+    constexpr auto max_quantized =
+            static_cast<double>(std::numeric_limits<Cost>::max());
+
+    // Find the largest finite cost. Infinite costs don't affect the scale.
+    auto max_cost = 0.0;
+    for (const auto& c : cost) {
+        const auto x = static_cast<double>(c);
+        if (std::isnan(x) || (x == -std::numeric_limits<double>::infinity())) {
+            throw std::runtime_error("costs must not be NaN or negative infinity");
+        }
+        WHIRLWIND_ASSERT(x >= 0.0);
+        if (std::isfinite(x)) {
+            max_cost = std::max(max_cost, x);
+        }
+    }
+
+    auto quantization = CostQuantization();
+    if (options.scale > 0.0) {
+        quantization.scale = options.scale;
+    } else if (max_cost > 0.0) {
+        quantization.scale = std::floor(max_quantized / options.headroom) / max_cost;
+    }
+    if (!(quantization.scale > 0.0)) {
+        throw std::runtime_error("cost type is too narrow for the requested headroom");
+    }
+    quantization.error_bound = 0.5 / quantization.scale;
+
+    auto out = QuantizedCosts<Cost, Container>();
+    out.cost.reserve(std::size(cost));
+    for (const auto& c : cost) {
+        const auto x = static_cast<double>(c);
+        if (std::isinf(x)) {
+            out.cost.push_back(infinity<Cost>());
+            continue;
+        }
+        const auto q = std::round(x * quantization.scale);
+        if (q > max_quantized) {
+            throw std::runtime_error(
+                    "quantized cost is not representable by the cost type");
+        }
+        out.cost.push_back(static_cast<Cost>(q));
+        const auto error = std::abs(quantization.dequantize(q) - x);
+        quantization.max_error = std::max(quantization.max_error, error);
+    }
+    out.quantization = quantization;
+
+    return out;
+}
+
+/**
+ * Create a network whose arc costs are quantized from floating-point edge costs.
+ *
+ * The costs are quantized by `quantize_costs()` to the network's cost type, which must
+ * be a signed integer type.
+ *
+ * @tparam Network
+ *     The network type.
+ *
+ * @param[in] graph
+ *     The graph.
+ * @param[in] surplus
+ *     The supply (or demand, if negative) of each node.
+ * @param[in] cost
+ *     The unit cost of each edge in the graph, indexed by edge. Each cost must be
+ *     nonnegative and not NaN. Positive infinite costs are mapped to infinity.
+ * @param[in] options
+ *     The quantization options.
+ *
+ * @returns
+ *     The network and a description of the quantization.
+ *
+ * @throws std::runtime_error
+ *     If a cost is NaN or negative infinity, or a finite quantized cost is not
+ *     representable by the network's cost type.
+ */
+template<class Network, class InputRange, class Range>
+[[nodiscard]] auto
+make_quantized_network(const typename Network::graph_type& graph,
+                       const InputRange& surplus,
+                       const Range& cost,
+                       const CostQuantizationOptions& options = {})
+        -> QuantizedNetwork<Network>
+{
+    using Cost = typename Network::cost_type;
+    auto quantized = quantize_costs<Cost>(cost, options);
+    return {Network(graph, surplus, quantized.cost), quantized.quantization};
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -1,14 +1,23 @@
 #pragma once
 
 #include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
 #include <utility>
 
 #include <range/v3/view/filter.hpp>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/graph/masked_grid_graph.hpp>
+#include <whirlwind/graph/permuted_csr_graph.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/math/math.hpp>
 
@@ -18,11 +27,12 @@ WHIRLWIND_NAMESPACE_BEGIN
 
 namespace detail {
 
-template<GraphType Graph>
+template<GraphType Graph,
+         GraphType ResidualGraph = typename ResidualGraphTraits<Graph>::type>
 class BasicResidualGraphMixin {
 public:
     using graph_type = Graph;
-    using residual_graph_type = ResidualGraphTraits<graph_type>::type;
+    using residual_graph_type = ResidualGraph;
     using node_type = residual_graph_type::vertex_type;
     using arc_type = residual_graph_type::edge_type;
     using size_type = std::size_t;
@@ -160,6 +170,16 @@ public:
         return residual_graph().outgoing_edges(node);
     }
 
+    /**
+     * The number of bytes of memory owned by the network's residual graph (see
+     * `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(residual_graph_);
+    }
+
 protected:
     constexpr BasicResidualGraphMixin(residual_graph_type residual_graph)
         : residual_graph_(std::move(residual_graph))
@@ -171,16 +191,61 @@ private:
 
 } // namespace detail
 
+/**
+ * The precomputed arrays that describe the residual graph of a network and its
+ * relationship to the network's original graph.
+ *
+ * A `ResidualGraphLayout` holds the same data that `ResidualGraphMixin` computes from
+ * the original graph. It may be used to construct a network directly from previously
+ * computed arrays (for example, arrays loaded from a file via `map_residual_graph()`)
+ * without recomputing them.
+ *
+ * @tparam ResidualGraph
+ *     The residual graph type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the arrays.
+ */
+template<class ResidualGraph, template<class> class Container = Vector>
+struct ResidualGraphLayout {
+    using residual_graph_type = ResidualGraph;
+    using index_type = typename residual_graph_type::edge_type;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /** The residual graph. */
+    residual_graph_type residual_graph;
+
+    /** Whether each arc in the residual graph is a forward arc, indexed by arc. */
+    container_type<bool> is_forward_arc;
+
+    /** The arc index of the forward arc of each edge in the original graph. */
+    container_type<index_type> residual_graph_arc_id;
+
+    /** The arc index of the transpose of each arc in the residual graph. */
+    container_type<index_type> transpose_arc_id;
+
+    /** The original edge index of each arc in the residual graph. */
+    container_type<index_type> edge_id;
+};
+
 template<GraphType Graph, template<class> class Container = Vector>
 class ResidualGraphMixin : public detail::BasicResidualGraphMixin<Graph> {
 private:
     using super_type = detail::BasicResidualGraphMixin<Graph>;
 
 public:
+    using graph_type = super_type::graph_type;
     using arc_type = super_type::arc_type;
     using size_type = super_type::size_type;
     using residual_graph_type = super_type::residual_graph_type;
 
+    // The type used to store arc and edge indices. Matches the residual graph's arc
+    // type, so that e.g. a `CSRGraph` with 32-bit indices also uses 32-bit index
+    // arrays here.
+    using index_type = arc_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_integral_v<index_type>);
+
     template<class T>
     using container_type = Container<T>;
 
@@ -230,12 +295,32 @@ public:
      *     The arc index of the corresponding arc in the residual graph.
      */
     [[nodiscard]] constexpr auto
-    get_residual_graph_arc_id(size_type edge_id) const -> size_type
+    get_residual_graph_arc_id(size_type edge_id) const -> index_type
     {
         WHIRLWIND_ASSERT(edge_id < std::size(residual_graph_arc_id_));
         return residual_graph_arc_id_[edge_id];
     }
 
+    /**
+     * Given a forward arc in the network's residual graph, get the edge index of the
+     * corresponding edge in the original graph.
+     *
+     * @param[in] forward_arc
+     *     The input arc. Must be a valid forward arc in the network's residual graph.
+     *
+     * @returns
+     *     The edge index of the corresponding edge in the original graph.
+     */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const arc_type& forward_arc) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(forward_arc));
+        WHIRLWIND_ASSERT(is_forward_arc(forward_arc));
+        const auto arc_id = get_arc_id(forward_arc);
+        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(edge_id_));
+        return edge_id_[arc_id];
+    }
+
     /**
      * Given a forward or reverse arc in the network's residual graph, get the index of
      * its transpose arc.
@@ -252,7 +337,7 @@ public:
      *     The arc index of the transpose arc.
      */
     [[nodiscard]] constexpr auto
-    get_transpose_arc_id(const arc_type& arc) const -> size_type
+    get_transpose_arc_id(const arc_type& arc) const -> index_type
     {
         WHIRLWIND_ASSERT(contains_arc(arc));
         const auto arc_id = get_arc_id(arc);
@@ -260,11 +345,100 @@ public:
         return transpose_arc_id_[arc_id];
     }
 
+    /**
+     * The number of bytes of memory owned by the network's residual graph and its
+     * associated arc index arrays (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> size_type
+    {
+        return super_type::memory_usage() + get_memory_usage(is_forward_arc_) +
+               get_memory_usage(residual_graph_arc_id_) +
+               get_memory_usage(transpose_arc_id_) + get_memory_usage(edge_id_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store the residual graph of a
+     * graph and its associated arc index arrays.
+     *
+     * @param[in] original_graph
+     *     The original graph.
+     *
+     * @returns
+     *     The estimated size of the residual graph and its arc index arrays.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& original_graph) -> size_type
+    {
+        const auto num_nodes = size_type{original_graph.num_vertices()};
+        const auto num_edges = size_type{original_graph.num_edges()};
+        const auto num_arcs = 2 * num_edges;
+        return residual_graph_type::estimate_memory(num_nodes, num_arcs) +
+               estimate_array_memory<bool, Container>(num_arcs) +
+               estimate_array_memory<index_type, Container>(num_edges) +
+               2 * estimate_array_memory<index_type, Container>(num_arcs);
+    }
+
 protected:
+    /**
+     * Create the residual graph of a network from its original graph.
+     *
+     * For each edge from `tail` to `head` in the original graph, the residual graph
+     * contains a forward arc from `tail` to `head` and a reverse arc from `head` to
+     * `tail`.
+     *
+     * @param[in] original_graph
+     *     The network's original graph.
+     */
+    explicit constexpr ResidualGraphMixin(const graph_type& original_graph)
+        : super_type(make_residual_graph(original_graph)),
+          is_forward_arc_(num_arcs(), false),
+          residual_graph_arc_id_(original_graph.num_edges()),
+          transpose_arc_id_(num_arcs()),
+          edge_id_(num_arcs())
+    {
+        WHIRLWIND_ASSERT(num_arcs() == 2 * original_graph.num_edges());
+
+        // The residual graph may contain multiple arcs with the same tail and head
+        // (e.g. parallel edges, or a reverse arc alongside an antiparallel forward
+        // arc). Track which arcs have already been paired with an edge in the original
+        // graph so that each arc is assigned exactly once.
+        auto is_assigned_arc = container_type<bool>(num_arcs(), false);
+        auto assign_arc = [&](const auto& tail, const auto& head) -> size_type {
+            for (const auto& [arc, arc_head] : this->outgoing_arcs(tail)) {
+                const auto arc_id = get_arc_id(arc);
+                WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(is_assigned_arc));
+                if ((arc_head == head) && !is_assigned_arc[arc_id]) {
+                    is_assigned_arc[arc_id] = true;
+                    return arc_id;
+                }
+            }
+            WHIRLWIND_ASSERT(false);
+            return num_arcs();
+        };
+
+        for (const auto& tail : original_graph.vertices()) {
+            for (const auto& [edge, head] : original_graph.outgoing_edges(tail)) {
+                const auto edge_id = original_graph.get_edge_id(edge);
+                WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(residual_graph_arc_id_));
+
+                const auto forward_arc_id = assign_arc(tail, head);
+                const auto reverse_arc_id = assign_arc(head, tail);
+
+                is_forward_arc_[forward_arc_id] = true;
+                residual_graph_arc_id_[edge_id] = to_index(forward_arc_id);
+                transpose_arc_id_[forward_arc_id] = to_index(reverse_arc_id);
+                transpose_arc_id_[reverse_arc_id] = to_index(forward_arc_id);
+                edge_id_[forward_arc_id] = to_index(edge_id);
+                edge_id_[reverse_arc_id] = to_index(edge_id);
+            }
+        }
+    }
+
     constexpr ResidualGraphMixin(residual_graph_type residual_graph,
                                  container_type<bool> is_forward_arc,
-                                 container_type<size_type> residual_graph_arc_id,
-                                 container_type<size_type> transpose_arc_id)
+                                 container_type<index_type> residual_graph_arc_id,
+                                 container_type<index_type> transpose_arc_id)
         : super_type(std::move(residual_graph)),
           is_forward_arc_(std::move(is_forward_arc)),
           residual_graph_arc_id_(std::move(residual_graph_arc_id)),
@@ -272,22 +446,234 @@ protected:
     {
         WHIRLWIND_ASSERT(2 * std::size(residual_graph_arc_id_) ==
                          std::size(transpose_arc_id_));
-        WHIRLWIND_ASSERT(std::size(is_forward_arc_) == residual_graph().num_edges());
-        WHIRLWIND_ASSERT(std::size(transpose_arc_id_) == residual_graph().num_edges());
+        WHIRLWIND_ASSERT(std::size(is_forward_arc_) == num_arcs());
+        WHIRLWIND_ASSERT(std::size(transpose_arc_id_) == num_arcs());
+
+        // Recover the original edge index of each arc from the forward arc indices.
+        edge_id_.resize(num_arcs());
+        for (size_type edge_id = 0; edge_id < std::size(residual_graph_arc_id_);
+             ++edge_id) {
+            const auto forward_arc_id = residual_graph_arc_id_[edge_id];
+            WHIRLWIND_ASSERT(forward_arc_id < num_arcs());
+            edge_id_[forward_arc_id] = to_index(edge_id);
+            edge_id_[transpose_arc_id_[forward_arc_id]] = to_index(edge_id);
+        }
+    }
+
+    /**
+     * Create the residual graph of a network from precomputed arrays.
+     *
+     * The arrays are moved into the network as-is. No validation is performed beyond
+     * checking that the array sizes are consistent.
+     *
+     * @param[in] layout
+     *     The residual graph and its associated arc index arrays.
+     */
+    explicit constexpr ResidualGraphMixin(
+            ResidualGraphLayout<residual_graph_type, Container> layout)
+        : super_type(std::move(layout.residual_graph)),
+          is_forward_arc_(std::move(layout.is_forward_arc)),
+          residual_graph_arc_id_(std::move(layout.residual_graph_arc_id)),
+          transpose_arc_id_(std::move(layout.transpose_arc_id)),
+          edge_id_(std::move(layout.edge_id))
+    {
+        WHIRLWIND_ASSERT(2 * std::size(residual_graph_arc_id_) == num_arcs());
+        WHIRLWIND_ASSERT(std::size(is_forward_arc_) == num_arcs());
+        WHIRLWIND_ASSERT(std::size(transpose_arc_id_) == num_arcs());
+        WHIRLWIND_ASSERT(std::size(edge_id_) == num_arcs());
     }
 
 private:
+    [[nodiscard]] static constexpr auto
+    to_index(size_type id) noexcept -> index_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(id <= std::numeric_limits<index_type>::max());
+        return static_cast<index_type>(id);
+    }
+
+    [[nodiscard]] static constexpr auto
+    make_residual_graph(const graph_type& original_graph) -> residual_graph_type
+    {
+        using Vertex = typename residual_graph_type::vertex_type;
+        auto edge_list = EdgeList<Vertex, Container>();
+        for (const auto& tail : original_graph.vertices()) {
+            for (const auto& [edge, head] : original_graph.outgoing_edges(tail)) {
+                edge_list.add_edge(tail, head);
+                edge_list.add_edge(head, tail);
+            }
+        }
+        return residual_graph_type(std::move(edge_list));
+    }
+
     container_type<bool> is_forward_arc_;
-    container_type<size_type> residual_graph_arc_id_;
-    container_type<size_type> transpose_arc_id_;
+    container_type<index_type> residual_graph_arc_id_;
+    container_type<index_type> transpose_arc_id_;
+    container_type<index_type> edge_id_;
 };
 
-// Partial specialization for `RectangularGridGraph`.
-template<class Dim, template<class> class Container>
-class ResidualGraphMixin<RectangularGridGraph<1, Dim>, Container>
-    : public detail::BasicResidualGraphMixin<RectangularGridGraph<1, Dim>> {
+/**
+ * A residual graph mixin for general graphs that numbers each forward arc and its
+ * transpose reverse arc consecutively.
+ *
+ * The forward arc of the edge with index `k` in the original graph has arc index `2k`
+ * and its reverse arc has arc index `2k + 1`. Unlike `ResidualGraphMixin`, which stores
+ * the direction, transpose, and original edge index of each arc in separate arrays,
+ * these are computed from the arc index using bit operations. The residual graph is
+ * stored as a `PermutedCSRGraph` whose edge index array maps each position in the
+ * adjacency arrays to its arc index.
+ *
+ * @tparam Graph
+ *     The type of the network's original graph.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the residual graph's arrays.
+ * @tparam Index
+ *     The unsigned integer type used to represent nodes and arcs. Must be able to
+ *     represent twice the number of edges in the original graph.
+ */
+template<GraphType Graph,
+         template<class> class Container = Vector,
+         class Index = typename Graph::edge_type>
+class InterleavedResidualGraphMixin
+    : public detail::BasicResidualGraphMixin<Graph,
+                                             PermutedCSRGraph<Container, Index>> {
 private:
-    using super_type = detail::BasicResidualGraphMixin<RectangularGridGraph<1, Dim>>;
+    using super_type =
+            detail::BasicResidualGraphMixin<Graph, PermutedCSRGraph<Container, Index>>;
+
+public:
+    using graph_type = super_type::graph_type;
+    using residual_graph_type = super_type::residual_graph_type;
+    using arc_type = super_type::arc_type;
+    using size_type = super_type::size_type;
+    using index_type = Index;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using super_type::arcs;
+    using super_type::contains_arc;
+    using super_type::get_arc_id;
+
+    /** See `ResidualGraphMixin::is_forward_arc()`. */
+    [[nodiscard]] constexpr auto
+    is_forward_arc(const arc_type& arc) const -> bool
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        return is_even(get_arc_id(arc));
+    }
+
+    [[nodiscard]] constexpr auto
+    forward_arcs() const
+    {
+        return ranges::views::filter(
+                arcs(), [&](const auto& arc) { return is_forward_arc(arc); });
+    }
+
+    /** See `ResidualGraphMixin::get_residual_graph_arc_id()`. */
+    [[nodiscard]] constexpr auto
+    get_residual_graph_arc_id(size_type edge_id) const -> index_type
+    {
+        WHIRLWIND_ASSERT(2 * edge_id < this->num_arcs());
+        return static_cast<index_type>(2 * edge_id);
+    }
+
+    /** See `ResidualGraphMixin::get_edge_id()`. */
+    [[nodiscard]] constexpr auto
+    get_edge_id(const arc_type& forward_arc) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(forward_arc));
+        WHIRLWIND_ASSERT(is_forward_arc(forward_arc));
+        return get_arc_id(forward_arc) / 2;
+    }
+
+    /** See `ResidualGraphMixin::get_transpose_arc_id()`. */
+    [[nodiscard]] constexpr auto
+    get_transpose_arc_id(const arc_type& arc) const -> index_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        return static_cast<index_type>(get_arc_id(arc) ^ size_type{1});
+    }
+
+    /** See `ResidualGraphMixin::estimate_memory()`. */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& original_graph) -> size_type
+    {
+        const auto num_nodes = size_type{original_graph.num_vertices()};
+        const auto num_arcs = 2 * size_type{original_graph.num_edges()};
+        return residual_graph_type::estimate_memory(num_nodes, num_arcs);
+    }
+
+protected:
+    /**
+     * Create the residual graph of a network from its original graph.
+     *
+     * @param[in] original_graph
+     *     The network's original graph.
+     */
+    explicit constexpr InterleavedResidualGraphMixin(const graph_type& original_graph)
+        : super_type(make_residual_graph(original_graph))
+    {
+        WHIRLWIND_ASSERT(this->num_arcs() == 2 * original_graph.num_edges());
+    }
+
+private:
+    [[nodiscard]] static constexpr auto
+    make_residual_graph(const graph_type& original_graph) -> residual_graph_type
+    {
+        const auto num_nodes = size_type{original_graph.num_vertices()};
+        const auto num_arcs = 2 * size_type{original_graph.num_edges()};
+        WHIRLWIND_ASSERT(num_nodes <= std::numeric_limits<index_type>::max());
+        WHIRLWIND_ASSERT(num_arcs <= std::numeric_limits<index_type>::max());
+
+        // Count the outgoing arcs of each node: each edge contributes a forward arc to
+        // its tail and a reverse arc to its head.
+        auto row_offsets = container_type<index_type>(num_nodes + 1, 0);
+        for (const auto& tail : original_graph.vertices()) {
+            const auto tail_id = original_graph.get_vertex_id(tail);
+            for (const auto& [edge, head] : original_graph.outgoing_edges(tail)) {
+                const auto head_id = original_graph.get_vertex_id(head);
+                ++row_offsets[tail_id + 1];
+                ++row_offsets[head_id + 1];
+            }
+        }
+        std::partial_sum(std::begin(row_offsets), std::end(row_offsets),
+                         std::begin(row_offsets));
+        WHIRLWIND_DEBUG_ASSERT(row_offsets.back() == num_arcs);
+
+        // Scatter each arc to the next free position in its tail node's row.
+        auto column_indices = container_type<index_type>(num_arcs);
+        auto arc_ids = container_type<index_type>(num_arcs);
+        auto next = container_type<index_type>(std::begin(row_offsets),
+                                               std::prev(std::end(row_offsets)));
+        const auto add_arc = [&](size_type tail_id, size_type head_id, size_type arc) {
+            const auto pos = next[tail_id]++;
+            column_indices[pos] = static_cast<index_type>(head_id);
+            arc_ids[pos] = static_cast<index_type>(arc);
+        };
+        for (const auto& tail : original_graph.vertices()) {
+            const auto tail_id = original_graph.get_vertex_id(tail);
+            for (const auto& [edge, head] : original_graph.outgoing_edges(tail)) {
+                const auto head_id = original_graph.get_vertex_id(head);
+                const auto edge_id = original_graph.get_edge_id(edge);
+                add_arc(tail_id, head_id, 2 * edge_id);
+                add_arc(head_id, tail_id, 2 * edge_id + 1);
+            }
+        }
+
+        return {std::move(row_offsets), std::move(column_indices), std::move(arc_ids)};
+    }
+};
+
+namespace detail {
+
+// Residual graph mixin for grid graphs with a single edge between each pair of
+// adjacent vertices. The residual graph has two parallel arcs for each edge in the
+// original graph: a forward arc followed by the transpose of the antiparallel edge's
+// forward arc.
+template<class Graph, template<class> class Container>
+class GridResidualGraphMixin : public BasicResidualGraphMixin<Graph> {
+private:
+    using super_type = BasicResidualGraphMixin<Graph>;
 
 public:
     using graph_type = super_type::graph_type;
@@ -358,11 +744,126 @@ public:
         }
     }
 
+    // The residual graph of a grid graph owns no memory.
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& /* original_graph */) noexcept -> size_type
+    {
+        return 0;
+    }
+
 protected:
-    constexpr ResidualGraphMixin(const graph_type& original_graph)
+    constexpr GridResidualGraphMixin(const graph_type& original_graph)
         : super_type(residual_graph_type(original_graph.num_rows(),
                                          original_graph.num_cols()))
     {}
 };
 
+} // namespace detail
+
+// Partial specialization for `RectangularGridGraph`.
+template<class Dim, template<class> class Container>
+class ResidualGraphMixin<RectangularGridGraph<1, Dim>, Container>
+    : public detail::GridResidualGraphMixin<RectangularGridGraph<1, Dim>, Container> {
+private:
+    using super_type =
+            detail::GridResidualGraphMixin<RectangularGridGraph<1, Dim>, Container>;
+
+protected:
+    using super_type::super_type;
+};
+
+// Partial specialization for `CompactGridGraph`.
+template<class Vertex, template<class> class Container>
+class ResidualGraphMixin<CompactGridGraph<1, Vertex>, Container>
+    : public detail::GridResidualGraphMixin<CompactGridGraph<1, Vertex>, Container> {
+private:
+    using super_type =
+            detail::GridResidualGraphMixin<CompactGridGraph<1, Vertex>, Container>;
+
+protected:
+    using super_type::super_type;
+};
+
+// Partial specialization for `MaskedGridGraph`. The residual graph has the same
+// vertex mask as the original graph. Each pair of opposing edges in the original graph
+// is numbered consecutively, so the forward arc of each edge is followed by the
+// transpose of the other's forward arc, and the transpose of an arc is found by
+// flipping the two lowest bits of its index.
+template<class Dim,
+         template<class>
+         class GraphContainer,
+         template<class>
+         class Container>
+class ResidualGraphMixin<MaskedGridGraph<1, Dim, GraphContainer>, Container>
+    : public detail::BasicResidualGraphMixin<MaskedGridGraph<1, Dim, GraphContainer>> {
+private:
+    using super_type =
+            detail::BasicResidualGraphMixin<MaskedGridGraph<1, Dim, GraphContainer>>;
+
+public:
+    using graph_type = super_type::graph_type;
+    using residual_graph_type = super_type::residual_graph_type;
+    using arc_type = super_type::arc_type;
+    using size_type = super_type::size_type;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using super_type::arcs;
+    using super_type::contains_arc;
+    using super_type::get_arc_id;
+
+    [[nodiscard]] constexpr auto
+    is_forward_arc(const arc_type& arc) const -> bool
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        return is_even(get_arc_id(arc));
+    }
+
+    [[nodiscard]] constexpr auto
+    forward_arcs() const
+    {
+        return ranges::views::filter(
+                arcs(), [&](const auto& arc) { return is_forward_arc(arc); });
+    }
+
+    [[nodiscard]] constexpr auto
+    get_residual_graph_arc_id(size_type edge_id) const -> size_type
+    {
+        return 2 * edge_id;
+    }
+
+    [[nodiscard]] constexpr auto
+    get_edge_id(const arc_type& forward_arc) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(forward_arc));
+        WHIRLWIND_ASSERT(is_forward_arc(forward_arc));
+        return get_arc_id(forward_arc) / 2;
+    }
+
+    [[nodiscard]] constexpr auto
+    get_transpose_arc_id(const arc_type& arc) const -> size_type
+    {
+        WHIRLWIND_ASSERT(contains_arc(arc));
+        return get_arc_id(arc) ^ size_type{3};
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store the residual graph of a
+     * graph, which has the same vertex mask as the original graph.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& original_graph) -> size_type
+    {
+        return residual_graph_type::estimate_memory(
+                static_cast<size_type>(original_graph.num_rows()),
+                static_cast<size_type>(original_graph.num_cols()));
+    }
+
+protected:
+    constexpr ResidualGraphMixin(const graph_type& original_graph)
+        : super_type(residual_graph_type(original_graph))
+    {}
+};
+
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/mapped_file.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/const_span.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/csr_graph_io.hpp>
+
+#include "residual_graph.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Write the residual graph of a network to an output stream in binary format.
+ *
+ * The file stores the network's residual graph (which must be a `CSRGraph`) together
+ * with the arc index arrays of its `ResidualGraphMixin`, in a versioned binary layout
+ * that may be loaded without copying via `map_residual_graph()`. The network's
+ * mutable state (flows, potentials, node excesses, and arc costs) is not stored.
+ *
+ * @param[in,out] os
+ *     The output stream. Should be opened in binary mode.
+ * @param[in] network
+ *     The network.
+ *
+ * @throws std::runtime_error
+ *     If writing to the stream failed.
+ */
+template<class Network>
+void
+write_residual_graph(std::ostream& os, const Network& network)
+{
+    using index_type = typename Network::residual_graph_type::edge_type;
+    const auto& residual_graph = network.residual_graph();
+
+    // Boolean arrays are stored as one byte per element.
+    WHIRLWIND_STATIC_ASSERT(sizeof(bool) == 1);
+
+    auto writer = detail::BinaryWriter(os);
+    writer.write_header(detail::BinaryFileKind::residual_graph, sizeof(index_type),
+                        residual_graph.num_vertices(), residual_graph.num_edges());
+    writer.write_array(residual_graph.row_offsets());
+    writer.write_array(residual_graph.column_indices());
+
+    const auto arcs = network.arcs();
+    writer.write_array(arcs | ranges::views::transform([&](const auto& arc) {
+                           return network.is_forward_arc(arc);
+                       }));
+
+    const auto num_edges = network.num_forward_arcs();
+    const auto edge_ids = ranges::views::iota(std::size_t{0}, num_edges);
+    writer.write_array(edge_ids | ranges::views::transform([&](auto edge_id) {
+                           return static_cast<index_type>(
+                                   network.get_residual_graph_arc_id(edge_id));
+                       }));
+
+    writer.write_array(arcs | ranges::views::transform([&](const auto& arc) {
+                           return static_cast<index_type>(
+                                   network.get_transpose_arc_id(arc));
+                       }));
+
+    writer.write_array(arcs | ranges::views::transform([&](const auto& arc) {
+                           const auto forward_arc =
+                                   network.is_forward_arc(arc)
+                                           ? arc
+                                           : network.get_transpose_arc_id(arc);
+                           const auto edge_id = network.get_edge_id(forward_arc);
+                           return static_cast<index_type>(edge_id);
+                       }));
+}
+
+/**
+ * Load the residual graph of a network from a memory-mapped binary file written by
+ * `write_residual_graph()`.
+ *
+ * The returned layout refers directly to the contents of the mapped file, which must
+ * outlive it (and any network constructed from it). A network may be constructed from
+ * the layout using a `ResidualGraphMixin` with `ConstSpan` as its container, e.g.
+ *
+ * @code
+ * using Graph = CSRGraph<ConstSpan, std::uint32_t>;
+ * using Base = ResidualGraphMixin<Graph, ConstSpan>;
+ * using Mixin = UnitCapacityMixin<Graph, int, Vector, Base>;
+ * auto network = Network<Graph, int, int, Vector, Mixin>(
+ *         map_residual_graph<std::uint32_t>(file), surplus, cost);
+ * @endcode
+ *
+ * @tparam Index
+ *     The vertex and arc index type of the residual graph. Must match the index type of
+ *     the residual graph that was written.
+ *
+ * @param[in] file
+ *     The mapped file.
+ *
+ * @returns
+ *     A read-only residual graph layout backed by the mapped file.
+ *
+ * @throws std::runtime_error
+ *     If the file is not a valid residual graph file with the same format version,
+ *     byte order, and index size.
+ */
+template<class Index = std::size_t>
+[[nodiscard]] auto
+map_residual_graph(const MappedFile& file)
+        -> ResidualGraphLayout<CSRGraph<ConstSpan, Index>, ConstSpan>
+{
+    auto reader = detail::BinaryReader(file.bytes());
+    const auto header = reader.read_header(detail::BinaryFileKind::residual_graph,
+                                           sizeof(Index));
+    const auto num_nodes = static_cast<std::size_t>(header.num_vertices);
+    const auto num_arcs = static_cast<std::size_t>(header.num_edges);
+    if (num_arcs % 2 != 0) {
+        throw std::runtime_error("binary file contains an odd number of arcs");
+    }
+
+    auto row_offsets = reader.read_array<Index>(num_nodes + 1);
+    auto column_indices = reader.read_array<Index>(num_arcs);
+    if (row_offsets.front() != 0 || row_offsets.back() != num_arcs) {
+        throw std::runtime_error("binary file contains invalid row offsets");
+    }
+
+    auto is_forward_arc = reader.read_array<bool>(num_arcs);
+    auto residual_graph_arc_id = reader.read_array<Index>(num_arcs / 2);
+    auto transpose_arc_id = reader.read_array<Index>(num_arcs);
+    auto edge_id = reader.read_array<Index>(num_arcs);
+
+    using ResidualGraph = CSRGraph<ConstSpan, Index>;
+    return {
+            ResidualGraph(std::move(row_offsets), std::move(column_indices)),
+            std::move(is_forward_arc),
+            std::move(residual_graph_arc_id),
+            std::move(transpose_arc_id),
+            std::move(edge_id),
+    };
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -3,7 +3,9 @@
 #include <cstddef>
 
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/graph/compact_grid_graph.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/masked_grid_graph.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 
 WHIRLWIND_NAMESPACE_BEGIN
@@ -11,9 +13,9 @@ WHIRLWIND_NAMESPACE_BEGIN
 template<class Graph>
 struct ResidualGraphTraits;
 
-template<template<class> class Container>
-struct ResidualGraphTraits<CSRGraph<Container>> {
-    using type = CSRGraph<Container>;
+template<template<class> class Container, class Index>
+struct ResidualGraphTraits<CSRGraph<Container, Index>> {
+    using type = CSRGraph<Container, Index>;
 };
 
 template<std::size_t P, class Dim>
@@ -21,4 +23,14 @@ struct ResidualGraphTraits<RectangularGridGraph<P, Dim>> {
     using type = RectangularGridGraph<2 * P, Dim>;
 };
 
+template<std::size_t P, class Vertex>
+struct ResidualGraphTraits<CompactGridGraph<P, Vertex>> {
+    using type = CompactGridGraph<2 * P, Vertex>;
+};
+
+template<std::size_t P, class Dim, template<class> class Container>
+struct ResidualGraphTraits<MaskedGridGraph<P, Dim, Container>> {
+    using type = MaskedGridGraph<2 * P, Dim, Container>;
+};
+
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// A residual graph mixin that may be constructed on its own (the constructors of the
+// residual graph mixins are protected, since they are meant to be used as bases of a
+// `Network`).
+template<class ResidualGraphMixin>
+class ResidualTopology : public ResidualGraphMixin {
+public:
+    template<class... Args>
+    explicit constexpr ResidualTopology(Args&&... args)
+        : ResidualGraphMixin(std::forward<Args>(args)...)
+    {}
+};
+
+} // namespace detail
+
+/**
+ * A residual graph and its associated arc index arrays, shared by multiple networks.
+ *
+ * Many networks on the same graph (e.g. the interferograms of a stack, all on the same
+ * grid) have identical residual graphs, which differ only in their node excesses,
+ * potentials, arc flows, and arc costs. A `SharedResidualGraph` computes the residual
+ * graph (as `ResidualGraphMixin` would) once, and may be passed to the constructor of
+ * each `Network` whose mixin is based on `SharedResidualGraphMixin<ResidualGraphMixin>`
+ * so that the networks refer to it rather than storing their own copy.
+ *
+ * `SharedResidualGraph` is a cheap-to-copy handle. The residual graph is destroyed when
+ * the last handle (or network that refers to it) is destroyed. It is never modified, so
+ * it may be used by multiple networks on multiple threads concurrently.
+ *
+ * @tparam ResidualGraphMixin
+ *     The residual graph mixin whose residual graph is shared (e.g.
+ *     `ResidualGraphMixin<Graph>`).
+ */
+template<class ResidualGraphMixin>
+class SharedResidualGraph {
+public:
+    using mixin_type = ResidualGraphMixin;
+    using graph_type = typename mixin_type::graph_type;
+    using residual_graph_type = typename mixin_type::residual_graph_type;
+    using size_type = std::size_t;
+
+    /**
+     * Create the residual graph of a graph.
+     *
+     * @param[in] original_graph
+     *     The original graph of each network that will share the residual graph.
+     */
+    explicit SharedResidualGraph(const graph_type& original_graph)
+        : topology_(std::make_shared<const detail::ResidualTopology<mixin_type>>(
+                  original_graph))
+    {}
+
+    /** The shared residual graph mixin. */
+    [[nodiscard]] auto
+    get() const noexcept -> const mixin_type&
+    {
+        WHIRLWIND_DEBUG_ASSERT(topology_ != nullptr);
+        return *topology_;
+    }
+
+    /** The number of handles (including networks) that refer to the residual graph. */
+    [[nodiscard]] auto
+    use_count() const noexcept -> long
+    {
+        return topology_.use_count();
+    }
+
+    /**
+     * The number of bytes of memory owned by the shared residual graph and its arc
+     * index arrays (see `get_memory_usage()`).
+     */
+    [[nodiscard]] auto
+    memory_usage() const -> size_type
+    {
+        return get_memory_usage(get());
+    }
+
+    /** See `ResidualGraphMixin::estimate_memory()`. */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& original_graph) -> size_type
+    {
+        return mixin_type::estimate_memory(original_graph);
+    }
+
+private:
+    std::shared_ptr<const detail::ResidualTopology<mixin_type>> topology_;
+};
+
+/**
+ * A residual graph mixin that refers to a `SharedResidualGraph` rather than storing its
+ * own residual graph.
+ *
+ * It provides the same interface as `ResidualGraphMixin` and may be used as the
+ * residual graph mixin of a capacity mixin, e.g.
+ * `UncapacitatedMixin<Graph, Flow, Container, SharedResidualGraphMixin<...>>`. Each
+ * network then stores only its per-network arrays (node excesses and potentials, and
+ * arc flows and costs).
+ *
+ * @tparam ResidualGraphMixin
+ *     The residual graph mixin whose residual graph is shared.
+ */
+template<class ResidualGraphMixin>
+class SharedResidualGraphMixin {
+public:
+    using shared_residual_graph_type = SharedResidualGraph<ResidualGraphMixin>;
+    using mixin_type = ResidualGraphMixin;
+    using graph_type = typename mixin_type::graph_type;
+    using residual_graph_type = typename mixin_type::residual_graph_type;
+    using node_type = typename mixin_type::node_type;
+    using arc_type = typename mixin_type::arc_type;
+    using size_type = typename mixin_type::size_type;
+
+    /** The shared residual graph. */
+    [[nodiscard]] constexpr auto
+    shared_residual_graph() const noexcept -> const shared_residual_graph_type&
+    {
+        return shared_;
+    }
+
+    /** See `ResidualGraphMixin::residual_graph()`. */
+    [[nodiscard]] constexpr auto
+    residual_graph() const noexcept -> const residual_graph_type&
+    {
+        return mixin().residual_graph();
+    }
+
+    [[nodiscard]] constexpr auto
+    num_nodes() const noexcept -> size_type
+    {
+        return mixin().num_nodes();
+    }
+
+    [[nodiscard]] constexpr auto
+    num_arcs() const noexcept -> size_type
+    {
+        return mixin().num_arcs();
+    }
+
+    [[nodiscard]] constexpr auto
+    num_forward_arcs() const noexcept -> size_type
+    {
+        return mixin().num_forward_arcs();
+    }
+
+    [[nodiscard]] constexpr auto
+    contains_node(const node_type& node) const -> bool
+    {
+        return mixin().contains_node(node);
+    }
+
+    [[nodiscard]] constexpr auto
+    contains_arc(const arc_type& arc) const -> bool
+    {
+        return mixin().contains_arc(arc);
+    }
+
+    [[nodiscard]] constexpr auto
+    get_node_id(const node_type& node) const -> size_type
+    {
+        return mixin().get_node_id(node);
+    }
+
+    [[nodiscard]] constexpr auto
+    get_arc_id(const arc_type& arc) const -> size_type
+    {
+        return mixin().get_arc_id(arc);
+    }
+
+    [[nodiscard]] constexpr auto
+    nodes() const
+    {
+        return mixin().nodes();
+    }
+
+    [[nodiscard]] constexpr auto
+    arcs() const
+    {
+        return mixin().arcs();
+    }
+
+    [[nodiscard]] constexpr auto
+    outgoing_arcs(const node_type& node) const
+    {
+        return mixin().outgoing_arcs(node);
+    }
+
+    [[nodiscard]] constexpr auto
+    is_forward_arc(const arc_type& arc) const -> bool
+    {
+        return mixin().is_forward_arc(arc);
+    }
+
+    [[nodiscard]] constexpr auto
+    forward_arcs() const
+    {
+        return mixin().forward_arcs();
+    }
+
+    [[nodiscard]] constexpr auto
+    get_residual_graph_arc_id(size_type edge_id) const
+    {
+        return mixin().get_residual_graph_arc_id(edge_id);
+    }
+
+    [[nodiscard]] constexpr auto
+    get_edge_id(const arc_type& forward_arc) const -> size_type
+    {
+        return mixin().get_edge_id(forward_arc);
+    }
+
+    [[nodiscard]] constexpr auto
+    get_transpose_arc_id(const arc_type& arc) const
+    {
+        return mixin().get_transpose_arc_id(arc);
+    }
+
+    /**
+     * The number of bytes of memory owned by the network's residual graph, which is
+     * zero since the residual graph is shared (see
+     * `SharedResidualGraph::memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const noexcept -> size_type
+    {
+        return 0;
+    }
+
+    // The shared residual graph is not owned by the network.
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const graph_type& /* original_graph */) noexcept -> size_type
+    {
+        return 0;
+    }
+
+protected:
+    /**
+     * Refer to a shared residual graph.
+     *
+     * @param[in] shared_residual_graph
+     *     The shared residual graph.
+     */
+    explicit constexpr SharedResidualGraphMixin(
+            shared_residual_graph_type shared_residual_graph) noexcept
+        : shared_(std::move(shared_residual_graph))
+    {}
+
+private:
+    [[nodiscard]] constexpr auto
+    mixin() const noexcept -> const mixin_type&
+    {
+        return shared_.get();
+    }
+
+    shared_residual_graph_type shared_;
+};
+
+WHIRLWIND_NAMESPACE_END
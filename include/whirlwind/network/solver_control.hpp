@@ -0,0 +1,278 @@
+#pragma once
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** The reason that a solve controlled by a `SolverControl` stopped early. */
+enum class SolverStopReason : unsigned char {
+    /** The solve was not stopped early. */
+    none,
+    /** Cancellation was requested via the stop token. */
+    cancelled,
+    /** The deadline passed. */
+    deadline,
+};
+
+/**
+ * A solver statistics policy that can interrupt a solve and reports its progress.
+ *
+ * `SolverControl` collects the same statistics as `SolverStats`. In addition, between
+ * iterations of `primal_dual()` or `successive_shortest_paths()`, it invokes an
+ * optional progress callback with the statistics so far (e.g. the remaining excess and
+ * the time spent in each phase), and then stops the solve if cancellation was requested
+ * via its stop token or its deadline has passed.
+ *
+ * A solve that stops early returns as soon as the current iteration finishes. The
+ * network is left with a feasible flow (which satisfies the arc capacities) and node
+ * potentials for which every unsaturated arc has nonnegative reduced cost, but some
+ * excess remains unrouted. The caller may inspect `stop_reason()` and
+ * `Network::total_excess()` to decide whether to accept the partial solution, e.g. by
+ * resolving the remaining excess with a cheaper cost model.
+ *
+ * The deadline is checked once per iteration, so a single long iteration (e.g. a
+ * primal-dual iteration on a very large network) may overrun it.
+ */
+class SolverControl : public SolverStats {
+public:
+    using clock_type = SolverStats::clock_type;
+    using progress_callback_type = std::function<void(const SolverStats&)>;
+
+    /** Create a new `SolverControl` with no stop token, deadline, or callback. */
+    SolverControl() = default;
+
+    /**
+     * Stop the solve once stop is requested on a stop token.
+     *
+     * @param[in] stop_token
+     *     The stop token.
+     */
+    void
+    set_stop_token(std::stop_token stop_token) noexcept
+    {
+        stop_token_ = std::move(stop_token);
+    }
+
+    /**
+     * Stop the solve once a deadline has passed.
+     *
+     * @param[in] deadline
+     *     The deadline.
+     */
+    void
+    set_deadline(clock_type::time_point deadline) noexcept
+    {
+        deadline_ = deadline;
+    }
+
+    /**
+     * Stop the solve once a time budget, measured from now, has been spent.
+     *
+     * @param[in] budget
+     *     The time budget.
+     */
+    template<class Rep, class Period>
+    void
+    set_time_budget(std::chrono::duration<Rep, Period> budget)
+    {
+        set_deadline(clock_type::now() +
+                     std::chrono::duration_cast<clock_type::duration>(budget));
+    }
+
+    /**
+     * Invoke a callback with the statistics so far between solver iterations.
+     *
+     * @param[in] callback
+     *     The callback. It's invoked on the thread that runs the solve.
+     */
+    void
+    set_progress_callback(progress_callback_type callback)
+    {
+        progress_callback_ = std::move(callback);
+    }
+
+    /** The reason that the most recent solve stopped early, if it did. */
+    [[nodiscard]] auto
+    stop_reason() const noexcept -> SolverStopReason
+    {
+        return stop_reason_;
+    }
+
+    /** Check whether the most recent solve stopped early. */
+    [[nodiscard]] auto
+    stopped() const noexcept -> bool
+    {
+        return stop_reason_ != SolverStopReason::none;
+    }
+
+    /**
+     * Report progress and check whether the solver should stop early.
+     *
+     * @returns
+     *     True if cancellation was requested or the deadline has passed; otherwise
+     *     false.
+     */
+    [[nodiscard]] auto
+    should_stop() -> bool
+    {
+        if (progress_callback_) {
+            progress_callback_(*this);
+        }
+        if (stop_token_.stop_requested()) {
+            stop_reason_ = SolverStopReason::cancelled;
+        } else if (deadline_ && (clock_type::now() >= *deadline_)) {
+            stop_reason_ = SolverStopReason::deadline;
+        }
+        return stopped();
+    }
+
+private:
+    std::stop_token stop_token_ = {};
+    std::optional<clock_type::time_point> deadline_ = {};
+    progress_callback_type progress_callback_ = {};
+    SolverStopReason stop_reason_ = SolverStopReason::none;
+};
+
+/**
+ * A handle to a solve running asynchronously (see `solve_async()`).
+ *
+ * `SolveTask` is movable but not copyable. Destroying the handle does not wait for or
+ * cancel the solve.
+ */
+class SolveTask {
+public:
+    /** Create a `SolveTask` that refers to no solve. */
+    SolveTask() = default;
+
+    SolveTask(std::stop_source stop_source, std::future<SolverStopReason> future)
+        : stop_source_(std::move(stop_source)), future_(std::move(future))
+    {}
+
+    /** Check whether the handle refers to a solve. */
+    [[nodiscard]] auto
+    valid() const noexcept -> bool
+    {
+        return future_.valid();
+    }
+
+    /**
+     * Request that the solve stop after its current iteration. Has no effect if it has
+     * already finished.
+     */
+    void
+    cancel() noexcept
+    {
+        stop_source_.request_stop();
+    }
+
+    /** Block until the solve has finished. */
+    void
+    wait() const
+    {
+        WHIRLWIND_ASSERT(valid());
+        future_.wait();
+    }
+
+    /**
+     * Block until the solve has finished or a timeout has elapsed.
+     *
+     * @returns
+     *     True if the solve has finished; otherwise false.
+     */
+    template<class Rep, class Period>
+    [[nodiscard]] auto
+    wait_for(std::chrono::duration<Rep, Period> timeout) const -> bool
+    {
+        WHIRLWIND_ASSERT(valid());
+        return future_.wait_for(timeout) == std::future_status::ready;
+    }
+
+    /**
+     * Wait for the solve to finish and get the reason that it stopped early, if it
+     * did. May be called at most once.
+     *
+     * @returns
+     *     The reason that the solve stopped early, or `SolverStopReason::none` if it
+     *     ran to completion.
+     *
+     * @throws
+     *     Any exception thrown by the solve.
+     */
+    [[nodiscard]] auto
+    get() -> SolverStopReason
+    {
+        WHIRLWIND_ASSERT(valid());
+        return future_.get();
+    }
+
+private:
+    std::stop_source stop_source_ = std::stop_source(std::nostopstate);
+    std::future<SolverStopReason> future_ = {};
+};
+
+/**
+ * Run a solve asynchronously on an executor.
+ *
+ * The solve is submitted to `executor` as a single task, which invokes
+ * `solve(control)` with a `SolverControl` whose stop token is controlled by the
+ * returned `SolveTask`. `solve` should pass `control` as the solver statistics policy
+ * of `primal_dual()` or `successive_shortest_paths()`, e.g.
+ * `[&](auto& control) { primal_dual<Dijkstra>(network, 0, phase, yield, control); }`,
+ * so that calling `SolveTask::cancel()` stops the solve after its current iteration.
+ *
+ * Any network used by `solve` must outlive the solve and must not be accessed by other
+ * threads until it finishes (see `SolveTask::wait()`).
+ *
+ * @param[in] executor
+ *     A callable object that runs a nullary callable object, e.g. on a thread pool.
+ *     It's invoked once with the task.
+ * @param[in] solve
+ *     A callable object that solves a problem using a `SolverControl&`.
+ * @param[in] control
+ *     The solver control. May have a deadline and a progress callback. Any stop
+ *     token is replaced.
+ *
+ * @returns
+ *     A handle to the solve.
+ */
+template<class Executor, class SolveFunc>
+[[nodiscard]] auto
+solve_async(Executor&& executor, SolveFunc solve, SolverControl control = {})
+        -> SolveTask
+{
+    auto stop_source = std::stop_source();
+    control.set_stop_token(stop_source.get_token());
+
+    // The state of the task is shared, since the executor may copy the task.
+    struct State {
+        SolveFunc solve;
+        SolverControl control;
+        std::promise<SolverStopReason> promise = {};
+    };
+    auto state = std::make_shared<State>(State{std::move(solve), std::move(control)});
+    auto future = state->promise.get_future();
+
+    std::forward<Executor>(executor)([state]() {
+        try {
+            state->solve(state->control);
+            state->promise.set_value(state->control.stop_reason());
+        } catch (...) {
+            state->promise.set_exception(std::current_exception());
+        }
+    });
+
+    return {std::move(stop_source), std::move(future)};
+}
+
+WHIRLWIND_NAMESPACE_END
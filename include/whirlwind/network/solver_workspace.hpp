@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+
+#include "admissible_path_search.hpp"
+#include "primal_dual.hpp"
+#include "solver_workspace_concepts.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Reusable state for the minimum cost flow solvers.
+ *
+ * A `SolverWorkspace` owns the shortest path solvers, admissible path search, and
+ * scratch buffers used by `primal_dual()` and `successive_shortest_paths()`, so that
+ * they may be reused across iterations and across multiple solves. The solvers are
+ * created on first use.
+ * Each subsequent use with a network whose residual graph has no more nodes than the
+ * network that the solver was created for resets the existing solver and rebinds it to
+ * the new network's residual graph, without reallocating its arrays. Using a larger
+ * network recreates the solver.
+ *
+ * As a result, repeatedly solving problems of the same (or decreasing) size performs
+ * no heap allocation in the solvers after the first solve.
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type (e.g. `Dijkstra` or `Dial`). Must provide a
+ *     `rebind()` member function.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store scratch buffers.
+ * @tparam Flow
+ *     The flow type of the networks to be solved.
+ */
+template<class Dijkstra, template<class> class Container = Vector, class Flow = int>
+class SolverWorkspace {
+public:
+    using dijkstra_type = Dijkstra;
+    using primal_dual_dijkstra_type = PrimalDualDijkstra<Dijkstra>;
+    using graph_type = typename dijkstra_type::graph_type;
+    using admissible_path_search_type = AdmissiblePathSearch<graph_type, Container>;
+    using node_type = typename graph_type::vertex_type;
+    using flow_type = Flow;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    using node_buffer_type = container_type<node_type>;
+    using flow_buffer_type = container_type<flow_type>;
+
+    /** Create a new, empty `SolverWorkspace`. No memory is allocated. */
+    SolverWorkspace() = default;
+
+    /**
+     * Get a reset shortest path solver bound to a network's residual graph.
+     *
+     * @param[in] network
+     *     The network. Must outlive any use of the returned solver.
+     *
+     * @returns
+     *     The solver.
+     */
+    template<class Network>
+    [[nodiscard]] constexpr auto
+    dijkstra(const Network& network) -> dijkstra_type&
+    {
+        return acquire(dijkstra_, dijkstra_capacity_, network);
+    }
+
+    /**
+     * Get a reset primal-dual shortest path solver bound to a network's residual
+     * graph.
+     *
+     * @param[in] network
+     *     The network. Must outlive any use of the returned solver.
+     *
+     * @returns
+     *     The solver.
+     */
+    template<class Network>
+    [[nodiscard]] constexpr auto
+    primal_dual_dijkstra(const Network& network) -> primal_dual_dijkstra_type&
+    {
+        return acquire(primal_dual_dijkstra_, primal_dual_dijkstra_capacity_, network);
+    }
+
+    /**
+     * Get an admissible path search bound to a network's residual graph.
+     *
+     * @param[in] network
+     *     The network. Must outlive any use of the returned object.
+     *
+     * @returns
+     *     The admissible path search.
+     */
+    template<class Network>
+    [[nodiscard]] constexpr auto
+    admissible_path_search(const Network& network) -> admissible_path_search_type&
+    {
+        return acquire(admissible_path_search_, admissible_path_search_capacity_,
+                       network);
+    }
+
+    /** A scratch buffer of nodes. Its contents are unspecified. */
+    [[nodiscard]] constexpr auto
+    node_buffer() noexcept -> node_buffer_type&
+    {
+        return node_buffer_;
+    }
+
+    /** A scratch buffer of flow values. Its contents are unspecified. */
+    [[nodiscard]] constexpr auto
+    flow_buffer() noexcept -> flow_buffer_type&
+    {
+        return flow_buffer_;
+    }
+
+    /**
+     * The max number of nodes in a network that can be solved without recreating the
+     * shortest path solvers that have been allocated so far.
+     */
+    [[nodiscard]] constexpr auto
+    capacity() const noexcept -> size_type
+    {
+        auto capacity = std::numeric_limits<size_type>::max();
+        auto any = false;
+        const auto update = [&](const auto& solver, size_type solver_capacity) {
+            if (solver) {
+                capacity = std::min(capacity, solver_capacity);
+                any = true;
+            }
+        };
+        update(dijkstra_, dijkstra_capacity_);
+        update(primal_dual_dijkstra_, primal_dual_dijkstra_capacity_);
+        update(admissible_path_search_, admissible_path_search_capacity_);
+        return any ? capacity : size_type{0};
+    }
+
+    /** Destroy the solvers and release all memory owned by the workspace. */
+    constexpr void
+    clear()
+    {
+        dijkstra_.reset();
+        primal_dual_dijkstra_.reset();
+        admissible_path_search_.reset();
+        dijkstra_capacity_ = 0;
+        primal_dual_dijkstra_capacity_ = 0;
+        admissible_path_search_capacity_ = 0;
+        node_buffer_ = {};
+        flow_buffer_ = {};
+    }
+
+private:
+    template<class Solver, class Network>
+    [[nodiscard]] static constexpr auto
+    acquire(std::optional<Solver>& solver, size_type& capacity, const Network& network)
+            -> Solver&
+    {
+        const auto& residual_graph = network.residual_graph();
+        const auto num_nodes = size_type{residual_graph.num_vertices()};
+        if (solver && (num_nodes <= capacity)) WHIRLWIND_LIKELY {
+            solver->rebind(residual_graph);
+        } else {
+            solver.emplace(network);
+            capacity = num_nodes;
+        }
+        return *solver;
+    }
+
+    std::optional<dijkstra_type> dijkstra_ = {};
+    std::optional<primal_dual_dijkstra_type> primal_dual_dijkstra_ = {};
+    std::optional<admissible_path_search_type> admissible_path_search_ = {};
+    size_type dijkstra_capacity_ = 0;
+    size_type primal_dual_dijkstra_capacity_ = 0;
+    size_type admissible_path_search_capacity_ = 0;
+    node_buffer_type node_buffer_ = {};
+    flow_buffer_type flow_buffer_ = {};
+};
+
+WHIRLWIND_NAMESPACE_END
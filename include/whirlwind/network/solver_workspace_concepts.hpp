@@ -0,0 +1,25 @@
+#pragma once
+
+#include <concepts>
+
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A type that owns reusable solver state for the minimum cost flow algorithms (see
+ * `SolverWorkspace`).
+ */
+template<class T>
+concept SolverWorkspaceType = requires(T w) {
+    typename T::dijkstra_type;
+    typename T::primal_dual_dijkstra_type;
+    typename T::admissible_path_search_type;
+    typename T::flow_type;
+
+    { w.node_buffer() } -> std::same_as<typename T::node_buffer_type&>;
+    { w.flow_buffer() } -> std::same_as<typename T::flow_buffer_type&>;
+    w.clear();
+};
+
+WHIRLWIND_NAMESPACE_END
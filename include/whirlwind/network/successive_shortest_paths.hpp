@@ -1,27 +1,179 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <type_traits>
 
+#include <range/v3/algorithm/sort.hpp>
+
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra_concepts.hpp>
+#include <whirlwind/graph/dijkstra_visitor.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
 #include <whirlwind/math/numbers.hpp>
 
+#include "solver_workspace_concepts.hpp"
+
 WHIRLWIND_NAMESPACE_BEGIN
 
+/** How the successive shortest paths algorithm searches for augmenting paths. */
+enum class SuccessiveShortestPathsSearch : unsigned char {
+    /** Grow a Dijkstra search from each excess node until it reaches a deficit node. */
+    dijkstra,
+    /**
+     * Periodically update the node potentials with the reduced cost distance from
+     * each node to the nearest deficit node, computed by a backward search from all
+     * deficit nodes (see `update_potential_to_deficits()`). This acts as an exact
+     * A* heuristic for each subsequent Dijkstra search, which then only visits nodes
+     * whose distance to the nearest deficit node has increased since the update. The
+     * update is repeated once the searches since the last update have visited as many
+     * nodes as there are in the network, so it at most doubles the number of nodes
+     * visited. Until the first update, this is equivalent to `dijkstra`.
+     */
+    goal_directed,
+};
+
+namespace detail {
+
+// Checks whether a residual graph is a `RectangularGridGraph` with a pair of parallel
+// arcs between each pair of adjacent nodes (i.e. the residual graph of a simple
+// `RectangularGridGraph`).
+template<class ResidualGraph>
+inline constexpr bool is_grid_residual_graph = false;
+
+template<class Dim>
+inline constexpr bool is_grid_residual_graph<RectangularGridGraph<2, Dim>> = true;
+
+// Relax each unsaturated outgoing arc of `tail` (which was reached at the specified
+// distance) w.r.t. its reduced cost. This is the generic implementation, which works
+// for any network.
+template<class Dijkstra, class Network, class Visitor>
+constexpr void
+relax_outgoing_arcs_generic(Dijkstra& dijkstra,
+                            const Network& network,
+                            Visitor& visitor,
+                            const typename Network::node_type& tail,
+                            const typename Dijkstra::distance_type& distance)
+{
+    for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+        WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+        WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+
+        if (network.is_arc_saturated(arc)) {
+            continue;
+        }
+
+        const auto arc_length = network.arc_reduced_cost(arc, tail, head);
+        WHIRLWIND_ASSERT(arc_length >= zero<typename Dijkstra::distance_type>());
+
+        relax_edge(dijkstra, visitor, arc, tail, head, distance + arc_length);
+        WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
+    }
+}
+
+// Same as `relax_outgoing_arcs_generic()`, but specialized for networks whose residual
+// graph is a `RectangularGridGraph<2>`. The four neighbor directions are unrolled and
+// the first arc to each neighbor is computed directly from the tail node's row and
+// column, rather than materializing the outgoing arcs of the tail. The tail node's
+// potential is looked up once, and each neighbor's potential once for both of its
+// parallel arcs.
+//
+// The arcs are relaxed in the same order, and their reduced costs are evaluated by the
+// same expression as `Network::arc_reduced_cost()`, so the results are identical to
+// the generic implementation (including for floating-point costs).
+template<class Dijkstra, class Network, class Visitor>
+constexpr void
+relax_outgoing_grid_arcs(Dijkstra& dijkstra,
+                         const Network& network,
+                         Visitor& visitor,
+                         const typename Network::node_type& tail,
+                         const typename Dijkstra::distance_type& distance)
+{
+    using Node = typename Network::node_type;
+    using Arc = typename Network::arc_type;
+    using Cost = typename Network::cost_type;
+
+    const auto& graph = network.residual_graph();
+    WHIRLWIND_STATIC_ASSERT(graph.num_parallel_edges() == 2);
+    WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
+
+    const auto tail_potential = network.node_potential(tail);
+
+    // Relax the pair of parallel arcs from the tail node to an adjacent node, starting
+    // with `first_arc`.
+    const auto relax_arc_pair = [&](const Arc& first_arc, const Node& head) {
+        WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+        const auto head_potential = network.node_potential(head);
+        for (auto arc = first_arc; arc != first_arc + 2; ++arc) {
+            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
+            if (network.is_arc_saturated(arc)) {
+                continue;
+            }
+
+            const auto arc_length = static_cast<Cost>(network.arc_cost(arc) -
+                                                      tail_potential + head_potential);
+            WHIRLWIND_ASSERT(arc_length >= zero<Cost>());
+
+            relax_edge(dijkstra, visitor, arc, tail, head, distance + arc_length);
+            WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
+        }
+    };
+
+    const auto [i, j] = tail;
+    if (i != 0) WHIRLWIND_LIKELY {
+        relax_arc_pair(graph.get_up_edge(tail), Node(i - 1, j));
+    }
+    if (j != 0) WHIRLWIND_LIKELY {
+        relax_arc_pair(graph.get_left_edge(tail), Node(i, j - 1));
+    }
+    if (i + 1 != graph.num_rows()) WHIRLWIND_LIKELY {
+        relax_arc_pair(graph.get_down_edge(tail), Node(i + 1, j));
+    }
+    if (j + 1 != graph.num_cols()) WHIRLWIND_LIKELY {
+        relax_arc_pair(graph.get_right_edge(tail), Node(i, j + 1));
+    }
+}
+
+// Relax each unsaturated outgoing arc of `tail` w.r.t. its reduced cost, using a
+// specialized implementation for grid networks if possible.
+template<class Dijkstra, class Network, class Visitor>
+constexpr void
+relax_outgoing_arcs(Dijkstra& dijkstra,
+                    const Network& network,
+                    Visitor& visitor,
+                    const typename Network::node_type& tail,
+                    const typename Dijkstra::distance_type& distance)
+{
+    if constexpr (is_grid_residual_graph<typename Network::residual_graph_type>) {
+        relax_outgoing_grid_arcs(dijkstra, network, visitor, tail, distance);
+    } else {
+        relax_outgoing_arcs_generic(dijkstra, network, visitor, tail, distance);
+    }
+}
+
+} // namespace detail
+
 // Find the shortest path w.r.t the reduced arc costs from the source to the nearest
-// deficit node using Dijkstra's algorithm.
-template<class Dijkstra, class Network>
+// deficit node using Dijkstra's algorithm. The events of the search are reported to
+// `visitor`.
+template<class Dijkstra, class Network, class Visitor = NullDijkstraVisitor>
 constexpr auto
 dijkstra_ssp(Dijkstra& dijkstra,
              const Network& network,
-             const typename Network::node_type& source)
+             const typename Network::node_type& source,
+             Visitor&& visitor = Visitor())
         -> std::optional<typename Network::node_type>
 {
     using Distance = typename Dijkstra::distance_type;
     WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+    WHIRLWIND_STATIC_ASSERT(
+            DijkstraVisitorType<std::remove_cvref_t<Visitor>, Dijkstra>);
 
     WHIRLWIND_ASSERT(network.contains_node(source));
     WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
@@ -33,47 +185,41 @@ dijkstra_ssp(Dijkstra& dijkstra,
     WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(source) == infinity<Distance>());
 
     dijkstra.add_source(source);
+    visitor.on_source(source);
     WHIRLWIND_DEBUG_ASSERT(!dijkstra.done());
     WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(source));
     WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(source) == zero<Distance>());
 
-    while (!dijkstra.done()) {
+    while (!detail::search_done(dijkstra, visitor)) {
         const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
         WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
         WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+        visitor.on_pop(tail, distance);
 
         dijkstra.visit_vertex(tail, distance);
         WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
         WHIRLWIND_DEBUG_ASSERT(dijkstra.distance_to_vertex(tail) == distance);
 
         if (network.is_deficit_node(tail)) {
+            visitor.on_sink_found(tail);
             return tail;
         }
 
-        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
-            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
-            WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
-
-            if (network.is_arc_saturated(arc)) {
-                continue;
-            }
-
-            const auto arc_length = network.arc_reduced_cost(arc, tail, head);
-            WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
-
-            dijkstra.relax_edge(arc, tail, head, distance + arc_length);
-            WHIRLWIND_DEBUG_ASSERT(dijkstra.has_reached_vertex(head));
-        }
+        detail::relax_outgoing_arcs(dijkstra, network, visitor, tail, distance);
     }
 
     return std::nullopt;
 }
 
+// Augment flow along the shortest path to the sink from the excess node that it was
+// reached from. The amount of flow is the min of the source's excess, the sink's
+// deficit, and the residual capacity of each arc along the path. Returns the amount of
+// flow that was added.
 template<class Network, class Dijkstra>
-constexpr void
+constexpr auto
 augment_flow_ssp(Network& network,
                  const Dijkstra& dijkstra,
-                 const typename Network::node_type& sink)
+                 const typename Network::node_type& sink) -> typename Network::flow_type
 {
     using Flow = typename Network::flow_type;
 
@@ -82,28 +228,36 @@ augment_flow_ssp(Network& network,
     WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
                      std::addressof(dijkstra.graph()));
 
-    constexpr auto delta = one<Flow>();
-
+    // Find the source node and the bottleneck capacity of the path.
     WHIRLWIND_ASSERT(network.is_deficit_node(sink));
-    network.increase_node_excess(sink, delta);
-    WHIRLWIND_ASSERT(!network.is_deficit_node(sink));
-
-    auto head = sink;
+    auto delta = static_cast<Flow>(-network.node_excess(sink));
+    auto source = sink;
     for (const auto& [tail, arc] : dijkstra.predecessors(sink)) {
         WHIRLWIND_DEBUG_ASSERT(network.contains_arc(arc));
         WHIRLWIND_DEBUG_ASSERT(network.contains_node(tail));
         WHIRLWIND_DEBUG_ASSERT(dijkstra.has_visited_vertex(tail));
 
+        delta = std::min(delta, network.arc_residual_capacity(arc));
+        source = tail;
+    }
+
+    WHIRLWIND_ASSERT(network.is_excess_node(source));
+    delta = std::min(delta, network.node_excess(source));
+    WHIRLWIND_ASSERT(delta > zero<Flow>());
+
+    network.increase_node_excess(sink, delta);
+    WHIRLWIND_DEBUG_ASSERT(!network.is_excess_node(sink));
+
+    for (const auto& [tail, arc] : dijkstra.predecessors(sink)) {
         WHIRLWIND_DEBUG_ASSERT(network.arc_residual_capacity(arc) >= delta);
         network.increase_arc_flow(arc, delta);
         WHIRLWIND_DEBUG_ASSERT(network.arc_flow(arc) > zero<Flow>());
-
-        head = tail;
     }
 
-    WHIRLWIND_ASSERT(network.is_excess_node(head));
-    network.decrease_node_excess(head, delta);
-    WHIRLWIND_ASSERT(!network.is_excess_node(head));
+    network.decrease_node_excess(source, delta);
+    WHIRLWIND_DEBUG_ASSERT(!network.is_deficit_node(source));
+
+    return delta;
 }
 
 template<class Network, class Dijkstra>
@@ -135,35 +289,253 @@ update_potential_ssp(Network& network,
     }
 }
 
-template<class Dijkstra, class Logger = NullLogger, class Network>
+// Find the shortest path w.r.t. the reduced arc costs from each node to the nearest
+// deficit node using Dijkstra's algorithm. The search runs backwards from the deficit
+// nodes, relaxing the incoming arcs of each visited node. The events of the search are
+// reported to `visitor`. Since the search runs backwards, the tail and head reported
+// for each relaxed arc are those of its transpose.
+template<class Dijkstra, class Network, class Visitor = NullDijkstraVisitor>
 constexpr void
-successive_shortest_paths(Network& network)
+dijkstra_to_deficits(Dijkstra& dijkstra,
+                     const Network& network,
+                     Visitor&& visitor = Visitor())
 {
-    auto logger = Logger("whirlwind.network.successive_shortest_paths");
+    using Arc = typename Network::arc_type;
+    using Distance = typename Dijkstra::distance_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+    WHIRLWIND_STATIC_ASSERT(
+            DijkstraVisitorType<std::remove_cvref_t<Visitor>, Dijkstra>);
 
-    WHIRLWIND_ASSERT(network.is_balanced());
+    WHIRLWIND_ASSERT(std::addressof(dijkstra.graph()) ==
+                     std::addressof(network.residual_graph()));
 
-    auto dijkstra = Dijkstra(network);
+    dijkstra.reset();
+    for (const auto& sink : network.deficit_nodes()) {
+        dijkstra.add_source(sink);
+        visitor.on_source(sink);
+    }
+
+    while (!detail::search_done(dijkstra, visitor)) {
+        const auto [head, distance] = dijkstra.pop_next_unvisited_vertex();
+        WHIRLWIND_DEBUG_ASSERT(network.contains_node(head));
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+        visitor.on_pop(head, distance);
+
+        dijkstra.visit_vertex(head, distance);
+
+        // The transpose of each outgoing arc is an incoming arc.
+        for (const auto& [arc, tail] : network.outgoing_arcs(head)) {
+            const auto transpose_arc =
+                    static_cast<Arc>(network.get_transpose_arc_id(arc));
+            WHIRLWIND_DEBUG_ASSERT(network.contains_arc(transpose_arc));
+
+            if (network.is_arc_saturated(transpose_arc)) {
+                continue;
+            }
+
+            const auto arc_length = network.arc_reduced_cost(transpose_arc, tail, head);
+            WHIRLWIND_ASSERT(arc_length >= zero<Distance>());
+
+            detail::relax_edge(dijkstra, visitor, arc, head, tail,
+                               distance + arc_length);
+        }
+    }
+}
+
+// Update the node potentials such that the reduced cost distance from each node to the
+// nearest deficit node (as found by `dijkstra_to_deficits()`) becomes zero. Nodes from
+// which no deficit node is reachable are unchanged.
+//
+// The reduced costs remain nonnegative. Subsequent searches by `dijkstra_ssp()` then
+// only visit nodes whose reduced cost distance increased since the update (e.g. due to
+// deficit nodes that were satisfied in the meantime), acting as a goal-directed search
+// with an exact heuristic.
+template<class Network, class Dijkstra>
+constexpr void
+update_potential_to_deficits(Network& network, const Dijkstra& dijkstra)
+{
+    using Distance = typename Dijkstra::distance_type;
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<Distance, typename Network::cost_type>);
+
+    WHIRLWIND_ASSERT(std::addressof(network.residual_graph()) ==
+                     std::addressof(dijkstra.graph()));
+
+    const auto visited_vertices = dijkstra.visited_vertices();
+    if (std::empty(visited_vertices)) {
+        return;
+    }
+
+    // Nodes are visited in order of increasing distance. Offsetting each potential by
+    // the max distance leaves the potentials of unvisited nodes unchanged.
+    const auto max_distance = dijkstra.distance_to_vertex(visited_vertices.back());
+    for (const auto& node : visited_vertices) {
+        const auto distance = dijkstra.distance_to_vertex(node);
+        WHIRLWIND_DEBUG_ASSERT(distance >= zero<Distance>());
+        WHIRLWIND_DEBUG_ASSERT(distance <= max_distance);
+        network.decrease_node_potential(node, max_distance - distance);
+    }
+}
+
+namespace detail {
+
+// Run the successive shortest paths algorithm using the specified solver. `sources` is
+// a scratch buffer whose contents are overwritten. Solver statistics are recorded in
+// `stats`.
+template<class Logger,
+         class Network,
+         class Dijkstra,
+         class SourceContainer,
+         class Stats>
+constexpr void
+successive_shortest_paths_iterations(Network& network,
+                                     Dijkstra& dijkstra,
+                                     SourceContainer& sources,
+                                     SuccessiveShortestPathsSearch search,
+                                     Logger& logger,
+                                     Stats& stats)
+{
     WHIRLWIND_DEBUG_ASSERT(dijkstra.done());
     WHIRLWIND_DEBUG_ASSERT(std::addressof(dijkstra.graph()) ==
                            std::addressof(network.residual_graph()));
 
-    const auto num_iter = network.total_excess();
-    using Iter = std::remove_const_t<decltype(num_iter)>;
+    // Augmentations remove their source from the set of excess nodes, so take a copy
+    // of the set rather than iterating over it directly. The sources are visited
+    // in order of increasing node index, since the order of the set is unspecified
+    // and the number of nodes visited by each search depends strongly on the order in
+    // which residues are resolved.
+    const auto& excess_nodes = network.excess_nodes();
+    sources.assign(std::begin(excess_nodes), std::end(excess_nodes));
+    ranges::sort(sources, {},
+                 [&](const auto& node) { return network.get_node_id(node); });
+
+    // Each iteration routes at least one unit of flow, so the total excess is an upper
+    // bound on the number of iterations.
+    const auto max_iter = network.total_excess();
+    using Iter = std::remove_const_t<decltype(max_iter)>;
     Iter iter = 1;
-    for (const auto& source : network.excess_nodes()) {
-        if (iter % 100 == 0) {
-            logger.info("Iteration {:>8}/{}", iter, num_iter);
-        }
 
-        const auto sink = dijkstra_ssp(dijkstra, network, source);
-        WHIRLWIND_ASSERT(sink);
+    // The number of nodes visited since the node potentials were last updated with the
+    // distance to the nearest deficit node.
+    const auto goal_directed = (search == SuccessiveShortestPathsSearch::goal_directed);
+    std::size_t num_visited = 0;
+
+    for (const auto& source : sources) {
+        // A source with more than one unit of excess may need multiple augmenting
+        // paths, e.g. if its excess exceeds the capacity of the shortest path or the
+        // demand of the nearest deficit node.
+        do {
+            // Stopping early leaves a feasible flow with some excess remaining.
+            if (stats.should_stop()) {
+                logger.info("Stopped early with {} excess remaining",
+                            network.total_excess());
+                return;
+            }
 
-        augment_flow_ssp(network, dijkstra, *sink);
-        update_potential_ssp(network, dijkstra, *sink);
+            if (iter % 100 == 0) {
+                logger.info("Iteration {:>8}/{}", iter, max_iter);
+            }
 
-        ++iter;
+            if (goal_directed && (num_visited >= network.num_nodes())) {
+                timed_phase(stats, SolverPhase::refresh_potential, [&] {
+                    dijkstra_to_deficits(dijkstra, network, stats);
+                    update_potential_to_deficits(network, dijkstra);
+                });
+                num_visited = 0;
+            }
+
+            const auto sink = timed_phase(stats, SolverPhase::search, [&] {
+                return dijkstra_ssp(dijkstra, network, source, stats);
+            });
+            WHIRLWIND_ASSERT(sink);
+            num_visited += std::size(dijkstra.visited_vertices());
+
+            timed_phase(stats, SolverPhase::augment,
+                        [&] { augment_flow_ssp(network, dijkstra, *sink); });
+            timed_phase(stats, SolverPhase::update_potential,
+                        [&] { update_potential_ssp(network, dijkstra, *sink); });
+
+            stats.add_iteration();
+            stats.set_excess_remaining(network.total_excess());
+            ++iter;
+        } while (network.is_excess_node(source));
     }
 }
 
+} // namespace detail
+
+/**
+ * Solve a minimum cost flow problem using the successive shortest paths algorithm.
+ *
+ * @tparam Dijkstra
+ *     The shortest path solver type.
+ * @tparam Logger
+ *     The logger type.
+ *
+ * @param[in,out] network
+ *     The network.
+ * @param[in] search
+ *     How augmenting paths are searched for. Defaults to a plain Dijkstra search from
+ *     each excess node; goal-directed search must be requested explicitly.
+ * @param[in,out] stats
+ *     A solver statistics policy in which to record statistics about the solve (e.g.
+ *     `SolverStats`). Defaults to `NullSolverStats`, which records nothing.
+ */
+template<class Dijkstra,
+         class Logger = NullLogger,
+         class Network,
+         class Stats = NullSolverStats>
+constexpr void
+successive_shortest_paths(Network& network,
+                          SuccessiveShortestPathsSearch search =
+                                  SuccessiveShortestPathsSearch::dijkstra,
+                          Stats&& stats = Stats())
+{
+    auto logger = Logger("whirlwind.network.successive_shortest_paths");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    auto dijkstra = Dijkstra(network);
+    auto sources = Vector<typename Network::node_type>();
+    detail::successive_shortest_paths_iterations(network, dijkstra, sources, search,
+                                                 logger, stats);
+}
+
+/**
+ * Solve a minimum cost flow problem using the successive shortest paths algorithm,
+ * reusing the solver state owned by a `SolverWorkspace`.
+ *
+ * Equivalent to `successive_shortest_paths<Dijkstra>(network, search)`, where
+ * `Dijkstra` is the workspace's solver type, except that the shortest path solver and
+ * scratch buffer are taken from the workspace rather than allocated.
+ *
+ * @param[in,out] network
+ *     The network.
+ * @param[in,out] workspace
+ *     The solver workspace.
+ * @param[in] search
+ *     How augmenting paths are searched for.
+ * @param[in,out] stats
+ *     A solver statistics policy in which to record statistics about the solve.
+ */
+template<class Logger = NullLogger,
+         class Network,
+         SolverWorkspaceType Workspace,
+         class Stats = NullSolverStats>
+constexpr void
+successive_shortest_paths(Network& network,
+                          Workspace& workspace,
+                          SuccessiveShortestPathsSearch search =
+                                  SuccessiveShortestPathsSearch::dijkstra,
+                          Stats&& stats = Stats())
+{
+    auto logger = Logger("whirlwind.network.successive_shortest_paths");
+
+    WHIRLWIND_ASSERT(network.is_balanced());
+
+    auto& dijkstra = workspace.dijkstra(network);
+    auto& sources = workspace.node_buffer();
+    detail::successive_shortest_paths_iterations(network, dijkstra, sources, search,
+                                                 logger, stats);
+}
+
 WHIRLWIND_NAMESPACE_END
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <utility>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
 #include <whirlwind/math/numbers.hpp>
@@ -28,7 +30,7 @@ public:
     using container_type = Container<T>;
 
     using super_type::contains_arc;
-    using super_type::get_arc_id;
+    using super_type::get_edge_id;
     using super_type::get_transpose_arc_id;
     using super_type::is_forward_arc;
     using super_type::num_forward_arcs;
@@ -69,9 +71,9 @@ public:
             return infinity<flow_type>();
         }
 
-        const auto arc_id = get_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_flow_));
-        return arc_flow_[arc_id];
+        const auto edge_id = get_edge_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(arc_flow_));
+        return arc_flow_[edge_id];
     }
 
     /**
@@ -93,9 +95,10 @@ public:
             return infinity<flow_type>();
         }
 
-        const auto transpose_arc_id = get_transpose_arc_id(arc);
-        WHIRLWIND_DEBUG_ASSERT(transpose_arc_id < std::size(arc_flow_));
-        return arc_flow_[transpose_arc_id];
+        const auto forward_arc = static_cast<arc_type>(get_transpose_arc_id(arc));
+        const auto edge_id = get_edge_id(forward_arc);
+        WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(arc_flow_));
+        return arc_flow_[edge_id];
     }
 
     /**
@@ -115,7 +118,7 @@ public:
         if (is_forward_arc(arc)) {
             return false;
         }
-        return arc_residual_capacity(arc) > zero<flow_type>();
+        return arc_residual_capacity(arc) == zero<flow_type>();
     }
 
     /**
@@ -138,16 +141,46 @@ public:
         WHIRLWIND_ASSERT(arc_residual_capacity(arc) >= delta);
 
         if (is_forward_arc(arc)) {
-            const auto arc_id = get_arc_id(arc);
-            WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(arc_flow_));
-            arc_flow_[arc_id] += delta;
+            const auto edge_id = get_edge_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(arc_flow_));
+            arc_flow_[edge_id] += delta;
         } else {
-            const auto transpose_arc_id = get_transpose_arc_id(arc);
-            WHIRLWIND_DEBUG_ASSERT(transpose_arc_id < std::size(arc_flow_));
-            arc_flow_[transpose_arc_id] -= delta;
+            const auto forward_arc = static_cast<arc_type>(get_transpose_arc_id(arc));
+            const auto edge_id = get_edge_id(forward_arc);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(arc_flow_));
+            arc_flow_[edge_id] -= delta;
         }
     }
 
+    /**
+     * The number of bytes of memory owned by the network's residual graph and arc
+     * flows (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> std::size_t
+    {
+        return super_type::memory_usage() + get_memory_usage(arc_flow_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store the residual graph and
+     * arc flows of a network.
+     *
+     * @param[in] original_graph
+     *     The network's original graph.
+     *
+     * @returns
+     *     The estimated size of the residual graph and arc flows.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const typename super_type::graph_type& original_graph)
+            -> std::size_t
+    {
+        const auto num_edges = static_cast<std::size_t>(original_graph.num_edges());
+        return super_type::estimate_memory(original_graph) +
+               estimate_array_memory<flow_type, Container>(num_edges);
+    }
+
 protected:
     template<class... Args>
     constexpr UncapacitatedMixin(Args&&... args)
@@ -158,6 +191,8 @@ protected:
     }
 
 private:
+    // The flow in each forward arc, indexed by the corresponding edge in the original
+    // graph.
     container_type<flow_type> arc_flow_;
 };
 
@@ -1,13 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/transform.hpp>
-
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/memory_usage.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
 #include <whirlwind/math/numbers.hpp>
@@ -136,17 +135,46 @@ public:
         is_arc_saturated_[transpose_arc_id] = false;
     }
 
+    /**
+     * The number of bytes of memory owned by the network's residual graph and arc
+     * saturation flags (see `get_memory_usage()`).
+     */
+    [[nodiscard]] constexpr auto
+    memory_usage() const -> std::size_t
+    {
+        return super_type::memory_usage() + get_memory_usage(is_arc_saturated_);
+    }
+
+    /**
+     * Estimate the number of bytes of memory needed to store the residual graph and
+     * arc saturation flags of a network.
+     *
+     * @param[in] original_graph
+     *     The network's original graph.
+     *
+     * @returns
+     *     The estimated size of the residual graph and arc saturation flags.
+     */
+    [[nodiscard]] static constexpr auto
+    estimate_memory(const typename super_type::graph_type& original_graph)
+            -> std::size_t
+    {
+        const auto num_arcs = 2 * static_cast<std::size_t>(original_graph.num_edges());
+        return super_type::estimate_memory(original_graph) +
+               estimate_array_memory<bool, Container>(num_arcs);
+    }
+
 protected:
     template<class... Args>
     constexpr UnitCapacityMixin(Args&&... args)
-        : super_type(std::forward<Args>(args)...), is_arc_saturated_([&]() {
-              return arcs() | ranges::views::transform([&](const auto& arc) {
-                         return !this->is_forward_arc(arc);
-                     }) |
-                     ranges::to<container_type<bool>>();
-          }())
+        : super_type(std::forward<Args>(args)...), is_arc_saturated_(num_arcs(), false)
     {
-        WHIRLWIND_DEBUG_ASSERT(std::size(is_arc_saturated_) == num_arcs());
+        // Reverse arcs are initially saturated.
+        for (const auto& arc : arcs()) {
+            const auto arc_id = get_arc_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(arc_id < std::size(is_arc_saturated_));
+            is_arc_saturated_[arc_id] = !this->is_forward_arc(arc);
+        }
     }
 
 private:
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/ring_queue.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Update the node potentials such that the reduced cost of each unsaturated forward
+// arc is nonnegative.
+//
+// Each node's potential is offset by its (nonpositive) shortest reduced cost distance
+// to any other node along unsaturated forward arcs, found by a label-correcting search
+// backwards along each arc. Forward arc costs are nonnegative, so there are no
+// negative cycles and the search terminates.
+template<template<class> class Container = Vector, class Network>
+constexpr void
+repair_forward_arc_potentials(Network& network)
+{
+    using Node = typename Network::node_type;
+    using Arc = typename Network::arc_type;
+    using Cost = typename Network::cost_type;
+
+    const auto num_nodes = network.num_nodes();
+    auto distance = Container<Cost>(num_nodes, zero<Cost>());
+    auto queued = Container<unsigned char>(num_nodes, 0);
+    auto queue = RingQueue<Node, Container>();
+
+    const auto relax = [&](const auto& tail, const auto& length) {
+        const auto tail_id = network.get_node_id(tail);
+        WHIRLWIND_DEBUG_ASSERT(tail_id < std::size(distance));
+        if (length < distance[tail_id]) {
+            distance[tail_id] = length;
+            if (queued[tail_id] == 0) {
+                queued[tail_id] = 1;
+                queue.push(tail);
+            }
+        }
+    };
+
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            if (network.is_forward_arc(arc) && !network.is_arc_saturated(arc)) {
+                relax(tail, network.arc_reduced_cost(arc, tail, head));
+            }
+        }
+    }
+
+    while (!queue.empty()) {
+        const auto head = queue.front();
+        queue.pop();
+        const auto head_id = network.get_node_id(head);
+        queued[head_id] = 0;
+
+        // The transpose of each outgoing arc is an incoming arc.
+        for (const auto& [arc, tail] : network.outgoing_arcs(head)) {
+            const auto transpose_arc =
+                    static_cast<Arc>(network.get_transpose_arc_id(arc));
+            if (network.is_forward_arc(transpose_arc) &&
+                !network.is_arc_saturated(transpose_arc)) {
+                relax(tail, network.arc_reduced_cost(transpose_arc, tail, head) +
+                                    distance[head_id]);
+            }
+        }
+    }
+
+    for (const auto& node : network.nodes()) {
+        const auto node_id = network.get_node_id(node);
+        if (distance[node_id] < zero<Cost>()) {
+            network.decrease_node_potential(node, -distance[node_id]);
+        }
+    }
+}
+
+// Saturate each unsaturated reverse arc with negative reduced cost, i.e. cancel the
+// flow in each forward arc whose reduced cost is positive. Reverse arc capacities are
+// bounded by the flow in the corresponding forward arc, so this is always possible.
+template<class Network>
+constexpr void
+cancel_positive_reduced_cost_flows(Network& network)
+{
+    using Cost = typename Network::cost_type;
+
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            if (network.is_forward_arc(arc) || network.is_arc_saturated(arc) ||
+                (network.arc_reduced_cost(arc, tail, head) >= zero<Cost>())) {
+                continue;
+            }
+
+            const auto delta = network.arc_residual_capacity(arc);
+            network.increase_arc_flow(arc, delta);
+            network.decrease_node_excess(tail, delta);
+            network.increase_node_excess(head, delta);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Seed a network with the flows and node potentials of a previous solution.
+ *
+ * This is intended for solving a sequence of similar problems on the same graph (e.g.
+ * a time series of interferograms with similar residues and costs). The previous
+ * flows are added to the network, moving the network's node excesses accordingly, and
+ * the node potentials are replaced with the previous potentials. Reduced cost
+ * optimality is then restored for any arcs whose costs changed: node potentials are
+ * lowered until every unsaturated forward arc has nonnegative reduced cost, and the
+ * flow in any forward arc with positive reduced cost is cancelled.
+ *
+ * Afterwards, every unsaturated arc has nonnegative reduced cost, as required by
+ * `successive_shortest_paths()` and `primal_dual()`, which then only need to route the
+ * remaining excess -- typically the change in node surplus between the two problems
+ * plus any cancelled flow.
+ *
+ * @param[in,out] network
+ *     The network. Must not carry any flow (e.g. a newly-constructed network).
+ * @param[in] edge_flow
+ *     The flow in each forward arc, indexed by the corresponding edge in the original
+ *     graph. Each flow must be nonnegative and no greater than the arc's capacity.
+ * @param[in] node_potential
+ *     The potential of each node, indexed by node ID.
+ */
+template<class Network, class FlowRange, class PotentialRange>
+constexpr void
+warm_start(Network& network,
+           const FlowRange& edge_flow,
+           const PotentialRange& node_potential)
+{
+    using Flow = typename Network::flow_type;
+
+    WHIRLWIND_ASSERT(std::size(edge_flow) == network.num_forward_arcs());
+    WHIRLWIND_ASSERT(std::size(node_potential) == network.num_nodes());
+
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            if (!network.is_forward_arc(arc)) {
+                continue;
+            }
+
+            const auto edge_id = network.get_edge_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(edge_flow));
+            const auto flow = static_cast<Flow>(edge_flow[edge_id]);
+            WHIRLWIND_ASSERT(flow >= zero<Flow>());
+            WHIRLWIND_ASSERT(network.arc_flow(arc) == zero<Flow>());
+            if (flow == zero<Flow>()) {
+                continue;
+            }
+
+            network.increase_arc_flow(arc, flow);
+            network.decrease_node_excess(tail, flow);
+            network.increase_node_excess(head, flow);
+        }
+    }
+
+    for (const auto& node : network.nodes()) {
+        const auto node_id = network.get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_potential));
+        network.increase_node_potential(
+                node, node_potential[node_id] - network.node_potential(node));
+    }
+
+    detail::repair_forward_arc_potentials(network);
+    detail::cancel_positive_reduced_cost_flows(network);
+}
+
+/**
+ * Seed a network with the flows and node potentials of a previously solved network on
+ * the same graph. See `warm_start(network, edge_flow, node_potential)`.
+ *
+ * @param[in,out] network
+ *     The network. Must not carry any flow (e.g. a newly-constructed network).
+ * @param[in] prior
+ *     The previously solved network. Its original graph must be the same as that of
+ *     `network`, though its node surpluses and arc costs may differ.
+ */
+template<class Network, class PriorNetwork>
+constexpr void
+warm_start(Network& network, const PriorNetwork& prior)
+{
+    using Flow = typename Network::flow_type;
+    using Cost = typename Network::cost_type;
+
+    WHIRLWIND_ASSERT(prior.num_nodes() == network.num_nodes());
+    WHIRLWIND_ASSERT(prior.num_forward_arcs() == network.num_forward_arcs());
+
+    auto edge_flow = Vector<Flow>(prior.num_forward_arcs(), zero<Flow>());
+    for (const auto& arc : prior.forward_arcs()) {
+        const auto edge_id = prior.get_edge_id(arc);
+        WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(edge_flow));
+        edge_flow[edge_id] = static_cast<Flow>(prior.arc_flow(arc));
+    }
+
+    auto node_potential = Vector<Cost>(prior.num_nodes(), zero<Cost>());
+    for (const auto& node : prior.nodes()) {
+        const auto node_id = prior.get_node_id(node);
+        WHIRLWIND_DEBUG_ASSERT(node_id < std::size(node_potential));
+        node_potential[node_id] = static_cast<Cost>(prior.node_potential(node));
+    }
+
+    warm_start(network, edge_flow, node_potential);
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 #include <range/v3/range/conversion.hpp>
@@ -13,6 +18,7 @@
 #include <whirlwind/ndarray/ndarray.hpp>
 
 #include "cubic_b_spline_basis.hpp"
+#include "cubic_b_spline_interpolation.hpp"
 
 WHIRLWIND_NAMESPACE_BEGIN
 
@@ -47,6 +53,36 @@ public:
           }())
     {}
 
+    /**
+     * Create a new `CubicBSpline` that interpolates the given values at each knot.
+     *
+     * The control points are those of the natural cubic spline (whose second
+     * derivative is zero at the first and last knots) that passes through each value.
+     * They are found by solving a banded linear system in O(n) time.
+     *
+     * @param[in] basis
+     *     The spline basis.
+     * @param[in] values
+     *     The value of the spline at each of the n knots of the basis.
+     */
+    template<class InputRange>
+    constexpr CubicBSpline(InterpolateKnots, basis_type basis, const InputRange& values)
+        : basis_(std::move(basis)), control_points_([&]() {
+              const auto n = std::size(basis_.knots());
+              WHIRLWIND_ASSERT(std::size(values) == n);
+
+              auto c = container_type<value_type>(n + 2);
+              std::copy(std::begin(values), std::end(values), std::begin(c));
+
+              const auto interpolator =
+                      detail::CubicBSplineInterpolator<knot_type, Container>(basis_);
+              interpolator.solve([&](size_type k) -> auto& { return c[k]; });
+
+              const auto ext = DynamicExtents1D(n + 2);
+              return control_points_type(std::move(c), ext);
+          }())
+    {}
+
     [[nodiscard]] constexpr auto
     operator()(const knot_type& x) const -> value_type
     {
@@ -58,14 +94,79 @@ public:
         return (c(0) * b[0] + c(1) * b[1]) + (c(2) * b[2] + c(3) * b[3]);
     }
 
+    /**
+     * Evaluate the spline at each of an array of points.
+     *
+     * The points are processed in blocks of `BlockSize`. The knot interval of each
+     * point in a block is found first, and then the basis functions are evaluated for
+     * the whole block at once by loops that compilers can vectorize. No memory is
+     * allocated. The points may be in any order, but knot intervals are found fastest
+     * if they are sorted.
+     *
+     * @tparam BlockSize
+     *     The number of points evaluated together, e.g. a small multiple of the SIMD
+     *     vector width. Typically between 4 and 16.
+     *
+     * @param[in] x
+     *     The points.
+     * @param[out] out
+     *     The value of the spline at each point. Must have the same size as `x`.
+     */
+    template<std::size_t BlockSize = 8>
+    constexpr void
+    operator()(std::span<const knot_type> x, std::span<value_type> out) const
+    {
+        WHIRLWIND_STATIC_ASSERT(BlockSize >= 1);
+        WHIRLWIND_ASSERT(std::size(out) == std::size(x));
+
+        // Each knot interval search starts from that of the previous point, so sorted
+        // points take amortized O(1) time each to locate.
+        auto cursor = KnotIntervalCursor<basis_type>(basis_);
+
+        const auto n = std::size(x);
+        for (size_type first = 0; first < n; first += BlockSize) {
+            // A partial block is padded by repeating its last point.
+            const auto count = std::min(BlockSize, n - first);
+            auto xx = std::array<knot_type, BlockSize>();
+            auto i = std::array<size_type, BlockSize>();
+            for (size_type k = 0; k < count; ++k) {
+                xx[k] = x[first + k];
+                i[k] = cursor(xx[k]);
+            }
+            for (auto k = count; k < BlockSize; ++k) {
+                xx[k] = xx[count - 1];
+                i[k] = i[count - 1];
+            }
+
+            const auto b = basis_.eval_in_intervals(xx, i);
+            for (size_type k = 0; k < count; ++k) {
+                auto c = [&](size_type ii) noexcept {
+                    return control_points_[i[k] + ii];
+                };
+                out[first + k] = (c(0) * b[0][k] + c(1) * b[1][k]) +
+                                 (c(2) * b[2][k] + c(3) * b[3][k]);
+            }
+        }
+    }
+
     template<class InputRange>
     [[nodiscard]] constexpr auto
     operator()(const InputRange& x) const -> container_type<value_type>
     {
-        return x | ranges::views::transform([&](const auto& xx) {
-                   return operator()(xx);
-               }) |
-               ranges::to<container_type<value_type>>();
+        using T = std::remove_cvref_t<std::ranges::range_value_t<InputRange>>;
+        if constexpr (std::ranges::contiguous_range<const InputRange> &&
+                      std::ranges::sized_range<const InputRange> &&
+                      std::is_same_v<T, knot_type> &&
+                      std::ranges::contiguous_range<container_type<value_type>>) {
+            auto out = container_type<value_type>(std::size(x));
+            operator()(std::span<const knot_type>(x), std::span<value_type>(out));
+            return out;
+        } else {
+            return x | ranges::views::transform([&](const auto& xx) {
+                       return operator()(xx);
+                   }) |
+                   ranges::to<container_type<value_type>>();
+        }
     }
 
     [[nodiscard]] static WHIRLWIND_CONSTEVAL auto
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -46,6 +47,72 @@ is_contiguous_range(const Vector<T>&) noexcept -> bool
     return true;
 }
 
+namespace detail {
+
+// Find the index of the first element of a sorted span that is not less than `x`,
+// i.e. the result of `std::lower_bound()`, by exponential search outward from the index
+// `hint`. This takes O(log(d)) comparisons, where d is the distance from `hint` to the
+// result, so a sequence of monotonic queries that each start from the previous result
+// takes amortized O(1) comparisons per query.
+template<class T>
+[[nodiscard]] constexpr auto
+gallop_lower_bound(std::span<const T> s, const T& x, std::size_t hint) -> std::size_t
+{
+    const auto n = std::size(s);
+    hint = std::min(hint, n);
+
+    // Bracket the result within [lo, hi].
+    std::size_t lo = hint;
+    std::size_t hi = hint;
+    if (hint < n && s[hint] < x) {
+        lo = hint + 1;
+        hi = lo;
+        for (std::size_t step = 1; hi < n && s[hi] < x; step *= 2) {
+            lo = hi + 1;
+            hi += step;
+        }
+        hi = std::min(hi, n);
+    } else {
+        for (std::size_t step = 1; lo > 0 && !(s[lo - 1] < x); step *= 2) {
+            hi = lo - 1;
+            lo = (hi >= step) ? hi - step : 0;
+        }
+    }
+
+    const auto first = std::begin(s);
+    const auto it = std::lower_bound(first + static_cast<std::ptrdiff_t>(lo),
+                                     first + static_cast<std::ptrdiff_t>(hi), x);
+    return static_cast<std::size_t>(it - first);
+}
+
+// Evaluate the four cubic B-spline basis functions that are nonzero at `x`, given the
+// six augmented knots `t` surrounding its knot interval and the precomputed de Boor
+// coefficients `c` of the interval.
+template<class Knot>
+[[nodiscard]] constexpr auto
+eval_cubic_b_spline_basis(const Knot& x,
+                          const std::array<Knot, 6>& t,
+                          const std::array<Knot, 4>& c) noexcept -> std::array<Knot, 4>
+{
+    const auto dt5x = t[5] - x;
+    const auto dt4x = t[4] - x;
+    const auto dt3x = t[3] - x;
+    const auto dxt2 = x - t[2];
+    const auto dxt1 = x - t[1];
+    const auto dxt0 = x - t[0];
+
+    const auto y3 = c[0] * (dxt2 * dxt2 * dxt2);
+    const auto y2 = c[0] * (dt5x * dxt2 * dxt2) + c[1] * (dxt1 * dxt1 * dt3x) +
+                    c[2] * (dxt1 * dt4x * dxt2);
+    const auto y1 = c[1] * (dt4x * dxt1 * dt3x) + c[2] * (dt4x * dt4x * dxt2) +
+                    c[3] * (dxt0 * dt3x * dt3x);
+    const auto y0 = c[3] * (dt3x * dt3x * dt3x);
+
+    return std::array{y0, y1, y2, y3};
+}
+
+} // namespace detail
+
 template<class Knot, template<class> class Container = Vector>
 class CubicBSplineBasis {
 protected:
@@ -175,7 +242,42 @@ public:
         const auto subspan = std::span(first, count);
 
         const auto it = ranges::lower_bound(subspan, x);
-        const auto i = size_type{std::distance(first, std::to_address(it))};
+        const auto d = std::distance(first, std::to_address(it));
+        const auto i = static_cast<size_type>(d);
+        WHIRLWIND_DEBUG_ASSERT(i < num_knot_intervals());
+        return i;
+    }
+
+    /**
+     * Get the index of the knot interval containing a point, searching outward from a
+     * nearby interval.
+     *
+     * The result is the same as that of `get_knot_interval(x)`, but the search takes
+     * O(log(d)) time, where d is the number of intervals between `hint` and the result,
+     * rather than O(log(n)). This makes a sequence of sorted queries, each starting
+     * from the previous result, take amortized O(1) time per query. See also
+     * `KnotIntervalCursor`.
+     *
+     * @param[in] x
+     *     The point.
+     * @param[in] hint
+     *     The index of a knot interval near `x`, e.g. that of the previous query.
+     *
+     * @returns
+     *     The index of the knot interval containing `x`.
+     */
+    [[nodiscard]] constexpr auto
+    get_knot_interval(const knot_type& x, size_type hint) const -> size_type
+    {
+        WHIRLWIND_ASSERT(!std::isnan(x));
+        WHIRLWIND_ASSERT(is_contiguous_range(augmented_knots_));
+
+        WHIRLWIND_DEBUG_ASSERT(std::size(augmented_knots_) >= 6);
+        const auto first = std::to_address(ranges::begin(augmented_knots_) + 3);
+        const auto count = std::size(augmented_knots_) - 6;
+        const auto subspan = std::span<const knot_type>(first, count);
+
+        const auto i = detail::gallop_lower_bound(subspan, x, hint);
         WHIRLWIND_DEBUG_ASSERT(i < num_knot_intervals());
         return i;
     }
@@ -192,33 +294,72 @@ public:
         const auto c2 = de_boor_coeffs_(i, 2);
         const auto c3 = de_boor_coeffs_(i, 3);
 
-        WHIRLWIND_DEBUG_ASSERT(i + 5 < std::size(augmented_knots_));
-        const auto dt5x = augmented_knots_[i + 5] - x;
-        const auto dt4x = augmented_knots_[i + 4] - x;
-        const auto dt3x = augmented_knots_[i + 3] - x;
-        WHIRLWIND_DEBUG_ASSERT(dt5x >= 0);
-        WHIRLWIND_DEBUG_ASSERT(dt4x >= 0);
-        WHIRLWIND_DEBUG_ASSERT(dt3x >= 0);
+        const auto t = get_interval_knots(i);
+        WHIRLWIND_DEBUG_ASSERT(x >= t[2]);
+        WHIRLWIND_DEBUG_ASSERT(x <= t[3]);
 
-        const auto dxt2 = x - augmented_knots_[i + 2];
-        const auto dxt1 = x - augmented_knots_[i + 1];
-        const auto dxt0 = x - augmented_knots_[i];
-        WHIRLWIND_DEBUG_ASSERT(dxt2 >= 0);
-        WHIRLWIND_DEBUG_ASSERT(dxt1 >= 0);
-        WHIRLWIND_DEBUG_ASSERT(dxt0 >= 0);
+        const auto c = std::array{c0, c1, c2, c3};
+        const auto y = detail::eval_cubic_b_spline_basis(x, t, c);
+        WHIRLWIND_DEBUG_ASSERT(y[0] >= 0);
+        WHIRLWIND_DEBUG_ASSERT(y[1] >= 0);
+        WHIRLWIND_DEBUG_ASSERT(y[2] >= 0);
+        WHIRLWIND_DEBUG_ASSERT(y[3] >= 0);
 
-        const auto y3 = c0 * (dxt2 * dxt2 * dxt2);
-        const auto y2 = c0 * (dt5x * dxt2 * dxt2) + c1 * (dxt1 * dxt1 * dt3x) +
-                        c2 * (dxt1 * dt4x * dxt2);
-        const auto y1 = c1 * (dt4x * dxt1 * dt3x) + c2 * (dt4x * dt4x * dxt2) +
-                        c3 * (dxt0 * dt3x * dt3x);
-        const auto y0 = c3 * (dt3x * dt3x * dt3x);
-        WHIRLWIND_DEBUG_ASSERT(y0 >= 0);
-        WHIRLWIND_DEBUG_ASSERT(y1 >= 0);
-        WHIRLWIND_DEBUG_ASSERT(y2 >= 0);
-        WHIRLWIND_DEBUG_ASSERT(y3 >= 0);
+        return y;
+    }
 
-        return std::array{y0, y1, y2, y3};
+    /**
+     * Evaluate the nonzero basis functions at each of a block of points.
+     *
+     * This is equivalent to calling `eval_in_interval()` for each point. However, the
+     * knots and coefficients of each point's knot interval are first gathered into
+     * contiguous arrays, so that the basis functions are evaluated by a loop over the
+     * block that compilers can vectorize.
+     *
+     * @tparam N
+     *     The number of points in the block.
+     *
+     * @param[in] x
+     *     The points.
+     * @param[in] i
+     *     The knot interval containing each point.
+     *
+     * @returns
+     *     The values of the four nonzero basis functions (in order) at each point,
+     *     indexed by basis function and then by point.
+     */
+    template<std::size_t N>
+    [[nodiscard]] constexpr auto
+    eval_in_intervals(const std::array<knot_type, N>& x,
+                      const std::array<size_type, N>& i) const
+            -> std::array<std::array<knot_type, N>, 4>
+    {
+        auto t = std::array<std::array<knot_type, N>, 6>();
+        auto c = std::array<std::array<knot_type, N>, 4>();
+        for (size_type k = 0; k < N; ++k) {
+            WHIRLWIND_ASSERT(i[k] < num_knot_intervals());
+            WHIRLWIND_DEBUG_ASSERT(i[k] + 5 < std::size(augmented_knots_));
+            for (size_type j = 0; j < 6; ++j) {
+                t[j][k] = augmented_knots_[i[k] + j];
+            }
+            for (size_type j = 0; j < 4; ++j) {
+                c[j][k] = de_boor_coeffs_(i[k], j);
+            }
+        }
+
+        auto y = std::array<std::array<knot_type, N>, 4>();
+        for (size_type k = 0; k < N; ++k) {
+            WHIRLWIND_DEBUG_ASSERT(x[k] >= t[2][k]);
+            WHIRLWIND_DEBUG_ASSERT(x[k] <= t[3][k]);
+            const auto b = detail::eval_cubic_b_spline_basis(
+                    x[k], {t[0][k], t[1][k], t[2][k], t[3][k], t[4][k], t[5][k]},
+                    {c[0][k], c[1][k], c[2][k], c[3][k]});
+            for (size_type j = 0; j < 4; ++j) {
+                y[j][k] = b[j];
+            }
+        }
+
+        return y;
     }
 
     [[nodiscard]] constexpr auto
@@ -300,8 +441,104 @@ public:
     }
 
 private:
+    // Get the six augmented knots surrounding the `i`-th knot interval.
+    [[nodiscard]] constexpr auto
+    get_interval_knots(size_type i) const -> std::array<knot_type, 6>
+    {
+        WHIRLWIND_DEBUG_ASSERT(i + 5 < std::size(augmented_knots_));
+        return {augmented_knots_[i],     augmented_knots_[i + 1],
+                augmented_knots_[i + 2], augmented_knots_[i + 3],
+                augmented_knots_[i + 4], augmented_knots_[i + 5]};
+    }
+
     container_type<knot_type> augmented_knots_;
     NDArray<knot_type, Extents<dynamic, 4>, container_type<knot_type>> de_boor_coeffs_;
 };
 
+/**
+ * A cursor that finds the knot interval of each of a sequence of points by searching
+ * outward from the interval of the previous point.
+ *
+ * Queries may be made in any order, but if they are sorted (as is typical when a spline
+ * is evaluated along a line) each takes amortized O(1) time rather than O(log(n)).
+ *
+ * @tparam Basis
+ *     The spline basis type. Must provide `get_knot_interval(x, hint)`.
+ */
+template<class Basis>
+class KnotIntervalCursor {
+public:
+    using basis_type = Basis;
+    using knot_type = typename Basis::knot_type;
+    using size_type = typename Basis::size_type;
+
+    /**
+     * Create a new `KnotIntervalCursor` positioned at the first knot interval.
+     *
+     * @param[in] basis
+     *     The spline basis. Must outlive the cursor.
+     */
+    explicit constexpr KnotIntervalCursor(const Basis& basis) noexcept
+        : basis_(&basis)
+    {}
+
+    /**
+     * Get the index of the knot interval containing a point and move the cursor to it.
+     *
+     * @param[in] x
+     *     The point.
+     *
+     * @returns
+     *     The index of the knot interval containing `x`.
+     */
+    [[nodiscard]] constexpr auto
+    operator()(const knot_type& x) -> size_type
+    {
+        interval_ = basis_->get_knot_interval(x, interval_);
+        return interval_;
+    }
+
+    /** The index of the knot interval at the current cursor position. */
+    [[nodiscard]] constexpr auto
+    interval() const noexcept -> size_type
+    {
+        return interval_;
+    }
+
+private:
+    const basis_type* basis_;
+    size_type interval_ = 0;
+};
+
+namespace detail {
+
+// The knot interval of each of a sequence of points along one axis of a tensor-product
+// spline, and the values of the four nonzero basis functions at each point.
+template<class Knot, template<class> class Container>
+struct AxisBasisWeights {
+    Container<std::size_t> interval;
+    Container<std::array<Knot, 4>> weights;
+};
+
+// Evaluate the nonzero basis functions at each of a sequence of points along one axis.
+template<template<class> class Container, class Basis, class InputRange>
+[[nodiscard]] auto
+get_axis_basis_weights(const Basis& basis, const InputRange& x)
+        -> AxisBasisWeights<typename Basis::knot_type, Container>
+{
+    auto out = AxisBasisWeights<typename Basis::knot_type, Container>();
+    out.interval.reserve(std::size(x));
+    out.weights.reserve(std::size(x));
+
+    auto cursor = KnotIntervalCursor(basis);
+    for (const auto& xx : x) {
+        const auto i = cursor(xx);
+        out.interval.push_back(i);
+        out.weights.push_back(basis.eval_in_interval(xx, i));
+    }
+    return out;
+}
+
+} // namespace detail
+
 WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A tag type used to select the constructors of `CubicBSpline`, `CubicBSpline2D`, and
+ * `CubicBSpline3D` that fit the control points of a spline to sampled values.
+ */
+struct InterpolateKnots {
+    explicit InterpolateKnots() = default;
+};
+
+/** A tag used to select the interpolating constructors of the cubic B-spline types. */
+inline constexpr auto interpolate_knots = InterpolateKnots();
+
+namespace detail {
+
+// A solver for the control points of the natural cubic spline (with zero second
+// derivative at the first and last knots) that interpolates given values at each knot
+// of a cubic B-spline basis.
+//
+// For a basis with n knots, the n + 2 control points satisfy n interpolation equations,
+// each involving the three basis functions that are nonzero at a knot, plus the two
+// boundary conditions. With the equations ordered
+//
+//   [interp(0), bc(0), interp(1), ..., interp(n-1), bc(n-1)]
+//
+// the system matrix is pentadiagonal and is factored once by banded Gaussian
+// elimination without pivoting in O(n) time. Each right-hand side is then solved in
+// O(n) time, so that many lines of a tensor-product spline may share the factorization.
+template<class Knot, template<class> class Container = Vector>
+class CubicBSplineInterpolator {
+public:
+    using knot_type = Knot;
+    using size_type = std::size_t;
+
+    template<class Basis>
+    explicit CubicBSplineInterpolator(const Basis& basis)
+        : lu_(basis.num_basis_funcs(), 2 * bandwidth + 1)
+    {
+        const auto knots = basis.knots();
+        const auto n = std::size(knots);
+        WHIRLWIND_ASSERT(n >= 2);
+        WHIRLWIND_ASSERT(basis.num_basis_funcs() == n + 2);
+
+        for (size_type r = 0; r < size(); ++r) {
+            for (size_type d = 0; d < 2 * bandwidth + 1; ++d) {
+                lu_(r, d) = knot_type{0};
+            }
+        }
+
+        // Set the weights of the four basis functions that are nonzero in the `i`-th
+        // knot interval in row `r`. Weights outside the band are zero (up to rounding),
+        // since each equation is evaluated at an end of a knot interval.
+        const auto set_row = [&](size_type r, size_type i, const auto& w) {
+            for (size_type k = 0; k < 4; ++k) {
+                if (in_band(r, i + k)) {
+                    at(r, i + k) = w[k];
+                }
+            }
+        };
+
+        const auto last = n - 2;
+        set_row(0, 0, basis.eval_in_interval(knots[0], 0));
+        set_row(1, 0, basis.eval_second_derivative_in_interval(knots[0], 0));
+        for (size_type k = 1; k < n; ++k) {
+            const auto i = std::min(k, last);
+            set_row(k + 1, i, basis.eval_in_interval(knots[k], i));
+        }
+        set_row(n + 1, last,
+                basis.eval_second_derivative_in_interval(knots[n - 1], last));
+
+        factor();
+    }
+
+    // The number of control points (and equations).
+    [[nodiscard]] auto
+    size() const noexcept -> size_type
+    {
+        return lu_.extent(0);
+    }
+
+    // Solve for the control points in place. On input, elements [0, n) of `line` hold
+    // the values at each of the n knots. On output, elements [0, n + 2) hold the
+    // control points. `line` is a callable object that returns a reference to the
+    // element at a given index.
+    template<class Line>
+    void
+    solve(Line&& line) const
+    {
+        const auto m = size();
+
+        // Rearrange the values into the order of the equations, with zero right-hand
+        // sides for the boundary conditions.
+        using Value = std::remove_cvref_t<decltype(line(0))>;
+        line(m - 1) = Value{0};
+        for (auto k = m - 2; k >= 2; --k) {
+            line(k) = line(k - 1);
+        }
+        line(1) = Value{0};
+
+        // Forward substitution with the unit lower triangular factor.
+        for (size_type r = 1; r < m; ++r) {
+            const auto first = (r >= bandwidth) ? r - bandwidth : 0;
+            for (auto c = first; c < r; ++c) {
+                line(r) -= line(c) * at(r, c);
+            }
+        }
+
+        // Backward substitution with the upper triangular factor.
+        for (auto r = m; r-- > 0;) {
+            const auto last = std::min(r + bandwidth + 1, m);
+            for (auto c = r + 1; c < last; ++c) {
+                line(r) -= line(c) * at(r, c);
+            }
+            line(r) /= at(r, r);
+        }
+    }
+
+private:
+    static constexpr size_type bandwidth = 2;
+
+    [[nodiscard]] static constexpr auto
+    in_band(size_type r, size_type c) noexcept -> bool
+    {
+        return (c + bandwidth >= r) && (c <= r + bandwidth);
+    }
+
+    [[nodiscard]] auto
+    at(size_type r, size_type c) const -> const knot_type&
+    {
+        WHIRLWIND_DEBUG_ASSERT(in_band(r, c));
+        return lu_(r, c + bandwidth - r);
+    }
+
+    [[nodiscard]] auto
+    at(size_type r, size_type c) -> knot_type&
+    {
+        WHIRLWIND_DEBUG_ASSERT(in_band(r, c));
+        return lu_(r, c + bandwidth - r);
+    }
+
+    // Factor the system matrix in place into unit lower and upper triangular factors.
+    // The natural spline interpolation problem is always uniquely solvable, and the
+    // chosen equation order keeps each pivot nonzero.
+    void
+    factor()
+    {
+        const auto m = size();
+        for (size_type k = 0; k < m; ++k) {
+            const auto pivot = at(k, k);
+            WHIRLWIND_ASSERT(pivot != 0);
+            const auto last = std::min(k + bandwidth + 1, m);
+            for (auto r = k + 1; r < last; ++r) {
+                const auto l = at(r, k) / pivot;
+                at(r, k) = l;
+                for (auto c = k + 1; c < last; ++c) {
+                    at(r, c) -= l * at(k, c);
+                }
+            }
+        }
+    }
+
+    NDArray<knot_type, DynamicExtents2D, Container<knot_type>> lu_;
+};
+
+} // namespace detail
+
+WHIRLWIND_NAMESPACE_END
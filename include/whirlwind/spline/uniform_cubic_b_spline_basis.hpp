@@ -0,0 +1,290 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+
+#include "cubic_b_spline_basis.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A cubic B-spline basis with uniformly spaced knots.
+ *
+ * This is a drop-in replacement for `CubicBSplineBasis` (e.g. as the `Basis` template
+ * parameter of `CubicBSpline`) for the common case of evenly spaced knots. The knot
+ * interval containing a point is computed directly in O(1) time rather than by binary
+ * search, and since the de Boor coefficients of every interval are equal to
+ * 1 / (6 h^3), where h is the knot spacing, no per-interval coefficients are stored.
+ * Instead, the basis functions are evaluated in terms of the normalized position of the
+ * point within its interval.
+ *
+ * @tparam Knot
+ *     The knot type. Must be a floating-point type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the knots.
+ */
+template<class Knot, template<class> class Container = Vector>
+class UniformCubicBSplineBasis {
+public:
+    using knot_type = Knot;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /**
+     * Create a new `UniformCubicBSplineBasis`.
+     *
+     * @param[in] first
+     *     The first knot.
+     * @param[in] spacing
+     *     The distance between consecutive knots. Must be positive.
+     * @param[in] num_knots
+     *     The number of knots. Must be at least 2.
+     */
+    constexpr UniformCubicBSplineBasis(const knot_type& first,
+                                       const knot_type& spacing,
+                                       size_type num_knots)
+        : first_(first), spacing_(spacing), inv_spacing_(knot_type{1} / spacing)
+    {
+        WHIRLWIND_ASSERT(std::isfinite(first));
+        WHIRLWIND_ASSERT(std::isfinite(spacing) && (spacing > 0));
+        WHIRLWIND_ASSERT(num_knots >= 2);
+
+        // The knots are stored so that they may be viewed by `knots()`, but aren't used
+        // to evaluate the basis functions.
+        augmented_knots_ = Container<Knot>(num_knots + 4);
+        for (size_type k = 0; k < num_knots + 4; ++k) {
+            const auto offset = static_cast<knot_type>(k) - knot_type{2};
+            augmented_knots_[k] = first_ + offset * spacing_;
+        }
+    }
+
+    /**
+     * Create a new `UniformCubicBSplineBasis` from a sequence of knots.
+     *
+     * The knots must be uniformly spaced, to within a relative tolerance of 1e-6 of the
+     * knot spacing.
+     *
+     * @param[in] knots
+     *     The knots. Must contain at least 2 strictly increasing values.
+     */
+    template<class RandomAccessRange>
+    explicit constexpr UniformCubicBSplineBasis(const RandomAccessRange& knots)
+        : UniformCubicBSplineBasis(knots[0],
+                                   get_mean_spacing(knots),
+                                   std::size(knots))
+    {
+        [[maybe_unused]] constexpr auto tol = knot_type{1e-6};
+        for (size_type k = 0; k < std::size(knots); ++k) {
+            WHIRLWIND_ASSERT(std::abs(knots[k] - augmented_knots_[k + 2]) <=
+                             tol * spacing_);
+        }
+    }
+
+    [[nodiscard]] constexpr auto
+    knots() const
+    {
+        WHIRLWIND_ASSERT(is_contiguous_range(augmented_knots_));
+        WHIRLWIND_DEBUG_ASSERT(std::size(augmented_knots_) >= 4);
+        const auto first = std::to_address(std::begin(augmented_knots_) + 2);
+        const auto count = std::size(augmented_knots_) - 4;
+        return std::span(first, count);
+    }
+
+    /** The distance between consecutive knots. */
+    [[nodiscard]] constexpr auto
+    spacing() const noexcept -> knot_type
+    {
+        return spacing_;
+    }
+
+    [[nodiscard]] constexpr auto
+    num_knot_intervals() const noexcept -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(augmented_knots_) >= 5);
+        return std::size(augmented_knots_) - 5;
+    }
+
+    [[nodiscard]] constexpr auto
+    num_basis_funcs() const noexcept -> size_type
+    {
+        WHIRLWIND_DEBUG_ASSERT(std::size(augmented_knots_) >= 2);
+        return std::size(augmented_knots_) - 2;
+    }
+
+    /**
+     * Get the index of the knot interval containing a point, in O(1) time.
+     *
+     * As in `CubicBSplineBasis`, each knot is considered part of the interval that
+     * precedes it, and points outside of the knot span are assigned to the first or
+     * last interval.
+     *
+     * @param[in] x
+     *     The point.
+     *
+     * @returns
+     *     The index of the knot interval containing `x`.
+     */
+    [[nodiscard]] constexpr auto
+    get_knot_interval(const knot_type& x) const -> size_type
+    {
+        WHIRLWIND_ASSERT(!std::isnan(x));
+
+        const auto u = (x - first_) * inv_spacing_;
+        const auto last = num_knot_intervals() - 1;
+        if (!(u > knot_type{1})) {
+            return 0;
+        }
+        if (u > static_cast<knot_type>(last)) {
+            return last;
+        }
+        return static_cast<size_type>(std::ceil(u)) - 1;
+    }
+
+    /**
+     * Get the index of the knot interval containing a point.
+     *
+     * The hint is unused, since the interval is computed directly. This overload is
+     * provided for compatibility with `CubicBSplineBasis` (e.g. for use with
+     * `KnotIntervalCursor`).
+     *
+     * @param[in] x
+     *     The point.
+     *
+     * @returns
+     *     The index of the knot interval containing `x`.
+     */
+    [[nodiscard]] constexpr auto
+    get_knot_interval(const knot_type& x, size_type /* hint */) const -> size_type
+    {
+        return get_knot_interval(x);
+    }
+
+    [[nodiscard]] constexpr auto
+    eval_in_interval(const knot_type& x, size_type i) const
+    {
+        WHIRLWIND_ASSERT(i < num_knot_intervals());
+        return eval_normalized(get_normalized_position(x, i));
+    }
+
+    [[nodiscard]] constexpr auto
+    eval_derivative_in_interval(const knot_type& x, size_type i) const
+    {
+        WHIRLWIND_ASSERT(i < num_knot_intervals());
+        const auto u = get_normalized_position(x, i);
+        const auto scale = knot_type{0.5} * inv_spacing_;
+        const auto v = knot_type{1} - u;
+
+        const auto y0 = -scale * (v * v);
+        const auto y1 = scale * (knot_type{3} * u * u - knot_type{4} * u);
+        const auto y2 =
+                scale * (knot_type{-3} * u * u + knot_type{2} * u + knot_type{1});
+        const auto y3 = scale * (u * u);
+
+        return std::array{y0, y1, y2, y3};
+    }
+
+    [[nodiscard]] constexpr auto
+    eval_second_derivative_in_interval(const knot_type& x, size_type i) const
+    {
+        WHIRLWIND_ASSERT(i < num_knot_intervals());
+        const auto u = get_normalized_position(x, i);
+        const auto scale = inv_spacing_ * inv_spacing_;
+
+        const auto y0 = scale * (knot_type{1} - u);
+        const auto y1 = scale * (knot_type{3} * u - knot_type{2});
+        const auto y2 = scale * (knot_type{1} - knot_type{3} * u);
+        const auto y3 = scale * u;
+
+        return std::array{y0, y1, y2, y3};
+    }
+
+    /**
+     * Evaluate the nonzero basis functions at each of a block of points.
+     *
+     * This is equivalent to calling `eval_in_interval()` for each point, but the basis
+     * functions are evaluated by a loop over the block that compilers can vectorize.
+     *
+     * @tparam N
+     *     The number of points in the block.
+     *
+     * @param[in] x
+     *     The points.
+     * @param[in] i
+     *     The knot interval containing each point.
+     *
+     * @returns
+     *     The values of the four nonzero basis functions (in order) at each point,
+     *     indexed by basis function and then by point.
+     */
+    template<std::size_t N>
+    [[nodiscard]] constexpr auto
+    eval_in_intervals(const std::array<knot_type, N>& x,
+                      const std::array<size_type, N>& i) const
+            -> std::array<std::array<knot_type, N>, 4>
+    {
+        auto y = std::array<std::array<knot_type, N>, 4>();
+        for (size_type k = 0; k < N; ++k) {
+            WHIRLWIND_ASSERT(i[k] < num_knot_intervals());
+            const auto b = eval_normalized(get_normalized_position(x[k], i[k]));
+            for (size_type j = 0; j < 4; ++j) {
+                y[j][k] = b[j];
+            }
+        }
+        return y;
+    }
+
+private:
+    template<class RandomAccessRange>
+    [[nodiscard]] static constexpr auto
+    get_mean_spacing(const RandomAccessRange& knots) -> knot_type
+    {
+        const auto n = std::size(knots);
+        WHIRLWIND_ASSERT(n >= 2);
+        return (knots[n - 1] - knots[0]) / static_cast<knot_type>(n - 1);
+    }
+
+    // Get the position of `x` relative to the start of the `i`-th knot interval, in
+    // units of the knot spacing.
+    [[nodiscard]] constexpr auto
+    get_normalized_position(const knot_type& x, size_type i) const noexcept
+            -> knot_type
+    {
+        return (x - first_) * inv_spacing_ - static_cast<knot_type>(i);
+    }
+
+    // Evaluate the four nonzero basis functions at normalized position `u` within a
+    // knot interval. These are the general de Boor formulas with every knot difference
+    // expressed as a multiple of the knot spacing.
+    [[nodiscard]] static constexpr auto
+    eval_normalized(const knot_type& u) noexcept -> std::array<knot_type, 4>
+    {
+        constexpr auto sixth = knot_type{1} / knot_type{6};
+        const auto u2 = u * u;
+        const auto u3 = u2 * u;
+        const auto v = knot_type{1} - u;
+
+        const auto y0 = sixth * (v * v * v);
+        const auto y1 = sixth * (knot_type{3} * u3 - knot_type{6} * u2 + knot_type{4});
+        const auto y2 = sixth * (knot_type{-3} * u3 + knot_type{3} * u2 +
+                                 knot_type{3} * u + knot_type{1});
+        const auto y3 = sixth * u3;
+
+        return std::array{y0, y1, y2, y3};
+    }
+
+    knot_type first_;
+    knot_type spacing_;
+    knot_type inv_spacing_;
+    container_type<knot_type> augmented_knots_;
+};
+
+WHIRLWIND_NAMESPACE_END
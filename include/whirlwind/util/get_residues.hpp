@@ -1,101 +1,283 @@
 #pragma once
 
-#include <cmath>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
 
 #include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/math/numbers.hpp>
 #include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
 
 WHIRLWIND_NAMESPACE_BEGIN
 
-template<class SignedInteger = std::int32_t,
-         template<class> class Container = Vector,
-         class ArrayLike2D>
+namespace detail {
+
+// Get the number of cycles to remove from the difference between two wrapped phase
+// values in the interval [-pi, pi] in order to wrap it to the interval [-pi, pi].
+// This is the difference divided by 2pi, rounded to the nearest integer (with halfway
+// cases rounded away from zero). Since the difference is in [-2pi, 2pi], the result is
+// in {-1, 0, 1} and is computed here without branches or calls to `std::round()` so
+// that loops over rows of pixels can be vectorized.
+template<class SignedInteger, class Real>
 [[nodiscard]] constexpr auto
-get_residues(const ArrayLike2D& wrapped_phase)
-        -> Array2D<SignedInteger, Container<SignedInteger>>
+get_cycle_diff_residual(const Real& a, const Real& b) noexcept -> SignedInteger
 {
-    WHIRLWIND_STATIC_ASSERT(std::is_signed_v<SignedInteger> &&
-                            std::is_integral_v<SignedInteger>);
-    using Extents = typename ArrayLike2D::extents_type;
-    WHIRLWIND_STATIC_ASSERT(Extents::rank() == 2);
+    const auto diff = a - b;
+    const auto up = static_cast<int>(diff >= pi<Real>());
+    const auto down = static_cast<int>(diff <= -pi<Real>());
+    return static_cast<SignedInteger>(up - down);
+}
 
-    const auto m = wrapped_phase.extent(0);
-    const auto n = wrapped_phase.extent(1);
-    WHIRLWIND_ASSERT(m >= 1);
-    WHIRLWIND_ASSERT(n >= 1);
-    auto out = Array2D<SignedInteger, Container<SignedInteger>>(m + 1, n + 1);
+// Get the difference between two wrapped phase values (in radians) in the interval
+// [-pi, pi], wrapped to the interval [-pi, pi). The number of cycles to remove is
+// computed without branches so that loops over rows of pixels can be vectorized.
+template<class Real>
+[[nodiscard]] constexpr auto
+get_wrapped_diff(const Real& a, const Real& b) noexcept -> Real
+{
+    const auto cycles = get_cycle_diff_residual<int>(a, b);
+    return (a - b) - tau<Real>() * static_cast<Real>(cycles);
+}
 
-    // Checks whether the argument is in the interval [-pi, pi].
-    [[maybe_unused]] auto is_wrapped_phase = [](const auto& psi) {
-        using T = decltype(psi);
-        return (psi >= -pi<T>()) && (psi <= pi<T>());
-    };
+// Compute the residues of a wrapped phase array one row at a time, given each row of
+// the wrapped phase in order. Only the two most recent input rows are stored.
+//
+// Each pixel pair's residual cycles are added to one node bordering the pair and
+// subtracted from the other. In terms of the residual cycles `v(i,j)` between pixels
+// (i,j) and (i+1,j), and `h(i,j)` between pixels (i,j) and (i,j+1), each node (r,c)
+// gathers
+//
+//   v(r-1,c) - v(r-1,c-1) + h(r,c-1) - h(r-1,c-1)
+//
+// where out-of-bounds terms are zero. Output row `r` therefore only depends on input
+// rows `r-1` and `r`. The cycles are computed a whole row at a time into contiguous
+// buffers by branch-free loops that compilers can vectorize.
+template<class SignedInteger, class Real, template<class> class Container>
+class ResidueRowKernel {
+public:
+    using size_type = std::size_t;
 
-    auto cycle_diff_residual = [](const auto& a, const auto& b) -> SignedInteger {
-        const auto diff = a - b;
-        return static_cast<SignedInteger>(std::round(diff / tau<decltype(diff)>()));
-    };
+    explicit ResidueRowKernel(size_type num_cols)
+        : prev_row_(num_cols),
+          curr_row_(num_cols),
+          v_(num_cols, 0),
+          h_prev_(num_cols - 1, 0),
+          h_curr_(num_cols - 1, 0)
+    {
+        WHIRLWIND_ASSERT(num_cols >= 1);
+    }
 
-    using Index = std::remove_const_t<decltype(m)>;
-    for (Index i = 0; i < m - 1; ++i) {
-        for (Index j = 0; j < n - 1; ++j) {
-            const auto phi_00 = wrapped_phase(i, j);
-            const auto phi_10 = wrapped_phase(i + 1, j);
-            const auto phi_01 = wrapped_phase(i, j + 1);
-            WHIRLWIND_ASSERT(is_wrapped_phase(phi_00));
-            WHIRLWIND_ASSERT(is_wrapped_phase(phi_10));
-            WHIRLWIND_ASSERT(is_wrapped_phase(phi_01));
-
-            const auto di = cycle_diff_residual(phi_00, phi_10);
-            const auto dj = cycle_diff_residual(phi_01, phi_00);
-            WHIRLWIND_DEBUG_ASSERT((di == -1) || (di == 0) || (di == 1));
-            WHIRLWIND_DEBUG_ASSERT((dj == -1) || (dj == 0) || (dj == 1));
-
-            WHIRLWIND_DEBUG_ASSERT(i + 1 < out.extent(0));
-            WHIRLWIND_DEBUG_ASSERT(j + 1 < out.extent(1));
-            out(i + 1, j) += di;
-            out(i, j + 1) += dj;
-            out(i + 1, j + 1) -= di + dj;
-        }
+    // The number of columns of pixels.
+    [[nodiscard]] auto
+    num_cols() const noexcept -> size_type
+    {
+        return curr_row_.size();
     }
 
-    // Last column.
-    for (Index i = 0, j = n - 1; i < m - 1; ++i) {
-        const auto phi0 = wrapped_phase(i, j);
-        const auto phi1 = wrapped_phase(i + 1, j);
-        WHIRLWIND_ASSERT(is_wrapped_phase(phi0));
-        WHIRLWIND_ASSERT(is_wrapped_phase(phi1));
+    // The wrapped phase of the previous input row.
+    [[nodiscard]] auto
+    previous_row() const noexcept -> const Container<Real>&
+    {
+        return prev_row_;
+    }
+
+    // The wrapped phase of the current input row.
+    [[nodiscard]] auto
+    current_row() const noexcept -> const Container<Real>&
+    {
+        return curr_row_;
+    }
 
-        const auto d = cycle_diff_residual(phi0, phi1);
-        WHIRLWIND_DEBUG_ASSERT((d == -1) || (d == 0) || (d == 1));
+    // Make row `i` of a wrapped phase array the current input row.
+    template<class ArrayLike2D>
+    void
+    push_row(const ArrayLike2D& wrapped_phase, size_type i)
+    {
+        // Checks whether the argument is in the interval [-pi, pi].
+        [[maybe_unused]] auto is_wrapped_phase = [](const auto& psi) {
+            using T = std::remove_cvref_t<decltype(psi)>;
+            return (psi >= -pi<T>()) && (psi <= pi<T>());
+        };
+
+        WHIRLWIND_ASSERT(static_cast<size_type>(wrapped_phase.extent(1)) == num_cols());
+        shift();
+        for (size_type j = 0; j < num_cols(); ++j) {
+            curr_row_[j] = wrapped_phase(i, j);
+            WHIRLWIND_ASSERT(is_wrapped_phase(curr_row_[j]));
+        }
+        for (size_type j = 0; j + 1 < num_cols(); ++j) {
+            h_curr_[j] = get_cycle_diff_residual<SignedInteger>(curr_row_[j + 1],
+                                                                curr_row_[j]);
+        }
+        has_curr_ = true;
+    }
 
-        WHIRLWIND_DEBUG_ASSERT(i + 1 < out.extent(0));
-        WHIRLWIND_DEBUG_ASSERT(j + 1 < out.extent(1));
-        out(i + 1, j) += d;
-        out(i + 1, j + 1) -= d;
+    // Advance past the last input row.
+    void
+    push_end()
+    {
+        shift();
+        std::fill(h_curr_.begin(), h_curr_.end(), SignedInteger{0});
+        has_curr_ = false;
     }
 
-    // Last row.
-    for (Index i = m - 1, j = 0; j < n - 1; ++j) {
-        const auto phi0 = wrapped_phase(i, j);
-        const auto phi1 = wrapped_phase(i, j + 1);
-        WHIRLWIND_ASSERT(is_wrapped_phase(phi0));
-        WHIRLWIND_ASSERT(is_wrapped_phase(phi1));
+    // Get the residues of the output row between the previous and current input rows,
+    // assigning the residue of each of the `num_cols() + 1` nodes `c` to `out(c)`.
+    template<class Out>
+    void
+    get_residue_row(Out&& out)
+    {
+        const auto n = num_cols();
+        if (has_prev_ && has_curr_) {
+            for (size_type j = 0; j < n; ++j) {
+                v_[j] = get_cycle_diff_residual<SignedInteger>(prev_row_[j],
+                                                               curr_row_[j]);
+            }
+        } else {
+            std::fill(v_.begin(), v_.end(), SignedInteger{0});
+        }
 
-        const auto d = cycle_diff_residual(phi1, phi0);
-        WHIRLWIND_DEBUG_ASSERT((d == -1) || (d == 0) || (d == 1));
+        out(0) = v_[0];
+        for (size_type c = 1; c < n; ++c) {
+            out(c) = static_cast<SignedInteger>(v_[c] - v_[c - 1] + h_curr_[c - 1] -
+                                                h_prev_[c - 1]);
+        }
+        out(n) = static_cast<SignedInteger>(-v_[n - 1]);
+    }
 
-        WHIRLWIND_DEBUG_ASSERT(i + 1 < out.extent(0));
-        WHIRLWIND_DEBUG_ASSERT(j + 1 < out.extent(1));
-        out(i, j + 1) += d;
-        out(i + 1, j + 1) -= d;
+private:
+    void
+    shift()
+    {
+        using std::swap;
+        swap(prev_row_, curr_row_);
+        swap(h_prev_, h_curr_);
+        has_prev_ = has_curr_;
     }
 
+    Container<Real> prev_row_;
+    Container<Real> curr_row_;
+    Container<SignedInteger> v_;
+    Container<SignedInteger> h_prev_;
+    Container<SignedInteger> h_curr_;
+    bool has_prev_ = false;
+    bool has_curr_ = false;
+};
+
+} // namespace detail
+
+/**
+ * Compute the residues of a 2-D wrapped phase array, writing them to an existing
+ * array.
+ *
+ * The residues are the nodes of the (M+1) x (N+1) grid of corners between pixels (and
+ * around the border of the array) of an M x N wrapped phase array. The charge of each
+ * node is the net number of cycles in the wrapped phase differences around the pixels
+ * adjacent to it, such that the total charge of all nodes is zero.
+ *
+ * Each output row is computed independently from the residual cycles in the phase
+ * differences between adjacent pixels in (at most) two consecutive rows of the input,
+ * which are computed a whole row at a time into contiguous buffers by branch-free loops
+ * that compilers can vectorize. Blocks of output rows may be distributed across
+ * multiple threads. The result doesn't depend on the number of threads.
+ *
+ * Both the input and the output may have any memory layout (e.g. a `Span2D` with
+ * `LayoutLeft` or `LayoutStride` viewing an externally-owned buffer), so no copies of
+ * either are made. Each input row is read once per output row that borders it.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the per-row buffers.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[out] out
+ *     The (M+1) x (N+1) output array of residues.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ */
+template<template<class> class Container = Vector,
+         class ArrayLike2D,
+         class SignedInteger,
+         class LayoutPolicy>
+void
+get_residues(const ArrayLike2D& wrapped_phase,
+             Span2D<SignedInteger, LayoutPolicy> out,
+             std::size_t num_threads = 1)
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_signed_v<SignedInteger> &&
+                            std::is_integral_v<SignedInteger>);
+    using Extents = typename ArrayLike2D::extents_type;
+    WHIRLWIND_STATIC_ASSERT(Extents::rank() == 2);
+    using Real = std::remove_cvref_t<typename ArrayLike2D::value_type>;
+
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(out.extent(0) == m + 1);
+    WHIRLWIND_ASSERT(out.extent(1) == n + 1);
+    WHIRLWIND_ASSERT(num_threads >= 1);
+
+    // Each block of output rows is computed independently, starting from the input row
+    // preceding the block.
+    const auto get_rows = [&](std::size_t first, std::size_t last) {
+        auto kernel = detail::ResidueRowKernel<SignedInteger, Real, Container>(n);
+        if (first >= 1) {
+            kernel.push_row(wrapped_phase, first - 1);
+        }
+        for (auto r = first; r < last; ++r) {
+            if (r < m) {
+                kernel.push_row(wrapped_phase, r);
+            } else {
+                kernel.push_end();
+            }
+            kernel.get_residue_row(
+                    [&, r](std::size_t c) -> auto& { return out(r, c); });
+        }
+    };
+    parallel_for_chunks(0, m + 1, num_threads, get_rows);
+}
+
+/**
+ * Compute the residues of a 2-D wrapped phase array.
+ *
+ * See the overload above for details. The input may have any memory layout.
+ *
+ * @tparam SignedInteger
+ *     The signed integer type of the output residues.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the output array and the
+ *     per-row buffers.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ *
+ * @returns
+ *     The (M+1) x (N+1) array of residues.
+ */
+template<class SignedInteger = std::int32_t,
+         template<class> class Container = Vector,
+         class ArrayLike2D>
+[[nodiscard]] auto
+get_residues(const ArrayLike2D& wrapped_phase, std::size_t num_threads = 1)
+        -> Array2D<SignedInteger, Container<SignedInteger>>
+{
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    auto out = Array2D<SignedInteger, Container<SignedInteger>>(m + 1, n + 1);
+    get_residues<Container>(wrapped_phase, out.to_mdspan(), num_threads);
     return out;
 }
 
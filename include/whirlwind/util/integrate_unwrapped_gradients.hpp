@@ -1,17 +1,56 @@
 #pragma once
 
-#include <cmath>
+#include <cstddef>
 #include <type_traits>
 
+#include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
 #include <whirlwind/container/vector.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/math/numbers.hpp>
 #include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
 #include <whirlwind/network/network.hpp>
+#include <whirlwind/util/get_residues.hpp>
 
 WHIRLWIND_NAMESPACE_BEGIN
 
+/**
+ * Integrate the unwrapped phase gradients implied by a minimum cost flow solution,
+ * writing the unwrapped phase to an existing array.
+ *
+ * The unwrapped phase gradient between each pair of adjacent pixels is the wrapped
+ * phase gradient plus the net flow (in cycles) on the arcs between the two residues
+ * that border the pair. The unwrapped phase is obtained by accumulating gradients down
+ * the first column, starting from the top-left pixel (whose unwrapped phase is equal to
+ * its wrapped phase), and then across each row.
+ *
+ * The net flows of each row are first gathered into a contiguous buffer, after which
+ * the unwrapped gradients are computed by a branch-free loop that compilers can
+ * vectorize. Blocks of rows may be integrated by multiple threads. Each row is summed
+ * in the same order regardless of the number of threads, so the result doesn't depend
+ * on the number of threads.
+ *
+ * Both the input and the output may have any memory layout (e.g. a `Span2D` with
+ * `LayoutLeft` or `LayoutStride` viewing an externally-owned buffer), so no copies of
+ * either are made.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the per-row buffers.
+ * @tparam Accumulator
+ *     The floating-point type used to accumulate the unwrapped phase gradients.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi].
+ * @param[in] network
+ *     The solved network on the (M+1) x (N+1) grid of residues.
+ * @param[out] unwrapped_phase
+ *     The M x N output unwrapped phase array.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ */
 template<template<class> class Container = Vector,
          class Accumulator = double,
          class ArrayLike2D,
@@ -21,16 +60,21 @@ template<template<class> class Container = Vector,
          // clang-format off
          template<class> class UContainer,
          // clang-format on
-         class Mixin>
-[[nodiscard]] constexpr auto
+         class Mixin,
+         class T,
+         class LayoutPolicy>
+void
 integrate_unwrapped_gradients(
         const ArrayLike2D& wrapped_phase,
         const Network<RectangularGridGraph<1, Dim>, Cost, Flow, UContainer, Mixin>&
-                network)
+                network,
+        Span2D<T, LayoutPolicy> unwrapped_phase,
+        std::size_t num_threads = 1)
 {
     // The input wrapped phase array must be a real-valued 2-D array.
-    using Real = typename ArrayLike2D::value_type;
+    using Real = std::remove_cvref_t<typename ArrayLike2D::value_type>;
     WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<Real>);
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<T>);
     using Extents = typename ArrayLike2D::extents_type;
     WHIRLWIND_STATIC_ASSERT(Extents::rank() == 2);
 
@@ -41,34 +85,26 @@ integrate_unwrapped_gradients(
     // Check that the wrapped phase array and network grid graph have compatible shapes.
     // The graph is expected to contain exactly one more row and one more column of
     // nodes than the array dimensions.
-    const auto m = wrapped_phase.extent(0);
-    const auto n = wrapped_phase.extent(1);
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
     const auto& residual_graph = network.residual_graph();
     WHIRLWIND_ASSERT(residual_graph.num_rows() == m + 1);
     WHIRLWIND_ASSERT(residual_graph.num_cols() == n + 1);
+    WHIRLWIND_ASSERT(unwrapped_phase.extent(0) == m);
+    WHIRLWIND_ASSERT(unwrapped_phase.extent(1) == n);
+    WHIRLWIND_ASSERT(num_threads >= 1);
 
     // TODO: Check that the flow in the network is feasible
 
-    // Initialize the output array.
-    auto unwrapped_phase = Array2D<Real, Container<Real>>(m, n);
-
     // If the input array is Mx0 or 0xN, there's nothing to do.
     if ((m == 0) || (n == 0)) {
-        return unwrapped_phase;
+        return;
     }
 
     // Checks whether the argument is in the interval [-pi, pi].
     [[maybe_unused]] auto is_wrapped_phase = [](const auto& psi) {
-        using T = decltype(psi);
-        return (psi >= -pi<T>()) && (psi <= pi<T>());
-    };
-
-    // Computes the difference between the two input phase values (in radians), wrapped
-    // to the interval [-pi, pi).
-    auto wrapped_diff = [](const auto& a, const auto& b) {
-        const auto diff = a - b;
-        using T = decltype(diff);
-        return diff - tau<T>() * std::round(diff / tau<T>());
+        using U = std::remove_cvref_t<decltype(psi)>;
+        return (psi >= -pi<U>()) && (psi <= pi<U>());
     };
 
     using ResidualGraph = std::remove_cvref_t<decltype(residual_graph)>;
@@ -76,93 +112,129 @@ integrate_unwrapped_gradients(
 
     // Start with a fixed "seed" point where the wrapped and unwrapped phase values are
     // forced to be equal.
-    unwrapped_phase(0, 0) = wrapped_phase(0, 0);
+    unwrapped_phase(0, 0) = static_cast<T>(wrapped_phase(0, 0));
 
     // Scan down the first column. Accumulate the unwrapped phase gradients between each
     // adjacent pair of pixels to get the unwrapped phase values.
     auto phi = Accumulator{unwrapped_phase(0, 0)};
-    using Index = std::remove_const_t<decltype(m)>;
-    for (Index i = 1; i < m; ++i) {
+    for (std::size_t i = 1; i < m; ++i) {
         // Compute the wrapped phase gradient between the pair of adjacent phase values.
         const auto psi0 = wrapped_phase(i - 1, 0);
         const auto psi1 = wrapped_phase(i, 0);
         WHIRLWIND_ASSERT(is_wrapped_phase(psi0));
         WHIRLWIND_ASSERT(is_wrapped_phase(psi1));
-        const auto dpsi = wrapped_diff(psi1, psi0);
+        const auto dpsi = detail::get_wrapped_diff<Real>(psi1, psi0);
         WHIRLWIND_DEBUG_ASSERT(is_wrapped_phase(dpsi));
 
-        // Get the two residues (nodes) in the network that both border the edge between
-        // the pair of pixels.
-        WHIRLWIND_DEBUG_ASSERT(i < residual_graph.num_rows());
-        WHIRLWIND_DEBUG_ASSERT(1 < residual_graph.num_cols());
+        // Get the net leftward flow between the two neighboring residues that both
+        // border the edge between the pair of pixels. If the residues were formed from
+        // clockwise loops, this corresponds to the difference (in cycles) between the
+        // unwrapped & wrapped phase gradients in the downward direction (from the upper
+        // to the lower pixel).
         const auto node0 = Vertex(i, 0);
         const auto node1 = Vertex(i, 1);
-        WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_vertex(node0));
-        WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_vertex(node1));
-
-        // Get the net leftward flow between the two neighboring residues. If the
-        // residues were formed from clockwise loops, this corresponds to the difference
-        // (in cycles) between the unwrapped & wrapped phase gradients in the downward
-        // direction (from the upper to the lower pixel).
         const auto arc0 = residual_graph.get_right_edge(node0);
         const auto arc1 = residual_graph.get_left_edge(node1);
-        WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_edge(arc0));
-        WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_edge(arc1));
         const auto net_flow = network.arc_flow(arc1) - network.arc_flow(arc0);
 
         // Get the unwrapped phase gradient between the pixels and add it to the
         // cumulative sum.
-        const auto dphi = dpsi + tau<decltype(dpsi)>() * net_flow;
+        const auto dphi = dpsi + tau<Real>() * static_cast<Real>(net_flow);
         phi += Accumulator{dphi};
 
         // Store the unwrapped phase value.
-        unwrapped_phase(i, 0) = static_cast<Real>(phi);
+        unwrapped_phase(i, 0) = static_cast<T>(phi);
     }
 
     // Scan across each row. Accumulate the unwrapped phase gradients between each
-    // adjacent pair of pixels to get the unwrapped phase values.
-    for (Index i = 0; i < m; ++i) {
-        auto phi = Accumulator{unwrapped_phase(i, 0)};
-
-        for (Index j = 1; j < n; ++j) {
-            // Compute the wrapped phase gradient between the pair of adjacent phase
-            // values.
-            const auto psi0 = wrapped_phase(i, j - 1);
-            const auto psi1 = wrapped_phase(i, j);
-            WHIRLWIND_ASSERT(is_wrapped_phase(psi0));
-            WHIRLWIND_ASSERT(is_wrapped_phase(psi1));
-            const auto dpsi = wrapped_diff(psi1, psi0);
-            WHIRLWIND_DEBUG_ASSERT(is_wrapped_phase(dpsi));
-
-            // Get the two residues (nodes) in the network that both border the edge
-            // between the pair of pixels.
-            WHIRLWIND_DEBUG_ASSERT(i + 1 < residual_graph.num_rows());
-            WHIRLWIND_DEBUG_ASSERT(j < residual_graph.num_cols());
-            const auto node0 = Vertex(i, j);
-            const auto node1 = Vertex(i + 1, j);
-            WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_vertex(node0));
-            WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_vertex(node1));
-
-            // Get the net downward flow between the two neighboring residues. If the
-            // residues were formed from clockwise loops, this corresponds to the
+    // adjacent pair of pixels to get the unwrapped phase values. Rows are independent
+    // once the first column is known.
+    const auto integrate_rows = [&](std::size_t first, std::size_t last) {
+        auto psi = Container<Real>(n);
+        auto net_flow = Container<Real>(n - 1);
+        auto dphi = Container<Real>(n - 1);
+
+        for (auto i = first; i < last; ++i) {
+            // Gather the wrapped phase and the net downward flow between each pair of
+            // neighboring residues that border the edge between a pair of pixels. If
+            // the residues were formed from clockwise loops, this corresponds to the
             // difference (in cycles) between the unwrapped & wrapped phase gradients in
             // the rightward direction (from the left to the right pixel).
-            const auto arc0 = residual_graph.get_down_edge(node0);
-            const auto arc1 = residual_graph.get_up_edge(node1);
-            WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_edge(arc0));
-            WHIRLWIND_DEBUG_ASSERT(residual_graph.contains_edge(arc1));
-            const auto net_flow = network.arc_flow(arc0) - network.arc_flow(arc1);
-
-            // Get the unwrapped phase gradient between the pixels and add it to the
-            // cumulative sum.
-            const auto dphi = dpsi + tau<decltype(dpsi)>() * net_flow;
-            phi += Accumulator{dphi};
-
-            // Store the unwrapped phase value.
-            unwrapped_phase(i, j) = static_cast<Real>(phi);
+            for (std::size_t j = 0; j < n; ++j) {
+                psi[j] = wrapped_phase(i, j);
+                WHIRLWIND_ASSERT(is_wrapped_phase(psi[j]));
+            }
+            for (std::size_t j = 1; j < n; ++j) {
+                const auto node0 = Vertex(i, j);
+                const auto node1 = Vertex(i + 1, j);
+                const auto arc0 = residual_graph.get_down_edge(node0);
+                const auto arc1 = residual_graph.get_up_edge(node1);
+                net_flow[j - 1] = static_cast<Real>(network.arc_flow(arc0) -
+                                                    network.arc_flow(arc1));
+            }
+
+            // Compute the unwrapped phase gradients between each pair of pixels.
+            for (std::size_t j = 1; j < n; ++j) {
+                const auto dpsi = detail::get_wrapped_diff<Real>(psi[j], psi[j - 1]);
+                dphi[j - 1] = dpsi + tau<Real>() * net_flow[j - 1];
+            }
+
+            // Accumulate the gradients and store the unwrapped phase values.
+            auto row_phi = Accumulator{unwrapped_phase(i, 0)};
+            for (std::size_t j = 1; j < n; ++j) {
+                row_phi += Accumulator{dphi[j - 1]};
+                unwrapped_phase(i, j) = static_cast<T>(row_phi);
+            }
         }
-    }
+    };
+    parallel_for_chunks(0, m, num_threads, integrate_rows);
+}
 
+/**
+ * Integrate the unwrapped phase gradients implied by a minimum cost flow solution.
+ *
+ * See the overload above for details. The input may have any memory layout.
+ *
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the output array and the
+ *     per-row buffers.
+ * @tparam Accumulator
+ *     The floating-point type used to accumulate the unwrapped phase gradients.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi].
+ * @param[in] network
+ *     The solved network on the (M+1) x (N+1) grid of residues.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ *
+ * @returns
+ *     The M x N unwrapped phase array.
+ */
+template<template<class> class Container = Vector,
+         class Accumulator = double,
+         class ArrayLike2D,
+         class Dim,
+         class Cost,
+         class Flow,
+         // clang-format off
+         template<class> class UContainer,
+         // clang-format on
+         class Mixin>
+[[nodiscard]] auto
+integrate_unwrapped_gradients(
+        const ArrayLike2D& wrapped_phase,
+        const Network<RectangularGridGraph<1, Dim>, Cost, Flow, UContainer, Mixin>&
+                network,
+        std::size_t num_threads = 1)
+{
+    using Real = std::remove_cvref_t<typename ArrayLike2D::value_type>;
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    auto unwrapped_phase = Array2D<Real, Container<Real>>(m, n);
+    integrate_unwrapped_gradients<Container, Accumulator>(
+            wrapped_phase, network, unwrapped_phase.to_mdspan(), num_threads);
     return unwrapped_phase;
 }
 
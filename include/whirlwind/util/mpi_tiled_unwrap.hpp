@@ -0,0 +1,387 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <mpi.h>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+
+#include "tiled_unwrap.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Throw an exception if an MPI call failed.
+inline void
+check_mpi(int status, const char* what)
+{
+    if (status != MPI_SUCCESS) {
+        throw std::runtime_error(std::string(what) + " failed with error code " +
+                                 std::to_string(status));
+    }
+}
+
+// Get the MPI datatype corresponding to a floating-point type.
+template<class Real>
+[[nodiscard]] auto
+mpi_datatype() -> MPI_Datatype
+{
+    if constexpr (std::is_same_v<Real, float>) {
+        return MPI_FLOAT;
+    } else if constexpr (std::is_same_v<Real, double>) {
+        return MPI_DOUBLE;
+    } else {
+        WHIRLWIND_STATIC_ASSERT(std::is_same_v<Real, long double>);
+        return MPI_LONG_DOUBLE;
+    }
+}
+
+// Convert a buffer size to an MPI count.
+[[nodiscard]] inline auto
+mpi_count(std::size_t count) -> int
+{
+    WHIRLWIND_ASSERT(count <= static_cast<std::size_t>(INT_MAX));
+    return static_cast<int>(count);
+}
+
+// Invoke `func(other_id)`, in ascending order, for each tile (other than the specified
+// tile) whose extended region overlaps the core region of the specified tile.
+template<class Func>
+constexpr void
+for_each_neighbor_tile(const TileLayout& layout, std::size_t tile_id, Func&& func)
+{
+    const auto tile = layout.tile(tile_id);
+    const auto overlap = layout.overlap();
+
+    const auto row_begin = tile.core_row_begin - std::min(tile.core_row_begin, overlap);
+    const auto row_end = std::min(tile.core_row_end + overlap, layout.num_rows());
+    const auto col_begin = tile.core_col_begin - std::min(tile.core_col_begin, overlap);
+    const auto col_end = std::min(tile.core_col_end + overlap, layout.num_cols());
+
+    const auto ti_begin = row_begin / layout.tile_rows();
+    const auto ti_end = (row_end - 1) / layout.tile_rows() + 1;
+    const auto tj_begin = col_begin / layout.tile_cols();
+    const auto tj_end = (col_end - 1) / layout.tile_cols() + 1;
+
+    for (auto ti = ti_begin; ti < ti_end; ++ti) {
+        for (auto tj = tj_begin; tj < tj_end; ++tj) {
+            const auto other_id = ti * layout.num_tile_cols() + tj;
+            if (other_id != tile_id) {
+                func(other_id);
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Unwrap a large interferogram by distributing its tiles across the ranks of an MPI
+ * communicator.
+ *
+ * This is the distributed counterpart of `tiled_unwrap()`. Tiles are assigned to ranks
+ * in round-robin order (tile `t` is owned by rank `t % size`) and each rank only ever
+ * loads and holds the tiles it owns, so the full array need not fit in the memory of
+ * any single node. The pipeline proceeds in four steps:
+ *
+ * 1. Each rank unwraps its tiles independently (see `unwrap_tile()`), with up to
+ *    `options.num_threads` tiles in flight at once.
+ * 2. Each rank sends the unwrapped phase of its tiles' core regions to the owners of
+ *    the overlapping tiles, which tally the cycle offsets suggested by each pixel in
+ *    their margins (see `get_seam_votes()`).
+ * 3. The votes are gathered on the root rank, which resolves the cycle offset of each
+ *    tile (see `resolve_tile_offsets()`) and scatters the offsets back to the owners.
+ * 4. Each rank adds its tiles' offsets to their unwrapped phase and passes each tile
+ *    to `store_tile`.
+ *
+ * Only the seam votes and per-tile offsets pass through the root rank. The result is
+ * the same as that of `tiled_unwrap()` with the same options.
+ *
+ * This function must be called collectively by every rank in the communicator with the
+ * same array shape and options.
+ *
+ * @tparam Cost
+ *     The arc cost type.
+ * @tparam Flow
+ *     The flow type. Must be signed.
+ *
+ * @param[in] num_rows
+ *     The number of rows in the full wrapped phase array.
+ * @param[in] num_cols
+ *     The number of columns in the full wrapped phase array.
+ * @param[in] load_tile
+ *     A callable object that, given a tile, returns a 2-D array of the wrapped phase in
+ *     the tile's extended region. It may be invoked concurrently from multiple threads.
+ * @param[in] cost_fn
+ *     A callable object that, given a tile and the grid graph of the tile's network,
+ *     returns a random-access range of the unit cost of each edge in the graph. It may
+ *     be invoked concurrently from multiple threads.
+ * @param[in] store_tile
+ *     A callable object that is invoked with each tile owned by this rank and a 2-D
+ *     array of the final unwrapped phase in the tile's extended region. Only the core
+ *     region of each tile should be kept. It is invoked from the calling thread only.
+ * @param[in] options
+ *     The tiling options.
+ * @param[in] comm
+ *     The MPI communicator.
+ * @param[in] root
+ *     The rank on which the tile offsets are resolved.
+ *
+ * @throws std::runtime_error
+ *     If an MPI call fails.
+ */
+template<class Cost = int,
+         class Flow = int,
+         class LoadFunc,
+         class CostFunc,
+         class StoreFunc>
+void
+mpi_tiled_unwrap(std::size_t num_rows,
+                 std::size_t num_cols,
+                 const LoadFunc& load_tile,
+                 const CostFunc& cost_fn,
+                 StoreFunc&& store_tile,
+                 const TiledUnwrapOptions& options = {},
+                 MPI_Comm comm = MPI_COMM_WORLD,
+                 int root = 0)
+{
+    using TilePhase = std::remove_cvref_t<std::invoke_result_t<const LoadFunc&, Tile>>;
+    using Real = std::remove_cvref_t<typename TilePhase::value_type>;
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<Real>);
+    WHIRLWIND_ASSERT(options.num_threads >= 1);
+
+    int mpi_rank = 0;
+    int mpi_size = 0;
+    detail::check_mpi(MPI_Comm_rank(comm, &mpi_rank), "MPI_Comm_rank");
+    detail::check_mpi(MPI_Comm_size(comm, &mpi_size), "MPI_Comm_size");
+    WHIRLWIND_ASSERT((root >= 0) && (root < mpi_size));
+    const auto rank = static_cast<std::size_t>(mpi_rank);
+    const auto num_ranks = static_cast<std::size_t>(mpi_size);
+
+    if ((num_rows == 0) || (num_cols == 0)) {
+        return;
+    }
+
+    const auto layout = TileLayout(num_rows, num_cols, options.tile_rows,
+                                   options.tile_cols, options.overlap);
+    const auto num_tiles = layout.num_tiles();
+
+    // The number of tiles owned by a rank. Rank `r` owns tiles `r`, `r + num_ranks`,
+    // `r + 2 * num_ranks`, etc, so tile `t` is the `(t / num_ranks)`-th tile of its
+    // owner.
+    const auto get_num_owned_tiles = [&](std::size_t r) -> std::size_t {
+        return (r < num_tiles) ? (num_tiles - r + num_ranks - 1) / num_ranks : 0;
+    };
+    const auto get_owner = [&](std::size_t tile_id) { return tile_id % num_ranks; };
+    const auto num_owned = get_num_owned_tiles(rank);
+
+    // Unwrap each tile owned by this rank.
+    auto tile_unwrapped = Vector<Array2D<Real>>(num_owned);
+    parallel_for_chunks(0, num_owned, options.num_threads, [&](auto first, auto last) {
+        for (auto k = first; k < last; ++k) {
+            const auto tile = layout.tile(rank + k * num_ranks);
+            const auto tile_phase = load_tile(tile);
+            tile_unwrapped[k] = detail::unwrap_extended_region<Cost, Flow>(
+                    tile_phase, tile, cost_fn);
+        }
+    });
+
+    // Send the unwrapped phase of each owned tile's core region at the margin pixels
+    // of each overlapping tile to the owner of that tile. Messages to each rank are
+    // packed in order of (sending tile, receiving tile).
+    auto send_buffers = Vector<Vector<Real>>(num_ranks);
+    for (std::size_t k = 0; k < num_owned; ++k) {
+        const auto tile_id = rank + k * num_ranks;
+        const auto tile = layout.tile(tile_id);
+        detail::for_each_neighbor_tile(layout, tile_id, [&](auto other_id) {
+            auto& buffer = send_buffers[get_owner(other_id)];
+            const auto other = layout.tile(other_id);
+            detail::for_each_margin_pixel(other, [&](auto i, auto j, auto) {
+                if (tile.core_contains(i, j)) {
+                    buffer.push_back(tile_unwrapped[k](i - tile.row_begin,
+                                                       j - tile.col_begin));
+                }
+            });
+        });
+    }
+
+    auto send_counts = Vector<int>(num_ranks);
+    auto send_displs = Vector<int>(num_ranks);
+    auto send_data = Vector<Real>();
+    for (std::size_t r = 0; r < num_ranks; ++r) {
+        send_counts[r] = detail::mpi_count(std::size(send_buffers[r]));
+        send_displs[r] = detail::mpi_count(std::size(send_data));
+        send_data.insert(std::end(send_data), std::begin(send_buffers[r]),
+                         std::end(send_buffers[r]));
+        send_buffers[r] = {};
+    }
+
+    auto recv_counts = Vector<int>(num_ranks);
+    detail::check_mpi(MPI_Alltoall(std::data(send_counts), 1, MPI_INT,
+                                   std::data(recv_counts), 1, MPI_INT, comm),
+                      "MPI_Alltoall");
+
+    auto recv_displs = Vector<int>(num_ranks);
+    std::size_t recv_size = 0;
+    for (std::size_t r = 0; r < num_ranks; ++r) {
+        recv_displs[r] = detail::mpi_count(recv_size);
+        recv_size += static_cast<std::size_t>(recv_counts[r]);
+    }
+
+    auto recv_data = Vector<Real>(recv_size);
+    const auto datatype = detail::mpi_datatype<Real>();
+    detail::check_mpi(MPI_Alltoallv(std::data(send_data), std::data(send_counts),
+                                    std::data(send_displs), datatype,
+                                    std::data(recv_data), std::data(recv_counts),
+                                    std::data(recv_displs), datatype, comm),
+                      "MPI_Alltoallv");
+    send_data = {};
+
+    // Unpack the neighboring tiles' unwrapped phase at the margin pixels of each owned
+    // tile, in the same order in which it was packed.
+    auto neighbor_phase = Vector<Vector<Real>>(num_owned);
+    for (std::size_t k = 0; k < num_owned; ++k) {
+        const auto tile = layout.tile(rank + k * num_ranks);
+        const auto num_pixels = tile.num_rows() * tile.num_cols();
+        const auto num_core_pixels = (tile.core_row_end - tile.core_row_begin) *
+                                     (tile.core_col_end - tile.core_col_begin);
+        neighbor_phase[k] = Vector<Real>(num_pixels - num_core_pixels);
+    }
+    for (std::size_t r = 0; r < num_ranks; ++r) {
+        auto pos = static_cast<std::size_t>(recv_displs[r]);
+        for (auto tile_id = r; tile_id < num_tiles; tile_id += num_ranks) {
+            const auto tile = layout.tile(tile_id);
+            detail::for_each_neighbor_tile(layout, tile_id, [&](auto other_id) {
+                if (get_owner(other_id) != rank) {
+                    return;
+                }
+                auto& phase = neighbor_phase[other_id / num_ranks];
+                const auto other = layout.tile(other_id);
+                detail::for_each_margin_pixel(other, [&](auto i, auto j, auto m) {
+                    if (tile.core_contains(i, j)) {
+                        WHIRLWIND_DEBUG_ASSERT(pos < std::size(recv_data));
+                        phase[m] = recv_data[pos];
+                        ++pos;
+                    }
+                });
+            });
+        }
+        [[maybe_unused]] const auto recv_end =
+                static_cast<std::size_t>(recv_displs[r] + recv_counts[r]);
+        WHIRLWIND_DEBUG_ASSERT(pos == recv_end);
+    }
+    recv_data = {};
+
+    // Tally the seam votes of each owned tile.
+    auto votes = Vector<SeamVote>();
+    for (std::size_t k = 0; k < num_owned; ++k) {
+        const auto tile_id = rank + k * num_ranks;
+        const auto tile = layout.tile(tile_id);
+        auto tile_votes = Vector<SeamVote>();
+        detail::for_each_margin_pixel(tile, [&](auto i, auto j, auto m) {
+            const auto other_id = layout.get_tile_id(i, j);
+            const auto& unwrapped = tile_unwrapped[k];
+            const auto diff = unwrapped(i - tile.row_begin, j - tile.col_begin) -
+                              neighbor_phase[k][m];
+            detail::add_seam_vote(tile_votes, tile_id, other_id, diff);
+        });
+        votes.insert(std::end(votes), std::begin(tile_votes), std::end(tile_votes));
+        neighbor_phase[k] = {};
+    }
+
+    // Gather the votes on the root rank, packed as (tile0, tile1, offset, count).
+    constexpr std::size_t vote_size = 4;
+    auto packed_votes = Vector<std::int64_t>();
+    packed_votes.reserve(vote_size * std::size(votes));
+    for (const auto& vote : votes) {
+        packed_votes.push_back(static_cast<std::int64_t>(vote.tile0));
+        packed_votes.push_back(static_cast<std::int64_t>(vote.tile1));
+        packed_votes.push_back(vote.offset);
+        packed_votes.push_back(static_cast<std::int64_t>(vote.count));
+    }
+
+    const auto packed_count = detail::mpi_count(std::size(packed_votes));
+    auto gather_counts = Vector<int>(num_ranks);
+    detail::check_mpi(MPI_Gather(&packed_count, 1, MPI_INT, std::data(gather_counts), 1,
+                                 MPI_INT, root, comm),
+                      "MPI_Gather");
+
+    auto gather_displs = Vector<int>(num_ranks);
+    std::size_t gather_size = 0;
+    for (std::size_t r = 0; r < num_ranks; ++r) {
+        gather_displs[r] = detail::mpi_count(gather_size);
+        gather_size += static_cast<std::size_t>(gather_counts[r]);
+    }
+
+    auto all_votes = Vector<std::int64_t>(gather_size);
+    detail::check_mpi(MPI_Gatherv(std::data(packed_votes), packed_count, MPI_INT64_T,
+                                  std::data(all_votes), std::data(gather_counts),
+                                  std::data(gather_displs), MPI_INT64_T, root, comm),
+                      "MPI_Gatherv");
+
+    // Resolve the tile offsets on the root rank and scatter them to their owners,
+    // grouped by rank.
+    auto scatter_counts = Vector<int>(num_ranks);
+    auto scatter_displs = Vector<int>(num_ranks);
+    auto scatter_data = Vector<std::int64_t>();
+    if (mpi_rank == root) {
+        votes.clear();
+        for (std::size_t k = 0; k < std::size(all_votes); k += vote_size) {
+            votes.push_back({static_cast<std::size_t>(all_votes[k]),
+                             static_cast<std::size_t>(all_votes[k + 1]),
+                             all_votes[k + 2],
+                             static_cast<std::size_t>(all_votes[k + 3])});
+        }
+        const auto offset = resolve_tile_offsets(num_tiles, votes);
+
+        scatter_data.reserve(num_tiles);
+        for (std::size_t r = 0; r < num_ranks; ++r) {
+            scatter_counts[r] = detail::mpi_count(get_num_owned_tiles(r));
+            scatter_displs[r] = detail::mpi_count(std::size(scatter_data));
+            for (auto tile_id = r; tile_id < num_tiles; tile_id += num_ranks) {
+                scatter_data.push_back(offset[tile_id]);
+            }
+        }
+    }
+    all_votes = {};
+    votes = {};
+
+    auto tile_offset = Vector<std::int64_t>(num_owned);
+    detail::check_mpi(MPI_Scatterv(std::data(scatter_data), std::data(scatter_counts),
+                                   std::data(scatter_displs), MPI_INT64_T,
+                                   std::data(tile_offset), detail::mpi_count(num_owned),
+                                   MPI_INT64_T, root, comm),
+                      "MPI_Scatterv");
+
+    // Apply the offsets and hand off each tile.
+    for (std::size_t k = 0; k < num_owned; ++k) {
+        const auto tile = layout.tile(rank + k * num_ranks);
+        auto& unwrapped = tile_unwrapped[k];
+        if (tile_offset[k] != 0) {
+            const auto shift = tau<Real>() * static_cast<Real>(tile_offset[k]);
+            for (std::size_t i = 0; i < unwrapped.extent(0); ++i) {
+                for (std::size_t j = 0; j < unwrapped.extent(1); ++j) {
+                    unwrapped(i, j) += shift;
+                }
+            }
+        }
+        std::invoke(store_tile, tile, std::as_const(unwrapped));
+        unwrapped = {};
+    }
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,671 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__HIPCC__)
+#include <hip/hip_runtime.h>
+#elif defined(__CUDACC__)
+#include <cuda_runtime.h>
+#endif
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/cost/statistical_cost.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/util/get_residues.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * Non-owning views of a value associated with each pair of adjacent pixels of a 2-D
+ * raster, laid out as two planar rasters (one per direction).
+ *
+ * For an M x N raster, `down` is an (M-1) x N array whose element (i,j) refers to the
+ * pair of pixels (i,j) and (i+1,j), and `right` is an M x (N-1) array whose element
+ * (i,j) refers to the pair of pixels (i,j) and (i,j+1). It's used to store the net flow
+ * (in cycles) across each pair of pixels and the unwrapped phase gradient between them.
+ *
+ * @tparam T
+ *     The element type.
+ * @tparam LayoutPolicy
+ *     Specifies the layout of each raster in memory.
+ */
+template<class T, class LayoutPolicy = LayoutRight>
+struct PlanarGradients {
+    /** The value between pixel (i,j) and pixel (i+1,j). */
+    Span2D<T, LayoutPolicy> down;
+
+    /** The value between pixel (i,j) and pixel (i,j+1). */
+    Span2D<T, LayoutPolicy> right;
+};
+
+/**
+ * Launches raster kernels on the calling thread (and, optionally, additional threads).
+ *
+ * A launcher is a callable object that, given a number of rows and columns and a
+ * kernel, invokes `kernel(i, j)` once for each index (i,j) of a `rows` x `cols` grid in
+ * an unspecified order, possibly concurrently. The `launch_*()` functions below use a
+ * launcher to run each per-element kernel, so the same kernels may be run on the host
+ * or (via `DeviceLauncher`) on a GPU.
+ *
+ * `HostLauncher` distributes blocks of rows across up to `num_threads` threads and
+ * returns after every invocation has finished.
+ */
+struct HostLauncher {
+    /**
+     * The maximum number of threads to use, including the calling thread. Must be at
+     * least 1.
+     */
+    std::size_t num_threads = 1;
+
+    template<class Kernel>
+    void
+    operator()(std::size_t rows, std::size_t cols, const Kernel& kernel) const
+    {
+        const auto launch_rows = [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i) {
+                for (std::size_t j = 0; j < cols; ++j) {
+                    kernel(i, j);
+                }
+            }
+        };
+        parallel_for_chunks(0, rows, num_threads, launch_rows);
+    }
+};
+
+#if defined(__CUDACC__) || defined(__HIPCC__)
+
+namespace detail {
+
+#if defined(__HIPCC__)
+using device_stream_type = hipStream_t;
+
+// Throw an exception if the most recent kernel launch failed.
+inline void
+check_kernel_launch()
+{
+    if (const auto error = hipGetLastError(); error != hipSuccess) {
+        throw std::runtime_error(hipGetErrorString(error));
+    }
+}
+#else
+using device_stream_type = cudaStream_t;
+
+// Throw an exception if the most recent kernel launch failed.
+inline void
+check_kernel_launch()
+{
+    if (const auto error = cudaGetLastError(); error != cudaSuccess) {
+        throw std::runtime_error(cudaGetErrorString(error));
+    }
+}
+#endif
+
+// Invoke `kernel(i, j)` for each index of a `rows` x `cols` grid. Each thread handles
+// one column of a block and strides over rows, since the number of blocks in the
+// y-dimension of the launch grid is limited.
+template<class Kernel>
+__global__ void
+launch_kernel_2d(std::size_t rows, std::size_t cols, Kernel kernel)
+{
+    const auto j = std::size_t{blockIdx.x} * blockDim.x + threadIdx.x;
+    if (j >= cols) {
+        return;
+    }
+    const auto stride = std::size_t{gridDim.y} * blockDim.y;
+    for (auto i = std::size_t{blockIdx.y} * blockDim.y + threadIdx.y; i < rows;
+         i += stride) {
+        kernel(i, j);
+    }
+}
+
+} // namespace detail
+
+/**
+ * Launches raster kernels on a CUDA or HIP device.
+ *
+ * Each kernel is launched asynchronously on a stream, with one device thread per
+ * column (and one or more rows) of the grid. Kernels launched on the same stream run in
+ * order. Every array accessed by a kernel must be device-accessible (e.g. a `Span2D`
+ * viewing device or managed memory), and the caller must synchronize with the stream
+ * before reading the results on the host.
+ *
+ * Only available when compiling with a CUDA or HIP compiler. With nvcc, the
+ * `--expt-relaxed-constexpr` flag is required, since the kernels call `constexpr`
+ * host functions (e.g. `std::clamp()`).
+ */
+struct DeviceLauncher {
+    /** The stream on which kernels are launched. Defaults to the default stream. */
+    detail::device_stream_type stream = nullptr;
+
+    /**
+     * Throw an exception if a kernel launch failed.
+     *
+     * @throws std::runtime_error
+     *     If the kernel could not be launched.
+     */
+    template<class Kernel>
+    void
+    operator()(std::size_t rows, std::size_t cols, const Kernel& kernel) const
+    {
+        if ((rows == 0) || (cols == 0)) {
+            return;
+        }
+
+        constexpr auto block_cols = 32U;
+        constexpr auto block_rows = 8U;
+        constexpr auto max_grid_rows = std::size_t{65535};
+        const auto grid_cols = (cols + block_cols - 1) / block_cols;
+        const auto grid_rows =
+                std::min((rows + block_rows - 1) / block_rows, max_grid_rows);
+
+        const auto grid = dim3(static_cast<unsigned>(grid_cols),
+                               static_cast<unsigned>(grid_rows));
+        const auto block = dim3(block_cols, block_rows);
+        detail::launch_kernel_2d<<<grid, block, 0, stream>>>(rows, cols, kernel);
+        detail::check_kernel_launch();
+    }
+};
+
+#endif
+
+namespace detail {
+
+// Computes the residue of node (r,c) of the (M+1) x (N+1) residue grid of an M x N
+// wrapped phase array. In terms of the residual cycles `v(i,j)` between pixels (i,j)
+// and (i+1,j), and `h(i,j)` between pixels (i,j) and (i,j+1), each node gathers
+//
+//   v(r-1,c) - v(r-1,c-1) + h(r,c-1) - h(r-1,c-1)
+//
+// where out-of-bounds terms are zero (see `ResidueRowKernel`). Each node is computed
+// independently from the (at most) four pixels around it.
+template<class PhaseSpan, class ResidueSpan>
+struct ResidueKernel {
+    PhaseSpan wrapped_phase;
+    ResidueSpan residues;
+
+    WHIRLWIND_HOST_DEVICE constexpr void
+    operator()(std::size_t r, std::size_t c) const
+    {
+        using SignedInteger = typename ResidueSpan::value_type;
+
+        const auto& psi = wrapped_phase;
+        const auto m = static_cast<std::size_t>(psi.extent(0));
+        const auto n = static_cast<std::size_t>(psi.extent(1));
+
+        const auto v = [&](std::size_t i, std::size_t j) {
+            return get_cycle_diff_residual<SignedInteger>(psi(i, j), psi(i + 1, j));
+        };
+        const auto h = [&](std::size_t i, std::size_t j) {
+            return get_cycle_diff_residual<SignedInteger>(psi(i, j + 1), psi(i, j));
+        };
+
+        auto residue = 0;
+        const auto has_v = (r >= 1) && (r < m);
+        if (has_v && (c < n)) {
+            residue += v(r - 1, c);
+        }
+        if (has_v && (c >= 1)) {
+            residue -= v(r - 1, c - 1);
+        }
+        if ((c >= 1) && (c < n)) {
+            if (r < m) {
+                residue += h(r, c - 1);
+            }
+            if (r >= 1) {
+                residue -= h(r - 1, c - 1);
+            }
+        }
+        residues(r, c) = static_cast<SignedInteger>(residue);
+    }
+};
+
+// Computes the statistical costs of the arcs incident on node (r,c) of the (M+1) x
+// (N+1) residue grid: the up and down arcs in column `c` of row `r` (if `r` < M), and
+// the left and right arcs in row `r` of column `c` (if `c` < N). The costs match those
+// of `compute_statistical_costs()` exactly.
+template<class PhaseSpan, class CoherenceSpan, class Cost, class LayoutPolicy>
+struct StatisticalCostKernel {
+    PhaseSpan wrapped_phase;
+    CoherenceSpan coherence;
+    PlanarGridCosts<Cost, LayoutPolicy> cost;
+    StatisticalCostOptions options;
+    Cost border_cost;
+
+    WHIRLWIND_HOST_DEVICE constexpr void
+    operator()(std::size_t r, std::size_t c) const
+    {
+        const auto& psi = wrapped_phase;
+        const auto m = static_cast<std::size_t>(psi.extent(0));
+        const auto n = static_cast<std::size_t>(psi.extent(1));
+
+        const auto var = [&](std::size_t i, std::size_t j) {
+            return get_phase_variance(coherence(i, j), options);
+        };
+
+        // The down (up) arcs in row `r` cross the rightward (leftward) phase gradient
+        // between adjacent pixels in input row `r`.
+        if (r < m) {
+            if ((c == 0) || (c == n)) {
+                cost.up(r, c) = border_cost;
+                cost.down(r, c) = border_cost;
+            } else {
+                const auto v = var(r, c) + var(r, c - 1);
+                const auto& psi1 = psi(r, c);
+                const auto& psi0 = psi(r, c - 1);
+                cost.down(r, c) =
+                        get_statistical_arc_cost<Cost>(psi1, psi0, v, 1.0, options);
+                cost.up(r, c) =
+                        get_statistical_arc_cost<Cost>(psi1, psi0, v, -1.0, options);
+            }
+        }
+
+        // The left (right) arcs in row `r` cross the downward (upward) phase gradient
+        // between input rows `r - 1` and `r`.
+        if (c < n) {
+            if ((r == 0) || (r == m)) {
+                cost.left(r, c) = border_cost;
+                cost.right(r, c) = border_cost;
+            } else {
+                const auto v = var(r, c) + var(r - 1, c);
+                const auto& psi1 = psi(r, c);
+                const auto& psi0 = psi(r - 1, c);
+                cost.left(r, c) =
+                        get_statistical_arc_cost<Cost>(psi1, psi0, v, 1.0, options);
+                cost.right(r, c) =
+                        get_statistical_arc_cost<Cost>(psi1, psi0, v, -1.0, options);
+            }
+        }
+    }
+};
+
+// Computes the unwrapped phase gradients from pixel (i,j) to each of its neighbors
+// below and to the right, as the wrapped phase gradient plus the net flow (in cycles)
+// across the pair of pixels.
+template<class PhaseSpan,
+         class Flow,
+         class FlowLayout,
+         class Real,
+         class GradientLayout>
+struct UnwrappedGradientKernel {
+    PhaseSpan wrapped_phase;
+    PlanarGradients<Flow, FlowLayout> net_flow;
+    PlanarGradients<Real, GradientLayout> gradient;
+
+    WHIRLWIND_HOST_DEVICE constexpr void
+    operator()(std::size_t i, std::size_t j) const
+    {
+        const auto& psi = wrapped_phase;
+        const auto m = static_cast<std::size_t>(psi.extent(0));
+        const auto n = static_cast<std::size_t>(psi.extent(1));
+
+        if (i + 1 < m) {
+            const auto dpsi = get_wrapped_diff<Real>(psi(i + 1, j), psi(i, j));
+            const auto k = static_cast<Real>(net_flow.down(i, j));
+            gradient.down(i, j) = dpsi + tau<Real>() * k;
+        }
+        if (j + 1 < n) {
+            const auto dpsi = get_wrapped_diff<Real>(psi(i, j + 1), psi(i, j));
+            const auto k = static_cast<Real>(net_flow.right(i, j));
+            gradient.right(i, j) = dpsi + tau<Real>() * k;
+        }
+    }
+};
+
+// Integrates the unwrapped phase gradients down the first column, starting from the
+// top-left pixel (whose unwrapped phase is equal to its wrapped phase). Launched on a
+// 1 x 1 grid.
+template<class Accumulator,
+         class PhaseSpan,
+         class Real,
+         class GradientLayout,
+         class OutSpan>
+struct IntegrateColumnKernel {
+    PhaseSpan wrapped_phase;
+    PlanarGradients<Real, GradientLayout> gradient;
+    OutSpan unwrapped_phase;
+
+    WHIRLWIND_HOST_DEVICE constexpr void
+    operator()(std::size_t, std::size_t) const
+    {
+        using T = typename OutSpan::value_type;
+        const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+
+        unwrapped_phase(0, 0) = static_cast<T>(wrapped_phase(0, 0));
+        auto phi = Accumulator{unwrapped_phase(0, 0)};
+        for (std::size_t i = 1; i < m; ++i) {
+            phi += Accumulator{gradient.down(i - 1, 0)};
+            unwrapped_phase(i, 0) = static_cast<T>(phi);
+        }
+    }
+};
+
+// Integrates the unwrapped phase gradients across row `i`, starting from its first
+// pixel. Launched on an M x 1 grid, after `IntegrateColumnKernel`.
+template<class Accumulator, class Real, class GradientLayout, class OutSpan>
+struct IntegrateRowKernel {
+    PlanarGradients<Real, GradientLayout> gradient;
+    OutSpan unwrapped_phase;
+
+    WHIRLWIND_HOST_DEVICE constexpr void
+    operator()(std::size_t i, std::size_t) const
+    {
+        using T = typename OutSpan::value_type;
+        const auto n = static_cast<std::size_t>(unwrapped_phase.extent(1));
+
+        auto phi = Accumulator{unwrapped_phase(i, 0)};
+        for (std::size_t j = 1; j < n; ++j) {
+            phi += Accumulator{gradient.right(i, j - 1)};
+            unwrapped_phase(i, j) = static_cast<T>(phi);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * Compute the residues of a 2-D wrapped phase array using a raster kernel launcher.
+ *
+ * The result is identical to `get_residues()`. Each node of the residue grid is
+ * computed independently by one invocation of the kernel, so the arrays may reside on
+ * a GPU (see `DeviceLauncher`), and only the residues need to be copied back to the
+ * host to form the network.
+ *
+ * @param[in] launch
+ *     The kernel launcher (e.g. `HostLauncher` or `DeviceLauncher`).
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[out] residues
+ *     The (M+1) x (N+1) output array of residues.
+ */
+template<class Launcher,
+         class Real,
+         class PhaseLayout,
+         class SignedInteger,
+         class ResidueLayout>
+void
+launch_residues(Launcher&& launch,
+                Span2D<Real, PhaseLayout> wrapped_phase,
+                Span2D<SignedInteger, ResidueLayout> residues)
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_signed_v<SignedInteger> &&
+                            std::is_integral_v<SignedInteger>);
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(residues.extent(0) == m + 1);
+    WHIRLWIND_ASSERT(residues.extent(1) == n + 1);
+
+    using Kernel = detail::ResidueKernel<Span2D<Real, PhaseLayout>,
+                                         Span2D<SignedInteger, ResidueLayout>>;
+    launch(m + 1, n + 1, Kernel{wrapped_phase, residues});
+}
+
+/**
+ * Compute statistical arc costs of a grid network using a raster kernel launcher.
+ *
+ * The result is identical to `get_statistical_costs()`. The arcs incident on each node
+ * of the residue grid are computed independently by one invocation of the kernel, so
+ * the arrays may reside on a GPU (see `DeviceLauncher`), and only the costs need to be
+ * copied back to the host to form the network.
+ *
+ * @param[in] launch
+ *     The kernel launcher (e.g. `HostLauncher` or `DeviceLauncher`).
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[in] coherence
+ *     The M x N coherence array, with values in the interval [0, 1].
+ * @param[out] cost
+ *     The output cost rasters.
+ * @param[in] options
+ *     The cost model options.
+ */
+template<class Launcher,
+         class Real,
+         class PhaseLayout,
+         class Coherence,
+         class CoherenceLayout,
+         class Cost,
+         class LayoutPolicy>
+void
+launch_statistical_costs(Launcher&& launch,
+                         Span2D<Real, PhaseLayout> wrapped_phase,
+                         Span2D<Coherence, CoherenceLayout> coherence,
+                         const PlanarGridCosts<Cost, LayoutPolicy>& cost,
+                         const StatisticalCostOptions& options = {})
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<std::remove_cv_t<Real>>);
+    WHIRLWIND_STATIC_ASSERT(std::is_arithmetic_v<Cost>);
+
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(coherence.extent(0) == m);
+    WHIRLWIND_ASSERT(coherence.extent(1) == n);
+    WHIRLWIND_ASSERT(cost.up.extent(0) == m);
+    WHIRLWIND_ASSERT(cost.up.extent(1) == n + 1);
+    WHIRLWIND_ASSERT(cost.down.extent(0) == m);
+    WHIRLWIND_ASSERT(cost.down.extent(1) == n + 1);
+    WHIRLWIND_ASSERT(cost.left.extent(0) == m + 1);
+    WHIRLWIND_ASSERT(cost.left.extent(1) == n);
+    WHIRLWIND_ASSERT(cost.right.extent(0) == m + 1);
+    WHIRLWIND_ASSERT(cost.right.extent(1) == n);
+    detail::check_statistical_cost_options<Cost>(options);
+
+    const auto border_cost = detail::to_arc_cost<Cost>(options.border_cost, options);
+
+    using Kernel = detail::StatisticalCostKernel<Span2D<Real, PhaseLayout>,
+                                                 Span2D<Coherence, CoherenceLayout>,
+                                                 Cost, LayoutPolicy>;
+    launch(m + 1, n + 1, Kernel{wrapped_phase, coherence, cost, options, border_cost});
+}
+
+/**
+ * Get the net flow across each pair of adjacent pixels from a minimum cost flow
+ * solution.
+ *
+ * The net flow across a pair of pixels is the net flow (in cycles) on the arcs between
+ * the two residues that border the pair, i.e. the difference between the unwrapped and
+ * wrapped phase gradients between the pixels (see `integrate_unwrapped_gradients()`).
+ * This is the only data that must be copied to a GPU after the network is solved on
+ * the host in order to compute the unwrapped phase there (see
+ * `launch_unwrapped_gradients()`).
+ *
+ * @param[in] network
+ *     The solved network on the (M+1) x (N+1) grid of residues.
+ * @param[out] net_flow
+ *     The output net flow across each pair of adjacent pixels of the M x N raster.
+ * @param[in] num_threads
+ *     The maximum number of threads to use, including the calling thread. Must be at
+ *     least 1. Defaults to 1.
+ */
+template<class Dim,
+         class Cost,
+         class Flow,
+         // clang-format off
+         template<class> class Container,
+         // clang-format on
+         class Mixin,
+         class T,
+         class LayoutPolicy>
+void
+get_planar_net_flow(
+        const Network<RectangularGridGraph<1, Dim>, Cost, Flow, Container, Mixin>&
+                network,
+        const PlanarGradients<T, LayoutPolicy>& net_flow,
+        std::size_t num_threads = 1)
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_signed_v<Flow>);
+
+    const auto& residual_graph = network.residual_graph();
+    const auto m = static_cast<std::size_t>(residual_graph.num_rows()) - 1;
+    const auto n = static_cast<std::size_t>(residual_graph.num_cols()) - 1;
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(net_flow.down.extent(0) == m - 1);
+    WHIRLWIND_ASSERT(net_flow.down.extent(1) == n);
+    WHIRLWIND_ASSERT(net_flow.right.extent(0) == m);
+    WHIRLWIND_ASSERT(net_flow.right.extent(1) == n - 1);
+
+    using Vertex = typename Network<RectangularGridGraph<1, Dim>, Cost, Flow, Container,
+                                    Mixin>::node_type;
+
+    const auto get_rows = [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            // The net leftward flow between the two residues that border the edge
+            // between pixels (i,j) and (i+1,j).
+            if (i + 1 < m) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    const auto node0 = Vertex(i + 1, j);
+                    const auto node1 = Vertex(i + 1, j + 1);
+                    const auto arc0 = residual_graph.get_right_edge(node0);
+                    const auto arc1 = residual_graph.get_left_edge(node1);
+                    net_flow.down(i, j) = static_cast<T>(network.arc_flow(arc1) -
+                                                         network.arc_flow(arc0));
+                }
+            }
+
+            // The net downward flow between the two residues that border the edge
+            // between pixels (i,j) and (i,j+1).
+            for (std::size_t j = 0; j + 1 < n; ++j) {
+                const auto node0 = Vertex(i, j + 1);
+                const auto node1 = Vertex(i + 1, j + 1);
+                const auto arc0 = residual_graph.get_down_edge(node0);
+                const auto arc1 = residual_graph.get_up_edge(node1);
+                net_flow.right(i, j) = static_cast<T>(network.arc_flow(arc0) -
+                                                      network.arc_flow(arc1));
+            }
+        }
+    };
+    parallel_for_chunks(0, m, num_threads, get_rows);
+}
+
+/**
+ * Compute the unwrapped phase gradient between each pair of adjacent pixels using a
+ * raster kernel launcher.
+ *
+ * The unwrapped phase gradient is the wrapped phase gradient plus the net flow (in
+ * cycles) across the pair of pixels (see `get_planar_net_flow()`). Each pixel is
+ * computed independently by one invocation of the kernel, so the arrays may reside on
+ * a GPU (see `DeviceLauncher`).
+ *
+ * @param[in] launch
+ *     The kernel launcher (e.g. `HostLauncher` or `DeviceLauncher`).
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[in] net_flow
+ *     The net flow across each pair of adjacent pixels.
+ * @param[out] gradient
+ *     The output unwrapped phase gradient between each pair of adjacent pixels.
+ */
+template<class Launcher,
+         class Real,
+         class PhaseLayout,
+         class Flow,
+         class FlowLayout,
+         class Gradient,
+         class GradientLayout>
+void
+launch_unwrapped_gradients(Launcher&& launch,
+                           Span2D<Real, PhaseLayout> wrapped_phase,
+                           const PlanarGradients<Flow, FlowLayout>& net_flow,
+                           const PlanarGradients<Gradient, GradientLayout>& gradient)
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_same_v<std::remove_cv_t<Real>, Gradient>);
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<Gradient>);
+
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(net_flow.down.extent(0) == m - 1);
+    WHIRLWIND_ASSERT(net_flow.down.extent(1) == n);
+    WHIRLWIND_ASSERT(net_flow.right.extent(0) == m);
+    WHIRLWIND_ASSERT(net_flow.right.extent(1) == n - 1);
+    WHIRLWIND_ASSERT(gradient.down.extent(0) == m - 1);
+    WHIRLWIND_ASSERT(gradient.down.extent(1) == n);
+    WHIRLWIND_ASSERT(gradient.right.extent(0) == m);
+    WHIRLWIND_ASSERT(gradient.right.extent(1) == n - 1);
+
+    using Kernel =
+            detail::UnwrappedGradientKernel<Span2D<Real, PhaseLayout>, Flow, FlowLayout,
+                                            Gradient, GradientLayout>;
+    launch(m, n, Kernel{wrapped_phase, net_flow, gradient});
+}
+
+/**
+ * Integrate unwrapped phase gradients using a raster kernel launcher.
+ *
+ * Gradients are accumulated down the first column, starting from the top-left pixel
+ * (whose unwrapped phase is equal to its wrapped phase), and then across each row, in
+ * the same order as `integrate_unwrapped_gradients()`, which this reproduces exactly
+ * given the gradients computed by `launch_unwrapped_gradients()`. The first column is
+ * integrated by a single invocation of one kernel, and then each row by one invocation
+ * of a second kernel, so the launcher must run successive launches in order (e.g. on
+ * the same stream).
+ *
+ * @tparam Accumulator
+ *     The floating-point type used to accumulate the unwrapped phase gradients.
+ *
+ * @param[in] launch
+ *     The kernel launcher (e.g. `HostLauncher` or `DeviceLauncher`).
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array, with values in the interval [-pi, pi]. Must have
+ *     at least one row and column.
+ * @param[in] gradient
+ *     The unwrapped phase gradient between each pair of adjacent pixels.
+ * @param[out] unwrapped_phase
+ *     The M x N output unwrapped phase array.
+ */
+template<class Accumulator = double,
+         class Launcher,
+         class Real,
+         class PhaseLayout,
+         class Gradient,
+         class GradientLayout,
+         class T,
+         class LayoutPolicy>
+void
+launch_integrate_gradients(Launcher&& launch,
+                           Span2D<Real, PhaseLayout> wrapped_phase,
+                           const PlanarGradients<Gradient, GradientLayout>& gradient,
+                           Span2D<T, LayoutPolicy> unwrapped_phase)
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<Accumulator>);
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<T>);
+
+    const auto m = static_cast<std::size_t>(wrapped_phase.extent(0));
+    [[maybe_unused]] const auto n = static_cast<std::size_t>(wrapped_phase.extent(1));
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(gradient.down.extent(0) == m - 1);
+    WHIRLWIND_ASSERT(gradient.down.extent(1) == n);
+    WHIRLWIND_ASSERT(gradient.right.extent(0) == m);
+    WHIRLWIND_ASSERT(gradient.right.extent(1) == n - 1);
+    WHIRLWIND_ASSERT(unwrapped_phase.extent(0) == m);
+    WHIRLWIND_ASSERT(unwrapped_phase.extent(1) == n);
+
+    using OutSpan = Span2D<T, LayoutPolicy>;
+    using ColumnKernel =
+            detail::IntegrateColumnKernel<Accumulator, Span2D<Real, PhaseLayout>,
+                                          Gradient, GradientLayout, OutSpan>;
+    using RowKernel =
+            detail::IntegrateRowKernel<Accumulator, Gradient, GradientLayout, OutSpan>;
+    launch(1, 1, ColumnKernel{wrapped_phase, gradient, unwrapped_phase});
+    launch(m, 1, RowKernel{gradient, unwrapped_phase});
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,547 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/algorithm/sort.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/rank_bitmap.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/network/network.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** Options for `SparseResidueNetwork`. */
+struct SparseResidueOptions {
+    /**
+     * The number of grid steps along each side of a coarse cell. The boundaries of the
+     * coarse cells form the highways of the sparse network.
+     */
+    std::size_t cell_size = 32;
+    /**
+     * The number of coarse cells around each cell containing a residue that are also
+     * represented at full resolution.
+     */
+    std::size_t halo = 1;
+};
+
+/**
+ * A reduced minimum cost flow network for phase unwrapping with sparse residues.
+ *
+ * The residues of an M x N wrapped phase array form an (M+1) x (N+1) grid of nodes,
+ * most of which typically have zero charge. This network keeps the full grid only near
+ * residues and represents the rest of the grid by a coarse "highway" network.
+ *
+ * The grid is partitioned into square coarse cells of `cell_size` x `cell_size` grid
+ * steps. Each cell that contains a residue, or is within `halo` cells of one, is dense:
+ * all of the grid nodes in the cell (including those on its boundary) and the grid
+ * edges between them are kept. The boundaries of all cells form a lattice of grid
+ * rows and columns; along each of these, consecutive kept nodes (the lattice
+ * intersections and the dense nodes) are joined by a single highway edge whose cost is
+ * the total cost of the straight run of grid edges between them. Every dense cell
+ * touches the highways, so the network is connected.
+ *
+ * Each edge of the sparse network thus represents a straight path of one or more
+ * edges in the full grid. After the sparse network is solved, its flows may be mapped
+ * back onto a full grid network with `expand_flows()`, e.g. in order to integrate the
+ * unwrapped phase gradients using `integrate_unwrapped_gradients()`. Since every edge
+ * maps to a path with the same cost, the resulting full grid flow is feasible and has
+ * the same cost as the sparse solution, though it may not be optimal for the full
+ * grid.
+ *
+ * @tparam Cost
+ *     The arc cost type.
+ * @tparam Flow
+ *     The flow type.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the network and its mapping
+ *     onto the full grid.
+ */
+template<class Cost = int, class Flow = int, template<class> class Container = Vector>
+class SparseResidueNetwork {
+public:
+    using graph_type = CSRGraph<Container>;
+    using network_type = Network<graph_type, Cost, Flow, Container>;
+    using grid_graph_type = RectangularGridGraph<1, std::size_t>;
+    using grid_vertex_type = typename grid_graph_type::vertex_type;
+    using node_type = typename network_type::node_type;
+    using cost_type = Cost;
+    using flow_type = Flow;
+    using size_type = std::size_t;
+
+    template<class T>
+    using container_type = Container<T>;
+
+    /**
+     * Create a new `SparseResidueNetwork`.
+     *
+     * @param[in] residues
+     *     The (M+1) x (N+1) array of residues (e.g. from `get_residues()`), which
+     *     gives the surplus of each node in the full grid. Must have at least two rows
+     *     and two columns.
+     * @param[in] cost
+     *     A random-access range of the unit cost of each edge in the full grid, indexed
+     *     by the edge IDs of a `RectangularGridGraph<1>` of the same shape as
+     *     `residues`. Infinite costs (see `infinity()`) are propagated to the highway
+     *     edges whose paths contain them.
+     * @param[in] options
+     *     The size of the coarse cells and of the dense region around each residue.
+     */
+    template<class ArrayLike2D, class RandomAccessRange>
+    SparseResidueNetwork(const ArrayLike2D& residues,
+                         const RandomAccessRange& cost,
+                         const SparseResidueOptions& options = {})
+        : grid_(residues.extent(0), residues.extent(1)),
+          cell_size_(options.cell_size),
+          num_cell_rows_(num_cells(grid_.num_rows(), options.cell_size)),
+          num_cell_cols_(num_cells(grid_.num_cols(), options.cell_size)),
+          dense_cell_(make_dense_cells(residues, options.halo)),
+          kept_(make_kept_nodes()),
+          grid_node_(make_grid_nodes()),
+          network_(make_network(residues, cost))
+    {}
+
+    /** The sparse network. */
+    [[nodiscard]] constexpr auto
+    network() noexcept -> network_type&
+    {
+        return network_;
+    }
+
+    /** The sparse network. */
+    [[nodiscard]] constexpr auto
+    network() const noexcept -> const network_type&
+    {
+        return network_;
+    }
+
+    /** The full grid of nodes represented by the sparse network. */
+    [[nodiscard]] constexpr auto
+    grid() const noexcept -> const grid_graph_type&
+    {
+        return grid_;
+    }
+
+    /**
+     * Get the full grid node corresponding to a node in the sparse network.
+     *
+     * @param[in] node
+     *     A node in the sparse network.
+     *
+     * @returns
+     *     The (row,col) index of the node in the full grid.
+     */
+    [[nodiscard]] constexpr auto
+    get_grid_vertex(const node_type& node) const -> grid_vertex_type
+    {
+        const auto node_id = network_.get_node_id(node);
+        WHIRLWIND_ASSERT(node_id < std::size(grid_node_));
+        return to_grid_vertex(grid_node_[node_id]);
+    }
+
+    /**
+     * Check whether a full grid node is represented in the sparse network.
+     *
+     * @param[in] vertex
+     *     The (row,col) index of a node in the full grid.
+     *
+     * @returns
+     *     True if the sparse network contains the node; otherwise false.
+     */
+    [[nodiscard]] constexpr auto
+    contains_grid_vertex(const grid_vertex_type& vertex) const -> bool
+    {
+        WHIRLWIND_ASSERT(grid_.contains_vertex(vertex));
+        return kept_.test(grid_.get_vertex_id(vertex));
+    }
+
+    /**
+     * Map the flows in the sparse network onto a network over the full grid.
+     *
+     * The flow on each edge of the sparse network is added to each edge along the
+     * corresponding path in the full grid, and the excess at each end of the path is
+     * updated. If `grid_network` was created with the same surplus as the sparse
+     * network and carries no flow, the sparse network's flow balances it exactly when
+     * the sparse network is balanced.
+     *
+     * @param[in,out] grid_network
+     *     A network over a grid with the same shape as the full grid.
+     */
+    template<class Dim,
+             class GridCost,
+             class GridFlow,
+             template<class>
+             class GridContainer,
+             class Mixin>
+    constexpr void
+    expand_flows(Network<RectangularGridGraph<1, Dim>,
+                         GridCost,
+                         GridFlow,
+                         GridContainer,
+                         Mixin>& grid_network) const
+    {
+        using GridNetwork = std::remove_cvref_t<decltype(grid_network)>;
+        using GridNode = typename GridNetwork::node_type;
+        using GridArc = typename GridNetwork::arc_type;
+
+        WHIRLWIND_ASSERT(grid_network.residual_graph().num_rows() == grid_.num_rows());
+        WHIRLWIND_ASSERT(grid_network.residual_graph().num_cols() == grid_.num_cols());
+
+        for (const auto& arc : network_.forward_arcs()) {
+            const auto flow = static_cast<GridFlow>(network_.arc_flow(arc));
+            if (flow == zero<GridFlow>()) {
+                continue;
+            }
+
+            const auto edge_id = network_.get_edge_id(arc);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(paths_));
+            const auto& path = paths_[edge_id];
+
+            auto vertex = to_grid_vertex(path.first);
+            for (size_type k = 0; k < path.length; ++k) {
+                const auto edge = get_grid_edge(vertex, path.direction);
+                const auto arc_id =
+                        grid_network.get_residual_graph_arc_id(grid_.get_edge_id(edge));
+                grid_network.increase_arc_flow(static_cast<GridArc>(arc_id), flow);
+                vertex = step(vertex, path.direction);
+            }
+
+            const auto tail = to_grid_vertex(path.first);
+            grid_network.decrease_node_excess(GridNode(tail.first, tail.second), flow);
+            grid_network.increase_node_excess(GridNode(vertex.first, vertex.second),
+                                              flow);
+        }
+    }
+
+private:
+    // The direction of a straight path in the full grid.
+    enum class Direction : std::uint8_t { up, left, down, right };
+
+    // A straight path of `length` edges in the full grid, starting at the node with ID
+    // `first`.
+    struct GridPath {
+        size_type first;
+        size_type length;
+        Direction direction;
+    };
+
+    // The number of coarse cells spanning `num_nodes` nodes (`num_nodes - 1` steps).
+    [[nodiscard]] static constexpr auto
+    num_cells(size_type num_nodes, size_type cell_size) -> size_type
+    {
+        WHIRLWIND_ASSERT(num_nodes >= 2);
+        WHIRLWIND_ASSERT(cell_size >= 1);
+        return (num_nodes - 2) / cell_size + 1;
+    }
+
+    // The closed range of coarse cells whose closed extent contains the node at index
+    // `i` along an axis with `num_cells` cells.
+    [[nodiscard]] constexpr auto
+    get_cell_range(size_type i, size_type num_cells) const
+            -> std::pair<size_type, size_type>
+    {
+        const auto hi = std::min(i / cell_size_, num_cells - 1);
+        const auto lo = ((i % cell_size_ == 0) && (i != 0)) ? i / cell_size_ - 1 : hi;
+        return {std::min(lo, hi), hi};
+    }
+
+    // Check whether the node at index `i` along an axis with `num_nodes` nodes lies on
+    // a cell boundary.
+    [[nodiscard]] constexpr auto
+    is_lattice_line(size_type i, size_type num_nodes) const noexcept -> bool
+    {
+        return (i % cell_size_ == 0) || (i + 1 == num_nodes);
+    }
+
+    [[nodiscard]] constexpr auto
+    is_dense_cell(size_type ci, size_type cj) const -> bool
+    {
+        WHIRLWIND_DEBUG_ASSERT(ci < num_cell_rows_);
+        WHIRLWIND_DEBUG_ASSERT(cj < num_cell_cols_);
+        return dense_cell_[ci * num_cell_cols_ + cj] != 0;
+    }
+
+    // Check whether a grid node belongs to any dense cell.
+    [[nodiscard]] constexpr auto
+    is_dense_node(size_type i, size_type j) const -> bool
+    {
+        const auto [ci0, ci1] = get_cell_range(i, num_cell_rows_);
+        const auto [cj0, cj1] = get_cell_range(j, num_cell_cols_);
+        for (auto ci = ci0; ci <= ci1; ++ci) {
+            for (auto cj = cj0; cj <= cj1; ++cj) {
+                if (is_dense_cell(ci, cj)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] constexpr auto
+    is_kept_node(size_type i, size_type j) const -> bool
+    {
+        const auto on_lattice = is_lattice_line(i, grid_.num_rows()) &&
+                                is_lattice_line(j, grid_.num_cols());
+        return on_lattice || is_dense_node(i, j);
+    }
+
+    [[nodiscard]] constexpr auto
+    to_grid_vertex(size_type vertex_id) const noexcept -> grid_vertex_type
+    {
+        return {vertex_id / grid_.num_cols(), vertex_id % grid_.num_cols()};
+    }
+
+    [[nodiscard]] static constexpr auto
+    step(const grid_vertex_type& vertex, Direction direction) -> grid_vertex_type
+    {
+        switch (direction) {
+        case Direction::up:
+            return {vertex.first - 1, vertex.second};
+        case Direction::left:
+            return {vertex.first, vertex.second - 1};
+        case Direction::down:
+            return {vertex.first + 1, vertex.second};
+        default:
+            return {vertex.first, vertex.second + 1};
+        }
+    }
+
+    [[nodiscard]] static constexpr auto
+    reverse(Direction direction) noexcept -> Direction
+    {
+        switch (direction) {
+        case Direction::up:
+            return Direction::down;
+        case Direction::left:
+            return Direction::right;
+        case Direction::down:
+            return Direction::up;
+        default:
+            return Direction::left;
+        }
+    }
+
+    [[nodiscard]] constexpr auto
+    get_grid_edge(const grid_vertex_type& vertex, Direction direction) const
+    {
+        switch (direction) {
+        case Direction::up:
+            return grid_.get_up_edge(vertex);
+        case Direction::left:
+            return grid_.get_left_edge(vertex);
+        case Direction::down:
+            return grid_.get_down_edge(vertex);
+        default:
+            return grid_.get_right_edge(vertex);
+        }
+    }
+
+    // Mark each coarse cell within `halo` cells of a cell containing a residue.
+    template<class ArrayLike2D>
+    [[nodiscard]] auto
+    make_dense_cells(const ArrayLike2D& residues, size_type halo) const
+            -> container_type<unsigned char>
+    {
+        auto dense = container_type<unsigned char>(num_cell_rows_ * num_cell_cols_, 0);
+        for (size_type i = 0; i < grid_.num_rows(); ++i) {
+            for (size_type j = 0; j < grid_.num_cols(); ++j) {
+                if (residues(i, j) == 0) {
+                    continue;
+                }
+
+                const auto [ci0, ci1] = get_cell_range(i, num_cell_rows_);
+                const auto [cj0, cj1] = get_cell_range(j, num_cell_cols_);
+                const auto ci_begin = (ci0 >= halo) ? ci0 - halo : 0;
+                const auto cj_begin = (cj0 >= halo) ? cj0 - halo : 0;
+                const auto ci_end = std::min(ci1 + halo + 1, num_cell_rows_);
+                const auto cj_end = std::min(cj1 + halo + 1, num_cell_cols_);
+                for (auto ci = ci_begin; ci < ci_end; ++ci) {
+                    for (auto cj = cj_begin; cj < cj_end; ++cj) {
+                        dense[ci * num_cell_cols_ + cj] = 1;
+                    }
+                }
+            }
+        }
+        return dense;
+    }
+
+    [[nodiscard]] auto
+    make_kept_nodes() const -> RankBitmap<Container>
+    {
+        const auto n = grid_.num_cols();
+        auto kept = container_type<unsigned char>(grid_.num_vertices(), 0);
+        for (size_type i = 0; i < grid_.num_rows(); ++i) {
+            for (size_type j = 0; j < n; ++j) {
+                kept[i * n + j] = is_kept_node(i, j) ? 1 : 0;
+            }
+        }
+        return RankBitmap<Container>(kept);
+    }
+
+    [[nodiscard]] auto
+    make_grid_nodes() const -> container_type<size_type>
+    {
+        auto grid_node = container_type<size_type>();
+        grid_node.reserve(kept_.count());
+        for (size_type k = 0; k < kept_.size(); ++k) {
+            if (kept_.test(k)) {
+                grid_node.push_back(k);
+            }
+        }
+        return grid_node;
+    }
+
+    // Get the total cost of a straight path in the full grid.
+    template<class RandomAccessRange>
+    [[nodiscard]] constexpr auto
+    get_path_cost(const RandomAccessRange& cost, const GridPath& path) const -> Cost
+    {
+        auto total = zero<Cost>();
+        auto vertex = to_grid_vertex(path.first);
+        for (size_type k = 0; k < path.length; ++k) {
+            const auto edge = get_grid_edge(vertex, path.direction);
+            const auto edge_id = grid_.get_edge_id(edge);
+            WHIRLWIND_DEBUG_ASSERT(edge_id < std::size(cost));
+            const auto c = static_cast<Cost>(cost[edge_id]);
+            if (c >= infinity<Cost>()) {
+                return infinity<Cost>();
+            }
+            total += c;
+            vertex = step(vertex, path.direction);
+        }
+        return total;
+    }
+
+    template<class ArrayLike2D, class RandomAccessRange>
+    [[nodiscard]] auto
+    make_network(const ArrayLike2D& residues, const RandomAccessRange& cost)
+            -> network_type
+    {
+        const auto m = grid_.num_rows();
+        const auto n = grid_.num_cols();
+        WHIRLWIND_ASSERT(std::size(cost) == grid_.num_edges());
+
+        // An edge of the sparse network, stored with the IDs of its endpoints in the
+        // sparse network and its path in the full grid.
+        struct SparseEdge {
+            size_type tail;
+            size_type head;
+            GridPath path;
+        };
+        auto edges = Vector<SparseEdge>();
+
+        // Add a pair of opposing edges between the kept nodes at either end of a
+        // straight path, heading down or right, from the grid node `first`.
+        const auto add_link = [&](size_type first, size_type length, Direction dir) {
+            const auto stride = (dir == Direction::down) ? n : size_type{1};
+            const auto last = first + length * stride;
+            WHIRLWIND_DEBUG_ASSERT(kept_.test(first));
+            WHIRLWIND_DEBUG_ASSERT(kept_.test(last));
+            const auto u = kept_.rank(first);
+            const auto v = kept_.rank(last);
+            edges.push_back({u, v, {first, length, dir}});
+            edges.push_back({v, u, {last, length, reverse(dir)}});
+        };
+
+        // Full-resolution edges between adjacent dense nodes.
+        for (const auto& k : grid_node_) {
+            const auto [i, j] = to_grid_vertex(k);
+            if (!is_dense_node(i, j)) {
+                continue;
+            }
+            if ((i + 1 < m) && is_dense_node(i + 1, j)) {
+                add_link(k, 1, Direction::down);
+            }
+            if ((j + 1 < n) && is_dense_node(i, j + 1)) {
+                add_link(k, 1, Direction::right);
+            }
+        }
+
+        // Highway edges between consecutive kept nodes along each lattice row and
+        // column, except between adjacent dense nodes, which are already linked.
+        for (size_type i = 0; i < m; ++i) {
+            if (!is_lattice_line(i, m)) {
+                continue;
+            }
+            size_type prev = 0;
+            for (size_type j = 1; j < n; ++j) {
+                if (!kept_.test(i * n + j)) {
+                    continue;
+                }
+                const auto is_dense_pair = (j == prev + 1) && is_dense_node(i, prev) &&
+                                           is_dense_node(i, j);
+                if (!is_dense_pair) {
+                    add_link(i * n + prev, j - prev, Direction::right);
+                }
+                prev = j;
+            }
+        }
+        for (size_type j = 0; j < n; ++j) {
+            if (!is_lattice_line(j, n)) {
+                continue;
+            }
+            size_type prev = 0;
+            for (size_type i = 1; i < m; ++i) {
+                if (!kept_.test(i * n + j)) {
+                    continue;
+                }
+                const auto is_dense_pair = (i == prev + 1) && is_dense_node(prev, j) &&
+                                           is_dense_node(i, j);
+                if (!is_dense_pair) {
+                    add_link(prev * n + j, i - prev, Direction::down);
+                }
+                prev = i;
+            }
+        }
+
+        // `CSRGraph` numbers edges in (tail,head) order, so after sorting, the k-th
+        // edge corresponds to the k-th edge of the sparse graph.
+        ranges::sort(edges, [](const auto& lhs, const auto& rhs) {
+            return std::tie(lhs.tail, lhs.head) < std::tie(rhs.tail, rhs.head);
+        });
+
+        auto edge_list = EdgeList<size_type>();
+        auto edge_cost = Vector<Cost>();
+        edge_cost.reserve(std::size(edges));
+        paths_.reserve(std::size(edges));
+        for (const auto& edge : edges) {
+            edge_list.add_edge(edge.tail, edge.head);
+            edge_cost.push_back(get_path_cost(cost, edge.path));
+            paths_.push_back(edge.path);
+        }
+
+        const auto graph = graph_type(edge_list);
+        WHIRLWIND_ASSERT(graph.num_vertices() == std::size(grid_node_));
+
+        auto surplus = container_type<Flow>();
+        surplus.reserve(std::size(grid_node_));
+        for (const auto& k : grid_node_) {
+            const auto [i, j] = to_grid_vertex(k);
+            surplus.push_back(static_cast<Flow>(residues(i, j)));
+        }
+
+        return network_type(graph, std::move(surplus), edge_cost);
+    }
+
+    grid_graph_type grid_;
+    size_type cell_size_;
+    size_type num_cell_rows_;
+    size_type num_cell_cols_;
+    container_type<unsigned char> dense_cell_;
+    RankBitmap<Container> kept_;
+    container_type<size_type> grid_node_;
+    container_type<GridPath> paths_ = {};
+    network_type network_;
+};
+
+WHIRLWIND_NAMESPACE_END
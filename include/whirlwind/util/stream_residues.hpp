@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/util/get_residues.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/** Options for streaming residue computation. */
+struct ResidueStreamOptions {
+    /** The maximum number of rows of the wrapped phase loaded at a time. */
+    std::size_t strip_rows = 256;
+
+    /**
+     * Whether to load the next strip of the wrapped phase in a background thread while
+     * the residues of the current strip are computed.
+     */
+    bool prefetch = true;
+};
+
+/**
+ * A nonzero residue of a wrapped phase array.
+ *
+ * @tparam SignedInteger
+ *     The signed integer type of the residue charge.
+ */
+template<class SignedInteger = std::int32_t>
+struct Residue {
+    /** The row index of the residue node. */
+    std::size_t row = 0;
+
+    /** The column index of the residue node. */
+    std::size_t col = 0;
+
+    /** The net charge of the residue. */
+    SignedInteger charge = 0;
+
+    [[nodiscard]] friend constexpr auto
+    operator==(const Residue&, const Residue&) -> bool = default;
+};
+
+/**
+ * Compute the residues of a 2-D wrapped phase array that is read in strips of rows.
+ *
+ * The result is the same as that of `get_residues()`, but only one strip of the wrapped
+ * phase (plus, optionally, the next strip being prefetched) and the last row of the
+ * previous strip are held in memory at a time, so that residues may be computed for
+ * arrays that are too large to fit in memory, e.g. rasters that are memory-mapped from
+ * disk.
+ *
+ * Each of the M+1 rows of residues is passed to `emit_row` in order, as soon as both of
+ * the input rows that it borders have been loaded.
+ *
+ * @tparam SignedInteger
+ *     The signed integer type of the output residues.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the per-row buffers.
+ *
+ * @param[in] num_rows
+ *     The number of rows (M) in the wrapped phase array. Must be at least 1.
+ * @param[in] num_cols
+ *     The number of columns (N) in the wrapped phase array. Must be at least 1.
+ * @param[in] load_strip
+ *     A callable object that, given the half-open interval `[first, last)` of row
+ *     indices of a strip, returns a 2-D array (or view) of the `last - first` rows of
+ *     the wrapped phase in the strip, with values in the interval [-pi, pi]. If
+ *     prefetching is enabled, it is invoked from a background thread, concurrently
+ *     with `emit_row`.
+ * @param[in] emit_row
+ *     A callable object that is invoked with each row index `r` in [0, M] and a
+ *     random-access range of the N+1 residues in the row. The range is only valid
+ *     during the call. It is invoked from the calling thread only.
+ * @param[in] options
+ *     The streaming options.
+ */
+template<class SignedInteger = std::int32_t,
+         template<class> class Container = Vector,
+         class LoadFunc,
+         class EmitFunc>
+void
+stream_residues(std::size_t num_rows,
+                std::size_t num_cols,
+                const LoadFunc& load_strip,
+                EmitFunc&& emit_row,
+                const ResidueStreamOptions& options = {})
+{
+    WHIRLWIND_STATIC_ASSERT(std::is_signed_v<SignedInteger> &&
+                            std::is_integral_v<SignedInteger>);
+    using Strip = std::remove_cvref_t<
+            std::invoke_result_t<const LoadFunc&, std::size_t, std::size_t>>;
+    using Real = std::remove_cvref_t<typename Strip::value_type>;
+
+    const auto m = num_rows;
+    const auto n = num_cols;
+    WHIRLWIND_ASSERT(m >= 1);
+    WHIRLWIND_ASSERT(n >= 1);
+    WHIRLWIND_ASSERT(options.strip_rows >= 1);
+
+    const auto get_strip_end = [&](std::size_t first) {
+        return std::min(first + options.strip_rows, m);
+    };
+    const auto load = [&](std::size_t first) {
+        auto strip = load_strip(first, get_strip_end(first));
+        WHIRLWIND_ASSERT(static_cast<std::size_t>(strip.extent(0)) ==
+                         get_strip_end(first) - first);
+        WHIRLWIND_ASSERT(static_cast<std::size_t>(strip.extent(1)) == n);
+        return strip;
+    };
+    const auto load_async = [&](std::size_t first) {
+        const auto policy =
+                options.prefetch ? std::launch::async : std::launch::deferred;
+        return std::async(policy, load, first);
+    };
+
+    // The kernel retains the last row of the previous strip, so each output row is
+    // computed exactly once, in order.
+    auto kernel = detail::ResidueRowKernel<SignedInteger, Real, Container>(n);
+    auto row = Container<SignedInteger>(n + 1);
+    const auto get_row = [&](std::size_t r) {
+        kernel.get_residue_row([&](std::size_t c) -> auto& { return row[c]; });
+        emit_row(r, std::as_const(row));
+    };
+
+    auto next_strip = load_async(0);
+    for (std::size_t first = 0; first < m;) {
+        const auto last = get_strip_end(first);
+        const auto strip = next_strip.get();
+        if (last < m) {
+            next_strip = load_async(last);
+        }
+
+        for (auto i = first; i < last; ++i) {
+            kernel.push_row(strip, i - first);
+            get_row(i);
+        }
+        first = last;
+    }
+    kernel.push_end();
+    get_row(m);
+}
+
+/**
+ * Get the nonzero residues of a 2-D wrapped phase array that is read in strips of rows.
+ *
+ * This is a sparse variant of `stream_residues()` that only stores the location and
+ * charge of each nonzero residue. The residues are ordered by row and then by column.
+ *
+ * @tparam SignedInteger
+ *     The signed integer type of the output residues.
+ * @tparam Container
+ *     A `std::vector`-like type template used to store the output list and the per-row
+ *     buffers.
+ *
+ * @param[in] num_rows
+ *     The number of rows (M) in the wrapped phase array. Must be at least 1.
+ * @param[in] num_cols
+ *     The number of columns (N) in the wrapped phase array. Must be at least 1.
+ * @param[in] load_strip
+ *     A callable object that, given the half-open interval `[first, last)` of row
+ *     indices of a strip, returns a 2-D array (or view) of the `last - first` rows of
+ *     the wrapped phase in the strip, with values in the interval [-pi, pi]. If
+ *     prefetching is enabled, it is invoked from a background thread.
+ * @param[in] options
+ *     The streaming options.
+ *
+ * @returns
+ *     The nonzero residues among the (M+1) x (N+1) residue nodes.
+ */
+template<class SignedInteger = std::int32_t,
+         template<class> class Container = Vector,
+         class LoadFunc>
+[[nodiscard]] auto
+get_sparse_residues(std::size_t num_rows,
+                    std::size_t num_cols,
+                    const LoadFunc& load_strip,
+                    const ResidueStreamOptions& options = {})
+        -> Container<Residue<SignedInteger>>
+{
+    auto residues = Container<Residue<SignedInteger>>();
+    const auto emit_row = [&](std::size_t r, const auto& row) {
+        for (std::size_t c = 0; c <= num_cols; ++c) {
+            if (row[c] != 0) {
+                residues.push_back({r, c, row[c]});
+            }
+        }
+    };
+    stream_residues<SignedInteger, Container>(num_rows, num_cols, load_strip, emit_row,
+                                              options);
+    return residues;
+}
+
+WHIRLWIND_NAMESPACE_END
@@ -0,0 +1,698 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <range/v3/algorithm/sort.hpp>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/namespace.hpp>
+#include <whirlwind/common/parallel.hpp>
+#include <whirlwind/container/vector.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+
+#include "get_residues.hpp"
+#include "integrate_unwrapped_gradients.hpp"
+
+WHIRLWIND_NAMESPACE_BEGIN
+
+/**
+ * A rectangular tile of pixels in a 2-D array.
+ *
+ * Each tile consists of a core region and an extended region, which contains the core
+ * region plus a margin of overlapping pixels from the surrounding tiles (clipped to the
+ * bounds of the array). The core regions of all tiles partition the array. Bounds are
+ * half-open.
+ */
+struct Tile {
+    std::size_t row_begin = 0;
+    std::size_t row_end = 0;
+    std::size_t col_begin = 0;
+    std::size_t col_end = 0;
+    std::size_t core_row_begin = 0;
+    std::size_t core_row_end = 0;
+    std::size_t core_col_begin = 0;
+    std::size_t core_col_end = 0;
+
+    /** The number of rows of pixels in the extended region. */
+    [[nodiscard]] constexpr auto
+    num_rows() const noexcept -> std::size_t
+    {
+        return row_end - row_begin;
+    }
+
+    /** The number of columns of pixels in the extended region. */
+    [[nodiscard]] constexpr auto
+    num_cols() const noexcept -> std::size_t
+    {
+        return col_end - col_begin;
+    }
+
+    /** Check whether a pixel is in the core region. */
+    [[nodiscard]] constexpr auto
+    core_contains(std::size_t i, std::size_t j) const noexcept -> bool
+    {
+        return (i >= core_row_begin) && (i < core_row_end) && (j >= core_col_begin) &&
+               (j < core_col_end);
+    }
+};
+
+/** A partition of an M x N array into a grid of overlapping tiles. */
+class TileLayout {
+public:
+    using size_type = std::size_t;
+
+    /**
+     * Create a new `TileLayout`.
+     *
+     * @param[in] num_rows
+     *     The number of rows in the array.
+     * @param[in] num_cols
+     *     The number of columns in the array.
+     * @param[in] tile_rows
+     *     The number of rows in the core region of each tile (except possibly the last
+     *     row of tiles). Must be at least 1.
+     * @param[in] tile_cols
+     *     The number of columns in the core region of each tile (except possibly the
+     *     last column of tiles). Must be at least 1.
+     * @param[in] overlap
+     *     The width of the margin around each tile's core region, in pixels.
+     */
+    constexpr TileLayout(size_type num_rows,
+                         size_type num_cols,
+                         size_type tile_rows,
+                         size_type tile_cols,
+                         size_type overlap)
+        : num_rows_(num_rows),
+          num_cols_(num_cols),
+          tile_rows_(tile_rows),
+          tile_cols_(tile_cols),
+          overlap_(overlap)
+    {
+        WHIRLWIND_ASSERT(tile_rows >= 1);
+        WHIRLWIND_ASSERT(tile_cols >= 1);
+    }
+
+    [[nodiscard]] constexpr auto
+    num_rows() const noexcept -> size_type
+    {
+        return num_rows_;
+    }
+
+    [[nodiscard]] constexpr auto
+    num_cols() const noexcept -> size_type
+    {
+        return num_cols_;
+    }
+
+    /** The number of rows in the core region of each tile. */
+    [[nodiscard]] constexpr auto
+    tile_rows() const noexcept -> size_type
+    {
+        return tile_rows_;
+    }
+
+    /** The number of columns in the core region of each tile. */
+    [[nodiscard]] constexpr auto
+    tile_cols() const noexcept -> size_type
+    {
+        return tile_cols_;
+    }
+
+    [[nodiscard]] constexpr auto
+    overlap() const noexcept -> size_type
+    {
+        return overlap_;
+    }
+
+    /** The number of rows of tiles. */
+    [[nodiscard]] constexpr auto
+    num_tile_rows() const noexcept -> size_type
+    {
+        return (num_rows_ + tile_rows_ - 1) / tile_rows_;
+    }
+
+    /** The number of columns of tiles. */
+    [[nodiscard]] constexpr auto
+    num_tile_cols() const noexcept -> size_type
+    {
+        return (num_cols_ + tile_cols_ - 1) / tile_cols_;
+    }
+
+    /** The total number of tiles. */
+    [[nodiscard]] constexpr auto
+    num_tiles() const noexcept -> size_type
+    {
+        return num_tile_rows() * num_tile_cols();
+    }
+
+    /**
+     * Get a tile by its index. Tiles are numbered in row-major order.
+     *
+     * @param[in] tile_id
+     *     The tile index. Must be less than `num_tiles()`.
+     *
+     * @returns
+     *     The tile.
+     */
+    [[nodiscard]] constexpr auto
+    tile(size_type tile_id) const -> Tile
+    {
+        WHIRLWIND_ASSERT(tile_id < num_tiles());
+        const auto ti = tile_id / num_tile_cols();
+        const auto tj = tile_id % num_tile_cols();
+
+        auto out = Tile();
+        out.core_row_begin = ti * tile_rows_;
+        out.core_row_end = std::min(out.core_row_begin + tile_rows_, num_rows_);
+        out.core_col_begin = tj * tile_cols_;
+        out.core_col_end = std::min(out.core_col_begin + tile_cols_, num_cols_);
+        out.row_begin = out.core_row_begin - std::min(out.core_row_begin, overlap_);
+        out.row_end = std::min(out.core_row_end + overlap_, num_rows_);
+        out.col_begin = out.core_col_begin - std::min(out.core_col_begin, overlap_);
+        out.col_end = std::min(out.core_col_end + overlap_, num_cols_);
+        return out;
+    }
+
+    /** Get the index of the tile whose core region contains the specified pixel. */
+    [[nodiscard]] constexpr auto
+    get_tile_id(size_type i, size_type j) const -> size_type
+    {
+        WHIRLWIND_ASSERT(i < num_rows_);
+        WHIRLWIND_ASSERT(j < num_cols_);
+        return (i / tile_rows_) * num_tile_cols() + (j / tile_cols_);
+    }
+
+private:
+    size_type num_rows_;
+    size_type num_cols_;
+    size_type tile_rows_;
+    size_type tile_cols_;
+    size_type overlap_;
+};
+
+/** Options for `tiled_unwrap()`. */
+struct TiledUnwrapOptions {
+    /** The number of rows in the core region of each tile. */
+    std::size_t tile_rows = 1024;
+    /** The number of columns in the core region of each tile. */
+    std::size_t tile_cols = 1024;
+    /** The width of the margin of overlapping pixels around each tile. */
+    std::size_t overlap = 64;
+    /**
+     * The max number of tiles to unwrap concurrently, including on the calling thread.
+     */
+    std::size_t num_threads = default_num_threads();
+};
+
+/**
+ * A vote, from the pixels in the overlap between two tiles, for the difference between
+ * the number of cycles added to the second tile and to the first tile by
+ * `resolve_tile_offsets()`.
+ */
+struct SeamVote {
+    std::size_t tile0 = 0;
+    std::size_t tile1 = 0;
+    std::int64_t offset = 0;
+    std::size_t count = 0;
+};
+
+namespace detail {
+
+// Set the cost of each edge along the outer border of a grid graph to zero.
+//
+// The border nodes carry the charges that balance the residues of the wrapped phase,
+// and the border of a tile's network is an artifact of the tiling rather than a
+// boundary of the data, so its nodes are treated as a single ground node. Otherwise,
+// charges on the border could be paired across the interior of the tile at the same
+// cost as along the border, cutting the unwrapped phase along arbitrary paths.
+template<class Graph, class CostVector>
+constexpr void
+ground_grid_border(const Graph& graph, CostVector& cost)
+{
+    using Vertex = typename Graph::vertex_type;
+    const auto num_rows = graph.num_rows();
+    const auto num_cols = graph.num_cols();
+    for (std::size_t j = 0; j + 1 < num_cols; ++j) {
+        for (const auto i : {std::size_t{0}, num_rows - 1}) {
+            cost[graph.get_right_edge(Vertex(i, j))] = 0;
+            cost[graph.get_left_edge(Vertex(i, j + 1))] = 0;
+        }
+    }
+    for (std::size_t i = 0; i + 1 < num_rows; ++i) {
+        for (const auto j : {std::size_t{0}, num_cols - 1}) {
+            cost[graph.get_down_edge(Vertex(i, j))] = 0;
+            cost[graph.get_up_edge(Vertex(i + 1, j))] = 0;
+        }
+    }
+}
+
+// Unwrap the phase in the extended region of a tile, given the wrapped phase in that
+// region. See `unwrap_tile()`.
+template<class Cost, class Flow, class ArrayLike2D, class CostFunc>
+[[nodiscard]] auto
+unwrap_extended_region(const ArrayLike2D& tile_phase,
+                       const Tile& tile,
+                       const CostFunc& cost_fn)
+{
+    using Graph = RectangularGridGraph<1, std::size_t>;
+    using TileNetwork = Network<Graph, Cost, Flow>;
+    using TileDijkstra = Dijkstra<Cost, typename TileNetwork::residual_graph_type>;
+
+    const auto m = tile.num_rows();
+    const auto n = tile.num_cols();
+    WHIRLWIND_ASSERT(tile_phase.extent(0) == m);
+    WHIRLWIND_ASSERT(tile_phase.extent(1) == n);
+
+    const auto residues = get_residues(tile_phase);
+    const auto graph = Graph(m + 1, n + 1);
+    auto surplus = Vector<Flow>(graph.num_vertices());
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            surplus[i * (n + 1) + j] = static_cast<Flow>(residues(i, j));
+        }
+    }
+
+    const auto tile_cost = cost_fn(tile, graph);
+    auto cost = Vector<Cost>(std::begin(tile_cost), std::end(tile_cost));
+    WHIRLWIND_ASSERT(std::size(cost) == graph.num_edges());
+    ground_grid_border(graph, cost);
+
+    auto network = TileNetwork(graph, std::move(surplus), std::move(cost));
+    primal_dual<TileDijkstra>(network);
+
+    return integrate_unwrapped_gradients(tile_phase, network);
+}
+
+} // namespace detail
+
+/**
+ * Unwrap the phase in the extended region of a single tile.
+ *
+ * A minimum cost flow network is formed from the residues of the tile's wrapped phase
+ * and solved using the primal-dual algorithm, and the unwrapped phase is integrated
+ * from the resulting flows. The memory required is proportional to the size of the
+ * tile.
+ *
+ * The edges along the border of the network are given zero cost, regardless of
+ * `cost_fn`, so that the border acts as a single ground node: a residue may be
+ * balanced by the nearest border node, and the charges on the border are balanced
+ * along it without cutting the interior of the tile.
+ *
+ * @tparam Cost
+ *     The arc cost type.
+ * @tparam Flow
+ *     The flow type. Must be signed.
+ *
+ * @param[in] wrapped_phase
+ *     The full M x N wrapped phase array.
+ * @param[in] tile
+ *     The tile.
+ * @param[in] cost_fn
+ *     A callable object that, given the tile and the grid graph of the tile's network,
+ *     returns a random-access range of the unit cost of each edge in the graph.
+ *
+ * @returns
+ *     The unwrapped phase in the tile's extended region.
+ */
+template<class Cost = int, class Flow = int, class ArrayLike2D, class CostFunc>
+[[nodiscard]] auto
+unwrap_tile(const ArrayLike2D& wrapped_phase, const Tile& tile, const CostFunc& cost_fn)
+{
+    using Real = std::remove_cvref_t<typename ArrayLike2D::value_type>;
+
+    WHIRLWIND_ASSERT(tile.row_end <= wrapped_phase.extent(0));
+    WHIRLWIND_ASSERT(tile.col_end <= wrapped_phase.extent(1));
+
+    const auto m = tile.num_rows();
+    const auto n = tile.num_cols();
+    auto tile_phase = Array2D<Real>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            tile_phase(i, j) = wrapped_phase(tile.row_begin + i, tile.col_begin + j);
+        }
+    }
+
+    return detail::unwrap_extended_region<Cost, Flow>(tile_phase, tile, cost_fn);
+}
+
+namespace detail {
+
+// Invoke `func(i, j, k)` for each pixel (i,j) in the margin of a tile (the pixels in
+// its extended region outside of its core region), where `k` counts the margin pixels
+// in row-major order.
+template<class Func>
+constexpr void
+for_each_margin_pixel(const Tile& tile, Func&& func)
+{
+    std::size_t k = 0;
+    for (auto i = tile.row_begin; i < tile.row_end; ++i) {
+        for (auto j = tile.col_begin; j < tile.col_end; ++j) {
+            if (!tile.core_contains(i, j)) {
+                func(i, j, k);
+                ++k;
+            }
+        }
+    }
+}
+
+// Tally a vote from a single pixel in the overlap between two tiles, given the
+// difference between the unwrapped phase of the first and second tile at that pixel.
+template<class Real>
+constexpr void
+add_seam_vote(Vector<SeamVote>& votes,
+              std::size_t tile_id,
+              std::size_t other_id,
+              const Real& diff)
+{
+    // The number of cycles that must be added to the other tile's unwrapped phase for
+    // it to agree with this tile's unwrapped phase.
+    const auto offset = static_cast<std::int64_t>(std::round(diff / tau<Real>()));
+
+    auto vote = SeamVote{tile_id, other_id, offset, 1};
+    if (other_id < tile_id) {
+        vote = SeamVote{other_id, tile_id, -offset, 1};
+    }
+
+    const auto it =
+            std::find_if(std::begin(votes), std::end(votes), [&](const auto& other) {
+                return (other.tile0 == vote.tile0) && (other.tile1 == vote.tile1) &&
+                       (other.offset == vote.offset);
+            });
+    if (it == std::end(votes)) {
+        votes.push_back(vote);
+    } else {
+        ++it->count;
+    }
+}
+
+// Find the root of the set containing `x` in a disjoint-set forest, compressing the
+// path along the way.
+template<class Container>
+constexpr auto
+find_set(Container& parent, std::size_t x) -> std::size_t
+{
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+} // namespace detail
+
+/**
+ * Get the unwrapped phase in the margin of a tile, in row-major order.
+ *
+ * @param[in] tile
+ *     The tile.
+ * @param[in] tile_unwrapped
+ *     The unwrapped phase in the tile's extended region.
+ *
+ * @returns
+ *     The unwrapped phase of each pixel in the tile's extended region that's outside of
+ *     its core region.
+ */
+template<class ArrayLike2D>
+[[nodiscard]] auto
+get_tile_margin(const Tile& tile, const ArrayLike2D& tile_unwrapped)
+{
+    using Real = std::remove_cvref_t<typename ArrayLike2D::value_type>;
+    WHIRLWIND_ASSERT(tile_unwrapped.extent(0) == tile.num_rows());
+    WHIRLWIND_ASSERT(tile_unwrapped.extent(1) == tile.num_cols());
+
+    auto margin = Vector<Real>();
+    detail::for_each_margin_pixel(tile, [&](auto i, auto j, auto) {
+        margin.push_back(tile_unwrapped(i - tile.row_begin, j - tile.col_begin));
+    });
+    return margin;
+}
+
+/**
+ * Compare the unwrapped phase in the margin of a tile with the unwrapped phase of the
+ * overlapping tiles.
+ *
+ * Each margin pixel lies in the core region of another tile. Both tiles were unwrapped
+ * from the same wrapped phase, so (where both solutions agree) the difference between
+ * their unwrapped phase is an integer number of cycles. Pixels are tallied by the
+ * difference that they suggest between the two tiles.
+ *
+ * @param[in] layout
+ *     The tile layout.
+ * @param[in] tile_id
+ *     The index of the tile.
+ * @param[in] margin
+ *     The tile's unwrapped phase in its margin (see `get_tile_margin()`).
+ * @param[in] unwrapped_phase
+ *     The full M x N array of unwrapped phase, in which the core region of each tile
+ *     holds that tile's unwrapped phase.
+ *
+ * @returns
+ *     The votes for the cycle offsets between this tile and each overlapping tile.
+ */
+template<class MarginRange, class ArrayLike2D>
+[[nodiscard]] auto
+get_seam_votes(const TileLayout& layout,
+               std::size_t tile_id,
+               const MarginRange& margin,
+               const ArrayLike2D& unwrapped_phase) -> Vector<SeamVote>
+{
+    const auto tile = layout.tile(tile_id);
+    auto votes = Vector<SeamVote>();
+    detail::for_each_margin_pixel(tile, [&](auto i, auto j, auto k) {
+        WHIRLWIND_DEBUG_ASSERT(k < std::size(margin));
+        const auto other_id = layout.get_tile_id(i, j);
+        WHIRLWIND_DEBUG_ASSERT(other_id != tile_id);
+
+        const auto diff = margin[k] - unwrapped_phase(i, j);
+        detail::add_seam_vote(votes, tile_id, other_id, diff);
+    });
+    return votes;
+}
+
+/**
+ * Find the number of cycles to add to each tile's unwrapped phase so that adjacent
+ * tiles agree along their seams.
+ *
+ * This forms a reduced network whose nodes are the tiles, with an edge between each
+ * pair of overlapping tiles labeled by the most popular cycle offset between them and
+ * weighted by its number of votes. The offsets are propagated from the first tile along
+ * a maximum weight spanning tree, so the seams on which the tiles agree most strongly
+ * are kept consistent.
+ *
+ * Only a single offset per tile is resolved; the flows along the seams are not
+ * re-routed. Pixels in an overlap where the two tiles paired residues differently are
+ * outvoted, and each tile's flows in its core region are kept as they are, so such a
+ * disagreement remains as a branch cut along the seam.
+ *
+ * @param[in] num_tiles
+ *     The number of tiles.
+ * @param[in] votes
+ *     The votes from the overlap between each pair of tiles (see `get_seam_votes()`).
+ *     Votes for the same pair of tiles and offset are summed.
+ *
+ * @returns
+ *     The number of cycles to add to each tile.
+ */
+template<class VoteRange>
+[[nodiscard]] auto
+resolve_tile_offsets(std::size_t num_tiles, const VoteRange& votes)
+        -> Vector<std::int64_t>
+{
+    // Sum the votes for each pair of tiles and offset.
+    auto tally = Vector<SeamVote>(std::begin(votes), std::end(votes));
+    ranges::sort(tally, [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.tile0, lhs.tile1, lhs.offset) <
+               std::tie(rhs.tile0, rhs.tile1, rhs.offset);
+    });
+
+    // Keep the most popular offset for each pair of tiles.
+    auto seams = Vector<SeamVote>();
+    for (std::size_t k = 0; k < std::size(tally);) {
+        auto vote = tally[k];
+        ++k;
+        while ((k < std::size(tally)) && (tally[k].tile0 == vote.tile0) &&
+               (tally[k].tile1 == vote.tile1) && (tally[k].offset == vote.offset)) {
+            vote.count += tally[k].count;
+            ++k;
+        }
+
+        WHIRLWIND_ASSERT(vote.tile0 < num_tiles);
+        WHIRLWIND_ASSERT(vote.tile1 < num_tiles);
+        if (!std::empty(seams) && (seams.back().tile0 == vote.tile0) &&
+            (seams.back().tile1 == vote.tile1)) {
+            if (vote.count > seams.back().count) {
+                seams.back() = vote;
+            }
+        } else {
+            seams.push_back(vote);
+        }
+    }
+
+    // Form a maximum weight spanning forest using Kruskal's algorithm.
+    ranges::sort(seams, [](const auto& lhs, const auto& rhs) {
+        return lhs.count > rhs.count;
+    });
+    auto parent = Vector<std::size_t>(num_tiles);
+    std::iota(std::begin(parent), std::end(parent), std::size_t{0});
+    auto adjacency = Vector<Vector<std::pair<std::size_t, std::int64_t>>>(num_tiles);
+    for (const auto& seam : seams) {
+        const auto root0 = detail::find_set(parent, seam.tile0);
+        const auto root1 = detail::find_set(parent, seam.tile1);
+        if (root0 == root1) {
+            continue;
+        }
+        parent[root1] = root0;
+        adjacency[seam.tile0].emplace_back(seam.tile1, seam.offset);
+        adjacency[seam.tile1].emplace_back(seam.tile0, -seam.offset);
+    }
+
+    // Propagate the offsets outward from the first tile of each tree.
+    auto offset = Vector<std::int64_t>(num_tiles, 0);
+    auto visited = Vector<unsigned char>(num_tiles, 0);
+    auto stack = Vector<std::size_t>();
+    for (std::size_t root = 0; root < num_tiles; ++root) {
+        if (visited[root] != 0) {
+            continue;
+        }
+        visited[root] = 1;
+        stack.push_back(root);
+        while (!std::empty(stack)) {
+            const auto tile = stack.back();
+            stack.pop_back();
+            for (const auto& [other, diff] : adjacency[tile]) {
+                if (visited[other] == 0) {
+                    visited[other] = 1;
+                    offset[other] = offset[tile] + diff;
+                    stack.push_back(other);
+                }
+            }
+        }
+    }
+
+    return offset;
+}
+
+/**
+ * Unwrap a large interferogram by splitting it into overlapping tiles.
+ *
+ * Each tile is unwrapped independently (see `unwrap_tile()`), with up to
+ * `options.num_threads` tiles in flight at once, so the memory required by the
+ * network solvers is bounded by the size of the tiles rather than the size of the
+ * array. The core region of each tile's result is written to the output array and the
+ * tile's margin is retained. Each tile's solution is only unique up to an integer
+ * number of cycles, so the relative offsets of adjacent tiles are then resolved from
+ * the overlapping pixels (see `get_seam_votes()` and `resolve_tile_offsets()`) and
+ * added to the output.
+ *
+ * Residues near a seam are paired within each tile using only the pixels in that
+ * tile's extended region. Residue pairs that straddle a seam within the overlap are
+ * seen whole by both tiles, but the result may differ from unwrapping the full array
+ * at once if the optimal flow crosses a seam by more than the overlap, since the
+ * seams are stitched by a per-tile offset rather than by re-solving the flow along
+ * them.
+ *
+ * @tparam Cost
+ *     The arc cost type.
+ * @tparam Flow
+ *     The flow type. Must be signed.
+ * @tparam Container
+ *     The container type of the output array.
+ *
+ * @param[in] wrapped_phase
+ *     The M x N wrapped phase array.
+ * @param[in] cost_fn
+ *     A callable object that, given a tile and the grid graph of the tile's network,
+ *     returns a random-access range of the unit cost of each edge in the graph. It may
+ *     be invoked concurrently from multiple threads.
+ * @param[in] options
+ *     The tiling options.
+ *
+ * @returns
+ *     The M x N unwrapped phase array.
+ */
+template<class Cost = int,
+         class Flow = int,
+         template<class> class Container = Vector,
+         class ArrayLike2D,
+         class CostFunc>
+[[nodiscard]] auto
+tiled_unwrap(const ArrayLike2D& wrapped_phase,
+             const CostFunc& cost_fn,
+             const TiledUnwrapOptions& options = {})
+{
+    using Real = std::remove_cvref_t<typename ArrayLike2D::value_type>;
+    WHIRLWIND_STATIC_ASSERT(std::is_floating_point_v<Real>);
+    WHIRLWIND_ASSERT(options.num_threads >= 1);
+
+    const auto m = wrapped_phase.extent(0);
+    const auto n = wrapped_phase.extent(1);
+    auto unwrapped_phase = Array2D<Real, Container<Real>>(m, n);
+    if ((m == 0) || (n == 0)) {
+        return unwrapped_phase;
+    }
+
+    const auto layout =
+            TileLayout(m, n, options.tile_rows, options.tile_cols, options.overlap);
+    const auto num_tiles = layout.num_tiles();
+
+    // Unwrap each tile, writing its core region to the output array. The core regions
+    // are disjoint, so tiles may be processed concurrently.
+    auto margins = Vector<Vector<Real>>(num_tiles);
+    parallel_for_chunks(0, num_tiles, options.num_threads, [&](auto first, auto last) {
+        for (auto tile_id = first; tile_id < last; ++tile_id) {
+            const auto tile = layout.tile(tile_id);
+            const auto tile_unwrapped =
+                    unwrap_tile<Cost, Flow>(wrapped_phase, tile, cost_fn);
+            for (auto i = tile.core_row_begin; i < tile.core_row_end; ++i) {
+                for (auto j = tile.core_col_begin; j < tile.core_col_end; ++j) {
+                    unwrapped_phase(i, j) =
+                            tile_unwrapped(i - tile.row_begin, j - tile.col_begin);
+                }
+            }
+            margins[tile_id] = get_tile_margin(tile, tile_unwrapped);
+        }
+    });
+
+    // Resolve the cycle offset of each tile from the overlapping pixels.
+    auto votes = Vector<SeamVote>();
+    for (std::size_t tile_id = 0; tile_id < num_tiles; ++tile_id) {
+        const auto tile_votes =
+                get_seam_votes(layout, tile_id, margins[tile_id], unwrapped_phase);
+        votes.insert(std::end(votes), std::begin(tile_votes), std::end(tile_votes));
+        margins[tile_id] = {};
+    }
+    const auto offset = resolve_tile_offsets(num_tiles, votes);
+
+    // Add the offsets to the core region of each tile.
+    parallel_for_chunks(0, num_tiles, options.num_threads, [&](auto first, auto last) {
+        for (auto tile_id = first; tile_id < last; ++tile_id) {
+            if (offset[tile_id] == 0) {
+                continue;
+            }
+            const auto tile = layout.tile(tile_id);
+            const auto shift = tau<Real>() * static_cast<Real>(offset[tile_id]);
+            for (auto i = tile.core_row_begin; i < tile.core_row_end; ++i) {
+                for (auto j = tile.core_col_begin; j < tile.core_col_end; ++j) {
+                    unwrapped_phase(i, j) += shift;
+                }
+            }
+        }
+    });
+
+    return unwrapped_phase;
+}
+
+WHIRLWIND_NAMESPACE_END
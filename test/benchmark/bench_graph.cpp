@@ -0,0 +1,174 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/forest.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/graph/shortest_path_forest.hpp>
+#include <whirlwind/network/network.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::RectangularGridGraph<1, std::uint32_t>;
+using CSRGraph = ww::CSRGraph<>;
+
+// The number of rows and columns of the grid used by each benchmark.
+constexpr auto grid_size = 256U;
+
+// Make a `CSRGraph` with the same vertices and edges as a grid graph. Each vertex in
+// the result is the ID of the corresponding vertex in the grid.
+auto
+make_csr_graph(const Grid& grid) -> CSRGraph
+{
+    auto edgelist = ww::EdgeList();
+    for (const auto& tail : grid.vertices()) {
+        for (const auto& [_, head] : grid.outgoing_edges(tail)) {
+            edgelist.add_edge(grid.get_vertex_id(tail), grid.get_vertex_id(head));
+        }
+    }
+    return CSRGraph(edgelist);
+}
+
+// Make an uncapacitated network with zero surplus and unit cost on a graph.
+template<class Graph>
+auto
+make_network(const Graph& graph) -> ww::Network<Graph, int, int>
+{
+    const auto surplus = std::vector<int>(graph.num_vertices(), 0);
+    const auto cost = std::vector<int>(graph.num_edges(), 1);
+    return {graph, surplus, cost};
+}
+
+// Iterate over the outgoing edges of each vertex in a graph. Returns a checksum of the
+// IDs of each edge and head vertex so that the loop is not optimized away.
+template<class Graph>
+auto
+traverse_outgoing_edges(const Graph& graph) -> std::uint64_t
+{
+    auto checksum = std::uint64_t{0};
+    for (const auto& tail : graph.vertices()) {
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            checksum += graph.get_edge_id(edge) + graph.get_vertex_id(head);
+        }
+    }
+    return checksum;
+}
+
+// Iterate over the outgoing arcs of each node in a network. Returns a checksum of the
+// IDs of each arc and head node so that the loop is not optimized away.
+template<class Network>
+auto
+traverse_outgoing_arcs(const Network& network) -> std::uint64_t
+{
+    auto checksum = std::uint64_t{0};
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            checksum += network.get_arc_id(arc) + network.get_node_id(head);
+        }
+    }
+    return checksum;
+}
+
+CATCH_TEST_CASE("outgoing_edges", "[benchmark][graph]")
+{
+    const auto grid = Grid(grid_size, grid_size);
+    const auto csr_graph = make_csr_graph(grid);
+    CATCH_REQUIRE(csr_graph.num_edges() == grid.num_edges());
+
+    CATCH_BENCHMARK("RectangularGridGraph")
+    {
+        return traverse_outgoing_edges(grid);
+    };
+
+    CATCH_BENCHMARK("CSRGraph")
+    {
+        return traverse_outgoing_edges(csr_graph);
+    };
+}
+
+CATCH_TEST_CASE("outgoing_arcs", "[benchmark][network]")
+{
+    const auto grid = Grid(grid_size, grid_size);
+    const auto csr_graph = make_csr_graph(grid);
+    const auto grid_network = make_network(grid);
+    const auto csr_network = make_network(csr_graph);
+    CATCH_REQUIRE(csr_network.num_arcs() == grid_network.num_arcs());
+
+    CATCH_BENCHMARK("RectangularGridGraph")
+    {
+        return traverse_outgoing_arcs(grid_network);
+    };
+
+    CATCH_BENCHMARK("CSRGraph")
+    {
+        return traverse_outgoing_arcs(csr_network);
+    };
+}
+
+CATCH_TEST_CASE("ShortestPathForest::reset", "[benchmark][graph]")
+{
+    const auto grid = Grid(grid_size, grid_size);
+    auto forest = ww::ShortestPathForest<int, Grid>(grid);
+
+    // Each benchmark touches a subset of vertices (as a search would) and then resets
+    // the forest. Touching a small fraction of vertices exercises the sparse reset,
+    // while touching every vertex exercises the dense reset.
+    const auto touch_and_reset = [&](std::uint32_t stride) {
+        for (std::uint32_t i = 0; i < grid.num_rows(); ++i) {
+            for (std::uint32_t j = 0; j < grid.num_cols(); j += stride) {
+                const auto vertex = Grid::vertex_type(i, j);
+                forest.label_vertex_reached(vertex);
+                forest.set_distance_to_vertex(vertex, 1);
+            }
+        }
+        forest.reset();
+        return forest.has_reached_vertex(Grid::vertex_type(0U, 0U));
+    };
+
+    CATCH_BENCHMARK("sparse")
+    {
+        return touch_and_reset(64U);
+    };
+
+    CATCH_BENCHMARK("dense")
+    {
+        return touch_and_reset(1U);
+    };
+}
+
+CATCH_TEST_CASE("Forest::predecessors", "[benchmark][graph]")
+{
+    // A path graph, whose forest is a single chain from the last vertex to the first.
+    const auto num_vertices = std::size_t{grid_size} * std::size_t{grid_size};
+    auto edgelist = ww::EdgeList();
+    for (std::size_t vertex = 0; vertex + 1 < num_vertices; ++vertex) {
+        edgelist.add_edge(vertex, vertex + 1);
+    }
+    const auto graph = CSRGraph(edgelist);
+
+    auto forest = ww::Forest(graph);
+    for (const auto& tail : graph.vertices()) {
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            forest.set_predecessor(head, tail, edge);
+        }
+    }
+
+    const auto last = num_vertices - 1;
+    CATCH_BENCHMARK("path")
+    {
+        auto checksum = std::uint64_t{0};
+        for (const auto& [vertex, edge] : forest.predecessors(last)) {
+            checksum += vertex + edge;
+        }
+        return checksum;
+    };
+}
+
+} // namespace
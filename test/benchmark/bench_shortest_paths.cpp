@@ -0,0 +1,180 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/heap.hpp>
+#include <whirlwind/container/heap_concepts.hpp>
+#include <whirlwind/container/indexed_dary_heap.hpp>
+#include <whirlwind/container/indexed_pairing_heap.hpp>
+#include <whirlwind/container/radix_heap.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::RectangularGridGraph<1, std::uint32_t>;
+using Vertex = Grid::vertex_type;
+
+// The number of rows and columns of the grid used by each benchmark.
+constexpr auto grid_size = 256U;
+
+// The max length of an edge in the grid.
+constexpr auto max_edge_length = 9;
+
+// Get the pseudo-random length of an edge, in [1, `max_edge_length`].
+[[nodiscard]] constexpr auto
+edge_length(std::size_t edge_id) noexcept -> int
+{
+    const auto n = static_cast<std::size_t>(max_edge_length);
+    return 1 + static_cast<int>((7 * edge_id + edge_id / 3) % n);
+}
+
+// Insert each element into the heap and then remove them all in order of their keys.
+// Returns a checksum of the removed elements so that the loop is not optimized away.
+template<class Heap>
+auto
+push_pop(Heap& heap, const std::vector<int>& keys) -> std::uint64_t
+{
+    for (std::size_t i = 0; i < std::size(keys); ++i) {
+        if constexpr (ww::IndexedHeapType<Heap>) {
+            heap.emplace(i, i, keys[i]);
+        } else {
+            heap.emplace(i, keys[i]);
+        }
+    }
+
+    auto checksum = std::uint64_t{0};
+    while (!heap.empty()) {
+        checksum += heap.top().first;
+        heap.pop();
+    }
+    return checksum;
+}
+
+// Find the shortest path from the first vertex in the grid to every other vertex.
+// Returns the sum of the distances so that the search is not optimized away.
+template<class Dijkstra>
+auto
+single_source_search(Dijkstra& dijkstra) -> std::int64_t
+{
+    const auto& graph = dijkstra.graph();
+
+    dijkstra.reset();
+    dijkstra.add_source(Vertex(0U, 0U));
+    while (!dijkstra.done()) {
+        const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
+        dijkstra.visit_vertex(tail, distance);
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            if (dijkstra.has_visited_vertex(head)) {
+                continue;
+            }
+            const auto new_distance = distance + edge_length(graph.get_edge_id(edge));
+            if (new_distance < dijkstra.distance_to_vertex(head)) {
+                dijkstra.relax_edge(edge, tail, head, new_distance);
+            }
+        }
+    }
+
+    auto total = std::int64_t{0};
+    for (const auto& vertex : dijkstra.visited_vertices()) {
+        total += dijkstra.distance_to_vertex(vertex);
+    }
+    return total;
+}
+
+CATCH_TEST_CASE("Heap push/pop", "[benchmark][container]")
+{
+    const auto num_elements = std::size_t{grid_size} * std::size_t{grid_size};
+    auto keys = std::vector<int>(num_elements);
+    for (std::size_t i = 0; i < num_elements; ++i) {
+        keys[i] = static_cast<int>((7919 * i) % 1000);
+    }
+
+    CATCH_BENCHMARK_ADVANCED("BinaryHeap")(Catch::Benchmark::Chronometer meter)
+    {
+        auto heap = ww::BinaryHeap<std::size_t, int>();
+        meter.measure([&] { return push_pop(heap, keys); });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("RadixHeap")(Catch::Benchmark::Chronometer meter)
+    {
+        auto heap = ww::RadixHeap<std::size_t, int>();
+        meter.measure([&] {
+            // The heap's min key is monotone, so it must be reset before reuse.
+            heap.clear();
+            return push_pop(heap, keys);
+        });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("IndexedDaryHeap")(Catch::Benchmark::Chronometer meter)
+    {
+        auto heap = ww::IndexedDaryHeap<std::size_t, int>(num_elements);
+        meter.measure([&] { return push_pop(heap, keys); });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("IndexedPairingHeap")(Catch::Benchmark::Chronometer meter)
+    {
+        auto heap = ww::IndexedPairingHeap<std::size_t, int>(num_elements);
+        meter.measure([&] { return push_pop(heap, keys); });
+    };
+}
+
+CATCH_TEST_CASE("Single-source shortest paths", "[benchmark][graph]")
+{
+    const auto grid = Grid(grid_size, grid_size);
+
+    // Each solver must find the same shortest paths.
+    auto reference = ww::Dijkstra<int, Grid>(grid);
+    const auto expected = single_source_search(reference);
+
+    CATCH_BENCHMARK_ADVANCED("Dijkstra (BinaryHeap)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        auto dijkstra = ww::Dijkstra<int, Grid>(grid);
+        CATCH_REQUIRE(single_source_search(dijkstra) == expected);
+        meter.measure([&] { return single_source_search(dijkstra); });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("Dijkstra (RadixHeap)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        using Heap = ww::RadixHeap<Vertex, int>;
+        auto dijkstra = ww::Dijkstra<int, Grid, ww::Vector, Heap>(grid);
+        CATCH_REQUIRE(single_source_search(dijkstra) == expected);
+        meter.measure([&] { return single_source_search(dijkstra); });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("Dijkstra (IndexedDaryHeap)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        using Heap = ww::IndexedDaryHeap<Vertex, int>;
+        auto dijkstra = ww::Dijkstra<int, Grid, ww::Vector, Heap>(grid);
+        CATCH_REQUIRE(single_source_search(dijkstra) == expected);
+        meter.measure([&] { return single_source_search(dijkstra); });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("Dijkstra (IndexedPairingHeap)")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        using Heap = ww::IndexedPairingHeap<Vertex, int>;
+        auto dijkstra = ww::Dijkstra<int, Grid, ww::Vector, Heap>(grid);
+        CATCH_REQUIRE(single_source_search(dijkstra) == expected);
+        meter.measure([&] { return single_source_search(dijkstra); });
+    };
+
+    CATCH_BENCHMARK_ADVANCED("Dial")(Catch::Benchmark::Chronometer meter)
+    {
+        const auto num_buckets = static_cast<std::size_t>(max_edge_length) + 1;
+        auto dial = ww::Dial<int, Grid>(grid, num_buckets);
+        CATCH_REQUIRE(single_source_search(dial) == expected);
+        meter.measure([&] { return single_source_search(dial); });
+    };
+}
+
+} // namespace
@@ -0,0 +1,64 @@
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/spline/cubic_b_spline_basis.hpp>
+#include <whirlwind/spline/uniform_cubic_b_spline_basis.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Evaluate the basis functions at each point in its (precomputed) knot interval.
+// Returns the sum of the basis function values so that the loop is not optimized away.
+template<class Basis>
+auto
+eval_in_intervals(const Basis& basis,
+                  const std::vector<std::pair<double, std::size_t>>& points) -> double
+{
+    auto sum = 0.0;
+    for (const auto& [x, i] : points) {
+        const auto y = basis.eval_in_interval(x, i);
+        sum += y[0] + y[1] + y[2] + y[3];
+    }
+    return sum;
+}
+
+CATCH_TEST_CASE("CubicBSplineBasis::eval_in_interval", "[benchmark][spline]")
+{
+    constexpr auto num_knots = std::size_t{64};
+    constexpr auto num_points = std::size_t{65536};
+
+    auto knots = std::vector<double>(num_knots);
+    for (std::size_t i = 0; i < num_knots; ++i) {
+        knots[i] = 0.5 * static_cast<double>(i);
+    }
+    const auto basis = ww::CubicBSplineBasis<double>(knots);
+    const auto uniform = ww::UniformCubicBSplineBasis<double>(0.0, 0.5, num_knots);
+
+    // Points spread pseudo-randomly over the span of the knots, along with their knot
+    // intervals, so that only the evaluation itself is timed.
+    const auto span = knots.back() - knots.front();
+    auto points = std::vector<std::pair<double, std::size_t>>();
+    points.reserve(num_points);
+    for (std::size_t k = 0; k < num_points; ++k) {
+        const auto u = static_cast<double>((7919 * k) % num_points);
+        const auto x = span * u / static_cast<double>(num_points);
+        points.emplace_back(x, basis.get_knot_interval(x));
+    }
+
+    CATCH_BENCHMARK("CubicBSplineBasis")
+    {
+        return eval_in_intervals(basis, points);
+    };
+
+    CATCH_BENCHMARK("UniformCubicBSplineBasis")
+    {
+        return eval_in_intervals(uniform, points);
+    };
+}
+
+} // namespace
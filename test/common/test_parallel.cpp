@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/common/parallel.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("default_num_threads", "[parallel]")
+{
+    CATCH_CHECK(ww::default_num_threads() >= 1U);
+}
+
+CATCH_TEST_CASE("parallel_for_chunks", "[parallel]")
+{
+    const auto num_threads =
+            GENERATE(std::size_t{1}, std::size_t{3}, std::size_t{16});
+
+    CATCH_SECTION("coverage")
+    {
+        // Each index in the range is processed exactly once.
+        const auto first = std::size_t{5};
+        const auto last = std::size_t{105};
+        auto counts = std::vector<std::atomic<int>>(last);
+        auto num_chunks = std::atomic<std::size_t>(0);
+
+        ww::parallel_for_chunks(first, last, num_threads,
+                                [&](std::size_t chunk_first, std::size_t chunk_last) {
+                                    CATCH_REQUIRE(chunk_first < chunk_last);
+                                    for (auto i = chunk_first; i != chunk_last; ++i) {
+                                        ++counts[i];
+                                    }
+                                    ++num_chunks;
+                                });
+
+        for (std::size_t i = 0; i < last; ++i) {
+            CATCH_CHECK(counts[i] == ((i < first) ? 0 : 1));
+        }
+        CATCH_CHECK(num_chunks == num_threads);
+    }
+
+    CATCH_SECTION("small range")
+    {
+        // No more chunks than indices are created.
+        auto num_chunks = std::atomic<std::size_t>(0);
+        ww::parallel_for_chunks(0U, 2U, num_threads, [&](std::size_t, std::size_t) {
+            ++num_chunks;
+        });
+        CATCH_CHECK(num_chunks == std::min(num_threads, std::size_t{2}));
+    }
+
+    CATCH_SECTION("empty range")
+    {
+        // The function is invoked once on the calling thread with an empty range.
+        auto num_calls = 0;
+        ww::parallel_for_chunks(3U, 3U, num_threads,
+                                [&](std::size_t chunk_first, std::size_t chunk_last) {
+                                    CATCH_CHECK(chunk_first == chunk_last);
+                                    ++num_calls;
+                                });
+        CATCH_CHECK(num_calls == 1);
+    }
+
+    CATCH_SECTION("exceptions")
+    {
+        // Exceptions thrown while processing any chunk are propagated to the caller.
+        const auto func = [](std::size_t, std::size_t chunk_last) {
+            if (chunk_last > 50U) {
+                throw std::runtime_error("error");
+            }
+        };
+        CATCH_CHECK_THROWS_AS(ww::parallel_for_chunks(0U, 100U, num_threads, func),
+                              std::runtime_error);
+    }
+}
+
+CATCH_TEST_CASE("ThreadPool", "[parallel]")
+{
+    const auto num_threads =
+            GENERATE(std::size_t{1}, std::size_t{3}, std::size_t{16});
+    auto pool = ww::ThreadPool(num_threads);
+    CATCH_CHECK(pool.num_threads() >= 1U);
+    CATCH_CHECK(pool.num_threads() <= num_threads);
+
+    CATCH_SECTION("coverage")
+    {
+        // The workers are reused by each call, and each index in the range is
+        // processed exactly once per call.
+        const auto first = std::size_t{5};
+        const auto last = std::size_t{105};
+        auto counts = std::vector<std::atomic<int>>(last);
+        const auto num_calls = 200;
+        for (int call = 0; call < num_calls; ++call) {
+            auto num_chunks = std::atomic<std::size_t>(0);
+            const auto func = [&](std::size_t chunk_first, std::size_t chunk_last) {
+                CATCH_REQUIRE(chunk_first < chunk_last);
+                for (auto i = chunk_first; i != chunk_last; ++i) {
+                    ++counts[i];
+                }
+                ++num_chunks;
+            };
+            pool.parallel_for_chunks(first, last, func);
+            CATCH_REQUIRE(num_chunks == pool.num_threads());
+        }
+
+        for (std::size_t i = 0; i < last; ++i) {
+            CATCH_CHECK(counts[i] == ((i < first) ? 0 : num_calls));
+        }
+    }
+
+    CATCH_SECTION("small range")
+    {
+        auto num_chunks = std::atomic<std::size_t>(0);
+        pool.parallel_for_chunks(0U, 2U,
+                                 [&](std::size_t, std::size_t) { ++num_chunks; });
+        CATCH_CHECK(num_chunks == std::min(pool.num_threads(), std::size_t{2}));
+    }
+
+    CATCH_SECTION("exceptions")
+    {
+        // Exceptions are propagated to the caller, and the pool remains usable.
+        const auto func = [](std::size_t, std::size_t chunk_last) {
+            if (chunk_last > 50U) {
+                throw std::runtime_error("error");
+            }
+        };
+        CATCH_CHECK_THROWS_AS(pool.parallel_for_chunks(0U, 100U, func),
+                              std::runtime_error);
+
+        auto count = std::atomic<std::size_t>(0);
+        pool.parallel_for_chunks(0U, 100U, [&](std::size_t chunk_first,
+                                               std::size_t chunk_last) {
+            count += chunk_last - chunk_first;
+        });
+        CATCH_CHECK(count == 100U);
+    }
+}
+
+CATCH_TEST_CASE("parallel_reduce_chunks", "[parallel]")
+{
+    const auto num_threads =
+            GENERATE(std::size_t{1}, std::size_t{3}, std::size_t{16});
+
+    CATCH_SECTION("sum")
+    {
+        const auto sum = ww::parallel_reduce_chunks(
+                std::size_t{1}, std::size_t{101}, num_threads, std::size_t{7},
+                std::plus<std::size_t>(), [](std::size_t first, std::size_t last) {
+                    auto partial = std::size_t{0};
+                    for (auto i = first; i != last; ++i) {
+                        partial += i;
+                    }
+                    return partial;
+                });
+        CATCH_CHECK(sum == 7U + 5050U);
+    }
+
+    CATCH_SECTION("chunk order")
+    {
+        // Partial results are combined in chunk order, even for a non-commutative
+        // operation.
+        const auto concat = [](std::vector<std::size_t> lhs,
+                               const std::vector<std::size_t>& rhs) {
+            lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+            return lhs;
+        };
+        const auto indices = ww::parallel_reduce_chunks(
+                std::size_t{0}, std::size_t{50}, num_threads, std::vector<std::size_t>(),
+                concat, [](std::size_t first, std::size_t last) {
+                    auto partial = std::vector<std::size_t>();
+                    for (auto i = first; i != last; ++i) {
+                        partial.push_back(i);
+                    }
+                    return partial;
+                });
+        CATCH_REQUIRE(indices.size() == 50U);
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            CATCH_CHECK(indices[i] == i);
+        }
+    }
+
+    CATCH_SECTION("empty range")
+    {
+        const auto result = ww::parallel_reduce_chunks(
+                std::size_t{3}, std::size_t{3}, num_threads, 11,
+                [](int lhs, int rhs) { return lhs + rhs; },
+                [](std::size_t, std::size_t) { return 0; });
+        CATCH_CHECK(result == 11);
+    }
+
+    CATCH_SECTION("exceptions")
+    {
+        const auto func = [](std::size_t, std::size_t chunk_last) -> int {
+            if (chunk_last > 50U) {
+                throw std::runtime_error("error");
+            }
+            return 0;
+        };
+        CATCH_CHECK_THROWS_AS(ww::parallel_reduce_chunks(0U, 100U, num_threads, 0,
+                                                         std::plus<int>(), func),
+                              std::runtime_error);
+    }
+}
+
+} // namespace
@@ -0,0 +1,238 @@
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/arena_allocator.hpp>
+#include <whirlwind/container/queue.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// A memory resource that forwards to `new` and `delete` and counts the number of bytes
+// that are currently allocated.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t bytes_allocated = 0;
+    std::size_t num_allocations = 0;
+
+private:
+    auto
+    do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+    {
+        bytes_allocated += bytes;
+        ++num_allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void
+    do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        bytes_allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] auto
+    do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+    {
+        return this == &other;
+    }
+};
+
+template<class Graph>
+auto
+make_surplus(const Graph& graph) -> std::vector<int>
+{
+    auto surplus = std::vector<int>(graph.num_vertices(), 0);
+    surplus[0] = 1;
+    surplus[3] = 1;
+    surplus[graph.num_vertices() - 1] = -1;
+    surplus[graph.num_vertices() - 5] = -1;
+    return surplus;
+}
+
+template<class Graph>
+auto
+make_cost(const Graph& graph) -> std::vector<int>
+{
+    auto cost = std::vector<int>(graph.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((edge * 7) % 5);
+    }
+    return cost;
+}
+
+CATCH_TEST_CASE("MemoryResourceScope", "[container]")
+{
+    auto outer = CountingResource();
+    auto inner = CountingResource();
+
+    CATCH_CHECK(ww::get_current_memory_resource() == std::pmr::get_default_resource());
+    {
+        const auto outer_scope = ww::MemoryResourceScope(&outer);
+        CATCH_CHECK(ww::get_current_memory_resource() == &outer);
+        {
+            const auto inner_scope = ww::MemoryResourceScope(&inner);
+            CATCH_CHECK(ww::get_current_memory_resource() == &inner);
+        }
+        CATCH_CHECK(ww::get_current_memory_resource() == &outer);
+    }
+    CATCH_CHECK(ww::get_current_memory_resource() == std::pmr::get_default_resource());
+}
+
+CATCH_TEST_CASE("ArenaAllocator", "[container]")
+{
+    auto resource = CountingResource();
+
+    CATCH_SECTION("vector")
+    {
+        {
+            const auto scope = ww::MemoryResourceScope(&resource);
+            auto v = ww::ArenaVector<double>(10, 1.0);
+            CATCH_CHECK(v.get_allocator().resource() == &resource);
+            CATCH_CHECK(resource.bytes_allocated == 10 * sizeof(double));
+
+            v.resize(100, 2.0);
+            CATCH_CHECK(resource.bytes_allocated >= 100 * sizeof(double));
+        }
+        CATCH_CHECK(resource.bytes_allocated == 0);
+    }
+
+    CATCH_SECTION("scope ends before container")
+    {
+        auto v = [&] {
+            const auto scope = ww::MemoryResourceScope(&resource);
+            return ww::ArenaVector<int>(5);
+        }();
+
+        // The container keeps the resource that it was created with.
+        v.resize(50);
+        CATCH_CHECK(v.get_allocator().resource() == &resource);
+        CATCH_CHECK(resource.bytes_allocated >= 50 * sizeof(int));
+
+        v = {};
+        v.shrink_to_fit();
+        CATCH_CHECK(resource.bytes_allocated == 0);
+    }
+
+    CATCH_SECTION("copy and move")
+    {
+        auto v = [&] {
+            const auto scope = ww::MemoryResourceScope(&resource);
+            return ww::ArenaVector<int>(5, 3);
+        }();
+
+        // A copy allocates from the current resource.
+        const auto copy = v;
+        CATCH_CHECK(copy == v);
+        const auto* default_resource = std::pmr::get_default_resource();
+        CATCH_CHECK(copy.get_allocator().resource() == default_resource);
+
+        // A move steals the allocation and its resource.
+        const auto num_allocations = resource.num_allocations;
+        const auto moved = std::move(v);
+        CATCH_CHECK(moved.get_allocator().resource() == &resource);
+        CATCH_CHECK(resource.num_allocations == num_allocations);
+    }
+
+    CATCH_SECTION("queue")
+    {
+        const auto scope = ww::MemoryResourceScope(&resource);
+        auto queue = ww::Queue<int, ww::ArenaDeque>();
+        for (int i = 0; i < 1000; ++i) {
+            queue.push(i);
+        }
+        CATCH_CHECK(resource.bytes_allocated >= 1000 * sizeof(int));
+
+        queue.clear();
+        CATCH_CHECK(std::empty(queue));
+    }
+}
+
+CATCH_TEST_CASE("ArenaVector (Network)", "[network]")
+{
+    auto edgelist = ww::EdgeList();
+    for (auto i = 0U; i < 20U; ++i) {
+        edgelist.add_edge(i, i + 1U);
+        edgelist.add_edge(i + 1U, i);
+        edgelist.add_edge(i, (i + 7U) % 21U);
+    }
+
+    using Graph = ww::CSRGraph<>;
+    using Mixin = ww::UnitCapacityMixin<Graph, int>;
+    using Network = ww::Network<Graph, int, int, ww::Vector, Mixin>;
+    using ResidualGraph = Network::residual_graph_type;
+    using Dijkstra = ww::Dijkstra<int, ResidualGraph>;
+
+    const auto graph = Graph(edgelist);
+    const auto surplus = make_surplus(graph);
+    const auto cost = make_cost(graph);
+
+    auto expected = Network(graph, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(expected.is_balanced());
+
+    CATCH_SECTION("CSRGraph")
+    {
+        using ArenaGraph = ww::CSRGraph<ww::ArenaVector>;
+        using ArenaMixin = ww::UnitCapacityMixin<ArenaGraph, int, ww::ArenaVector>;
+        using ArenaNetwork =
+                ww::Network<ArenaGraph, int, int, ww::ArenaVector, ArenaMixin>;
+        using ArenaResidualGraph = ArenaNetwork::residual_graph_type;
+        using ArenaDijkstra = ww::Dijkstra<int, ArenaResidualGraph, ww::ArenaVector>;
+
+        auto upstream = CountingResource();
+        {
+            auto arena = std::pmr::monotonic_buffer_resource(&upstream);
+            const auto scope = ww::MemoryResourceScope(&arena);
+
+            const auto arena_graph = ArenaGraph(edgelist);
+            auto network = ArenaNetwork(arena_graph, surplus, cost);
+            ww::successive_shortest_paths<ArenaDijkstra>(network);
+
+            CATCH_CHECK(network.is_balanced());
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+            CATCH_CHECK(upstream.bytes_allocated >= network.memory_usage());
+        }
+
+        // The arena is released all at once.
+        CATCH_CHECK(upstream.num_allocations > 0);
+        CATCH_CHECK(upstream.bytes_allocated == 0);
+    }
+
+    CATCH_SECTION("RectangularGridGraph")
+    {
+        using Grid = ww::RectangularGridGraph<1>;
+        using GridNetwork = ww::Network<Grid, int, int>;
+        using ArenaNetwork = ww::Network<Grid, int, int, ww::ArenaVector>;
+        using GridDijkstra = ww::Dijkstra<int, GridNetwork::residual_graph_type>;
+        using ArenaDijkstra = ww::Dijkstra<int,
+                                           ArenaNetwork::residual_graph_type,
+                                           ww::ArenaVector>;
+
+        const auto grid = Grid(6U, 7U);
+        auto grid_expected = GridNetwork(grid, make_surplus(grid), make_cost(grid));
+        ww::successive_shortest_paths<GridDijkstra>(grid_expected);
+
+        auto resource = CountingResource();
+        const auto scope = ww::MemoryResourceScope(&resource);
+        auto network = ArenaNetwork(grid, make_surplus(grid), make_cost(grid));
+        ww::successive_shortest_paths<ArenaDijkstra>(network);
+
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.total_cost() == grid_expected.total_cost());
+        CATCH_CHECK(resource.bytes_allocated >= network.memory_usage());
+    }
+}
+
+} // namespace
@@ -0,0 +1,49 @@
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/container/const_span.hpp>
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("ConstSpan", "[container]")
+{
+    CATCH_SECTION("empty")
+    {
+        const auto span = ww::ConstSpan<int>();
+        CATCH_CHECK(span.empty());
+        CATCH_CHECK(span.size() == 0U);
+        CATCH_CHECK(span.begin() == span.end());
+    }
+
+    CATCH_SECTION("elements")
+    {
+        const auto values = std::array{3, 1, 4, 1, 5};
+        const auto span = ww::ConstSpan<int>(values);
+
+        CATCH_CHECK(!span.empty());
+        CATCH_CHECK(span.size() == values.size());
+        CATCH_CHECK(span.data() == values.data());
+        CATCH_CHECK(span.front() == 3);
+        CATCH_CHECK(span.back() == 5);
+        CATCH_CHECK(span[2] == 4);
+        CATCH_CHECK_THAT(span, CM::RangeEquals(values));
+    }
+
+    CATCH_SECTION("copy")
+    {
+        const auto values = std::array{1, 2};
+        auto span = ww::ConstSpan<int>();
+        span = ww::ConstSpan<int>(values);
+        const auto copy = span;
+        CATCH_CHECK(copy.data() == values.data());
+        CATCH_CHECK(copy.size() == 2U);
+    }
+}
+
+} // namespace
@@ -0,0 +1,112 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/container/arena_allocator.hpp>
+#include <whirlwind/container/huge_page_allocator.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+auto
+is_huge_page_aligned(const void* p) -> bool
+{
+    // NOLINTNEXTLINE(*-reinterpret-cast)
+    return reinterpret_cast<std::uintptr_t>(p) % ww::huge_page_size == 0;
+}
+
+CATCH_TEST_CASE("HugePageVector", "[container]")
+{
+    CATCH_SECTION("small")
+    {
+        auto v = ww::HugePageVector<int>(10);
+        std::iota(v.begin(), v.end(), 0);
+        CATCH_CHECK(v[9] == 9);
+    }
+
+    CATCH_SECTION("large")
+    {
+        const auto n = 3 * ww::huge_page_size / sizeof(double);
+        auto v = ww::HugePageVector<double>(n, 1.5);
+        CATCH_CHECK(is_huge_page_aligned(v.data()));
+        CATCH_CHECK(v.front() == 1.5);
+        CATCH_CHECK(v.back() == 1.5);
+
+        v.resize(2 * n, 2.5);
+        CATCH_CHECK(is_huge_page_aligned(v.data()));
+        CATCH_CHECK(v[n - 1] == 1.5);
+        CATCH_CHECK(v[n] == 2.5);
+
+        const auto copy = v;
+        CATCH_CHECK(copy == v);
+    }
+}
+
+CATCH_TEST_CASE("HugePageMemoryResource", "[container]")
+{
+    const auto policy = GENERATE(ww::HugePagePolicy::transparent,
+                                 ww::HugePagePolicy::reserved);
+    const auto placement = GENERATE(ww::NumaPlacement::first_touch,
+                                    ww::NumaPlacement::allocating_thread);
+
+    auto options = ww::HugePageOptions();
+    options.policy = policy;
+    options.placement = placement;
+    auto resource = ww::HugePageMemoryResource(options);
+
+    const auto scope = ww::MemoryResourceScope(&resource);
+
+    // The reserved pool is usually empty, so this may fall back to transparent pages.
+    const auto n = ww::huge_page_size / sizeof(std::int32_t) + 1;
+    auto v = ww::ArenaVector<std::int32_t>(n, 7);
+    CATCH_CHECK(is_huge_page_aligned(v.data()));
+    CATCH_CHECK(v.back() == 7);
+
+    // Allocations below the threshold use the upstream resource.
+    const auto small = ww::ArenaVector<std::int32_t>(100, 3);
+    CATCH_CHECK(small.front() == 3);
+}
+
+CATCH_TEST_CASE("HugePageVector (Network)", "[network]")
+{
+    using Grid = ww::RectangularGridGraph<1>;
+    using Network = ww::Network<Grid, int, int>;
+    using HugePageNetwork = ww::Network<Grid, int, int, ww::HugePageVector>;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+    using HugePageDijkstra = ww::Dijkstra<int,
+                                          HugePageNetwork::residual_graph_type,
+                                          ww::HugePageVector>;
+
+    // Large enough that the arc arrays are backed by huge pages.
+    const auto grid = Grid(400U, 400U);
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[grid.get_vertex_id({1U, 2U})] = 1;
+    surplus[grid.get_vertex_id({300U, 350U})] = 1;
+    surplus[grid.get_vertex_id({399U, 0U})] = -1;
+    surplus[grid.get_vertex_id({20U, 399U})] = -1;
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((edge * 7) % 5);
+    }
+
+    auto expected = Network(grid, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    auto network = HugePageNetwork(grid, surplus, cost);
+    ww::successive_shortest_paths<HugePageDijkstra>(network);
+
+    CATCH_CHECK(network.is_balanced());
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+}
+
+} // namespace
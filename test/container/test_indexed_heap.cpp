@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/container/heap_concepts.hpp>
+#include <whirlwind/container/indexed_dary_heap.hpp>
+#include <whirlwind/container/indexed_pairing_heap.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+template<ww::IndexedHeapType Heap>
+WHIRLWIND_CONSTEVAL void
+require_satisfies_indexed_heap_type() noexcept
+{}
+
+CATCH_TEST_CASE("IndexedHeapType", "[container]")
+{
+    require_satisfies_indexed_heap_type<ww::IndexedDaryHeap<int, float>>();
+    require_satisfies_indexed_heap_type<ww::IndexedDaryHeap<int, int, 2>>();
+    require_satisfies_indexed_heap_type<ww::IndexedPairingHeap<int, double>>();
+}
+
+CATCH_TEMPLATE_TEST_CASE("IndexedHeap",
+                         "[container]",
+                         (ww::IndexedDaryHeap<char, int>),
+                         (ww::IndexedDaryHeap<char, int, 2>),
+                         (ww::IndexedPairingHeap<char, int>))
+{
+    using Heap = TestType;
+
+    const auto capacity = 8U;
+    auto heap = Heap(capacity);
+
+    CATCH_SECTION("Heap")
+    {
+        CATCH_CHECK(heap.capacity() == capacity);
+        CATCH_CHECK(heap.size() == 0U);
+        CATCH_CHECK(heap.empty());
+        for (std::size_t id = 0; id < capacity; ++id) {
+            CATCH_CHECK_FALSE(heap.contains(id));
+        }
+    }
+
+    CATCH_SECTION("emplace")
+    {
+        heap.emplace(3U, 'a', 30);
+        heap.emplace(5U, 'b', 10);
+        heap.emplace(1U, 'c', 20);
+
+        CATCH_CHECK(heap.size() == 3U);
+        CATCH_CHECK_FALSE(heap.empty());
+        CATCH_CHECK(heap.contains(3U));
+        CATCH_CHECK(heap.contains(5U));
+        CATCH_CHECK(heap.contains(1U));
+        CATCH_CHECK_FALSE(heap.contains(0U));
+        CATCH_CHECK(heap.key(3U) == 30);
+
+        const auto& [value, key] = heap.top();
+        CATCH_CHECK(value == 'b');
+        CATCH_CHECK(key == 10);
+    }
+
+    CATCH_SECTION("pop")
+    {
+        heap.emplace(3U, 'a', 30);
+        heap.emplace(5U, 'b', 10);
+        heap.emplace(1U, 'c', 20);
+
+        const auto values = {'b', 'c', 'a'};
+        const auto keys = {10, 20, 30};
+        auto key = std::begin(keys);
+        for (const auto& value : values) {
+            CATCH_CHECK(heap.top().first == value);
+            CATCH_CHECK(heap.top().second == *key++);
+            heap.pop();
+        }
+
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK_FALSE(heap.contains(3U));
+        CATCH_CHECK_FALSE(heap.contains(5U));
+        CATCH_CHECK_FALSE(heap.contains(1U));
+    }
+
+    CATCH_SECTION("decrease_key")
+    {
+        heap.emplace(0U, 'a', 30);
+        heap.emplace(1U, 'b', 10);
+        heap.emplace(2U, 'c', 20);
+
+        heap.decrease_key(0U, 5);
+        CATCH_CHECK(heap.size() == 3U);
+        CATCH_CHECK(heap.key(0U) == 5);
+        CATCH_CHECK(heap.top().first == 'a');
+
+        // Decreasing the key of the top element.
+        heap.decrease_key(0U, 1);
+        CATCH_CHECK(heap.top().first == 'a');
+        CATCH_CHECK(heap.top().second == 1);
+
+        heap.pop();
+        heap.decrease_key(2U, 10);
+        CATCH_CHECK(heap.size() == 2U);
+        CATCH_CHECK(heap.top().second == 10);
+        heap.pop();
+        CATCH_CHECK(heap.top().second == 10);
+        heap.pop();
+        CATCH_CHECK(heap.empty());
+    }
+
+    CATCH_SECTION("clear")
+    {
+        heap.emplace(0U, 'a', 30);
+        heap.emplace(4U, 'b', 10);
+        heap.emplace(7U, 'c', 20);
+        heap.pop();
+
+        heap.clear();
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK(heap.size() == 0U);
+        CATCH_CHECK(heap.capacity() == capacity);
+        for (std::size_t id = 0; id < capacity; ++id) {
+            CATCH_CHECK_FALSE(heap.contains(id));
+        }
+
+        // The heap may be reused after being cleared.
+        heap.emplace(0U, 'd', 1);
+        CATCH_CHECK(heap.size() == 1U);
+        CATCH_CHECK(heap.top().first == 'd');
+    }
+}
+
+CATCH_TEMPLATE_TEST_CASE("IndexedHeap (random)",
+                         "[container]",
+                         (ww::IndexedDaryHeap<std::size_t, int>),
+                         (ww::IndexedDaryHeap<std::size_t, int, 3>),
+                         (ww::IndexedPairingHeap<std::size_t, int>))
+{
+    using Heap = TestType;
+
+    const auto n = 1000U;
+    auto heap = Heap(n);
+
+    auto rng = std::mt19937(1234U);
+    auto dist = std::uniform_int_distribution<int>(0, 10'000);
+
+    auto keys = std::vector<int>(n);
+    for (std::size_t id = 0; id < n; ++id) {
+        keys[id] = dist(rng);
+        heap.emplace(id, id, keys[id]);
+    }
+
+    // Decrease the keys of a random subset of elements.
+    auto pick = std::uniform_int_distribution<std::size_t>(0, n - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto id = pick(rng);
+        keys[id] -= dist(rng) / 2;
+        heap.decrease_key(id, keys[id]);
+    }
+    CATCH_CHECK(heap.size() == n);
+
+    auto popped = std::vector<int>();
+    while (!heap.empty()) {
+        const auto [id, key] = heap.top();
+        CATCH_CHECK(key == keys[id]);
+        popped.push_back(key);
+        heap.pop();
+    }
+
+    auto sorted_keys = keys;
+    std::sort(std::begin(sorted_keys), std::end(sorted_keys));
+    CATCH_CHECK(popped == sorted_keys);
+}
+
+} // namespace
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/radix_heap.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("RadixHeap", "[container]")
+{
+    auto heap = ww::RadixHeap<char, int>();
+    CATCH_STATIC_REQUIRE(heap.num_buckets() == 33U);
+
+    CATCH_SECTION("empty")
+    {
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK(heap.size() == 0U);
+        CATCH_CHECK(heap.min_key() == 0);
+    }
+
+    CATCH_SECTION("emplace/top/pop")
+    {
+        heap.emplace('a', 5);
+        heap.emplace('b', 1000);
+        heap.emplace('c', 3);
+        heap.emplace('d', 3);
+        CATCH_CHECK(heap.size() == 4U);
+
+        CATCH_CHECK(heap.top().second == 3);
+        CATCH_CHECK(heap.min_key() == 3);
+        heap.pop();
+        CATCH_CHECK(heap.top().second == 3);
+        heap.pop();
+
+        // Keys no less than the last extracted key may be inserted.
+        heap.emplace('e', 3);
+        heap.emplace('f', 4);
+
+        CATCH_CHECK(heap.top() == std::pair('e', 3));
+        heap.pop();
+        CATCH_CHECK(heap.top() == std::pair('f', 4));
+        heap.pop();
+        CATCH_CHECK(heap.top() == std::pair('a', 5));
+        heap.pop();
+        CATCH_CHECK(heap.top() == std::pair('b', 1000));
+        CATCH_CHECK(heap.min_key() == 1000);
+        heap.pop();
+        CATCH_CHECK(heap.empty());
+    }
+
+    CATCH_SECTION("clear")
+    {
+        heap.emplace('a', 10);
+        heap.emplace('b', 20);
+        CATCH_CHECK(heap.top().second == 10);
+
+        heap.clear();
+        CATCH_CHECK(heap.empty());
+        CATCH_CHECK(heap.min_key() == 0);
+
+        heap.emplace('c', 1);
+        CATCH_CHECK(heap.top() == std::pair('c', 1));
+    }
+}
+
+CATCH_TEMPLATE_TEST_CASE("RadixHeap (monotone)",
+                         "[container]",
+                         std::int32_t,
+                         std::uint32_t,
+                         std::int64_t)
+{
+    using Key = TestType;
+
+    // Simulate the access pattern of Dijkstra's algorithm: repeatedly extract the
+    // minimum key and insert a few new keys no less than it. Extracted keys are
+    // compared against a reference sorted sequence.
+    auto heap = ww::RadixHeap<std::size_t, Key>();
+    auto reference = std::vector<Key>();
+
+    auto rng = std::mt19937(1234U);
+    auto num_pushes = std::uniform_int_distribution<int>(0, 3);
+    auto increment = std::uniform_int_distribution<Key>(0, 1'000'000);
+
+    heap.emplace(0U, Key{0});
+    reference.push_back(Key{0});
+
+    std::size_t count = 1;
+    while (!heap.empty() && count < 10'000U) {
+        const auto [value, key] = heap.top();
+        heap.pop();
+
+        const auto it = std::min_element(std::begin(reference), std::end(reference));
+        CATCH_REQUIRE(key == *it);
+        reference.erase(it);
+
+        for (int i = num_pushes(rng); i > 0; --i) {
+            const auto new_key = static_cast<Key>(key + increment(rng));
+            heap.emplace(count++, new_key);
+            reference.push_back(new_key);
+        }
+        CATCH_REQUIRE(heap.size() == std::size(reference));
+    }
+}
+
+} // namespace
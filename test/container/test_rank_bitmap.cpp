@@ -0,0 +1,40 @@
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/rank_bitmap.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("RankBitmap", "[container]")
+{
+    const auto bits = std::vector<bool>{true, false, true, true, false, true};
+    const auto bitmap = ww::RankBitmap<>(bits);
+
+    CATCH_CHECK(bitmap.size() == 6U);
+    CATCH_CHECK(bitmap.count() == 4U);
+    for (std::size_t i = 0; i < std::size(bits); ++i) {
+        CATCH_CHECK(bitmap.test(i) == bits[i]);
+    }
+
+    const auto expected_rank = std::vector<std::size_t>{0U, 1U, 1U, 2U, 3U, 3U, 4U};
+    for (std::size_t i = 0; i <= std::size(bits); ++i) {
+        CATCH_CHECK(bitmap.rank(i) == expected_rank[i]);
+    }
+
+    // Ranks are carried across word boundaries.
+    auto long_bits = std::vector<bool>(200U);
+    for (std::size_t i = 0; i < std::size(long_bits); ++i) {
+        long_bits[i] = (i % 3 == 0);
+    }
+    const auto long_bitmap = ww::RankBitmap<>(long_bits);
+    CATCH_CHECK(long_bitmap.count() == 67U);
+    CATCH_CHECK(long_bitmap.rank(64U) == 22U);
+    CATCH_CHECK(long_bitmap.rank(200U) == 67U);
+}
+
+} // namespace
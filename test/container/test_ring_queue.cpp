@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/ring_queue.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("RingQueue", "[container]")
+{
+    auto queue = ww::RingQueue<std::string>();
+
+    CATCH_SECTION("empty")
+    {
+        CATCH_CHECK(queue.empty());
+        CATCH_CHECK(queue.size() == 0U);
+        CATCH_CHECK(queue.capacity() == 0U);
+    }
+
+    CATCH_SECTION("push/pop")
+    {
+        queue.push("a");
+        queue.push("b");
+        CATCH_CHECK(queue.size() == 2U);
+        CATCH_CHECK(queue.front() == "a");
+        CATCH_CHECK(queue.back() == "b");
+
+        queue.pop();
+        CATCH_CHECK(queue.size() == 1U);
+        CATCH_CHECK(queue.front() == "b");
+        CATCH_CHECK(queue.back() == "b");
+
+        queue.pop();
+        CATCH_CHECK(queue.empty());
+    }
+
+    CATCH_SECTION("wrap around")
+    {
+        // Interleave pushes and pops so that the contents wrap around the end of the
+        // ring buffer and the buffer is grown while wrapped. Elements are always
+        // removed in FIFO order.
+        std::size_t pushed = 0;
+        std::size_t popped = 0;
+        for (std::size_t round = 0; round < 5U; ++round) {
+            for (std::size_t i = 0; i < 3U + round; ++i) {
+                queue.push(std::to_string(pushed++));
+            }
+            CATCH_CHECK(queue.back() == std::to_string(pushed - 1U));
+            for (std::size_t i = 0; i < 2U; ++i) {
+                CATCH_CHECK(queue.front() == std::to_string(popped++));
+                queue.pop();
+            }
+            CATCH_CHECK(queue.size() == pushed - popped);
+            CATCH_CHECK(queue.capacity() >= queue.size());
+        }
+
+        while (!queue.empty()) {
+            CATCH_CHECK(queue.front() == std::to_string(popped++));
+            queue.pop();
+        }
+        CATCH_CHECK(popped == pushed);
+    }
+
+    CATCH_SECTION("clear")
+    {
+        for (int i = 0; i < 10; ++i) {
+            queue.push(std::to_string(i));
+        }
+        const auto capacity = queue.capacity();
+        CATCH_CHECK(capacity >= 10U);
+
+        queue.clear();
+        CATCH_CHECK(queue.empty());
+        CATCH_CHECK(queue.capacity() == capacity);
+
+        queue.push("x");
+        CATCH_CHECK(queue.front() == "x");
+    }
+}
+
+} // namespace
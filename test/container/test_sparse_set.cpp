@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/sparse_set.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Get the sorted contents of a set.
+template<class Set>
+auto
+sorted_contents(const Set& set) -> std::vector<typename Set::value_type>
+{
+    auto contents = std::vector<typename Set::value_type>(set.begin(), set.end());
+    std::sort(contents.begin(), contents.end());
+    return contents;
+}
+
+CATCH_TEST_CASE("SparseSet", "[container]")
+{
+    auto set = ww::SparseSet<std::uint32_t, ww::Vector, std::uint32_t>(10U);
+
+    CATCH_SECTION("empty")
+    {
+        CATCH_CHECK(set.empty());
+        CATCH_CHECK(set.size() == 0U);
+        CATCH_CHECK(set.universe_size() == 10U);
+        CATCH_CHECK(set.begin() == set.end());
+        for (std::size_t id = 0; id < 10U; ++id) {
+            CATCH_CHECK(!set.contains(id));
+        }
+    }
+
+    CATCH_SECTION("insert")
+    {
+        CATCH_CHECK(set.insert(3U, 3U));
+        CATCH_CHECK(set.insert(7U, 7U));
+        CATCH_CHECK(set.insert(0U, 0U));
+        CATCH_CHECK(!set.insert(7U, 7U));
+
+        CATCH_CHECK(set.size() == 3U);
+        CATCH_CHECK(set.contains(0U));
+        CATCH_CHECK(set.contains(3U));
+        CATCH_CHECK(set.contains(7U));
+        CATCH_CHECK(!set.contains(1U));
+        CATCH_CHECK(sorted_contents(set) == std::vector<std::uint32_t>{0U, 3U, 7U});
+    }
+
+    CATCH_SECTION("erase")
+    {
+        for (std::uint32_t id = 0; id < 10U; id += 2U) {
+            set.insert(id, id);
+        }
+
+        // Remove an element from the middle, the last element, and a non-member.
+        CATCH_CHECK(set.erase(4U));
+        CATCH_CHECK(set.erase(8U));
+        CATCH_CHECK(!set.erase(5U));
+        CATCH_CHECK(!set.erase(4U));
+
+        CATCH_CHECK(set.size() == 3U);
+        CATCH_CHECK(!set.contains(4U));
+        CATCH_CHECK(!set.contains(8U));
+        CATCH_CHECK(sorted_contents(set) == std::vector<std::uint32_t>{0U, 2U, 6U});
+
+        // Removed elements may be reinserted.
+        CATCH_CHECK(set.insert(4U, 4U));
+        CATCH_CHECK(sorted_contents(set) ==
+                    std::vector<std::uint32_t>{0U, 2U, 4U, 6U});
+
+        while (!set.empty()) {
+            CATCH_CHECK(set.erase(*set.begin()));
+        }
+        for (std::size_t id = 0; id < 10U; ++id) {
+            CATCH_CHECK(!set.contains(id));
+        }
+    }
+
+    CATCH_SECTION("clear")
+    {
+        set.insert(1U, 1U);
+        set.insert(9U, 9U);
+        set.clear();
+
+        CATCH_CHECK(set.empty());
+        CATCH_CHECK(set.universe_size() == 10U);
+        CATCH_CHECK(!set.contains(1U));
+        CATCH_CHECK(!set.contains(9U));
+        CATCH_CHECK(set.insert(9U, 9U));
+    }
+}
+
+CATCH_TEST_CASE("SparseSet (non-integral values)", "[container]")
+{
+    // Elements need not be their own IDs.
+    auto set = ww::SparseSet<std::string>(5U);
+    for (std::size_t id = 0; id < 5U; ++id) {
+        set.insert(id, std::to_string(10U * id));
+    }
+
+    CATCH_CHECK(set.erase(0U));
+    CATCH_CHECK(set.erase(3U));
+    CATCH_CHECK(sorted_contents(set) == std::vector<std::string>{"10", "20", "40"});
+
+    // The positions of the moved elements are updated.
+    CATCH_CHECK(set.erase(4U));
+    CATCH_CHECK(set.erase(1U));
+    CATCH_CHECK(sorted_contents(set) == std::vector<std::string>{"20"});
+    CATCH_CHECK(set.contains(2U));
+}
+
+} // namespace
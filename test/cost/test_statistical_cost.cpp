@@ -0,0 +1,228 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/cost/statistical_cost.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/util/get_residues.hpp>
+#include <whirlwind/util/integrate_unwrapped_gradients.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Owning storage for a set of planar grid cost rasters.
+template<class Cost>
+struct CostRasters {
+    CostRasters(std::size_t m, std::size_t n)
+        : up(m, n + 1), down(m, n + 1), left(m + 1, n), right(m + 1, n)
+    {}
+
+    auto
+    view() -> ww::PlanarGridCosts<Cost>
+    {
+        return {up.to_mdspan(), down.to_mdspan(), left.to_mdspan(), right.to_mdspan()};
+    }
+
+    ww::Array2D<Cost> up;
+    ww::Array2D<Cost> down;
+    ww::Array2D<Cost> left;
+    ww::Array2D<Cost> right;
+};
+
+template<class Cost>
+auto
+operator==(const CostRasters<Cost>& a, const CostRasters<Cost>& b) -> bool
+{
+    const auto equal = [](const auto& x, const auto& y) {
+        for (std::size_t i = 0; i < x.extent(0); ++i) {
+            for (std::size_t j = 0; j < x.extent(1); ++j) {
+                if (x(i, j) != y(i, j)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    return equal(a.up, b.up) && equal(a.down, b.down) && equal(a.left, b.left) &&
+           equal(a.right, b.right);
+}
+
+CATCH_TEST_CASE("get_statistical_costs", "[cost]")
+{
+    const std::size_t m = 21;
+    const std::size_t n = 17;
+
+    auto rng = std::mt19937(2468);
+    auto phase_dist = std::uniform_real_distribution<double>(-ww::pi<double>(),
+                                                             ww::pi<double>());
+    auto coherence_dist = std::uniform_real_distribution<double>(0.0, 1.0);
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    auto coherence = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            wrapped_phase(i, j) = phase_dist(rng);
+            coherence(i, j) = coherence_dist(rng);
+        }
+    }
+
+    auto options = ww::StatisticalCostOptions();
+    options.num_looks = 4.0;
+    options.border_cost = 3.0;
+
+    auto expected = CostRasters<double>(m, n);
+    ww::get_statistical_costs(wrapped_phase, coherence, expected.view(), options);
+
+    CATCH_SECTION("cost model")
+    {
+        const auto variance = [&](std::size_t i, std::size_t j) {
+            const auto gamma = coherence(i, j);
+            const auto gamma2 = gamma * gamma;
+            return (1.0 - gamma2) / (2.0 * options.num_looks * gamma2);
+        };
+        const auto check_cost = [&](double cost, double dpsi, double var) {
+            const auto k = options.scale * ww::tau<double>() / var;
+            const auto expected_cost = std::min(k * (ww::pi<double>() + dpsi),
+                                                options.max_cost);
+            CATCH_CHECK(std::abs(cost - expected_cost) < 1e-9 * options.max_cost);
+        };
+        const auto wrap = [](double x) {
+            return x - ww::tau<double>() * std::round(x / ww::tau<double>());
+        };
+
+        options.min_coherence = 1e-6;
+        options.max_coherence = 1.0 - 1e-6;
+        ww::get_statistical_costs(wrapped_phase, coherence, expected.view(), options);
+
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 1; j < n; ++j) {
+                const auto dpsi = wrap(wrapped_phase(i, j) - wrapped_phase(i, j - 1));
+                const auto var = variance(i, j) + variance(i, j - 1);
+                check_cost(expected.down(i, j), dpsi, var);
+                check_cost(expected.up(i, j), -dpsi, var);
+            }
+            CATCH_CHECK(expected.up(i, 0) == options.border_cost);
+            CATCH_CHECK(expected.down(i, n) == options.border_cost);
+        }
+        for (std::size_t i = 1; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                const auto dpsi = wrap(wrapped_phase(i, j) - wrapped_phase(i - 1, j));
+                const auto var = variance(i, j) + variance(i - 1, j);
+                check_cost(expected.left(i, j), dpsi, var);
+                check_cost(expected.right(i, j), -dpsi, var);
+            }
+        }
+        for (std::size_t j = 0; j < n; ++j) {
+            CATCH_CHECK(expected.left(0, j) == options.border_cost);
+            CATCH_CHECK(expected.right(m, j) == options.border_cost);
+        }
+    }
+
+    CATCH_SECTION("threads")
+    {
+        const auto num_threads = GENERATE(std::size_t{2}, std::size_t{5});
+        auto cost = CostRasters<double>(m, n);
+        ww::get_statistical_costs(wrapped_phase, coherence, cost.view(), options,
+                                  num_threads);
+        CATCH_CHECK(cost == expected);
+    }
+
+    CATCH_SECTION("fused residues")
+    {
+        const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+        auto cost = CostRasters<double>(m, n);
+        auto residues = ww::Array2D<std::int32_t>(m + 1, n + 1);
+        ww::get_statistical_costs_and_residues(wrapped_phase, coherence, cost.view(),
+                                               residues.to_mdspan(), options,
+                                               num_threads);
+        CATCH_CHECK(cost == expected);
+
+        const auto expected_residues = ww::get_residues(wrapped_phase);
+        for (std::size_t i = 0; i <= m; ++i) {
+            for (std::size_t j = 0; j <= n; ++j) {
+                CATCH_CHECK(residues(i, j) == expected_residues(i, j));
+            }
+        }
+    }
+
+    CATCH_SECTION("integer costs")
+    {
+        auto cost = CostRasters<int>(m, n);
+        ww::get_statistical_costs(wrapped_phase, coherence, cost.view(), options);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j <= n; ++j) {
+                CATCH_CHECK(cost.down(i, j) ==
+                            static_cast<int>(std::round(expected.down(i, j))));
+            }
+        }
+    }
+}
+
+CATCH_TEST_CASE("get_statistical_costs (unwrapping)", "[cost]")
+{
+    using Grid = ww::RectangularGridGraph<1, std::size_t>;
+    using Network = ww::Network<Grid, int, int>;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    // A smooth phase ramp, wrapped, with a patch of low-coherence noise.
+    const std::size_t m = 24;
+    const std::size_t n = 30;
+    auto rng = std::mt19937(1357);
+    auto noise = std::uniform_real_distribution<double>(-ww::pi<double>(),
+                                                        ww::pi<double>());
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    auto coherence = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto is_noisy = (i >= 8) && (i < 14) && (j >= 10) && (j < 16);
+            const auto phi = 0.9 * static_cast<double>(j) +
+                             (is_noisy ? noise(rng) : 0.0);
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+            coherence(i, j) = is_noisy ? 0.1 : 0.9;
+        }
+    }
+
+    auto cost = CostRasters<int>(m, n);
+    auto residues = ww::Array2D<int>(m + 1, n + 1);
+    ww::get_statistical_costs_and_residues(wrapped_phase, coherence, cost.view(),
+                                           residues.to_mdspan());
+
+    const auto grid = Grid(m + 1, n + 1);
+    auto surplus = std::vector<int>();
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            surplus.push_back(residues(i, j));
+        }
+    }
+    auto network = Network(grid, surplus, cost.up.to_mdspan(), cost.down.to_mdspan(),
+                           cost.left.to_mdspan(), cost.right.to_mdspan());
+    ww::primal_dual<Dijkstra>(network);
+    CATCH_REQUIRE(network.is_balanced());
+
+    // Outside of the noisy patch, the ramp is recovered up to a constant offset.
+    const auto unwrapped_phase =
+            ww::integrate_unwrapped_gradients(wrapped_phase, network);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j + 1 < n; ++j) {
+            if ((i >= 7) && (i < 15) && (j >= 9) && (j < 16)) {
+                continue;
+            }
+            const auto dphi = unwrapped_phase(i, j + 1) - unwrapped_phase(i, j);
+            CATCH_CHECK(std::abs(dphi - 0.9) < 1e-6);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("CompactGridGraph", "[graph]")
+{
+    using Graph = ww::CompactGridGraph<>;
+    using Vertex = Graph::vertex_type;
+    CATCH_STATIC_REQUIRE(sizeof(Vertex) == sizeof(std::uint32_t));
+
+    const auto graph = Graph(3U, 4U);
+    const auto grid = ww::RectangularGridGraph<1, std::uint32_t>(3U, 4U);
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_rows() == 3U);
+        CATCH_CHECK(graph.num_cols() == 4U);
+        CATCH_CHECK(graph.num_vertices() == grid.num_vertices());
+        CATCH_CHECK(graph.num_edges() == grid.num_edges());
+    }
+
+    CATCH_SECTION("vertices")
+    {
+        const auto vertices = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U};
+        CATCH_CHECK_THAT(graph.vertices(), CM::RangeEquals(vertices));
+
+        for (const auto& vertex : graph.vertices()) {
+            CATCH_CHECK(graph.contains_vertex(vertex));
+            CATCH_CHECK(graph.get_vertex_id(vertex) == vertex);
+
+            const auto row = graph.vertex_row(vertex);
+            const auto col = graph.vertex_col(vertex);
+            CATCH_CHECK(graph.make_vertex(row, col) == vertex);
+            CATCH_CHECK(grid.get_vertex_id({row, col}) == graph.get_vertex_id(vertex));
+        }
+        CATCH_CHECK_FALSE(graph.contains_vertex(12U));
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        // Outgoing edges match those of the equivalent `RectangularGridGraph`.
+        for (const auto& vertex : grid.vertices()) {
+            const auto compact_vertex = graph.make_vertex(vertex.first, vertex.second);
+            CATCH_CHECK(graph.outdegree(compact_vertex) == grid.outdegree(vertex));
+
+            const auto outgoing_edges = graph.outgoing_edges(compact_vertex);
+            CATCH_CHECK(std::size(outgoing_edges) == grid.outdegree(vertex));
+
+            auto it = std::begin(outgoing_edges);
+            for (const auto& [edge, head] : grid.outgoing_edges(vertex)) {
+                const auto& [compact_edge, compact_head] = *it;
+                CATCH_CHECK(compact_edge == edge);
+                CATCH_CHECK(compact_head == grid.get_vertex_id(head));
+                ++it;
+            }
+        }
+    }
+
+    CATCH_SECTION("get_{up,left,down,right}_edge")
+    {
+        const auto vertex = graph.make_vertex(1U, 2U);
+        const auto grid_vertex = std::pair<std::uint32_t, std::uint32_t>(1U, 2U);
+        CATCH_CHECK(graph.get_up_edge(vertex) == grid.get_up_edge(grid_vertex));
+        CATCH_CHECK(graph.get_left_edge(vertex) == grid.get_left_edge(grid_vertex));
+        CATCH_CHECK(graph.get_down_edge(vertex) == grid.get_down_edge(grid_vertex));
+        CATCH_CHECK(graph.get_right_edge(vertex) == grid.get_right_edge(grid_vertex));
+    }
+}
+
+} // namespace
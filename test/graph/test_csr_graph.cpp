@@ -1,8 +1,13 @@
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <random>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 
@@ -268,4 +273,71 @@ CATCH_TEST_CASE("CSRGraph (self loops)", "[graph]")
     }
 }
 
+CATCH_TEST_CASE("CSRGraph (multithreaded construction)", "[graph]")
+{
+    // A large random edge list in arbitrary order.
+    auto rng = std::mt19937(1234U);
+    auto vertex_dist = std::uniform_int_distribution<std::size_t>(0U, 499U);
+    auto edgelist = ww::EdgeList();
+    for (std::size_t i = 0; i < 10'000U; ++i) {
+        edgelist.add_edge(vertex_dist(rng), vertex_dist(rng));
+    }
+
+    // The expected sequence of edges, in (tail,head) order.
+    auto sorted_edges = std::vector(std::begin(edgelist), std::end(edgelist));
+    std::sort(std::begin(sorted_edges), std::end(sorted_edges));
+
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{2}, std::size_t{7});
+    const auto graph = ww::CSRGraph(edgelist, num_threads);
+
+    CATCH_CHECK(graph.num_vertices() == sorted_edges.back().first + 1U);
+    CATCH_CHECK(graph.num_edges() == std::size(sorted_edges));
+
+    auto actual_edges = std::vector<std::pair<std::size_t, std::size_t>>();
+    for (const auto& tail : graph.vertices()) {
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            CATCH_CHECK(edge == std::size(actual_edges));
+            actual_edges.emplace_back(tail, head);
+        }
+    }
+    CATCH_CHECK(actual_edges == sorted_edges);
+}
+
+CATCH_TEST_CASE("CSRGraph (32-bit indices)", "[graph]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    CATCH_STATIC_REQUIRE((std::is_same_v<Graph::vertex_type, std::uint32_t>));
+    CATCH_STATIC_REQUIRE((std::is_same_v<Graph::edge_type, std::uint32_t>));
+    CATCH_STATIC_REQUIRE((std::is_same_v<Graph::size_type, std::size_t>));
+
+    // The edge list vertex type need not match the graph's vertex type.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 3U);
+    edgelist.add_edge(2U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(3U, 0U);
+    edgelist.add_edge(0U, 1U);
+
+    const auto graph = Graph(edgelist);
+    const auto reference = ww::CSRGraph(edgelist);
+
+    CATCH_CHECK(graph.num_vertices() == reference.num_vertices());
+    CATCH_CHECK(graph.num_edges() == reference.num_edges());
+
+    for (const auto& vertex : graph.vertices()) {
+        CATCH_CHECK(graph.outdegree(vertex) == reference.outdegree(vertex));
+
+        auto it = std::begin(reference.outgoing_edges(vertex));
+        for (const auto& [edge, head] : graph.outgoing_edges(vertex)) {
+            const auto [reference_edge, reference_head] = *it;
+            CATCH_CHECK(edge == reference_edge);
+            CATCH_CHECK(head == reference_head);
+            ++it;
+        }
+    }
+
+    // Vertex 1 has no outgoing edges.
+    CATCH_CHECK(std::empty(graph.outgoing_edges(1U)));
+}
+
 } // namespace
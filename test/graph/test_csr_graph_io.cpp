@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/common/mapped_file.hpp>
+#include <whirlwind/container/const_span.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/csr_graph_io.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+
+#include "../testing/matchers/graph_matchers.hpp"
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace fs = std::filesystem;
+namespace ww = whirlwind;
+
+// Get the path of a temporary file that is removed when the object is destroyed.
+struct TemporaryFile {
+    explicit TemporaryFile(const std::string& name)
+        : path(fs::temp_directory_path() / name)
+    {}
+
+    TemporaryFile(const TemporaryFile&) = delete;
+    auto
+    operator=(const TemporaryFile&) -> TemporaryFile& = delete;
+
+    ~TemporaryFile() { fs::remove(path); }
+
+    fs::path path;
+};
+
+CATCH_TEMPLATE_TEST_CASE("CSRGraph (binary file)",
+                         "[graph]",
+                         std::size_t,
+                         std::uint32_t)
+{
+    using Graph = ww::CSRGraph<ww::Vector, TestType>;
+
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(0U, 3U);
+    edgelist.add_edge(2U, 1U);
+    edgelist.add_edge(3U, 2U);
+    edgelist.add_edge(6U, 6U);
+
+    const auto graph = Graph(edgelist);
+    const auto file = TemporaryFile("whirlwind_test_csr_graph_" +
+                                    std::to_string(sizeof(TestType)) + ".bin");
+    {
+        auto os = std::ofstream(file.path, std::ios::binary);
+        ww::write_csr_graph(os, graph);
+    }
+
+    CATCH_SECTION("map_csr_graph")
+    {
+        const auto mapped_file = ww::MappedFile(file.path.string());
+        const auto mapped_graph = ww::map_csr_graph<TestType>(mapped_file);
+
+        CATCH_CHECK(mapped_graph.num_vertices() == graph.num_vertices());
+        CATCH_CHECK(mapped_graph.num_edges() == graph.num_edges());
+        CATCH_CHECK_THAT(mapped_graph.row_offsets(),
+                         CM::RangeEquals(graph.row_offsets()));
+        CATCH_CHECK_THAT(mapped_graph.column_indices(),
+                         CM::RangeEquals(graph.column_indices()));
+
+        for (const auto& vertex : graph.vertices()) {
+            CATCH_CHECK_THAT(mapped_graph.outgoing_edges(vertex),
+                             CM::RangeEquals(graph.outgoing_edges(vertex)));
+        }
+    }
+
+    CATCH_SECTION("index type mismatch")
+    {
+        const auto mapped_file = ww::MappedFile(file.path.string());
+        if constexpr (sizeof(TestType) == sizeof(std::uint32_t)) {
+            CATCH_CHECK_THROWS_AS(ww::map_csr_graph<std::uint64_t>(mapped_file),
+                                  std::runtime_error);
+        } else {
+            CATCH_CHECK_THROWS_AS(ww::map_csr_graph<std::uint32_t>(mapped_file),
+                                  std::runtime_error);
+        }
+    }
+}
+
+CATCH_TEST_CASE("map_csr_graph (invalid file)", "[graph]")
+{
+    const auto file = TemporaryFile("whirlwind_test_csr_graph_invalid.bin");
+
+    CATCH_SECTION("bad magic")
+    {
+        {
+            auto os = std::ofstream(file.path, std::ios::binary);
+            os << std::string(128, 'x');
+        }
+        const auto mapped_file = ww::MappedFile(file.path.string());
+        CATCH_CHECK_THROWS_AS(ww::map_csr_graph(mapped_file), std::runtime_error);
+    }
+
+    CATCH_SECTION("truncated")
+    {
+        auto edgelist = ww::EdgeList();
+        edgelist.add_edge(0U, 1U);
+        edgelist.add_edge(1U, 2U);
+        edgelist.add_edge(2U, 0U);
+        {
+            auto os = std::ofstream(file.path, std::ios::binary);
+            ww::write_csr_graph(os, ww::CSRGraph(edgelist));
+        }
+        fs::resize_file(file.path, fs::file_size(file.path) - 1);
+        const auto mapped_file = ww::MappedFile(file.path.string());
+        CATCH_CHECK_THROWS_AS(ww::map_csr_graph(mapped_file), std::runtime_error);
+    }
+
+    CATCH_SECTION("missing")
+    {
+        CATCH_CHECK_THROWS_AS(ww::MappedFile(file.path.string() + ".missing"),
+                              std::system_error);
+    }
+}
+
+} // namespace
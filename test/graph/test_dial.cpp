@@ -304,4 +304,115 @@ CATCH_TEST_CASE("Dial.done", "[graph]")
     CATCH_CHECK(dial.done());
 }
 
+CATCH_TEST_CASE("Dial (arc length exceeds num buckets)", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+
+    const auto tail = 0U;
+    const auto heads = {1U, 2U};
+    const auto edges = {0U, 1U};
+    const auto distances = {2, 10};
+
+    auto edgelist = ww::EdgeList();
+    for (const auto& head : heads) {
+        edgelist.add_edge(tail, head);
+    }
+
+    const auto graph = Graph(edgelist);
+
+    const auto num_buckets = 4U;
+    auto dial = ww::Dial<Distance, Graph>(graph, num_buckets);
+
+    dial.add_source(tail);
+    const auto [source, source_distance] = dial.pop_next_unvisited_vertex();
+    dial.visit_vertex(source, source_distance);
+    for (auto&& [edge, head, length] : ranges::views::zip(edges, heads, distances)) {
+        dial.relax_edge(edge, tail, head, length);
+    }
+
+    // The ring buffer should have grown to accommodate the longest arc.
+    CATCH_CHECK(dial.num_buckets() > 10U);
+    CATCH_CHECK(std::size(dial.buckets()) == dial.num_buckets());
+
+    for (auto&& [head, distance] : ranges::views::zip(heads, distances)) {
+        CATCH_CHECK_FALSE(dial.done());
+        CATCH_CHECK(dial.current_bucket_id() == dial.get_bucket_id(distance));
+        const auto [vertex, vertex_distance] = dial.pop_next_unvisited_vertex();
+        CATCH_CHECK(vertex == head);
+        CATCH_CHECK(vertex_distance == distance);
+        dial.visit_vertex(vertex, vertex_distance);
+    }
+
+    CATCH_CHECK(dial.done());
+}
+
+CATCH_TEST_CASE("Dial (occupancy)", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(1U, 3U);
+
+    const auto graph = Graph(edgelist);
+
+    // Use enough buckets that the occupancy bitmap spans multiple words.
+    const auto num_buckets = 150U;
+    auto dial = ww::Dial<Distance, Graph>(graph, num_buckets);
+    for (std::size_t bucket_id = 0; bucket_id < num_buckets; ++bucket_id) {
+        CATCH_CHECK_FALSE(dial.is_bucket_occupied(bucket_id));
+    }
+
+    dial.add_source(0U);
+    CATCH_CHECK(dial.is_bucket_occupied(0U));
+    CATCH_CHECK_FALSE(dial.done());
+    const auto [source, source_distance] = dial.pop_next_unvisited_vertex();
+    dial.visit_vertex(source, source_distance);
+    dial.relax_edge(0U, source, 1U, 70);
+    dial.relax_edge(1U, source, 2U, 140);
+    CATCH_CHECK(dial.is_bucket_occupied(70U));
+    CATCH_CHECK(dial.is_bucket_occupied(140U));
+
+    // `done()` skips over the empty buckets between occupied buckets and clears the
+    // occupancy of buckets whose contents are exhausted.
+    CATCH_CHECK_FALSE(dial.done());
+    CATCH_CHECK(dial.current_bucket_id() == 70U);
+    CATCH_CHECK_FALSE(dial.is_bucket_occupied(0U));
+    {
+        const auto [vertex, distance] = dial.pop_next_unvisited_vertex();
+        CATCH_CHECK(vertex == 1U);
+        dial.visit_vertex(vertex, distance);
+        dial.relax_edge(2U, vertex, 3U, distance + 100);
+    }
+
+    // The distance to vertex 3 wraps around to a bucket preceding the current bucket.
+    CATCH_CHECK(dial.get_bucket_id(170) == 20U);
+    CATCH_CHECK(dial.is_bucket_occupied(20U));
+
+    const auto vertices = {2U, 3U};
+    const auto bucket_ids = {140U, 20U};
+    for (auto&& [v, bucket_id] : ranges::views::zip(vertices, bucket_ids)) {
+        CATCH_CHECK_FALSE(dial.done());
+        CATCH_CHECK(dial.current_bucket_id() == bucket_id);
+        const auto [vertex, distance] = dial.pop_next_unvisited_vertex();
+        CATCH_CHECK(vertex == v);
+        dial.visit_vertex(vertex, distance);
+    }
+    CATCH_CHECK(dial.done());
+    for (std::size_t bucket_id = 0; bucket_id < num_buckets; ++bucket_id) {
+        CATCH_CHECK_FALSE(dial.is_bucket_occupied(bucket_id));
+    }
+
+    // Reset clears any buckets that are still occupied.
+    dial.reset();
+    dial.add_source(1U);
+    dial.reset();
+    CATCH_CHECK_FALSE(dial.is_bucket_occupied(0U));
+    CATCH_CHECK_THAT(dial.buckets(), CM::AllMatch(CM::IsEmpty()));
+    CATCH_CHECK(dial.done());
+}
+
 } // namespace
@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <vector>
 
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_container_properties.hpp>
@@ -12,6 +13,9 @@
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 
+#include <whirlwind/container/indexed_dary_heap.hpp>
+#include <whirlwind/container/indexed_pairing_heap.hpp>
+#include <whirlwind/container/radix_heap.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/dijkstra.hpp>
 #include <whirlwind/graph/edge_list.hpp>
@@ -282,4 +286,123 @@ CATCH_TEST_CASE("Dijkstra.done (visited)", "[graph]")
     CATCH_CHECK(dijkstra.done());
 }
 
+CATCH_TEMPLATE_TEST_CASE("Dijkstra (indexed heap)",
+                         "[graph]",
+                         (ww::IndexedDaryHeap<ww::CSRGraph<>::vertex_type, int>),
+                         (ww::IndexedPairingHeap<ww::CSRGraph<>::vertex_type, int>))
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+    using Heap = TestType;
+
+    const auto source = 0U;
+
+    // Vertex 2 is reachable from the source via two different paths.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(source, 1U);
+    edgelist.add_edge(source, 2U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 3U);
+
+    const auto graph = Graph(edgelist);
+
+    auto dijkstra = ww::Dijkstra<Distance, Graph, ww::Vector, Heap>(graph);
+    CATCH_CHECK(dijkstra.heap().capacity() == graph.num_vertices());
+
+    dijkstra.add_source(source);
+    const auto [vertex, distance] = dijkstra.pop_next_unvisited_vertex();
+    CATCH_CHECK(vertex == source);
+    dijkstra.visit_vertex(vertex, distance);
+
+    dijkstra.relax_edge(0U, source, 1U, 1);
+    dijkstra.relax_edge(1U, source, 2U, 10);
+    CATCH_CHECK(dijkstra.heap().size() == 2U);
+
+    // Vertex 1 is visited next. Finding a shorter path to vertex 2 decreases its key
+    // in-place rather than inserting a duplicate heap entry.
+    {
+        const auto [v, d] = dijkstra.pop_next_unvisited_vertex();
+        CATCH_CHECK(v == 1U);
+        CATCH_CHECK(d == 1);
+        dijkstra.visit_vertex(v, d);
+        dijkstra.relax_edge(2U, v, 2U, d + 2);
+    }
+    CATCH_CHECK(dijkstra.heap().size() == 1U);
+    CATCH_CHECK(dijkstra.distance_to_vertex(2U) == 3);
+    CATCH_CHECK(dijkstra.predecessor_vertex(2U) == 1U);
+
+    {
+        const auto [v, d] = dijkstra.pop_next_unvisited_vertex();
+        CATCH_CHECK(v == 2U);
+        CATCH_CHECK(d == 3);
+        dijkstra.visit_vertex(v, d);
+    }
+    CATCH_CHECK(dijkstra.done());
+
+    dijkstra.reset();
+    CATCH_CHECK(dijkstra.heap().empty());
+    CATCH_CHECK(dijkstra.done());
+}
+
+CATCH_TEST_CASE("Dijkstra (radix heap)", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+    using Vertex = Graph::vertex_type;
+    using Heap = ww::RadixHeap<Vertex, Distance>;
+
+    // A graph with a wide range of edge lengths.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(1U, 3U);
+    edgelist.add_edge(2U, 3U);
+    edgelist.add_edge(2U, 4U);
+    edgelist.add_edge(3U, 4U);
+    edgelist.add_edge(4U, 0U);
+
+    const auto graph = Graph(edgelist);
+    const auto lengths = std::vector<Distance>{
+            1'000'000, 5, 3, 7'000'000, 100'000, 20'000'000, 1, 1};
+
+    const auto solve = [&](auto& dijkstra) {
+        dijkstra.add_source(0U);
+        while (!dijkstra.done()) {
+            const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
+            dijkstra.visit_vertex(tail, distance);
+            for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+                if (dijkstra.has_visited_vertex(head)) {
+                    continue;
+                }
+                const auto new_distance = distance + lengths[graph.get_edge_id(edge)];
+                if (new_distance < dijkstra.distance_to_vertex(head)) {
+                    dijkstra.relax_edge(edge, tail, head, new_distance);
+                }
+            }
+        }
+    };
+
+    auto dijkstra = ww::Dijkstra<Distance, Graph, ww::Vector, Heap>(graph);
+    solve(dijkstra);
+    CATCH_CHECK_THAT(dijkstra.heap(), CM::IsEmpty());
+
+    auto reference = ww::Dijkstra<Distance, Graph>(graph);
+    solve(reference);
+
+    for (const auto& vertex : graph.vertices()) {
+        CATCH_CHECK(dijkstra.has_visited_vertex(vertex));
+        CATCH_CHECK(dijkstra.distance_to_vertex(vertex) ==
+                    reference.distance_to_vertex(vertex));
+        CATCH_CHECK(dijkstra.predecessor_vertex(vertex) ==
+                    reference.predecessor_vertex(vertex));
+    }
+    CATCH_CHECK(dijkstra.distance_to_vertex(4U) == 100'006);
+
+    dijkstra.reset();
+    CATCH_CHECK(dijkstra.heap().empty());
+    CATCH_CHECK(dijkstra.heap().min_key() == 0);
+    CATCH_CHECK(dijkstra.done());
+}
+
 } // namespace
@@ -1,10 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/container/indexed_dary_heap.hpp>
+#include <whirlwind/container/indexed_pairing_heap.hpp>
+#include <whirlwind/container/radix_heap.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/dial.hpp>
 #include <whirlwind/graph/dijkstra.hpp>
 #include <whirlwind/graph/dijkstra_concepts.hpp>
+#include <whirlwind/graph/dijkstra_visitor.hpp>
 
 namespace {
 
@@ -21,6 +25,44 @@ CATCH_TEST_CASE("DijkstraSolverType", "[graph]")
     using Graph = ww::CSRGraph<>;
     require_satisfies_dijkstra_solver_type<ww::Dijkstra<Distance, Graph>>();
     require_satisfies_dijkstra_solver_type<ww::Dial<Distance, Graph>>();
+
+    using Vertex = Graph::vertex_type;
+    using DaryHeap = ww::IndexedDaryHeap<Vertex, Distance>;
+    using PairingHeap = ww::IndexedPairingHeap<Vertex, Distance>;
+    require_satisfies_dijkstra_solver_type<
+            ww::Dijkstra<Distance, Graph, ww::Vector, DaryHeap>>();
+    require_satisfies_dijkstra_solver_type<
+            ww::Dijkstra<Distance, Graph, ww::Vector, PairingHeap>>();
+
+    using RadixHeap = ww::RadixHeap<Vertex, Distance>;
+    require_satisfies_dijkstra_solver_type<
+            ww::Dijkstra<Distance, Graph, ww::Vector, RadixHeap>>();
+}
+
+CATCH_TEST_CASE("DijkstraVisitorType", "[graph]")
+{
+    using Distance = int;
+    using Graph = ww::CSRGraph<>;
+    using Dijkstra = ww::Dijkstra<Distance, Graph>;
+    using Dial = ww::Dial<Distance, Graph>;
+
+    CATCH_STATIC_REQUIRE(ww::DijkstraVisitorType<ww::NullDijkstraVisitor, Dijkstra>);
+    CATCH_STATIC_REQUIRE(ww::DijkstraVisitorType<ww::NullDijkstraVisitor, Dial>);
+
+    // A visitor must accept every event.
+    struct PopVisitor {
+        void
+        on_pop(Graph::vertex_type, Distance)
+        {}
+    };
+    CATCH_STATIC_REQUIRE(!ww::DijkstraVisitorType<PopVisitor, Dijkstra>);
+
+    struct DerivedPopVisitor : ww::NullDijkstraVisitor {
+        void
+        on_pop(Graph::vertex_type, Distance)
+        {}
+    };
+    CATCH_STATIC_REQUIRE(ww::DijkstraVisitorType<DerivedPopVisitor, Dijkstra>);
 }
 
 } // namespace
@@ -1,8 +1,12 @@
+#include <cstdint>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include <whirlwind/common/compatibility.hpp>
+#include <whirlwind/graph/compact_grid_graph.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/graph_concepts.hpp>
+#include <whirlwind/graph/permuted_csr_graph.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 
 namespace {
@@ -17,7 +21,11 @@ require_satisfies_graph_type() noexcept
 CATCH_TEST_CASE("GraphType", "[graph]")
 {
     require_satisfies_graph_type<ww::CSRGraph<>>();
+    require_satisfies_graph_type<ww::CSRGraph<ww::Vector, std::uint32_t>>();
+    require_satisfies_graph_type<ww::PermutedCSRGraph<>>();
+    require_satisfies_graph_type<ww::PermutedCSRGraph<ww::Vector, std::uint32_t>>();
     require_satisfies_graph_type<ww::RectangularGridGraph<>>();
+    require_satisfies_graph_type<ww::CompactGridGraph<>>();
 }
 
 } // namespace
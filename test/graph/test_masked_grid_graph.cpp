@@ -0,0 +1,214 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/masked_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+// A 4x5 vertex mask with a masked vertex in the interior and one on the border.
+//
+//   1 1 1 1 1
+//   1 1 0 1 1
+//   1 1 1 1 1
+//   0 1 1 1 1
+//
+const auto mask = std::vector<int>{
+        1, 1, 1, 1, 1, //
+        1, 1, 0, 1, 1, //
+        1, 1, 1, 1, 1, //
+        0, 1, 1, 1, 1, //
+};
+
+CATCH_TEST_CASE("MaskedGridGraph", "[graph]")
+{
+    using Graph = ww::MaskedGridGraph<>;
+    using Vertex = Graph::vertex_type;
+    using Edge = Graph::edge_type;
+    using Pair = std::pair<Edge, Vertex>;
+
+    const auto graph = Graph(4U, 5U, mask);
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 18U);
+
+        // The full grid has 3 * 5 + 4 * 4 = 31 pairs of adjacent vertices. The
+        // interior masked vertex removes 4 of them and the border vertex removes 2.
+        CATCH_CHECK(graph.num_edges() == 2U * 25U);
+    }
+
+    CATCH_SECTION("vertices")
+    {
+        // Vertices are visited in row-major order, skipping masked vertices, and
+        // numbered consecutively.
+        std::size_t k = 0;
+        for (const auto& vertex : graph.vertices()) {
+            CATCH_CHECK(graph.contains_vertex(vertex));
+            CATCH_CHECK(graph.get_vertex_id(vertex) == k);
+            ++k;
+        }
+        CATCH_CHECK(k == graph.num_vertices());
+
+        CATCH_CHECK_FALSE(graph.contains_vertex(Vertex(1U, 2U)));
+        CATCH_CHECK_FALSE(graph.contains_vertex(Vertex(3U, 0U)));
+        CATCH_CHECK_FALSE(graph.contains_vertex(Vertex(4U, 0U)));
+        CATCH_CHECK(graph.get_vertex_id(Vertex(1U, 3U)) == 7U);
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        // Outgoing edges to masked vertices are skipped.
+        const auto vertex = Vertex(1U, 1U);
+        const auto expected = {
+                Pair(graph.get_up_edge(vertex), Vertex(0U, 1U)),
+                Pair(graph.get_left_edge(vertex), Vertex(1U, 0U)),
+                Pair(graph.get_down_edge(vertex), Vertex(2U, 1U)),
+        };
+        CATCH_CHECK(graph.outdegree(vertex) == 3U);
+        CATCH_CHECK_THAT(graph.outgoing_edges(vertex), CM::RangeEquals(expected));
+
+        const auto corner = Vertex(3U, 1U);
+        const auto expected_corner = {
+                Pair(graph.get_up_edge(corner), Vertex(2U, 1U)),
+                Pair(graph.get_right_edge(corner), Vertex(3U, 2U)),
+        };
+        CATCH_CHECK_THAT(graph.outgoing_edges(corner),
+                         CM::RangeEquals(expected_corner));
+    }
+
+    CATCH_SECTION("outgoing_edges (all)")
+    {
+        // Each edge is the outgoing edge of exactly one vertex, and the two opposing
+        // edges between each pair of adjacent vertices are numbered consecutively.
+        auto num_tails = std::vector<std::size_t>(graph.num_edges(), 0U);
+        for (const auto& tail : graph.vertices()) {
+            const auto outgoing_edges = graph.outgoing_edges(tail);
+            CATCH_CHECK(std::size(outgoing_edges) == graph.outdegree(tail));
+            for (const auto& [edge, head] : outgoing_edges) {
+                CATCH_CHECK(graph.contains_edge(edge));
+                CATCH_CHECK(graph.contains_vertex(head));
+                ++num_tails[graph.get_edge_id(edge)];
+
+                auto reverse_edges = std::vector<Edge>();
+                for (const auto& [reverse_edge, reverse_head] :
+                     graph.outgoing_edges(head)) {
+                    if (reverse_head == tail) {
+                        reverse_edges.push_back(reverse_edge);
+                    }
+                }
+                const auto expected_reverse = std::vector<Edge>{edge ^ 1U};
+                CATCH_CHECK_THAT(reverse_edges, CM::RangeEquals(expected_reverse));
+            }
+        }
+        CATCH_CHECK_THAT(num_tails, CM::RangeEquals(std::vector<std::size_t>(
+                                             graph.num_edges(), 1U)));
+    }
+
+    CATCH_SECTION("outgoing_edges (range)")
+    {
+        using OutgoingEdges = decltype(graph.outgoing_edges(Vertex(0U, 0U)));
+        CATCH_STATIC_REQUIRE(std::ranges::contiguous_range<OutgoingEdges>);
+        CATCH_STATIC_REQUIRE(std::ranges::sized_range<OutgoingEdges>);
+        CATCH_STATIC_REQUIRE(OutgoingEdges::capacity() == 4U);
+    }
+}
+
+CATCH_TEST_CASE("MaskedGridGraph (parallel edges)", "[graph]")
+{
+    using Graph = ww::MaskedGridGraph<2>;
+
+    const auto graph = Graph(Graph(4U, 5U, mask));
+    CATCH_CHECK(graph.num_vertices() == 18U);
+    CATCH_CHECK(graph.num_edges() == 4U * 25U);
+
+    for (const auto& tail : graph.vertices()) {
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            CATCH_CHECK(graph.contains_edge(edge));
+        }
+    }
+}
+
+CATCH_TEST_CASE("MaskedGridGraph (network)", "[graph]")
+{
+    using Graph = ww::MaskedGridGraph<1, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    using CSRGraph = ww::CSRGraph<>;
+    using CSRNetwork = ww::Network<CSRGraph, int, int, ww::Vector,
+                                   ww::UnitCapacityMixin<CSRGraph, int>>;
+    using CSRDijkstra = ww::Dijkstra<int, CSRNetwork::residual_graph_type>;
+
+    const auto graph = Graph(4U, 5U, mask);
+
+    // Assign each edge a cost that depends only on its endpoints, so that the same
+    // problem can be posed on an equivalent `CSRGraph`.
+    const auto edge_cost = [](std::size_t tail_id, std::size_t head_id) {
+        return 1 + static_cast<int>((3 * tail_id + 5 * head_id) % 7);
+    };
+
+    auto cost = std::vector<int>(graph.num_edges());
+    auto edgelist = ww::EdgeList<std::size_t>();
+    for (const auto& tail : graph.vertices()) {
+        const auto tail_id = graph.get_vertex_id(tail);
+        for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+            const auto head_id = graph.get_vertex_id(head);
+            cost[graph.get_edge_id(edge)] = edge_cost(tail_id, head_id);
+            edgelist.add_edge(tail_id, head_id);
+        }
+    }
+    const auto csr_graph = CSRGraph(edgelist);
+
+    auto csr_cost = std::vector<int>(csr_graph.num_edges());
+    for (const auto& tail : csr_graph.vertices()) {
+        for (const auto& [edge, head] : csr_graph.outgoing_edges(tail)) {
+            csr_cost[csr_graph.get_edge_id(edge)] = edge_cost(tail, head);
+        }
+    }
+
+    auto surplus = std::vector<int>(graph.num_vertices(), 0);
+    surplus[graph.get_vertex_id({0U, 0U})] = 1;
+    surplus[graph.get_vertex_id({1U, 1U})] = 1;
+    surplus[graph.get_vertex_id({2U, 4U})] = -1;
+    surplus[graph.get_vertex_id({3U, 2U})] = -1;
+
+    auto network = Network(graph, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(network);
+
+    auto expected = CSRNetwork(csr_graph, surplus, csr_cost);
+    ww::successive_shortest_paths<CSRDijkstra>(expected);
+
+    CATCH_CHECK(network.num_nodes() == graph.num_vertices());
+    CATCH_CHECK(network.num_arcs() == 2U * graph.num_edges());
+    CATCH_CHECK(network.is_balanced());
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+    for (const auto& arc : network.arcs()) {
+        const auto transpose_id = network.get_transpose_arc_id(arc);
+        CATCH_CHECK(network.get_transpose_arc_id(transpose_id) == arc);
+        CATCH_CHECK(network.is_forward_arc(arc) !=
+                    network.is_forward_arc(transpose_id));
+    }
+}
+
+} // namespace
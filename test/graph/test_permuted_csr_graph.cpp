@@ -0,0 +1,65 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/permuted_csr_graph.hpp>
+
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("PermutedCSRGraph (empty)", "[graph]")
+{
+    const auto graph = ww::PermutedCSRGraph();
+    CATCH_CHECK(graph.num_vertices() == 0U);
+    CATCH_CHECK(graph.num_edges() == 0U);
+}
+
+CATCH_TEST_CASE("PermutedCSRGraph", "[graph]")
+{
+    using Graph = ww::PermutedCSRGraph<ww::Vector, std::uint32_t>;
+
+    // Edges: 0->1 (#2), 0->2 (#0), 1->2 (#3), 2->0 (#1).
+    const auto graph = Graph({0U, 2U, 3U, 4U}, {1U, 2U, 2U, 0U}, {2U, 0U, 3U, 1U});
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 3U);
+        CATCH_CHECK(graph.num_edges() == 4U);
+    }
+
+    CATCH_SECTION("outdegree")
+    {
+        CATCH_CHECK(graph.outdegree(0U) == 2U);
+        CATCH_CHECK(graph.outdegree(1U) == 1U);
+        CATCH_CHECK(graph.outdegree(2U) == 1U);
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        using Pair = std::pair<std::uint32_t, std::uint32_t>;
+        CATCH_CHECK_THAT(graph.outgoing_edges(0U),
+                         CM::RangeEquals(std::vector<Pair>{{2U, 1U}, {0U, 2U}}));
+        CATCH_CHECK_THAT(graph.outgoing_edges(1U),
+                         CM::RangeEquals(std::vector<Pair>{{3U, 2U}}));
+        CATCH_CHECK_THAT(graph.outgoing_edges(2U),
+                         CM::RangeEquals(std::vector<Pair>{{1U, 0U}}));
+    }
+
+    CATCH_SECTION("contains_{vertex,edge}")
+    {
+        CATCH_CHECK(graph.contains_vertex(2U));
+        CATCH_CHECK(!graph.contains_vertex(3U));
+        CATCH_CHECK(graph.contains_edge(3U));
+        CATCH_CHECK(!graph.contains_edge(4U));
+    }
+}
+
+} // namespace
@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("RectangularGridGraph", "[graph]")
+{
+    using Graph = ww::RectangularGridGraph<>;
+    using Vertex = Graph::vertex_type;
+    using Edge = Graph::edge_type;
+    using Pair = std::pair<Edge, Vertex>;
+
+    const auto graph = Graph(3U, 4U);
+
+    CATCH_SECTION("num_{vertices,edges}")
+    {
+        CATCH_CHECK(graph.num_vertices() == 12U);
+        CATCH_CHECK(graph.num_edges() == 2U * (2U * 4U + 3U * 3U));
+    }
+
+    CATCH_SECTION("outgoing_edges")
+    {
+        // Outgoing edges are ordered up, left, down, right.
+        const auto interior = Vertex(1U, 1U);
+        const auto expected = {
+                Pair(graph.get_up_edge(interior), Vertex(0U, 1U)),
+                Pair(graph.get_left_edge(interior), Vertex(1U, 0U)),
+                Pair(graph.get_down_edge(interior), Vertex(2U, 1U)),
+                Pair(graph.get_right_edge(interior), Vertex(1U, 2U)),
+        };
+        CATCH_CHECK_THAT(graph.outgoing_edges(interior), CM::RangeEquals(expected));
+
+        const auto corner = Vertex(2U, 3U);
+        const auto expected_corner = {
+                Pair(graph.get_up_edge(corner), Vertex(1U, 3U)),
+                Pair(graph.get_left_edge(corner), Vertex(2U, 2U)),
+        };
+        CATCH_CHECK_THAT(graph.outgoing_edges(corner),
+                         CM::RangeEquals(expected_corner));
+    }
+
+    CATCH_SECTION("outgoing_edges (all)")
+    {
+        // Each edge is the outgoing edge of exactly one vertex.
+        auto num_tails = std::vector<std::size_t>(graph.num_edges(), 0U);
+        for (const auto& tail : graph.vertices()) {
+            const auto outgoing_edges = graph.outgoing_edges(tail);
+            CATCH_CHECK(std::size(outgoing_edges) == graph.outdegree(tail));
+            for (const auto& [edge, head] : outgoing_edges) {
+                CATCH_CHECK(graph.contains_edge(edge));
+                CATCH_CHECK(graph.contains_vertex(head));
+                ++num_tails[graph.get_edge_id(edge)];
+            }
+        }
+        CATCH_CHECK_THAT(num_tails, CM::RangeEquals(std::vector<std::size_t>(
+                                             graph.num_edges(), 1U)));
+    }
+
+    CATCH_SECTION("outgoing_edges (range)")
+    {
+        using OutgoingEdges = decltype(graph.outgoing_edges(Vertex(0U, 0U)));
+        CATCH_STATIC_REQUIRE(std::ranges::contiguous_range<OutgoingEdges>);
+        CATCH_STATIC_REQUIRE(std::ranges::sized_range<OutgoingEdges>);
+        CATCH_STATIC_REQUIRE(OutgoingEdges::capacity() == 4U);
+    }
+}
+
+CATCH_TEST_CASE("RectangularGridGraph (parallel edges)", "[graph]")
+{
+    using Graph = ww::RectangularGridGraph<2>;
+    using Vertex = Graph::vertex_type;
+    using Edge = Graph::edge_type;
+    using Pair = std::pair<Edge, Vertex>;
+
+    const auto graph = Graph(2U, 2U);
+
+    const auto vertex = Vertex(0U, 0U);
+    const auto down_edge = graph.get_down_edge(vertex);
+    const auto right_edge = graph.get_right_edge(vertex);
+
+    const auto expected = {
+            Pair(down_edge, Vertex(1U, 0U)),
+            Pair(down_edge + 1U, Vertex(1U, 0U)),
+            Pair(right_edge, Vertex(0U, 1U)),
+            Pair(right_edge + 1U, Vertex(0U, 1U)),
+    };
+    CATCH_CHECK_THAT(graph.outgoing_edges(vertex), CM::RangeEquals(expected));
+    CATCH_CHECK(graph.outdegree(vertex) == 4U);
+}
+
+} // namespace
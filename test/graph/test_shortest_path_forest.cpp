@@ -160,6 +160,56 @@ CATCH_TEST_CASE("ShortestPathForest (non-const)", "[graph]")
                 });
         CATCH_CHECK_THAT(distances, ww::testing::AllEqualTo(max_distance));
     }
+
+    CATCH_SECTION("reset (partial)")
+    {
+        shortest_paths.make_root_vertex(1U);
+        shortest_paths.label_vertex_reached(1U);
+        shortest_paths.set_distance_to_vertex(1U, 0);
+        shortest_paths.label_vertex_visited(1U);
+
+        shortest_paths.set_predecessor(2U, 1U, 1U);
+        shortest_paths.label_vertex_reached(2U);
+        shortest_paths.set_distance_to_vertex(2U, 5);
+
+        // Vertex 0 is assigned a distance without being reached.
+        shortest_paths.set_distance_to_vertex(0U, 7);
+
+        shortest_paths.reset();
+
+        using ww::testing::IsRootVertexIn;
+        using ww::testing::WasReachedBy;
+        CATCH_CHECK_THAT(graph.vertices(),
+                         CM::AllMatch(IsRootVertexIn(shortest_paths)));
+        CATCH_CHECK_THAT(graph.vertices(), CM::NoneMatch(WasReachedBy(shortest_paths)));
+        CATCH_CHECK(std::ranges::distance(shortest_paths.reached_vertices()) == 0U);
+        CATCH_CHECK(std::ranges::distance(shortest_paths.visited_vertices()) == 0U);
+
+        const auto distances =
+                graph.vertices() | ranges::views::transform([&](const auto& vertex) {
+                    return shortest_paths.distance_to_vertex(vertex);
+                });
+        CATCH_CHECK_THAT(distances, ww::testing::AllEqualTo(max_distance));
+    }
+
+    CATCH_SECTION("visited_vertices")
+    {
+        // Visited vertices are listed in the order that they were visited.
+        const auto vertices = {2U, 0U, 1U};
+        for (const auto& vertex : vertices) {
+            shortest_paths.label_vertex_reached(vertex);
+            shortest_paths.label_vertex_visited(vertex);
+        }
+        CATCH_CHECK_THAT(shortest_paths.visited_vertices(), CM::RangeEquals(vertices));
+
+        shortest_paths.reset();
+        CATCH_CHECK(std::ranges::distance(shortest_paths.visited_vertices()) == 0U);
+
+        shortest_paths.label_vertex_reached(1U);
+        shortest_paths.label_vertex_visited(1U);
+        const auto expected = {1U};
+        CATCH_CHECK_THAT(shortest_paths.visited_vertices(), CM::RangeEquals(expected));
+    }
 }
 
 } // namespace
@@ -0,0 +1,194 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+using Dial = ww::Dial<int, Network::residual_graph_type>;
+
+auto
+make_network(const Grid& grid) -> Network
+{
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[10] = 1;
+    surplus[11] = 1;
+    surplus[19] = 1;
+    surplus[20] = 1;
+    surplus[grid.num_vertices() - 11] = -1;
+    surplus[grid.num_vertices() - 12] = -1;
+    surplus[grid.num_vertices() - 20] = -1;
+    surplus[grid.num_vertices() - 21] = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((5 * edge) % 3);
+    }
+
+    return Network(grid, surplus, cost);
+}
+
+auto
+total_phase_time(const ww::SolverStats& stats) -> ww::SolverStats::duration_type
+{
+    auto total = ww::SolverStats::duration_type::zero();
+    for (const auto& t : stats.phase_time) {
+        CATCH_CHECK(t >= ww::SolverStats::duration_type::zero());
+        total += t;
+    }
+    return total;
+}
+
+CATCH_TEST_CASE("NullSolverStats", "[logging]")
+{
+    CATCH_STATIC_REQUIRE(!ww::NullSolverStats::enabled);
+    CATCH_STATIC_REQUIRE(ww::SolverStats::enabled);
+
+    // Solving with the null policy gives the same result as solving without one.
+    const auto grid = Grid(8U, 9U);
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    auto network = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(
+            network, ww::SuccessiveShortestPathsSearch::goal_directed,
+            ww::NullSolverStats());
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+}
+
+CATCH_TEST_CASE("SolverStats", "[logging]")
+{
+    const auto grid = Grid(8U, 9U);
+
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        const auto search = GENERATE(ww::SuccessiveShortestPathsSearch::dijkstra,
+                                     ww::SuccessiveShortestPathsSearch::goal_directed);
+
+        auto network = make_network(grid);
+        const auto initial_excess = static_cast<std::size_t>(network.total_excess());
+        auto stats = ww::SolverStats();
+        ww::successive_shortest_paths<Dijkstra>(network, search, stats);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        // Each iteration routes one unit of flow in a unit capacity network.
+        CATCH_CHECK(stats.num_iterations == initial_excess);
+        CATCH_CHECK(stats.excess_remaining == 0);
+
+        CATCH_CHECK(stats.nodes_visited >= stats.num_iterations);
+        CATCH_CHECK(stats.heap_pops == stats.nodes_visited);
+        CATCH_CHECK(stats.arcs_relaxed > 0);
+        CATCH_CHECK(stats.heap_pushes >= stats.heap_pops);
+        CATCH_CHECK(stats.heap_pushes <= stats.arcs_relaxed + stats.nodes_visited);
+        CATCH_CHECK(stats.heap_pops + stats.stale_pops <= stats.heap_pushes);
+
+        CATCH_CHECK(total_phase_time(stats) == stats.total_time());
+        CATCH_CHECK(stats.time(ww::SolverPhase::admissible_augment) ==
+                    ww::SolverStats::duration_type::zero());
+    }
+
+    CATCH_SECTION("successive_shortest_paths (Dial)")
+    {
+        auto network = make_network(grid);
+        auto stats = ww::SolverStats();
+        ww::successive_shortest_paths<Dial>(
+                network, ww::SuccessiveShortestPathsSearch::dijkstra, stats);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        // Dial's buckets aren't inspectable, so stale entries aren't counted.
+        CATCH_CHECK(stats.nodes_visited > 0);
+        CATCH_CHECK(stats.heap_pops == stats.nodes_visited);
+        CATCH_CHECK(stats.stale_pops == 0);
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        const auto phase = GENERATE(ww::PrimalDualPhase::single_path,
+                                    ww::PrimalDualPhase::blocking_flow,
+                                    ww::PrimalDualPhase::shortest_path_forest);
+
+        auto network = make_network(grid);
+        auto stats = ww::SolverStats();
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 0, phase, 0.0, ww::SuccessiveShortestPathsSearch::dijkstra,
+                stats);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::converged);
+        CATCH_CHECK(stats.num_iterations == summary.num_iterations);
+        CATCH_CHECK(stats.excess_remaining == 0);
+
+        // Each iteration visits every node.
+        CATCH_CHECK(stats.nodes_visited == stats.num_iterations * grid.num_vertices());
+        CATCH_CHECK(stats.heap_pops == stats.nodes_visited);
+
+        // Every heap entry is either popped or discarded by a full search.
+        CATCH_CHECK(stats.heap_pops + stats.stale_pops == stats.heap_pushes);
+        CATCH_CHECK(total_phase_time(stats) == stats.total_time());
+    }
+
+    CATCH_SECTION("primal_dual (max iterations)")
+    {
+        // The statistics include the successive shortest paths iterations that route
+        // the excess remaining after the primal-dual iterations.
+        auto network = make_network(grid);
+        auto stats = ww::SolverStats();
+        const auto search = GENERATE(ww::SuccessiveShortestPathsSearch::dijkstra,
+                                     ww::SuccessiveShortestPathsSearch::goal_directed);
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 1, ww::PrimalDualPhase::single_path, 0.0, search, stats);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::max_iterations);
+        CATCH_CHECK(stats.num_iterations == 1 + summary.remaining_excess);
+        CATCH_CHECK(stats.excess_remaining == 0);
+    }
+
+    CATCH_SECTION("accumulate")
+    {
+        auto network1 = make_network(grid);
+        auto stats1 = ww::SolverStats();
+        ww::successive_shortest_paths<Dijkstra>(
+                network1, ww::SuccessiveShortestPathsSearch::dijkstra, stats1);
+
+        auto network2 = make_network(grid);
+        auto stats2 = ww::SolverStats();
+        ww::successive_shortest_paths<Dijkstra>(
+                network2, ww::SuccessiveShortestPathsSearch::dijkstra, stats2);
+
+        auto total = stats1;
+        total += stats2;
+        CATCH_CHECK(total.num_iterations == 2 * stats1.num_iterations);
+        CATCH_CHECK(total.nodes_visited == 2 * stats1.nodes_visited);
+        CATCH_CHECK(total.arcs_relaxed == 2 * stats1.arcs_relaxed);
+        CATCH_CHECK(total.heap_pushes == 2 * stats1.heap_pushes);
+        CATCH_CHECK(total.total_time() == stats1.total_time() + stats2.total_time());
+
+        total.reset();
+        CATCH_CHECK(total.num_iterations == 0);
+        CATCH_CHECK(total.nodes_visited == 0);
+        CATCH_CHECK(total.total_time() == ww::SolverStats::duration_type::zero());
+    }
+}
+
+} // namespace
@@ -0,0 +1,173 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/network/admissible_path_search.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/solver_workspace.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("AdmissiblePathSearch", "[network]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+    using PathSearch = ww::AdmissiblePathSearch<Network::residual_graph_type>;
+
+    // Two disjoint paths from node 0 to node 3 (0->1->3 and 0->2->3), plus a
+    // dead-end branch 0->4.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 3U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(2U, 3U);
+    edgelist.add_edge(0U, 4U);
+    const auto graph = Graph(edgelist);
+
+    const auto surplus = std::vector<int>{2, 0, 0, -2, 0};
+
+    CATCH_SECTION("zero cost")
+    {
+        // With zero arc costs and node potentials, every unsaturated arc is
+        // admissible, so both units of excess are routed in a single pass.
+        const auto cost = std::vector<int>(graph.num_edges(), 0);
+        auto network = Network(graph, surplus, cost);
+        auto path_search = PathSearch(network);
+
+        CATCH_CHECK(path_search.augment(network) == 2U);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_deficit() == 0);
+        CATCH_CHECK(network.is_balanced());
+
+        // No excess remains, so no further paths are found.
+        CATCH_CHECK(path_search.augment(network) == 0U);
+    }
+
+    CATCH_SECTION("nonzero cost")
+    {
+        // No arc has zero reduced cost.
+        const auto cost = std::vector<int>(graph.num_edges(), 1);
+        auto network = Network(graph, surplus, cost);
+        auto path_search = PathSearch(network);
+
+        CATCH_CHECK(path_search.augment(network) == 0U);
+        CATCH_CHECK(network.total_excess() == 2);
+    }
+}
+
+CATCH_TEST_CASE("AdmissiblePathSearch (shared hub)", "[network]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+    using PathSearch = ww::AdmissiblePathSearch<Network::residual_graph_type>;
+
+    // Several excess nodes that each reach the deficit nodes only through a shared
+    // hub node (node 0). The hub's first outgoing arcs lead to dead-end nodes, each of
+    // which has an arc back to the hub, so every path after the first must resume the
+    // hub's scan past them.
+    constexpr std::uint32_t num_pairs = 5;
+    constexpr std::uint32_t num_dead_ends = 12;
+    const auto excess_node = [](std::uint32_t i) { return 1 + i; };
+    const auto deficit_node = [](std::uint32_t i) { return 1 + num_pairs + i; };
+    const auto dead_end_node = [](std::uint32_t i) { return 1 + 2 * num_pairs + i; };
+
+    auto edgelist = ww::EdgeList();
+    for (std::uint32_t i = 0; i < num_pairs; ++i) {
+        edgelist.add_edge(excess_node(i), 0U);
+    }
+    for (std::uint32_t i = 0; i < num_dead_ends; ++i) {
+        edgelist.add_edge(0U, dead_end_node(i));
+        edgelist.add_edge(dead_end_node(i), 0U);
+    }
+    for (std::uint32_t i = 0; i < num_pairs; ++i) {
+        edgelist.add_edge(0U, deficit_node(i));
+    }
+    const auto graph = Graph(edgelist);
+
+    auto surplus = std::vector<int>(graph.num_vertices(), 0);
+    for (std::uint32_t i = 0; i < num_pairs; ++i) {
+        surplus[excess_node(i)] = 1;
+        surplus[deficit_node(i)] = -1;
+    }
+    const auto cost = std::vector<int>(graph.num_edges(), 0);
+    auto network = Network(graph, surplus, cost);
+    auto path_search = PathSearch(network);
+
+    // Every unit of excess is routed in a single pass.
+    CATCH_CHECK(path_search.augment(network) == num_pairs);
+    CATCH_CHECK(network.total_excess() == 0);
+    CATCH_CHECK(network.is_balanced());
+}
+
+CATCH_TEST_CASE("primal_dual (blocking flow)", "[network]")
+{
+    using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+    using Network = ww::Network<Grid, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Grid, int>>;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    const auto grid = Grid(8U, 9U);
+
+    // A mix of single- and multi-unit residues.
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[10] = 2;
+    surplus[13] = 1;
+    surplus[22] = -1;
+    surplus[40] = 1;
+    surplus[50] = -2;
+    surplus[60] = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((3 * edge) % 4);
+    }
+
+    auto expected = Network(grid, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    CATCH_SECTION("primal_dual")
+    {
+        auto network = Network(grid, surplus, cost);
+        ww::primal_dual<Dijkstra>(network, 0, ww::PrimalDualPhase::blocking_flow);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("primal_dual (maxiter)")
+    {
+        auto network = Network(grid, surplus, cost);
+        ww::primal_dual<Dijkstra>(network, 1, ww::PrimalDualPhase::blocking_flow);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("SolverWorkspace")
+    {
+        auto workspace = ww::SolverWorkspace<Dijkstra>();
+        for (int i = 0; i < 2; ++i) {
+            auto network = Network(grid, surplus, cost);
+            ww::primal_dual(network, workspace, 0, ww::PrimalDualPhase::blocking_flow);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+        CATCH_CHECK(workspace.capacity() == grid.num_vertices());
+    }
+}
+
+} // namespace
@@ -0,0 +1,214 @@
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/batch_solve.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/shared_residual_graph.hpp>
+#include <whirlwind/network/solver_workspace.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Make the surplus of each node of a scene, with two pairs of opposite-signed residues
+// that depend on the scene index.
+template<class Graph>
+auto
+make_surplus(const Graph& graph, std::size_t scene) -> std::vector<int>
+{
+    const auto n = static_cast<std::size_t>(graph.num_vertices());
+    auto surplus = std::vector<int>(n, 0);
+    surplus[scene % 5] = 1;
+    surplus[7 + (scene % 3)] = 1;
+    surplus[n - 9] = -1;
+    surplus[n - 1 - (scene % 4)] = -1;
+    return surplus;
+}
+
+// Make pseudo-random edge costs that depend on the scene index.
+template<class Graph>
+auto
+make_cost(const Graph& graph, std::size_t scene) -> std::vector<int>
+{
+    auto cost = std::vector<int>(graph.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((7 * edge + 3 * scene) % 5);
+    }
+    return cost;
+}
+
+auto
+make_csr_graph() -> ww::CSRGraph<>
+{
+    auto edgelist = ww::EdgeList();
+    for (auto i = 0U; i < 30U; ++i) {
+        edgelist.add_edge(i, i + 1U);
+        edgelist.add_edge(i + 1U, i);
+        edgelist.add_edge(i, (i + 7U) % 31U);
+    }
+    return ww::CSRGraph<>(edgelist);
+}
+
+CATCH_TEST_CASE("SharedResidualGraph", "[network]")
+{
+    using Graph = ww::CSRGraph<>;
+    using Network = ww::Network<Graph, int, int>;
+    using SharedNetwork = ww::SharedResidualGraphNetwork<Graph, int, int>;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    const auto graph = make_csr_graph();
+    const auto shared = ww::SharedResidualGraph<ww::ResidualGraphMixin<Graph>>(graph);
+    CATCH_CHECK(shared.use_count() == 1);
+    CATCH_CHECK(shared.memory_usage() > 0);
+
+    const auto surplus = make_surplus(graph, 0);
+    const auto cost = make_cost(graph, 0);
+    auto expected = Network(graph, surplus, cost);
+    auto network = SharedNetwork(shared, surplus, cost);
+    CATCH_CHECK(shared.use_count() == 2);
+
+    CATCH_SECTION("topology")
+    {
+        CATCH_CHECK(&network.residual_graph() == &shared.get().residual_graph());
+        CATCH_CHECK(network.num_nodes() == expected.num_nodes());
+        CATCH_CHECK(network.num_arcs() == expected.num_arcs());
+        for (const auto& arc : expected.arcs()) {
+            CATCH_CHECK(network.is_forward_arc(arc) == expected.is_forward_arc(arc));
+            CATCH_CHECK(network.get_transpose_arc_id(arc) ==
+                        expected.get_transpose_arc_id(arc));
+            CATCH_CHECK(network.arc_cost(arc) == expected.arc_cost(arc));
+        }
+    }
+
+    CATCH_SECTION("memory_usage")
+    {
+        // The residual graph is not counted by the networks that share it.
+        using Shared = ww::SharedResidualGraph<ww::ResidualGraphMixin<Graph>>;
+        CATCH_CHECK(network.memory_usage() > 0);
+        CATCH_CHECK(network.memory_usage() < expected.memory_usage());
+        CATCH_CHECK(SharedNetwork::estimate_memory(graph) +
+                            Shared::estimate_memory(graph) ==
+                    Network::estimate_memory(graph));
+    }
+
+    CATCH_SECTION("solve")
+    {
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        ww::successive_shortest_paths<Dijkstra>(network);
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("solve_batch", "[network]")
+{
+    constexpr std::size_t num_scenes = 12;
+
+    CATCH_SECTION("CSRGraph")
+    {
+        using Graph = ww::CSRGraph<>;
+        using Mixin = ww::UnitCapacityMixin<Graph, int>;
+        using Network = ww::Network<Graph, int, int, ww::Vector, Mixin>;
+        using SharedMixin = ww::UnitCapacityMixin<
+                Graph, int, ww::Vector,
+                ww::SharedResidualGraphMixin<ww::ResidualGraphMixin<Graph>>>;
+        using SharedNetwork = ww::Network<Graph, int, int, ww::Vector, SharedMixin>;
+        using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+        using Workspace = ww::SolverWorkspace<Dijkstra>;
+
+        const auto graph = make_csr_graph();
+        const auto shared =
+                ww::SharedResidualGraph<ww::ResidualGraphMixin<Graph>>(graph);
+
+        auto networks = std::vector<SharedNetwork>();
+        for (std::size_t scene = 0; scene < num_scenes; ++scene) {
+            networks.emplace_back(shared, make_surplus(graph, scene),
+                                  make_cost(graph, scene));
+        }
+        CATCH_CHECK(shared.use_count() == num_scenes + 1);
+
+        ww::solve_batch<Workspace>(
+                networks,
+                [](auto& network, auto& workspace) {
+                    ww::primal_dual(network, workspace);
+                },
+                4);
+
+        for (std::size_t scene = 0; scene < num_scenes; ++scene) {
+            auto expected =
+                    Network(graph, make_surplus(graph, scene), make_cost(graph, scene));
+            ww::primal_dual<Dijkstra>(expected);
+
+            CATCH_CHECK(networks[scene].is_balanced());
+            CATCH_CHECK(networks[scene].total_cost() == expected.total_cost());
+        }
+    }
+
+    CATCH_SECTION("RectangularGridGraph")
+    {
+        using Grid = ww::RectangularGridGraph<1>;
+        using Network = ww::Network<Grid, int, int>;
+        using SharedNetwork = ww::SharedResidualGraphNetwork<Grid, int, int>;
+        using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+        using Workspace = ww::SolverWorkspace<Dijkstra>;
+
+        const auto grid = Grid(7U, 8U);
+        const auto shared = ww::SharedResidualGraph<ww::ResidualGraphMixin<Grid>>(grid);
+
+        auto networks = std::vector<SharedNetwork>();
+        for (std::size_t scene = 0; scene < num_scenes; ++scene) {
+            networks.emplace_back(shared, make_surplus(grid, scene),
+                                  make_cost(grid, scene));
+        }
+
+        const auto num_threads = GENERATE(1U, 3U, 32U);
+        ww::solve_batch<Workspace>(
+                networks,
+                [](auto& network, auto& workspace) {
+                    ww::successive_shortest_paths(network, workspace);
+                },
+                num_threads);
+
+        for (std::size_t scene = 0; scene < num_scenes; ++scene) {
+            auto expected =
+                    Network(grid, make_surplus(grid, scene), make_cost(grid, scene));
+            ww::successive_shortest_paths<Dijkstra>(expected);
+
+            CATCH_CHECK(networks[scene].is_balanced());
+            CATCH_CHECK(networks[scene].total_cost() == expected.total_cost());
+        }
+    }
+
+    CATCH_SECTION("exception")
+    {
+        using Grid = ww::RectangularGridGraph<1>;
+        using SharedNetwork = ww::SharedResidualGraphNetwork<Grid, int, int>;
+        using Dijkstra = ww::Dijkstra<int, SharedNetwork::residual_graph_type>;
+        using Workspace = ww::SolverWorkspace<Dijkstra>;
+
+        const auto grid = Grid(4U, 5U);
+        const auto shared = ww::SharedResidualGraph<ww::ResidualGraphMixin<Grid>>(grid);
+        auto networks = std::vector<SharedNetwork>();
+        for (std::size_t scene = 0; scene < 3; ++scene) {
+            networks.emplace_back(shared, make_surplus(grid, scene),
+                                  make_cost(grid, scene));
+        }
+
+        const auto solve = [](auto&, auto&) { throw std::runtime_error("failed"); };
+        CATCH_CHECK_THROWS_AS(ww::solve_batch<Workspace>(networks, solve, 2),
+                              std::runtime_error);
+    }
+}
+
+} // namespace
@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/common/mapped_file.hpp>
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
+#include <whirlwind/network/checkpoint.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/solver_control.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace fs = std::filesystem;
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+// Make a network on a grid with many pairs of opposite-signed residues scattered
+// pseudo-randomly, and pseudo-random arc costs. `extra_surplus` units of surplus are
+// moved from the second node to the first.
+auto
+make_network(const Grid& grid, int extra_surplus = 0) -> Network
+{
+    auto surplus = ww::testing::make_scattered_surplus(grid.num_vertices());
+    surplus[0] += extra_surplus;
+    surplus[1] -= extra_surplus;
+    const auto cost = ww::testing::make_pseudorandom_costs(grid.num_edges());
+    return {grid, surplus, cost};
+}
+
+CATCH_TEST_CASE("Network checkpoint", "[network]")
+{
+    const auto grid = Grid(16U, 17U);
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(expected.total_excess() == 0);
+
+    // Interrupt a solve after a few iterations, writing a checkpoint from the progress
+    // callback.
+    const auto path = fs::temp_directory_path() / "whirlwind_test_checkpoint.bin";
+    auto network = make_network(grid);
+    {
+        auto os = std::ofstream(path, std::ios::binary);
+        auto control = ww::SolverControl();
+        auto stop_source = std::stop_source();
+        control.set_stop_token(stop_source.get_token());
+        control.set_progress_callback([&](const ww::SolverStats& stats) {
+            if (stats.num_iterations == 5) {
+                ww::write_checkpoint(os, network);
+                stop_source.request_stop();
+            }
+        });
+        ww::successive_shortest_paths<Dijkstra>(
+                network, ww::SuccessiveShortestPathsSearch::goal_directed, control);
+        CATCH_REQUIRE(control.stopped());
+        CATCH_REQUIRE(network.total_excess() > 0);
+    }
+
+    const auto file = ww::MappedFile(path.string());
+
+    CATCH_SECTION("restore")
+    {
+        const auto checkpoint = ww::map_checkpoint<int, int>(file);
+        CATCH_REQUIRE(std::size(checkpoint.node_excess) == network.num_nodes());
+        CATCH_REQUIRE(std::size(checkpoint.node_potential) == network.num_nodes());
+        CATCH_REQUIRE(std::size(checkpoint.edge_flow) == network.num_forward_arcs());
+
+        auto restored = make_network(grid);
+        ww::restore_checkpoint(restored, checkpoint);
+
+        for (const auto& node : network.nodes()) {
+            CATCH_CHECK(restored.node_excess(node) == network.node_excess(node));
+            CATCH_CHECK(restored.node_potential(node) == network.node_potential(node));
+        }
+        for (const auto& arc : network.arcs()) {
+            CATCH_CHECK(restored.arc_flow(arc) == network.arc_flow(arc));
+        }
+        CATCH_CHECK(restored.total_excess() == network.total_excess());
+        CATCH_CHECK(std::size(restored.excess_nodes()) ==
+                    std::size(network.excess_nodes()));
+        CATCH_CHECK(std::size(restored.deficit_nodes()) ==
+                    std::size(network.deficit_nodes()));
+
+        // Resume the solve from the checkpoint.
+        ww::successive_shortest_paths<Dijkstra>(restored);
+        CATCH_CHECK(restored.is_balanced());
+        CATCH_CHECK(restored.total_excess() == 0);
+        CATCH_CHECK(restored.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("mismatched type")
+    {
+        CATCH_CHECK_THROWS_AS((ww::map_checkpoint<int, double>(file)),
+                              std::runtime_error);
+        CATCH_CHECK_THROWS_AS((ww::map_checkpoint<std::int64_t, int>(file)),
+                              std::runtime_error);
+    }
+
+    CATCH_SECTION("mismatched network")
+    {
+        const auto checkpoint = ww::map_checkpoint<int, int>(file);
+
+        auto other = make_network(grid, 1);
+        CATCH_CHECK_THROWS_AS(ww::restore_checkpoint(other, checkpoint),
+                              std::runtime_error);
+
+        // The network is left unchanged.
+        const auto pristine = make_network(grid, 1);
+        for (const auto& node : other.nodes()) {
+            CATCH_CHECK(other.node_excess(node) == pristine.node_excess(node));
+            CATCH_CHECK(other.node_potential(node) == pristine.node_potential(node));
+        }
+        for (const auto& arc : other.forward_arcs()) {
+            CATCH_CHECK(other.arc_flow(arc) == 0);
+        }
+
+        auto smaller = make_network(Grid(16U, 16U));
+        CATCH_CHECK_THROWS_AS(ww::restore_checkpoint(smaller, checkpoint),
+                              std::runtime_error);
+    }
+}
+
+} // namespace
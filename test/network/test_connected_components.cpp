@@ -0,0 +1,143 @@
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/network/connected_components.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/uncapacitated.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using UncapacitatedNetwork = ww::Network<Grid, int, int>;
+using UnitCapacityNetwork =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+
+// The column of vertices to the left of the masked seam that splits the grid in two.
+constexpr std::uint32_t seam_col = 7;
+
+// Make pseudo-random arc costs on a grid. Edges crossing the seam between columns
+// `seam_col` and `seam_col + 1` are assigned `seam_cost`.
+auto
+make_costs(const Grid& grid, int seam_cost) -> std::vector<int>
+{
+    auto cost = ww::testing::make_pseudorandom_costs(grid.num_edges());
+    for (const auto& tail : grid.vertices()) {
+        for (const auto& [edge, head] : grid.outgoing_edges(tail)) {
+            const auto tail_col = grid.vertex_col(tail);
+            const auto head_col = grid.vertex_col(head);
+            if (((tail_col == seam_col) && (head_col == seam_col + 1)) ||
+                ((tail_col == seam_col + 1) && (head_col == seam_col))) {
+                cost[grid.get_edge_id(edge)] = seam_cost;
+            }
+        }
+    }
+    return cost;
+}
+
+// Make a node surplus with pairs of opposite-signed residues, each pair on the same
+// side of the seam.
+auto
+make_surplus(const Grid& grid) -> std::vector<int>
+{
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    const auto num_rows = std::size_t{grid.num_rows()};
+    for (std::size_t i = 0; i < 10; ++i) {
+        const auto col0 = (i % 2 == 0) ? std::size_t{0} : std::size_t{seam_col + 1};
+        const auto width = (i % 2 == 0) ? std::size_t{seam_col + 1}
+                                        : std::size_t{grid.num_cols()} - seam_col - 1;
+        const auto a_row = static_cast<std::uint32_t>((3 * i) % num_rows);
+        const auto a_col = static_cast<std::uint32_t>(col0 + (5 * i) % width);
+        const auto b_row = static_cast<std::uint32_t>((7 * i + 4) % num_rows);
+        const auto b_col = static_cast<std::uint32_t>(col0 + (3 * i + 1) % width);
+        const auto a = grid.make_vertex(a_row, a_col);
+        const auto b = grid.make_vertex(b_row, b_col);
+        surplus[grid.get_vertex_id(a)] += 1;
+        surplus[grid.get_vertex_id(b)] -= 1;
+    }
+    return surplus;
+}
+
+CATCH_TEMPLATE_TEST_CASE("solve_connected_components",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork)
+{
+    using Network = TestType;
+
+    const auto solve = [](auto& component) {
+        using Component = std::remove_cvref_t<decltype(component)>;
+        using Dijkstra = ww::Dijkstra<int, typename Component::residual_graph_type>;
+        ww::primal_dual<Dijkstra>(component);
+    };
+
+    const auto grid = Grid(12U, 16U);
+    auto surplus = make_surplus(grid);
+
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{2});
+
+    CATCH_SECTION("balanced")
+    {
+        // The same problem with a large but finite seam cost. Since each side of the
+        // seam is balanced, no flow crosses the seam in an optimal solution.
+        using Dijkstra = ww::Dijkstra<int, typename Network::residual_graph_type>;
+        auto reference = Network(grid, surplus, make_costs(grid, 1000));
+        ww::successive_shortest_paths<Dijkstra>(reference);
+
+        auto network = Network(grid, surplus, make_costs(grid, ww::infinity<int>()));
+        const auto summary =
+                ww::solve_connected_components(network, solve, num_threads);
+        CATCH_CHECK(summary.num_components == 2);
+        CATCH_CHECK(summary.num_solved == 2);
+        CATCH_CHECK(summary.num_unbalanced == 0);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == reference.total_cost());
+
+        // Every unsaturated finite-cost arc has nonnegative reduced cost.
+        ww::testing::check_reduced_cost_optimality(
+                network, [&](const auto&, const auto& tail, const auto& head) {
+                    const auto col_sum = grid.vertex_col(tail) + grid.vertex_col(head);
+                    return col_sum != 2 * seam_col + 1;
+                });
+    }
+
+    CATCH_SECTION("unbalanced")
+    {
+        // Add an unpaired residue to the right side of the seam.
+        surplus[grid.get_vertex_id(grid.make_vertex(5U, 12U))] += 1;
+
+        auto network = Network(grid, surplus, make_costs(grid, ww::infinity<int>()));
+        const auto summary =
+                ww::solve_connected_components(network, solve, num_threads);
+        CATCH_CHECK(summary.num_components == 2);
+        CATCH_CHECK(summary.num_solved == 1);
+        CATCH_CHECK(summary.num_unbalanced == 1);
+
+        // The left side was solved and the right side left untouched.
+        for (const auto& node : network.nodes()) {
+            const auto node_id = grid.get_vertex_id(node);
+            if (grid.vertex_col(node) <= seam_col) {
+                CATCH_CHECK(network.node_excess(node) == 0);
+            } else {
+                CATCH_CHECK(network.node_excess(node) == surplus[node_id]);
+            }
+        }
+    }
+}
+
+} // namespace
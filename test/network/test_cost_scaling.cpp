@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/network/cost_scaling.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/uncapacitated.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+#include <whirlwind/network/warm_start.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using UncapacitatedNetwork = ww::Network<Grid, int, int>;
+using UnitCapacityNetwork =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using PackedUnitCapacityNetwork =
+        ww::Network<Grid, int, int, ww::Vector,
+                    ww::PackedUnitCapacityMixin<Grid, int, int>>;
+
+// Make a network on a grid with many pairs of opposite-signed residues scattered
+// pseudo-randomly (some of which coincide), and pseudo-random arc costs. Nonzero seeds
+// perturb a few of the residues and costs.
+template<class Network>
+auto
+make_network(const Grid& grid, std::size_t seed = 0) -> Network
+{
+    return ww::testing::make_scattered_residue_network<Network>(grid, seed, 6);
+}
+
+CATCH_TEMPLATE_TEST_CASE("cost_scaling",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork,
+                         PackedUnitCapacityNetwork)
+{
+    using Network = TestType;
+    using Dijkstra = ww::Dijkstra<int, typename Network::residual_graph_type>;
+
+    const auto grid = Grid(15U, 17U);
+
+    auto expected = make_network<Network>(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(expected.total_excess() == 0);
+
+    auto network = make_network<Network>(grid);
+
+    CATCH_SECTION("scale_factor = 8")
+    {
+        ww::cost_scaling(network);
+    }
+
+    CATCH_SECTION("scale_factor = 2")
+    {
+        ww::cost_scaling(network, 2);
+    }
+
+    CATCH_CHECK(network.total_excess() == 0);
+    CATCH_CHECK(network.total_deficit() == 0);
+    CATCH_CHECK(network.is_balanced());
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+    // The node potentials satisfy the reduced cost optimality conditions.
+    ww::testing::check_reduced_cost_optimality(network);
+}
+
+CATCH_TEMPLATE_TEST_CASE("cost_scaling (warm start)",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork)
+{
+    using Network = TestType;
+    using Dijkstra = ww::Dijkstra<int, typename Network::residual_graph_type>;
+
+    const auto grid = Grid(12U, 13U);
+
+    auto expected = make_network<Network>(grid, 3);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    const auto check_solution = [&](const Network& network) {
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        // The node potentials satisfy the reduced cost optimality conditions.
+        ww::testing::check_reduced_cost_optimality(network);
+    };
+
+    CATCH_SECTION("partial solve")
+    {
+        // Route some of the flow first, so that the initial flow and node potentials
+        // are nonzero.
+        auto network = make_network<Network>(grid, 3);
+        auto dijkstra = Dijkstra(network);
+        for (int i = 0; i < 3; ++i) {
+            const auto source = *std::begin(network.excess_nodes());
+            const auto sink = ww::dijkstra_ssp(dijkstra, network, source);
+            CATCH_REQUIRE(sink);
+            ww::augment_flow_ssp(network, dijkstra, *sink);
+            ww::update_potential_ssp(network, dijkstra, *sink);
+        }
+
+        ww::cost_scaling(network);
+        check_solution(network);
+    }
+
+    CATCH_SECTION("prior solution")
+    {
+        // Start from the solution of a slightly different problem, which must be
+        // partially rerouted.
+        auto prior = make_network<Network>(grid);
+        ww::successive_shortest_paths<Dijkstra>(prior);
+        auto network = make_network<Network>(grid, 3);
+        ww::warm_start(network, prior);
+
+        ww::cost_scaling(network);
+        check_solution(network);
+    }
+}
+
+CATCH_TEST_CASE("cost_scaling (warm start, uncapacitated)", "[network]")
+{
+    using Network = UncapacitatedNetwork;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    // A few large residues in addition to the scattered unit residues, so that the
+    // optimal flow on some arcs is greater than one.
+    const auto grid = Grid(12U, 13U);
+    const auto make_large_network = [&]() {
+        auto network = make_network<Network>(grid);
+        const auto num_nodes = static_cast<std::uint32_t>(grid.num_vertices());
+        network.increase_node_excess(0U, 5);
+        network.decrease_node_excess(num_nodes - 1, 5);
+        network.increase_node_excess(num_nodes - 13, 4);
+        network.decrease_node_excess(12U, 4);
+        return network;
+    };
+
+    auto expected = make_large_network();
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    // Route all but one unit of the excess first, so that the flow on some arcs
+    // exceeds the remaining excess.
+    auto network = make_large_network();
+    auto dijkstra = Dijkstra(network);
+    while (network.total_excess() > 1) {
+        const auto source = *std::begin(network.excess_nodes());
+        const auto sink = ww::dijkstra_ssp(dijkstra, network, source);
+        CATCH_REQUIRE(sink);
+        ww::augment_flow_ssp(network, dijkstra, *sink);
+        ww::update_potential_ssp(network, dijkstra, *sink);
+    }
+
+    auto max_flow = 0;
+    for (const auto& arc : network.forward_arcs()) {
+        max_flow = std::max(max_flow, network.arc_flow(arc));
+    }
+    CATCH_REQUIRE(max_flow > network.total_excess());
+
+    ww::cost_scaling(network);
+
+    CATCH_CHECK(network.total_excess() == 0);
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+    ww::testing::check_reduced_cost_optimality(network);
+}
+
+} // namespace
@@ -0,0 +1,151 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/network/delta_stepping.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+using DeltaStepping = ww::DeltaStepping<int, Network::residual_graph_type>;
+
+// Make a network on a grid with many pairs of opposite-signed residues scattered
+// pseudo-randomly, and pseudo-random arc costs.
+auto
+make_network(const Grid& grid) -> Network
+{
+    return ww::testing::make_scattered_residue_network<Network>(grid);
+}
+
+// Check that the solver's shortest path forest matches the distances found by
+// `PrimalDualDijkstra`, and that each tree path is a shortest path from its source.
+void
+check_forest(const Network& network,
+             const ww::PrimalDualDijkstra<Dijkstra>& expected,
+             const DeltaStepping& solver)
+{
+    CATCH_CHECK(std::size(solver.visited_vertices()) ==
+                std::size(expected.visited_vertices()));
+
+    auto position = std::vector<std::size_t>(network.num_nodes(), 0);
+    std::size_t i = 0;
+    for (const auto& node : solver.visited_vertices()) {
+        position[network.get_node_id(node)] = i++;
+    }
+
+    for (const auto& node : network.nodes()) {
+        CATCH_CHECK(solver.has_visited_vertex(node) ==
+                    expected.has_visited_vertex(node));
+        if (!solver.has_visited_vertex(node)) {
+            continue;
+        }
+
+        const auto distance = solver.distance_to_vertex(node);
+        CATCH_CHECK(distance == expected.distance_to_vertex(node));
+
+        if (solver.is_root_vertex(node)) {
+            CATCH_CHECK(network.is_excess_node(node));
+            CATCH_CHECK(solver.source_vertex(node) == node);
+            CATCH_CHECK(distance == 0);
+            continue;
+        }
+
+        // Each vertex is visited after its predecessor, along a tight arc.
+        const auto pred = solver.predecessor_vertex(node);
+        const auto& arc = solver.predecessor_edge(node);
+        CATCH_CHECK(position[network.get_node_id(pred)] <
+                    position[network.get_node_id(node)]);
+        CATCH_CHECK(!network.is_arc_saturated(arc));
+        CATCH_CHECK(distance == solver.distance_to_vertex(pred) +
+                                        network.arc_reduced_cost(arc, pred, node));
+        CATCH_CHECK(solver.source_vertex(node) == solver.source_vertex(pred));
+    }
+}
+
+CATCH_TEST_CASE("DeltaStepping", "[network]")
+{
+    const auto grid = Grid(60U, 70U);
+    auto network = make_network(grid);
+
+    // Route some of the flow first, so that the residual graph contains reverse arcs
+    // and the potentials are nonzero.
+    auto expected = ww::PrimalDualDijkstra<Dijkstra>(network);
+    ww::dijkstra_pd(expected, network);
+    ww::augment_flow_pd(network, expected);
+    ww::update_potential_pd(network, expected);
+    CATCH_REQUIRE(network.total_excess() > 0);
+
+    expected.reset();
+    ww::dijkstra_pd(expected, network);
+
+    CATCH_SECTION("default")
+    {
+        auto solver = DeltaStepping(network);
+        CATCH_CHECK(solver.delta() >= 1);
+        ww::dijkstra_pd(solver, network);
+        check_forest(network, expected, solver);
+
+        // The solver may be reused after a reset.
+        solver.reset();
+        ww::dijkstra_pd(solver, network);
+        check_forest(network, expected, solver);
+    }
+
+    CATCH_SECTION("delta = 1, single thread")
+    {
+        auto solver = DeltaStepping(network.residual_graph(), 1, 1);
+        ww::dijkstra_pd(solver, network);
+        check_forest(network, expected, solver);
+    }
+
+    CATCH_SECTION("large delta, multiple threads")
+    {
+        auto solver = DeltaStepping(network.residual_graph(), 1000, 4);
+        ww::dijkstra_pd(solver, network);
+        check_forest(network, expected, solver);
+    }
+
+    CATCH_SECTION("forest is independent of the number of threads")
+    {
+        auto solver1 = DeltaStepping(network.residual_graph(), 3, 1);
+        auto solver4 = DeltaStepping(network.residual_graph(), 3, 4);
+        ww::dijkstra_pd(solver1, network);
+        ww::dijkstra_pd(solver4, network);
+        for (const auto& node : network.nodes()) {
+            CATCH_CHECK(solver1.predecessor_vertex(node) ==
+                        solver4.predecessor_vertex(node));
+        }
+    }
+}
+
+CATCH_TEST_CASE("primal_dual (DeltaStepping)", "[network]")
+{
+    const auto grid = Grid(40U, 45U);
+
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    auto network = make_network(grid);
+    ww::primal_dual<Dijkstra, ww::NullLogger, DeltaStepping>(
+            network, 0, ww::PrimalDualPhase::single_path, 0.0);
+
+    CATCH_CHECK(network.total_excess() == 0);
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+}
+
+} // namespace
@@ -0,0 +1,244 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/const_span.hpp>
+#include <whirlwind/container/indexed_dary_heap.hpp>
+#include <whirlwind/container/memory_usage.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/masked_grid_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+template<class Graph>
+auto
+make_surplus(const Graph& graph) -> std::vector<int>
+{
+    auto surplus = std::vector<int>(graph.num_vertices(), 0);
+    surplus.front() = 1;
+    surplus.back() = -1;
+    return surplus;
+}
+
+template<class Graph>
+auto
+make_cost(const Graph& graph) -> std::vector<int>
+{
+    auto cost = std::vector<int>(graph.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>(edge % 3);
+    }
+    return cost;
+}
+
+// Run a full multi-source search from the excess nodes of a network and check that the
+// memory used by the solver is positive and no greater than its estimate.
+template<class Dijkstra, class Network>
+void
+check_solver_memory(Dijkstra& dijkstra, const Network& network, std::size_t estimate)
+{
+    ww::dijkstra_pd(dijkstra, network);
+    CATCH_CHECK(dijkstra.memory_usage() > 0);
+    CATCH_CHECK(dijkstra.memory_usage() <= estimate);
+}
+
+CATCH_TEST_CASE("get_memory_usage", "[container]")
+{
+    CATCH_SECTION("vector")
+    {
+        auto v = std::vector<std::int32_t>();
+        CATCH_CHECK(ww::get_memory_usage(v) == 0);
+
+        v.reserve(10);
+        CATCH_CHECK(ww::get_memory_usage(v) == v.capacity() * sizeof(std::int32_t));
+        CATCH_CHECK(ww::estimate_array_memory<std::int32_t>(10) == 40);
+    }
+
+    CATCH_SECTION("vector<bool>")
+    {
+        const auto v = std::vector<bool>(100, false);
+        CATCH_CHECK(ww::get_memory_usage(v) >= 13);
+        CATCH_CHECK(ww::get_memory_usage(v) < 100);
+        CATCH_CHECK(ww::estimate_array_memory<bool>(100) >= 13);
+        CATCH_CHECK(ww::estimate_array_memory<bool>(100) < 100);
+    }
+
+    CATCH_SECTION("nested")
+    {
+        auto v = std::vector<std::vector<double>>(3);
+        v[1].reserve(5);
+        const auto expected = v.capacity() * sizeof(std::vector<double>) +
+                              v[1].capacity() * sizeof(double);
+        CATCH_CHECK(ww::get_memory_usage(v) == expected);
+    }
+
+    CATCH_SECTION("non-owning")
+    {
+        const auto data = std::vector<int>(10);
+        const auto span = ww::ConstSpan<int>(std::span(data));
+        CATCH_CHECK(ww::get_memory_usage(span) == 0);
+        CATCH_CHECK(ww::get_memory_usage(ww::RectangularGridGraph<1>(4U, 5U)) == 0);
+    }
+}
+
+CATCH_TEST_CASE("memory_usage (CSRGraph)", "[graph]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+
+    CATCH_SECTION("empty")
+    {
+        const auto graph = Graph();
+        CATCH_CHECK(graph.memory_usage() >= Graph::estimate_memory(0, 0));
+    }
+
+    CATCH_SECTION("nonempty")
+    {
+        auto edgelist = ww::EdgeList();
+        edgelist.add_edge(0U, 1U);
+        edgelist.add_edge(0U, 2U);
+        edgelist.add_edge(1U, 2U);
+        edgelist.add_edge(2U, 3U);
+        const auto graph = Graph(edgelist);
+
+        CATCH_CHECK(Graph::estimate_memory(4, 4) == 5 * 4 + 4 * 4);
+        CATCH_CHECK(graph.memory_usage() >= Graph::estimate_memory(4, 4));
+    }
+}
+
+CATCH_TEST_CASE("memory_usage (MaskedGridGraph)", "[graph]")
+{
+    using Graph = ww::MaskedGridGraph<1>;
+
+    auto mask = std::vector<bool>(9 * 10, true);
+    mask[17] = false;
+    const auto graph = Graph(9, 10, mask);
+
+    CATCH_CHECK(graph.memory_usage() > 0);
+    CATCH_CHECK(graph.memory_usage() >= Graph::estimate_memory(9, 10));
+    CATCH_CHECK(Graph::estimate_memory(0, 0) == ww::RankBitmap<>::estimate_memory(0));
+}
+
+CATCH_TEST_CASE("memory_usage (Network)", "[network]")
+{
+    CATCH_SECTION("RectangularGridGraph")
+    {
+        using Graph = ww::RectangularGridGraph<1>;
+        using Network = ww::Network<Graph, int, int>;
+
+        const auto graph = Graph(8U, 9U);
+        const auto network = Network(graph, make_surplus(graph), make_cost(graph));
+
+        // The grid graph and its residual graph own no memory.
+        const auto num_nodes = graph.num_vertices();
+        const auto num_edges = graph.num_edges();
+        const auto expected = num_nodes * (2 * sizeof(int)) +
+                              num_edges * sizeof(int) + 2 * num_edges * sizeof(int) +
+                              2 * Network::node_set_type::estimate_memory(num_nodes,
+                                                                          num_nodes);
+        CATCH_CHECK(Network::estimate_memory(graph) == expected);
+
+        CATCH_CHECK(network.memory_usage() > 0);
+        CATCH_CHECK(network.memory_usage() <= Network::estimate_memory(graph));
+    }
+
+    CATCH_SECTION("CSRGraph")
+    {
+        using Graph = ww::CSRGraph<>;
+        using Mixin = ww::UnitCapacityMixin<Graph, int>;
+        using Network = ww::Network<Graph, int, int, ww::Vector, Mixin>;
+
+        auto edgelist = ww::EdgeList();
+        for (auto i = 0U; i < 20U; ++i) {
+            edgelist.add_edge(i, i + 1U);
+            edgelist.add_edge(i + 1U, i);
+            edgelist.add_edge(i, (i + 7U) % 21U);
+        }
+        const auto graph = Graph(edgelist);
+        const auto network = Network(graph, make_surplus(graph), make_cost(graph));
+
+        // The residual graph and its arc index arrays dominate.
+        const auto residual_graph_memory = Graph::estimate_memory(
+                graph.num_vertices(), 2 * graph.num_edges());
+        CATCH_CHECK(Network::estimate_memory(graph) > residual_graph_memory);
+
+        CATCH_CHECK(network.memory_usage() >= residual_graph_memory);
+        CATCH_CHECK(network.memory_usage() <= Network::estimate_memory(graph));
+    }
+
+    CATCH_SECTION("MaskedGridGraph")
+    {
+        using Graph = ww::MaskedGridGraph<1>;
+        using Network = ww::Network<Graph, int, int>;
+
+        auto mask = std::vector<bool>(8 * 9, true);
+        mask[40] = false;
+        const auto graph = Graph(8, 9, mask);
+        const auto network = Network(graph, make_surplus(graph), make_cost(graph));
+
+        CATCH_CHECK(network.memory_usage() > 0);
+        CATCH_CHECK(network.memory_usage() <= Network::estimate_memory(graph));
+    }
+}
+
+CATCH_TEST_CASE("memory_usage (Dijkstra)", "[network]")
+{
+    using Graph = ww::RectangularGridGraph<1>;
+    using Network = ww::Network<Graph, int, int>;
+    using ResidualGraph = Network::residual_graph_type;
+
+    const auto graph = Graph(8U, 9U);
+    const auto network = Network(graph, make_surplus(graph), make_cost(graph));
+    const auto num_nodes = network.num_nodes();
+    const auto num_arcs = network.num_arcs();
+
+    CATCH_SECTION("Dijkstra")
+    {
+        using Dijkstra = ww::PrimalDualDijkstra<ww::Dijkstra<int, ResidualGraph>>;
+        auto dijkstra = Dijkstra(network);
+        const auto estimate = Dijkstra::estimate_memory(num_nodes, num_arcs);
+        check_solver_memory(dijkstra, network, estimate);
+
+        // The source vertex of each vertex is stored in addition to the base solver.
+        using Base = ww::Dijkstra<int, ResidualGraph>;
+        CATCH_CHECK(estimate == Base::estimate_memory(num_nodes, num_arcs) +
+                                        num_nodes * sizeof(ResidualGraph::vertex_type));
+    }
+
+    CATCH_SECTION("Dijkstra (indexed heap)")
+    {
+        using Vertex = ResidualGraph::vertex_type;
+        using Heap = ww::IndexedDaryHeap<Vertex, int>;
+        using Dijkstra = ww::PrimalDualDijkstra<
+                ww::Dijkstra<int, ResidualGraph, ww::Vector, Heap>>;
+        auto dijkstra = Dijkstra(network);
+        const auto estimate = Dijkstra::estimate_memory(num_nodes, num_arcs);
+        check_solver_memory(dijkstra, network, estimate);
+
+        // The heap is allocated up front.
+        CATCH_CHECK(dijkstra.heap().memory_usage() == Heap::estimate_memory(num_nodes));
+    }
+
+    CATCH_SECTION("Dial")
+    {
+        using Dial = ww::PrimalDualDijkstra<ww::Dial<int, ResidualGraph>>;
+        auto dial = Dial(network);
+        const auto num_buckets = dial.num_buckets();
+        CATCH_CHECK(num_buckets == 4);
+        const auto estimate = Dial::estimate_memory(num_nodes, num_arcs, num_buckets);
+        check_solver_memory(dial, network, estimate);
+    }
+}
+
+} // namespace
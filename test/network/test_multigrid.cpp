@@ -0,0 +1,101 @@
+#include <cstddef>
+#include <type_traits>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/multigrid.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/uncapacitated.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::RectangularGridGraph<1, std::size_t>;
+using UncapacitatedNetwork = ww::Network<Grid, int, int>;
+using UnitCapacityNetwork =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+
+// Make a network on a grid with pairs of opposite-signed residues scattered
+// pseudo-randomly, pseudo-random arc costs, and a wall of high-cost edges with a
+// single gap.
+template<class Network>
+auto
+make_network(const Grid& grid) -> Network
+{
+    const auto surplus = ww::testing::make_scattered_surplus(grid.num_vertices(), 16);
+    auto cost = ww::testing::make_pseudorandom_costs(grid.num_edges());
+    for (std::size_t i = 0; i + 3 < grid.num_rows(); ++i) {
+        cost[grid.get_edge_id(grid.get_right_edge({i, 20}))] = 100;
+        cost[grid.get_edge_id(grid.get_left_edge({i, 21}))] = 100;
+    }
+
+    return {grid, surplus, cost};
+}
+
+CATCH_TEMPLATE_TEST_CASE("multigrid_warm_start",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork)
+{
+    using Network = TestType;
+    using Dijkstra = ww::Dijkstra<int, typename Network::residual_graph_type>;
+
+    const auto grid = Grid(45U, 52U);
+
+    auto expected = make_network<Network>(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(expected.total_excess() == 0);
+
+    const auto solve = [](auto& coarse) {
+        using Coarse = std::remove_cvref_t<decltype(coarse)>;
+        using CoarseDijkstra = ww::Dijkstra<int, typename Coarse::residual_graph_type>;
+        ww::primal_dual<CoarseDijkstra>(coarse);
+    };
+
+    auto options = ww::MultigridOptions();
+    options.factor = GENERATE(std::size_t{2}, std::size_t{4});
+    options.num_levels = GENERATE(std::size_t{1}, std::size_t{2});
+    options.min_size = 4;
+
+    auto network = make_network<Network>(grid);
+    ww::multigrid_warm_start(network, solve, options);
+    CATCH_CHECK(network.is_balanced());
+    ww::testing::check_reduced_cost_optimality(network);
+
+    ww::primal_dual<Dijkstra>(network);
+    CATCH_CHECK(network.total_excess() == 0);
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+    ww::testing::check_reduced_cost_optimality(network);
+}
+
+CATCH_TEST_CASE("multigrid_warm_start (small grid)", "[network]")
+{
+    using Network = UncapacitatedNetwork;
+
+    // The grid is too small to coarsen, so the network is left unchanged.
+    const auto grid = Grid(45U, 52U);
+    auto network = make_network<Network>(grid);
+    const auto total_excess = network.total_excess();
+
+    auto num_solves = 0;
+    const auto solve = [&](auto&) { ++num_solves; };
+
+    auto options = ww::MultigridOptions();
+    options.factor = 8;
+    options.min_size = 8;
+    ww::multigrid_warm_start(network, solve, options);
+    CATCH_CHECK(num_solves == 0);
+    CATCH_CHECK(network.total_excess() == total_excess);
+}
+
+} // namespace
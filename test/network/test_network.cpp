@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/uncapacitated.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::RectangularGridGraph<1, std::size_t>;
+using UncapacitatedNetwork = ww::Network<Grid, int, int>;
+using UnitCapacityNetwork =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using PackedUnitCapacityNetwork =
+        ww::Network<Grid,
+                    int,
+                    int,
+                    ww::Vector,
+                    ww::PackedUnitCapacityMixin<Grid, int, int>>;
+
+CATCH_TEMPLATE_TEST_CASE("Network (planar grid costs)",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork,
+                         PackedUnitCapacityNetwork)
+{
+    using Network = TestType;
+
+    const std::size_t m = 6;
+    const std::size_t n = 9;
+    const auto grid = Grid(m, n);
+    const auto surplus = std::vector<int>(grid.num_vertices(), 0);
+
+    // Distinct costs for every edge, in edge order.
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = static_cast<int>((13 * edge + 5) % 101);
+    }
+
+    // The same costs as planar rasters. The vertical rasters are column-major to
+    // check that any layout is accepted.
+    auto up_buffer = std::vector<int>((m - 1) * n);
+    auto down_buffer = std::vector<int>((m - 1) * n);
+    const auto up = ww::Span2D<int, ww::LayoutLeft>(up_buffer.data(), m - 1, n);
+    const auto down = ww::Span2D<int, ww::LayoutLeft>(down_buffer.data(), m - 1, n);
+    auto left = ww::Array2D<int>(m, n - 1);
+    auto right = ww::Array2D<int>(m, n - 1);
+    for (std::size_t i = 0; i + 1 < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            up(i, j) = cost[grid.get_edge_id(grid.get_up_edge({i + 1, j}))];
+            down(i, j) = cost[grid.get_edge_id(grid.get_down_edge({i, j}))];
+        }
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j + 1 < n; ++j) {
+            left(i, j) = cost[grid.get_edge_id(grid.get_left_edge({i, j + 1}))];
+            right(i, j) = cost[grid.get_edge_id(grid.get_right_edge({i, j}))];
+        }
+    }
+
+    const auto expected = Network(grid, surplus, cost);
+    const auto network = Network(grid, surplus, up, down, left, right);
+    CATCH_REQUIRE(network.num_arcs() == expected.num_arcs());
+    for (const auto& arc : expected.arcs()) {
+        CATCH_CHECK(network.arc_cost(arc) == expected.arc_cost(arc));
+    }
+}
+
+CATCH_TEMPLATE_TEST_CASE("Network (parallel construction)",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork,
+                         PackedUnitCapacityNetwork)
+{
+    using Network = TestType;
+
+    const auto grid = Grid(11U, 13U);
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus.front() = 1;
+    surplus.back() = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = static_cast<int>((13 * edge + 5) % 101);
+    }
+
+    // The network does not depend on the number of threads used to construct it.
+    auto expected = Network(grid, surplus, cost);
+    auto network = Network(grid, surplus, cost, 4U);
+    CATCH_REQUIRE(network.num_arcs() == expected.num_arcs());
+    for (const auto& arc : expected.arcs()) {
+        CATCH_CHECK(network.arc_cost(arc) == expected.arc_cost(arc));
+        CATCH_CHECK(network.is_arc_saturated(arc) == expected.is_arc_saturated(arc));
+    }
+    CATCH_CHECK(ww::get_max_admissible_arc_length(network, 4U) ==
+                ww::get_max_admissible_arc_length(expected));
+
+    // Route one unit of flow through some forward arcs.
+    auto num_flows = std::size_t{0};
+    for (const auto& arc : expected.forward_arcs()) {
+        if (num_flows++ % 3 == 0) {
+            expected.increase_arc_flow(arc, 1);
+            network.increase_arc_flow(arc, 1);
+        }
+    }
+    CATCH_CHECK(expected.total_cost() != 0);
+    CATCH_CHECK(network.total_cost(4U) == expected.total_cost());
+}
+
+} // namespace
@@ -0,0 +1,136 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/packed_unit_capacity.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("PackedUnitCapacityMixin (CSRGraph)", "[network]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+    using PackedNetwork = ww::Network<Graph, int, int, ww::Vector,
+                                      ww::PackedUnitCapacityMixin<Graph, int, int>>;
+
+    // Includes a pair of antiparallel edges (0->1 and 1->0) and a parallel edge.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 0U);
+    edgelist.add_edge(1U, 0U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(0U, 2U);
+
+    const auto graph = Graph(edgelist);
+    const auto surplus = std::vector<int>{1, 0, -1};
+    const auto cost = std::vector<int>{1, 5, 2, 3, 4, 6};
+
+    auto network = Network(graph, surplus, cost);
+    auto packed_network = PackedNetwork(graph, surplus, cost);
+
+    CATCH_SECTION("arcs")
+    {
+        CATCH_REQUIRE(packed_network.num_arcs() == network.num_arcs());
+        for (const auto& arc : network.arcs()) {
+            CATCH_CHECK(packed_network.get_transpose_arc_id(arc) ==
+                        network.get_transpose_arc_id(arc));
+            CATCH_CHECK(packed_network.is_arc_saturated(arc) ==
+                        network.is_arc_saturated(arc));
+            CATCH_CHECK(packed_network.arc_flow(arc) == network.arc_flow(arc));
+            CATCH_CHECK(packed_network.arc_cost(arc) == network.arc_cost(arc));
+        }
+    }
+
+    CATCH_SECTION("increase_arc_flow")
+    {
+        const auto arc = packed_network.get_residual_graph_arc_id(0);
+        const auto transpose_arc = packed_network.get_transpose_arc_id(arc);
+        CATCH_CHECK(!packed_network.is_arc_saturated(arc));
+        CATCH_CHECK(packed_network.is_arc_saturated(transpose_arc));
+
+        packed_network.increase_arc_flow(arc, 1);
+        CATCH_CHECK(packed_network.is_arc_saturated(arc));
+        CATCH_CHECK(!packed_network.is_arc_saturated(transpose_arc));
+        CATCH_CHECK(packed_network.get_transpose_arc_id(arc) == transpose_arc);
+        CATCH_CHECK(packed_network.get_transpose_arc_id(transpose_arc) == arc);
+
+        packed_network.increase_arc_flow(transpose_arc, 1);
+        CATCH_CHECK(!packed_network.is_arc_saturated(arc));
+        CATCH_CHECK(packed_network.is_arc_saturated(transpose_arc));
+    }
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        using Dijkstra = ww::Dijkstra<int, Graph>;
+        ww::successive_shortest_paths<Dijkstra>(network);
+        ww::successive_shortest_paths<Dijkstra>(packed_network);
+
+        CATCH_CHECK(packed_network.total_excess() == 0);
+        CATCH_CHECK(packed_network.total_cost() == network.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("PackedUnitCapacityMixin (CompactGridGraph)", "[network]")
+{
+    using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+    using Network = ww::Network<Grid, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Grid, int>>;
+    using PackedNetwork = ww::Network<Grid, int, int, ww::Vector,
+                                      ww::PackedUnitCapacityMixin<Grid, int, int>>;
+
+    const auto grid = Grid(6U, 7U);
+
+    // Two pairs of opposite-signed residues.
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[0] = 1;
+    surplus[8] = 1;
+    surplus[20] = -1;
+    surplus.back() = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((7 * edge) % 5);
+    }
+
+    auto network = Network(grid, surplus, cost);
+    auto packed_network = PackedNetwork(grid, surplus, cost);
+
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        ww::successive_shortest_paths<Dijkstra>(network);
+        ww::successive_shortest_paths<Dijkstra>(packed_network);
+
+        CATCH_CHECK(packed_network.total_excess() == 0);
+        CATCH_CHECK(packed_network.total_cost() == network.total_cost());
+        for (const auto& arc : network.arcs()) {
+            CATCH_CHECK(packed_network.arc_flow(arc) == network.arc_flow(arc));
+        }
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        ww::primal_dual<Dijkstra>(network);
+        ww::primal_dual<Dijkstra>(packed_network);
+
+        CATCH_CHECK(packed_network.total_excess() == 0);
+        CATCH_CHECK(packed_network.total_cost() == network.total_cost());
+    }
+}
+
+} // namespace
@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/solver_workspace.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+CATCH_TEST_CASE("primal_dual (adaptive switch)", "[network]")
+{
+    const auto grid = Grid(8U, 9U);
+
+    // Positive residues clustered near one corner of the grid and negative residues
+    // near the opposite corner. The shortest path trees compete for the same sinks, so
+    // the excess isn't eliminated by a single primal-dual iteration.
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[10] = 1;
+    surplus[11] = 1;
+    surplus[19] = 1;
+    surplus[20] = 1;
+    surplus[grid.num_vertices() - 11] = -1;
+    surplus[grid.num_vertices() - 12] = -1;
+    surplus[grid.num_vertices() - 20] = -1;
+    surplus[grid.num_vertices() - 21] = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((5 * edge) % 3);
+    }
+
+    auto expected = Network(grid, surplus, cost);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    CATCH_SECTION("disabled")
+    {
+        auto network = Network(grid, surplus, cost);
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 0, ww::PrimalDualPhase::single_path, 0.0);
+
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::converged);
+        CATCH_CHECK(summary.num_iterations > 1);
+        CATCH_CHECK(summary.remaining_excess == 0);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("max iterations")
+    {
+        auto network = Network(grid, surplus, cost);
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 1, ww::PrimalDualPhase::single_path, 0.0);
+
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::max_iterations);
+        CATCH_CHECK(summary.num_iterations == 1);
+        CATCH_CHECK(summary.remaining_excess > 0);
+        CATCH_CHECK(summary.predicted_yield > 0.0);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("low yield")
+    {
+        // No iteration can eliminate more excess than there are nodes in the network,
+        // so a min yield of 1 always switches after the first iteration.
+        auto network = Network(grid, surplus, cost);
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 0, ww::PrimalDualPhase::single_path, 1.0);
+
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::low_yield);
+        CATCH_CHECK(summary.num_iterations == 1);
+        CATCH_CHECK(summary.remaining_excess > 0);
+        CATCH_CHECK(summary.predicted_yield < 1.0);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("SolverWorkspace")
+    {
+        auto workspace = ww::SolverWorkspace<Dijkstra>();
+        auto network = Network(grid, surplus, cost);
+        const auto summary = ww::primal_dual(
+                network, workspace, 0, ww::PrimalDualPhase::single_path, 1.0);
+
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::low_yield);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+} // namespace
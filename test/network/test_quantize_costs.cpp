@@ -0,0 +1,134 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/quantize_costs.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("quantize_costs", "[network]")
+{
+    auto cost = std::vector<double>();
+    for (std::size_t i = 0; i < 100; ++i) {
+        cost.push_back(std::sqrt(static_cast<double>(i)));
+    }
+
+    CATCH_SECTION("automatic scale")
+    {
+        auto options = ww::CostQuantizationOptions();
+        options.headroom = 8.0;
+        const auto quantized = ww::quantize_costs<std::int16_t>(cost, options);
+        const auto& quantization = quantized.quantization;
+
+        // The largest cost maps to the largest integer allowed by the headroom.
+        constexpr auto max_cost = std::numeric_limits<std::int16_t>::max() / 8;
+        CATCH_REQUIRE(std::size(quantized.cost) == std::size(cost));
+        CATCH_CHECK(quantized.cost.back() == max_cost);
+        CATCH_CHECK(quantization.error_bound == 0.5 / quantization.scale);
+
+        auto max_error = 0.0;
+        for (std::size_t i = 0; i < std::size(cost); ++i) {
+            CATCH_CHECK(quantized.cost[i] >= 0);
+            CATCH_CHECK(quantized.cost[i] <= max_cost);
+            const auto error = std::abs(quantization.dequantize(quantized.cost[i]) -
+                                        cost[i]);
+            CATCH_CHECK(error <= quantization.error_bound);
+            max_error = std::max(max_error, error);
+        }
+        CATCH_CHECK(quantization.max_error == max_error);
+    }
+
+    CATCH_SECTION("explicit scale")
+    {
+        auto options = ww::CostQuantizationOptions();
+        options.scale = 100.0;
+        const auto quantized = ww::quantize_costs(cost, options);
+        CATCH_CHECK(quantized.quantization.scale == 100.0);
+        CATCH_CHECK(quantized.quantization.error_bound == 0.005);
+        CATCH_CHECK(quantized.cost[4] == 200);
+        CATCH_CHECK(quantized.cost[99] == 995);
+    }
+
+    CATCH_SECTION("overflow")
+    {
+        auto options = ww::CostQuantizationOptions();
+        options.scale = 10000.0;
+        CATCH_CHECK_THROWS_AS(ww::quantize_costs<std::int16_t>(cost, options),
+                              std::runtime_error);
+    }
+
+    CATCH_SECTION("infinite cost")
+    {
+        cost[3] = std::numeric_limits<double>::infinity();
+        auto options = ww::CostQuantizationOptions();
+        options.headroom = 8.0;
+        const auto quantized = ww::quantize_costs<std::int16_t>(cost, options);
+        const auto& quantization = quantized.quantization;
+
+        // The infinite cost maps to infinity and doesn't affect the scale or the
+        // quantization error of the finite costs.
+        constexpr auto max_cost = std::numeric_limits<std::int16_t>::max() / 8;
+        CATCH_REQUIRE(std::size(quantized.cost) == std::size(cost));
+        CATCH_CHECK(quantized.cost[3] == ww::infinity<std::int16_t>());
+        CATCH_CHECK(quantized.cost.back() == max_cost);
+        CATCH_CHECK(std::isfinite(quantization.max_error));
+        CATCH_CHECK(quantization.max_error <= quantization.error_bound);
+    }
+
+    CATCH_SECTION("NaN or negative infinite cost")
+    {
+        cost[3] = GENERATE(std::numeric_limits<double>::quiet_NaN(),
+                           -std::numeric_limits<double>::infinity());
+        CATCH_CHECK_THROWS_AS(ww::quantize_costs(cost), std::runtime_error);
+    }
+}
+
+CATCH_TEST_CASE("make_quantized_network", "[network]")
+{
+    using Grid = ww::RectangularGridGraph<1, std::size_t>;
+    using Network = ww::Network<Grid, int, int>;
+    using Dial = ww::Dial<int, Network::residual_graph_type>;
+
+    const auto grid = Grid(20U, 25U);
+    const auto surplus = ww::testing::make_scattered_surplus(grid.num_vertices());
+
+    // Costs that are multiples of 1/4 are quantized exactly with a scale of 4.
+    const auto int_cost = ww::testing::make_pseudorandom_costs(grid.num_edges());
+    auto cost = std::vector<double>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 0.25 * int_cost[edge];
+    }
+
+    auto expected = Network(grid, surplus, int_cost);
+    ww::successive_shortest_paths<Dial>(expected);
+    CATCH_REQUIRE(expected.is_balanced());
+
+    auto options = ww::CostQuantizationOptions();
+    options.scale = 4.0;
+    auto [network, quantization] =
+            ww::make_quantized_network<Network>(grid, surplus, cost, options);
+    CATCH_CHECK(quantization.max_error == 0.0);
+
+    ww::successive_shortest_paths<Dial>(network);
+    CATCH_CHECK(network.is_balanced());
+    CATCH_CHECK(network.total_cost() == expected.total_cost());
+    CATCH_CHECK(quantization.dequantize(network.total_cost()) ==
+                0.25 * expected.total_cost());
+}
+
+} // namespace
@@ -0,0 +1,301 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/container/radix_heap.hpp>
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/residual_graph.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEMPLATE_TEST_CASE("ResidualGraphMixin (CSRGraph)",
+                         "[network]",
+                         std::size_t,
+                         std::uint32_t)
+{
+    using Graph = ww::CSRGraph<ww::Vector, TestType>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+
+    // Includes a pair of antiparallel edges (0->1 and 1->0).
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 0U);
+    edgelist.add_edge(1U, 0U);
+
+    // Edges are ordered by (tail,head) in the CSR graph: 0->1, 1->0, 1->2, 2->0.
+    const auto graph = Graph(edgelist);
+    const auto surplus = std::vector<int>{1, 0, -1};
+    const auto cost = std::vector<int>{1, 2, 3, 4};
+
+    auto network = Network(graph, surplus, cost);
+
+    CATCH_SECTION("arcs")
+    {
+        CATCH_CHECK(network.num_nodes() == graph.num_vertices());
+        CATCH_CHECK(network.num_arcs() == 2 * graph.num_edges());
+        CATCH_CHECK(network.num_forward_arcs() == graph.num_edges());
+
+        std::size_t num_forward_arcs = 0;
+        for (const auto& arc : network.arcs()) {
+            const auto transpose_arc = network.get_transpose_arc_id(arc);
+            CATCH_CHECK(transpose_arc != arc);
+            CATCH_CHECK(network.get_transpose_arc_id(transpose_arc) == arc);
+            CATCH_CHECK(network.is_forward_arc(arc) !=
+                        network.is_forward_arc(transpose_arc));
+            num_forward_arcs += network.is_forward_arc(arc) ? 1U : 0U;
+        }
+        CATCH_CHECK(num_forward_arcs == graph.num_edges());
+    }
+
+    CATCH_SECTION("get_residual_graph_arc_id")
+    {
+        const auto& residual_graph = network.residual_graph();
+        for (const auto& tail : graph.vertices()) {
+            for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+                const auto edge_id = graph.get_edge_id(edge);
+                const auto arc = network.get_residual_graph_arc_id(edge_id);
+                CATCH_CHECK(network.is_forward_arc(arc));
+                CATCH_CHECK(network.get_edge_id(arc) == edge_id);
+                CATCH_CHECK(network.arc_cost(arc) == cost[edge_id]);
+
+                const auto transpose_arc = network.get_transpose_arc_id(arc);
+                CATCH_CHECK(network.arc_cost(transpose_arc) == -cost[edge_id]);
+
+                // Check that the forward arc is incident on the correct nodes.
+                auto found = false;
+                for (const auto& [outgoing_arc, arc_head] :
+                     residual_graph.outgoing_edges(tail)) {
+                    found = found || ((outgoing_arc == arc) && (arc_head == head));
+                }
+                CATCH_CHECK(found);
+            }
+        }
+    }
+
+    CATCH_SECTION("excess_nodes/deficit_nodes")
+    {
+        using Node = typename Network::node_type;
+        const auto contents = [](const auto& nodes) {
+            return std::vector<Node>(std::begin(nodes), std::end(nodes));
+        };
+
+        CATCH_CHECK(contents(network.excess_nodes()) == std::vector<Node>{0U});
+        CATCH_CHECK(contents(network.deficit_nodes()) == std::vector<Node>{2U});
+        CATCH_CHECK(network.total_excess() == 1);
+        CATCH_CHECK(network.total_deficit() == -1);
+        CATCH_CHECK(network.is_balanced());
+
+        // Move the unit of excess from node 0 to node 1 and then cancel it out.
+        network.decrease_node_excess(0U, 1);
+        CATCH_CHECK(std::empty(network.excess_nodes()));
+        CATCH_CHECK(!network.is_balanced());
+
+        network.increase_node_excess(1U, 1);
+        CATCH_CHECK(contents(network.excess_nodes()) == std::vector<Node>{1U});
+        CATCH_CHECK(network.is_balanced());
+
+        network.decrease_node_excess(1U, 2);
+        CATCH_CHECK(std::empty(network.excess_nodes()));
+        CATCH_CHECK(std::size(network.deficit_nodes()) == 2U);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_deficit() == -2);
+
+        network.increase_node_excess(1U, 1);
+        network.increase_node_excess(2U, 1);
+        CATCH_CHECK(std::empty(network.deficit_nodes()));
+        CATCH_CHECK(network.total_deficit() == 0);
+        CATCH_CHECK(network.is_balanced());
+    }
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        using Dijkstra = ww::Dijkstra<int, typename Network::residual_graph_type>;
+        ww::successive_shortest_paths<Dijkstra>(network);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_deficit() == 0);
+        CATCH_CHECK(std::empty(network.excess_nodes()));
+        CATCH_CHECK(std::empty(network.deficit_nodes()));
+
+        // The only path from node 0 to node 2 is 0->1->2.
+        CATCH_CHECK(network.total_cost() == 1 + 3);
+    }
+}
+
+CATCH_TEMPLATE_TEST_CASE("InterleavedResidualGraphMixin",
+                         "[network]",
+                         std::size_t,
+                         std::uint32_t)
+{
+    using Graph = ww::CSRGraph<ww::Vector, TestType>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+
+    using Interleaved = ww::InterleavedResidualGraphMixin<Graph>;
+    using InterleavedNetwork =
+            ww::Network<Graph, int, int, ww::Vector,
+                        ww::UnitCapacityMixin<Graph, int, ww::Vector, Interleaved>>;
+
+    // Includes a pair of antiparallel edges (0->1 and 1->0) and a parallel edge.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 0U);
+    edgelist.add_edge(1U, 0U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(0U, 2U);
+
+    const auto graph = Graph(edgelist);
+    const auto surplus = std::vector<int>{1, 0, -1};
+    const auto cost = std::vector<int>{1, 5, 2, 3, 4, 6};
+
+    auto network = InterleavedNetwork(graph, surplus, cost);
+
+    CATCH_SECTION("arcs")
+    {
+        CATCH_CHECK(network.num_nodes() == graph.num_vertices());
+        CATCH_CHECK(network.num_arcs() == 2 * graph.num_edges());
+
+        for (const auto& arc : network.arcs()) {
+            const auto transpose_arc = network.get_transpose_arc_id(arc);
+            CATCH_CHECK(transpose_arc != arc);
+            CATCH_CHECK(network.get_transpose_arc_id(transpose_arc) == arc);
+            CATCH_CHECK(network.is_forward_arc(arc) !=
+                        network.is_forward_arc(transpose_arc));
+            CATCH_CHECK(network.is_forward_arc(arc) == (arc % 2 == 0));
+        }
+    }
+
+    CATCH_SECTION("get_residual_graph_arc_id")
+    {
+        const auto& residual_graph = network.residual_graph();
+        for (const auto& tail : graph.vertices()) {
+            for (const auto& [edge, head] : graph.outgoing_edges(tail)) {
+                const auto edge_id = graph.get_edge_id(edge);
+                const auto arc = network.get_residual_graph_arc_id(edge_id);
+                CATCH_CHECK(network.is_forward_arc(arc));
+                CATCH_CHECK(network.get_edge_id(arc) == edge_id);
+                CATCH_CHECK(network.arc_cost(arc) == cost[edge_id]);
+
+                const auto transpose_arc = network.get_transpose_arc_id(arc);
+                CATCH_CHECK(network.arc_cost(transpose_arc) == -cost[edge_id]);
+
+                // Check that the forward and reverse arcs are incident on the correct
+                // nodes.
+                auto found_forward_arc = false;
+                for (const auto& [outgoing_arc, arc_head] :
+                     residual_graph.outgoing_edges(tail)) {
+                    found_forward_arc = found_forward_arc ||
+                                        ((outgoing_arc == arc) && (arc_head == head));
+                }
+                CATCH_CHECK(found_forward_arc);
+
+                auto found_reverse_arc = false;
+                for (const auto& [outgoing_arc, arc_head] :
+                     residual_graph.outgoing_edges(head)) {
+                    found_reverse_arc =
+                            found_reverse_arc ||
+                            ((outgoing_arc == transpose_arc) && (arc_head == tail));
+                }
+                CATCH_CHECK(found_reverse_arc);
+            }
+        }
+    }
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        auto reference_network = Network(graph, surplus, cost);
+        using ReferenceDijkstra =
+                ww::Dijkstra<int, typename Network::residual_graph_type>;
+        ww::successive_shortest_paths<ReferenceDijkstra>(reference_network);
+
+        using Dijkstra =
+                ww::Dijkstra<int, typename InterleavedNetwork::residual_graph_type>;
+        ww::successive_shortest_paths<Dijkstra>(network);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_deficit() == 0);
+        CATCH_CHECK(network.total_cost() == reference_network.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("ResidualGraphMixin (CompactGridGraph)", "[network]")
+{
+    using Vertex = std::uint32_t;
+    using Grid = ww::RectangularGridGraph<1, Vertex>;
+    using CompactGrid = ww::CompactGridGraph<1, Vertex>;
+
+    const auto grid = Grid(4U, 5U);
+    const auto compact_grid = CompactGrid(4U, 5U);
+
+    // A pair of opposite-signed residues in opposite corners of the grid.
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus.front() = 1;
+    surplus.back() = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((7 * edge) % 5);
+    }
+
+    using GridNetwork = ww::Network<Grid, int, int, ww::Vector,
+                                    ww::UnitCapacityMixin<Grid, int>>;
+    using CompactNetwork = ww::Network<CompactGrid, int, int, ww::Vector,
+                                       ww::UnitCapacityMixin<CompactGrid, int>>;
+
+    auto grid_network = GridNetwork(grid, surplus, cost);
+    auto compact_network = CompactNetwork(compact_grid, surplus, cost);
+
+    CATCH_SECTION("arcs")
+    {
+        CATCH_CHECK(compact_network.num_nodes() == grid_network.num_nodes());
+        CATCH_CHECK(compact_network.num_arcs() == grid_network.num_arcs());
+        for (const auto& arc : compact_network.arcs()) {
+            CATCH_CHECK(compact_network.get_transpose_arc_id(arc) ==
+                        grid_network.get_transpose_arc_id(arc));
+            CATCH_CHECK(compact_network.arc_cost(arc) == grid_network.arc_cost(arc));
+        }
+    }
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        using GridDijkstra = ww::Dijkstra<int, GridNetwork::residual_graph_type>;
+        ww::successive_shortest_paths<GridDijkstra>(grid_network);
+
+        using CompactDijkstra = ww::Dijkstra<int, CompactNetwork::residual_graph_type>;
+        ww::successive_shortest_paths<CompactDijkstra>(compact_network);
+
+        CATCH_CHECK(compact_network.total_excess() == 0);
+        CATCH_CHECK(compact_network.total_cost() == grid_network.total_cost());
+    }
+
+    CATCH_SECTION("successive_shortest_paths (radix heap)")
+    {
+        using GridDijkstra = ww::Dijkstra<int, GridNetwork::residual_graph_type>;
+        ww::successive_shortest_paths<GridDijkstra>(grid_network);
+
+        using ResidualGraph = CompactNetwork::residual_graph_type;
+        using RadixHeap = ww::RadixHeap<ResidualGraph::vertex_type, int>;
+        using RadixDijkstra = ww::Dijkstra<int, ResidualGraph, ww::Vector, RadixHeap>;
+        ww::successive_shortest_paths<RadixDijkstra>(compact_network);
+
+        CATCH_CHECK(compact_network.total_excess() == 0);
+        CATCH_CHECK(compact_network.total_cost() == grid_network.total_cost());
+    }
+}
+
+} // namespace
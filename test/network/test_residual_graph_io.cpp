@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <whirlwind/common/mapped_file.hpp>
+#include <whirlwind/container/const_span.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/residual_graph.hpp>
+#include <whirlwind/network/residual_graph_io.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/string_conversions.hpp" // IWYU pragma: keep
+
+namespace {
+
+namespace CM = Catch::Matchers;
+namespace fs = std::filesystem;
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("Network (residual graph binary file)", "[network]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int, ww::Vector,
+                                ww::UnitCapacityMixin<Graph, int>>;
+
+    using MappedGraph = ww::CSRGraph<ww::ConstSpan, std::uint32_t>;
+    using MappedResidualGraphMixin = ww::ResidualGraphMixin<MappedGraph, ww::ConstSpan>;
+    using MappedMixin = ww::UnitCapacityMixin<MappedGraph, int, ww::Vector,
+                                              MappedResidualGraphMixin>;
+    using MappedNetwork = ww::Network<MappedGraph, int, int, ww::Vector, MappedMixin>;
+
+    // Includes a pair of antiparallel edges (0->1 and 1->0) and a parallel edge.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 0U);
+    edgelist.add_edge(1U, 0U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(0U, 2U);
+
+    const auto graph = Graph(edgelist);
+    const auto surplus = std::vector<int>{1, 0, -1};
+    const auto cost = std::vector<int>{1, 5, 2, 3, 4, 6};
+
+    auto network = Network(graph, surplus, cost);
+
+    const auto path = fs::temp_directory_path() / "whirlwind_test_residual_graph.bin";
+    {
+        auto os = std::ofstream(path, std::ios::binary);
+        ww::write_residual_graph(os, network);
+    }
+
+    {
+        const auto file = ww::MappedFile(path.string());
+        auto layout = ww::map_residual_graph<std::uint32_t>(file);
+        auto mapped_network = MappedNetwork(std::move(layout), surplus, cost);
+
+        CATCH_SECTION("arcs")
+        {
+            CATCH_REQUIRE(mapped_network.num_nodes() == network.num_nodes());
+            CATCH_REQUIRE(mapped_network.num_arcs() == network.num_arcs());
+
+            for (const auto& arc : network.arcs()) {
+                CATCH_CHECK(mapped_network.is_forward_arc(arc) ==
+                            network.is_forward_arc(arc));
+                CATCH_CHECK(mapped_network.get_transpose_arc_id(arc) ==
+                            network.get_transpose_arc_id(arc));
+                CATCH_CHECK(mapped_network.arc_cost(arc) == network.arc_cost(arc));
+                CATCH_CHECK(mapped_network.arc_flow(arc) == network.arc_flow(arc));
+            }
+            for (const auto& edge : graph.edges()) {
+                const auto edge_id = graph.get_edge_id(edge);
+                CATCH_CHECK(mapped_network.get_residual_graph_arc_id(edge_id) ==
+                            network.get_residual_graph_arc_id(edge_id));
+            }
+            for (const auto& node : network.nodes()) {
+                CATCH_CHECK_THAT(mapped_network.outgoing_arcs(node),
+                                 CM::RangeEquals(network.outgoing_arcs(node)));
+            }
+        }
+
+        CATCH_SECTION("successive_shortest_paths")
+        {
+            using Dijkstra = ww::Dijkstra<int, Graph>;
+            ww::successive_shortest_paths<Dijkstra>(network);
+
+            using MappedDijkstra = ww::Dijkstra<int, MappedGraph>;
+            ww::successive_shortest_paths<MappedDijkstra>(mapped_network);
+
+            CATCH_CHECK(mapped_network.total_excess() == 0);
+            CATCH_CHECK(mapped_network.total_deficit() == 0);
+            CATCH_CHECK(mapped_network.total_cost() == network.total_cost());
+        }
+    }
+
+    fs::remove(path);
+}
+
+} // namespace
@@ -0,0 +1,223 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/solver_control.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+// Make a network on a grid with many pairs of opposite-signed residues scattered
+// pseudo-randomly, and pseudo-random arc costs.
+auto
+make_network(const Grid& grid) -> Network
+{
+    return ww::testing::make_scattered_residue_network<Network>(grid);
+}
+
+// An executor that runs each task on a new thread, joined on destruction.
+struct ThreadExecutor {
+    std::vector<std::jthread> threads;
+
+    void
+    operator()(std::function<void()> task)
+    {
+        threads.emplace_back(std::move(task));
+    }
+};
+
+CATCH_TEST_CASE("SolverControl", "[network]")
+{
+    const auto grid = Grid(16U, 17U);
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+    CATCH_REQUIRE(expected.total_excess() == 0);
+
+    CATCH_STATIC_REQUIRE(!ww::NullSolverStats().should_stop());
+
+    CATCH_SECTION("progress")
+    {
+        auto network = make_network(grid);
+        auto control = ww::SolverControl();
+        auto excess = std::vector<std::size_t>();
+        control.set_progress_callback(
+                [&](const ww::SolverStats& stats) {
+                    excess.push_back(stats.excess_remaining);
+                });
+
+        ww::successive_shortest_paths<Dijkstra>(
+                network, ww::SuccessiveShortestPathsSearch::goal_directed, control);
+        CATCH_CHECK(!control.stopped());
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+
+        // The callback is invoked before each iteration, so the first call precedes
+        // any statistics.
+        CATCH_CHECK(std::size(excess) == control.num_iterations);
+        for (std::size_t i = 2; i < std::size(excess); ++i) {
+            CATCH_CHECK(excess[i] < excess[i - 1]);
+        }
+    }
+
+    CATCH_SECTION("cancel (successive shortest paths)")
+    {
+        auto network = make_network(grid);
+        const auto initial_excess = network.total_excess();
+
+        auto stop_source = std::stop_source();
+        auto control = ww::SolverControl();
+        control.set_stop_token(stop_source.get_token());
+        control.set_progress_callback([&](const ww::SolverStats& stats) {
+            if (stats.num_iterations == 3) {
+                stop_source.request_stop();
+            }
+        });
+
+        ww::successive_shortest_paths<Dijkstra>(
+                network, ww::SuccessiveShortestPathsSearch::goal_directed, control);
+        CATCH_CHECK(control.stop_reason() == ww::SolverStopReason::cancelled);
+        CATCH_CHECK(control.num_iterations == 3);
+        CATCH_CHECK(network.total_excess() > 0);
+        CATCH_CHECK(network.total_excess() < initial_excess);
+
+        // The partial solution may be resumed.
+        ww::successive_shortest_paths<Dijkstra>(network);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("cancel (primal-dual)")
+    {
+        auto network = make_network(grid);
+        const auto initial_excess = network.total_excess();
+
+        auto stop_source = std::stop_source();
+        stop_source.request_stop();
+        auto control = ww::SolverControl();
+        control.set_stop_token(stop_source.get_token());
+
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 0, ww::PrimalDualPhase::single_path,
+                ww::default_primal_dual_min_yield,
+                ww::SuccessiveShortestPathsSearch::dijkstra, control);
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::interrupted);
+        CATCH_CHECK(summary.num_iterations == 0);
+        const auto remaining_excess = static_cast<std::size_t>(initial_excess);
+        CATCH_CHECK(summary.remaining_excess == remaining_excess);
+        CATCH_CHECK(control.stop_reason() == ww::SolverStopReason::cancelled);
+        CATCH_CHECK(network.total_excess() == initial_excess);
+    }
+
+    CATCH_SECTION("deadline")
+    {
+        auto network = make_network(grid);
+        auto control = ww::SolverControl();
+        control.set_deadline(ww::SolverControl::clock_type::now());
+
+        const auto summary = ww::primal_dual<Dijkstra>(
+                network, 0, ww::PrimalDualPhase::single_path,
+                ww::default_primal_dual_min_yield,
+                ww::SuccessiveShortestPathsSearch::dijkstra, control);
+        CATCH_CHECK(summary.stop_reason == ww::PrimalDualStopReason::interrupted);
+        CATCH_CHECK(control.stop_reason() == ww::SolverStopReason::deadline);
+        CATCH_CHECK(network.total_excess() > 0);
+    }
+
+    CATCH_SECTION("time budget")
+    {
+        auto network = make_network(grid);
+        auto control = ww::SolverControl();
+        control.set_time_budget(std::chrono::hours(1));
+
+        ww::primal_dual<Dijkstra>(network, 0, ww::PrimalDualPhase::single_path,
+                                  ww::default_primal_dual_min_yield,
+                                  ww::SuccessiveShortestPathsSearch::dijkstra, control);
+        CATCH_CHECK(!control.stopped());
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("solve_async", "[network]")
+{
+    const auto grid = Grid(16U, 17U);
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected);
+
+    CATCH_SECTION("complete")
+    {
+        auto network = make_network(grid);
+        auto executor = ThreadExecutor();
+        auto task = ww::solve_async(executor, [&](auto& control) {
+            ww::successive_shortest_paths<Dijkstra>(
+                    network, ww::SuccessiveShortestPathsSearch::goal_directed,
+                    control);
+        });
+        CATCH_REQUIRE(task.valid());
+        task.wait();
+        CATCH_CHECK(task.wait_for(std::chrono::seconds(0)));
+        CATCH_CHECK(task.get() == ww::SolverStopReason::none);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("cancel")
+    {
+        auto network = make_network(grid);
+        const auto initial_excess = network.total_excess();
+
+        // Block the solve until it has been cancelled.
+        auto cancelled = std::promise<void>();
+        auto control = ww::SolverControl();
+        control.set_progress_callback(
+                [future = cancelled.get_future().share()](const auto&) {
+                    future.wait();
+                });
+
+        auto executor = ThreadExecutor();
+        auto task = ww::solve_async(
+                executor,
+                [&](auto& control) {
+                    ww::successive_shortest_paths<Dijkstra>(
+                            network, ww::SuccessiveShortestPathsSearch::goal_directed,
+                            control);
+                },
+                std::move(control));
+        task.cancel();
+        cancelled.set_value();
+
+        CATCH_CHECK(task.get() == ww::SolverStopReason::cancelled);
+        CATCH_CHECK(network.total_excess() == initial_excess);
+    }
+
+    CATCH_SECTION("exception")
+    {
+        auto executor = ThreadExecutor();
+        auto task = ww::solve_async(executor, [](auto&) {
+            throw std::runtime_error("failed");
+        });
+        CATCH_CHECK_THROWS_AS(task.get(), std::runtime_error);
+    }
+}
+
+} // namespace
@@ -0,0 +1,248 @@
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/solver_workspace.hpp>
+#include <whirlwind/network/solver_workspace_concepts.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using ResidualGraph = Network::residual_graph_type;
+
+// Make a network on a grid with two pairs of opposite-signed
+// residues and pseudo-random arc costs.
+template<class Net = Network, class Graph>
+auto
+make_network(const Graph& grid, std::size_t seed) -> Net
+{
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[seed % 5] = 1;
+    surplus[7 + (seed % 3)] = 1;
+    surplus[grid.num_vertices() - 9] = -1;
+    surplus.back() = -1;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((7 * edge + seed) % 5);
+    }
+
+    return {grid, surplus, cost};
+}
+
+CATCH_TEST_CASE("SolverWorkspaceType", "[network]")
+{
+    using Dijkstra = ww::Dijkstra<int, ResidualGraph>;
+    CATCH_STATIC_REQUIRE(ww::SolverWorkspaceType<ww::SolverWorkspace<Dijkstra>>);
+    CATCH_STATIC_REQUIRE(!ww::SolverWorkspaceType<Dijkstra>);
+}
+
+CATCH_TEST_CASE("SolverWorkspace", "[network]")
+{
+    using Dijkstra = ww::Dijkstra<int, ResidualGraph>;
+    auto workspace = ww::SolverWorkspace<Dijkstra>();
+    CATCH_CHECK(workspace.capacity() == 0);
+
+    const auto large_grid = Grid(8U, 9U);
+    const auto small_grid = Grid(6U, 7U);
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        for (std::size_t seed = 0; seed < 4; ++seed) {
+            const auto& grid = (seed % 2 == 0) ? large_grid : small_grid;
+            auto expected = make_network(grid, seed);
+            auto network = make_network(grid, seed);
+
+            ww::successive_shortest_paths<Dijkstra>(expected);
+            ww::successive_shortest_paths(network, workspace);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+            CATCH_CHECK(workspace.capacity() == large_grid.num_vertices());
+        }
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        for (std::size_t seed = 0; seed < 4; ++seed) {
+            const auto& grid = (seed % 2 == 0) ? large_grid : small_grid;
+            auto expected = make_network(grid, seed);
+            auto network = make_network(grid, seed);
+
+            ww::primal_dual<Dijkstra>(expected);
+            ww::primal_dual(network, workspace);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+    }
+
+    CATCH_SECTION("primal_dual (shortest_path_forest)")
+    {
+        for (std::size_t seed = 0; seed < 4; ++seed) {
+            const auto& grid = (seed % 2 == 0) ? large_grid : small_grid;
+            auto expected = make_network(grid, seed);
+            auto network = make_network(grid, seed);
+
+            ww::primal_dual<Dijkstra>(expected);
+            ww::primal_dual(network, workspace, 0,
+                            ww::PrimalDualPhase::shortest_path_forest);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+    }
+
+    CATCH_SECTION("primal_dual (maxiter)")
+    {
+        // With a single primal-dual iteration, the remaining excess is routed by the
+        // successive shortest paths fallback, which uses the workspace's other solver.
+        for (std::size_t seed = 0; seed < 4; ++seed) {
+            const auto& grid = (seed % 2 == 0) ? large_grid : small_grid;
+            auto expected = make_network(grid, seed);
+            auto network = make_network(grid, seed);
+
+            ww::primal_dual<Dijkstra>(expected, 1);
+            ww::primal_dual(network, workspace, 1);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+    }
+
+    CATCH_SECTION("growth")
+    {
+        auto small_network = make_network(small_grid, 0);
+        ww::successive_shortest_paths(small_network, workspace);
+        CATCH_CHECK(workspace.capacity() == small_grid.num_vertices());
+
+        auto large_network = make_network(large_grid, 0);
+        ww::successive_shortest_paths(large_network, workspace);
+        CATCH_CHECK(workspace.capacity() == large_grid.num_vertices());
+        CATCH_CHECK(large_network.total_excess() == 0);
+    }
+
+    CATCH_SECTION("clear")
+    {
+        auto network = make_network(large_grid, 0);
+        ww::successive_shortest_paths(network, workspace);
+        CATCH_CHECK(workspace.capacity() > 0);
+
+        workspace.clear();
+        CATCH_CHECK(workspace.capacity() == 0);
+    }
+}
+
+CATCH_TEST_CASE("SolverWorkspace (Dial)", "[network]")
+{
+    using Dial = ww::Dial<int, ResidualGraph>;
+    using Dijkstra = ww::Dijkstra<int, ResidualGraph>;
+    auto workspace = ww::SolverWorkspace<Dial>();
+
+    const auto grid = Grid(6U, 7U);
+    for (std::size_t seed = 0; seed < 4; ++seed) {
+        auto expected = make_network(grid, seed);
+        auto network = make_network(grid, seed);
+
+        ww::successive_shortest_paths<Dijkstra>(expected);
+        ww::successive_shortest_paths(network, workspace);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("SolverWorkspace (RectangularGridGraph)", "[network]")
+{
+    // The vertices of a `RectangularGridGraph` are (row, col) pairs, so a solver that
+    // is rebound to a grid with a different number of columns must not retain any
+    // vertices of the previous grid. Each network (and its residual graph) is
+    // destroyed before the workspace is reused for the next one.
+    using RectGrid = ww::RectangularGridGraph<1, std::uint32_t>;
+    using RectNetwork = ww::Network<RectGrid, int, int>;
+    using Dijkstra = ww::Dijkstra<int, RectNetwork::residual_graph_type>;
+    auto workspace = ww::SolverWorkspace<Dijkstra>();
+
+    const auto grids = std::vector<RectGrid>{RectGrid(6U, 10U), RectGrid(10U, 6U),
+                                             RectGrid(8U, 7U), RectGrid(5U, 11U)};
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        for (std::size_t seed = 0; seed < std::size(grids); ++seed) {
+            const auto& grid = grids[seed];
+            auto expected = make_network<RectNetwork>(grid, seed);
+            auto network = make_network<RectNetwork>(grid, seed);
+
+            ww::successive_shortest_paths<Dijkstra>(expected);
+            ww::successive_shortest_paths(network, workspace);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+            CATCH_CHECK(workspace.capacity() == grids[0].num_vertices());
+        }
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        for (std::size_t seed = 0; seed < std::size(grids); ++seed) {
+            const auto& grid = grids[seed];
+            auto expected = make_network<RectNetwork>(grid, seed);
+            auto network = make_network<RectNetwork>(grid, seed);
+
+            ww::primal_dual<Dijkstra>(expected);
+            ww::primal_dual(network, workspace);
+
+            CATCH_CHECK(network.total_excess() == 0);
+            CATCH_CHECK(network.total_cost() == expected.total_cost());
+        }
+    }
+
+    CATCH_SECTION("rebind")
+    {
+        // After rebinding, each vertex of the new grid is the root of its own
+        // singleton tree and is unreached, even if the previous grid has since been
+        // destroyed.
+        auto network = std::optional(make_network<RectNetwork>(grids[0], 0));
+        auto dijkstra = Dijkstra(network->residual_graph());
+
+        for (std::size_t k = 1; k < std::size(grids); ++k) {
+            // Search the entire residual graph with unit arc lengths.
+            const auto& graph = dijkstra.graph();
+            dijkstra.add_source(*std::begin(network->nodes()));
+            while (!dijkstra.done()) {
+                const auto [tail, distance] = dijkstra.pop_next_unvisited_vertex();
+                dijkstra.visit_vertex(tail, distance);
+                for (const auto& [arc, head] : graph.outgoing_edges(tail)) {
+                    if (!dijkstra.has_reached_vertex(head)) {
+                        dijkstra.relax_edge(arc, tail, head, distance + 1);
+                    }
+                }
+            }
+
+            network.emplace(make_network<RectNetwork>(grids[k], k));
+            dijkstra.rebind(network->residual_graph());
+            for (const auto& vertex : network->nodes()) {
+                CATCH_CHECK(dijkstra.is_root_vertex(vertex));
+                CATCH_CHECK(!dijkstra.has_reached_vertex(vertex));
+            }
+            CATCH_CHECK(dijkstra.done());
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,377 @@
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/dijkstra_visitor.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/logging/solver_stats.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/solver_control.hpp>
+#include <whirlwind/network/solver_workspace.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using Network =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+// Make a network on a grid with many pairs of opposite-signed residues scattered
+// pseudo-randomly, and pseudo-random arc costs.
+auto
+make_network(const Grid& grid) -> Network
+{
+    return ww::testing::make_scattered_residue_network<Network>(grid);
+}
+
+// A search visitor that counts the number of times each node is popped (i.e. a heatmap
+// of search effort), along with the other search events.
+struct HeatmapVisitor : ww::NullSolverStats {
+    explicit HeatmapVisitor(const Network& network)
+        : network(&network), num_pops(network.num_nodes(), 0)
+    {}
+
+    void
+    on_pop(const Network::node_type& node, int /* distance */)
+    {
+        num_pops[network->get_node_id(node)] += 1;
+    }
+
+    template<class Arc>
+    void
+    on_relax(const Arc&, const Network::node_type&, const Network::node_type&, int)
+    {
+        num_relaxed += 1;
+    }
+
+    template<class Arc>
+    void
+    on_improve(const Arc&, const Network::node_type&, const Network::node_type&, int)
+    {
+        num_improved += 1;
+    }
+
+    void
+    on_sink_found(const Network::node_type& node)
+    {
+        sinks.push_back(node);
+    }
+
+    [[nodiscard]] auto
+    total_pops() const -> std::size_t
+    {
+        auto total = std::size_t{0};
+        for (const auto& n : num_pops) {
+            total += n;
+        }
+        return total;
+    }
+
+    const Network* network;
+    std::vector<std::size_t> num_pops;
+    std::size_t num_relaxed = 0;
+    std::size_t num_improved = 0;
+    std::vector<Network::node_type> sinks = {};
+};
+
+CATCH_TEST_CASE("dijkstra_ssp (visitor)", "[network]")
+{
+    const auto grid = Grid(12U, 13U);
+
+    CATCH_SECTION("single search")
+    {
+        auto network = make_network(grid);
+        auto dijkstra = Dijkstra(network);
+        auto visitor = HeatmapVisitor(network);
+        CATCH_STATIC_REQUIRE(ww::DijkstraVisitorType<HeatmapVisitor, Dijkstra>);
+
+        const auto source = *std::begin(network.excess_nodes());
+        const auto sink = ww::dijkstra_ssp(dijkstra, network, source, visitor);
+        CATCH_REQUIRE(sink);
+
+        // Each visited node was popped exactly once.
+        const auto visited_vertices = dijkstra.visited_vertices();
+        CATCH_CHECK(visitor.total_pops() == std::size(visited_vertices));
+        for (const auto& node : visited_vertices) {
+            CATCH_CHECK(visitor.num_pops[network.get_node_id(node)] == 1);
+        }
+
+        CATCH_CHECK(visitor.num_relaxed > 0);
+        CATCH_CHECK(visitor.num_improved <= visitor.num_relaxed);
+        CATCH_REQUIRE(std::size(visitor.sinks) == 1);
+        CATCH_CHECK(visitor.sinks[0] == *sink);
+    }
+
+    CATCH_SECTION("full solve")
+    {
+        // A visitor derived from `NullSolverStats` may be passed to the solver to
+        // accumulate a heatmap of every search.
+        auto expected = make_network(grid);
+        ww::successive_shortest_paths<Dijkstra>(
+                expected, ww::SuccessiveShortestPathsSearch::dijkstra);
+
+        auto network = make_network(grid);
+        const auto initial_excess = static_cast<std::size_t>(network.total_excess());
+        auto visitor = HeatmapVisitor(network);
+        ww::successive_shortest_paths<Dijkstra>(
+                network, ww::SuccessiveShortestPathsSearch::dijkstra, visitor);
+
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+        CATCH_CHECK(std::size(visitor.sinks) == initial_excess);
+        CATCH_CHECK(visitor.total_pops() >= initial_excess);
+    }
+}
+
+CATCH_TEST_CASE("update_potential_to_deficits", "[network]")
+{
+    const auto grid = Grid(12U, 13U);
+    auto network = make_network(grid);
+    auto dijkstra = Dijkstra(network);
+
+    // Route some of the flow first, so that the residual graph contains reverse arcs
+    // and the potentials are nonzero.
+    const auto source = *std::begin(network.excess_nodes());
+    const auto sink = ww::dijkstra_ssp(dijkstra, network, source);
+    CATCH_REQUIRE(sink);
+    ww::augment_flow_ssp(network, dijkstra, *sink);
+    ww::update_potential_ssp(network, dijkstra, *sink);
+
+    ww::dijkstra_to_deficits(dijkstra, network);
+    ww::update_potential_to_deficits(network, dijkstra);
+
+    // The reduced costs of all unsaturated arcs are nonnegative.
+    ww::testing::check_reduced_cost_optimality(network);
+
+    // Each node is at zero reduced cost distance from the nearest deficit node.
+    ww::dijkstra_to_deficits(dijkstra, network);
+    for (const auto& node : dijkstra.visited_vertices()) {
+        CATCH_CHECK(dijkstra.distance_to_vertex(node) == 0);
+    }
+
+    // So the next search from an excess node doesn't need to leave the zero reduced
+    // cost subgraph.
+    const auto next_source = *std::begin(network.excess_nodes());
+    const auto next_sink = ww::dijkstra_ssp(dijkstra, network, next_source);
+    CATCH_REQUIRE(next_sink);
+    CATCH_CHECK(dijkstra.distance_to_vertex(*next_sink) == 0);
+}
+
+CATCH_TEST_CASE("successive_shortest_paths (goal-directed search)", "[network]")
+{
+    using SSPSearch = ww::SuccessiveShortestPathsSearch;
+
+    const auto grid = Grid(16U, 17U);
+
+    auto expected = make_network(grid);
+    ww::successive_shortest_paths<Dijkstra>(expected, SSPSearch::dijkstra);
+    CATCH_REQUIRE(expected.total_excess() == 0);
+
+    CATCH_SECTION("Dijkstra")
+    {
+        auto network = make_network(grid);
+        ww::successive_shortest_paths<Dijkstra>(network, SSPSearch::goal_directed);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("Dial")
+    {
+        using Dial = ww::Dial<int, Network::residual_graph_type>;
+        auto network = make_network(grid);
+        ww::successive_shortest_paths<Dial>(network, SSPSearch::goal_directed);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+
+    CATCH_SECTION("SolverWorkspace")
+    {
+        auto workspace = ww::SolverWorkspace<Dijkstra>();
+        auto network = make_network(grid);
+        ww::successive_shortest_paths(network, workspace, SSPSearch::goal_directed);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("successive_shortest_paths (default search)", "[network]")
+{
+    using SSPSearch = ww::SuccessiveShortestPathsSearch;
+
+    const auto grid = Grid(16U, 17U);
+
+    // Goal-directed search is opt-in, so by default the solution (including the node
+    // potentials) is the same as with a plain Dijkstra search.
+    const auto check_same_solution = [](const Network& network,
+                                        const Network& expected) {
+        for (const auto& node : network.nodes()) {
+            CATCH_CHECK(network.node_potential(node) == expected.node_potential(node));
+        }
+        for (const auto& arc : network.forward_arcs()) {
+            CATCH_CHECK(network.arc_flow(arc) == expected.arc_flow(arc));
+        }
+    };
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        auto expected = make_network(grid);
+        ww::successive_shortest_paths<Dijkstra>(expected, SSPSearch::dijkstra);
+
+        auto network = make_network(grid);
+        ww::successive_shortest_paths<Dijkstra>(network);
+        check_same_solution(network, expected);
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        // The remaining excess after the first primal-dual iteration is routed by the
+        // successive shortest paths algorithm using the caller's choice of search.
+        auto expected = make_network(grid);
+        ww::primal_dual<Dijkstra>(expected, 1, ww::PrimalDualPhase::single_path,
+                                  ww::default_primal_dual_min_yield,
+                                  SSPSearch::dijkstra);
+
+        auto network = make_network(grid);
+        ww::primal_dual<Dijkstra>(network, 1);
+        check_same_solution(network, expected);
+
+        auto goal_directed = make_network(grid);
+        ww::primal_dual<Dijkstra>(goal_directed, 1, ww::PrimalDualPhase::single_path,
+                                  ww::default_primal_dual_min_yield,
+                                  SSPSearch::goal_directed);
+        CATCH_CHECK(goal_directed.total_excess() == 0);
+        CATCH_CHECK(goal_directed.total_cost() == expected.total_cost());
+    }
+}
+
+// A stand-in for a shortest path search that records each edge relaxation, so that the
+// relaxations of different implementations may be compared exactly.
+template<class Network>
+struct RelaxationRecorder {
+    using distance_type = typename Network::cost_type;
+    using node_type = typename Network::node_type;
+    using arc_type = typename Network::arc_type;
+
+    struct Relaxation {
+        arc_type arc;
+        node_type tail;
+        node_type head;
+        distance_type distance;
+
+        friend auto
+        operator==(const Relaxation&, const Relaxation&) -> bool = default;
+    };
+
+    [[nodiscard]] auto
+    distance_to_vertex(const node_type& /* node */) const -> distance_type
+    {
+        return ww::infinity<distance_type>();
+    }
+
+    [[nodiscard]] auto
+    has_reached_vertex(const node_type& /* node */) const -> bool
+    {
+        return !relaxations.empty();
+    }
+
+    void
+    relax_edge(const arc_type& arc,
+               const node_type& tail,
+               const node_type& head,
+               distance_type distance)
+    {
+        relaxations.push_back({arc, tail, head, distance});
+    }
+
+    std::vector<Relaxation> relaxations = {};
+};
+
+CATCH_TEST_CASE("relax_outgoing_arcs (grid)", "[network]")
+{
+    using GridGraph = ww::RectangularGridGraph<1, std::uint32_t>;
+    using GridNetwork = ww::Network<GridGraph, double, int, ww::Vector,
+                                    ww::UnitCapacityMixin<GridGraph, int>>;
+    using GridDijkstra = ww::Dijkstra<double, GridNetwork::residual_graph_type>;
+    CATCH_STATIC_REQUIRE(
+            ww::detail::is_grid_residual_graph<GridNetwork::residual_graph_type>);
+    CATCH_STATIC_REQUIRE(
+            !ww::detail::is_grid_residual_graph<Network::residual_graph_type>);
+
+    const auto grid = GridGraph(11U, 14U);
+    const auto make_grid_network = [&]() {
+        const auto surplus = ww::testing::make_scattered_surplus(grid.num_vertices());
+
+        // Non-integer costs (which are exactly representable, so the reduced costs are
+        // never negative due to rounding).
+        const auto int_cost = ww::testing::make_pseudorandom_costs(grid.num_edges());
+        auto cost = std::vector<double>(std::size(int_cost));
+        for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+            cost[edge] = 0.25 * int_cost[edge];
+        }
+
+        return GridNetwork(grid, surplus, cost);
+    };
+
+    CATCH_SECTION("matches generic implementation")
+    {
+        // Interrupt a solve so that the network carries some flow and has nonzero node
+        // potentials.
+        auto network = make_grid_network();
+        auto control = ww::SolverControl();
+        auto stop_source = std::stop_source();
+        control.set_stop_token(stop_source.get_token());
+        control.set_progress_callback([&](const ww::SolverStats& stats) {
+            if (stats.num_iterations == 8) {
+                stop_source.request_stop();
+            }
+        });
+        ww::successive_shortest_paths<GridDijkstra>(
+                network, ww::SuccessiveShortestPathsSearch::dijkstra, control);
+        CATCH_REQUIRE(control.stopped());
+
+        auto visitor = ww::NullDijkstraVisitor();
+        for (const auto& node : network.nodes()) {
+            const auto distance = 0.75;
+
+            auto expected = RelaxationRecorder<GridNetwork>();
+            ww::detail::relax_outgoing_arcs_generic(expected, network, visitor, node,
+                                                    distance);
+
+            auto actual = RelaxationRecorder<GridNetwork>();
+            ww::detail::relax_outgoing_arcs(actual, network, visitor, node, distance);
+
+            CATCH_CHECK(actual.relaxations == expected.relaxations);
+        }
+    }
+
+    CATCH_SECTION("full solve")
+    {
+        auto ssp_network = make_grid_network();
+        ww::successive_shortest_paths<GridDijkstra>(ssp_network);
+        CATCH_CHECK(ssp_network.total_excess() == 0);
+
+        auto pd_network = make_grid_network();
+        ww::primal_dual<GridDijkstra>(pd_network);
+        CATCH_CHECK(pd_network.total_excess() == 0);
+
+        CATCH_CHECK(pd_network.total_cost() == ssp_network.total_cost());
+    }
+}
+
+} // namespace
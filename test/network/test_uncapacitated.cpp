@@ -0,0 +1,221 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/uncapacitated.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("UncapacitatedMixin", "[network]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int>;
+
+    // Edges are ordered by (tail,head) in the CSR graph: 0->1, 0->2, 1->2, 2->0.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(0U, 2U);
+    edgelist.add_edge(1U, 2U);
+    edgelist.add_edge(2U, 0U);
+
+    const auto graph = Graph(edgelist);
+    const auto surplus = std::vector<int>{3, 0, -3};
+    const auto cost = std::vector<int>{1, 5, 1, 1};
+
+    auto network = Network(graph, surplus, cost);
+
+    CATCH_SECTION("initial flow")
+    {
+        for (const auto& arc : network.forward_arcs()) {
+            CATCH_CHECK(network.arc_flow(arc) == 0);
+            CATCH_CHECK(network.arc_residual_capacity(arc) == ww::infinity<int>());
+            CATCH_CHECK(!network.is_arc_saturated(arc));
+
+            // Reverse arcs have no residual capacity until flow is added to the
+            // corresponding forward arc.
+            const auto transpose_arc = network.get_transpose_arc_id(arc);
+            CATCH_CHECK(network.arc_residual_capacity(transpose_arc) == 0);
+            CATCH_CHECK(network.is_arc_saturated(transpose_arc));
+        }
+    }
+
+    CATCH_SECTION("increase_arc_flow")
+    {
+        const auto arc = network.get_residual_graph_arc_id(2);
+        const auto transpose_arc = network.get_transpose_arc_id(arc);
+
+        network.increase_arc_flow(arc, 2);
+        CATCH_CHECK(network.arc_flow(arc) == 2);
+        CATCH_CHECK(network.arc_residual_capacity(transpose_arc) == 2);
+        CATCH_CHECK(!network.is_arc_saturated(transpose_arc));
+
+        network.increase_arc_flow(transpose_arc, 2);
+        CATCH_CHECK(network.arc_flow(arc) == 0);
+        CATCH_CHECK(network.is_arc_saturated(transpose_arc));
+
+        // Flow in other arcs is unaffected.
+        for (const auto& other_arc : network.forward_arcs()) {
+            CATCH_CHECK(network.arc_flow(other_arc) == 0);
+        }
+    }
+
+    CATCH_SECTION("successive_shortest_paths")
+    {
+        // All three units of flow are routed along the path 0->1->2 in a single
+        // augmentation.
+        using Dijkstra = ww::Dijkstra<int, Graph>;
+        ww::successive_shortest_paths<Dijkstra>(network);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_deficit() == 0);
+        CATCH_CHECK(network.total_cost() == 3 * (1 + 1));
+        CATCH_CHECK(network.arc_flow(network.get_residual_graph_arc_id(0)) == 3);
+        CATCH_CHECK(network.arc_flow(network.get_residual_graph_arc_id(1)) == 0);
+        CATCH_CHECK(network.arc_flow(network.get_residual_graph_arc_id(2)) == 3);
+    }
+
+    CATCH_SECTION("primal_dual")
+    {
+        using Dijkstra = ww::Dijkstra<int, Graph>;
+        ww::primal_dual<Dijkstra>(network);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == 3 * (1 + 1));
+    }
+}
+
+CATCH_TEST_CASE("Multi-unit augmentation", "[network]")
+{
+    using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+    using UncapacitatedNetwork = ww::Network<Grid, int, int>;
+    using UnitCapacityNetwork = ww::Network<Grid, int, int, ww::Vector,
+                                            ww::UnitCapacityMixin<Grid, int>>;
+    using Dijkstra = ww::Dijkstra<int, UnitCapacityNetwork::residual_graph_type>;
+
+    const auto grid = Grid(6U, 7U);
+
+    // Residues with multiple units of excess/deficit, including a source whose excess
+    // exceeds the deficit of the nearest sink. Each node has at least as many outgoing
+    // edges as its excess (or incoming edges as its deficit), so that the problem is
+    // feasible with unit capacities.
+    auto surplus = std::vector<int>(grid.num_vertices(), 0);
+    surplus[8] = 3;
+    surplus[9] = -1;
+    surplus[20] = 2;
+    surplus[30] = -2;
+    surplus.back() = -2;
+
+    auto cost = std::vector<int>(grid.num_edges());
+    for (std::size_t edge = 0; edge < std::size(cost); ++edge) {
+        cost[edge] = 1 + static_cast<int>((7 * edge) % 5);
+    }
+
+    CATCH_SECTION("UncapacitatedMixin")
+    {
+        auto ssp_network = UncapacitatedNetwork(grid, surplus, cost);
+        auto pd_network = UncapacitatedNetwork(grid, surplus, cost);
+        auto forest_network = UncapacitatedNetwork(grid, surplus, cost);
+        ww::successive_shortest_paths<Dijkstra>(ssp_network);
+        ww::primal_dual<Dijkstra>(pd_network);
+        ww::primal_dual<Dijkstra>(forest_network, 0,
+                                  ww::PrimalDualPhase::shortest_path_forest);
+
+        CATCH_CHECK(ssp_network.total_excess() == 0);
+        CATCH_CHECK(pd_network.total_excess() == 0);
+        CATCH_CHECK(forest_network.total_excess() == 0);
+        CATCH_CHECK(pd_network.total_cost() == ssp_network.total_cost());
+        CATCH_CHECK(forest_network.total_cost() == ssp_network.total_cost());
+    }
+
+    CATCH_SECTION("UnitCapacityMixin")
+    {
+        // The bottleneck capacity of each path is one, so sources with multiple units
+        // of excess require multiple augmentations.
+        auto ssp_network = UnitCapacityNetwork(grid, surplus, cost);
+        auto pd_network = UnitCapacityNetwork(grid, surplus, cost);
+        auto forest_network = UnitCapacityNetwork(grid, surplus, cost);
+        ww::successive_shortest_paths<Dijkstra>(ssp_network);
+        ww::primal_dual<Dijkstra>(pd_network);
+        ww::primal_dual<Dijkstra>(forest_network, 0,
+                                  ww::PrimalDualPhase::shortest_path_forest);
+
+        CATCH_CHECK(ssp_network.total_excess() == 0);
+        CATCH_CHECK(pd_network.total_excess() == 0);
+        CATCH_CHECK(forest_network.total_excess() == 0);
+        CATCH_CHECK(pd_network.total_cost() == ssp_network.total_cost());
+        CATCH_CHECK(forest_network.total_cost() == ssp_network.total_cost());
+
+        // The uncapacitated network has a superset of feasible flows.
+        auto network = UncapacitatedNetwork(grid, surplus, cost);
+        ww::successive_shortest_paths<Dijkstra>(network);
+        CATCH_CHECK(network.total_cost() <= ssp_network.total_cost());
+    }
+}
+
+CATCH_TEST_CASE("augment_flow_forest_pd", "[network]")
+{
+    using Graph = ww::CSRGraph<ww::Vector, std::uint32_t>;
+    using Network = ww::Network<Graph, int, int>;
+    using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+    // A tree rooted at node 0 with sinks at an interior node (1) and at two leaves (3
+    // and 4): 0->1, 1->3, 1->4, 0->2.
+    auto edgelist = ww::EdgeList();
+    edgelist.add_edge(0U, 1U);
+    edgelist.add_edge(1U, 3U);
+    edgelist.add_edge(1U, 4U);
+    edgelist.add_edge(0U, 2U);
+    const auto graph = Graph(edgelist);
+
+    const auto cost = std::vector<int>(graph.num_edges(), 1);
+
+    CATCH_SECTION("all sinks")
+    {
+        // The source has enough excess to satisfy every sink in its tree, so all of
+        // the flow is routed by a single bulk augmentation.
+        const auto surplus = std::vector<int>{4, -1, 0, -1, -2};
+        auto network = Network(graph, surplus, cost);
+        auto dijkstra = ww::PrimalDualDijkstra<Dijkstra>(network);
+        ww::dijkstra_pd(dijkstra, network);
+
+        auto flow = ww::Vector<int>();
+        ww::augment_flow_forest_pd(network, dijkstra, flow);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.total_cost() == 4 + 1 + 2);
+    }
+
+    CATCH_SECTION("limited excess")
+    {
+        // The source's excess is less than the total deficit of its tree. Node 2 is
+        // the root of another tree, from which no sink is reachable.
+        const auto surplus = std::vector<int>{2, -1, 1, -1, -1};
+        auto network = Network(graph, surplus, cost);
+        auto dijkstra = ww::PrimalDualDijkstra<Dijkstra>(network);
+        ww::dijkstra_pd(dijkstra, network);
+
+        auto flow = ww::Vector<int>();
+        ww::augment_flow_forest_pd(network, dijkstra, flow);
+
+        CATCH_CHECK(network.total_excess() == 1);
+        CATCH_CHECK(network.total_deficit() == -1);
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.node_excess(2U) == 1);
+    }
+}
+
+} // namespace
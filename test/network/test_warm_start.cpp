@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/compact_grid_graph.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/successive_shortest_paths.hpp>
+#include <whirlwind/network/uncapacitated.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+#include <whirlwind/network/warm_start.hpp>
+
+#include "../testing/networks.hpp"
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::CompactGridGraph<1, std::uint32_t>;
+using UncapacitatedNetwork = ww::Network<Grid, int, int>;
+using UnitCapacityNetwork =
+        ww::Network<Grid, int, int, ww::Vector, ww::UnitCapacityMixin<Grid, int>>;
+
+// Make a network on a grid with many pairs of opposite-signed residues scattered
+// pseudo-randomly, and pseudo-random arc costs. Different seeds perturb a few of the
+// residues and costs.
+template<class Network>
+auto
+make_network(const Grid& grid, std::size_t seed) -> Network
+{
+    return ww::testing::make_scattered_residue_network<Network>(grid, seed);
+}
+
+CATCH_TEMPLATE_TEST_CASE("warm_start",
+                         "[network]",
+                         UncapacitatedNetwork,
+                         UnitCapacityNetwork)
+{
+    using Network = TestType;
+    using Dijkstra = ww::Dijkstra<int, typename Network::residual_graph_type>;
+
+    const auto grid = Grid(15U, 17U);
+
+    auto prior = make_network<Network>(grid, 0);
+    ww::successive_shortest_paths<Dijkstra>(prior);
+    CATCH_REQUIRE(prior.total_excess() == 0);
+
+    CATCH_SECTION("same problem")
+    {
+        auto network = make_network<Network>(grid, 0);
+        ww::warm_start(network, prior);
+
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_deficit() == 0);
+        CATCH_CHECK(network.total_cost() == prior.total_cost());
+        ww::testing::check_reduced_cost_optimality(network);
+    }
+
+    CATCH_SECTION("perturbed problem")
+    {
+        auto expected = make_network<Network>(grid, 3);
+        ww::successive_shortest_paths<Dijkstra>(expected);
+
+        auto network = make_network<Network>(grid, 3);
+        ww::warm_start(network, prior);
+        CATCH_CHECK(network.is_balanced());
+        ww::testing::check_reduced_cost_optimality(network);
+
+        ww::successive_shortest_paths<Dijkstra>(network);
+        CATCH_CHECK(network.total_excess() == 0);
+        CATCH_CHECK(network.total_cost() == expected.total_cost());
+        ww::testing::check_reduced_cost_optimality(network);
+    }
+}
+
+} // namespace
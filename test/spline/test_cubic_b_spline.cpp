@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <whirlwind/spline/cubic_b_spline.hpp>
+#include <whirlwind/spline/uniform_cubic_b_spline_basis.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// Make a spline with irregularly-spaced knots and oscillating control points.
+auto
+make_spline() -> ww::CubicBSpline<double>
+{
+    auto knots = std::vector<double>();
+    for (std::size_t i = 0; i < 11; ++i) {
+        const auto t = static_cast<double>(i);
+        knots.push_back(0.7 * t + 0.01 * t * t);
+    }
+    const auto basis = ww::CubicBSplineBasis<double>(knots);
+
+    auto control_points = std::vector<double>();
+    for (std::size_t i = 0; i < basis.num_basis_funcs(); ++i) {
+        control_points.push_back(std::sin(static_cast<double>(i)));
+    }
+    return {basis, control_points};
+}
+
+// Get `n` points evenly spaced over the spline's knot span, including both endpoints.
+auto
+get_sample_points(const ww::CubicBSpline<double>& spline, std::size_t n)
+        -> std::vector<double>
+{
+    const auto knots = spline.knots();
+    const auto first = knots.front();
+    const auto last = knots.back();
+
+    auto x = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto t = static_cast<double>(i) / static_cast<double>(n - 1);
+        x[i] = first + t * (last - first);
+    }
+    return x;
+}
+
+CATCH_TEMPLATE_TEST_CASE_SIG("CubicBSpline (batched)",
+                             "[spline]",
+                             ((std::size_t BlockSize), BlockSize),
+                             1,
+                             4,
+                             8,
+                             16)
+{
+    const auto spline = make_spline();
+    const auto n = GENERATE(std::size_t{2}, std::size_t{15}, std::size_t{64});
+    const auto x = get_sample_points(spline, n);
+
+    auto y = std::vector<double>(n);
+    spline.operator()<BlockSize>(std::span<const double>(x), std::span<double>(y));
+
+    for (std::size_t i = 0; i < n; ++i) {
+        CATCH_CHECK_THAT(y[i], Catch::Matchers::WithinAbs(spline(x[i]), 1e-12));
+    }
+}
+
+CATCH_TEST_CASE("CubicBSpline (range)", "[spline]")
+{
+    const auto spline = make_spline();
+    const auto x = get_sample_points(spline, 37);
+    const auto y = spline(x);
+
+    CATCH_REQUIRE(std::size(y) == std::size(x));
+    for (std::size_t i = 0; i < std::size(x); ++i) {
+        CATCH_CHECK_THAT(y[i], Catch::Matchers::WithinAbs(spline(x[i]), 1e-12));
+    }
+}
+
+CATCH_TEST_CASE("CubicBSplineBasis (hinted knot interval)", "[spline]")
+{
+    const auto spline = make_spline();
+    const auto basis = ww::CubicBSplineBasis<double>(spline.knots());
+    const auto n = basis.num_knot_intervals();
+
+    // Include each knot, since they lie on interval boundaries.
+    auto x = get_sample_points(spline, 41);
+    for (const auto& knot : spline.knots()) {
+        x.push_back(knot);
+    }
+
+    for (const auto& xx : x) {
+        const auto expected = basis.get_knot_interval(xx);
+        for (std::size_t hint = 0; hint <= n; ++hint) {
+            CATCH_CHECK(basis.get_knot_interval(xx, hint) == expected);
+        }
+    }
+}
+
+CATCH_TEST_CASE("KnotIntervalCursor", "[spline]")
+{
+    const auto spline = make_spline();
+    const auto basis = ww::CubicBSplineBasis<double>(spline.knots());
+
+    auto x = get_sample_points(spline, 53);
+    const auto reverse = GENERATE(false, true);
+    if (reverse) {
+        std::reverse(x.begin(), x.end());
+    }
+
+    auto cursor = ww::KnotIntervalCursor(basis);
+    for (const auto& xx : x) {
+        const auto i = cursor(xx);
+        CATCH_CHECK(i == basis.get_knot_interval(xx));
+        CATCH_CHECK(cursor.interval() == i);
+    }
+}
+
+CATCH_TEST_CASE("UniformCubicBSplineBasis", "[spline]")
+{
+    auto knots = std::vector<double>();
+    for (std::size_t i = 0; i < 9; ++i) {
+        knots.push_back(-1.0 + 0.5 * static_cast<double>(i));
+    }
+    const auto basis = ww::CubicBSplineBasis<double>(knots);
+    const auto uniform = ww::UniformCubicBSplineBasis<double>(-1.0, 0.5, 9);
+
+    CATCH_CHECK(uniform.spacing() == 0.5);
+    CATCH_CHECK(uniform.num_knot_intervals() == basis.num_knot_intervals());
+    CATCH_CHECK(uniform.num_basis_funcs() == basis.num_basis_funcs());
+    CATCH_CHECK(std::ranges::equal(uniform.knots(), basis.knots()));
+
+    CATCH_SECTION("knot interval")
+    {
+        for (std::size_t i = 0; i <= 400; ++i) {
+            const auto x = -1.5 + 0.0125 * static_cast<double>(i);
+            CATCH_CHECK(uniform.get_knot_interval(x) == basis.get_knot_interval(x));
+        }
+        for (const auto& x : knots) {
+            CATCH_CHECK(uniform.get_knot_interval(x) == basis.get_knot_interval(x));
+        }
+    }
+
+    CATCH_SECTION("spline evaluation")
+    {
+        using UniformSpline = ww::CubicBSpline<double, double, ww::Vector,
+                                               ww::UniformCubicBSplineBasis<double>>;
+
+        auto control_points = std::vector<double>();
+        for (std::size_t i = 0; i < basis.num_basis_funcs(); ++i) {
+            control_points.push_back(std::cos(static_cast<double>(i)));
+        }
+        const auto expected = ww::CubicBSpline<double>(basis, control_points);
+        const auto spline = UniformSpline(uniform, control_points);
+
+        const auto x = get_sample_points(expected, 50);
+        const auto y = spline(x);
+        for (std::size_t i = 0; i < std::size(x); ++i) {
+            const auto z = expected(x[i]);
+            CATCH_CHECK_THAT(spline(x[i]), Catch::Matchers::WithinAbs(z, 1e-12));
+            CATCH_CHECK_THAT(y[i], Catch::Matchers::WithinAbs(z, 1e-12));
+        }
+    }
+}
+
+} // namespace
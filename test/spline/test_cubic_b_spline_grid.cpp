@@ -0,0 +1,96 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <whirlwind/spline/cubic_b_spline_2d.hpp>
+#include <whirlwind/spline/cubic_b_spline_3d.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Basis = ww::CubicBSplineBasis<double>;
+
+// Get `n` points evenly spaced over the knot span of a basis, including both endpoints.
+auto
+get_sample_points(const Basis& basis, std::size_t n) -> std::vector<double>
+{
+    const auto knots = basis.knots();
+    const auto first = knots.front();
+    const auto last = knots.back();
+
+    auto x = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto t = static_cast<double>(i) / static_cast<double>(n - 1);
+        x[i] = first + t * (last - first);
+    }
+    return x;
+}
+
+// Get `n` pseudo-random control point values.
+auto
+get_control_points(std::size_t n) -> std::vector<double>
+{
+    auto c = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        c[i] = std::sin(0.3 * static_cast<double>(i * i % 17));
+    }
+    return c;
+}
+
+CATCH_TEST_CASE("CubicBSpline2D::eval_grid", "[spline]")
+{
+    const auto basis0 = Basis(std::vector{0.0, 1.0, 2.0, 3.5, 4.0, 5.0});
+    const auto basis1 = Basis(std::vector{-1.0, 0.0, 0.5, 2.0, 3.0});
+    const auto num_ctrl = basis0.num_basis_funcs() * basis1.num_basis_funcs();
+    const auto spline =
+            ww::CubicBSpline2D<double>(basis0, basis1, get_control_points(num_ctrl));
+
+    const auto x0 = get_sample_points(basis0, 21);
+    const auto x1 = get_sample_points(basis1, 14);
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{3});
+    const auto z = spline.eval_grid(x0, x1, num_threads);
+
+    CATCH_REQUIRE(z.extent(0) == std::size(x0));
+    CATCH_REQUIRE(z.extent(1) == std::size(x1));
+    for (std::size_t i = 0; i < std::size(x0); ++i) {
+        for (std::size_t j = 0; j < std::size(x1); ++j) {
+            const auto expected = spline(x0[i], x1[j]);
+            CATCH_CHECK_THAT(z(i, j), Catch::Matchers::WithinAbs(expected, 1e-12));
+        }
+    }
+}
+
+CATCH_TEST_CASE("CubicBSpline3D::eval_grid", "[spline]")
+{
+    const auto basis0 = Basis(std::vector{0.0, 1.0, 2.0, 3.5, 4.0, 5.0});
+    const auto basis1 = Basis(std::vector{-1.0, 0.0, 0.5, 2.0, 3.0});
+    const auto basis2 = Basis(std::vector{0.0, 1.0, 2.0, 3.0});
+    const auto num_ctrl = basis0.num_basis_funcs() * basis1.num_basis_funcs() *
+                          basis2.num_basis_funcs();
+    const auto spline = ww::CubicBSpline3D<double>(
+            std::array{basis0, basis1, basis2}, get_control_points(num_ctrl));
+
+    const auto x0 = get_sample_points(basis0, 11);
+    const auto x1 = get_sample_points(basis1, 9);
+    const auto x2 = get_sample_points(basis2, 7);
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+    const auto z = spline.eval_grid(x0, x1, x2, num_threads);
+
+    for (std::size_t i = 0; i < std::size(x0); ++i) {
+        for (std::size_t j = 0; j < std::size(x1); ++j) {
+            for (std::size_t k = 0; k < std::size(x2); ++k) {
+                const auto expected = spline(x0[i], x1[j], x2[k]);
+                CATCH_CHECK_THAT(z(i, j, k),
+                                 Catch::Matchers::WithinAbs(expected, 1e-12));
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,160 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/spline/cubic_b_spline.hpp>
+#include <whirlwind/spline/cubic_b_spline_2d.hpp>
+#include <whirlwind/spline/cubic_b_spline_3d.hpp>
+#include <whirlwind/spline/uniform_cubic_b_spline_basis.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Catch::Matchers::WithinAbs;
+
+using Basis = ww::CubicBSplineBasis<double>;
+
+// Get `n` irregularly spaced knots.
+auto
+make_knots(std::size_t n, double offset = 0.0) -> std::vector<double>
+{
+    auto knots = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto t = static_cast<double>(i);
+        knots[i] = offset + 0.5 * t + 0.03 * t * t;
+    }
+    return knots;
+}
+
+auto
+f(double x) -> double
+{
+    return std::sin(x) + 0.1 * x * x;
+}
+
+CATCH_TEST_CASE("CubicBSpline (interpolate)", "[spline]")
+{
+    const auto n = GENERATE(std::size_t{2}, std::size_t{3}, std::size_t{4},
+                            std::size_t{25});
+    const auto knots = make_knots(n);
+    const auto basis = Basis(knots);
+
+    auto values = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = f(knots[i]);
+    }
+    const auto spline = ww::CubicBSpline<double>(ww::interpolate_knots, basis, values);
+    CATCH_REQUIRE(std::size(spline.control_points()) == n + 2);
+
+    CATCH_SECTION("values at knots")
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            CATCH_CHECK_THAT(spline(knots[i]), WithinAbs(values[i], 1e-12));
+        }
+    }
+
+    CATCH_SECTION("natural boundary conditions")
+    {
+        const auto& c = spline.control_points();
+        const auto get_second_derivative = [&](double x, std::size_t i) {
+            const auto d = basis.eval_second_derivative_in_interval(x, i);
+            return (c[i] * d[0] + c[i + 1] * d[1]) +
+                   (c[i + 2] * d[2] + c[i + 3] * d[3]);
+        };
+        CATCH_CHECK_THAT(get_second_derivative(knots[0], 0), WithinAbs(0.0, 1e-10));
+        CATCH_CHECK_THAT(get_second_derivative(knots[n - 1], n - 2),
+                         WithinAbs(0.0, 1e-10));
+    }
+}
+
+CATCH_TEST_CASE("CubicBSpline (interpolate, uniform knots)", "[spline]")
+{
+    using UniformBasis = ww::UniformCubicBSplineBasis<double>;
+    using UniformSpline = ww::CubicBSpline<double, double, ww::Vector, UniformBasis>;
+
+    const auto n = std::size_t{17};
+    const auto basis = UniformBasis(-2.0, 0.25, n);
+
+    auto values = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = f(basis.knots()[i]);
+    }
+    const auto spline = UniformSpline(ww::interpolate_knots, basis, values);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        CATCH_CHECK_THAT(spline(basis.knots()[i]), WithinAbs(values[i], 1e-12));
+    }
+
+    // Natural cubic spline interpolation of a smooth function is accurate to O(h^2)
+    // near the boundaries and O(h^4) in the interior.
+    const auto x = 0.3;
+    CATCH_CHECK_THAT(spline(x), WithinAbs(f(x), 1e-3));
+}
+
+CATCH_TEST_CASE("CubicBSpline2D (interpolate)", "[spline]")
+{
+    const auto knots0 = make_knots(6);
+    const auto knots1 = make_knots(5, -1.0);
+    const auto basis0 = Basis(knots0);
+    const auto basis1 = Basis(knots1);
+
+    auto values = ww::Array2D<double>(std::size(knots0), std::size(knots1));
+    for (std::size_t i = 0; i < std::size(knots0); ++i) {
+        for (std::size_t j = 0; j < std::size(knots1); ++j) {
+            values(i, j) = f(knots0[i]) * std::cos(knots1[j]);
+        }
+    }
+
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{3});
+    const auto spline = ww::CubicBSpline2D<double>(ww::interpolate_knots, basis0,
+                                                   basis1, values, num_threads);
+    CATCH_REQUIRE(spline.control_points().extent(0) == std::size(knots0) + 2);
+    CATCH_REQUIRE(spline.control_points().extent(1) == std::size(knots1) + 2);
+
+    for (std::size_t i = 0; i < std::size(knots0); ++i) {
+        for (std::size_t j = 0; j < std::size(knots1); ++j) {
+            CATCH_CHECK_THAT(spline(knots0[i], knots1[j]),
+                             WithinAbs(values(i, j), 1e-12));
+        }
+    }
+}
+
+CATCH_TEST_CASE("CubicBSpline3D (interpolate)", "[spline]")
+{
+    const auto knots0 = make_knots(6);
+    const auto knots1 = make_knots(5, -1.0);
+    const auto knots2 = make_knots(4, 2.0);
+    const auto bases = std::array{Basis(knots0), Basis(knots1), Basis(knots2)};
+
+    auto values = ww::Array3D<double>(std::size(knots0), std::size(knots1),
+                                      std::size(knots2));
+    for (std::size_t i = 0; i < std::size(knots0); ++i) {
+        for (std::size_t j = 0; j < std::size(knots1); ++j) {
+            for (std::size_t k = 0; k < std::size(knots2); ++k) {
+                values(i, j, k) = f(knots0[i]) * std::cos(knots1[j]) + knots2[k];
+            }
+        }
+    }
+
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+    const auto spline = ww::CubicBSpline3D<double>(ww::interpolate_knots, bases,
+                                                   values, num_threads);
+
+    for (std::size_t i = 0; i < std::size(knots0); ++i) {
+        for (std::size_t j = 0; j < std::size(knots1); ++j) {
+            for (std::size_t k = 0; k < std::size(knots2); ++k) {
+                CATCH_CHECK_THAT(spline(knots0[i], knots1[j], knots2[k]),
+                                 WithinAbs(values(i, j, k), 1e-12));
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/common/namespace.hpp>
+
+WHIRLWIND_NAMESPACE_BEGIN
+namespace testing {
+
+/**
+ * Make the surplus of each node of a network with many pairs of opposite-signed
+ * residues scattered pseudo-randomly (some of which may coincide).
+ *
+ * @param[in] num_nodes
+ *     The number of nodes in the network.
+ * @param[in] nodes_per_pair
+ *     The number of nodes per pair of residues.
+ * @param[in] seed
+ *     Nonzero seeds perturb a few of the positive residues.
+ */
+[[nodiscard]] inline auto
+make_scattered_surplus(std::size_t num_nodes,
+                       std::size_t nodes_per_pair = 8,
+                       std::size_t seed = 0) -> std::vector<int>
+{
+    auto surplus = std::vector<int>(num_nodes, 0);
+    for (std::size_t i = 0; i < num_nodes / nodes_per_pair; ++i) {
+        const auto shift = (i % 10 == 0) ? seed : 0;
+        surplus[(37 * i + 5 + shift) % num_nodes] += 1;
+        surplus[(53 * i + 11) % num_nodes] -= 1;
+    }
+    return surplus;
+}
+
+/**
+ * Make pseudo-random arc costs in [1, 9].
+ *
+ * @param[in] num_edges
+ *     The number of edges in the graph.
+ * @param[in] seed
+ *     Nonzero seeds perturb a few of the costs.
+ */
+[[nodiscard]] inline auto
+make_pseudorandom_costs(std::size_t num_edges, std::size_t seed = 0) -> std::vector<int>
+{
+    auto cost = std::vector<int>(num_edges);
+    for (std::size_t edge = 0; edge < num_edges; ++edge) {
+        const auto shift = (edge % 7 == 0) ? seed : 0;
+        cost[edge] = 1 + static_cast<int>((7 * edge + edge / 3 + shift) % 9);
+    }
+    return cost;
+}
+
+/**
+ * Make a network on a graph with many pairs of opposite-signed residues scattered
+ * pseudo-randomly, and pseudo-random arc costs (see `make_scattered_surplus()` and
+ * `make_pseudorandom_costs()`).
+ *
+ * @tparam Network
+ *     The network type.
+ *
+ * @param[in] graph
+ *     The network's underlying graph.
+ * @param[in] seed
+ *     Nonzero seeds perturb a few of the residues and costs.
+ * @param[in] nodes_per_pair
+ *     The number of nodes per pair of residues.
+ */
+template<class Network, class Graph>
+[[nodiscard]] auto
+make_scattered_residue_network(const Graph& graph,
+                               std::size_t seed = 0,
+                               std::size_t nodes_per_pair = 8) -> Network
+{
+    const auto surplus = make_scattered_surplus(graph.num_vertices(), nodes_per_pair,
+                                                seed);
+    const auto cost = make_pseudorandom_costs(graph.num_edges(), seed);
+    return {graph, surplus, cost};
+}
+
+/**
+ * Check that a network's node potentials satisfy the reduced cost optimality
+ * conditions, i.e. that every unsaturated arc has nonnegative reduced cost.
+ *
+ * @param[in] network
+ *     The network.
+ * @param[in] is_checked
+ *     A predicate `is_checked(arc, tail, head)` selecting which arcs to check.
+ */
+template<class Network, class Predicate>
+void
+check_reduced_cost_optimality(const Network& network, const Predicate& is_checked)
+{
+    for (const auto& tail : network.nodes()) {
+        for (const auto& [arc, head] : network.outgoing_arcs(tail)) {
+            if (is_checked(arc, tail, head) && !network.is_arc_saturated(arc)) {
+                CATCH_CHECK(network.arc_reduced_cost(arc, tail, head) >= 0);
+            }
+        }
+    }
+}
+
+/**
+ * Check that a network's node potentials satisfy the reduced cost optimality
+ * conditions for every arc.
+ *
+ * @param[in] network
+ *     The network.
+ */
+template<class Network>
+void
+check_reduced_cost_optimality(const Network& network)
+{
+    check_reduced_cost_optimality(network, [](const auto&...) { return true; });
+}
+
+} // namespace testing
+WHIRLWIND_NAMESPACE_END
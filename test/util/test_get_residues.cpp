@@ -0,0 +1,153 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/util/get_residues.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+// A straightforward reference implementation, which sums the wrapped phase
+// differences around each 2x2 loop of pixels (and around the border of the array).
+auto
+get_residues_reference(const ww::Array2D<double>& wrapped_phase)
+        -> ww::Array2D<std::int32_t>
+{
+    const auto m = wrapped_phase.extent(0);
+    const auto n = wrapped_phase.extent(1);
+    auto out = ww::Array2D<std::int32_t>(m + 1, n + 1);
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            out(i, j) = 0;
+        }
+    }
+
+    const auto cycles = [](double a, double b) {
+        return static_cast<std::int32_t>(std::round((a - b) / ww::tau<double>()));
+    };
+
+    for (std::size_t i = 0; i + 1 < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto d = cycles(wrapped_phase(i, j), wrapped_phase(i + 1, j));
+            out(i + 1, j) += d;
+            out(i + 1, j + 1) -= d;
+        }
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j + 1 < n; ++j) {
+            const auto d = cycles(wrapped_phase(i, j + 1), wrapped_phase(i, j));
+            out(i, j + 1) += d;
+            out(i + 1, j + 1) -= d;
+        }
+    }
+    return out;
+}
+
+CATCH_TEST_CASE("get_residues", "[util]")
+{
+    const auto [m, n] = GENERATE(std::pair<std::size_t, std::size_t>{1, 1},
+                                 std::pair<std::size_t, std::size_t>{1, 9},
+                                 std::pair<std::size_t, std::size_t>{7, 1},
+                                 std::pair<std::size_t, std::size_t>{23, 31});
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+
+    // Uniformly random wrapped phase, which has residues almost everywhere. Some
+    // values are exactly +/-pi.
+    auto rng = std::mt19937(1234);
+    auto dist = std::uniform_real_distribution<double>(-ww::pi<double>(),
+                                                       ww::pi<double>());
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            wrapped_phase(i, j) = ((i + 2 * j) % 11 == 0) ? ww::pi<double>()
+                                                          : dist(rng);
+        }
+    }
+
+    const auto residues = ww::get_residues(wrapped_phase, num_threads);
+    const auto expected = get_residues_reference(wrapped_phase);
+    CATCH_REQUIRE(residues.extent(0) == m + 1);
+    CATCH_REQUIRE(residues.extent(1) == n + 1);
+
+    std::int32_t total = 0;
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            CATCH_CHECK(residues(i, j) == expected(i, j));
+            total += residues(i, j);
+        }
+    }
+    CATCH_CHECK(total == 0);
+}
+
+CATCH_TEST_CASE("get_residues (strided layouts)", "[util]")
+{
+    const std::size_t m = 13;
+    const std::size_t n = 19;
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+
+    // A column-major wrapped phase array viewing an external buffer.
+    auto rng = std::mt19937(5678);
+    auto dist = std::uniform_real_distribution<double>(-ww::pi<double>(),
+                                                       ww::pi<double>());
+    auto input = std::vector<double>(m * n);
+    for (auto& psi : input) {
+        psi = dist(rng);
+    }
+    const auto wrapped_phase =
+            ww::Span2D<const double, ww::LayoutLeft>(input.data(), m, n);
+
+    auto row_major = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            row_major(i, j) = wrapped_phase(i, j);
+        }
+    }
+    const auto expected = ww::get_residues(row_major);
+
+    CATCH_SECTION("returned")
+    {
+        const auto residues = ww::get_residues(wrapped_phase, num_threads);
+        for (std::size_t i = 0; i <= m; ++i) {
+            for (std::size_t j = 0; j <= n; ++j) {
+                CATCH_CHECK(residues(i, j) == expected(i, j));
+            }
+        }
+    }
+
+    CATCH_SECTION("output parameter")
+    {
+        // The output is written into a padded buffer with a row stride of N+4. The
+        // padding is left untouched.
+        const auto row_stride = n + 4;
+        auto output = std::vector<std::int32_t>((m + 1) * row_stride, 99);
+        const auto mapping = ww::LayoutStride::mapping<ww::DynamicExtents2D>(
+                ww::DynamicExtents2D(m + 1, n + 1),
+                std::array<std::size_t, 2>{row_stride, 1});
+        const auto residues =
+                ww::Span2D<std::int32_t, ww::LayoutStride>(output.data(), mapping);
+        ww::get_residues(wrapped_phase, residues, num_threads);
+
+        for (std::size_t i = 0; i <= m; ++i) {
+            for (std::size_t j = 0; j < row_stride; ++j) {
+                if (j <= n) {
+                    CATCH_CHECK(residues(i, j) == expected(i, j));
+                } else {
+                    CATCH_CHECK(output[i * row_stride + j] == 99);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,124 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/util/get_residues.hpp>
+#include <whirlwind/util/integrate_unwrapped_gradients.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using GridGraph = ww::RectangularGridGraph<1, std::size_t>;
+using GridNetwork = ww::Network<GridGraph, int, int>;
+using GridDijkstra = ww::Dijkstra<int, GridNetwork::residual_graph_type>;
+
+// Make a wrapped phase array containing a linear phase ramp plus a pair of phase
+// vortices of opposite sign, centered between pixels so that each forms a single
+// residue.
+auto
+make_wrapped_phase(std::size_t m, std::size_t n) -> ww::Array2D<double>
+{
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto x = static_cast<double>(j);
+            const auto y = static_cast<double>(i);
+            const auto phi = 0.7 * x - 0.4 * y + std::atan2(y - 5.5, x - 4.5) -
+                             std::atan2(y - 5.5, x - 13.5);
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+        }
+    }
+    return wrapped_phase;
+}
+
+CATCH_TEST_CASE("integrate_unwrapped_gradients", "[util]")
+{
+    const std::size_t m = 17;
+    const std::size_t n = 23;
+    const auto wrapped_phase = make_wrapped_phase(m, n);
+    const auto residues = ww::get_residues(wrapped_phase);
+
+    const auto grid = GridGraph(m + 1, n + 1);
+    const auto cost = std::vector<int>(grid.num_edges(), 1);
+    auto surplus = std::vector<int>();
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            surplus.push_back(residues(i, j));
+        }
+    }
+    auto network = GridNetwork(grid, surplus, cost);
+    ww::primal_dual<GridDijkstra>(network);
+    CATCH_REQUIRE(network.is_balanced());
+    CATCH_REQUIRE(network.total_cost() > 0);
+
+    const auto expected = ww::integrate_unwrapped_gradients(wrapped_phase, network);
+    CATCH_CHECK(expected(0, 0) == wrapped_phase(0, 0));
+
+    // The unwrapped phase is congruent with the wrapped phase.
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto k = (expected(i, j) - wrapped_phase(i, j)) / ww::tau<double>();
+            CATCH_CHECK(std::abs(k - std::round(k)) < 1e-6);
+        }
+    }
+
+    // Every vertical unwrapped gradient, not only those in the first column, is the
+    // wrapped gradient plus the net leftward flow between the bordering residues.
+    const auto& residual_graph = network.residual_graph();
+    for (std::size_t i = 1; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto arc0 = residual_graph.get_right_edge({i, j});
+            const auto arc1 = residual_graph.get_left_edge({i, j + 1});
+            const auto net_flow = network.arc_flow(arc1) - network.arc_flow(arc0);
+            const auto diff = wrapped_phase(i, j) - wrapped_phase(i - 1, j);
+            const auto dpsi =
+                    diff - ww::tau<double>() * std::round(diff / ww::tau<double>());
+            const auto dphi = dpsi + ww::tau<double>() * net_flow;
+            CATCH_CHECK(std::abs(expected(i, j) - expected(i - 1, j) - dphi) < 1e-6);
+        }
+    }
+
+    // The result doesn't depend on the number of threads.
+    const auto num_threads = GENERATE(std::size_t{2}, std::size_t{4}, std::size_t{32});
+    const auto unwrapped_phase =
+            ww::integrate_unwrapped_gradients(wrapped_phase, network, num_threads);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            CATCH_CHECK(unwrapped_phase(i, j) == expected(i, j));
+        }
+    }
+
+    // Column-major input and output buffers are used without copies and give the same
+    // result.
+    auto input = std::vector<double>(m * n);
+    const auto input_view = ww::Span2D<double, ww::LayoutLeft>(input.data(), m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            input_view(i, j) = wrapped_phase(i, j);
+        }
+    }
+    auto output = std::vector<double>(m * n);
+    const auto output_view = ww::Span2D<double, ww::LayoutLeft>(output.data(), m, n);
+    const auto column_major =
+            ww::Span2D<const double, ww::LayoutLeft>(input.data(), m, n);
+    ww::integrate_unwrapped_gradients(column_major, network, output_view, num_threads);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            CATCH_CHECK(output_view(i, j) == expected(i, j));
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <mpi.h>
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/util/mpi_tiled_unwrap.hpp>
+#include <whirlwind/util/tiled_unwrap.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("mpi_tiled_unwrap", "[util][mpi]")
+{
+    // A phase ramp plus noise. Every rank generates the same wrapped phase.
+    const std::size_t m = 53;
+    const std::size_t n = 47;
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    auto rng = std::mt19937(1234);
+    auto noise = std::normal_distribution<double>(0.0, 1.0);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto phi = 0.5 * static_cast<double>(i) -
+                             0.8 * static_cast<double>(j) + noise(rng);
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+        }
+    }
+
+    const auto load_tile = [&](const ww::Tile& tile) {
+        auto out = ww::Array2D<double>(tile.num_rows(), tile.num_cols());
+        for (std::size_t i = 0; i < tile.num_rows(); ++i) {
+            for (std::size_t j = 0; j < tile.num_cols(); ++j) {
+                out(i, j) = wrapped_phase(tile.row_begin + i, tile.col_begin + j);
+            }
+        }
+        return out;
+    };
+
+    const auto cost_fn = [](const ww::Tile&, const auto& graph) {
+        return std::vector<int>(graph.num_edges(), 1);
+    };
+
+    auto options = ww::TiledUnwrapOptions();
+    options.tile_rows = 11;
+    options.tile_cols = 13;
+    options.overlap = 4;
+    options.num_threads = 2;
+
+    // The distributed pipeline should match the shared-memory pipeline exactly.
+    const auto expected = ww::tiled_unwrap(wrapped_phase, cost_fn, options);
+
+    auto num_stored = std::uint64_t{0};
+    const auto store_tile = [&](const ww::Tile& tile, const auto& tile_unwrapped) {
+        for (auto i = tile.core_row_begin; i < tile.core_row_end; ++i) {
+            for (auto j = tile.core_col_begin; j < tile.core_col_end; ++j) {
+                const auto x = tile_unwrapped(i - tile.row_begin, j - tile.col_begin);
+                CATCH_CHECK_THAT(x, Catch::Matchers::WithinAbs(expected(i, j), 1e-9));
+                ++num_stored;
+            }
+        }
+    };
+
+    ww::mpi_tiled_unwrap(m, n, load_tile, cost_fn, store_tile, options);
+
+    // Every pixel is stored by exactly one rank.
+    auto total_stored = std::uint64_t{0};
+    MPI_Allreduce(&num_stored, &total_stored, 1, MPI_UINT64_T, MPI_SUM,
+                  MPI_COMM_WORLD);
+    CATCH_CHECK(total_stored == m * n);
+}
+
+} // namespace
+
+auto
+main(int argc, char** argv) -> int
+{
+    MPI_Init(&argc, &argv);
+    const auto result = Catch::Session().run(argc, argv);
+    MPI_Finalize();
+    return result;
+}
@@ -0,0 +1,197 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/cost/statistical_cost.hpp>
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/util/get_residues.hpp>
+#include <whirlwind/util/integrate_unwrapped_gradients.hpp>
+#include <whirlwind/util/raster_kernels.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using Grid = ww::RectangularGridGraph<1, std::size_t>;
+using Network = ww::Network<Grid, int, int>;
+using Dijkstra = ww::Dijkstra<int, Network::residual_graph_type>;
+
+// Owning storage for a set of planar grid cost rasters.
+template<class Cost>
+struct CostRasters {
+    CostRasters(std::size_t m, std::size_t n)
+        : up(m, n + 1), down(m, n + 1), left(m + 1, n), right(m + 1, n)
+    {}
+
+    auto
+    view() -> ww::PlanarGridCosts<Cost>
+    {
+        return {up.to_mdspan(), down.to_mdspan(), left.to_mdspan(), right.to_mdspan()};
+    }
+
+    ww::Array2D<Cost> up;
+    ww::Array2D<Cost> down;
+    ww::Array2D<Cost> left;
+    ww::Array2D<Cost> right;
+};
+
+// Owning storage for a pair of planar gradient rasters of an M x N raster.
+template<class T>
+struct GradientRasters {
+    GradientRasters(std::size_t m, std::size_t n) : down(m - 1, n), right(m, n - 1) {}
+
+    auto
+    view() -> ww::PlanarGradients<T>
+    {
+        return {down.to_mdspan(), right.to_mdspan()};
+    }
+
+    ww::Array2D<T> down;
+    ww::Array2D<T> right;
+};
+
+// Check whether two 2-D arrays with the same shape are exactly equal.
+template<class A, class B>
+auto
+all_equal(const A& a, const B& b) -> bool
+{
+    for (std::size_t i = 0; i < a.extent(0); ++i) {
+        for (std::size_t j = 0; j < a.extent(1); ++j) {
+            if (a(i, j) != b(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Make a wrapped phase ramp with a patch of noise, and its coherence.
+auto
+make_inputs(std::size_t m, std::size_t n)
+        -> std::pair<ww::Array2D<double>, ww::Array2D<double>>
+{
+    auto rng = std::mt19937(2468);
+    auto noise = std::uniform_real_distribution<double>(-ww::pi<double>(),
+                                                        ww::pi<double>());
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    auto coherence = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto is_noisy = (i >= 5) && (i < 12) && (j >= 7) && (j < 15);
+            const auto phi = 0.8 * static_cast<double>(j) -
+                             0.3 * static_cast<double>(i) +
+                             (is_noisy ? noise(rng) : 0.0);
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+            coherence(i, j) = is_noisy ? 0.15 : 0.85;
+        }
+    }
+    return {std::move(wrapped_phase), std::move(coherence)};
+}
+
+CATCH_TEST_CASE("launch_residues", "[util]")
+{
+    const std::size_t m = 19;
+    const std::size_t n = 26;
+    auto [wrapped_phase, _] = make_inputs(m, n);
+    const auto expected = ww::get_residues(wrapped_phase);
+
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+    auto residues = ww::Array2D<std::int32_t>(m + 1, n + 1);
+    ww::launch_residues(ww::HostLauncher{num_threads}, wrapped_phase.to_mdspan(),
+                        residues.to_mdspan());
+    CATCH_CHECK(all_equal(residues, expected));
+}
+
+CATCH_TEST_CASE("launch_statistical_costs", "[util]")
+{
+    const std::size_t m = 19;
+    const std::size_t n = 26;
+    auto [wrapped_phase, coherence] = make_inputs(m, n);
+
+    auto options = ww::StatisticalCostOptions();
+    options.border_cost = 3.0;
+
+    auto expected = CostRasters<int>(m, n);
+    ww::get_statistical_costs(wrapped_phase, coherence, expected.view(), options);
+
+    const auto num_threads = GENERATE(std::size_t{1}, std::size_t{4});
+    auto cost = CostRasters<int>(m, n);
+    ww::launch_statistical_costs(ww::HostLauncher{num_threads},
+                                 wrapped_phase.to_mdspan(), coherence.to_mdspan(),
+                                 cost.view(), options);
+    CATCH_CHECK(all_equal(cost.up, expected.up));
+    CATCH_CHECK(all_equal(cost.down, expected.down));
+    CATCH_CHECK(all_equal(cost.left, expected.left));
+    CATCH_CHECK(all_equal(cost.right, expected.right));
+}
+
+CATCH_TEST_CASE("launch_integrate_gradients", "[util]")
+{
+    const std::size_t m = 19;
+    const std::size_t n = 26;
+    auto [wrapped_phase, coherence] = make_inputs(m, n);
+    const auto launch = ww::HostLauncher{GENERATE(std::size_t{1}, std::size_t{4})};
+
+    // Compute the residues and costs with the kernels, then solve the network on the
+    // host.
+    auto residues = ww::Array2D<int>(m + 1, n + 1);
+    auto cost = CostRasters<int>(m, n);
+    ww::launch_residues(launch, wrapped_phase.to_mdspan(), residues.to_mdspan());
+    ww::launch_statistical_costs(launch, wrapped_phase.to_mdspan(),
+                                 coherence.to_mdspan(), cost.view());
+
+    const auto grid = Grid(m + 1, n + 1);
+    auto surplus = std::vector<int>();
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            surplus.push_back(residues(i, j));
+        }
+    }
+    auto network = Network(grid, surplus, cost.up.to_mdspan(), cost.down.to_mdspan(),
+                           cost.left.to_mdspan(), cost.right.to_mdspan());
+    ww::primal_dual<Dijkstra>(network);
+    CATCH_REQUIRE(network.total_excess() == 0);
+    CATCH_REQUIRE(network.total_cost() > 0);
+
+    auto net_flow = GradientRasters<int>(m, n);
+    ww::get_planar_net_flow(network, net_flow.view(), launch.num_threads);
+
+    // Each net flow is the net flow between the residues that border the pair of
+    // pixels.
+    const auto& residual_graph = network.residual_graph();
+    for (std::size_t i = 1; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto arc0 = residual_graph.get_right_edge({i, j});
+            const auto arc1 = residual_graph.get_left_edge({i, j + 1});
+            const auto k = network.arc_flow(arc1) - network.arc_flow(arc0);
+            CATCH_CHECK(net_flow.down(i - 1, j) == k);
+        }
+    }
+
+    auto gradient = GradientRasters<double>(m, n);
+    ww::launch_unwrapped_gradients(launch, wrapped_phase.to_mdspan(), net_flow.view(),
+                                   gradient.view());
+
+    auto unwrapped_phase = ww::Array2D<double>(m, n);
+    ww::launch_integrate_gradients(launch, wrapped_phase.to_mdspan(), gradient.view(),
+                                   unwrapped_phase.to_mdspan());
+
+    // The result is identical to integrating the solution on the host.
+    const auto expected = ww::integrate_unwrapped_gradients(wrapped_phase, network);
+    CATCH_CHECK(all_equal(unwrapped_phase, expected));
+}
+
+} // namespace
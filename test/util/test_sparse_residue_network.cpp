@@ -0,0 +1,131 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/util/get_residues.hpp>
+#include <whirlwind/util/integrate_unwrapped_gradients.hpp>
+#include <whirlwind/util/sparse_residue_network.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+using GridGraph = ww::RectangularGridGraph<1, std::size_t>;
+using GridNetwork = ww::Network<GridGraph, int, int>;
+using GridDijkstra = ww::Dijkstra<int, GridNetwork::residual_graph_type>;
+using SparseNetwork = ww::SparseResidueNetwork<int, int>;
+using SparseDijkstra =
+        ww::Dijkstra<int, SparseNetwork::network_type::residual_graph_type>;
+
+// Make a wrapped phase array containing a pair of phase vortices of opposite sign,
+// centered between pixels so that each forms a single residue.
+auto
+make_vortex_pair(std::size_t m, std::size_t n) -> ww::Array2D<double>
+{
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto y = static_cast<double>(i) - 10.5;
+            const auto phi = std::atan2(y, static_cast<double>(j) - 12.5) -
+                             std::atan2(y, static_cast<double>(j) - 30.5);
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+        }
+    }
+    return wrapped_phase;
+}
+
+CATCH_TEST_CASE("SparseResidueNetwork", "[util]")
+{
+    const std::size_t m = 40;
+    const std::size_t n = 50;
+    const auto wrapped_phase = make_vortex_pair(m, n);
+    const auto residues = ww::get_residues(wrapped_phase);
+
+    const auto grid = GridGraph(m + 1, n + 1);
+    const auto cost = std::vector<int>(grid.num_edges(), 1);
+    auto surplus = std::vector<int>();
+    for (std::size_t i = 0; i <= m; ++i) {
+        for (std::size_t j = 0; j <= n; ++j) {
+            surplus.push_back(residues(i, j));
+        }
+    }
+
+    // The optimal solution on the full grid.
+    auto full_network = GridNetwork(grid, surplus, cost);
+    ww::primal_dual<GridDijkstra>(full_network);
+    const auto optimal_cost = full_network.total_cost();
+    CATCH_REQUIRE(optimal_cost > 0);
+
+    CATCH_SECTION("sparse")
+    {
+        auto options = ww::SparseResidueOptions();
+        options.cell_size = 8;
+        options.halo = 0;
+        auto sparse = SparseNetwork(residues, cost, options);
+
+        // Most of the grid is represented only by highways.
+        auto& network = sparse.network();
+        CATCH_CHECK(network.num_nodes() < grid.num_vertices() / 2);
+        for (const auto& node : network.nodes()) {
+            const auto vertex = sparse.get_grid_vertex(node);
+            CATCH_CHECK(sparse.contains_grid_vertex(vertex));
+            const auto& [i, j] = vertex;
+            CATCH_CHECK(network.node_excess(node) == residues(i, j));
+        }
+
+        ww::primal_dual<SparseDijkstra>(network);
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.total_cost() >= optimal_cost);
+
+        // The expanded flows are feasible and have the same cost as the sparse
+        // solution.
+        auto expanded = GridNetwork(grid, surplus, cost);
+        sparse.expand_flows(expanded);
+        CATCH_CHECK(expanded.is_balanced());
+        CATCH_CHECK(expanded.total_cost() == network.total_cost());
+
+        // The unwrapped phase is congruent with the wrapped phase.
+        const auto unwrapped_phase =
+                ww::integrate_unwrapped_gradients(wrapped_phase, expanded);
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                const auto k = (unwrapped_phase(i, j) - wrapped_phase(i, j)) /
+                               ww::tau<double>();
+                CATCH_CHECK(std::abs(k - std::round(k)) < 1e-6);
+            }
+        }
+    }
+
+    CATCH_SECTION("dense")
+    {
+        // With a halo covering the whole grid, the sparse network is the full grid.
+        auto options = ww::SparseResidueOptions();
+        options.cell_size = 8;
+        options.halo = 10;
+        auto sparse = SparseNetwork(residues, cost, options);
+
+        auto& network = sparse.network();
+        CATCH_CHECK(network.num_nodes() == grid.num_vertices());
+        CATCH_CHECK(network.num_arcs() == 2 * grid.num_edges());
+
+        ww::primal_dual<SparseDijkstra>(network);
+        CATCH_CHECK(network.is_balanced());
+        CATCH_CHECK(network.total_cost() == optimal_cost);
+
+        auto expanded = GridNetwork(grid, surplus, cost);
+        sparse.expand_flows(expanded);
+        CATCH_CHECK(expanded.is_balanced());
+        CATCH_CHECK(expanded.total_cost() == optimal_cost);
+    }
+}
+
+} // namespace
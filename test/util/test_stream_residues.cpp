@@ -0,0 +1,92 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/ndarray/ndspan.hpp>
+#include <whirlwind/util/get_residues.hpp>
+#include <whirlwind/util/stream_residues.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("stream_residues", "[util]")
+{
+    const auto [m, n] = GENERATE(std::pair<std::size_t, std::size_t>{1, 1},
+                                 std::pair<std::size_t, std::size_t>{7, 1},
+                                 std::pair<std::size_t, std::size_t>{23, 31});
+    auto options = ww::ResidueStreamOptions();
+    options.strip_rows = GENERATE(std::size_t{1}, std::size_t{5}, std::size_t{64});
+    options.prefetch = GENERATE(false, true);
+
+    // Uniformly random wrapped phase, stored in a row-major buffer in the same manner
+    // as a memory-mapped raster.
+    auto rng = std::mt19937(1234);
+    auto dist = std::uniform_real_distribution<double>(-ww::pi<double>(),
+                                                       ww::pi<double>());
+    auto buffer = std::vector<double>(m * n);
+    for (auto& psi : buffer) {
+        psi = dist(rng);
+    }
+    const auto wrapped_phase = ww::Span2D<const double>(buffer.data(), m, n);
+    const auto expected = ww::get_residues(wrapped_phase);
+
+    // Each strip is a view of the buffer. Strips may be loaded from a background
+    // thread, so the requested intervals are recorded and checked afterwards.
+    auto strips = std::vector<std::pair<std::size_t, std::size_t>>();
+    const auto load_strip = [&](std::size_t first, std::size_t last) {
+        strips.emplace_back(first, last);
+        return ww::Span2D<const double>(buffer.data() + first * n, last - first, n);
+    };
+
+    // Each strip is requested exactly once, in order.
+    const auto check_strips = [&] {
+        auto num_loaded = std::size_t{0};
+        for (const auto& [first, last] : strips) {
+            CATCH_CHECK(first == num_loaded);
+            CATCH_CHECK(last > first);
+            CATCH_CHECK(last - first <= options.strip_rows);
+            num_loaded = last;
+        }
+        CATCH_CHECK(num_loaded == m);
+    };
+
+    CATCH_SECTION("dense")
+    {
+        auto num_rows = std::size_t{0};
+        const auto emit_row = [&](std::size_t r, const auto& row) {
+            CATCH_CHECK(r == num_rows);
+            for (std::size_t c = 0; c <= n; ++c) {
+                CATCH_CHECK(row[c] == expected(r, c));
+            }
+            ++num_rows;
+        };
+        ww::stream_residues(m, n, load_strip, emit_row, options);
+        CATCH_CHECK(num_rows == m + 1);
+        check_strips();
+    }
+
+    CATCH_SECTION("sparse")
+    {
+        const auto residues = ww::get_sparse_residues(m, n, load_strip, options);
+        auto expected_residues = std::vector<ww::Residue<std::int32_t>>();
+        for (std::size_t i = 0; i <= m; ++i) {
+            for (std::size_t j = 0; j <= n; ++j) {
+                if (expected(i, j) != 0) {
+                    expected_residues.push_back({i, j, expected(i, j)});
+                }
+            }
+        }
+        CATCH_CHECK(residues == expected_residues);
+        check_strips();
+    }
+}
+
+} // namespace
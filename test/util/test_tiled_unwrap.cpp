@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <whirlwind/math/numbers.hpp>
+#include <whirlwind/ndarray/ndarray.hpp>
+#include <whirlwind/util/tiled_unwrap.hpp>
+
+namespace {
+
+namespace ww = whirlwind;
+
+CATCH_TEST_CASE("TileLayout", "[util]")
+{
+    const auto layout = ww::TileLayout(25, 31, 10, 12, 3);
+    CATCH_CHECK(layout.num_tile_rows() == 3);
+    CATCH_CHECK(layout.num_tile_cols() == 3);
+    CATCH_CHECK(layout.num_tiles() == 9);
+
+    // The core regions partition the array, and each extended region contains its core
+    // region plus a margin clipped to the array bounds.
+    auto count = std::vector<int>(25 * 31, 0);
+    for (std::size_t tile_id = 0; tile_id < layout.num_tiles(); ++tile_id) {
+        const auto tile = layout.tile(tile_id);
+        CATCH_CHECK(tile.row_begin ==
+                    ((tile.core_row_begin >= 3) ? tile.core_row_begin - 3 : 0));
+        CATCH_CHECK(tile.row_end == std::min(tile.core_row_end + 3, std::size_t{25}));
+        CATCH_CHECK(tile.col_begin ==
+                    ((tile.core_col_begin >= 3) ? tile.core_col_begin - 3 : 0));
+        CATCH_CHECK(tile.col_end == std::min(tile.core_col_end + 3, std::size_t{31}));
+
+        for (auto i = tile.core_row_begin; i < tile.core_row_end; ++i) {
+            for (auto j = tile.core_col_begin; j < tile.core_col_end; ++j) {
+                CATCH_CHECK(layout.get_tile_id(i, j) == tile_id);
+                ++count[i * 31 + j];
+            }
+        }
+    }
+    for (const auto& c : count) {
+        CATCH_CHECK(c == 1);
+    }
+}
+
+CATCH_TEST_CASE("resolve_tile_offsets", "[util]")
+{
+    // Three tiles in a row. The seam between tiles 0 and 2 disagrees with the others,
+    // but has the fewest votes.
+    const auto votes = std::vector<ww::SeamVote>{
+            {0, 1, 2, 10},
+            {0, 1, 1, 3},
+            {1, 2, -1, 6},
+            {1, 2, -1, 5},
+            {0, 2, 5, 4},
+    };
+    const auto offset = ww::resolve_tile_offsets(3, votes);
+    CATCH_REQUIRE(std::size(offset) == 3);
+    CATCH_CHECK(offset[0] == 0);
+    CATCH_CHECK(offset[1] == 2);
+    CATCH_CHECK(offset[2] == 1);
+}
+
+CATCH_TEST_CASE("tiled_unwrap", "[util]")
+{
+    // A smooth phase ramp whose gradients are less than half a cycle, so it contains no
+    // residues and can be unwrapped exactly.
+    const std::size_t m = 37;
+    const std::size_t n = 41;
+    auto phase = ww::Array2D<double>(m, n);
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto phi =
+                    0.9 * static_cast<double>(i) + 0.7 * static_cast<double>(j);
+            phase(i, j) = phi;
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+        }
+    }
+
+    const auto cost_fn = [](const ww::Tile&, const auto& graph) {
+        return std::vector<int>(graph.num_edges(), 1);
+    };
+
+    auto options = ww::TiledUnwrapOptions();
+    options.tile_rows = 10;
+    options.tile_cols = 12;
+    options.overlap = 3;
+
+    CATCH_SECTION("single thread")
+    {
+        options.num_threads = 1;
+    }
+
+    CATCH_SECTION("multiple threads")
+    {
+        options.num_threads = 3;
+    }
+
+    const auto unwrapped_phase = ww::tiled_unwrap(wrapped_phase, cost_fn, options);
+    CATCH_REQUIRE(unwrapped_phase.extent(0) == m);
+    CATCH_REQUIRE(unwrapped_phase.extent(1) == n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            CATCH_CHECK_THAT(unwrapped_phase(i, j),
+                             Catch::Matchers::WithinAbs(phase(i, j), 1e-9));
+        }
+    }
+}
+
+CATCH_TEST_CASE("tiled_unwrap (residues near seams)", "[util]")
+{
+    // A phase ramp plus three pairs of phase vortices of opposite sign, each centered
+    // on a residue node (i,j) at the corner between pixels:
+    //  - (5,10) and (5,14) straddle the seam between the first two columns of tiles,
+    //  - (19,30) and (22,30) straddle the seam between the second and third rows of
+    //    tiles,
+    //  - (23,25) and (28,25) lie in the core of tile 10, close enough to the margin of
+    //    tile 9 that tile 9 balances them with its border instead of pairing them, so
+    //    the pixels in the overlap between tiles 9 and 10 cast conflicting votes.
+    struct Vortex {
+        double i;
+        double j;
+        double sign;
+    };
+    const auto vortices = std::vector<Vortex>{
+            {5.0, 10.0, 1.0},
+            {5.0, 14.0, -1.0},
+            {19.0, 30.0, 1.0},
+            {22.0, 30.0, -1.0},
+            {23.0, 25.0, 1.0},
+            {28.0, 25.0, -1.0},
+    };
+
+    const std::size_t m = 37;
+    const std::size_t n = 41;
+    auto wrapped_phase = ww::Array2D<double>(m, n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            const auto y = static_cast<double>(i);
+            const auto x = static_cast<double>(j);
+            auto phi = 0.2 * y - 0.1 * x;
+            for (const auto& v : vortices) {
+                phi += v.sign * std::atan2(y - (v.i - 0.5), x - (v.j - 0.5));
+            }
+            wrapped_phase(i, j) =
+                    phi - ww::tau<double>() * std::round(phi / ww::tau<double>());
+        }
+    }
+
+    const auto cost_fn = [](const ww::Tile&, const auto& graph) {
+        return std::vector<int>(graph.num_edges(), 1);
+    };
+
+    // An untiled primal-dual solve over the whole array.
+    const auto whole = ww::TileLayout(m, n, m, n, 0).tile(0);
+    const auto expected = ww::unwrap_tile(wrapped_phase, whole, cost_fn);
+
+    auto options = ww::TiledUnwrapOptions();
+    options.tile_rows = 10;
+    options.tile_cols = 12;
+    options.overlap = 3;
+    const auto layout = ww::TileLayout(
+            m, n, options.tile_rows, options.tile_cols, options.overlap);
+
+    // Tile 9 pairs the residues in its margin differently than tile 10 does, so its
+    // margin disagrees with the untiled solution on some pixels but not others.
+    const auto tile = layout.tile(9);
+    const auto margin = ww::get_tile_margin(
+            tile, ww::unwrap_tile(wrapped_phase, tile, cost_fn));
+    auto offsets = std::set<std::int64_t>();
+    for (const auto& vote : ww::get_seam_votes(layout, 9, margin, expected)) {
+        if ((vote.tile0 == 9) && (vote.tile1 == 10)) {
+            offsets.insert(vote.offset);
+        }
+    }
+    CATCH_CHECK(std::size(offsets) >= 2);
+
+    // The tiled solution matches the untiled solution up to a constant number of
+    // cycles.
+    const auto unwrapped_phase = ww::tiled_unwrap(wrapped_phase, cost_fn, options);
+    CATCH_REQUIRE(unwrapped_phase.extent(0) == m);
+    CATCH_REQUIRE(unwrapped_phase.extent(1) == n);
+    const auto shift = unwrapped_phase(0, 0) - expected(0, 0);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            CATCH_CHECK_THAT(unwrapped_phase(i, j) - expected(i, j),
+                             Catch::Matchers::WithinAbs(shift, 1e-9));
+        }
+    }
+}
+
+} // namespace